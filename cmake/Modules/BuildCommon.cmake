@@ -35,6 +35,8 @@ set(KATANA_USE_TUNE "intel;generic;auto" CACHE STRING "Semi-colon separated list
   optimizing for the most common processors and then to optimizing for the processor selected by KATANA_USE_ARCH")
 set(KATANA_USE_SANITIZER "" CACHE STRING "Semi-colon separated list of sanitizers to use (Memory, MemoryWithOrigins, Address, Undefined, Thread)")
 set(KATANA_USE_JEMALLOC OFF CACHE BOOL "Use jemalloc")
+set(KATANA_USE_FLAT_ENTITY_INDEX ON CACHE BOOL "Use sorted arrays instead of trees for property indexes")
+set(KATANA_USE_IO_URING ON CACHE BOOL "Serve asynchronous local storage reads and writes with io_uring when the kernel supports it")
 
 # This option is automatically handled by CMake.
 # It makes add_library build a shared lib unless STATIC is explicitly specified.
@@ -20,6 +20,7 @@
 #ifndef KATANA_LIBGALOIS_KATANA_HWTOPO_H_
 #define KATANA_LIBGALOIS_KATANA_HWTOPO_H_
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -55,6 +56,10 @@ struct KATANA_EXPORT HWTopoInfo {
  */
 KATANA_EXPORT HWTopoInfo getHWTopo();
 
+/// Size in bytes of the last level cache of a socket, or of a typical one if
+/// the system does not tell
+KATANA_EXPORT size_t getLastLevelCacheSize();
+
 /**
  * parseCPUList parses cpuset information in "List format" as described in
  * cpuset(7) and available under /proc/self/status
@@ -5,6 +5,8 @@
 
 #include "katana/Cache.h"
 #include "katana/Manager.h"
+#include "katana/PropertySpillCache.h"
+#include "katana/Result.h"
 #include "katana/Time.h"
 
 namespace katana {
@@ -21,7 +23,8 @@ public:
   count_t FreeStandbyMemory(count_t goal) override;
 
   /// Client wants a property, see if we have it in the cache and if so return it and
-  /// make the memory active.
+  /// make the memory active.  Properties that were spilled are memory mapped from the
+  /// spill tier.
   /// Returns nullptr if manager does not have it in the cache
   std::shared_ptr<arrow::Table> GetProperty(const katana::URI& property_path);
 
@@ -33,7 +36,26 @@ public:
       const katana::URI& property_path,
       const std::shared_ptr<arrow::Table>& property);
 
-  CacheStats GetPropertyCacheStats() const { return cache_->GetStats(); }
+  /// Free at least \p goal bytes of standby memory, if there is that much, by
+  /// moving the least recently used properties to the spill tier.  Unlike
+  /// FreeStandbyMemory, which drops properties to relieve memory pressure quickly,
+  /// this writes each property to local storage first, so call it when there is
+  /// time for that, e.g., between phases of a workload.  Properties are dropped
+  /// if there is no spill tier.  Returns the bytes freed.
+  count_t SpillStandby(count_t goal);
+
+  /// Move properties that SpillStandby evicts to a second tier in a new directory
+  /// under \p dir, which holds at most \p capacity bytes.  Replaces the current
+  /// tier, if any.
+  ///
+  /// The tier is enabled at startup if KATANA_PROPERTY_SPILL_DIR names a directory,
+  /// with a capacity of KATANA_PROPERTY_SPILL_GB (default 64) gigabytes.
+  Result<void> EnableSpill(const std::string& dir, count_t capacity);
+  /// Drop the second tier and its files
+  void DisableSpill() { spill_.reset(); }
+  bool IsSpillEnabled() const { return spill_ != nullptr; }
+
+  CacheStats GetPropertyCacheStats() const;
   void LogMemoryStats(const std::string& message);
   struct Stats {
     void Log() const {
@@ -42,15 +64,24 @@ public:
           {
               {"bytes_loaded", bytes_loaded},
               {"gb_loaded", katana::ToGB(bytes_loaded)},
+              {"gb_spilled", katana::ToGB(bytes_spilled)},
+              {"gb_unspilled", katana::ToGB(bytes_unspilled)},
           });
     }
     count_t bytes_loaded{0LL};
+    /// Bytes of properties written to and mapped from the spill tier
+    count_t bytes_spilled{0LL};
+    count_t bytes_unspilled{0LL};
   };
   Stats GetStats() const { return stats; }
 
 private:
   void MakePropertyCache();
+  void Spill(
+      const katana::URI& property_path,
+      const std::shared_ptr<arrow::Table>& property);
   std::unique_ptr<PropertyCache> cache_;
+  std::unique_ptr<PropertySpillCache> spill_;
   Stats stats;
 };
 
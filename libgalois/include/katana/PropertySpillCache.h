@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include <arrow/table.h>
+
+#include "katana/Cache.h"
+#include "katana/Manager.h"
+#include "katana/Result.h"
+#include "katana/URI.h"
+
+namespace katana {
+
+/// Second tier of the property cache.  Properties evicted from memory are written to
+/// a local scratch directory in the Arrow IPC file format (Feather V2) and memory
+/// mapped back when they are wanted again, which is much cheaper than reading them
+/// from their storage when that is remote.
+///
+/// Keys are storage locations of properties, which are never rewritten in place, so
+/// a spilled file stays valid after it is mapped back.  Files stay in the tier until
+/// its byte budget evicts them, least recently used first.  Not thread safe.
+class KATANA_EXPORT PropertySpillCache {
+public:
+  /// Creates a tier that keeps at most \p capacity bytes of files in a new directory
+  /// under \p dir
+  static Result<std::unique_ptr<PropertySpillCache>> Make(
+      const std::string& dir, count_t capacity);
+
+  ~PropertySpillCache();
+  PropertySpillCache(const PropertySpillCache&) = delete;
+  PropertySpillCache& operator=(const PropertySpillCache&) = delete;
+  PropertySpillCache(PropertySpillCache&&) = delete;
+  PropertySpillCache& operator=(PropertySpillCache&&) = delete;
+
+  /// Writes \p property to the tier, unless the tier has it already.  Returns
+  /// true if the tier wrote and kept the file, and false if it had the property
+  /// already or the file was larger than its whole budget and was dropped
+  Result<bool> Insert(
+      const katana::URI& property_path,
+      const std::shared_ptr<arrow::Table>& property);
+
+  /// Returns the property memory mapped from the tier, or nullptr if the tier does
+  /// not have it
+  Result<std::shared_ptr<arrow::Table>> Get(const katana::URI& property_path);
+
+  bool Contains(const katana::URI& property_path) const {
+    return files_.Contains(property_path);
+  }
+
+  /// Bytes of spilled files
+  count_t size() const { return files_.size(); }
+  count_t capacity() const { return files_.capacity(); }
+  const std::string& dir() const { return dir_; }
+
+  CacheStats GetStats() const { return files_.GetStats(); }
+
+private:
+  struct SpillFile;
+
+  PropertySpillCache(std::string dir, count_t capacity);
+
+  std::string dir_;
+  uint64_t next_file_{0};
+  Cache<std::shared_ptr<SpillFile>> files_;
+};
+
+}  // namespace katana
@@ -20,7 +20,12 @@
 #ifndef KATANA_LIBGALOIS_KATANA_TILEDEXECUTOR_H_
 #define KATANA_LIBGALOIS_KATANA_TILEDEXECUTOR_H_
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
 #include "katana/Galois.h"
+#include "katana/HWTopo.h"
 #include "katana/NUMAArray.h"
 #include "katana/NoDerefIterator.h"
 #include "katana/config.h"
@@ -600,5 +605,244 @@ public:
   }
 };
 
+/**
+ * Runs pull kernels, in which every node reduces the values of its neighbors,
+ * a segment of neighbors at a time (CSR segmenting; Zhang et al., "Making
+ * Caches Work for Graph Analytics", BigData 2017). Neighbors are split into
+ * segments of consecutive ids whose values fit in the last level cache, and
+ * the edges into each segment are copied into a CSR of their own. While
+ * processing a segment, the random reads of neighbor values hit the cache;
+ * the partial result of each node goes to an accumulator that is written in
+ * node order.
+ *
+ * Building the segments takes two passes over the edges and memory for a copy
+ * of them, so an executor should be kept for all iterations of a kernel. When
+ * all neighbors fit in one segment, nothing is copied and Execute iterates
+ * for_each_neighbor directly.
+ *
+ * @tparam T type of the values that are reduced
+ * @tparam ForEachNeighbor type of for_each_neighbor; see
+ * MakeCacheBlockedPullExecutor
+ */
+template <typename T, typename ForEachNeighbor>
+class CacheBlockedPullExecutor {
+  using Node = uint32_t;
+
+  /// The edges from all nodes into one segment of neighbors
+  struct Segment {
+    /// nodes with neighbors in the segment, in increasing order
+    katana::NUMAArray<Node> nodes;
+    /// edges of nodes[i] are [index[i], index[i + 1])
+    katana::NUMAArray<uint64_t> index;
+    katana::NUMAArray<Node> neighbors;
+  };
+
+  /// Contiguous ranges of nodes that are counted and copied as a unit, so
+  /// that the segments list nodes in order
+  static constexpr size_t kBlocksPerThread = 8;
+
+  size_t num_nodes_;
+  size_t segment_size_;
+  ForEachNeighbor for_each_neighbor_;
+  /// Empty when there is at most one segment
+  std::vector<Segment> segments_;
+  katana::NUMAArray<T> accumulators_;
+
+  void Build() {
+    size_t num_segments = this->num_segments();
+    if (num_segments <= 1) {
+      return;
+    }
+    size_t num_blocks = std::min<size_t>(
+        num_nodes_, kBlocksPerThread * katana::getActiveThreads());
+    num_blocks = std::max<size_t>(num_blocks, 1);
+    size_t block_size = (num_nodes_ + num_blocks - 1) / num_blocks;
+
+    // Neighbors of one node per segment; touched lists the nonzero counts
+    struct Scratch {
+      std::vector<uint64_t> counts;
+      std::vector<uint64_t> cursors;
+      std::vector<uint32_t> touched;
+    };
+    katana::PerThreadStorage<Scratch> scratch;
+    katana::on_each([&](unsigned, unsigned) {
+      scratch.getLocal()->counts.assign(num_segments, 0);
+      scratch.getLocal()->cursors.assign(num_segments, 0);
+    });
+
+    auto count_node = [&](Scratch* local, Node n) {
+      for_each_neighbor_(n, [&](Node neighbor) {
+        uint32_t s = neighbor / segment_size_;
+        if (local->counts[s]++ == 0) {
+          local->touched.emplace_back(s);
+        }
+      });
+    };
+
+    // First pass: nodes and edges per block and segment
+    std::vector<uint64_t> block_nodes(num_blocks * num_segments);
+    std::vector<uint64_t> block_edges(num_blocks * num_segments);
+    katana::do_all(
+        katana::iterate(size_t{0}, num_blocks),
+        [&](size_t b) {
+          Scratch* local = scratch.getLocal();
+          size_t end = std::min(num_nodes_, (b + 1) * block_size);
+          for (size_t n = b * block_size; n < end; ++n) {
+            count_node(local, n);
+            for (uint32_t s : local->touched) {
+              block_nodes[b * num_segments + s] += 1;
+              block_edges[b * num_segments + s] += local->counts[s];
+              local->counts[s] = 0;
+            }
+            local->touched.clear();
+          }
+        },
+        katana::steal(), katana::chunk_size<1>(),
+        katana::loopname("CacheBlockedCount"), katana::no_stats());
+
+    // Turn the counts into the offsets at which blocks start in segments
+    segments_.resize(num_segments);
+    for (size_t s = 0; s < num_segments; ++s) {
+      uint64_t num_segment_nodes = 0;
+      uint64_t num_segment_edges = 0;
+      for (size_t b = 0; b < num_blocks; ++b) {
+        uint64_t nodes = block_nodes[b * num_segments + s];
+        uint64_t edges = block_edges[b * num_segments + s];
+        block_nodes[b * num_segments + s] = num_segment_nodes;
+        block_edges[b * num_segments + s] = num_segment_edges;
+        num_segment_nodes += nodes;
+        num_segment_edges += edges;
+      }
+      segments_[s].nodes.allocateBlocked(num_segment_nodes);
+      segments_[s].index.allocateBlocked(num_segment_nodes + 1);
+      segments_[s].index[0] = 0;
+      segments_[s].neighbors.allocateBlocked(num_segment_edges);
+    }
+
+    // Second pass: copy the edges
+    katana::do_all(
+        katana::iterate(size_t{0}, num_blocks),
+        [&](size_t b) {
+          Scratch* local = scratch.getLocal();
+          uint64_t* next_node = &block_nodes[b * num_segments];
+          uint64_t* next_edge = &block_edges[b * num_segments];
+          size_t end = std::min(num_nodes_, (b + 1) * block_size);
+          for (size_t n = b * block_size; n < end; ++n) {
+            count_node(local, n);
+            for (uint32_t s : local->touched) {
+              Segment& segment = segments_[s];
+              segment.nodes[next_node[s]] = n;
+              local->cursors[s] = next_edge[s];
+              next_edge[s] += local->counts[s];
+              segment.index[++next_node[s]] = next_edge[s];
+              local->counts[s] = 0;
+            }
+            for_each_neighbor_(n, [&](Node neighbor) {
+              uint32_t s = neighbor / segment_size_;
+              segments_[s].neighbors[local->cursors[s]++] = neighbor;
+            });
+            local->touched.clear();
+          }
+        },
+        katana::steal(), katana::chunk_size<1>(),
+        katana::loopname("CacheBlockedCopy"), katana::no_stats());
+  }
+
+public:
+  /// See MakeCacheBlockedPullExecutor
+  CacheBlockedPullExecutor(
+      size_t num_nodes, ForEachNeighbor for_each_neighbor, size_t segment_size)
+      : num_nodes_(num_nodes),
+        segment_size_(segment_size),
+        for_each_neighbor_(std::move(for_each_neighbor)) {
+    KATANA_LOG_DEBUG_ASSERT(segment_size_ > 0);
+    accumulators_.allocateBlocked(num_nodes_);
+    Build();
+  }
+
+  size_t num_segments() const {
+    return (num_nodes_ + segment_size_ - 1) / segment_size_;
+  }
+
+  /**
+   * For every node n, reduce gather(m) over the neighbors m of n, starting
+   * from identity, and call apply(n, result). Calls to gather and reduce for
+   * different nodes run in parallel, as do calls to apply, but all calls to
+   * gather happen before the first call to apply.
+   *
+   * @param identity identity of reduce
+   * @param gather gather(m) returns the T that neighbor m contributes
+   * @param reduce reduce(a, b) combines two Ts, and must be associative and
+   * commutative
+   * @param apply apply(n, result) consumes the result of node n
+   */
+  template <typename Gather, typename Reduce, typename Apply>
+  void Execute(
+      const T& identity, const Gather& gather, const Reduce& reduce,
+      const Apply& apply) {
+    if (segments_.empty()) {
+      katana::do_all(
+          katana::iterate(size_t{0}, num_nodes_),
+          [&](size_t n) {
+            T result = identity;
+            for_each_neighbor_(n, [&](Node neighbor) {
+              result = reduce(result, gather(neighbor));
+            });
+            accumulators_[n] = result;
+          },
+          katana::steal(), katana::chunk_size<64>(),
+          katana::loopname("CacheBlockedUnsegmented"), katana::no_stats());
+    } else {
+      katana::do_all(
+          katana::iterate(size_t{0}, num_nodes_),
+          [&](size_t n) { accumulators_[n] = identity; },
+          katana::loopname("CacheBlockedReset"), katana::no_stats());
+    }
+
+    for (Segment& segment : segments_) {
+      katana::do_all(
+          katana::iterate(size_t{0}, segment.nodes.size()),
+          [&](size_t i) {
+            T partial = identity;
+            for (uint64_t e = segment.index[i]; e < segment.index[i + 1]; ++e) {
+              partial = reduce(partial, gather(segment.neighbors[e]));
+            }
+            Node n = segment.nodes[i];
+            accumulators_[n] = reduce(accumulators_[n], partial);
+          },
+          katana::steal(), katana::chunk_size<64>(),
+          katana::loopname("CacheBlockedSegment"), katana::no_stats());
+    }
+
+    katana::do_all(
+        katana::iterate(size_t{0}, num_nodes_),
+        [&](size_t n) { apply(n, accumulators_[n]); },
+        katana::loopname("CacheBlockedApply"), katana::no_stats());
+  }
+};
+
+/// Number of values of value_size bytes that fit in half of the last level
+/// cache, leaving the other half to the segment being streamed
+inline size_t
+CacheBlockedSegmentSize(size_t value_size) {
+  return std::max<size_t>(1, katana::getLastLevelCacheSize() / 2 / value_size);
+}
+
+/**
+ * @param num_nodes number of nodes of the graph
+ * @param for_each_neighbor for_each_neighbor(n, fn) calls fn(m) for every
+ * neighbor m of node n, the nodes whose values n pulls. The executor keeps a
+ * copy, so anything it refers to must outlive the executor.
+ * @param segment_size number of consecutive neighbor ids per segment
+ */
+template <typename T, typename ForEachNeighbor>
+CacheBlockedPullExecutor<T, ForEachNeighbor>
+MakeCacheBlockedPullExecutor(
+    size_t num_nodes, ForEachNeighbor for_each_neighbor,
+    size_t segment_size = CacheBlockedSegmentSize(sizeof(T))) {
+  return CacheBlockedPullExecutor<T, ForEachNeighbor>(
+      num_nodes, std::move(for_each_neighbor), segment_size);
+}
+
 }  // namespace katana
 #endif
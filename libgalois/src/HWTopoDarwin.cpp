@@ -133,6 +133,19 @@ katana::bindThreadSelf([[maybe_unused]] unsigned osContext) {
   return true;
 }
 
+size_t
+katana::getLastLevelCacheSize() {
+  // Apple silicon has no L3 and reports only the L2 of its clusters
+  for (const char* name : {"hw.l3cachesize", "hw.l2cachesize"}) {
+    int64_t size = 0;
+    size_t len = sizeof(size);
+    if (sysctlbyname(name, &size, &len, nullptr, 0) == 0 && size > 0) {
+      return size;
+    }
+  }
+  return 8UL << 20;
+}
+
 HWTopoInfo
 katana::getHWTopo() {
   static SimpleLock lock;
@@ -18,6 +18,7 @@
  */
 
 #include <dlfcn.h>
+#include <unistd.h>
 
 #include <algorithm>
 #include <array>
@@ -319,6 +320,17 @@ katana::getHWTopo() {
   return *data;
 }
 
+size_t
+katana::getLastLevelCacheSize() {
+  // glibc reads these from cpuid, and reports 0 when it cannot
+  for (int name : {_SC_LEVEL3_CACHE_SIZE, _SC_LEVEL2_CACHE_SIZE}) {
+    if (long size = sysconf(name); size > 0) {
+      return size;
+    }
+  }
+  return 8UL << 20;
+}
+
 //! binds current thread to OS HW context "proc"
 bool
 katana::bindThreadSelf([[maybe_unused]] unsigned osContext) {
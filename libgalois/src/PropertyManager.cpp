@@ -1,6 +1,7 @@
 #include "katana/PropertyManager.h"
 
 #include "katana/ArrowInterchange.h"
+#include "katana/Env.h"
 #include "katana/Logging.h"
 #include "katana/MemorySupervisor.h"
 #include "katana/ProgressTracer.h"
@@ -21,8 +22,47 @@ katana::PropertyManager::MakePropertyCache() {
       });
 }
 
-katana::PropertyManager::PropertyManager() { MakePropertyCache(); }
-katana::PropertyManager::~PropertyManager() { cache_.reset(); }
+katana::PropertyManager::PropertyManager() {
+  MakePropertyCache();
+
+  std::string spill_dir;
+  if (katana::GetEnv("KATANA_PROPERTY_SPILL_DIR", &spill_dir)) {
+    double spill_gb = 64;
+    katana::GetEnv("KATANA_PROPERTY_SPILL_GB", &spill_gb);
+    auto capacity = static_cast<count_t>(spill_gb * (1LL << 30));
+    if (auto res = EnableSpill(spill_dir, capacity); !res) {
+      KATANA_LOG_WARN("not spilling properties: {}", res.error());
+    }
+  }
+}
+katana::PropertyManager::~PropertyManager() {
+  cache_.reset();
+  spill_.reset();
+}
+
+katana::Result<void>
+katana::PropertyManager::EnableSpill(const std::string& dir, count_t capacity) {
+  spill_ = KATANA_CHECKED(katana::PropertySpillCache::Make(dir, capacity));
+  katana::GetTracer().GetActiveSpan().Log(
+      "property spill enabled", {
+                                    {"dir", spill_->dir()},
+                                    {"capacity_gb", ToGB(capacity)},
+                                });
+  return katana::ResultSuccess();
+}
+
+katana::CacheStats
+katana::PropertyManager::GetPropertyCacheStats() const {
+  auto stats = cache_->GetStats();
+  if (spill_) {
+    auto spill_stats = spill_->GetStats();
+    stats.spill_get_count = spill_stats.get_count;
+    stats.spill_get_hit_count = spill_stats.get_hit_count;
+    stats.spill_insert_count = spill_stats.insert_count;
+    stats.spill_bytes = spill_->size();
+  }
+  return stats;
+}
 
 std::shared_ptr<arrow::Table>
 katana::PropertyManager::GetProperty(const katana::URI& property_path) {
@@ -41,6 +81,26 @@ katana::PropertyManager::GetProperty(const katana::URI& property_path) {
     return property.value();
   }
   MemorySupervisor::Get().CheckPressure();
+
+  if (spill_) {
+    auto spilled_res = spill_->Get(property_path);
+    if (!spilled_res) {
+      KATANA_LOG_WARN(
+          "reading spilled property {}: {}", property_path,
+          spilled_res.error());
+    } else if (spilled_res.value()) {
+      // Mapped memory is active memory, the supervisor does not track it
+      auto bytes = katana::ApproxTableMemUse(spilled_res.value());
+      stats.bytes_unspilled += bytes;
+      katana::GetTracer().GetActiveSpan().Log(
+          "property spill get", {
+                                    {"storage_name", property_path.BaseName()},
+                                    {"approx_size_gb", ToGB(bytes)},
+                                });
+      return spilled_res.value();
+    }
+  }
+
   katana::GetTracer().GetActiveSpan().Log(
       "property cache get not found",
       {
@@ -97,3 +157,46 @@ katana::PropertyManager::FreeStandbyMemory(count_t goal) {
                });
   return reclaim;
 }
+
+katana::count_t
+katana::PropertyManager::SpillStandby(count_t goal) {
+  auto scope = katana::GetTracer().StartActiveSpan("spill standby memory");
+  scope.span().Log(
+      "before", {
+                    {"goal_gb", ToGB(goal)},
+                    {"cache_gb", ToGB(cache_->size())},
+                });
+
+  auto freed = static_cast<count_t>(cache_->Reclaim(
+      goal, [this](
+                const katana::URI& property_path,
+                const std::shared_ptr<arrow::Table>& property) {
+        Spill(property_path, property);
+      }));
+  MemorySupervisor::Get().PutStandby(Name(), freed);
+
+  scope.span().Log(
+      "after", {
+                   {"freed_gb", ToGB(freed)},
+                   {"cache_gb", ToGB(cache_->size())},
+               });
+  return freed;
+}
+
+void
+katana::PropertyManager::Spill(
+    const katana::URI& property_path,
+    const std::shared_ptr<arrow::Table>& property) {
+  if (!spill_) {
+    return;
+  }
+  auto bytes = static_cast<count_t>(katana::ApproxTableMemUse(property));
+  auto res = spill_->Insert(property_path, property);
+  if (!res) {
+    KATANA_LOG_WARN("spilling property {}: {}", property_path, res.error());
+    return;
+  }
+  if (res.value()) {
+    stats.bytes_spilled += bytes;
+  }
+}
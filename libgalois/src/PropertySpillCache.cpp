@@ -0,0 +1,125 @@
+#include "katana/PropertySpillCache.h"
+
+#include <arrow/io/file.h>
+#include <arrow/ipc/writer.h>
+#include <boost/filesystem.hpp>
+
+#include "katana/ArrowInterchange.h"
+#include "katana/ErrorCode.h"
+#include "katana/Logging.h"
+#include "katana/ProgressTracer.h"
+#include "katana/Time.h"
+
+namespace fs = boost::filesystem;
+
+/// A file in the spill directory, removed when the tier evicts it.  Tables mapped
+/// from the file stay valid after it is removed.
+struct katana::PropertySpillCache::SpillFile {
+  std::string path;
+  count_t bytes{};
+
+  explicit SpillFile(std::string path_) : path(std::move(path_)) {}
+  SpillFile(const SpillFile&) = delete;
+  SpillFile& operator=(const SpillFile&) = delete;
+
+  ~SpillFile() {
+    boost::system::error_code err;
+    fs::remove(path, err);
+    if (err) {
+      KATANA_LOG_WARN("removing spilled property {}: {}", path, err.message());
+    }
+  }
+};
+
+katana::PropertySpillCache::PropertySpillCache(
+    std::string dir, count_t capacity)
+    : dir_(std::move(dir)),
+      files_(capacity, [](const std::shared_ptr<SpillFile>& file) {
+        return file->bytes;
+      }) {}
+
+katana::PropertySpillCache::~PropertySpillCache() {
+  files_.clear();
+  boost::system::error_code err;
+  fs::remove_all(dir_, err);
+  if (err) {
+    KATANA_LOG_WARN("removing spill directory {}: {}", dir_, err.message());
+  }
+}
+
+katana::Result<std::unique_ptr<katana::PropertySpillCache>>
+katana::PropertySpillCache::Make(const std::string& dir, count_t capacity) {
+  if (capacity <= 0) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "spill capacity must be positive: {}",
+        capacity);
+  }
+  boost::system::error_code err;
+  fs::create_directories(dir, err);
+  if (err) {
+    return KATANA_ERROR(
+        std::error_code(err.value(), err.category()),
+        "creating spill directory {}: {}", dir, err.message());
+  }
+  fs::path spill_dir =
+      fs::unique_path(fs::path(dir) / "katana-properties-%%%%-%%%%-%%%%");
+  fs::create_directory(spill_dir, err);
+  if (err) {
+    return KATANA_ERROR(
+        std::error_code(err.value(), err.category()),
+        "creating spill directory {}: {}", spill_dir.string(), err.message());
+  }
+  return std::unique_ptr<PropertySpillCache>(
+      new PropertySpillCache(spill_dir.string(), capacity));
+}
+
+katana::Result<bool>
+katana::PropertySpillCache::Insert(
+    const katana::URI& property_path,
+    const std::shared_ptr<arrow::Table>& property) {
+  if (files_.Contains(property_path)) {
+    return false;
+  }
+
+  auto file = std::make_shared<SpillFile>(
+      fmt::format("{}/{:06}.arrow", dir_, next_file_++));
+  auto out = KATANA_CHECKED_CONTEXT(
+      arrow::io::FileOutputStream::Open(file->path), "creating {}",
+      file->path);
+  auto writer = KATANA_CHECKED_CONTEXT(
+      arrow::ipc::MakeFileWriter(out, property->schema()), "writing {}",
+      file->path);
+  KATANA_CHECKED_CONTEXT(
+      writer->WriteTable(*property), "writing {}", file->path);
+  KATANA_CHECKED_CONTEXT(writer->Close(), "writing {}", file->path);
+  file->bytes = KATANA_CHECKED(out->Tell());
+  KATANA_CHECKED_CONTEXT(out->Close(), "closing {}", file->path);
+
+  // Files larger than the whole budget are not inserted, and so removed here
+  files_.Insert(property_path, file);
+  bool kept = files_.Contains(property_path);
+  katana::GetTracer().GetActiveSpan().Log(
+      "property spill insert", {
+                                   {"storage_name", property_path.BaseName()},
+                                   {"file_size_gb", ToGB(file->bytes)},
+                                   {"spill_gb", ToGB(files_.size())},
+                                   {"kept", kept},
+                               });
+  return kept;
+}
+
+katana::Result<std::shared_ptr<arrow::Table>>
+katana::PropertySpillCache::Get(const katana::URI& property_path) {
+  auto file = files_.Get(property_path);
+  if (!file.has_value()) {
+    return std::shared_ptr<arrow::Table>(nullptr);
+  }
+  const std::string& path = file.value()->path;
+
+  // Arrays read from a mapped file point into the mapping, so nothing is copied
+  // until pages are touched
+  auto in = KATANA_CHECKED_CONTEXT(
+      arrow::io::MemoryMappedFile::Open(path, arrow::io::FileMode::READ),
+      "mapping {}", path);
+  return KATANA_CHECKED_CONTEXT(ReadArrowIpcFile(in), "reading {}", path);
+}
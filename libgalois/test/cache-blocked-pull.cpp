@@ -0,0 +1,109 @@
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "katana/Galois.h"
+#include "katana/TiledExecutor.h"
+
+namespace {
+
+using Adjacency = std::vector<std::vector<uint32_t>>;
+
+// Random neighbors, with duplicates and nodes without neighbors
+Adjacency
+MakeAdjacency(uint32_t num_nodes, uint32_t max_degree) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<uint32_t> any_node(0, num_nodes - 1);
+  std::uniform_int_distribution<uint32_t> degree(0, max_degree);
+
+  Adjacency adjacency(num_nodes);
+  for (auto& neighbors : adjacency) {
+    for (uint32_t i = degree(gen); i > 0; --i) {
+      neighbors.emplace_back(any_node(gen));
+    }
+  }
+  return adjacency;
+}
+
+void
+TestSum(const Adjacency& adjacency, size_t segment_size) {
+  uint32_t num_nodes = adjacency.size();
+  auto executor = katana::MakeCacheBlockedPullExecutor<uint64_t>(
+      num_nodes,
+      [&](uint32_t n, const auto& fn) {
+        for (uint32_t m : adjacency[n]) {
+          fn(m);
+        }
+      },
+      segment_size);
+  KATANA_LOG_ASSERT(
+      executor.num_segments() ==
+      (num_nodes + segment_size - 1) / segment_size);
+
+  std::vector<uint64_t> values(num_nodes);
+  for (uint32_t n = 0; n < num_nodes; ++n) {
+    values[n] = 3 * n + 1;
+  }
+
+  // Run twice to check that the accumulators are reset between runs
+  for (int i = 0; i < 2; ++i) {
+    std::vector<uint64_t> results(num_nodes);
+    executor.Execute(
+        0, [&](uint32_t m) { return values[m]; },
+        [](uint64_t a, uint64_t b) { return a + b; },
+        [&](uint32_t n, uint64_t sum) { results[n] = sum; });
+
+    for (uint32_t n = 0; n < num_nodes; ++n) {
+      uint64_t expected = 0;
+      for (uint32_t m : adjacency[n]) {
+        expected += values[m];
+      }
+      KATANA_LOG_VASSERT(
+          results[n] == expected, "node {}: {}, expected {}", n, results[n],
+          expected);
+    }
+  }
+}
+
+// Apply runs after all gathers, so it may overwrite the values gathered
+void
+TestJacobi(const Adjacency& adjacency) {
+  uint32_t num_nodes = adjacency.size();
+  auto executor = katana::MakeCacheBlockedPullExecutor<uint64_t>(
+      num_nodes,
+      [&](uint32_t n, const auto& fn) {
+        for (uint32_t m : adjacency[n]) {
+          fn(m);
+        }
+      },
+      17);
+
+  std::vector<uint64_t> values(num_nodes, 1);
+  executor.Execute(
+      0, [&](uint32_t m) { return values[m]; },
+      [](uint64_t a, uint64_t b) { return a + b; },
+      [&](uint32_t n, uint64_t sum) { values[n] = sum; });
+
+  for (uint32_t n = 0; n < num_nodes; ++n) {
+    KATANA_LOG_ASSERT(values[n] == adjacency[n].size());
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::GaloisRuntime sys;
+  katana::setActiveThreads(4);
+
+  Adjacency adjacency = MakeAdjacency(1000, 20);
+  for (size_t segment_size : {1, 7, 64, 999, 1000, 5000}) {
+    TestSum(adjacency, segment_size);
+  }
+  TestSum(MakeAdjacency(1, 3), 1);
+  TestJacobi(adjacency);
+
+  KATANA_LOG_ASSERT(katana::CacheBlockedSegmentSize(sizeof(float)) > 0);
+
+  return 0;
+}
@@ -37,6 +37,8 @@ printMyTopo() {
               << " osContext: " << c.osContext
               << " osNumaNode: " << c.osNumaNode << "\n";
   }
+  std::cout << "last level cache: " << katana::getLastLevelCacheSize()
+            << " bytes\n";
 }
 
 void
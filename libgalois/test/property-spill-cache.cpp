@@ -0,0 +1,177 @@
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+#include <boost/filesystem.hpp>
+
+#include "katana/ArrowInterchange.h"
+#include "katana/Logging.h"
+#include "katana/MemoryPolicy.h"
+#include "katana/MemorySupervisor.h"
+#include "katana/PropertyManager.h"
+#include "katana/PropertySpillCache.h"
+#include "katana/URI.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+constexpr int64_t kRows = 1 << 16;
+
+std::shared_ptr<arrow::Table>
+MakeProperty(const std::string& name, int64_t first) {
+  arrow::Int64Builder builder;
+  for (int64_t i = 0; i < kRows; ++i) {
+    KATANA_LOG_ASSERT(builder.Append(first + i).ok());
+  }
+  std::shared_ptr<arrow::Array> array;
+  KATANA_LOG_ASSERT(builder.Finish(&array).ok());
+  return arrow::Table::Make(
+      arrow::schema({arrow::field(name, arrow::int64())}), {array});
+}
+
+katana::URI
+MakeKey(const std::string& name) {
+  auto uri_res = katana::URI::Make("/remote/graph/" + name);
+  KATANA_LOG_ASSERT(uri_res);
+  return uri_res.value();
+}
+
+bool
+Inserted(
+    katana::PropertySpillCache* spill, const std::string& name,
+    const std::shared_ptr<arrow::Table>& property) {
+  auto res = spill->Insert(MakeKey(name), property);
+  KATANA_LOG_VASSERT(res, "Insert: {}", res.error());
+  return res.value();
+}
+
+size_t
+CountFiles(const std::string& dir) {
+  return std::distance(fs::directory_iterator(dir), fs::directory_iterator());
+}
+
+void
+TestSpillCache(const std::string& scratch) {
+  auto a = MakeProperty("a", 0);
+  auto b = MakeProperty("b", kRows);
+  auto c = MakeProperty("c", 2 * kRows);
+  // Room for two of the properties
+  auto capacity = static_cast<katana::count_t>(
+      2.5 * static_cast<double>(katana::ApproxTableMemUse(a)));
+
+  std::string dir;
+  {
+    auto spill_res = katana::PropertySpillCache::Make(scratch, capacity);
+    KATANA_LOG_VASSERT(spill_res, "Make: {}", spill_res.error());
+    std::unique_ptr<katana::PropertySpillCache> spill =
+        std::move(spill_res.value());
+    dir = spill->dir();
+
+    KATANA_LOG_ASSERT(Inserted(spill.get(), "a", a));
+    KATANA_LOG_ASSERT(Inserted(spill.get(), "b", b));
+    // Inserting again does not write again
+    KATANA_LOG_ASSERT(!Inserted(spill.get(), "a", a));
+    KATANA_LOG_ASSERT(CountFiles(dir) == 2);
+
+    auto a_res = spill->Get(MakeKey("a"));
+    KATANA_LOG_VASSERT(a_res, "Get: {}", a_res.error());
+    KATANA_LOG_ASSERT(a_res.value() && a_res.value()->Equals(*a));
+
+    // b is least recently used, so c replaces it
+    KATANA_LOG_ASSERT(Inserted(spill.get(), "c", c));
+    KATANA_LOG_ASSERT(CountFiles(dir) == 2);
+    KATANA_LOG_ASSERT(!spill->Contains(MakeKey("b")));
+    auto b_res = spill->Get(MakeKey("b"));
+    KATANA_LOG_ASSERT(b_res && !b_res.value());
+
+    // Mapped tables outlive their files
+    auto c_res = spill->Get(MakeKey("c"));
+    KATANA_LOG_ASSERT(c_res && c_res.value());
+    std::shared_ptr<arrow::Table> mapped_c = c_res.value();
+    KATANA_LOG_ASSERT(Inserted(spill.get(), "b", b));
+    KATANA_LOG_ASSERT(Inserted(spill.get(), "a", a));
+    KATANA_LOG_ASSERT(!spill->Contains(MakeKey("c")));
+    KATANA_LOG_ASSERT(mapped_c->Equals(*c));
+
+    auto stats = spill->GetStats();
+    KATANA_LOG_ASSERT(stats.get_count == 3);
+    KATANA_LOG_ASSERT(stats.get_hit_count == 2);
+    KATANA_LOG_ASSERT(spill->size() <= capacity);
+  }
+  KATANA_LOG_ASSERT(!fs::exists(dir));
+
+  // Files larger than the budget are dropped
+  {
+    auto spill_res = katana::PropertySpillCache::Make(scratch, 1024);
+    KATANA_LOG_VASSERT(spill_res, "Make: {}", spill_res.error());
+    std::unique_ptr<katana::PropertySpillCache> spill =
+        std::move(spill_res.value());
+    KATANA_LOG_ASSERT(!Inserted(spill.get(), "a", a));
+    KATANA_LOG_ASSERT(!spill->Contains(MakeKey("a")));
+    KATANA_LOG_ASSERT(CountFiles(spill->dir()) == 0);
+  }
+
+  KATANA_LOG_ASSERT(!katana::PropertySpillCache::Make(scratch, 0));
+}
+
+void
+TestPropertyManager(const std::string& scratch) {
+  // Only reclaim when told to
+  katana::MemorySupervisor::Get().SetPolicy(
+      std::make_unique<katana::MemoryPolicyNull>());
+  katana::PropertyManager* pm =
+      katana::MemorySupervisor::Get().GetPropertyManager();
+  KATANA_LOG_ASSERT(pm->EnableSpill(scratch, 1LL << 30));
+
+  auto a = MakeProperty("a", 0);
+  auto bytes = static_cast<katana::count_t>(katana::ApproxTableMemUse(a));
+
+  // Reclaiming memory under pressure drops properties without spilling them
+  pm->PutProperty(MakeKey("a"), a);
+  KATANA_LOG_ASSERT(pm->FreeStandbyMemory(bytes) == bytes);
+  auto stats = pm->GetPropertyCacheStats();
+  KATANA_LOG_ASSERT(stats.spill_insert_count == 0);
+  KATANA_LOG_ASSERT(!pm->GetProperty(MakeKey("a")));
+
+  pm->PutProperty(MakeKey("a"), a);
+  KATANA_LOG_ASSERT(pm->SpillStandby(bytes) == bytes);
+  stats = pm->GetPropertyCacheStats();
+  KATANA_LOG_ASSERT(stats.spill_insert_count == 1);
+  KATANA_LOG_ASSERT(stats.spill_bytes > 0);
+
+  std::shared_ptr<arrow::Table> unspilled = pm->GetProperty(MakeKey("a"));
+  KATANA_LOG_ASSERT(unspilled && unspilled->Equals(*a));
+  KATANA_LOG_ASSERT(!pm->GetProperty(MakeKey("missing")));
+
+  stats = pm->GetPropertyCacheStats();
+  KATANA_LOG_ASSERT(stats.spill_get_count == 3);
+  KATANA_LOG_ASSERT(stats.spill_get_hit_count == 1);
+  KATANA_LOG_ASSERT(pm->GetStats().bytes_spilled == bytes);
+
+  // A property that the spill tier drops does not count as spilled
+  pm->DisableSpill();
+  KATANA_LOG_ASSERT(pm->EnableSpill(scratch, 1024));
+  pm->PutProperty(MakeKey("b"), MakeProperty("b", kRows));
+  KATANA_LOG_ASSERT(pm->SpillStandby(bytes) == bytes);
+  KATANA_LOG_ASSERT(pm->GetStats().bytes_spilled == bytes);
+
+  pm->DisableSpill();
+  KATANA_LOG_ASSERT(!pm->IsSpillEnabled());
+}
+
+}  // namespace
+
+int
+main() {
+  fs::path scratch =
+      fs::temp_directory_path() / fs::unique_path("spill-test-%%%%-%%%%");
+
+  TestSpillCache(scratch.string());
+  TestPropertyManager(scratch.string());
+
+  fs::remove_all(scratch);
+  return 0;
+}
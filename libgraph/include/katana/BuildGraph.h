@@ -7,7 +7,9 @@
 
 #include <functional>
 #include <iostream>
+#include <optional>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -97,11 +99,20 @@ struct LabelRule {
   LabelRule(const std::string& label) : LabelRule(label, false, false, label) {}
 };
 
+/// A file of rows written out by a spilling PropertyGraphBuilder
+struct SpillFile {
+  std::string path;
+  size_t rows;
+};
+
 struct PropertiesState {
   std::unordered_map<std::string, size_t> keys;
   ArrowFields schema;
   ArrayBuilders builders;
   std::vector<ArrowArrays> chunks;
+  // rows before chunks[i][0] that have been spilled, in order
+  size_t spilled_rows{0};
+  std::vector<SpillFile> spill_files;
 };
 
 struct LabelsState {
@@ -110,6 +121,9 @@ struct LabelsState {
   BooleanBuilders builders;
   std::vector<ArrowArrays> chunks;
   std::unordered_map<std::string, std::string> reverse_schema;
+  // rows before chunks[i][0] that have been spilled, in order
+  size_t spilled_rows{0};
+  std::vector<SpillFile> spill_files;
 };
 
 struct TopologyState {
@@ -131,6 +145,37 @@ struct TopologyState {
   std::unordered_map<size_t, std::string> destinations_intermediate;
 };
 
+/// SpillOptions make a PropertyGraphBuilder write rows and edges to local
+/// files as they are added instead of keeping all of them until Finish.
+/// Edges are sorted into CSR order with an external merge sort, and the
+/// final tables are assembled one column at a time, so that importing needs
+/// little more memory than the graph that is built. Only the map from node
+/// IDs to node indexes and the per node edge counts stay in memory.
+struct SpillOptions {
+  /// local directory in which a temporary spill directory is created
+  std::string dir;
+  /// approximate bound on the memory used by buffered rows and edges
+  size_t memory_budget{size_t{1} << 30};
+};
+
+struct SpillState {
+  SpillOptions options;
+  // directory holding the spill files of this builder, created on first use
+  std::string dir;
+  size_t next_file{0};
+  // complete chunks of nodes and edges when buffered memory was last checked
+  size_t checked_chunks{0};
+  // index of the edge at sources[0] and destinations[0]
+  size_t edges_base{0};
+  // files of edges sorted by (source, edge index)
+  std::vector<SpillFile> edge_runs;
+  // (edge index, source, destination) of edges with an endpoint that can
+  // only be resolved at the end
+  std::vector<std::tuple<uint64_t, uint32_t, uint32_t>> pending_edges;
+  // first error hit while spilling, reported by Finish
+  std::optional<katana::CopyableErrorInfo> error;
+};
+
 struct WriterProperties {
   NullMaps null_arrays;
   std::shared_ptr<arrow::Array> false_array;
@@ -177,6 +222,19 @@ struct KATANA_EXPORT GraphComponents {
   }
 };
 
+/// GraphFragment is a part of a graph built by a PropertyGraphBuilder from a
+/// part of an input. Its edges may refer to nodes of other fragments by ID;
+/// see MergeGraphFragments.
+struct GraphFragment {
+  GraphComponent nodes;
+  /// edges in the order they were added rather than in CSR order
+  GraphComponent edges;
+  size_t num_nodes{0};
+  size_t num_edges{0};
+  /// node IDs, and edge endpoints as fragment node indexes or IDs
+  TopologyState topology;
+};
+
 class KATANA_EXPORT PropertyGraphBuilder {
   WriterProperties properties_;
   PropertiesState node_properties_;
@@ -188,9 +246,13 @@ class KATANA_EXPORT PropertyGraphBuilder {
   size_t edges_;
   bool building_node_;
   bool building_edge_;
+  std::optional<SpillState> spill_;
 
 public:
   PropertyGraphBuilder(size_t chunk_size);
+  /// A builder that spills to files under \p spill_options.dir
+  PropertyGraphBuilder(size_t chunk_size, SpillOptions spill_options);
+  ~PropertyGraphBuilder();
 
   bool StartNode();
   bool StartNode(const std::string& id);
@@ -222,6 +284,9 @@ public:
   void AddLabel(const std::string& name);
 
   Result<GraphComponents> Finish(bool verbose = true);
+  /// Like Finish, but leaves edges to nodes that were not added to this
+  /// builder unresolved so that the fragment can be merged with others
+  Result<GraphFragment> FinishFragment();
 
   size_t GetNodeIndex();
   size_t GetNodes();
@@ -230,8 +295,23 @@ public:
 private:
   void ResolveIntermediateIDs();
   GraphComponent BuildFinalEdges(bool verbose);
+
+  /// Write out complete chunks and edges if they exceed the memory budget;
+  /// called between nodes and edges
+  void MaybeSpill();
+  Result<void> SpillRows(bool all);
+  Result<void> SpillEdges();
+  Result<std::string> NewSpillPath(const std::string& prefix);
+  Result<GraphComponents> FinishSpilled(bool verbose);
 };
 
+/// Merge graph fragments into one graph. Nodes are numbered in the order of
+/// the fragments, and edges are resolved as if all fragments had been added
+/// to one builder in order: to the first node with a given ID, or else to a
+/// new node without properties.
+KATANA_EXPORT Result<GraphComponents> MergeGraphFragments(
+    std::vector<GraphFragment>&& fragments, size_t chunk_size);
+
 KATANA_EXPORT Result<std::unique_ptr<katana::PropertyGraph>>
 ConvertToPropertyGraph(
     GraphComponents&& graph_comps, katana::TxnContext* txn_ctx);
@@ -1,9 +1,12 @@
 #ifndef KATANA_LIBGRAPH_KATANA_ENTITYINDEX_H_
 #define KATANA_LIBGRAPH_KATANA_ENTITYINDEX_H_
 
+#include <algorithm>
 #include <set>
 #include <string>
+#include <type_traits>
 #include <variant>
+#include <vector>
 
 #include <arrow/api.h>
 #include <arrow/array.h>
@@ -11,6 +14,7 @@
 #include <boost/iterator/iterator_categories.hpp>
 #include <boost/iterator/iterator_facade.hpp>
 
+#include "katana/NUMAArray.h"
 #include "katana/Result.h"
 #include "katana/config.h"
 
@@ -18,6 +22,12 @@ namespace katana {
 
 // EntityIndex provides an interface similar to an ordered container
 // over a single property.
+//
+// Two backends are available, selected at build time. By default
+// (KATANA_USE_FLAT_ENTITY_INDEX) an index is an array of entity ids sorted by
+// property value plus a sparse array of fence keys sampled from it, which
+// costs sizeof(node_or_edge) bytes per entity and is searched without
+// chasing pointers. Otherwise an index is a std::multiset of entity ids.
 template <typename node_or_edge>
 class KATANA_EXPORT EntityIndex {
 public:
@@ -33,6 +43,29 @@ public:
       IndexID, bool, uint8_t, int64_t, uint64_t, double_t, std::string_view*>;
 
   // EntityIndex::iterator returns a sequence of node or edge ids.
+#if defined(KATANA_USE_FLAT_ENTITY_INDEX)
+  class iterator
+      : public boost::iterator_facade<
+            iterator, const node_or_edge, boost::random_access_traversal_tag> {
+  public:
+    explicit iterator(const node_or_edge* ptr) : ptr_(ptr) {}
+    iterator() = default;
+
+  private:
+    friend class boost::iterator_core_access;
+
+    const node_or_edge& dereference() const { return *ptr_; }
+    bool equal(const iterator& other) const { return ptr_ == other.ptr_; }
+    void increment() { ++ptr_; }
+    void decrement() { --ptr_; }
+    void advance(std::ptrdiff_t n) { ptr_ += n; }
+    std::ptrdiff_t distance_to(const iterator& other) const {
+      return other.ptr_ - ptr_;
+    }
+
+    const node_or_edge* ptr_{nullptr};
+  };
+#else
   using base_iterator = typename std::multiset<set_key_type>::iterator;
   class iterator : public base_iterator {
   public:
@@ -42,6 +75,7 @@ public:
       return std::get<IndexID>(base_iterator::operator*()).id;
     }
   };
+#endif
 
   EntityIndex(std::string property_name)
       : property_name_(std::move(property_name)) {}
@@ -62,6 +96,51 @@ public:
   virtual Result<void> BuildFromProperty() = 0;
   // virtual Result<void> BuildFromFile() = 0;
 
+protected:
+  // Number of sorted entries between two consecutive fence keys of the flat
+  // backend.
+  static constexpr size_t kFenceStride = 64;
+
+  // Returns the index of the first element of data[0, size) for which `pred`
+  // is false, assuming `pred` partitions the array. The loop has a fixed trip
+  // count for a given size and compiles to conditional moves.
+  template <typename T, typename Pred>
+  static size_t BranchlessPartitionPoint(
+      const T* data, size_t size, const Pred& pred) {
+    if (size == 0) {
+      return 0;
+    }
+    const T* base = data;
+    while (size > 1) {
+      size_t half = size / 2;
+      base = pred(base[half]) ? base + half : base;
+      size -= half;
+    }
+    return (base - data) + pred(*base);
+  }
+
+  // Returns the position in `sorted_ids` of the first entity for which `pred`
+  // of its value is false. `fences` holds the value of every kFenceStride-th
+  // entity, so only one stride of `sorted_ids` (and of the property) is
+  // touched.
+  template <typename Fence, typename Value, typename Pred>
+  static size_t FencedPartitionPoint(
+      const std::vector<Fence>& fences,
+      const NUMAArray<node_or_edge>& sorted_ids, const Value& value,
+      const Pred& pred) {
+    size_t block = BranchlessPartitionPoint(fences.data(), fences.size(), pred);
+    if (block == 0) {
+      return 0;
+    }
+    // The first entity of `block - 1` satisfies pred and the first entity of
+    // `block` (if any) does not.
+    size_t lo = (block - 1) * kFenceStride + 1;
+    size_t hi = std::min(block * kFenceStride, sorted_ids.size());
+    return lo + BranchlessPartitionPoint(
+                    sorted_ids.data() + lo, hi - lo,
+                    [&](node_or_edge id) { return pred(value(id)); });
+  }
+
 private:
   std::string property_name_;
 };
@@ -80,9 +159,44 @@ public:
       std::shared_ptr<arrow::Array> property)
       : EntityIndex<node_or_edge>(column),
         num_entities_(num_entities),
-        property_(std::static_pointer_cast<ArrowArrayType>(property)),
-        set_(PropertyCompare(property_)) {}
+        property_(std::static_pointer_cast<ArrowArrayType>(property)) {}
+
+#if defined(KATANA_USE_FLAT_ENTITY_INDEX)
+  iterator begin() override { return iterator(sorted_ids_.data()); }
+  iterator end() override {
+    return iterator(sorted_ids_.data() + sorted_ids_.size());
+  }
+
+  // Returns an iterator to the first element in the index with its property
+  // value equal to `key`.
+  iterator Find(c_type key) {
+    iterator it = LowerBound(key);
+    if (it == end() || property_->Value(*it) != key) {
+      return end();
+    }
+    return it;
+  }
+
+  // Returns an iterator to the first element in the index that is greater
+  // than or equal to `key`.
+  iterator LowerBound(c_type key) {
+    return iterator(
+        sorted_ids_.data() +
+        this->FencedPartitionPoint(
+            fences_, sorted_ids_, PropertyValue{property_.get()},
+            [key](c_type v) { return std::less<c_type>{}(v, key); }));
+  }
 
+  // Returns an iterator to the first element in the index that is greater
+  // than `key`.
+  iterator UpperBound(c_type key) {
+    return iterator(
+        sorted_ids_.data() +
+        this->FencedPartitionPoint(
+            fences_, sorted_ids_, PropertyValue{property_.get()},
+            [key](c_type v) { return !std::less<c_type>{}(key, v); }));
+  }
+#else
   iterator begin() override { return iterator(set_.begin()); }
   iterator end() override { return iterator(set_.end()); }
 
@@ -105,8 +219,14 @@ public:
   // Returns an iterator to the first element in the set that is greater than
   // `key`.
   iterator UpperBound(c_type key) { return iterator(set_.upper_bound(key)); }
+#endif
 
 private:
+  struct PropertyValue {
+    const ArrowArrayType* property;
+    c_type operator()(node_or_edge id) const { return property->Value(id); }
+  };
+
   class PropertyCompare {
   public:
     PropertyCompare(std::shared_ptr<ArrowArrayType> property)
@@ -138,7 +258,19 @@ private:
 
   size_t num_entities_;
   std::shared_ptr<ArrowArrayType> property_;
-  std::multiset<set_key_type, PropertyCompare> set_;
+#if defined(KATANA_USE_FLAT_ENTITY_INDEX)
+  // Avoid std::vector<bool> for the fences of boolean properties.
+  using FenceType =
+      std::conditional_t<std::is_same_v<c_type, bool>, uint8_t, c_type>;
+
+  // Valid entities ordered by (property value, id).
+  NUMAArray<node_or_edge> sorted_ids_;
+  // Property value of sorted_ids_[i * kFenceStride].
+  std::vector<FenceType> fences_;
+#else
+  std::multiset<set_key_type, PropertyCompare> set_{
+      PropertyCompare(property_)};
+#endif
 };
 
 // StringEntityIndex provides a EntityIndex for strings.
@@ -156,9 +288,45 @@ public:
       const std::shared_ptr<arrow::Array>& property)
       : EntityIndex<node_or_edge>(property_name),
         num_entities_(num_entities),
-        property_(std::static_pointer_cast<arrow::LargeStringArray>(property)),
-        set_(StringCompare(property_)) {}
+        property_(
+            std::static_pointer_cast<arrow::LargeStringArray>(property)) {}
+
+#if defined(KATANA_USE_FLAT_ENTITY_INDEX)
+  iterator begin() override { return iterator(sorted_ids_.data()); }
+  iterator end() override {
+    return iterator(sorted_ids_.data() + sorted_ids_.size());
+  }
+
+  // Returns an iterator to the first element in the index with its property
+  // value equal to `key`.
+  iterator Find(std::string_view key) {
+    iterator it = LowerBound(key);
+    if (it == end() || PropertyValue{property_.get()}(*it) != key) {
+      return end();
+    }
+    return it;
+  }
+
+  // Returns an iterator to the first element in the index that is greater
+  // than or equal to `key`.
+  iterator LowerBound(std::string_view key) {
+    return iterator(
+        sorted_ids_.data() +
+        this->FencedPartitionPoint(
+            fences_, sorted_ids_, PropertyValue{property_.get()},
+            [key](std::string_view v) { return v < key; }));
+  }
 
+  // Returns an iterator to the first element in the index that is greater
+  // than `key`.
+  iterator UpperBound(std::string_view key) {
+    return iterator(
+        sorted_ids_.data() +
+        this->FencedPartitionPoint(
+            fences_, sorted_ids_, PropertyValue{property_.get()},
+            [key](std::string_view v) { return !(key < v); }));
+  }
+#else
   iterator begin() override { return iterator(set_.begin()); }
   iterator end() override { return iterator(set_.end()); }
 
@@ -188,8 +356,17 @@ public:
   iterator UpperBound(std::string_view key) {
     return iterator(set_.upper_bound(&key));
   }
+#endif
 
 private:
+  struct PropertyValue {
+    const arrow::LargeStringArray* property;
+    std::string_view operator()(node_or_edge id) const {
+      arrow::util::string_view arrow_view = property->GetView(id);
+      return std::string_view(arrow_view.data(), arrow_view.length());
+    }
+  };
+
   class StringCompare {
   public:
     StringCompare(std::shared_ptr<arrow::LargeStringArray> property)
@@ -221,7 +398,14 @@ private:
 
   size_t num_entities_;
   std::shared_ptr<arrow::LargeStringArray> property_;
-  std::multiset<set_key_type, StringCompare> set_;
+#if defined(KATANA_USE_FLAT_ENTITY_INDEX)
+  // Valid entities ordered by (property value, id).
+  NUMAArray<node_or_edge> sorted_ids_;
+  // Views into property_ of the value of sorted_ids_[i * kFenceStride].
+  std::vector<std::string_view> fences_;
+#else
+  std::multiset<set_key_type, StringCompare> set_{StringCompare(property_)};
+#endif
 };  // namespace katana
 
 // Create a EntityIndex with the appropriate type for 'property'. Does not
@@ -1,6 +1,9 @@
 #ifndef KATANA_LIBGRAPH_KATANA_GRAPHML_H_
 #define KATANA_LIBGRAPH_KATANA_GRAPHML_H_
 
+#include <string>
+#include <vector>
+
 #include <libxml/xmlreader.h>
 
 #include "katana/BuildGraph.h"
@@ -21,6 +24,42 @@ KATANA_EXPORT katana::Result<katana::GraphComponents> ConvertGraphML(
     const std::string& infilename, size_t chunk_size = 25000,
     bool verbose = false);
 
+/// ConvertGraphML converts a GraphML file into katana form without keeping
+/// all of it in memory while parsing; see SpillOptions
+///
+/// \param infilename Path to source graphml file
+/// \param spill_options Where to spill parsed rows and edges, and how much
+///     memory to use for them before spilling
+/// \param chunk_size Chunk size for in memory representations during conversion.
+/// \param verbose If true, print graph data to the standard out while
+///     converting.
+/// \returns A collection of Arrow tables of node properties/labels, edge
+///     properties/types, and CSR topology
+KATANA_EXPORT katana::Result<katana::GraphComponents> ConvertGraphML(
+    const std::string& infilename, const SpillOptions& spill_options,
+    size_t chunk_size = 25000, bool verbose = false);
+
+/// ConvertGraphMLParallel converts GraphML files into katana form, parsing
+/// parts of them in parallel. Each file is split at node and edge elements
+/// into parts that are parsed by separate threads into graph fragments,
+/// which are then merged into one graph as if the files had been parsed one
+/// after the other. Nodes and edges keep their order, and edges may refer to
+/// nodes of other parts and files.
+///
+/// Split points are found without parsing the files, so files with node or
+/// edge tags inside comments or CDATA sections, or with nested graphs, should
+/// be converted with ConvertGraphML instead.
+///
+/// \param infilenames Paths to source graphml files
+/// \param chunk_size Chunk size for in memory representations during conversion.
+/// \param verbose If true, print graph data to the standard out while
+///     converting.
+/// \returns A collection of Arrow tables of node properties/labels, edge
+///     properties/types, and CSR topology
+KATANA_EXPORT katana::Result<katana::GraphComponents> ConvertGraphMLParallel(
+    const std::vector<std::string>& infilenames, size_t chunk_size = 25000,
+    bool verbose = false);
+
 /// ConvertGraphML converts a GraphML file into katana form
 ///
 /// \param reader xml text reader object for the document
@@ -1,6 +1,9 @@
 #ifndef KATANA_LIBGRAPH_KATANA_GRAPHTOPOLOGY_H_
 #define KATANA_LIBGRAPH_KATANA_GRAPHTOPOLOGY_H_
 
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -13,6 +16,7 @@
 #include "katana/Iterators.h"
 #include "katana/Logging.h"
 #include "katana/NUMAArray.h"
+#include "katana/PerThreadStorage.h"
 #include "katana/RDGTopology.h"
 #include "katana/Result.h"
 #include "katana/config.h"
@@ -47,6 +51,7 @@ struct KATANA_EXPORT GraphTopologyTypes {
 
 class KATANA_EXPORT EdgeShuffleTopology;
 class KATANA_EXPORT EdgeTypeAwareTopology;
+class KATANA_EXPORT CompressedTopology;
 
 /********************/
 /* Topology classes */
@@ -80,11 +85,20 @@ public:
       PropIndexVec&& edge_prop_indices,
       PropIndexVec&& node_prop_indices) noexcept;
 
+  /// Uses the adjacency indices and destinations of \p rdg_topo, which must
+  /// have been mapped from a file bound with RDGTopology::BindMapped, in
+  /// place rather than copying them. The result keeps the mapped file alive.
+  static GraphTopology MakeMapped(const RDGTopology& rdg_topo) noexcept;
+
   static GraphTopology Copy(const GraphTopology& that) noexcept;
 
   static GraphTopology CopyWithoutPropertyIndexes(
       const GraphTopology& that) noexcept;
 
+  /// Returns true if the arrays of this topology are backed by a mapped file
+  /// (see MakeMapped) rather than by memory of their own
+  bool IsMapped() const noexcept { return mapped_file_ != nullptr; }
+
   uint64_t NumNodes() const noexcept { return adj_indices_.size(); }
 
   uint64_t NumEdges() const noexcept { return dests_.size(); }
@@ -219,12 +233,16 @@ private:
   // by moving NUMAArrays in this class.
   friend class EdgeShuffleTopology;
   friend class EdgeTypeAwareTopology;
+  friend class CompressedTopology;
 
   NUMAArray<Edge>& GetAdjIndices() noexcept { return adj_indices_; }
   NUMAArray<Node>& GetDests() noexcept { return dests_; }
   PropIndexVec& GetEdgePropIndices() noexcept { return edge_prop_indices_; }
   PropIndexVec& GetNodePropIndices() noexcept { return node_prop_indices_; }
 
+  // declared before the arrays it may back, so that it outlives them
+  std::shared_ptr<MappedFile> mapped_file_;
+
   NUMAArray<Edge> adj_indices_;
   NUMAArray<Node> dests_;
 
@@ -311,7 +329,8 @@ public:
     return ret;
   }
 
-  static std::shared_ptr<EdgeShuffleTopology> Make(RDGTopology* rdg_topo);
+  static katana::Result<std::shared_ptr<EdgeShuffleTopology>> Make(
+      RDGTopology* rdg_topo);
 
   katana::Result<RDGTopology> ToRDGTopology() const;
 
@@ -407,10 +426,15 @@ public:
   static std::shared_ptr<ShuffleTopology> MakeSortedByNodeType(
       const PropertyGraph* pg, const EdgeShuffleTopology& seed_topo) noexcept;
 
-  static std::shared_ptr<ShuffleTopology> MakeFromTopo(
+  /// Nodes in one of the locality improving orders of GraphReordering.h
+  static katana::Result<std::shared_ptr<ShuffleTopology>> MakeReordered(
+      const EdgeShuffleTopology& seed_topo,
+      const RDGTopology::NodeSortKind& node_sort_todo);
+
+  static katana::Result<std::shared_ptr<ShuffleTopology>> MakeFromTopo(
       const PropertyGraph* pg, const EdgeShuffleTopology& seed_topo,
       const RDGTopology::NodeSortKind& node_sort_todo,
-      const RDGTopology::EdgeSortKind& edge_sort_todo) noexcept {
+      const RDGTopology::EdgeSortKind& edge_sort_todo) {
     std::shared_ptr<ShuffleTopology> ret;
 
     switch (node_sort_todo) {
@@ -423,8 +447,16 @@ public:
     case RDGTopology::NodeSortKind::kSortedByNodeType:
       ret = MakeSortedByNodeType(pg, seed_topo);
       break;
+    case RDGTopology::NodeSortKind::kReorderedByDegreeGrouping:
+    case RDGTopology::NodeSortKind::kReorderedByRCM:
+    case RDGTopology::NodeSortKind::kReorderedByGorder:
+    case RDGTopology::NodeSortKind::kReorderedByRabbit:
+      ret = KATANA_CHECKED(MakeReordered(seed_topo, node_sort_todo));
+      break;
     default:
-      KATANA_LOG_FATAL("switch case fell through");
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument, "unknown node sort kind: {}",
+          static_cast<int>(node_sort_todo));
     }
 
     ret->sortEdges(pg, edge_sort_todo);
@@ -432,7 +464,8 @@ public:
     return ret;
   }
 
-  static std::shared_ptr<ShuffleTopology> Make(RDGTopology* rdg_topo);
+  static katana::Result<std::shared_ptr<ShuffleTopology>> Make(
+      RDGTopology* rdg_topo);
 
   katana::Result<RDGTopology> ToRDGTopology() const;
 
@@ -452,6 +485,14 @@ private:
         new_to_old.begin(), new_to_old.end(),
         [&](const auto& i1, const auto& i2) { return cmp(i1, i2); });
 
+    return MakeNodePermutedTopo(seed_topo, new_to_old, node_sort_todo);
+  }
+
+  /// new_to_old[i] is the node of seed_topo that gets id i
+  template <typename NewToOld>
+  static std::shared_ptr<ShuffleTopology> MakeNodePermutedTopo(
+      const EdgeShuffleTopology& seed_topo, const NewToOld& new_to_old,
+      const RDGTopology::NodeSortKind& node_sort_todo) {
     GraphTopology::AdjIndexVec degrees;
     degrees.allocateInterleaved(seed_topo.NumNodes());
 
@@ -473,9 +514,6 @@ private:
         },
         katana::no_stats());
 
-    KATANA_LOG_DEBUG_ASSERT(
-        std::is_sorted(degrees.begin(), degrees.end(), std::greater<>()));
-
     katana::ParallelSTL::partial_sum(
         degrees.begin(), degrees.end(), degrees.begin());
 
@@ -654,7 +692,7 @@ public:
       std::shared_ptr<const CondensedTypeIDMap> edge_type_index,
       EdgeShuffleTopology&& e_topo) noexcept;
 
-  static std::shared_ptr<EdgeTypeAwareTopology> Make(
+  static katana::Result<std::shared_ptr<EdgeTypeAwareTopology>> Make(
       RDGTopology* rdg_topo,
       std::shared_ptr<const CondensedTypeIDMap> edge_type_index,
       EdgeShuffleTopology&& e_topo);
@@ -885,6 +923,220 @@ private:
   AdjIndexVec per_type_adj_indices_;
 };
 
+/// A read-only CSR topology that keeps edge destinations compressed.
+///
+/// Destinations are split into blocks of kBlockSize consecutive edges. The
+/// first destination of a block is stored as a varint and every following one
+/// as the zigzag-encoded varint of its difference to its predecessor, so lists
+/// sorted by destination mostly need one or two bytes per edge. A skip pointer
+/// per block holds its byte offset, which makes OutEdgeDst() a single block
+/// decode. The last decoded block is cached per thread, so iterating over
+/// OutEdges(node) decodes each block only once.
+///
+/// Edge property indices, which a topology sorted by destination needs to
+/// find the properties of its edges, are not stored when they are the
+/// identity. Otherwise they are encoded the same way: within a node they are
+/// a permutation of its edge range, so their deltas are bounded by its
+/// degree.
+///
+/// The view cache builds it next to the default topology, so it only saves
+/// memory where an algorithm would otherwise build a sorted copy: its
+/// adjacency lists are always sorted by destination and FindEdge() is a
+/// binary search, like on PropertyGraphViews::EdgesSortedByDestID.
+class KATANA_EXPORT CompressedTopology : public GraphTopologyTypes {
+public:
+  static constexpr size_t kBlockSize = 64;
+
+  CompressedTopology() = default;
+  CompressedTopology(CompressedTopology&&) = default;
+  CompressedTopology& operator=(CompressedTopology&&) = default;
+
+  CompressedTopology(const CompressedTopology&) = delete;
+  CompressedTopology& operator=(const CompressedTopology&) = delete;
+  virtual ~CompressedTopology();
+
+  /// Compress \p seed_topo. Edge ids, edge property indices and node property
+  /// indices of the result are those of \p seed_topo. The result is sorted by
+  /// destination if the adjacency lists of \p seed_topo are, even if
+  /// \p seed_topo does not record it.
+  static std::shared_ptr<CompressedTopology> MakeFrom(
+      const GraphTopology& seed_topo) noexcept;
+
+  uint64_t NumNodes() const noexcept { return adj_indices_.size(); }
+
+  uint64_t NumEdges() const noexcept { return num_edges_; }
+
+  /// Gets all out-edges
+  edges_range OutEdges() const noexcept {
+    return MakeStandardRange<edge_iterator>(Edge{0}, Edge{NumEdges()});
+  }
+
+  /// Gets out-edges of some node.
+  ///
+  /// \param node node to get the edge range of
+  /// \returns iterable edge range for node.
+  edges_range OutEdges(Node node) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(node <= adj_indices_.size());
+    edge_iterator e_beg{node > 0 ? adj_indices_[node - 1] : 0};
+    edge_iterator e_end{adj_indices_[node]};
+
+    return MakeStandardRange(e_beg, e_end);
+  }
+
+  Node OutEdgeDst(Edge edge_id) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(edge_id < NumEdges());
+    DecodedBlock<Node>& decoded = *decoded_blocks_.getLocal();
+    const uint64_t block = edge_id / kBlockSize;
+    if (decoded.block != block) {
+      DecodeBlock(block, decoded.values.data());
+      decoded.block = block;
+    }
+    return decoded.values[edge_id % kBlockSize];
+  }
+
+  Node GetEdgeSrc(const Edge& eid) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(eid < NumEdges());
+
+    auto it = std::upper_bound(adj_indices_.begin(), adj_indices_.end(), eid);
+    KATANA_LOG_DEBUG_ASSERT(it != adj_indices_.end());
+
+    return static_cast<Node>(std::distance(adj_indices_.begin(), it));
+  }
+
+  /// @param node node to get degree for
+  /// @returns Degree of node N
+  size_t OutDegree(Node node) const noexcept { return OutEdges(node).size(); }
+
+  nodes_range Nodes() const noexcept {
+    return MakeStandardRange<node_iterator>(
+        Node{0}, static_cast<Node>(NumNodes()));
+  }
+
+  // Standard container concepts
+
+  node_iterator begin() const noexcept { return node_iterator(0); }
+
+  node_iterator end() const noexcept { return node_iterator(NumNodes()); }
+
+  size_t size() const noexcept { return NumNodes(); }
+
+  bool empty() const noexcept { return NumNodes() == 0; }
+
+  PropertyIndex GetEdgePropertyIndexFromOutEdge(
+      const Edge& eid) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(eid < NumEdges());
+    if (edge_prop_index_offsets_.empty()) {
+      return eid;
+    }
+    DecodedBlock<PropertyIndex>& decoded =
+        *decoded_edge_prop_indices_.getLocal();
+    const uint64_t block = eid / kBlockSize;
+    if (decoded.block != block) {
+      DecodeEdgePropIndexBlock(block, decoded.values.data());
+      decoded.block = block;
+    }
+    return decoded.values[eid % kBlockSize];
+  }
+
+  PropertyIndex GetNodePropertyIndex(const Node& nid) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(nid < NumNodes() || NumNodes() == 0);
+    return node_prop_indices_.empty() ? nid : node_prop_indices_[nid];
+  }
+
+  Node GetLocalNodeID(const Node& nid) const noexcept {
+    return static_cast<Node>(GetNodePropertyIndex(nid));
+  }
+
+  Edge GetLocalEdgeIDFromOutEdge(const Edge& eid) const noexcept {
+    return GetEdgePropertyIndexFromOutEdge(eid);
+  }
+
+  bool is_valid() const noexcept { return is_valid_; }
+
+  void invalidate() noexcept { is_valid_ = false; }
+
+  RDGTopology::EdgeSortKind edge_sort_state() const noexcept {
+    return edge_sort_state_;
+  }
+
+  bool has_edges_sorted_by(
+      const RDGTopology::EdgeSortKind& kind) const noexcept {
+    return (kind == RDGTopology::EdgeSortKind::kAny) ||
+           (kind == edge_sort_state());
+  }
+
+  /// Finds the first edge from \p src to \p dst. A binary search if edges
+  /// are sorted by destination; each probe decodes at most one block.
+  /// @returns the edge or OutEdges(src).end() if there is none
+  edge_iterator FindEdge(const Node& src, const Node& dst) const noexcept {
+    auto e_range = OutEdges(src);
+    if (!has_edges_sorted_by(RDGTopology::EdgeSortKind::kSortedByDestID)) {
+      return std::find_if(
+          e_range.begin(), e_range.end(),
+          [&](const Edge& e) { return OutEdgeDst(e) == dst; });
+    }
+    auto iter = std::lower_bound(
+        e_range.begin(), e_range.end(), dst,
+        internal::EdgeDestComparator<CompressedTopology>{this});
+    if (iter != e_range.end() && OutEdgeDst(*iter) == dst) {
+      return iter;
+    }
+    return e_range.end();
+  }
+
+  bool HasEdge(const Node& src, const Node& dst) const noexcept {
+    return FindEdge(src, dst) != OutEdges(src).end();
+  }
+
+  /// @returns the number of bytes used by the encoded destinations and their
+  /// skip pointers
+  size_t EncodedSizeInBytes() const noexcept {
+    return encoded_dests_.size() + block_offsets_.size() * sizeof(uint64_t);
+  }
+
+  /// @returns the number of bytes used by all arrays of the topology
+  size_t SizeInBytes() const noexcept {
+    return adj_indices_.size() * sizeof(Edge) + EncodedSizeInBytes() +
+           encoded_edge_prop_indices_.size() +
+           edge_prop_index_offsets_.size() * sizeof(uint64_t) +
+           node_prop_indices_.size() * sizeof(PropertyIndex);
+  }
+
+  void Print() const noexcept;
+
+private:
+  template <typename T>
+  struct DecodedBlock {
+    uint64_t block{std::numeric_limits<uint64_t>::max()};
+    std::array<T, kBlockSize> values;
+  };
+
+  /// Decode all destinations of \p block into \p out
+  void DecodeBlock(uint64_t block, Node* out) const noexcept;
+
+  /// Decode all edge property indices of \p block into \p out
+  void DecodeEdgePropIndexBlock(
+      uint64_t block, PropertyIndex* out) const noexcept;
+
+  AdjIndexVec adj_indices_;
+  uint64_t num_edges_{0};
+  /// varint stream of all blocks, padded so that 8-byte loads never overrun
+  NUMAArray<uint8_t> encoded_dests_;
+  /// byte offset of each block in encoded_dests_
+  NUMAArray<uint64_t> block_offsets_;
+  /// edge property indices, encoded like the destinations; both are empty if
+  /// the indices are the identity
+  NUMAArray<uint8_t> encoded_edge_prop_indices_;
+  NUMAArray<uint64_t> edge_prop_index_offsets_;
+  PropIndexVec node_prop_indices_;
+  RDGTopology::EdgeSortKind edge_sort_state_{RDGTopology::EdgeSortKind::kAny};
+  bool is_valid_ = true;
+
+  mutable PerThreadStorage<DecodedBlock<Node>> decoded_blocks_;
+  mutable PerThreadStorage<DecodedBlock<PropertyIndex>>
+      decoded_edge_prop_indices_;
+};
+
 /****************************/
 /* Topology wrapper classes */
 /****************************/
@@ -914,6 +1166,10 @@ public:
     return topo().OutEdgeDst(eid);
   }
 
+  /// Destinations of all out-edges, contiguous in edge id order. Only
+  /// available for topologies that store destinations uncompressed.
+  auto DestData() const noexcept { return topo().DestData(); }
+
   auto GetEdgeSrc(const Edge& eid) const noexcept {
     return topo().GetEdgeSrc(eid);
   }
@@ -1404,8 +1660,8 @@ using PGViewDefault = BasicPropGraphViewWrapper<DefaultPGTopology>;
 template <>
 struct PGViewBuilder<PGViewDefault> {
   template <typename ViewCache>
-  static PGViewDefault BuildView(
-      PropertyGraph* pg, ViewCache& viewCache) noexcept {
+  static katana::Result<PGViewDefault> BuildView(
+      PropertyGraph* pg, ViewCache& viewCache) {
     auto topo = viewCache.GetDefaultTopology();
     return PGViewDefault{pg, DefaultPGTopology{topo}};
   }
@@ -1419,8 +1675,8 @@ using PGViewTransposed = BasicPropGraphViewWrapper<TransposedTopology>;
 template <>
 struct PGViewBuilder<PGViewTransposed> {
   template <typename ViewCache>
-  static PGViewTransposed BuildView(
-      PropertyGraph* pg, ViewCache& viewCache) noexcept {
+  static katana::Result<PGViewTransposed> BuildView(
+      PropertyGraph* pg, ViewCache& viewCache) {
     auto transposed_topo = viewCache.BuildOrGetEdgeShuffTopo(
         pg, RDGTopology::TransposeKind::kYes, RDGTopology::EdgeSortKind::kAny);
 
@@ -1437,8 +1693,8 @@ using PGViewEdgesSortedByDestID =
 template <>
 struct PGViewBuilder<PGViewEdgesSortedByDestID> {
   template <typename ViewCache>
-  static PGViewEdgesSortedByDestID BuildView(
-      PropertyGraph* pg, ViewCache& viewCache) noexcept {
+  static katana::Result<PGViewEdgesSortedByDestID> BuildView(
+      PropertyGraph* pg, ViewCache& viewCache) {
     auto sorted_topo = viewCache.BuildOrGetEdgeShuffTopo(
         pg, RDGTopology::TransposeKind::kNo,
         RDGTopology::EdgeSortKind::kSortedByDestID);
@@ -1460,18 +1716,64 @@ using PGViewNodesSortedByDegreeEdgesSortedByDestID =
 template <>
 struct PGViewBuilder<PGViewNodesSortedByDegreeEdgesSortedByDestID> {
   template <typename ViewCache>
-  static PGViewNodesSortedByDegreeEdgesSortedByDestID BuildView(
-      PropertyGraph* pg, ViewCache& viewCache) noexcept {
-    auto sorted_topo = viewCache.BuildOrGetShuffTopo(
+  static katana::Result<PGViewNodesSortedByDegreeEdgesSortedByDestID> BuildView(
+      PropertyGraph* pg, ViewCache& viewCache) {
+    auto sorted_topo = KATANA_CHECKED(viewCache.BuildOrGetShuffTopo(
         pg, RDGTopology::TransposeKind::kNo,
         RDGTopology::NodeSortKind::kSortedByDegree,
-        RDGTopology::EdgeSortKind::kSortedByDestID);
+        RDGTopology::EdgeSortKind::kSortedByDestID));
 
     return PGViewNodesSortedByDegreeEdgesSortedByDestID{
         pg, NodesSortedByDegreeEdgesSortedByDestIDTopology{sorted_topo}};
   }
 };
 
+// Nodes in a locality improving order, edges sorted by destination view
+
+template <RDGTopology::NodeSortKind kNodeOrder>
+class NodesReorderedEdgesSortedByDestIDTopology
+    : public SortedTopologyWrapper<ShuffleTopology> {
+  using Base = SortedTopologyWrapper<ShuffleTopology>;
+
+public:
+  using Base::Base;
+};
+
+template <RDGTopology::NodeSortKind kNodeOrder>
+using PGViewNodesReorderedEdgesSortedByDestID = BasicPropGraphViewWrapper<
+    NodesReorderedEdgesSortedByDestIDTopology<kNodeOrder>>;
+
+template <RDGTopology::NodeSortKind kNodeOrder>
+struct PGViewBuilder<PGViewNodesReorderedEdgesSortedByDestID<kNodeOrder>> {
+  template <typename ViewCache>
+  static katana::Result<PGViewNodesReorderedEdgesSortedByDestID<kNodeOrder>>
+  BuildView(PropertyGraph* pg, ViewCache& viewCache) {
+    auto reordered_topo = KATANA_CHECKED(viewCache.BuildOrGetShuffTopo(
+        pg, RDGTopology::TransposeKind::kNo, kNodeOrder,
+        RDGTopology::EdgeSortKind::kSortedByDestID));
+
+    return PGViewNodesReorderedEdgesSortedByDestID<kNodeOrder>{
+        pg, NodesReorderedEdgesSortedByDestIDTopology<kNodeOrder>{
+                reordered_topo}};
+  }
+};
+
+// Compressed view
+
+using CompressedPGTopology = SortedTopologyWrapper<CompressedTopology>;
+using PGViewCompressed = BasicPropGraphViewWrapper<CompressedPGTopology>;
+
+template <>
+struct PGViewBuilder<PGViewCompressed> {
+  template <typename ViewCache>
+  static katana::Result<PGViewCompressed> BuildView(
+      PropertyGraph* pg, ViewCache& viewCache) {
+    auto compressed_topo = viewCache.BuildOrGetCompressedTopo(pg);
+
+    return PGViewCompressed{pg, CompressedPGTopology{compressed_topo}};
+  }
+};
+
 // Bidirectional view
 
 using SimpleBiDirTopology =
@@ -1481,8 +1783,8 @@ using PGViewBiDirectional = BasicPropGraphViewWrapper<SimpleBiDirTopology>;
 template <>
 struct PGViewBuilder<PGViewBiDirectional> {
   template <typename ViewCache>
-  static PGViewBiDirectional BuildView(
-      PropertyGraph* pg, ViewCache& viewCache) noexcept {
+  static katana::Result<PGViewBiDirectional> BuildView(
+      PropertyGraph* pg, ViewCache& viewCache) {
     auto tpose_topo = viewCache.BuildOrGetEdgeShuffTopo(
         pg, RDGTopology::TransposeKind::kYes, RDGTopology::EdgeSortKind::kAny);
     auto bidir_topo =
@@ -1501,8 +1803,8 @@ using PGViewUnDirected = BasicPropGraphViewWrapper<UndirectedTopology>;
 template <>
 struct PGViewBuilder<PGViewUnDirected> {
   template <typename ViewCache>
-  static internal::PGViewUnDirected BuildView(
-      PropertyGraph* pg, ViewCache& viewCache) noexcept {
+  static katana::Result<PGViewUnDirected> BuildView(
+      PropertyGraph* pg, ViewCache& viewCache) {
     auto tpose_topo = viewCache.BuildOrGetEdgeShuffTopo(
         pg, RDGTopology::TransposeKind::kYes, RDGTopology::EdgeSortKind::kAny);
     auto undir_topo =
@@ -1520,8 +1822,8 @@ using PGViewEdgeTypeAwareBiDir =
 template <>
 struct PGViewBuilder<PGViewEdgeTypeAwareBiDir> {
   template <typename ViewCache>
-  static PGViewEdgeTypeAwareBiDir BuildView(
-      PropertyGraph* pg, ViewCache& viewCache) noexcept {
+  static katana::Result<PGViewEdgeTypeAwareBiDir> BuildView(
+      PropertyGraph* pg, ViewCache& viewCache) {
     auto out_topo = viewCache.BuildOrGetEdgeTypeAwareTopo(
         pg, RDGTopology::TransposeKind::kNo);
     auto in_topo = viewCache.BuildOrGetEdgeTypeAwareTopo(
@@ -1546,6 +1848,20 @@ struct PropertyGraphViews {
   using EdgeTypeAwareBiDir = internal::PGViewEdgeTypeAwareBiDir;
   using NodesSortedByDegreeEdgesSortedByDestID =
       internal::PGViewNodesSortedByDegreeEdgesSortedByDestID;
+  using Compressed = internal::PGViewCompressed;
+  // Node n of these views is node GetLocalNodeID(n) of the graph
+  using NodesReorderedByDegreeGroupingEdgesSortedByDestID =
+      internal::PGViewNodesReorderedEdgesSortedByDestID<
+          RDGTopology::NodeSortKind::kReorderedByDegreeGrouping>;
+  using NodesReorderedByRCMEdgesSortedByDestID =
+      internal::PGViewNodesReorderedEdgesSortedByDestID<
+          RDGTopology::NodeSortKind::kReorderedByRCM>;
+  using NodesReorderedByGorderEdgesSortedByDestID =
+      internal::PGViewNodesReorderedEdgesSortedByDestID<
+          RDGTopology::NodeSortKind::kReorderedByGorder>;
+  using NodesReorderedByRabbitEdgesSortedByDestID =
+      internal::PGViewNodesReorderedEdgesSortedByDestID<
+          RDGTopology::NodeSortKind::kReorderedByRabbit>;
 };
 
 class KATANA_EXPORT PGViewCache {
@@ -1556,6 +1872,7 @@ class KATANA_EXPORT PGViewCache {
   std::vector<std::shared_ptr<ShuffleTopology>> fully_shuff_topos_;
   std::vector<std::shared_ptr<EdgeTypeAwareTopology>> edge_type_aware_topos_;
   std::shared_ptr<CondensedTypeIDMap> edge_type_id_map_;
+  std::shared_ptr<CompressedTopology> compressed_topo_;
   // TODO(amber): define a node_type_id_map_;
 
   template <typename>
@@ -1573,16 +1890,16 @@ public:
   PGViewCache& operator=(const PGViewCache&) = delete;
 
   template <typename PGView>
-  PGView BuildView(PropertyGraph* pg) noexcept {
+  katana::Result<PGView> BuildView(PropertyGraph* pg) {
     return internal::PGViewBuilder<PGView>::BuildView(pg, *this);
   }
 
   katana::Result<std::vector<RDGTopology>> ToRDGTopology();
 
   template <typename PGView>
-  PGView BuildView(
+  katana::Result<PGView> BuildView(
       const PropertyGraph* pg, const std::vector<std::string>& node_types,
-      const std::vector<std::string>& edge_types) noexcept {
+      const std::vector<std::string>& edge_types) {
     return internal::PGViewBuilder<PGView>::BuildView(
         pg, node_types, edge_types, *this);
   }
@@ -1616,13 +1933,19 @@ private:
       PropertyGraph* pg, const RDGTopology::TransposeKind& tpose_kind,
       const RDGTopology::EdgeSortKind& sort_kind) noexcept;
 
-  std::shared_ptr<ShuffleTopology> BuildOrGetShuffTopo(
+  katana::Result<std::shared_ptr<ShuffleTopology>> BuildOrGetShuffTopo(
       PropertyGraph* pg, const RDGTopology::TransposeKind& tpose_kind,
       const RDGTopology::NodeSortKind& node_sort_todo,
-      const RDGTopology::EdgeSortKind& edge_sort_todo) noexcept;
+      const RDGTopology::EdgeSortKind& edge_sort_todo);
 
   std::shared_ptr<EdgeTypeAwareTopology> BuildOrGetEdgeTypeAwareTopo(
       PropertyGraph* pg, const RDGTopology::TransposeKind& tpose_kind) noexcept;
+
+  // Compresses the default topology if its edges are already sorted by
+  // destination, otherwise a sorted copy of it. A cached sorted copy is used
+  // and stays cached; if there is none, the copy is built without caching it.
+  std::shared_ptr<CompressedTopology> BuildOrGetCompressedTopo(
+      PropertyGraph* pg) noexcept;
 };
 
 /// Creates a uniform-random CSR GraphTopology instance, where each node as
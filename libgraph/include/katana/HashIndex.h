@@ -0,0 +1,103 @@
+#ifndef KATANA_LIBGRAPH_KATANA_HASHINDEX_H_
+#define KATANA_LIBGRAPH_KATANA_HASHINDEX_H_
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/NUMAArray.h"
+#include "katana/PropertyHashIndexPrimitive.h"
+#include "katana/Range.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+// HashIndex maps the values of one or more properties (a composite key such
+// as type and external id) to the node or edge ids with those values. Unlike
+// EntityIndex it only answers equality lookups, in expected constant time.
+//
+// Entities with a null value in any of the indexed properties are not
+// indexed. The index refers to the property arrays it was built from, which
+// must not be modified while it is in use.
+template <typename node_or_edge>
+class KATANA_EXPORT HashIndex {
+public:
+  // The value of one indexed property in a key. The alternative must match
+  // the type of the property: bool, uint8_t, int64_t, uint64_t, double_t or
+  // (for large strings) std::string_view.
+  using KeyValue = std::variant<
+      bool, uint8_t, int64_t, uint64_t, double_t, std::string_view>;
+  // One value per indexed property, in the order of property_names().
+  using Key = std::vector<KeyValue>;
+  using Range = StandardRange<const node_or_edge*>;
+
+  // Creates an empty index over `properties`. Fails if a property has a type
+  // that cannot be indexed or has fewer than `num_entities` values.
+  static Result<std::unique_ptr<HashIndex>> Make(
+      std::vector<std::string> property_names, size_t num_entities,
+      std::vector<std::shared_ptr<arrow::Array>> properties);
+
+  HashIndex(const HashIndex&) = delete;
+  HashIndex& operator=(const HashIndex&) = delete;
+  HashIndex(HashIndex&&) = delete;
+  HashIndex& operator=(HashIndex&&) = delete;
+
+  const std::vector<std::string>& property_names() const {
+    return property_names_;
+  }
+
+  // Number of indexed entities.
+  size_t size() const { return ids_.size(); }
+
+  // Number of distinct keys.
+  size_t num_keys() const { return group_hashes_.size(); }
+
+  // Builds the index from the properties, in parallel.
+  Result<void> BuildFromProperties();
+
+  // Returns the entities whose properties are equal to `key` in increasing
+  // order of id. The range is empty if there are none.
+  Result<Range> Find(const Key& key) const;
+
+  // Returns the on-storage form of the index (see RDG::
+  // WritePropertyHashIndexPrimitive).
+  PropertyHashIndexPrimitive ToPrimitive() const;
+
+  // Replaces the contents of the index with a previously built index over the
+  // same properties. Fails if `primitive` was built for other properties or
+  // for a different number of entities.
+  Result<void> FromPrimitive(PropertyHashIndexPrimitive* primitive);
+
+private:
+  HashIndex(
+      std::vector<std::string> property_names, size_t num_entities,
+      std::vector<std::shared_ptr<arrow::Array>> properties);
+
+  uint64_t HashOf(node_or_edge id) const;
+  bool AllValid(node_or_edge id) const;
+  bool KeysEqual(node_or_edge a, node_or_edge b) const;
+  bool KeyEquals(const Key& key, node_or_edge id) const;
+
+  std::vector<std::string> property_names_;
+  size_t num_entities_;
+  std::vector<std::shared_ptr<arrow::Array>> properties_;
+
+  // Indexed entities, grouped by key and in increasing order within a group
+  NUMAArray<node_or_edge> ids_;
+  // ids_[group_offsets_[g], group_offsets_[g + 1]) have the key of group g
+  NUMAArray<uint64_t> group_offsets_;
+  // Hash of the key of each group
+  NUMAArray<uint64_t> group_hashes_;
+  // Linear probing table of group + 1 (0 is an empty slot), with a power of
+  // two size
+  NUMAArray<uint64_t> slots_;
+};
+
+}  // namespace katana
+
+#endif
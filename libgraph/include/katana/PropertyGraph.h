@@ -14,6 +14,7 @@
 #include "katana/EntityTypeManager.h"
 #include "katana/ErrorCode.h"
 #include "katana/GraphTopology.h"
+#include "katana/HashIndex.h"
 #include "katana/Iterators.h"
 #include "katana/Logging.h"
 #include "katana/NUMAArray.h"
@@ -228,11 +229,24 @@ public:
         NumEdges());
   }
 
+  /// Build a view of this graph, building and caching the topology it needs
+  /// unless it is cached already. Fails if the topology cannot be built.
   template <typename PGView>
-  PGView BuildView() noexcept {
+  Result<PGView> MakeView() {
     return pg_view_cache_.BuildView<PGView>(this);
   }
 
+  /// Like MakeView, for callers that cannot handle errors; aborts if the
+  /// topology of the view cannot be built.
+  template <typename PGView>
+  PGView BuildView() noexcept {
+    auto res = MakeView<PGView>();
+    if (!res) {
+      KATANA_LOG_FATAL("building view: {}", res.error());
+    }
+    return std::move(res.value());
+  }
+
   /// Make a property graph from a constructed RDG. Take ownership of the RDG
   /// and its underlying resources.
   static Result<std::unique_ptr<PropertyGraph>> Make(
@@ -802,6 +816,34 @@ public:
   /// if i is not a valid index, append the column to the end of the table
   Result<void> LoadEdgeProperty(const std::string& name, int i = -1);
 
+  /// Set how the node property \p name is written from now on, e.g., its
+  /// row group and zone sizes; see RDG::SetNodePropertyWriteOpts
+  void SetNodePropertyWriteOpts(
+      const std::string& name, const ParquetWriter::WriteOpts& opts) {
+    rdg_->SetNodePropertyWriteOpts(name, opts);
+  }
+
+  /// Set how the edge property \p name is written from now on; see
+  /// RDG::SetEdgePropertyWriteOpts
+  void SetEdgePropertyWriteOpts(
+      const std::string& name, const ParquetWriter::WriteOpts& opts) {
+    rdg_->SetEdgePropertyWriteOpts(name, opts);
+  }
+
+  /// Read from storage only the rows of a stored node property whose zones
+  /// may hold values in [min, max]; see RDG::ReadNodePropertyRange
+  Result<std::shared_ptr<arrow::Table>> ReadNodePropertyRange(
+      const std::string& name, const ParquetReader::Bound& min,
+      const ParquetReader::Bound& max,
+      std::vector<ParquetReader::Slice>* slices = nullptr) const;
+
+  /// Read from storage only the rows of a stored edge property whose zones
+  /// may hold values in [min, max]; see RDG::ReadEdgePropertyRange
+  Result<std::shared_ptr<arrow::Table>> ReadEdgePropertyRange(
+      const std::string& name, const ParquetReader::Bound& min,
+      const ParquetReader::Bound& max,
+      std::vector<ParquetReader::Slice>* slices = nullptr) const;
+
   /// Load a node property by name if it is absent and append its column to
   /// the table do nothing otherwise
   Result<void> EnsureNodePropertyLoaded(const std::string& name);
@@ -978,6 +1020,54 @@ public:
   katana::Result<std::shared_ptr<katana::EntityIndex<GraphTopology::Edge>>>
   GetEdgeIndex(const std::string& property_name) const;
 
+  /// Creates a hash index over one or more node properties. If an index over
+  /// the same properties was stored with the graph (see WriteNodeHashIndex)
+  /// it is loaded instead of built.
+  ///
+  /// Adding, upserting or removing any of the properties deletes the index,
+  /// so it has to be made again to reflect the new values.
+  Result<void> MakeNodeHashIndex(
+      const std::vector<std::string>& property_names);
+
+  /// Creates a hash index over one or more edge properties, see
+  /// MakeNodeHashIndex.
+  Result<void> MakeEdgeHashIndex(
+      const std::vector<std::string>& property_names);
+
+  /// Deletes the hash index over the named node properties. A copy stored
+  /// with the graph is kept.
+  Result<void> DeleteNodeHashIndex(
+      const std::vector<std::string>& property_names);
+
+  /// Deletes the hash index over the named edge properties, see
+  /// DeleteNodeHashIndex.
+  Result<void> DeleteEdgeHashIndex(
+      const std::vector<std::string>& property_names);
+
+  /// Returns the hash index over the named node properties.
+  ///
+  /// The graph retains ownership of the index.
+  Result<std::shared_ptr<HashIndex<GraphTopology::Node>>> GetNodeHashIndex(
+      const std::vector<std::string>& property_names) const;
+
+  /// Returns the hash index over the named edge properties.
+  ///
+  /// The graph retains ownership of the index.
+  Result<std::shared_ptr<HashIndex<GraphTopology::Edge>>> GetEdgeHashIndex(
+      const std::vector<std::string>& property_names) const;
+
+  /// Writes the hash index over the named node properties to the graph's
+  /// storage location so that later loads of the graph do not rebuild it.
+  /// Fails with NotFound if the index was deleted, including by modifying
+  /// its properties; such an index must be made again before it is written.
+  Result<void> WriteNodeHashIndex(
+      const std::vector<std::string>& property_names);
+
+  /// Writes the hash index over the named edge properties, see
+  /// WriteNodeHashIndex.
+  Result<void> WriteEdgeHashIndex(
+      const std::vector<std::string>& property_names);
+
   GraphTopology::Node OriginalToTransformedNodeID(
       GraphTopology::Node node) const {
     return IsTransformed() ? original_to_transformed_nodes_[node] : node;
@@ -1123,6 +1213,8 @@ private:
   // List of node and edge indexes on this graph.
   std::vector<std::shared_ptr<EntityIndex<Node>>> node_indexes_;
   std::vector<std::shared_ptr<EntityIndex<Edge>>> edge_indexes_;
+  std::vector<std::shared_ptr<HashIndex<Node>>> node_hash_indexes_;
+  std::vector<std::shared_ptr<HashIndex<Edge>>> edge_hash_indexes_;
 
   PGViewCache pg_view_cache_;
 
@@ -0,0 +1,138 @@
+#ifndef KATANA_LIBGRAPH_KATANA_SORTEDINTERSECTION_H_
+#define KATANA_LIBGRAPH_KATANA_SORTEDINTERSECTION_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "katana/config.h"
+
+namespace katana {
+
+/// Intersection kernels over sorted adjacency lists, shared by the analytics
+/// that count common neighbors (triangle counting, Jaccard, k-truss).
+
+/// When one list is this many times longer than the other, the shorter one
+/// is searched in the longer one instead of merging both.
+constexpr size_t kGallopingRatio = 32;
+
+/// Returns the number of elements common to \p a and \p b.
+///
+/// Both arrays must be sorted. An element repeated in both arrays is matched
+/// one-to-one, like std::set_intersection does, whichever kernel runs.
+/// Depending on the sizes of the inputs and on what the CPU supports this
+/// uses galloping search, an AVX-512 or AVX2 block merge, or a scalar merge.
+/// The instruction set is selected once at runtime.
+KATANA_EXPORT size_t SortedIntersectionSize(
+    const uint32_t* a, size_t a_size, const uint32_t* b,
+    size_t b_size) noexcept;
+
+/// Scalar reference implementation of SortedIntersectionSize. Exposed for
+/// testing and benchmarking the vectorized kernels against.
+KATANA_EXPORT size_t SortedIntersectionSizeScalar(
+    const uint32_t* a, size_t a_size, const uint32_t* b,
+    size_t b_size) noexcept;
+
+/// Membership bitmap of a fixed set over [0, universe), for when the same
+/// (usually high degree) set is intersected with many others. Probing costs
+/// one bit test per element and the probed array need not be sorted.
+class KATANA_EXPORT IntersectionBitmap {
+public:
+  IntersectionBitmap(const uint32_t* set, size_t size, uint32_t universe);
+
+  bool Contains(uint32_t v) const noexcept {
+    return (bits_[v / 64] >> (v % 64)) & 1;
+  }
+
+  /// Returns the number of elements of \p b (counting repeats) in the set.
+  size_t IntersectionSize(const uint32_t* b, size_t b_size) const noexcept;
+
+private:
+  std::vector<uint64_t> bits_;
+};
+
+/// Visits the common elements of two sorted ranges of iterators.
+///
+/// \p key maps the value of an iterator to the sorted key; entries for which
+/// \p keep returns false are skipped. \p visit is called with the matching
+/// pair of iterators and stops the intersection by returning false. Used when
+/// the keys are not contiguous in memory or must be filtered, so the array
+/// kernels above do not apply.
+template <typename Iter, typename Key, typename Keep, typename Visit>
+void
+ForEachSortedIntersection(
+    Iter a, Iter a_end, Iter b, Iter b_end, const Key& key, const Keep& keep,
+    const Visit& visit) {
+  auto a_size = std::distance(a, a_end);
+  auto b_size = std::distance(b, b_end);
+  if (a_size == 0 || b_size == 0) {
+    return;
+  }
+
+  bool swapped = false;
+  if (a_size > b_size) {
+    std::swap(a, b);
+    std::swap(a_end, b_end);
+    std::swap(a_size, b_size);
+    swapped = true;
+  }
+  auto do_visit = [&](Iter x, Iter y) {
+    return swapped ? visit(y, x) : visit(x, y);
+  };
+  auto key_less = [&](const auto& it_value, const auto& k) {
+    return key(it_value) < k;
+  };
+
+  if (static_cast<size_t>(b_size) / static_cast<size_t>(a_size) >=
+      kGallopingRatio) {
+    for (; a != a_end && b != b_end; ++a) {
+      if (!keep(*a)) {
+        continue;
+      }
+      const auto k = key(*a);
+      b = std::lower_bound(b, b_end, k, key_less);
+      for (; b != b_end && key(*b) == k; ++b) {
+        if (keep(*b)) {
+          if (!do_visit(a, b)) {
+            return;
+          }
+          ++b;
+          break;
+        }
+      }
+    }
+    return;
+  }
+
+  while (true) {
+    while (a != a_end && !keep(*a)) {
+      ++a;
+    }
+    while (b != b_end && !keep(*b)) {
+      ++b;
+    }
+    if (a == a_end || b == b_end) {
+      return;
+    }
+
+    const auto ka = key(*a);
+    const auto kb = key(*b);
+    if (ka < kb) {
+      ++a;
+    } else if (kb < ka) {
+      ++b;
+    } else {
+      if (!do_visit(a, b)) {
+        return;
+      }
+      ++a;
+      ++b;
+    }
+  }
+}
+
+}  // namespace katana
+
+#endif  // KATANA_LIBGRAPH_KATANA_SORTEDINTERSECTION_H_
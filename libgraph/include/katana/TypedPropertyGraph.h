@@ -350,7 +350,7 @@ Result<TypedPropertyGraphView<PGView, NodeProps, EdgeProps>>
 TypedPropertyGraphView<PGView, NodeProps, EdgeProps>::Make(
     PropertyGraph* pg, const std::vector<std::string>& node_properties,
     const std::vector<std::string>& edge_properties) {
-  auto pg_view = pg->BuildView<PGView>();
+  auto pg_view = KATANA_CHECKED(pg->MakeView<PGView>());
   KATANA_LOG_DEBUG_ASSERT(pg);
   auto node_view_result =
       internal::MakeNodePropertyViews<NodeProps>(pg, node_properties);
@@ -372,7 +372,7 @@ TypedPropertyGraphView<PGView, NodeProps, EdgeProps>::Make(
 template <typename PGView, typename NodeProps, typename EdgeProps>
 Result<TypedPropertyGraphView<PGView, NodeProps, EdgeProps>>
 TypedPropertyGraphView<PGView, NodeProps, EdgeProps>::Make(PropertyGraph* pg) {
-  auto pg_view = pg->BuildView<PGView>();
+  auto pg_view = KATANA_CHECKED(pg->MakeView<PGView>());
   return TypedPropertyGraphView<PGView, NodeProps, EdgeProps>::Make(
       pg_view, pg->loaded_node_schema()->field_names(),
       pg->loaded_edge_schema()->field_names());
@@ -20,15 +20,25 @@
 #ifndef KATANA_LIBGRAPH_KATANA_ANALYTICS_CLUSTERINGIMPLEMENTATIONBASE_H_
 #define KATANA_LIBGRAPH_KATANA_ANALYTICS_CLUSTERINGIMPLEMENTATIONBASE_H_
 
+#include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <set>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "katana/AtomicHelpers.h"
 #include "katana/Galois.h"
+#include "katana/GraphTopology.h"
 #include "katana/NUMAArray.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Properties.h"
+#include "katana/Traits.h"
 #include "katana/analytics/Utils.h"
 
 namespace katana::analytics {
@@ -64,6 +74,322 @@ using EdgeWeight = katana::PODProperty<EdgeWeightType>;
 struct CurrentSubCommunityID : public katana::PODProperty<uint64_t> {};
 struct NodeWeight : public katana::PODProperty<uint64_t> {};
 
+/// NeighborClusterMap sums the weights of the edges from a node, or from the
+/// nodes of a cluster, to each neighboring cluster. It is an open addressing
+/// hash table meant to be reused by one thread for many nodes: its capacity
+/// grows to fit the largest neighborhood seen and is kept, and Clear takes
+/// time proportional to the number of clusters in the map, so aggregating a
+/// neighborhood does not allocate.
+///
+/// Clusters are indexed in the order they were first added.
+template <typename EdgeWeightType>
+class NeighborClusterMap {
+public:
+  /// Add weight to the total of cluster, which starts at zero
+  void Add(uint64_t cluster, EdgeWeightType weight) {
+    if (2 * (clusters_.size() + 1) > slots_.size()) {
+      Grow();
+    }
+    uint64_t slot = Slot(cluster);
+    while (true) {
+      uint32_t index = slots_[slot];
+      if (index == kEmpty) {
+        slots_[slot] = clusters_.size();
+        used_slots_.emplace_back(slot);
+        clusters_.emplace_back(cluster);
+        weights_.emplace_back(weight);
+        return;
+      }
+      if (clusters_[index] == cluster) {
+        weights_[index] += weight;
+        return;
+      }
+      slot = (slot + 1) & (slots_.size() - 1);
+    }
+  }
+
+  void Clear() {
+    for (uint64_t slot : used_slots_) {
+      slots_[slot] = kEmpty;
+    }
+    used_slots_.clear();
+    clusters_.clear();
+    weights_.clear();
+  }
+
+  size_t size() const { return clusters_.size(); }
+  bool empty() const { return clusters_.empty(); }
+  uint64_t cluster(size_t index) const { return clusters_[index]; }
+  EdgeWeightType weight(size_t index) const { return weights_[index]; }
+
+private:
+  constexpr static uint32_t kEmpty = std::numeric_limits<uint32_t>::max();
+  constexpr static uint64_t kMinSlots = 16;
+
+  uint64_t Slot(uint64_t cluster) const {
+    // Fibonacci hashing spreads consecutive cluster IDs over the table
+    return (cluster * UINT64_C(0x9E3779B97F4A7C15)) >> shift_;
+  }
+
+  void Grow() {
+    uint64_t num_slots = std::max(kMinSlots, 2 * slots_.size());
+    slots_.assign(num_slots, kEmpty);
+    shift_ = 64 - __builtin_ctzll(num_slots);
+    used_slots_.clear();
+    for (size_t index = 0; index < clusters_.size(); ++index) {
+      uint64_t slot = Slot(clusters_[index]);
+      while (slots_[slot] != kEmpty) {
+        slot = (slot + 1) & (num_slots - 1);
+      }
+      slots_[slot] = index;
+      used_slots_.emplace_back(slot);
+    }
+  }
+
+  /// indexes into clusters_ and weights_, a power of two of them
+  std::vector<uint32_t> slots_;
+  uint32_t shift_{64};
+  std::vector<uint64_t> used_slots_;
+  std::vector<uint64_t> clusters_;
+  std::vector<EdgeWeightType> weights_;
+};
+
+/// One NUMAArray per node property of a CoarsenedGraph
+template <typename NodeProps>
+struct CoarsenedNodeData;
+
+template <typename... NodeProps>
+struct CoarsenedNodeData<std::tuple<NodeProps...>> {
+  using type = std::tuple<katana::NUMAArray<PropertyValueType<NodeProps>>...>;
+};
+
+/// CoarsenedGraph is the graph that Louvain and Leiden clustering iterate on:
+/// a CSR in NUMAArrays with an edge weight per edge and the node properties
+/// \p NodeProps in one NUMAArray each. Unlike a PropertyGraph it has no
+/// property tables to construct, so building a level of the clustering
+/// hierarchy costs only the sort and reduction of the edges between clusters.
+///
+/// It has the part of the TypedPropertyGraphView interface that
+/// ClusteringImplementationBase uses. Its edges are out-edges; a graph built
+/// from an undirected view has every edge in both directions.
+template <typename NodeProps, typename EdgeWeightType>
+class CoarsenedGraph {
+public:
+  using Node = GraphTopologyTypes::Node;
+  using Edge = GraphTopologyTypes::Edge;
+  using node_iterator = GraphTopologyTypes::node_iterator;
+  using edge_iterator = GraphTopologyTypes::edge_iterator;
+  using nodes_range = GraphTopologyTypes::nodes_range;
+  using edges_range = GraphTopologyTypes::edges_range;
+  using iterator = node_iterator;
+  using node_properties = NodeProps;
+  using edge_properties = std::tuple<EdgeWeight<EdgeWeightType>>;
+
+  /// Builds the graph whose nodes are the clusters of \p graph. Node n of
+  /// graph is in cluster cluster_of(n); nodes in a cluster of at least
+  /// \p num_clusters are dropped and must have no edges from other nodes.
+  ///
+  /// Each edge of graph becomes a (cluster, cluster, weight) triple. The
+  /// triples are sorted by source cluster with a parallel counting sort,
+  /// then each cluster sorts its triples by destination and sums the weights
+  /// of those with the same destination into one edge. Every weight is
+  /// multiplied by \p weight_scale. Node properties are zero.
+  template <typename InputGraph, typename ClusterFn>
+  static CoarsenedGraph Make(
+      const InputGraph& graph, uint64_t num_clusters,
+      const ClusterFn& cluster_of, EdgeWeightType weight_scale = 1);
+
+  /// Copies \p graph, merging parallel edges
+  template <typename InputGraph>
+  static CoarsenedGraph Copy(const InputGraph& graph) {
+    return Make(graph, graph.NumNodes(), [](Node n) { return uint64_t{n}; });
+  }
+
+  uint64_t NumNodes() const { return adj_indices_.size(); }
+  uint64_t NumEdges() const { return dests_.size(); }
+
+  edges_range OutEdges() const noexcept {
+    return MakeStandardRange<edge_iterator>(Edge{0}, Edge{NumEdges()});
+  }
+
+  edges_range OutEdges(Node node) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(node < NumNodes());
+    edge_iterator e_beg{node > 0 ? adj_indices_[node - 1] : 0};
+    edge_iterator e_end{adj_indices_[node]};
+    return MakeStandardRange(e_beg, e_end);
+  }
+
+  Node OutEdgeDst(Edge edge) const noexcept {
+    KATANA_LOG_DEBUG_ASSERT(edge < NumEdges());
+    return dests_[edge];
+  }
+
+  size_t OutDegree(Node node) const noexcept { return OutEdges(node).size(); }
+
+  nodes_range Nodes() const noexcept {
+    return MakeStandardRange<node_iterator>(
+        Node{0}, static_cast<Node>(NumNodes()));
+  }
+
+  node_iterator begin() const noexcept { return node_iterator(0); }
+  node_iterator end() const noexcept { return node_iterator(NumNodes()); }
+  size_t size() const noexcept { return NumNodes(); }
+  bool empty() const noexcept { return NumNodes() == 0; }
+
+  template <typename NodeProp>
+  PropertyValueType<NodeProp>& GetData(Node node) {
+    KATANA_LOG_DEBUG_ASSERT(node < NumNodes());
+    return std::get<find_trait<NodeProp, NodeProps>()>(node_data_)[node];
+  }
+
+  template <typename NodeProp>
+  const PropertyValueType<NodeProp>& GetData(Node node) const {
+    KATANA_LOG_DEBUG_ASSERT(node < NumNodes());
+    return std::get<find_trait<NodeProp, NodeProps>()>(node_data_)[node];
+  }
+
+  template <typename EdgeProp>
+  EdgeWeightType& GetEdgeData(Edge edge) {
+    static_assert(std::is_same_v<EdgeProp, EdgeWeight<EdgeWeightType>>);
+    KATANA_LOG_DEBUG_ASSERT(edge < NumEdges());
+    return weights_[edge];
+  }
+
+  template <typename EdgeProp>
+  const EdgeWeightType& GetEdgeData(Edge edge) const {
+    static_assert(std::is_same_v<EdgeProp, EdgeWeight<EdgeWeightType>>);
+    KATANA_LOG_DEBUG_ASSERT(edge < NumEdges());
+    return weights_[edge];
+  }
+
+private:
+  katana::NUMAArray<Edge> adj_indices_;
+  katana::NUMAArray<Node> dests_;
+  katana::NUMAArray<EdgeWeightType> weights_;
+  typename CoarsenedNodeData<NodeProps>::type node_data_;
+};
+
+template <typename NodeProps, typename EdgeWeightType>
+template <typename InputGraph, typename ClusterFn>
+CoarsenedGraph<NodeProps, EdgeWeightType>
+CoarsenedGraph<NodeProps, EdgeWeightType>::Make(
+    const InputGraph& graph, uint64_t num_clusters,
+    const ClusterFn& cluster_of, EdgeWeightType weight_scale) {
+  using InputNode = typename InputGraph::Node;
+  // The source cluster of a triple is implied by its position
+  using Triple = std::pair<Node, EdgeWeightType>;
+
+  CoarsenedGraph coarsened;
+
+  katana::NUMAArray<std::atomic<Edge>> cursors;
+  cursors.allocateBlocked(num_clusters);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_clusters),
+      [&](uint64_t c) { cursors[c] = 0; }, katana::no_stats());
+  katana::do_all(
+      katana::iterate(graph),
+      [&](InputNode n) {
+        uint64_t c = cluster_of(n);
+        if (c < num_clusters) {
+          katana::atomicAdd(cursors[c], static_cast<Edge>(Degree(graph, n)));
+        }
+      },
+      katana::loopname("Coarsen: Count"));
+
+  // Each cluster fills [bounds[c - 1], bounds[c]) of triples
+  katana::NUMAArray<Edge> bounds;
+  bounds.allocateInterleaved(num_clusters);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_clusters),
+      [&](uint64_t c) { bounds[c] = cursors[c]; }, katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      bounds.begin(), bounds.end(), bounds.begin());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_clusters),
+      [&](uint64_t c) { cursors[c] = c > 0 ? bounds[c - 1] : 0; },
+      katana::no_stats());
+  const Edge num_triples = num_clusters > 0 ? bounds[num_clusters - 1] : 0;
+
+  katana::NUMAArray<Triple> triples;
+  triples.allocateInterleaved(num_triples);
+  katana::do_all(
+      katana::iterate(graph),
+      [&](InputNode n) {
+        uint64_t c = cluster_of(n);
+        if (c >= num_clusters) {
+          return;
+        }
+        Edge pos =
+            katana::atomicAdd(cursors[c], static_cast<Edge>(Degree(graph, n)));
+        for (auto e : Edges(graph, n)) {
+          uint64_t dst_cluster = cluster_of(EdgeDst(graph, e));
+          KATANA_LOG_DEBUG_ASSERT(dst_cluster < num_clusters);
+          triples[pos++] = Triple(
+              static_cast<Node>(dst_cluster),
+              weight_scale *
+                  graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(e));
+        }
+      },
+      katana::steal(), katana::loopname("Coarsen: Scatter"));
+  cursors.destroy();
+  cursors.deallocate();
+
+  // Ordering by weight after destination makes sums of floating point
+  // weights independent of the order in which nodes were scattered
+  coarsened.adj_indices_.allocateInterleaved(num_clusters);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_clusters),
+      [&](uint64_t c) {
+        Triple* first = triples.data() + (c > 0 ? bounds[c - 1] : 0);
+        Triple* last = triples.data() + bounds[c];
+        std::sort(first, last);
+        Triple* out = first;
+        for (Triple* it = first; it != last;) {
+          Triple merged = *it;
+          for (++it; it != last && it->first == merged.first; ++it) {
+            merged.second += it->second;
+          }
+          *out++ = merged;
+        }
+        coarsened.adj_indices_[c] = out - first;
+      },
+      katana::steal(), katana::loopname("Coarsen: Reduce"));
+
+  katana::ParallelSTL::partial_sum(
+      coarsened.adj_indices_.begin(), coarsened.adj_indices_.end(),
+      coarsened.adj_indices_.begin());
+  const Edge num_edges =
+      num_clusters > 0 ? coarsened.adj_indices_[num_clusters - 1] : 0;
+
+  coarsened.dests_.allocateInterleaved(num_edges);
+  coarsened.weights_.allocateInterleaved(num_edges);
+  katana::do_all(
+      katana::iterate(uint64_t{0}, num_clusters),
+      [&](uint64_t c) {
+        const Triple* in = triples.data() + (c > 0 ? bounds[c - 1] : 0);
+        for (auto e : coarsened.OutEdges(c)) {
+          coarsened.dests_[e] = in->first;
+          coarsened.weights_[e] = in->second;
+          ++in;
+        }
+      },
+      katana::steal(), katana::loopname("Coarsen: Copy"));
+
+  std::apply(
+      [&](auto&... arrays) {
+        auto allocate = [&](auto& array) {
+          array.allocateBlocked(num_clusters);
+          katana::do_all(
+              katana::iterate(uint64_t{0}, num_clusters),
+              [&](uint64_t c) { array[c] = {}; }, katana::no_stats());
+        };
+        (allocate(arrays), ...);
+      },
+      coarsened.node_data_);
+
+  return coarsened;
+}
+
 template <typename _Graph, typename _EdgeType, typename _CommunityType>
 struct ClusteringImplementationBase {
   using Graph = _Graph;
@@ -82,44 +408,28 @@ struct ClusteringImplementationBase {
    * Algorithm to find the best cluster for the node
    * to move to among its neighbors in the graph and moves.
    *
-   * It updates the mapping of neighboring nodes clusters
-   * in cluster_local_map, total unique cluster edge weights
-   * in counter as well as total weight of self edges in self_loop_wt.
+   * It replaces the contents of clusters with the total weights of the
+   * edges to each neighboring cluster, starting with the node's own
+   * cluster, and adds the total weight of self edges to self_loop_wt.
    */
   template <typename EdgeWeightType>
   static void FindNeighboringClusters(
-      const Graph& graph, const GNode& n,
-      std::map<uint64_t, uint64_t>& cluster_local_map,
-      std::vector<EdgeTy>& counter, EdgeTy& self_loop_wt) {
-    uint64_t num_unique_clusters = 0;
+      const Graph& graph, const GNode& n, NeighborClusterMap<EdgeTy>* clusters,
+      EdgeTy& self_loop_wt) {
+    clusters->Clear();
 
     // Add the node's current cluster to be considered
-    // for movement as well
-    cluster_local_map[graph.template GetData<CurrentCommunityID>(n)] =
-        0;                 // Add n's current cluster
-    counter.push_back(0);  // Initialize the counter to zero (no edges incident
-                           // yet)
-    num_unique_clusters++;
+    // for movement as well, with no edges incident yet
+    clusters->Add(graph.template GetData<CurrentCommunityID>(n), 0);
 
     // Assuming we have grabbed lock on all the neighbors
     for (auto e : Edges(graph, n)) {
       auto dst = EdgeDst(graph, e);
-      // Self loop weights is recorded
       auto edge_wt = graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(e);
       if (dst == n) {
         self_loop_wt += edge_wt;  // Self loop weights is recorded
       }
-      auto stored_already =
-          cluster_local_map.find(graph.template GetData<CurrentCommunityID>(
-              dst));  // Check if it already exists
-      if (stored_already != cluster_local_map.end()) {
-        counter[stored_already->second] += edge_wt;
-      } else {
-        cluster_local_map[graph.template GetData<CurrentCommunityID>(dst)] =
-            num_unique_clusters;
-        counter.push_back(edge_wt);
-        num_unique_clusters++;
-      }
+      clusters->Add(graph.template GetData<CurrentCommunityID>(dst), edge_wt);
     }  // End edge loop
   }
 
@@ -127,8 +437,14 @@ struct ClusteringImplementationBase {
    * Enables the filtering optimization to remove the
    * node with out-degree 0 (isolated) and 1 before the clustering
    * algorithm begins.
+   *
+   * Degrees are taken from \p input, the graph that \p graph is a copy of.
+   * The copy merges parallel edges, and a node with parallel edges to its
+   * only neighbor must not follow it.
    */
-  static uint64_t VertexFollowing(Graph* graph) {
+  template <typename InputGraph>
+  static uint64_t VertexFollowing(const InputGraph& input, Graph* graph) {
+    KATANA_LOG_DEBUG_ASSERT(input.NumNodes() == graph->NumNodes());
     // Initialize each node to its own cluster
     katana::do_all(katana::iterate(*graph), [&](GNode n) {
       graph->template GetData<CurrentCommunityID>(n) = n;
@@ -139,16 +455,16 @@ struct ClusteringImplementationBase {
     katana::do_all(katana::iterate(*graph), [&](GNode n) {
       auto& n_data_curr_comm_id =
           graph->template GetData<CurrentCommunityID>(n);
-      uint64_t degree = Degree(*graph, n);
+      uint64_t degree = Degree(input, n);
       if (degree == 0) {
         isolated_nodes += 1;
         n_data_curr_comm_id = UNASSIGNED;
       } else {
         if (degree == 1) {
           // Check if the destination has degree greater than one
-          auto edge = Edges(*graph, n).begin();
-          auto dst = EdgeDst(*graph, *edge);
-          uint64_t dst_degree = Degree(*graph, dst);
+          auto edge = Edges(input, n).begin();
+          auto dst = EdgeDst(input, *edge);
+          uint64_t dst_degree = Degree(input, dst);
           if ((dst_degree > 1 || (n > dst))) {
             isolated_nodes += 1;
             n_data_curr_comm_id =
@@ -276,44 +592,40 @@ struct ClusteringImplementationBase {
    * without swapping the cluster assignment.
    */
   static uint64_t MaxModularityWithoutSwaps(
-      std::map<uint64_t, uint64_t>& cluster_local_map,
-      std::vector<EdgeTy>& counter, uint64_t self_loop_wt,
+      const NeighborClusterMap<EdgeTy>& clusters, uint64_t self_loop_wt,
       CommunityArray& c_info, EdgeTy degree_wt, uint64_t sc, double constant) {
     uint64_t max_index = sc;  // Assign the intial value as self community
     double cur_gain = 0;
     double max_gain = 0;
-    double eix = counter[0] - self_loop_wt;
+    double eix = clusters.weight(0) - self_loop_wt;
     double ax = c_info[sc].degree_wt - degree_wt;
     double eiy = 0;
     double ay = 0;
 
-    auto stored_already = cluster_local_map.begin();
-    do {
-      if (sc != stored_already->first) {
-        ay = c_info[stored_already->first].degree_wt;  // Degree wt of cluster y
+    for (size_t i = 0; i < clusters.size(); ++i) {
+      uint64_t cluster = clusters.cluster(i);
+      if (sc == cluster) {
+        continue;
+      }
+      ay = c_info[cluster].degree_wt;  // Degree wt of cluster y
 
-        if (ay < (ax + degree_wt)) {
-          stored_already++;
-          continue;
-        } else if (ay == (ax + degree_wt) && stored_already->first > sc) {
-          stored_already++;
-          continue;
-        }
+      if (ay < (ax + degree_wt)) {
+        continue;
+      } else if (ay == (ax + degree_wt) && cluster > sc) {
+        continue;
+      }
 
-        eiy = counter[stored_already
-                          ->second];  // Total edges incident on cluster y
-        cur_gain = 2 * constant * (eiy - eix) +
-                   2 * degree_wt * ((ax - ay) * constant * constant);
+      eiy = clusters.weight(i);  // Total edges incident on cluster y
+      cur_gain = 2 * constant * (eiy - eix) +
+                 2 * degree_wt * ((ax - ay) * constant * constant);
 
-        if ((cur_gain > max_gain) ||
-            ((cur_gain == max_gain) && (cur_gain != 0) &&
-             (stored_already->first < max_index))) {
-          max_gain = cur_gain;
-          max_index = stored_already->first;
-        }
+      if ((cur_gain > max_gain) ||
+          ((cur_gain == max_gain) && (cur_gain != 0) &&
+           (cluster < max_index))) {
+        max_gain = cur_gain;
+        max_index = cluster;
       }
-      stored_already++;  // Explore next cluster
-    } while (stored_already != cluster_local_map.end());
+    }
 
     if ((c_info[max_index].size == 1 && c_info[sc].size == 1 &&
          max_index > sc)) {
@@ -480,62 +792,6 @@ struct ClusteringImplementationBase {
     auto mod = CalModularityFinal<EdgeWeightType, CurrentCommunityID>(graph);
   }
 
-  /**
- * Creates a duplicate of the graph by copying the
- * graph (pfg_from) topology
- * (read from the underlying RDG) to the in-memory
- * temporary graph (pfg_to).
- * TODO(gill) replace with ephemeral graph
- */
-  static katana::Result<std::unique_ptr<katana::PropertyGraph>>
-  DuplicateGraphWithSameTopo(const katana::PropertyGraph& pfg_from) {
-    // The resulting PropertyGraph is detached from the property table of the input graph.
-    // Thus any property index indirection of the original topology has to be dropped.
-    katana::GraphTopology topo_copy =
-        GraphTopology::CopyWithoutPropertyIndexes(pfg_from.topology());
-    return katana::PropertyGraph::Make(std::move(topo_copy));
-  }
-
-  /**
- * Copy edge property from
- * property graph, pg_from to pg_to.
- */
-  template <typename GraphViewTy>
-  static katana::Result<void> CopyEdgeProperty(
-      katana::PropertyGraph* pfg_from, katana::PropertyGraph* pfg_to,
-      const std::string& new_edge_property_name, katana::TxnContext* txn_ctx) {
-    // Remove the existing edge property
-    if (pfg_to->HasEdgeProperty(new_edge_property_name)) {
-      if (auto r = pfg_to->RemoveEdgeProperty(new_edge_property_name, txn_ctx);
-          !r) {
-        return r.error();
-      }
-    }
-
-    using NodeData = std::tuple<>;
-    using EdgeData = std::tuple<EdgeWeight<EdgeTy>>;
-    using GraphTy =
-        katana::TypedPropertyGraphView<GraphViewTy, NodeData, EdgeData>;
-
-    std::vector<std::string> new_edge_property_vec{"new_edge_property_name"};
-    KATANA_CHECKED(pfg_to->ConstructEdgeProperties<EdgeData>(
-        txn_ctx, new_edge_property_vec));
-
-    auto graph_to = KATANA_CHECKED(GraphTy::Make(pfg_to));
-    auto graph_from = KATANA_CHECKED(GraphTy::Make(pfg_from));
-
-    using Edge = katana::GraphTopology::Edge;
-    // Copy edge properties
-    katana::do_all(
-        katana::iterate(graph_from.OutEdges()),
-        [&](Edge e) {
-          graph_to.template GetEdgeData<EdgeWeight<EdgeTy>>(e) =
-              graph_from.template GetEdgeData<EdgeWeight<EdgeTy>>(e);
-        },
-        katana::no_stats());
-    return katana::ResultSuccess();
-  }
-
   /**
  * Creates a coarsened hierarchical graph for the next phase
  * of the clustering algorithm. It merges all the nodes within a
@@ -543,180 +799,21 @@ struct ClusteringImplementationBase {
  * The total number of nodes in the coarsened graph are equal to
  * the number of unique clusters in the previous level of the graph.
  * All the edges inside a cluster are merged (edge weights are summed
- * up) to form the edges within super nodes.
+ * up) to form the edges within super nodes. Edge weights of the
+ * coarsened graph are multiplied by weight_scale.
  */
-  template <
-      typename NodeData, typename EdgeData, typename EdgeWeightType,
-      typename CommunityIDType>
-  static katana::Result<std::unique_ptr<katana::PropertyGraph>> GraphCoarsening(
-      const Graph& graph, katana::PropertyGraph* pfg_mutable,
-      uint64_t num_unique_clusters,
-      const std::vector<std::string>& temp_node_property_names,
-      const std::vector<std::string>& temp_edge_property_names,
-      katana::TxnContext* txn_ctx) {
-    using GNode = typename Graph::Node;
-
+  template <typename CommunityIDType>
+  static Graph GraphCoarsening(
+      const Graph& graph, uint64_t num_unique_clusters,
+      EdgeTy weight_scale = 1) {
     katana::StatTimer TimerGraphBuild("Timer_Graph_build");
-    TimerGraphBuild.start();
-
-    const uint64_t num_nodes_next = num_unique_clusters;
-
-    std::vector<std::vector<GNode>> cluster_bags(num_unique_clusters);
-    // TODO(amber): This loop can be parallelized when using a concurrent container
-    // for cluster_bags, but something like katana::InsertBag exhausts the
-    // per-thread-storage memory
-    for (GNode n = 0; n < graph.NumNodes(); ++n) {
-      auto n_data_curr_comm_id = graph.template GetData<CommunityIDType>(n);
-      if (n_data_curr_comm_id != UNASSIGNED) {
-        cluster_bags[n_data_curr_comm_id].push_back(n);
-      }
-    }
-
-    std::vector<katana::gstl::Vector<uint32_t>> edges_id(num_unique_clusters);
-    std::vector<katana::gstl::Vector<EdgeTy>> edges_data(num_unique_clusters);
-
-    /* First pass to find the number of edges */
-    katana::do_all(
-        katana::iterate(uint64_t{0}, num_unique_clusters),
-        [&](uint64_t c) {
-          katana::gstl::Map<uint64_t, uint64_t> cluster_local_map;
-          uint64_t num_unique_clusters = 0;
-          for (auto node : cluster_bags[c]) {
-            KATANA_LOG_DEBUG_ASSERT(
-                graph.template GetData<CommunityIDType>(node) ==
-                c);  // All nodes in this bag must have same cluster id
-
-            for (auto e : Edges(graph, node)) {
-              auto dst = EdgeDst(graph, e);
-              auto dst_data_curr_comm_id =
-                  graph.template GetData<CommunityIDType>(dst);
-              KATANA_LOG_DEBUG_ASSERT(dst_data_curr_comm_id != UNASSIGNED);
-              auto stored_already = cluster_local_map.find(
-                  dst_data_curr_comm_id);  // Check if it already exists
-              if (stored_already != cluster_local_map.end()) {
-                edges_data[c][stored_already->second] +=
-                    graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(e);
-              } else {
-                cluster_local_map[dst_data_curr_comm_id] = num_unique_clusters;
-                edges_id[c].push_back(dst_data_curr_comm_id);
-                edges_data[c].push_back(
-                    graph.template GetEdgeData<EdgeWeight<EdgeWeightType>>(e));
-                num_unique_clusters++;
-              }
-            }  // End edge loop
-          }
-        },
-        katana::steal(), katana::loopname("BuildGraph: Find edges"));
-
-    /* Serial loop to reduce all the edge counts */
-    katana::NUMAArray<uint64_t> prefix_edges_count;
-    prefix_edges_count.allocateInterleaved(num_unique_clusters);
+    katana::TimerGuard TimerGraphBuildGuard(TimerGraphBuild);
 
-    katana::GAccumulator<uint64_t> num_edges_acc;
-    katana::do_all(
-        katana::iterate(uint64_t{0}, num_nodes_next), [&](uint64_t c) {
-          prefix_edges_count[c] = edges_id[c].size();
-          num_edges_acc += prefix_edges_count[c];
-        });
-
-    const uint64_t num_edges_next = num_edges_acc.reduce();
-
-    katana::ParallelSTL::partial_sum(
-        prefix_edges_count.begin(), prefix_edges_count.end(),
-        prefix_edges_count.begin());
-
-    KATANA_LOG_DEBUG_ASSERT(
-        prefix_edges_count[num_unique_clusters - 1] == num_edges_next);
-    katana::StatTimer TimerConstructFrom("Timer_Construct_From");
-    TimerConstructFrom.start();
-
-    // Remove all the existing node/edge properties
-    for (auto property : temp_node_property_names) {
-      if (pfg_mutable->HasNodeProperty(property)) {
-        if (auto r = pfg_mutable->RemoveNodeProperty(property, txn_ctx); !r) {
-          return r.error();
-        }
-      }
-    }
-    for (auto property : temp_edge_property_names) {
-      if (pfg_mutable->HasEdgeProperty(property)) {
-        if (auto r = pfg_mutable->RemoveEdgeProperty(property, txn_ctx); !r) {
-          return r.error();
-        }
-      }
-    }
-
-    using Node = katana::GraphTopology::Node;
-    using Edge = katana::GraphTopology::Edge;
-
-    katana::NUMAArray<Node> out_dests_next;
-    out_dests_next.allocateInterleaved(num_edges_next);
-
-    katana::NUMAArray<EdgeWeightType> edge_data_next;
-    edge_data_next.allocateInterleaved(num_edges_next);
-
-    katana::do_all(
-        katana::iterate(uint64_t{0}, num_nodes_next), [&](uint64_t n) {
-          uint64_t number_of_edges =
-              (n == 0) ? prefix_edges_count[0]
-                       : (prefix_edges_count[n] - prefix_edges_count[n - 1]);
-          uint64_t start_index = (n == 0) ? 0 : prefix_edges_count[n - 1];
-          for (uint64_t k = 0; k < number_of_edges; ++k) {
-            out_dests_next[start_index + k] = edges_id[n][k];
-            edge_data_next[start_index + k] = edges_data[n][k];
-          }
-        });
-
-    TimerConstructFrom.stop();
-
-    // TODO(amber): This is a lame attempt at freeing the memory back to each
-    // thread's pool of free pages and blocks. Due to stealing, the execution of
-    // do_all above that populates these containers may be different from the
-    // do_all below that frees them.
-    katana::do_all(
-        katana::iterate(uint64_t{0}, num_unique_clusters), [&](uint64_t c) {
-          edges_id[c] = gstl::Vector<uint32_t>();
-          edges_data[c] = gstl::Vector<EdgeTy>();
-        });
-
-    GraphTopology topo_next{
-        std::move(prefix_edges_count), std::move(out_dests_next)};
-    auto pfg_next_res = katana::PropertyGraph::Make(std::move(topo_next));
-
-    if (!pfg_next_res) {
-      return pfg_next_res.error();
-    }
-    std::unique_ptr<katana::PropertyGraph> pfg_next =
-        std::move(pfg_next_res.value());
-
-    if (auto result = pfg_next->ConstructNodeProperties<NodeData>(
-            txn_ctx, temp_node_property_names);
-        !result) {
-      return result.error();
-    }
-
-    if (auto result = pfg_next->ConstructEdgeProperties<EdgeData>(
-            txn_ctx, temp_edge_property_names);
-        !result) {
-      return result.error();
-    }
-
-    auto graph_result = Graph::Make(pfg_next.get());
-    if (!graph_result) {
-      return graph_result.error();
-    }
-    Graph graph_next = graph_result.value();
-    // TODO(amber): figure out a better way to add/update the edge property
-    katana::do_all(
-        katana::iterate(graph_next.OutEdges()),
-        [&](Edge e) {
-          graph_next.template GetEdgeData<EdgeWeight<EdgeWeightType>>(e) =
-              edge_data_next[e];
-        },
-        katana::no_stats());
-
-    TimerGraphBuild.stop();
-    return std::unique_ptr<katana::PropertyGraph>(std::move(pfg_next));
+    // Nodes in cluster UNASSIGNED are left out of the coarsened graph
+    return Graph::Make(
+        graph, num_unique_clusters,
+        [&](GNode n) { return graph.template GetData<CommunityIDType>(n); },
+        weight_scale);
   }
 
   /**
@@ -1073,37 +1170,35 @@ struct ClusteringImplementationBase {
 
   template <typename EdgeWeightType>
   uint64_t MaxCPMQualityWithoutSwaps(
-      std::map<uint64_t, uint64_t>& cluster_local_map,
-      std::vector<EdgeWeightType>& counter, EdgeWeightType self_loop_wt,
-      CommunityArray& c_info, uint64_t node_wt, uint64_t sc,
-      double resolution) {
+      const NeighborClusterMap<EdgeWeightType>& clusters,
+      EdgeWeightType self_loop_wt, CommunityArray& c_info, uint64_t node_wt,
+      uint64_t sc, double resolution) {
     uint64_t max_index = sc;  // Assign the initial value as self community
     double cur_gain = 0;
     double max_gain = 0;
-    double eix = counter[0] - self_loop_wt;
+    double eix = clusters.weight(0) - self_loop_wt;
     double eiy = 0;
     auto size_x = static_cast<double>(c_info[sc].node_wt - node_wt);
     double size_y = 0;
 
-    auto stored_already = cluster_local_map.begin();
-    do {
-      if (sc != stored_already->first) {
-        eiy = counter[stored_already
-                          ->second];  // Total edges incident on cluster y
-        size_y = c_info[stored_already->first].node_wt;
-
-        cur_gain = 2.0 * (eiy - eix) - resolution *
-                                           static_cast<double>(node_wt) *
-                                           (size_y - size_x);
-        if ((cur_gain > max_gain) ||
-            ((cur_gain == max_gain) && (cur_gain != 0) &&
-             (stored_already->first < max_index))) {
-          max_gain = cur_gain;
-          max_index = stored_already->first;
-        }
+    for (size_t i = 0; i < clusters.size(); ++i) {
+      uint64_t cluster = clusters.cluster(i);
+      if (sc == cluster) {
+        continue;
       }
-      stored_already++;  // Explore next cluster
-    } while (stored_already != cluster_local_map.end());
+      eiy = clusters.weight(i);  // Total edges incident on cluster y
+      size_y = c_info[cluster].node_wt;
+
+      cur_gain = 2.0 * (eiy - eix) - resolution *
+                                         static_cast<double>(node_wt) *
+                                         (size_y - size_x);
+      if ((cur_gain > max_gain) ||
+          ((cur_gain == max_gain) && (cur_gain != 0) &&
+           (cluster < max_index))) {
+        max_gain = cur_gain;
+        max_index = cluster;
+      }
+    }
 
     if ((c_info[max_index].size == 1 && c_info[sc].size == 1 &&
          max_index > sc)) {
@@ -18,16 +18,35 @@ public:
   enum Algorithm {
     kLevel,
     kOuter,
+    kSampling,
     // TODO(gill): Reinstate async and auto once we have bidirectional graphs.
     // kAsynchronous,
     // kAutomatic,
   };
 
+  static constexpr double kDefaultEpsilon = 0.01;
+  static constexpr double kDefaultDelta = 0.1;
+  static const uint64_t kDefaultSeed = 0;
+
 private:
   Algorithm algorithm_;
+  double epsilon_;
+  double delta_;
+  uint64_t seed_;
+
+  BetweennessCentralityPlan(
+      Architecture architecture, Algorithm algorithm, double epsilon,
+      double delta, uint64_t seed)
+      : Plan(architecture),
+        algorithm_(algorithm),
+        epsilon_(epsilon),
+        delta_(delta),
+        seed_(seed) {}
 
   BetweennessCentralityPlan(Architecture architecture, Algorithm algorithm)
-      : Plan(architecture), algorithm_(algorithm) {}
+      : BetweennessCentralityPlan(
+            architecture, algorithm, kDefaultEpsilon, kDefaultDelta,
+            kDefaultSeed) {}
 
 public:
   BetweennessCentralityPlan() : BetweennessCentralityPlan{kCPU, kLevel} {}
@@ -50,11 +69,38 @@ public:
   }
 
   Algorithm algorithm() const { return algorithm_; }
+  double epsilon() const { return epsilon_; }
+  double delta() const { return delta_; }
+  uint64_t seed() const { return seed_; }
 
   static BetweennessCentralityPlan Level() { return {kCPU, kLevel}; }
 
   static BetweennessCentralityPlan Outer() { return {kCPU, kOuter}; }
 
+  /// Approximate betweenness centrality from uniformly sampled sources
+  ///
+  /// Sources are drawn, with replacement, until with probability at least
+  /// 1 - delta the betweenness of every node normalized by n * (n - 1) is
+  /// within epsilon of its exact value, and the result is scaled to be
+  /// comparable with the exact betweenness. Sampling stops early once
+  /// empirical Bernstein bounds, which shrink with the variance of the
+  /// dependencies of each node, are met, and otherwise when the Hoeffding
+  /// bound is met after ln(4n / delta) / (2 epsilon^2) sources. The number
+  /// of sources and the bound reached are reported as the SampledSources
+  /// and ErrorBound statistics. Each source is processed like in Level.
+  ///
+  /// BRANDES, Ulrik; PICH, Christian. Centrality estimation in large
+  /// networks. International Journal of Bifurcation and Chaos, 2007, 17.07:
+  /// 2303-2318.
+  ///
+  /// MAURER, Andreas; PONTIL, Massimiliano. Empirical Bernstein bounds and
+  /// sample variance penalization. In: Conference on Learning Theory, 2009.
+  static BetweennessCentralityPlan Sampling(
+      double epsilon = kDefaultEpsilon, double delta = kDefaultDelta,
+      uint64_t seed = kDefaultSeed) {
+    return {kCPU, kSampling, epsilon, delta, seed};
+  }
+
   static BetweennessCentralityPlan FromAlgorithm(Algorithm algo) {
     return BetweennessCentralityPlan(kCPU, algo);
   }
@@ -78,6 +124,8 @@ KATANA_EXPORT extern const BetweennessCentralitySources
 /// @param sources Only process some sources, producing an approximate
 ///          betweenness centrality. If this is a vector process those source
 ///          nodes; if this is an int process that number of source nodes.
+///          With the Sampling plan, an int caps the number of sampled
+///          sources, and a vector is not supported.
 /// @param plan
 KATANA_EXPORT Result<void> BetweennessCentrality(
     PropertyGraph* pg, const std::string& output_property_name,
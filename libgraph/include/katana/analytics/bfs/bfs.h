@@ -2,6 +2,9 @@
 #define KATANA_LIBGRAPH_KATANA_ANALYTICS_BFS_BFS_H_
 
 #include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
 
 #include "katana/analytics/Plan.h"
 #include "katana/analytics/Utils.h"
@@ -80,6 +83,30 @@ KATANA_EXPORT Result<void> Bfs(
     const std::string& output_property_name, katana::TxnContext* txn_ctx,
     BfsPlan algo = {});
 
+/// The distance of a node from a source of MultiSourceBfs that does not
+/// reach it
+constexpr uint32_t kMultiSourceBfsUnreached =
+    std::numeric_limits<uint32_t>::max();
+
+/// Compute the BFS distance, in hops, of every node in the graph pg from
+/// each node in sources. The result is stored in a property named by
+/// output_property_name, a fixed size list of sources.size() uint32s per
+/// node, the i-th of which is the distance from sources[i] or
+/// kMultiSourceBfsUnreached.
+///
+/// Sources are traversed together in batches of up to 512, with a bit per
+/// source in masks of the nodes seen, visited in the current level and to
+/// visit in the next (Then et al., The More the Merrier: Efficient
+/// Multi-Source Graph Traversal, VLDB 2014), so each edge is scanned once
+/// per level for the whole batch. Levels switch between push and pull
+/// like kSynchronousDirectOpt, which is the only supported algorithm.
+/// The property named output_property_name is created by this function and may
+/// not exist before the call.
+KATANA_EXPORT Result<void> MultiSourceBfs(
+    PropertyGraph* pg, const std::vector<uint32_t>& sources,
+    const std::string& output_property_name, katana::TxnContext* txn_ctx,
+    BfsPlan algo = {});
+
 /// Do a quick validation of the results of a BFS computation where the results
 /// are stored in property_name. This function does do an exhaustive check.
 /// @return a failure if the BFS results do not pass validation or if there is a
@@ -2,6 +2,10 @@
 #define KATANA_LIBGRAPH_KATANA_ANALYTICS_JACCARD_JACCARD_H_
 
 #include <iostream>
+#include <memory>
+#include <vector>
+
+#include <arrow/api.h>
 
 #include "katana/Properties.h"
 #include "katana/PropertyGraph.h"
@@ -62,6 +66,17 @@ KATANA_EXPORT Result<void> Jaccard(
     const std::string& output_property_name, katana::TxnContext* txn_ctx,
     JaccardPlan plan = {});
 
+/// Compute, in a single parallel pass, the k nodes most similar to each node
+/// in query_nodes, or to every node if query_nodes is empty. Candidates are
+/// the nodes sharing at least one neighbor with the query, so nodes with
+/// similarity 0 and the query node itself are never reported. The result is
+/// an edge list with columns "source" (the query node), "destination" (the
+/// similar node) and "similarity"; the rows of a query are contiguous and
+/// ordered by decreasing similarity, with ties broken by node id. Candidate
+/// counting does not depend on the order of edges, so there is no plan.
+KATANA_EXPORT Result<std::shared_ptr<arrow::Table>> JaccardTopK(
+    PropertyGraph* pg, const std::vector<uint32_t>& query_nodes, uint32_t k);
+
 KATANA_EXPORT Result<void> JaccardAssertValid(
     PropertyGraph* pg, uint32_t compare_node, const std::string& property_name);
 
@@ -17,7 +17,7 @@ namespace katana::analytics {
 class KCorePlan : public Plan {
 public:
   /// Algorithm selectors for KCore
-  enum Algorithm { kSynchronous, kAsynchronous };
+  enum Algorithm { kSynchronous, kAsynchronous, kBucketed };
 
   // Don't allow people to directly construct these, so as to have only one
   // consistent way to configure.
@@ -40,6 +40,13 @@ public:
 
   /// Asynchronous k-core algorithm.
   static KCorePlan Asynchronous() { return {kCPU, kAsynchronous}; }
+
+  /// Peel nodes in the order of their degree, keeping nodes in buckets by
+  /// current degree as in Julienne (Dhulipala, Blelloch and Shun, "Julienne:
+  /// A Framework for Parallel Graph Algorithms using Work-efficient
+  /// Bucketing", SPAA 2017). Computes the core number of every node in one
+  /// run, so it is the only algorithm supported by KCoreNumbers.
+  static KCorePlan Bucketed() { return {kCPU, kBucketed}; }
 };
 
 /// Compute the k-core for pg. The pg must be symmetric.
@@ -52,6 +59,17 @@ KATANA_EXPORT Result<void> KCore(
     const std::string& output_property_name, katana::TxnContext* txn_ctx,
     const bool& is_symmetric = false, KCorePlan plan = KCorePlan());
 
+/// Compute the core number of every node of pg, the largest k such that the
+/// node is in the k-core. The pg must be symmetric, unless is_symmetric is
+/// false, in which case the edges are taken to be undirected. Only
+/// KCorePlan::Bucketed is supported.
+/// The uint32 property named output_property_name is created by this function
+/// and may not exist before the call.
+KATANA_EXPORT Result<void> KCoreNumbers(
+    PropertyGraph* pg, const std::string& output_property_name,
+    katana::TxnContext* txn_ctx, const bool& is_symmetric = false,
+    KCorePlan plan = KCorePlan::Bucketed());
+
 KATANA_EXPORT Result<void> KCoreAssertValid(
     PropertyGraph* pg, uint32_t k_core_number,
     const std::string& property_name);
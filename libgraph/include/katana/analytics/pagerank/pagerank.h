@@ -2,6 +2,8 @@
 #define KATANA_LIBGRAPH_KATANA_ANALYTICS_PAGERANK_PAGERANK_H_
 
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include "katana/Properties.h"
 #include "katana/PropertyGraph.h"
@@ -112,6 +114,80 @@ KATANA_EXPORT Result<void> Pagerank(
     PropertyGraph* pg, const std::string& output_property_name,
     katana::TxnContext* txn_ctx, PagerankPlan plan = {});
 
+/// An edge inserted into or deleted from a graph; see PagerankIncremental
+struct KATANA_EXPORT PagerankEdgeChange {
+  GraphTopology::Node src;
+  GraphTopology::Node dst;
+  /// False if the edge was deleted
+  bool inserted;
+};
+
+/// Update the Page Rank of a graph after a few of its edges changed. pg is
+/// the graph after the change, and the property named previous_property_name
+/// holds the Page Rank of the graph before the change, as computed by a
+/// residual or push algorithm with the same alpha. new_nodes are the nodes
+/// of pg that did not exist before the change; their previous Page Rank is
+/// ignored. deleted_nodes are nodes that were removed by the change. They
+/// keep their ids in pg but must have no edges to or from them; their edges
+/// must be listed as deleted in changed_edges. Their Page Rank is 0.
+///
+/// Rather than starting from the initial residual everywhere, this seeds
+/// residuals only at the destinations of the edges of nodes whose edges
+/// changed, and at new nodes, and converges with the asynchronous push
+/// algorithm, so it usually touches a small part of the graph. The result
+/// is within the tolerance of the plan of what Pagerank would compute from
+/// scratch. plan must be a PushAsynchronous plan.
+///
+/// The property named output_property_name is created by this function and
+/// may not exist before the call.
+KATANA_EXPORT Result<void> PagerankIncremental(
+    PropertyGraph* pg, const std::string& previous_property_name,
+    const std::vector<PagerankEdgeChange>& changed_edges,
+    const std::vector<GraphTopology::Node>& new_nodes,
+    const std::vector<GraphTopology::Node>& deleted_nodes,
+    const std::string& output_property_name, katana::TxnContext* txn_ctx,
+    PagerankPlan plan = {});
+
+/// Compute the Personalized Page Rank of each node with respect to a set of
+/// seed nodes: the probability that a random walk, which restarts at a
+/// uniformly chosen seed with probability 1 - alpha before each step, is at
+/// the node. Walks that reach a node without out-edges end there, as in
+/// Pagerank, so the ranks sum to at most 1.
+///
+/// This is the forward push of Andersen, Chung and Lang on the residual
+/// worklist of the asynchronous push algorithm: a node is pushed while its
+/// residual exceeds tolerance times its out degree, so the work done depends
+/// on the tolerance and on the neighborhood of the seeds rather than on the
+/// size of the graph. The ranks are within tolerance * (number of edges +
+/// number of nodes) / (1 - alpha) of the exact ranks in total. plan must be
+/// a PushAsynchronous plan.
+///
+/// The property named output_property_name is created by this function and
+/// may not exist before the call.
+KATANA_EXPORT Result<void> PersonalizedPagerank(
+    PropertyGraph* pg, const std::vector<GraphTopology::Node>& seeds,
+    const std::string& output_property_name, katana::TxnContext* txn_ctx,
+    PagerankPlan plan = {});
+
+/// Compute the Personalized Page Rank of each node with respect to each
+/// node of sources, as PersonalizedPagerank with a single seed would. The
+/// output property is a fixed size list of sources.size() floats per node,
+/// the i-th of which is the rank with respect to sources[i].
+///
+/// Residuals are vectors with one element per source, so each push along an
+/// edge serves every source whose residual at the node is non-zero. This is
+/// much faster than computing the ranks one source at a time, but memory
+/// grows with the product of the number of nodes and of sources; callers
+/// should split large numbers of sources into batches. plan must be a
+/// PushAsynchronous plan.
+///
+/// The property named output_property_name is created by this function and
+/// may not exist before the call.
+KATANA_EXPORT Result<void> PersonalizedPagerankBatch(
+    PropertyGraph* pg, const std::vector<GraphTopology::Node>& sources,
+    const std::string& output_property_name, katana::TxnContext* txn_ctx,
+    PagerankPlan plan = {});
+
 KATANA_EXPORT Result<void> PagerankAssertValid(
     PropertyGraph* pg, const std::string& property_name);
 
@@ -2,10 +2,13 @@
 #define KATANA_LIBGRAPH_KATANA_ANALYTICS_RANDOMWALKS_RANDOMWALKS_H_
 
 #include <iostream>
+#include <limits>
 
+#include <arrow/api.h>
 #include <katana/analytics/Plan.h>
 
 #include "katana/AtomicHelpers.h"
+#include "katana/NUMAArray.h"
 #include "katana/analytics/Utils.h"
 
 // API
@@ -17,7 +20,7 @@ namespace katana::analytics {
 class RandomWalksPlan : public Plan {
 public:
   /// Algorithm selectors for random walks
-  enum Algorithm { kNode2Vec, kEdge2Vec };
+  enum Algorithm { kNode2Vec, kEdge2Vec, kFirstOrder };
 
   static const Algorithm kDefaultAlgorithm = kNode2Vec;
   static const uint32_t kDefaultWalkLength = 1;
@@ -131,6 +134,61 @@ public:
         max_iterations,
         number_of_edge_types};
   }
+
+  /// First-order walks, where each step goes to an out-neighbor of the
+  /// current node independently of the previous steps: with probability
+  /// proportional to the edge weight when walks are generated with an edge
+  /// weight property, and uniformly otherwise. Weighted steps take O(1) time
+  /// by sampling from per-node alias tables (Walker, "An Efficient Method for
+  /// Generating Discrete Random Variables with General Distributions", 1977).
+  static RandomWalksPlan FirstOrder(
+      uint32_t walk_length = kDefaultWalkLength,
+      uint32_t number_of_walks = kDefaultNumberOfWalks) {
+    return {
+        kCPU,
+        kFirstOrder,
+        walk_length,
+        number_of_walks,
+        kDefaultBackwardProbability,
+        kDefaultForwardProbability,
+        0,
+        1};
+  }
+};
+
+/// Marks the steps of a walk after it reached a node without out-edges
+constexpr uint32_t kRandomWalkEnd = std::numeric_limits<uint32_t>::max();
+
+/// Random walks stored in one flat row-major array with a row of
+/// walk_length() + 1 nodes per walk. Walk i starts at node i % NumNodes();
+/// the rows of walks that reach a node without out-edges, including those
+/// that start at one, are padded with kRandomWalkEnd.
+class KATANA_EXPORT RandomWalkMatrix {
+public:
+  RandomWalkMatrix() = default;
+  RandomWalkMatrix(uint64_t num_walks, uint32_t walk_length);
+
+  uint64_t num_walks() const { return num_walks_; }
+  uint32_t walk_length() const { return walk_length_; }
+  uint32_t row_length() const { return walk_length_ + 1; }
+
+  const uint32_t* walk(uint64_t i) const {
+    return nodes_.data() + i * row_length();
+  }
+  uint32_t* walk(uint64_t i) { return nodes_.data() + i * row_length(); }
+
+  /// Hand the walks to arrow without copying them, as a list of
+  /// row_length() nodes per walk. The matrix is empty afterwards.
+  Result<std::shared_ptr<arrow::FixedSizeListArray>> ToArrow();
+
+  /// Copy the walks into one vector per walk without the padding, leaving
+  /// out walks that start at a node without out-edges
+  std::vector<std::vector<uint32_t>> ToVectors() const;
+
+private:
+  uint64_t num_walks_{0};
+  uint32_t walk_length_{0};
+  NUMAArray<uint32_t> nodes_;
 };
 
 /// Compute the random-walks for pg. The pg is expected to be symmetric. The
@@ -140,6 +198,23 @@ public:
 KATANA_EXPORT Result<std::vector<std::vector<uint32_t>>> RandomWalks(
     PropertyGraph* pg, RandomWalksPlan plan = RandomWalksPlan());
 
+/// Compute the random-walks for pg like RandomWalks, but write them into a
+/// RandomWalkMatrix, which is allocated once rather than per walk. Edge2Vec
+/// generates number_of_walks() walks per node in each of its iterations, and
+/// returns the walks of all iterations. Edge2Vec drops the walks that reach a
+/// node without out-edges before walk_length() steps: their rows hold only
+/// the start node, like the rows of walks that start at such a node.
+KATANA_EXPORT Result<RandomWalkMatrix> GenerateRandomWalks(
+    PropertyGraph* pg, RandomWalksPlan plan = RandomWalksPlan());
+
+/// Compute weighted first-order random walks for pg, which step to an
+/// out-neighbor with probability proportional to the weight of the edge to
+/// it. The weights must be non-negative; nodes whose out-edges all have
+/// weight 0 end walks. Only RandomWalksPlan::FirstOrder supports weights.
+KATANA_EXPORT Result<RandomWalkMatrix> GenerateRandomWalks(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    RandomWalksPlan plan = RandomWalksPlan::FirstOrder());
+
 KATANA_EXPORT Result<void> RandomWalksAssertValid(PropertyGraph* pg);
 
 }  // namespace katana::analytics
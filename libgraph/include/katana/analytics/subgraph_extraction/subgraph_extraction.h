@@ -13,6 +13,7 @@ class SubGraphExtractionPlan : public Plan {
 public:
   enum Algorithm {
     kNodeSet,
+    kCompressedNodeSet,
   };
 
 private:
@@ -40,6 +41,16 @@ public:
    *    connecting all the nodes in the set along with the properties requested.
    */
   static SubGraphExtractionPlan NodeSet() { return {kCPU, kNodeSet}; }
+
+  /**
+   * The node-set algorithm on a compressed copy of the topology
+   * (PropertyGraphViews::Compressed) instead of a copy sorted by destination.
+   * Uses less memory on graphs whose edges are not sorted by destination, at
+   * the cost of decoding destinations during the edge searches.
+   */
+  static SubGraphExtractionPlan CompressedNodeSet() {
+    return {kCPU, kCompressedNodeSet};
+  }
 };
 
 /**
@@ -9,6 +9,7 @@
 #include <limits>
 #include <map>
 #include <optional>
+#include <queue>
 #include <random>
 #include <sstream>
 #include <unordered_map>
@@ -17,8 +18,11 @@
 
 #include <arrow/api.h>
 #include <arrow/array.h>
+#include <arrow/array/concatenate.h>
 #include <arrow/io/api.h>
+#include <arrow/util/byte_size.h>
 #include <boost/algorithm/string.hpp>
+#include <boost/filesystem.hpp>
 #include <boost/foreach.hpp>
 #include <boost/lexical_cast.hpp>
 #include <parquet/arrow/reader.h>
@@ -49,9 +53,12 @@ using katana::LabelRule;
 using katana::LabelsState;
 using katana::PropertiesState;
 using katana::PropertyKey;
+using katana::SpillFile;
 using katana::TopologyState;
 using katana::WriterProperties;
 
+namespace fs = boost::filesystem;
+
 namespace {
 
 /************************************/
@@ -1148,6 +1155,366 @@ BuildImportVec(
   return array;
 }
 
+/**********************************************/
+/* Functions for spilling to and from storage */
+/**********************************************/
+
+// Edges buffered by a spilling builder: a source and a destination, and the
+// edge index once they are sorted
+constexpr size_t kBytesPerBufferedEdge = 16;
+constexpr int64_t kEdgeRunRowGroupSize = 1 << 16;
+
+katana::Result<void>
+WriteSpillTable(
+    const arrow::Table& table, const std::string& path,
+    int64_t row_group_size) {
+  auto out = KATANA_CHECKED_CONTEXT(
+      arrow::io::FileOutputStream::Open(path), "creating {}", path);
+  KATANA_CHECKED_CONTEXT(
+      parquet::arrow::WriteTable(
+          table, arrow::default_memory_pool(), out, row_group_size),
+      "writing {}", path);
+  KATANA_CHECKED(out->Close());
+  return katana::ResultSuccess();
+}
+
+katana::Result<std::unique_ptr<parquet::arrow::FileReader>>
+OpenSpillFile(const std::string& path) {
+  auto in = KATANA_CHECKED_CONTEXT(
+      arrow::io::ReadableFile::Open(path), "opening {}", path);
+  std::unique_ptr<parquet::arrow::FileReader> reader;
+  KATANA_CHECKED_CONTEXT(
+      parquet::arrow::OpenFile(in, arrow::default_memory_pool(), &reader),
+      "reading {}", path);
+  return std::unique_ptr<parquet::arrow::FileReader>(std::move(reader));
+}
+
+size_t
+ChunkBytes(const std::vector<ArrowArrays>& columns) {
+  size_t bytes = 0;
+  for (const auto& column : columns) {
+    for (const auto& chunk : column) {
+      bytes += arrow::util::TotalBufferSize(*chunk);
+    }
+  }
+  return bytes;
+}
+
+// Adds nulls so that every column has at least total rows in complete
+// chunks; total is a multiple of the chunk size unless it is the number of
+// rows of the table
+void
+CompleteChunks(
+    ArrayBuilders* builders, std::vector<ArrowArrays>* chunks,
+    WriterProperties* properties, size_t total) {
+  for (size_t i = 0; i < builders->size(); i++) {
+    auto& builder = builders->at(i);
+    auto& column = chunks->at(i);
+    if (column.size() * properties->chunk_size + builder->length() < total) {
+      AddNulls(builder, &column, properties, total);
+    }
+    if (column.size() * properties->chunk_size < total) {
+      column.emplace_back(BuildArray(builder));
+    }
+  }
+}
+
+// Adds falses so that every column has at least total rows in complete
+// chunks; total is a multiple of the chunk size unless it is the number of
+// rows of the table
+void
+CompleteChunks(
+    BooleanBuilders* builders, std::vector<ArrowArrays>* chunks,
+    WriterProperties* properties, size_t total) {
+  for (size_t i = 0; i < builders->size(); i++) {
+    auto& builder = builders->at(i);
+    auto& column = chunks->at(i);
+    if (column.size() * properties->chunk_size + builder->length() < total) {
+      AddFalses(builder, &column, properties, total);
+    }
+    if (column.size() * properties->chunk_size < total) {
+      column.emplace_back(BuildArray(builder));
+    }
+  }
+}
+
+// Writes out the rows of state before row rows and drops them from memory
+template <typename State>
+katana::Result<void>
+SpillChunks(
+    State* state, WriterProperties* properties, size_t rows,
+    const std::string& path) {
+  if (rows == state->spilled_rows) {
+    return katana::ResultSuccess();
+  }
+  size_t new_rows = rows - state->spilled_rows;
+  CompleteChunks(&state->builders, &state->chunks, properties, new_rows);
+
+  if (state->schema.empty()) {
+    // nothing to write, but later columns need to know about these rows
+    state->spill_files.emplace_back(SpillFile{"", new_rows});
+  } else {
+    auto table = BuildTable(&state->chunks, &state->schema);
+    KATANA_CHECKED(WriteSpillTable(*table, path, properties->chunk_size));
+    state->spill_files.emplace_back(SpillFile{path, new_rows});
+    for (auto& column : state->chunks) {
+      column.clear();
+    }
+  }
+  state->spilled_rows = rows;
+  return katana::ResultSuccess();
+}
+
+// Reads a column back from spill files, in chunks of chunk_size rows like
+// those of the builders. Files written before the column was added get
+// nulls, or falses for labels.
+katana::Result<std::shared_ptr<arrow::ChunkedArray>>
+ReadSpilledColumn(
+    const std::vector<SpillFile>& files,
+    const std::shared_ptr<arrow::Field>& field, bool labels,
+    size_t chunk_size) {
+  ArrowArrays chunks;
+  for (const auto& file : files) {
+    std::shared_ptr<arrow::Array> values;
+    if (!file.path.empty()) {
+      auto reader = KATANA_CHECKED(OpenSpillFile(file.path));
+      std::shared_ptr<arrow::Schema> schema;
+      KATANA_CHECKED(reader->GetSchema(&schema));
+      if (int i = schema->GetFieldIndex(field->name()); i >= 0) {
+        std::shared_ptr<arrow::ChunkedArray> column;
+        KATANA_CHECKED(reader->ReadColumn(i, &column));
+        values = column->num_chunks() == 1
+                     ? column->chunk(0)
+                     : KATANA_CHECKED(arrow::Concatenate(column->chunks()));
+      }
+    }
+    if (!values) {
+      values = labels ? GetFalseArray(file.rows)
+                      : KATANA_CHECKED(
+                            arrow::MakeArrayOfNull(field->type(), file.rows));
+    }
+    for (size_t i = 0; i < file.rows; i += chunk_size) {
+      chunks.emplace_back(
+          values->Slice(i, std::min(chunk_size, file.rows - i)));
+    }
+  }
+  return std::make_shared<arrow::ChunkedArray>(chunks, field->type());
+}
+
+katana::Result<std::shared_ptr<arrow::Table>>
+ReadSpilledTable(
+    const std::vector<SpillFile>& files, const ArrowFields& schema,
+    bool labels, size_t chunk_size, size_t rows) {
+  ChunkedArrays columns;
+  for (const auto& field : schema) {
+    columns.emplace_back(
+        KATANA_CHECKED(ReadSpilledColumn(files, field, labels, chunk_size)));
+  }
+  return arrow::Table::Make(arrow::schema(schema), columns, rows);
+}
+
+// Sorts (source, edge index, destination) triples and writes them as a run
+katana::Result<void>
+WriteEdgeRun(
+    std::vector<std::tuple<uint32_t, uint64_t, uint32_t>>* edges,
+    const std::string& path, std::vector<SpillFile>* runs) {
+  if (edges->empty()) {
+    return katana::ResultSuccess();
+  }
+  katana::ParallelSTL::sort(edges->begin(), edges->end());
+
+  arrow::UInt32Builder sources;
+  arrow::UInt64Builder indexes;
+  arrow::UInt32Builder destinations;
+  KATANA_CHECKED(sources.Reserve(edges->size()));
+  KATANA_CHECKED(indexes.Reserve(edges->size()));
+  KATANA_CHECKED(destinations.Reserve(edges->size()));
+  for (const auto& [src, index, dest] : *edges) {
+    sources.UnsafeAppend(src);
+    indexes.UnsafeAppend(index);
+    destinations.UnsafeAppend(dest);
+  }
+  ArrowArrays columns(3);
+  KATANA_CHECKED(sources.Finish(&columns[0]));
+  KATANA_CHECKED(indexes.Finish(&columns[1]));
+  KATANA_CHECKED(destinations.Finish(&columns[2]));
+  auto table = arrow::Table::Make(
+      arrow::schema(
+          {arrow::field("source", arrow::uint32()),
+           arrow::field("index", arrow::uint64()),
+           arrow::field("destination", arrow::uint32())}),
+      columns);
+
+  KATANA_CHECKED(WriteSpillTable(*table, path, kEdgeRunRowGroupSize));
+  runs->emplace_back(SpillFile{path, edges->size()});
+  edges->clear();
+  return katana::ResultSuccess();
+}
+
+// Reads a run of sorted edges one row group at a time
+class EdgeRun {
+public:
+  explicit EdgeRun(std::unique_ptr<parquet::arrow::FileReader> reader)
+      : reader_(std::move(reader)) {}
+
+  // Moves to the next edge, returns false at the end of the run
+  katana::Result<bool> Next() {
+    if (++pos_ < length_) {
+      return true;
+    }
+    while (++row_group_ < reader_->num_row_groups()) {
+      std::shared_ptr<arrow::Table> table;
+      KATANA_CHECKED(reader_->ReadRowGroup(row_group_, &table));
+      table = KATANA_CHECKED(table->CombineChunks());
+      if (table->num_rows() == 0) {
+        continue;
+      }
+      sources_ = std::static_pointer_cast<arrow::UInt32Array>(
+          table->column(0)->chunk(0));
+      indexes_ = std::static_pointer_cast<arrow::UInt64Array>(
+          table->column(1)->chunk(0));
+      destinations_ = std::static_pointer_cast<arrow::UInt32Array>(
+          table->column(2)->chunk(0));
+      pos_ = 0;
+      length_ = table->num_rows();
+      return true;
+    }
+    return false;
+  }
+
+  uint32_t source() const { return sources_->Value(pos_); }
+  uint64_t index() const { return indexes_->Value(pos_); }
+  uint32_t destination() const { return destinations_->Value(pos_); }
+
+private:
+  std::unique_ptr<parquet::arrow::FileReader> reader_;
+  int row_group_{-1};
+  int64_t pos_{0};
+  int64_t length_{0};
+  std::shared_ptr<arrow::UInt32Array> sources_;
+  std::shared_ptr<arrow::UInt64Array> indexes_;
+  std::shared_ptr<arrow::UInt32Array> destinations_;
+};
+
+// Merges sorted runs of edges into CSR order: fills out_dests and maps each
+// CSR position to the index of its edge
+katana::Result<void>
+MergeEdgeRuns(
+    const std::vector<SpillFile>& runs, std::vector<uint32_t>* out_dests,
+    std::vector<size_t>* edge_mapping) {
+  using Head = std::tuple<uint32_t, uint64_t, size_t>;
+  std::priority_queue<Head, std::vector<Head>, std::greater<Head>> heads;
+  std::vector<EdgeRun> cursors;
+  for (size_t i = 0; i < runs.size(); i++) {
+    cursors.emplace_back(KATANA_CHECKED(OpenSpillFile(runs[i].path)));
+    if (KATANA_CHECKED(cursors[i].Next())) {
+      heads.emplace(cursors[i].source(), cursors[i].index(), i);
+    }
+  }
+
+  size_t pos = 0;
+  while (!heads.empty()) {
+    auto [src, index, i] = heads.top();
+    heads.pop();
+    if (pos == out_dests->size()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::AssertionFailed, "more spilled edges than edges");
+    }
+    (*out_dests)[pos] = cursors[i].destination();
+    (*edge_mapping)[pos] = index;
+    pos++;
+    if (KATANA_CHECKED(cursors[i].Next())) {
+      heads.emplace(cursors[i].source(), cursors[i].index(), i);
+    }
+  }
+  if (pos != out_dests->size()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AssertionFailed, "{} spilled edges for {} edges",
+        pos, out_dests->size());
+  }
+  return katana::ResultSuccess();
+}
+
+/*****************************************/
+/* Functions for merging graph fragments */
+/*****************************************/
+
+// Columns without rows have no chunks, from which a ChunkedArray cannot infer
+// its type; give them an empty chunk
+katana::Result<void>
+AddEmptyChunks(std::vector<ArrowArrays>* chunks, const ArrowFields& schema) {
+  for (size_t i = 0; i < chunks->size(); ++i) {
+    if (chunks->at(i).empty()) {
+      chunks->at(i).emplace_back(
+          KATANA_CHECKED(arrow::MakeArrayOfNull(schema[i]->type(), 0)));
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+// Values of a column that a table does not have: nulls, or falses for labels
+katana::Result<std::shared_ptr<arrow::Array>>
+MissingColumn(
+    const std::shared_ptr<arrow::DataType>& type, bool labels, size_t rows) {
+  if (labels) {
+    return GetFalseArray(rows);
+  }
+  return KATANA_CHECKED(arrow::MakeArrayOfNull(type, rows));
+}
+
+// Concatenates tables with possibly different columns into a table with the
+// union of their columns, in order of appearance. Rows of tables without a
+// column, and extra_rows rows at the end, are nulls, or falses for labels.
+katana::Result<std::shared_ptr<arrow::Table>>
+ConcatenateTables(
+    const std::vector<std::shared_ptr<arrow::Table>>& tables, size_t extra_rows,
+    bool labels, size_t chunk_size) {
+  ArrowFields fields;
+  std::unordered_map<std::string, size_t> field_indexes;
+  size_t rows = extra_rows;
+  for (const auto& table : tables) {
+    for (const auto& field : table->schema()->fields()) {
+      auto [it, inserted] = field_indexes.emplace(field->name(), fields.size());
+      if (inserted) {
+        fields.emplace_back(field);
+      } else if (!fields[it->second]->type()->Equals(field->type())) {
+        return KATANA_ERROR(
+            katana::ErrorCode::InvalidArgument,
+            "property {} is both of type {} and of type {}", field->name(),
+            fields[it->second]->type()->ToString(),
+            field->type()->ToString());
+      }
+    }
+    rows += table->num_rows();
+  }
+
+  ChunkedArrays columns;
+  for (const auto& field : fields) {
+    ArrowArrays parts;
+    for (const auto& table : tables) {
+      if (auto column = table->GetColumnByName(field->name()); column) {
+        parts.insert(
+            parts.end(), column->chunks().begin(), column->chunks().end());
+      } else {
+        parts.emplace_back(KATANA_CHECKED(
+            MissingColumn(field->type(), labels, table->num_rows())));
+      }
+    }
+    parts.emplace_back(KATANA_CHECKED(
+        MissingColumn(field->type(), labels, extra_rows)));
+    auto values = KATANA_CHECKED(arrow::Concatenate(parts));
+    parts.clear();
+
+    ArrowArrays chunks;
+    for (size_t i = 0; i < rows; i += chunk_size) {
+      chunks.emplace_back(values->Slice(i, std::min(chunk_size, rows - i)));
+    }
+    columns.emplace_back(
+        std::make_shared<arrow::ChunkedArray>(chunks, field->type()));
+  }
+  return arrow::Table::Make(arrow::schema(fields), columns, rows);
+}
+
 }  // end of unnamed namespace
 
 katana::PropertyGraphBuilder::PropertyGraphBuilder(size_t chunk_size)
@@ -1162,6 +1529,20 @@ katana::PropertyGraphBuilder::PropertyGraphBuilder(size_t chunk_size)
       building_node_(false),
       building_edge_(false) {}
 
+katana::PropertyGraphBuilder::PropertyGraphBuilder(
+    size_t chunk_size, SpillOptions spill_options)
+    : PropertyGraphBuilder(chunk_size) {
+  spill_ = SpillState{};
+  spill_->options = std::move(spill_options);
+}
+
+katana::PropertyGraphBuilder::~PropertyGraphBuilder() {
+  if (spill_ && !spill_->dir.empty()) {
+    boost::system::error_code err;
+    fs::remove_all(spill_->dir, err);
+  }
+}
+
 /***************************/
 /* Basic utility functions */
 /***************************/
@@ -1268,6 +1649,7 @@ katana::PropertyGraphBuilder::FinishNode() {
   }
   nodes_++;
   building_node_ = false;
+  this->MaybeSpill();
 
   return true;
 }
@@ -1349,6 +1731,7 @@ katana::PropertyGraphBuilder::FinishEdge() {
   }
   edges_++;
   building_edge_ = false;
+  this->MaybeSpill();
 
   return true;
 }
@@ -1595,7 +1978,7 @@ katana::PropertyGraphBuilder::AddValue(
   }
   AddValueInternal(
       property_builder->builders[index], &property_builder->chunks[index],
-      &properties_, total, resolve_value);
+      &properties_, total - property_builder->spilled_rows, resolve_value);
 }
 
 // Add falses until the array is even and then append true so that length =
@@ -1620,7 +2003,7 @@ katana::PropertyGraphBuilder::AddLabel(const std::string& name) {
   }
   AddLabelInternal(
       label_builder->builders[index], &label_builder->chunks[index],
-      &properties_, total);
+      &properties_, total - label_builder->spilled_rows);
 }
 
 /*********************************/
@@ -1702,6 +2085,10 @@ katana::PropertyGraphBuilder::BuildFinalEdges(bool verbose) {
 
 katana::Result<GraphComponents>
 katana::PropertyGraphBuilder::Finish(bool verbose) {
+  if (spill_) {
+    return this->FinishSpilled(verbose);
+  }
+
   topology_builder_.out_dests.resize(
       edges_, std::numeric_limits<uint32_t>::max());
   this->ResolveIntermediateIDs();
@@ -1769,6 +2156,294 @@ katana::PropertyGraphBuilder::Finish(bool verbose) {
       nodes_tables, edges_tables, std::move(pg_topo)};
 }
 
+katana::Result<katana::GraphFragment>
+katana::PropertyGraphBuilder::FinishFragment() {
+  if (spill_) {
+    return KATANA_ERROR(
+        ErrorCode::NotImplemented,
+        "spilling builders cannot build graph fragments");
+  }
+
+  // add buffered rows and even out columns
+  EvenOutChunkBuilders(
+      &node_properties_.builders, &node_properties_.chunks, &properties_,
+      nodes_);
+  EvenOutChunkBuilders(
+      &node_labels_.builders, &node_labels_.chunks, &properties_, nodes_);
+  EvenOutChunkBuilders(
+      &edge_properties_.builders, &edge_properties_.chunks, &properties_,
+      edges_);
+  EvenOutChunkBuilders(
+      &edge_types_.builders, &edge_types_.chunks, &properties_, edges_);
+
+  KATANA_CHECKED(
+      AddEmptyChunks(&node_properties_.chunks, node_properties_.schema));
+  KATANA_CHECKED(AddEmptyChunks(&node_labels_.chunks, node_labels_.schema));
+  KATANA_CHECKED(
+      AddEmptyChunks(&edge_properties_.chunks, edge_properties_.schema));
+  KATANA_CHECKED(AddEmptyChunks(&edge_types_.chunks, edge_types_.schema));
+
+  GraphFragment fragment;
+  fragment.nodes = GraphComponent{
+      BuildTable(&node_properties_.chunks, &node_properties_.schema),
+      BuildTable(&node_labels_.chunks, &node_labels_.schema)};
+  fragment.edges = GraphComponent{
+      BuildTable(&edge_properties_.chunks, &edge_properties_.schema),
+      BuildTable(&edge_types_.chunks, &edge_types_.schema)};
+  fragment.num_nodes = nodes_;
+  fragment.num_edges = edges_;
+  fragment.topology = std::move(topology_builder_);
+  topology_builder_ = TopologyState{};
+
+  return std::move(fragment);
+}
+
+/*****************************************/
+/* Functions for spilling while building */
+/*****************************************/
+
+void
+katana::PropertyGraphBuilder::MaybeSpill() {
+  if (!spill_ || spill_->error || building_node_ || building_edge_) {
+    return;
+  }
+  size_t half_budget = spill_->options.memory_budget / 2;
+
+  // Buffered rows only grow by a chunk at a time
+  size_t complete_chunks =
+      (nodes_ + edges_ - node_properties_.spilled_rows -
+       edge_properties_.spilled_rows) /
+      properties_.chunk_size;
+  if (complete_chunks != spill_->checked_chunks) {
+    spill_->checked_chunks = complete_chunks;
+    size_t bytes =
+        ChunkBytes(node_properties_.chunks) + ChunkBytes(node_labels_.chunks) +
+        ChunkBytes(edge_properties_.chunks) + ChunkBytes(edge_types_.chunks);
+    if (bytes >= half_budget) {
+      if (auto res = this->SpillRows(false); !res) {
+        KATANA_LOG_ERROR("spilling rows: {}", res.error());
+        spill_->error = res.error();
+        return;
+      }
+      spill_->checked_chunks = 0;
+    }
+  }
+
+  if (!topology_builder_.sources.empty() &&
+      topology_builder_.sources.size() * kBytesPerBufferedEdge >=
+          half_budget) {
+    if (auto res = this->SpillEdges(); !res) {
+      KATANA_LOG_ERROR("spilling edges: {}", res.error());
+      spill_->error = res.error();
+    }
+  }
+}
+
+katana::Result<std::string>
+katana::PropertyGraphBuilder::NewSpillPath(const std::string& prefix) {
+  if (spill_->dir.empty()) {
+    boost::system::error_code err;
+    fs::create_directories(spill_->options.dir, err);
+    if (err) {
+      return KATANA_ERROR(
+          std::error_code(err.value(), err.category()),
+          "creating spill directory {}: {}", spill_->options.dir,
+          err.message());
+    }
+    fs::path dir = fs::unique_path(
+        fs::path(spill_->options.dir) / "katana-import-%%%%-%%%%-%%%%");
+    fs::create_directory(dir, err);
+    if (err) {
+      return KATANA_ERROR(
+          std::error_code(err.value(), err.category()),
+          "creating spill directory {}: {}", dir.string(), err.message());
+    }
+    spill_->dir = dir.string();
+  }
+  return fmt::format(
+      "{}/{}-{:06}.parquet", spill_->dir, prefix, spill_->next_file++);
+}
+
+// Spill the complete chunks of all tables, or every row if all is true
+katana::Result<void>
+katana::PropertyGraphBuilder::SpillRows(bool all) {
+  size_t chunk_size = properties_.chunk_size;
+  size_t node_rows = all ? nodes_ : nodes_ - nodes_ % chunk_size;
+  size_t edge_rows = all ? edges_ : edges_ - edges_ % chunk_size;
+
+  KATANA_CHECKED(SpillChunks(
+      &node_properties_, &properties_, node_rows,
+      KATANA_CHECKED(this->NewSpillPath("node-properties"))));
+  KATANA_CHECKED(SpillChunks(
+      &node_labels_, &properties_, node_rows,
+      KATANA_CHECKED(this->NewSpillPath("node-labels"))));
+  KATANA_CHECKED(SpillChunks(
+      &edge_properties_, &properties_, edge_rows,
+      KATANA_CHECKED(this->NewSpillPath("edge-properties"))));
+  KATANA_CHECKED(SpillChunks(
+      &edge_types_, &properties_, edge_rows,
+      KATANA_CHECKED(this->NewSpillPath("edge-types"))));
+  return katana::ResultSuccess();
+}
+
+// Write the buffered edges as a sorted run; edges with an endpoint that is
+// not known yet are kept aside until Finish
+katana::Result<void>
+katana::PropertyGraphBuilder::SpillEdges() {
+  TopologyState* topology = &topology_builder_;
+  KATANA_LOG_DEBUG_ASSERT(
+      topology->sources.size() == topology->destinations.size());
+  constexpr uint32_t kUnresolved = std::numeric_limits<uint32_t>::max();
+
+  std::vector<std::tuple<uint32_t, uint64_t, uint32_t>> run;
+  run.reserve(topology->sources.size());
+  for (size_t i = 0; i < topology->sources.size(); i++) {
+    uint64_t index = spill_->edges_base + i;
+    uint32_t src = topology->sources[i];
+    uint32_t dest = topology->destinations[i];
+    if (src == kUnresolved || dest == kUnresolved) {
+      spill_->pending_edges.emplace_back(index, src, dest);
+    } else {
+      run.emplace_back(src, index, dest);
+    }
+  }
+  spill_->edges_base += topology->sources.size();
+  topology->sources.clear();
+  topology->destinations.clear();
+
+  return WriteEdgeRun(
+      &run, KATANA_CHECKED(this->NewSpillPath("edges")), &spill_->edge_runs);
+}
+
+// Like Finish, but reads rows and edges back from the spill files
+katana::Result<GraphComponents>
+katana::PropertyGraphBuilder::FinishSpilled(bool verbose) {
+  if (spill_->error) {
+    return spill_->error.value();
+  }
+  KATANA_CHECKED(this->SpillEdges());
+
+  // Resolve string node IDs like ResolveIntermediateIDs, for the edges that
+  // were set aside
+  TopologyState* topology = &topology_builder_;
+  auto& pending = spill_->pending_edges;
+  auto find_pending = [&pending](size_t index) {
+    auto it = std::lower_bound(
+        pending.begin(), pending.end(), index,
+        [](const auto& edge, size_t i) { return std::get<0>(edge) < i; });
+    KATANA_LOG_ASSERT(it != pending.end() && std::get<0>(*it) == index);
+    return it;
+  };
+  for (const auto& [index, str_id] : topology->destinations_intermediate) {
+    auto dest_index = topology->node_indexes.find(str_id);
+    uint32_t dest;
+    if (dest_index == topology->node_indexes.end()) {
+      dest = nodes_;
+      this->AddNode(str_id);
+    } else {
+      dest = static_cast<uint32_t>(dest_index->second);
+    }
+    std::get<2>(*find_pending(index)) = dest;
+  }
+  for (const auto& [index, str_id] : topology->sources_intermediate) {
+    auto src_index = topology->node_indexes.find(str_id);
+    uint32_t src;
+    if (src_index == topology->node_indexes.end()) {
+      src = nodes_;
+      this->AddNode(str_id);
+    } else {
+      src = static_cast<uint32_t>(src_index->second);
+    }
+    std::get<1>(*find_pending(index)) = src;
+    topology->out_indices[src]++;
+  }
+  if (spill_->error) {
+    return spill_->error.value();
+  }
+
+  std::vector<std::tuple<uint32_t, uint64_t, uint32_t>> resolved;
+  resolved.reserve(pending.size());
+  for (const auto& [index, src, dest] : pending) {
+    resolved.emplace_back(src, index, dest);
+  }
+  pending.clear();
+  KATANA_CHECKED(WriteEdgeRun(
+      &resolved, KATANA_CHECKED(this->NewSpillPath("edges")),
+      &spill_->edge_runs));
+  KATANA_CHECKED(this->SpillRows(true));
+
+  // Build CSR with an external merge of the sorted runs
+  katana::ParallelSTL::partial_sum(
+      topology->out_indices.begin(), topology->out_indices.end(),
+      topology->out_indices.begin());
+  topology->out_dests.resize(edges_);
+  std::vector<size_t> edge_mapping(edges_);
+  KATANA_CHECKED(
+      MergeEdgeRuns(spill_->edge_runs, &topology->out_dests, &edge_mapping));
+
+  if (verbose) {
+    std::cout << "Finished topology from " << spill_->edge_runs.size()
+              << " sorted runs\n";
+  }
+
+  size_t chunk_size = properties_.chunk_size;
+  GraphComponent nodes_tables{
+      KATANA_CHECKED(ReadSpilledTable(
+          node_properties_.spill_files, node_properties_.schema, false,
+          chunk_size, nodes_)),
+      KATANA_CHECKED(ReadSpilledTable(
+          node_labels_.spill_files, node_labels_.schema, true, chunk_size,
+          nodes_))};
+
+  // Rearrange edges to match implicit edge IDs, a column at a time
+  ChunkedArrays edge_columns;
+  for (const auto& field : edge_properties_.schema) {
+    auto column = KATANA_CHECKED(ReadSpilledColumn(
+        edge_properties_.spill_files, field, false, chunk_size));
+    auto rearranged = RearrangeTable({column}, edge_mapping, &properties_);
+    edge_columns.emplace_back(
+        std::make_shared<arrow::ChunkedArray>(rearranged[0], field->type()));
+  }
+  ChunkedArrays type_columns;
+  for (const auto& field : edge_types_.schema) {
+    auto column = KATANA_CHECKED(
+        ReadSpilledColumn(edge_types_.spill_files, field, true, chunk_size));
+    auto rearranged = RearrangeTypeTable({column}, edge_mapping, &properties_);
+    type_columns.emplace_back(
+        std::make_shared<arrow::ChunkedArray>(rearranged[0], field->type()));
+  }
+  GraphComponent edges_tables{
+      arrow::Table::Make(
+          arrow::schema(edge_properties_.schema), edge_columns, edges_),
+      arrow::Table::Make(
+          arrow::schema(edge_types_.schema), type_columns, edges_)};
+
+  katana::GraphTopology pg_topo(
+      topology->out_indices.data(), topology->out_indices.size(),
+      topology->out_dests.data(), topology->out_dests.size());
+
+  if (verbose) {
+    std::cout << "Nodes: " << pg_topo.NumNodes() << "\n";
+    std::cout << "Node Properties: " << nodes_tables.properties->num_columns()
+              << "\n";
+    std::cout << "Node Labels: " << nodes_tables.labels->num_columns() << "\n";
+    std::cout << "Edges: " << pg_topo.NumEdges() << "\n";
+    std::cout << "Edge Properties: " << edges_tables.properties->num_columns()
+              << "\n";
+    std::cout << "Edge Types: " << edges_tables.labels->num_columns() << "\n";
+  }
+
+  boost::system::error_code err;
+  fs::remove_all(spill_->dir, err);
+  if (err) {
+    KATANA_LOG_WARN("removing {}: {}", spill_->dir, err.message());
+  }
+  spill_->dir.clear();
+
+  return katana::GraphComponents{
+      nodes_tables, edges_tables, std::move(pg_topo)};
+}
+
 // NB: is_list is always initialized
 void
 ImportData::ValueFromArrowScalar(std::shared_ptr<arrow::Scalar> scalar) {
@@ -1831,6 +2506,156 @@ ImportData::ValueFromArrowScalar(std::shared_ptr<arrow::Scalar> scalar) {
   }
 }
 
+katana::Result<katana::GraphComponents>
+katana::MergeGraphFragments(
+    std::vector<GraphFragment>&& fragments, size_t chunk_size) {
+  WriterProperties properties = GetWriterProperties(chunk_size);
+
+  // Nodes and edges are numbered in the order of the fragments
+  std::vector<size_t> node_offsets;
+  std::vector<size_t> edge_offsets;
+  size_t num_nodes = 0;
+  size_t num_edges = 0;
+  for (const auto& fragment : fragments) {
+    node_offsets.emplace_back(num_nodes);
+    edge_offsets.emplace_back(num_edges);
+    num_nodes += fragment.num_nodes;
+    num_edges += fragment.num_edges;
+  }
+  size_t fragment_nodes = num_nodes;
+
+  // The first node with an ID keeps it. Edges to or from a later node with
+  // the same ID, even in that node's own fragment, are remapped to the first
+  // node, so later duplicates are left without edges, as with one builder
+  std::unordered_map<std::string, size_t> node_indexes;
+  std::vector<std::unordered_map<size_t, size_t>> duplicates(fragments.size());
+  for (size_t f = 0; f < fragments.size(); ++f) {
+    auto& fragment_indexes = fragments[f].topology.node_indexes;
+    for (auto& [id, index] : fragment_indexes) {
+      index += node_offsets[f];
+    }
+    node_indexes.merge(fragment_indexes);
+    for (const auto& [id, index] : fragment_indexes) {
+      duplicates[f].emplace(index - node_offsets[f], node_indexes[id]);
+    }
+    fragment_indexes.clear();
+  }
+
+  // Resolve edge endpoints to global node indexes, creating empty nodes for
+  // IDs that no fragment has
+  auto resolve = [&](const std::string& id) {
+    auto [it, inserted] = node_indexes.emplace(id, num_nodes);
+    if (inserted) {
+      num_nodes++;
+    }
+    return static_cast<uint32_t>(it->second);
+  };
+
+  TopologyState topology;
+  topology.sources.resize(num_edges);
+  topology.destinations.resize(num_edges);
+  for (size_t f = 0; f < fragments.size(); ++f) {
+    TopologyState* fragment_topology = &fragments[f].topology;
+    KATANA_LOG_DEBUG_ASSERT(
+        fragment_topology->sources.size() == fragments[f].num_edges &&
+        fragment_topology->destinations.size() == fragments[f].num_edges);
+    auto remap = [&](uint32_t local) {
+      if (auto it = duplicates[f].find(local); it != duplicates[f].end()) {
+        return static_cast<uint32_t>(it->second);
+      }
+      return static_cast<uint32_t>(node_offsets[f] + local);
+    };
+
+    for (size_t i = 0; i < fragments[f].num_edges; ++i) {
+      size_t edge = edge_offsets[f] + i;
+      topology.sources[edge] = remap(fragment_topology->sources[i]);
+      topology.destinations[edge] = remap(fragment_topology->destinations[i]);
+    }
+    for (const auto& [i, id] : fragment_topology->destinations_intermediate) {
+      topology.destinations[edge_offsets[f] + i] = resolve(id);
+    }
+    for (const auto& [i, id] : fragment_topology->sources_intermediate) {
+      topology.sources[edge_offsets[f] + i] = resolve(id);
+    }
+    *fragment_topology = TopologyState{};
+  }
+  node_indexes.clear();
+
+  // Build CSR
+  topology.out_indices.resize(num_nodes, 0);
+  for (uint32_t src : topology.sources) {
+    topology.out_indices[src]++;
+  }
+  katana::ParallelSTL::partial_sum(
+      topology.out_indices.begin(), topology.out_indices.end(),
+      topology.out_indices.begin());
+  topology.out_dests.resize(num_edges, std::numeric_limits<uint32_t>::max());
+
+  std::vector<size_t> edge_mapping;
+  edge_mapping.resize(num_edges, std::numeric_limits<uint64_t>::max());
+
+  std::vector<uint64_t> offsets;
+  offsets.resize(num_nodes, 0);
+
+  // get edge indices
+  for (size_t i = 0; i < topology.sources.size(); i++) {
+    uint64_t edgeID = SetEdgeID(&topology, &offsets, i);
+    edge_mapping[edgeID] = i;
+  }
+
+  // Concatenate tables, a component at a time to bound peak memory
+  std::vector<std::shared_ptr<arrow::Table>> tables;
+  auto concatenate = [&](auto member, size_t extra_rows, bool labels) {
+    tables.clear();
+    for (auto& fragment : fragments) {
+      tables.emplace_back(member(&fragment));
+    }
+    return ConcatenateTables(tables, extra_rows, labels, chunk_size);
+  };
+  GraphComponent nodes_tables{
+      KATANA_CHECKED(concatenate(
+          [](GraphFragment* f) { return std::move(f->nodes.properties); },
+          num_nodes - fragment_nodes, false)),
+      KATANA_CHECKED(concatenate(
+          [](GraphFragment* f) { return std::move(f->nodes.labels); },
+          num_nodes - fragment_nodes, true))};
+  auto initial_edges = KATANA_CHECKED(concatenate(
+      [](GraphFragment* f) { return std::move(f->edges.properties); }, 0,
+      false));
+  auto initial_types = KATANA_CHECKED(concatenate(
+      [](GraphFragment* f) { return std::move(f->edges.labels); }, 0, true));
+  tables.clear();
+  fragments.clear();
+
+  // rearrange edges to match implicit edge IDs
+  auto rearrange = [&](const std::shared_ptr<arrow::Table>& initial,
+                       bool labels) {
+    std::vector<ArrowArrays> rearranged;
+    if (labels) {
+      rearranged =
+          RearrangeTypeTable(initial->columns(), edge_mapping, &properties);
+    } else {
+      rearranged =
+          RearrangeTable(initial->columns(), edge_mapping, &properties);
+    }
+    ChunkedArrays columns;
+    for (int i = 0; i < initial->num_columns(); ++i) {
+      columns.emplace_back(std::make_shared<arrow::ChunkedArray>(
+          rearranged[i], initial->schema()->field(i)->type()));
+    }
+    return arrow::Table::Make(initial->schema(), columns, num_edges);
+  };
+  GraphComponent edges_tables{
+      rearrange(initial_edges, false), rearrange(initial_types, true)};
+
+  katana::GraphTopology pg_topo(
+      topology.out_indices.data(), topology.out_indices.size(),
+      topology.out_dests.data(), topology.out_dests.size());
+
+  return katana::GraphComponents{
+      nodes_tables, edges_tables, std::move(pg_topo)};
+}
+
 katana::Result<std::unique_ptr<katana::PropertyGraph>>
 katana::ConvertToPropertyGraph(
     katana::GraphComponents&& graph_comps, katana::TxnContext* txn_ctx) {
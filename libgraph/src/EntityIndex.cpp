@@ -1,7 +1,87 @@
 #include "katana/EntityIndex.h"
 
+#include <numeric>
+
+#include "katana/Galois.h"
+#include "katana/ParallelSTL.h"
 #include "katana/PropertyGraph.h"
 
+namespace {
+
+/// Returns the entities in [0, num_entities) with a valid value in
+/// \p property, ordered by their value (as returned by \p value) and then by
+/// id. Both the compaction of valid entities and the sort run in parallel.
+template <typename node_or_edge, typename Value>
+katana::NUMAArray<node_or_edge>
+SortValidEntities(
+    const arrow::Array& property, size_t num_entities, const Value& value) {
+  katana::NUMAArray<node_or_edge> ids;
+
+  if (property.null_count() == 0) {
+    ids.allocateInterleaved(num_entities);
+    katana::ParallelSTL::iota(ids.begin(), ids.end(), node_or_edge{0});
+  } else {
+    // Count the valid entities of each thread's block, then have each thread
+    // write its valid entities starting at the prefix sum of the counts.
+    std::vector<size_t> offsets(katana::getActiveThreads() + 1, 0);
+    katana::on_each([&](unsigned tid, unsigned total) {
+      auto [begin, end] =
+          katana::block_range(size_t{0}, num_entities, tid, total);
+      size_t count = 0;
+      for (size_t i = begin; i < end; ++i) {
+        count += property.IsValid(i);
+      }
+      offsets[tid + 1] = count;
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+    ids.allocateInterleaved(offsets.back());
+    katana::on_each([&](unsigned tid, unsigned total) {
+      auto [begin, end] =
+          katana::block_range(size_t{0}, num_entities, tid, total);
+      size_t out = offsets[tid];
+      for (size_t i = begin; i < end; ++i) {
+        if (property.IsValid(i)) {
+          ids[out++] = static_cast<node_or_edge>(i);
+        }
+      }
+    });
+  }
+
+  katana::ParallelSTL::sort(
+      ids.begin(), ids.end(), [&value](node_or_edge a, node_or_edge b) {
+        auto value_a = value(a);
+        auto value_b = value(b);
+        if (value_a < value_b) {
+          return true;
+        }
+        if (value_b < value_a) {
+          return false;
+        }
+        return a < b;
+      });
+
+  return ids;
+}
+
+#if defined(KATANA_USE_FLAT_ENTITY_INDEX)
+/// Samples the value of every \p stride-th entity of \p sorted_ids.
+template <typename Fence, typename node_or_edge, typename Value>
+std::vector<Fence>
+SampleFences(
+    const katana::NUMAArray<node_or_edge>& sorted_ids, const Value& value,
+    size_t stride) {
+  std::vector<Fence> fences((sorted_ids.size() + stride - 1) / stride);
+  katana::do_all(
+      katana::iterate(size_t{0}, fences.size()),
+      [&](size_t i) { fences[i] = value(sorted_ids[i * stride]); },
+      katana::no_stats());
+  return fences;
+}
+#endif
+
+}  // namespace
+
 namespace katana {
 
 // Switch statement over creation of per-type indexes.
@@ -55,14 +135,21 @@ PrimitiveEntityIndex<node_or_edge, c_type>::BuildFromProperty() {
         ErrorCode::InvalidArgument, "Property does not contain all entities");
   }
 
-  // TODO(osh): Index build should be parallelized.
-  for (node_or_edge i = 0; i < num_entities_; ++i) {
-    // The keys inserted are the node ids - the set translates these into
-    // property values.
-    if (property_->IsValid(i)) {
-      set_.insert(IndexID{i});
-    }
+  PropertyValue value{property_.get()};
+  NUMAArray<node_or_edge> sorted_ids =
+      SortValidEntities<node_or_edge>(*property_, num_entities_, value);
+
+#if defined(KATANA_USE_FLAT_ENTITY_INDEX)
+  fences_ = SampleFences<FenceType>(sorted_ids, value, this->kFenceStride);
+  sorted_ids_ = std::move(sorted_ids);
+#else
+  // The keys inserted are the node ids - the set translates these into
+  // property values. Inserting in order at the end of the set does not need
+  // to search the tree.
+  for (node_or_edge id : sorted_ids) {
+    set_.insert(set_.end(), IndexID{id});
   }
+#endif
 
   return katana::ResultSuccess();
 }
@@ -75,14 +162,22 @@ StringEntityIndex<node_or_edge>::BuildFromProperty() {
         ErrorCode::InvalidArgument, "Property does not contain all entities");
   }
 
-  // TODO(osh): Index build should be parallelized.
-  for (node_or_edge i = 0; i < num_entities_; ++i) {
-    // The keys inserted are the node ids - the set translates these into
-    // property values.
-    if (property_->IsValid(i)) {
-      set_.insert(IndexID{i});
-    }
+  PropertyValue value{property_.get()};
+  NUMAArray<node_or_edge> sorted_ids =
+      SortValidEntities<node_or_edge>(*property_, num_entities_, value);
+
+#if defined(KATANA_USE_FLAT_ENTITY_INDEX)
+  fences_ =
+      SampleFences<std::string_view>(sorted_ids, value, this->kFenceStride);
+  sorted_ids_ = std::move(sorted_ids);
+#else
+  // The keys inserted are the node ids - the set translates these into
+  // property values. Inserting in order at the end of the set does not need
+  // to search the tree.
+  for (node_or_edge id : sorted_ids) {
+    set_.insert(set_.end(), IndexID{id});
   }
+#endif
 
   return katana::ResultSuccess();
 }
@@ -1,23 +1,33 @@
 #include "katana/GraphML.h"
 
 #include <algorithm>
+#include <array>
+#include <cctype>
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <initializer_list>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <optional>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include "katana/Env.h"
 #include "katana/ErrorCode.h"
 #include "katana/Galois.h"
 #include "katana/GraphMLSchema.h"
 #include "katana/Logging.h"
+#include "katana/MappedFile.h"
 #include "katana/PropertyGraph.h"
 #include "katana/SharedMemSys.h"
 #include "katana/Threads.h"
+#include "katana/URI.h"
 
 using katana::ImportData;
 using katana::ImportDataType;
@@ -592,30 +602,13 @@ ProcessGraph(
   }
 }
 
-}  // end of unnamed namespace
-
-katana::Result<katana::GraphComponents>
-katana::ConvertGraphML(
-    const std::string& infilename, size_t chunk_size, bool verbose) {
-  xmlTextReaderPtr reader;
-
-  reader = xmlNewTextReaderFilename(infilename.c_str());
-  if (reader == NULL) {
-    return KATANA_ERROR(ErrorCode::NotFound, "Unable to open {}", infilename);
-  }
-  auto res = ConvertGraphML(reader, chunk_size, verbose);
-  xmlFreeTextReader(reader);
-  return res;
-}
-
-katana::Result<katana::GraphComponents>
-katana::ConvertGraphML(
-    xmlTextReaderPtr reader, size_t chunk_size, bool verbose) {
+katana::Result<void>
+ParseGraphML(
+    xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder,
+    bool verbose) {
   int ret = 0;
   bool finishedGraph = false;
 
-  katana::PropertyGraphBuilder builder{chunk_size};
-
   // procedure:
   // read in "key" xml nodes and add them to nodeKeys and edgeKeys
   // once we reach the first "graph" xml node we parse it using the above keys
@@ -633,16 +626,16 @@ katana::ConvertGraphML(
         if (!key.id.empty() && key.id != std::string("label") &&
             key.id != std::string("IGNORE")) {
           if (key.for_node) {
-            builder.AddBuilder(std::move(key));
+            builder->AddBuilder(std::move(key));
           } else if (key.for_edge) {
-            builder.AddBuilder(std::move(key));
+            builder->AddBuilder(std::move(key));
           }
         }
       } else if (xmlStrEqual(name, BAD_CAST "graph")) {
         if (verbose) {
           std::cout << "Finished processing property headers\n";
         }
-        ProcessGraph(reader, &builder, false);
+        ProcessGraph(reader, builder, false);
         finishedGraph = true;
       }
     }
@@ -650,11 +643,344 @@ katana::ConvertGraphML(
   }
   if (ret < 0) {
     return KATANA_ERROR(
-        ErrorCode::InvalidArgument,
+        katana::ErrorCode::InvalidArgument,
         "failed to parse: incorrect xml format\n"
         "Please verify there are no illegal characters in the GraphML file\n"
         "To remove invalid characters use: \"sed -i $'s/[^[:print:]\t]//g' "
         "<file>\", warning this will alter the original file");
   }
-  return builder.Finish(verbose);
+  return katana::ResultSuccess();
+}
+
+katana::Result<katana::GraphComponents>
+ReadGraphML(
+    xmlTextReaderPtr reader, katana::PropertyGraphBuilder* builder,
+    bool verbose) {
+  KATANA_CHECKED(ParseGraphML(reader, builder, verbose));
+  return builder->Finish(verbose);
+}
+
+katana::Result<katana::GraphComponents>
+ReadGraphMLFile(
+    const std::string& infilename, katana::PropertyGraphBuilder* builder,
+    bool verbose) {
+  xmlTextReaderPtr reader;
+
+  reader = xmlNewTextReaderFilename(infilename.c_str());
+  if (reader == NULL) {
+    return KATANA_ERROR(
+        katana::ErrorCode::NotFound, "Unable to open {}", infilename);
+  }
+  auto res = ReadGraphML(reader, builder, verbose);
+  xmlFreeTextReader(reader);
+  return res;
+}
+
+/************************************************/
+/* Functions for parsing GraphML files in parts */
+/************************************************/
+
+// Parts are at least this large so that the cost of merging stays small
+// relative to parsing, unless KATANA_GRAPHML_MIN_PART_SIZE says otherwise, and
+// a file is split into at most kPartsPerThread parts per thread to balance
+// the load
+constexpr size_t kMinPartSize = size_t{64} << 20;
+constexpr size_t kPartsPerThread = 4;
+constexpr std::string_view kPartFooter = "</graph></graphml>\n";
+
+// Whether a start tag of one of the elements in names begins at pos
+bool
+IsStartTag(
+    std::string_view text, std::initializer_list<std::string_view> names,
+    size_t pos) {
+  for (std::string_view name : names) {
+    size_t end = pos + 1 + name.size();
+    if (end < text.size() && text[pos] == '<' &&
+        text.compare(pos + 1, name.size(), name) == 0 &&
+        (std::isspace(static_cast<unsigned char>(text[end])) ||
+         text[end] == '/' || text[end] == '>')) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns the offset of the first start tag of one of the elements in names
+// at or after pos, or npos
+size_t
+FindStartTag(
+    std::string_view text, std::initializer_list<std::string_view> names,
+    size_t pos) {
+  while ((pos = text.find('<', pos)) != std::string_view::npos) {
+    if (IsStartTag(text, names, pos)) {
+      return pos;
+    }
+    pos++;
+  }
+  return std::string_view::npos;
+}
+
+// Returns the offset of the first graph start tag that is not in a comment,
+// processing instruction or CDATA section, or npos
+size_t
+FindGraphStartTag(std::string_view document) {
+  constexpr std::array<std::pair<std::string_view, std::string_view>, 3>
+      kSkipped{{{"<!--", "-->"}, {"<![CDATA[", "]]>"}, {"<?", "?>"}}};
+  size_t pos = 0;
+  while ((pos = document.find('<', pos)) != std::string_view::npos) {
+    bool skipped = false;
+    for (const auto& [open, close] : kSkipped) {
+      if (document.compare(pos, open.size(), open) == 0) {
+        pos = document.find(close, pos + open.size());
+        if (pos == std::string_view::npos) {
+          return pos;
+        }
+        pos += close.size();
+        skipped = true;
+        break;
+      }
+    }
+    if (skipped) {
+      continue;
+    }
+    if (IsStartTag(document, {"graph"}, pos)) {
+      return pos;
+    }
+    pos++;
+  }
+  return std::string_view::npos;
+}
+
+// Returns the offset of the '>' that ends the tag at pos, or npos. Attribute
+// values may contain '>'.
+size_t
+FindTagEnd(std::string_view text, size_t pos) {
+  char quote = 0;
+  for (; pos < text.size(); ++pos) {
+    char c = text[pos];
+    if (quote != 0) {
+      if (c == quote) {
+        quote = 0;
+      }
+    } else if (c == '"' || c == '\'') {
+      quote = c;
+    } else if (c == '>') {
+      return pos;
+    }
+  }
+  return std::string_view::npos;
+}
+
+// Whether the body of a graph, the text between its start and end tags, can
+// be split at the node and edge start tags found in it textually. Those have
+// to be the children of the graph: not text in a comment, processing
+// instruction or CDATA section, nor elements of a nested graph. A body with
+// another graph start or end tag may also span several graphs.
+bool
+CanSplitGraphBody(std::string_view body) {
+  return body.find("<!") == std::string_view::npos &&
+         body.find("<?") == std::string_view::npos &&
+         FindStartTag(body, {"graph"}, 0) == std::string_view::npos &&
+         body.find("</graph") == std::string_view::npos;
+}
+
+// A part of a GraphML file parsed as a document of its own: the text before
+// the graph, with the keys, some of the nodes and edges of the graph and the
+// end of the document
+struct GraphMLPart {
+  const std::string* filename;
+  std::string_view header;
+  std::string_view body;
+  std::string_view footer;
+};
+
+// Splits the graph of a GraphML document into at most max_parts parts of
+// about min_part_size bytes or more that start at node or edge elements.
+// Split points are found textually, so a document whose graph body has
+// comments, CDATA sections, processing instructions or nested graphs, or that
+// has several graphs or a document type declaration, which may define
+// entities, is left in one part.
+void
+SplitGraphML(
+    const std::string& filename, std::string_view document,
+    size_t min_part_size, size_t max_parts, std::vector<GraphMLPart>* parts) {
+  size_t graph = FindGraphStartTag(document);
+  size_t header_end = graph == std::string_view::npos
+                          ? std::string_view::npos
+                          : FindTagEnd(document, graph);
+  size_t body_end = document.rfind("</graph>");
+  if (header_end == std::string_view::npos ||
+      document[header_end - 1] == '/' || body_end == std::string_view::npos ||
+      body_end < header_end ||
+      document.substr(0, graph).find("<!DOCTYPE") != std::string_view::npos ||
+      !CanSplitGraphBody(
+          document.substr(header_end + 1, body_end - header_end - 1))) {
+    // Nothing to split, or nothing that can be split safely, so let the
+    // parser deal with the document as is
+    parts->emplace_back(GraphMLPart{&filename, document, {}, {}});
+    return;
+  }
+  header_end++;
+
+  std::string_view header = document.substr(0, header_end);
+  size_t body_size = body_end - header_end;
+  size_t num_parts =
+      std::clamp<size_t>(body_size / min_part_size, 1, max_parts);
+
+  size_t begin = header_end;
+  for (size_t i = 1; i <= num_parts; ++i) {
+    size_t end = body_end;
+    if (i < num_parts) {
+      size_t split = header_end + body_size * i / num_parts;
+      end = std::min(FindStartTag(document, {"node", "edge"}, split), body_end);
+    }
+    if (end <= begin) {
+      continue;
+    }
+    parts->emplace_back(GraphMLPart{
+        &filename, header, document.substr(begin, end - begin), kPartFooter});
+    begin = end;
+  }
+  if (begin == header_end) {
+    parts->emplace_back(GraphMLPart{&filename, header, {}, kPartFooter});
+  }
+}
+
+// Feeds the pieces of a part to libxml without copying them into one buffer
+struct PartInput {
+  std::array<std::string_view, 3> pieces;
+  size_t piece{0};
+  size_t pos{0};
+};
+
+int
+ReadPartInput(void* context, char* buffer, int len) {
+  auto* input = static_cast<PartInput*>(context);
+  size_t read = 0;
+  while (read < static_cast<size_t>(len) &&
+         input->piece < input->pieces.size()) {
+    std::string_view piece = input->pieces[input->piece];
+    size_t n =
+        std::min(static_cast<size_t>(len) - read, piece.size() - input->pos);
+    std::memcpy(buffer + read, piece.data() + input->pos, n);
+    read += n;
+    input->pos += n;
+    if (input->pos == piece.size()) {
+      input->piece++;
+      input->pos = 0;
+    }
+  }
+  return static_cast<int>(read);
+}
+
+katana::Result<void>
+ParseGraphMLPart(
+    const GraphMLPart& part, katana::PropertyGraphBuilder* builder) {
+  PartInput input{{part.header, part.body, part.footer}};
+  xmlTextReaderPtr reader = xmlReaderForIO(
+      ReadPartInput, nullptr, &input, part.filename->c_str(), nullptr, 0);
+  if (reader == NULL) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "Unable to read {}",
+        *part.filename);
+  }
+  auto res = ParseGraphML(reader, builder, false);
+  xmlFreeTextReader(reader);
+  return res;
+}
+
+}  // end of unnamed namespace
+
+katana::Result<katana::GraphComponents>
+katana::ConvertGraphML(
+    const std::string& infilename, size_t chunk_size, bool verbose) {
+  katana::PropertyGraphBuilder builder{chunk_size};
+  return ReadGraphMLFile(infilename, &builder, verbose);
+}
+
+katana::Result<katana::GraphComponents>
+katana::ConvertGraphML(
+    const std::string& infilename, const SpillOptions& spill_options,
+    size_t chunk_size, bool verbose) {
+  katana::PropertyGraphBuilder builder{chunk_size, spill_options};
+  return ReadGraphMLFile(infilename, &builder, verbose);
+}
+
+katana::Result<katana::GraphComponents>
+katana::ConvertGraphML(
+    xmlTextReaderPtr reader, size_t chunk_size, bool verbose) {
+  katana::PropertyGraphBuilder builder{chunk_size};
+  return ReadGraphML(reader, &builder, verbose);
+}
+
+katana::Result<katana::GraphComponents>
+katana::ConvertGraphMLParallel(
+    const std::vector<std::string>& infilenames, size_t chunk_size,
+    bool verbose) {
+  // libxml has to be initialized before it is used by several threads
+  xmlInitParser();
+
+  std::vector<std::shared_ptr<katana::MappedFile>> files;
+  std::vector<GraphMLPart> parts;
+  size_t min_part_size = kMinPartSize;
+  if (int size = 0;
+      katana::GetEnv("KATANA_GRAPHML_MIN_PART_SIZE", &size) && size > 0) {
+    min_part_size = size;
+  }
+  size_t max_parts = kPartsPerThread * katana::getActiveThreads();
+  for (size_t i = 0; i < infilenames.size(); ++i) {
+    auto uri = KATANA_CHECKED(katana::URI::MakeFromFile(infilenames[i]));
+    files.emplace_back(KATANA_CHECKED(katana::MappedFile::Make(uri)));
+    std::string_view contents(
+        files.back()->ptr<const char>(), files.back()->size());
+    SplitGraphML(infilenames[i], contents, min_part_size, max_parts, &parts);
+  }
+  if (verbose) {
+    std::cout << "Parsing " << parts.size() << " parts of "
+              << infilenames.size() << " files\n";
+  }
+
+  // Only parse in the loop; finishing fragments uses parallel loops itself
+  std::vector<std::unique_ptr<katana::PropertyGraphBuilder>> builders(
+      parts.size());
+  std::vector<std::optional<katana::CopyableErrorInfo>> errors(parts.size());
+  katana::do_all(
+      katana::iterate(size_t{0}, parts.size()),
+      [&](size_t i) {
+        builders[i] =
+            std::make_unique<katana::PropertyGraphBuilder>(chunk_size);
+        if (auto res = ParseGraphMLPart(parts[i], builders[i].get()); !res) {
+          errors[i] = res.error();
+        }
+      },
+      katana::steal(), katana::chunk_size<1>(),
+      katana::loopname("ParseGraphMLParts"));
+  for (const auto& error : errors) {
+    if (error) {
+      return error.value();
+    }
+  }
+  if (verbose) {
+    std::cout << "Finished parsing\n";
+  }
+
+  std::vector<katana::GraphFragment> fragments;
+  for (auto& builder : builders) {
+    fragments.emplace_back(KATANA_CHECKED(builder->FinishFragment()));
+    builder.reset();
+  }
+  auto graph = KATANA_CHECKED(
+      katana::MergeGraphFragments(std::move(fragments), chunk_size));
+
+  if (verbose) {
+    std::cout << "Nodes: " << graph.topology.NumNodes() << "\n";
+    std::cout << "Node Properties: " << graph.nodes.properties->num_columns()
+              << "\n";
+    std::cout << "Node Labels: " << graph.nodes.labels->num_columns() << "\n";
+    std::cout << "Edges: " << graph.topology.NumEdges() << "\n";
+    std::cout << "Edge Properties: " << graph.edges.properties->num_columns()
+              << "\n";
+    std::cout << "Edge Types: " << graph.edges.labels->num_columns() << "\n";
+  }
+  return std::move(graph);
 }
@@ -0,0 +1,863 @@
+#include "katana/GraphReordering.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <arrow/api.h>
+#include <arrow/compute/api_vector.h>
+
+#include "katana/AtomicHelpers.h"
+#include "katana/Bag.h"
+#include "katana/ErrorCode.h"
+#include "katana/Galois.h"
+#include "katana/ParallelSTL.h"
+#include "katana/PerThreadStorage.h"
+#include "katana/Reduction.h"
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+using NodeOrder = katana::NUMAArray<Node>;
+
+constexpr Node kNoNode = std::numeric_limits<Node>::max();
+
+/// Contiguous ranges of nodes that are counted and scattered as a unit, so
+/// that grouping nodes keeps their order
+constexpr size_t kBlocksPerThread = 8;
+
+/// Number of degree groups of kDegreeGrouping
+constexpr size_t kNumDegreeGroups = 8;
+
+/// Bound on the breadth-first searches for a pseudo-peripheral node
+constexpr size_t kMaxPeripheralSearches = 8;
+
+NodeOrder
+IdentityOrder(size_t num_nodes) {
+  NodeOrder order;
+  order.allocateBlocked(num_nodes);
+  katana::ParallelSTL::iota(order.begin(), order.end(), Node{0});
+  return order;
+}
+
+/// The out- and in-neighbors of every node, sorted, without self loops. Nodes
+/// connected in both directions, or by several edges, appear several times.
+class UndirectedAdjacency {
+public:
+  explicit UndirectedAdjacency(const katana::GraphTopology& topology) {
+    size_t num_nodes = topology.NumNodes();
+    index_.allocateBlocked(num_nodes + 1);
+    katana::do_all(
+        katana::iterate(size_t{0}, num_nodes + 1),
+        [&](size_t n) { index_[n] = 0; }, katana::no_stats());
+
+    katana::do_all(
+        katana::iterate(topology.Nodes()),
+        [&](Node src) {
+          for (auto e : topology.OutEdges(src)) {
+            Node dst = topology.OutEdgeDst(e);
+            if (dst != src) {
+              __sync_fetch_and_add(&index_[src + 1], 1);
+              __sync_fetch_and_add(&index_[dst + 1], 1);
+            }
+          }
+        },
+        katana::steal(), katana::no_stats());
+    katana::ParallelSTL::partial_sum(
+        index_.begin(), index_.end(), index_.begin());
+
+    katana::NUMAArray<uint64_t> cursors;
+    cursors.allocateBlocked(num_nodes);
+    katana::do_all(
+        katana::iterate(size_t{0}, num_nodes),
+        [&](size_t n) { cursors[n] = index_[n]; }, katana::no_stats());
+
+    neighbors_.allocateBlocked(index_[num_nodes]);
+    katana::do_all(
+        katana::iterate(topology.Nodes()),
+        [&](Node src) {
+          for (auto e : topology.OutEdges(src)) {
+            Node dst = topology.OutEdgeDst(e);
+            if (dst != src) {
+              neighbors_[__sync_fetch_and_add(&cursors[src], 1)] = dst;
+              neighbors_[__sync_fetch_and_add(&cursors[dst], 1)] = src;
+            }
+          }
+        },
+        katana::steal(), katana::no_stats());
+
+    // Sorting makes the orders independent of the interleaving above
+    katana::do_all(
+        katana::iterate(size_t{0}, num_nodes),
+        [&](size_t n) {
+          std::sort(
+              neighbors_.data() + index_[n], neighbors_.data() + index_[n + 1]);
+        },
+        katana::steal(), katana::no_stats());
+  }
+
+  size_t num_nodes() const { return index_.size() - 1; }
+  uint64_t num_entries() const { return neighbors_.size(); }
+  uint64_t degree(Node n) const { return index_[n + 1] - index_[n]; }
+  const Node* begin(Node n) const { return neighbors_.data() + index_[n]; }
+  const Node* end(Node n) const { return neighbors_.data() + index_[n + 1]; }
+
+private:
+  katana::NUMAArray<uint64_t> index_;
+  katana::NUMAArray<Node> neighbors_;
+};
+
+/// In-edges of every node in CSR form
+struct InEdges {
+  katana::NUMAArray<uint64_t> index;
+  katana::NUMAArray<Node> sources;
+
+  explicit InEdges(const katana::GraphTopology& topology) {
+    size_t num_nodes = topology.NumNodes();
+    index.allocateBlocked(num_nodes + 1);
+    katana::do_all(
+        katana::iterate(size_t{0}, num_nodes + 1),
+        [&](size_t n) { index[n] = 0; }, katana::no_stats());
+    katana::do_all(
+        katana::iterate(topology.OutEdges()),
+        [&](auto e) {
+          __sync_fetch_and_add(&index[topology.OutEdgeDst(e) + 1], 1);
+        },
+        katana::no_stats());
+    katana::ParallelSTL::partial_sum(index.begin(), index.end(), index.begin());
+
+    katana::NUMAArray<uint64_t> cursors;
+    cursors.allocateBlocked(num_nodes);
+    katana::do_all(
+        katana::iterate(size_t{0}, num_nodes),
+        [&](size_t n) { cursors[n] = index[n]; }, katana::no_stats());
+
+    sources.allocateBlocked(topology.NumEdges());
+    katana::do_all(
+        katana::iterate(topology.Nodes()),
+        [&](Node src) {
+          for (auto e : topology.OutEdges(src)) {
+            Node dst = topology.OutEdgeDst(e);
+            sources[__sync_fetch_and_add(&cursors[dst], 1)] = src;
+          }
+        },
+        katana::steal(), katana::no_stats());
+  }
+
+  uint64_t degree(Node n) const { return index[n + 1] - index[n]; }
+};
+
+/// Orders nodes by group, keeping their order within a group
+template <typename GroupOf>
+NodeOrder
+StableGroupBy(size_t num_nodes, size_t num_groups, const GroupOf& group_of) {
+  size_t num_blocks = std::min<size_t>(
+      num_nodes, kBlocksPerThread * katana::getActiveThreads());
+  num_blocks = std::max<size_t>(num_blocks, 1);
+  size_t block_size = (num_nodes + num_blocks - 1) / num_blocks;
+
+  std::vector<uint64_t> offsets(num_blocks * num_groups);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_blocks),
+      [&](size_t b) {
+        size_t end = std::min(num_nodes, (b + 1) * block_size);
+        for (size_t n = b * block_size; n < end; ++n) {
+          offsets[b * num_groups + group_of(n)] += 1;
+        }
+      },
+      katana::steal(), katana::chunk_size<1>(), katana::no_stats());
+
+  uint64_t offset = 0;
+  for (size_t g = 0; g < num_groups; ++g) {
+    for (size_t b = 0; b < num_blocks; ++b) {
+      uint64_t count = offsets[b * num_groups + g];
+      offsets[b * num_groups + g] = offset;
+      offset += count;
+    }
+  }
+
+  NodeOrder order;
+  order.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_blocks),
+      [&](size_t b) {
+        size_t end = std::min(num_nodes, (b + 1) * block_size);
+        for (size_t n = b * block_size; n < end; ++n) {
+          order[offsets[b * num_groups + group_of(n)]++] = n;
+        }
+      },
+      katana::steal(), katana::chunk_size<1>(), katana::no_stats());
+  return order;
+}
+
+NodeOrder
+DegreeOrder(const katana::GraphTopology& topology) {
+  NodeOrder order = IdentityOrder(topology.NumNodes());
+  katana::ParallelSTL::sort(order.begin(), order.end(), [&](Node a, Node b) {
+    auto degree_a = topology.OutDegree(a);
+    auto degree_b = topology.OutDegree(b);
+    return degree_a > degree_b || (degree_a == degree_b && a < b);
+  });
+  return order;
+}
+
+NodeOrder
+DegreeGroupingOrder(const katana::GraphTopology& topology) {
+  size_t num_nodes = topology.NumNodes();
+  if (topology.NumEdges() == 0) {
+    return IdentityOrder(num_nodes);
+  }
+  katana::NUMAArray<uint64_t> in_degrees;
+  in_degrees.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t n) { in_degrees[n] = 0; }, katana::no_stats());
+  katana::do_all(
+      katana::iterate(topology.OutEdges()),
+      [&](auto e) {
+        __sync_fetch_and_add(&in_degrees[topology.OutEdgeDst(e)], 1);
+      },
+      katana::no_stats());
+  double average_degree = 2.0 * topology.NumEdges() / num_nodes;
+
+  // Group 0 holds degrees of at least 2^(kNumDegreeGroups - 2) times half
+  // the average, the last group degrees below half the average
+  auto group_of = [&](size_t n) -> size_t {
+    double degree = topology.OutDegree(n) + in_degrees[n];
+    double ratio = degree / (average_degree / 2);
+    if (ratio < 1) {
+      return kNumDegreeGroups - 1;
+    }
+    auto level = static_cast<size_t>(std::log2(ratio));
+    return kNumDegreeGroups - 2 - std::min(level, kNumDegreeGroups - 2);
+  };
+  return StableGroupBy(num_nodes, kNumDegreeGroups, group_of);
+}
+
+/// Parallel level-synchronous breadth-first search over the undirected
+/// adjacency that marks the nodes it visits with a stamp, so that searches
+/// do not need to clear their marks
+class StampedSearch {
+public:
+  explicit StampedSearch(size_t num_nodes) {
+    stamps_.allocateBlocked(num_nodes);
+    katana::do_all(
+        katana::iterate(size_t{0}, num_nodes),
+        [&](size_t n) { stamps_[n] = 0; }, katana::no_stats());
+  }
+
+  /// Returns the number of levels after the first one and the nodes of the
+  /// last level
+  std::pair<size_t, std::vector<Node>> LastLevel(
+      const UndirectedAdjacency& adjacency, Node source) {
+    uint64_t stamp = ++last_stamp_;
+    stamps_[source] = stamp;
+    katana::InsertBag<Node> bags[2];
+    katana::InsertBag<Node>* current = &bags[0];
+    katana::InsertBag<Node>* next = &bags[1];
+    current->push(source);
+
+    size_t eccentricity = 0;
+    while (true) {
+      katana::do_all(
+          katana::iterate(*current),
+          [&](Node n) {
+            for (const Node* m = adjacency.begin(n); m != adjacency.end(n);
+                 ++m) {
+              uint64_t old = stamps_[*m].load(std::memory_order_relaxed);
+              if (old != stamp &&
+                  stamps_[*m].compare_exchange_strong(
+                      old, stamp, std::memory_order_relaxed)) {
+                next->push(*m);
+              }
+            }
+          },
+          katana::steal(), katana::no_stats());
+      if (next->empty()) {
+        break;
+      }
+      ++eccentricity;
+      current->clear();
+      std::swap(current, next);
+    }
+    return {eccentricity, std::vector<Node>(current->begin(), current->end())};
+  }
+
+private:
+  katana::NUMAArray<std::atomic<uint64_t>> stamps_;
+  uint64_t last_stamp_{0};
+};
+
+/// Finds a node of high eccentricity in the component of start (George and
+/// Liu): moves to a node of minimum degree in the last level of a
+/// breadth-first search for as long as the eccentricity grows
+Node
+PseudoPeripheralNode(
+    const UndirectedAdjacency& adjacency, Node start, StampedSearch* search) {
+  Node node = start;
+  size_t eccentricity = 0;
+  for (size_t i = 0; i < kMaxPeripheralSearches; ++i) {
+    auto [node_eccentricity, last_level] = search->LastLevel(adjacency, node);
+    if (i > 0 && node_eccentricity <= eccentricity) {
+      break;
+    }
+    eccentricity = node_eccentricity;
+    Node candidate = *std::min_element(
+        last_level.begin(), last_level.end(), [&](Node a, Node b) {
+          return std::make_pair(adjacency.degree(a), a) <
+                 std::make_pair(adjacency.degree(b), b);
+        });
+    if (candidate == node) {
+      break;
+    }
+    node = candidate;
+  }
+  return node;
+}
+
+/// Reverse Cuthill-McKee, with the levels of the Cuthill-McKee search
+/// expanded in parallel as in Karantasis et al., SC 2014: every unplaced
+/// neighbor is claimed by the earliest placed node next to it, and the nodes
+/// of a level place the neighbors they claimed, sorted by degree, in the
+/// order of the level. This gives the same order as the sequential search.
+NodeOrder
+RCMOrder(const katana::GraphTopology& topology) {
+  size_t num_nodes = topology.NumNodes();
+  UndirectedAdjacency adjacency(topology);
+  auto by_degree = [&](Node a, Node b) {
+    return std::make_pair(adjacency.degree(a), a) <
+           std::make_pair(adjacency.degree(b), b);
+  };
+
+  // Roots are searched for from the unplaced node of least degree
+  NodeOrder candidates = IdentityOrder(num_nodes);
+  katana::ParallelSTL::sort(candidates.begin(), candidates.end(), by_degree);
+
+  // Position of the node that claimed a node, or kNoNode
+  katana::NUMAArray<std::atomic<Node>> claims;
+  claims.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t n) { claims[n] = kNoNode; }, katana::no_stats());
+
+  NodeOrder order;
+  order.allocateBlocked(num_nodes);
+  StampedSearch search(num_nodes);
+  katana::PerThreadStorage<std::vector<Node>> children;
+
+  // Collects the distinct neighbors that the node at position p claimed
+  auto claimed_by = [&](uint64_t p, std::vector<Node>* claimed) {
+    claimed->clear();
+    Node n = order[p];
+    for (const Node* m = adjacency.begin(n); m != adjacency.end(n); ++m) {
+      if (claims[*m].load(std::memory_order_relaxed) == p &&
+          (claimed->empty() || claimed->back() != *m)) {
+        claimed->emplace_back(*m);
+      }
+    }
+  };
+
+  uint64_t num_placed = 0;
+  size_t next_candidate = 0;
+  while (num_placed < num_nodes) {
+    while (claims[candidates[next_candidate]] != kNoNode) {
+      ++next_candidate;
+    }
+    Node root = candidates[next_candidate];
+    if (adjacency.degree(root) > 0) {
+      root = PseudoPeripheralNode(adjacency, root, &search);
+    }
+    order[num_placed] = root;
+    claims[root] = num_placed;
+
+    uint64_t level_begin = num_placed;
+    uint64_t level_end = num_placed + 1;
+    while (level_begin < level_end) {
+      katana::do_all(
+          katana::iterate(level_begin, level_end),
+          [&](uint64_t p) {
+            Node n = order[p];
+            for (const Node* m = adjacency.begin(n); m != adjacency.end(n);
+                 ++m) {
+              katana::atomicMin(claims[*m], static_cast<Node>(p));
+            }
+          },
+          katana::steal(), katana::no_stats());
+
+      std::vector<uint64_t> offsets(level_end - level_begin + 1);
+      katana::do_all(
+          katana::iterate(level_begin, level_end),
+          [&](uint64_t p) {
+            std::vector<Node>* claimed = children.getLocal();
+            claimed_by(p, claimed);
+            offsets[p - level_begin + 1] = claimed->size();
+          },
+          katana::steal(), katana::no_stats());
+      offsets[0] = level_end;
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+      katana::do_all(
+          katana::iterate(level_begin, level_end),
+          [&](uint64_t p) {
+            std::vector<Node>* claimed = children.getLocal();
+            claimed_by(p, claimed);
+            std::sort(claimed->begin(), claimed->end(), by_degree);
+            std::copy(
+                claimed->begin(), claimed->end(),
+                order.data() + offsets[p - level_begin]);
+          },
+          katana::steal(), katana::no_stats());
+
+      level_begin = level_end;
+      level_end = offsets.back();
+    }
+    num_placed = level_end;
+  }
+
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+/// Max-priority queue of nodes with small integer keys that are only
+/// incremented and decremented by one, in constant time: a doubly linked list
+/// of nodes per key (the unit heap of Gorder)
+class UnitHeap {
+public:
+  explicit UnitHeap(size_t num_nodes)
+      : keys_(num_nodes, 0),
+        prev_(num_nodes),
+        next_(num_nodes),
+        heads_(1, kNoNode) {
+    // Link in reverse so that ties on key 0 are taken in increasing order
+    for (size_t n = num_nodes; n > 0; --n) {
+      Link(n - 1);
+    }
+  }
+
+  void Increment(Node n) {
+    if (keys_[n] == kRemoved) {
+      return;
+    }
+    Unlink(n);
+    if (++keys_[n] == heads_.size()) {
+      heads_.emplace_back(kNoNode);
+    }
+    top_ = std::max(top_, keys_[n]);
+    Link(n);
+  }
+
+  void Decrement(Node n) {
+    if (keys_[n] == kRemoved) {
+      return;
+    }
+    KATANA_LOG_DEBUG_ASSERT(keys_[n] > 0);
+    Unlink(n);
+    --keys_[n];
+    Link(n);
+  }
+
+  void Remove(Node n) {
+    Unlink(n);
+    keys_[n] = kRemoved;
+  }
+
+  /// Removes and returns a node of maximum key
+  Node PopMax() {
+    while (top_ > 0 && heads_[top_] == kNoNode) {
+      --top_;
+    }
+    Node n = heads_[top_];
+    KATANA_LOG_DEBUG_ASSERT(n != kNoNode);
+    Remove(n);
+    return n;
+  }
+
+private:
+  static constexpr uint32_t kRemoved = std::numeric_limits<uint32_t>::max();
+
+  void Link(Node n) {
+    Node head = heads_[keys_[n]];
+    prev_[n] = kNoNode;
+    next_[n] = head;
+    if (head != kNoNode) {
+      prev_[head] = n;
+    }
+    heads_[keys_[n]] = n;
+  }
+
+  void Unlink(Node n) {
+    if (prev_[n] != kNoNode) {
+      next_[prev_[n]] = next_[n];
+    } else {
+      heads_[keys_[n]] = next_[n];
+    }
+    if (next_[n] != kNoNode) {
+      prev_[next_[n]] = prev_[n];
+    }
+  }
+
+  std::vector<uint32_t> keys_;
+  std::vector<Node> prev_;
+  std::vector<Node> next_;
+  std::vector<Node> heads_;
+  uint32_t top_{0};
+};
+
+/// Gorder: the score of a candidate is the number of edges between it and
+/// the nodes in the window plus the number of in-neighbors it shares with
+/// them. In-neighbors with more than sqrt(num_nodes) out-edges are not
+/// counted as shared, as in the reference implementation.
+NodeOrder
+GorderOrder(const katana::GraphTopology& topology) {
+  size_t num_nodes = topology.NumNodes();
+  InEdges in_edges(topology);
+  auto hub_degree = static_cast<uint64_t>(std::sqrt(num_nodes));
+
+  UnitHeap heap(num_nodes);
+  auto update = [&](Node n, bool enter) {
+    auto change = [&](Node m) {
+      if (enter) {
+        heap.Increment(m);
+      } else {
+        heap.Decrement(m);
+      }
+    };
+    for (auto e : topology.OutEdges(n)) {
+      change(topology.OutEdgeDst(e));
+    }
+    for (uint64_t i = in_edges.index[n]; i < in_edges.index[n + 1]; ++i) {
+      Node parent = in_edges.sources[i];
+      change(parent);
+      if (topology.OutDegree(parent) > hub_degree) {
+        continue;
+      }
+      for (auto e : topology.OutEdges(parent)) {
+        Node sibling = topology.OutEdgeDst(e);
+        if (sibling != n) {
+          change(sibling);
+        }
+      }
+    }
+  };
+
+  NodeOrder order;
+  order.allocateBlocked(num_nodes);
+
+  Node start = 0;
+  for (Node n = 1; n < num_nodes; ++n) {
+    if (in_edges.degree(n) > in_edges.degree(start)) {
+      start = n;
+    }
+  }
+  heap.Remove(start);
+  order[0] = start;
+  update(start, true);
+
+  for (size_t i = 1; i < num_nodes; ++i) {
+    if (i > katana::kGorderWindow) {
+      update(order[i - katana::kGorderWindow - 1], false);
+    }
+    Node n = heap.PopMax();
+    order[i] = n;
+    update(n, true);
+  }
+  return order;
+}
+
+/// Rabbit order. Nodes are visited in increasing degree; a node's edges,
+/// together with those of the nodes merged into it so far, are aggregated by
+/// the community they lead to, and the node is merged into the community of
+/// largest positive modularity gain. Nodes that merge nowhere are the roots
+/// of the dendrograms.
+NodeOrder
+RabbitOrder(const katana::GraphTopology& topology) {
+  size_t num_nodes = topology.NumNodes();
+  UndirectedAdjacency adjacency(topology);
+  double total_weight = adjacency.num_entries();
+  if (total_weight == 0) {
+    return IdentityOrder(num_nodes);
+  }
+
+  NodeOrder visit_order = IdentityOrder(num_nodes);
+  katana::ParallelSTL::sort(
+      visit_order.begin(), visit_order.end(), [&](Node a, Node b) {
+        return std::make_pair(adjacency.degree(a), a) <
+               std::make_pair(adjacency.degree(b), b);
+      });
+
+  std::vector<Node> community(num_nodes);
+  std::vector<double> strength(num_nodes);
+  for (Node n = 0; n < num_nodes; ++n) {
+    community[n] = n;
+    strength[n] = adjacency.degree(n);
+  }
+  auto find = [&](Node n) {
+    while (community[n] != n) {
+      community[n] = community[community[n]];
+      n = community[n];
+    }
+    return n;
+  };
+
+  // Edges that nodes merged into a node brought along, aggregated
+  std::vector<std::vector<std::pair<Node, double>>> inherited(num_nodes);
+  std::vector<bool> visited(num_nodes);
+  std::vector<Node> first_child(num_nodes, kNoNode);
+  std::vector<Node> next_sibling(num_nodes, kNoNode);
+
+  std::vector<double> weight_to(num_nodes);
+  std::vector<Node> touched;
+  for (Node n : visit_order) {
+    visited[n] = true;
+    auto add = [&](Node m, double weight) {
+      Node c = find(m);
+      if (c == n) {
+        return;
+      }
+      if (weight_to[c] == 0) {
+        touched.emplace_back(c);
+      }
+      weight_to[c] += weight;
+    };
+    for (const Node* m = adjacency.begin(n); m != adjacency.end(n); ++m) {
+      add(*m, 1);
+    }
+    for (const auto& [m, weight] : inherited[n]) {
+      add(m, weight);
+    }
+    inherited[n] = {};
+
+    Node best = kNoNode;
+    double best_gain = 0;
+    for (Node c : touched) {
+      double gain = 2 * (weight_to[c] / total_weight -
+                         strength[n] * strength[c] /
+                             (total_weight * total_weight));
+      if (gain > best_gain || (gain == best_gain && best != kNoNode &&
+                               c < best)) {
+        best = c;
+        best_gain = gain;
+      }
+    }
+
+    if (best != kNoNode) {
+      community[n] = best;
+      strength[best] += strength[n];
+      next_sibling[n] = first_child[best];
+      first_child[best] = n;
+      // Only communities that are still to be visited aggregate their edges
+      if (!visited[best]) {
+        for (Node c : touched) {
+          if (c != best) {
+            inherited[best].emplace_back(c, weight_to[c]);
+          }
+        }
+      }
+    }
+    for (Node c : touched) {
+      weight_to[c] = 0;
+    }
+    touched.clear();
+  }
+
+  NodeOrder order;
+  order.allocateBlocked(num_nodes);
+  size_t num_placed = 0;
+  std::vector<Node> stack;
+  for (Node root = 0; root < num_nodes; ++root) {
+    if (community[root] != root) {
+      continue;
+    }
+    stack.emplace_back(root);
+    while (!stack.empty()) {
+      Node n = stack.back();
+      stack.pop_back();
+      order[num_placed++] = n;
+      for (Node c = first_child[n]; c != kNoNode; c = next_sibling[c]) {
+        stack.emplace_back(c);
+      }
+    }
+  }
+  KATANA_LOG_DEBUG_ASSERT(num_placed == num_nodes);
+  return order;
+}
+
+/// Returns indices as an arrow array for arrow::compute::Take
+template <typename F>
+katana::Result<std::shared_ptr<arrow::UInt64Array>>
+MakeTakeIndices(uint64_t length, const F& index_of) {
+  std::shared_ptr<arrow::Buffer> buffer = KATANA_CHECKED(
+      arrow::AllocateBuffer(length * sizeof(uint64_t)));
+  auto* indices = reinterpret_cast<uint64_t*>(buffer->mutable_data());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, length),
+      [&](uint64_t i) { indices[i] = index_of(i); }, katana::no_stats());
+  return std::make_shared<arrow::UInt64Array>(length, buffer);
+}
+
+katana::Result<std::shared_ptr<arrow::Table>>
+TakeProperties(
+    const std::shared_ptr<arrow::Schema>& schema,
+    std::vector<std::shared_ptr<arrow::ChunkedArray>>&& columns,
+    const std::shared_ptr<arrow::UInt64Array>& indices) {
+  auto table = arrow::Table::Make(schema, std::move(columns));
+  arrow::Datum taken =
+      KATANA_CHECKED(arrow::compute::Take(arrow::Datum(table), indices));
+  return taken.table();
+}
+
+}  // namespace
+
+katana::Result<katana::NUMAArray<katana::GraphTopology::Node>>
+katana::ComputeNodeOrder(const GraphTopology& topology, ReorderingKind kind) {
+  if (topology.NumNodes() == 0) {
+    return NodeOrder();
+  }
+
+  switch (kind) {
+  case ReorderingKind::kDegree:
+    return DegreeOrder(topology);
+  case ReorderingKind::kDegreeGrouping:
+    return DegreeGroupingOrder(topology);
+  case ReorderingKind::kRCM:
+    return RCMOrder(topology);
+  case ReorderingKind::kGorder:
+    return GorderOrder(topology);
+  case ReorderingKind::kRabbit:
+    return RabbitOrder(topology);
+  default:
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "unknown reordering kind {}",
+        static_cast<int>(kind));
+  }
+}
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::PermuteNodes(
+    const PropertyGraph* pg, const NUMAArray<GraphTopology::Node>& new_to_old,
+    TxnContext* txn_ctx) {
+  const GraphTopology& topology = pg->topology();
+  size_t num_nodes = topology.NumNodes();
+  if (new_to_old.size() != num_nodes) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "order has {} nodes but the graph has {}",
+        new_to_old.size(), num_nodes);
+  }
+
+  NodeOrder old_to_new;
+  old_to_new.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t n) { old_to_new[n] = kNoNode; }, katana::no_stats());
+  katana::GReduceLogicalOr invalid;
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t i) {
+        Node old = new_to_old[i];
+        if (old >= num_nodes ||
+            !__sync_bool_compare_and_swap(
+                &old_to_new[old], kNoNode, static_cast<Node>(i))) {
+          invalid.update(true);
+        }
+      },
+      katana::no_stats());
+  if (invalid.reduce()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "order is not a permutation of the nodes");
+  }
+
+  GraphTopology::AdjIndexVec adj_indices;
+  adj_indices.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t i) { adj_indices[i] = topology.OutDegree(new_to_old[i]); },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      adj_indices.begin(), adj_indices.end(), adj_indices.begin());
+
+  // Old out-edge of every new edge
+  NUMAArray<GraphTopology::Edge> old_edges;
+  old_edges.allocateBlocked(topology.NumEdges());
+  GraphTopology::EdgeDestVec dests;
+  dests.allocateBlocked(topology.NumEdges());
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t i) {
+        GraphTopology::Edge new_edge = i == 0 ? 0 : adj_indices[i - 1];
+        for (auto e : topology.OutEdges(new_to_old[i])) {
+          old_edges[new_edge] = e;
+          dests[new_edge] = old_to_new[topology.OutEdgeDst(e)];
+          ++new_edge;
+        }
+      },
+      katana::steal(), katana::no_stats());
+
+  PropertyGraph::EntityTypeIDArray node_types;
+  node_types.allocateBlocked(num_nodes);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_nodes),
+      [&](size_t i) { node_types[i] = pg->GetTypeOfNode(new_to_old[i]); },
+      katana::no_stats());
+  PropertyGraph::EntityTypeIDArray edge_types;
+  edge_types.allocateBlocked(topology.NumEdges());
+  katana::do_all(
+      katana::iterate(uint64_t{0}, topology.NumEdges()),
+      [&](uint64_t e) {
+        edge_types[e] = pg->GetTypeOfEdgeFromTopoIndex(old_edges[e]);
+      },
+      katana::no_stats());
+
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> node_columns;
+  for (int32_t i = 0; i < pg->GetNumNodeProperties(); ++i) {
+    node_columns.emplace_back(pg->GetNodeProperty(i));
+  }
+  std::vector<std::shared_ptr<arrow::ChunkedArray>> edge_columns;
+  for (int32_t i = 0; i < pg->GetNumEdgeProperties(); ++i) {
+    edge_columns.emplace_back(pg->GetEdgeProperty(i));
+  }
+  std::shared_ptr<arrow::Table> node_properties;
+  if (!node_columns.empty()) {
+    auto indices = KATANA_CHECKED(MakeTakeIndices(num_nodes, [&](uint64_t i) {
+      return topology.GetNodePropertyIndex(new_to_old[i]);
+    }));
+    node_properties = KATANA_CHECKED(TakeProperties(
+        pg->loaded_node_schema(), std::move(node_columns), indices));
+  }
+  std::shared_ptr<arrow::Table> edge_properties;
+  if (!edge_columns.empty()) {
+    auto indices = KATANA_CHECKED(
+        MakeTakeIndices(topology.NumEdges(), [&](uint64_t e) {
+          return topology.GetEdgePropertyIndexFromOutEdge(old_edges[e]);
+        }));
+    edge_properties = KATANA_CHECKED(TakeProperties(
+        pg->loaded_edge_schema(), std::move(edge_columns), indices));
+  }
+
+  auto permuted = KATANA_CHECKED(PropertyGraph::Make(
+      GraphTopology(std::move(adj_indices), std::move(dests)),
+      std::move(node_types), std::move(edge_types),
+      EntityTypeManager(pg->GetNodeTypeManager()),
+      EntityTypeManager(pg->GetEdgeTypeManager())));
+  if (node_properties) {
+    KATANA_CHECKED_CONTEXT(
+        permuted->AddNodeProperties(node_properties, txn_ctx),
+        "adding permuted node properties");
+  }
+  if (edge_properties) {
+    KATANA_CHECKED_CONTEXT(
+        permuted->AddEdgeProperties(edge_properties, txn_ctx),
+        "adding permuted edge properties");
+  }
+  return permuted;
+}
+
+katana::Result<std::unique_ptr<katana::PropertyGraph>>
+katana::ReorderNodes(
+    const PropertyGraph* pg, ReorderingKind kind, TxnContext* txn_ctx) {
+  NUMAArray<GraphTopology::Node> new_to_old =
+      KATANA_CHECKED(ComputeNodeOrder(pg->topology(), kind));
+  return PermuteNodes(pg, new_to_old, txn_ctx);
+}
@@ -4,6 +4,8 @@
 
 #include <iostream>
 
+#include "katana/DeltaVarint.h"
+#include "katana/GraphReordering.h"
 #include "katana/Logging.h"
 #include "katana/PropertyGraph.h"
 #include "katana/RDGTopology.h"
@@ -75,6 +77,19 @@ katana::GraphTopology::GraphTopology(
       edge_prop_indices_(std::move(edge_prop_indices)),
       node_prop_indices_(std::move(node_prop_indices)) {}
 
+katana::GraphTopology
+katana::GraphTopology::MakeMapped(const RDGTopology& rdg_topo) noexcept {
+  KATANA_LOG_DEBUG_ASSERT(rdg_topo.mapped_file());
+  // The mapping is private and writable, so writes through these arrays never
+  // reach the file
+  GraphTopology topo(
+      AdjIndexVec(
+          const_cast<Edge*>(rdg_topo.adj_indices()), rdg_topo.num_nodes()),
+      EdgeDestVec(const_cast<Node*>(rdg_topo.dests()), rdg_topo.num_edges()));
+  topo.mapped_file_ = rdg_topo.mapped_file();
+  return topo;
+}
+
 katana::GraphTopology
 katana::GraphTopology::Copy(const GraphTopology& that) noexcept {
   return katana::GraphTopology(
@@ -223,7 +238,7 @@ katana::EdgeShuffleTopology::MakeOriginalCopy(const katana::PropertyGraph* pg) {
       std::move(edge_prop_indices), std::move(copy_topo.GetNodePropIndices())});
 }
 
-std::shared_ptr<katana::EdgeShuffleTopology>
+katana::Result<std::shared_ptr<katana::EdgeShuffleTopology>>
 katana::EdgeShuffleTopology::Make(katana::RDGTopology* rdg_topo) {
   KATANA_LOG_DEBUG_ASSERT(rdg_topo);
 
@@ -253,8 +268,7 @@ katana::EdgeShuffleTopology::Make(katana::RDGTopology* rdg_topo) {
 
   // Since we copy the data we need out of the RDGTopology into our own arrays,
   // unbind the RDGTopologys file store to save memory.
-  auto res = rdg_topo->unbind_file_storage();
-  KATANA_LOG_ASSERT(res);
+  KATANA_CHECKED(rdg_topo->unbind_file_storage());
 
   std::shared_ptr<EdgeShuffleTopology> shuffle =
       std::make_shared<EdgeShuffleTopology>(EdgeShuffleTopology{
@@ -451,8 +465,14 @@ katana::ShuffleTopology::MakeSortedByDegree(
     return d1 > d2;
   };
 
-  return MakeNodeSortedTopo(
+  auto ret = MakeNodeSortedTopo(
       seed_topo, cmp, katana::RDGTopology::NodeSortKind::kSortedByDegree);
+  KATANA_LOG_DEBUG_ASSERT(std::is_sorted(
+      ret->Nodes().begin(), ret->Nodes().end(),
+      [&](auto n1, auto n2) {
+        return ret->OutDegree(n1) > ret->OutDegree(n2);
+      }));
+  return ret;
 }
 
 std::shared_ptr<katana::ShuffleTopology>
@@ -474,7 +494,35 @@ katana::ShuffleTopology::MakeSortedByNodeType(
       seed_topo, cmp, katana::RDGTopology::NodeSortKind::kSortedByNodeType);
 }
 
-std::shared_ptr<katana::ShuffleTopology>
+katana::Result<std::shared_ptr<katana::ShuffleTopology>>
+katana::ShuffleTopology::MakeReordered(
+    const katana::EdgeShuffleTopology& seed_topo,
+    const katana::RDGTopology::NodeSortKind& node_sort_todo) {
+  katana::ReorderingKind kind{};
+  switch (node_sort_todo) {
+  case katana::RDGTopology::NodeSortKind::kReorderedByDegreeGrouping:
+    kind = katana::ReorderingKind::kDegreeGrouping;
+    break;
+  case katana::RDGTopology::NodeSortKind::kReorderedByRCM:
+    kind = katana::ReorderingKind::kRCM;
+    break;
+  case katana::RDGTopology::NodeSortKind::kReorderedByGorder:
+    kind = katana::ReorderingKind::kGorder;
+    break;
+  case katana::RDGTopology::NodeSortKind::kReorderedByRabbit:
+    kind = katana::ReorderingKind::kRabbit;
+    break;
+  default:
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "not a reordering: {}",
+        static_cast<int>(node_sort_todo));
+  }
+
+  auto new_to_old = KATANA_CHECKED(katana::ComputeNodeOrder(seed_topo, kind));
+  return MakeNodePermutedTopo(seed_topo, new_to_old, node_sort_todo);
+}
+
+katana::Result<std::shared_ptr<katana::ShuffleTopology>>
 katana::ShuffleTopology::Make(katana::RDGTopology* rdg_topo) {
   KATANA_LOG_DEBUG_ASSERT(rdg_topo);
   EdgeDestVec dests_copy;
@@ -506,8 +554,7 @@ katana::ShuffleTopology::Make(katana::RDGTopology* rdg_topo) {
 
   // Since we copy the data we need out of the RDGTopology into our own arrays,
   // unbind the RDGTopologys file store to save memory.
-  auto res = rdg_topo->unbind_file_storage();
-  KATANA_LOG_ASSERT(res);
+  KATANA_CHECKED(rdg_topo->unbind_file_storage());
 
   std::shared_ptr<ShuffleTopology> shuffle =
       std::make_shared<ShuffleTopology>(ShuffleTopology{
@@ -654,7 +701,7 @@ katana::EdgeTypeAwareTopology::ToRDGTopology() const {
   return katana::RDGTopology(std::move(topo));
 }
 
-std::shared_ptr<katana::EdgeTypeAwareTopology>
+katana::Result<std::shared_ptr<katana::EdgeTypeAwareTopology>>
 katana::EdgeTypeAwareTopology::Make(
     katana::RDGTopology* rdg_topo,
     std::shared_ptr<const CondensedTypeIDMap> edge_type_index,
@@ -687,14 +734,174 @@ katana::EdgeTypeAwareTopology::Make(
 
   // Since we copy the data we need out of the RDGTopology into our own arrays,
   // unbind the RDGTopologys file store to save memory.
-  auto res = rdg_topo->unbind_file_storage();
-  KATANA_LOG_ASSERT(res);
+  KATANA_CHECKED(rdg_topo->unbind_file_storage());
 
   return std::make_shared<EdgeTypeAwareTopology>(EdgeTypeAwareTopology{
       std::move(e_topo), std::move(edge_type_index),
       std::move(per_type_adj_indices)});
 }
 
+namespace {
+
+/// Returns true if the out edges of every node of \p topo are sorted by
+/// destination, whether or not \p topo records it
+bool
+AdjacencyListsSortedByDest(const katana::GraphTopology& topo) noexcept {
+  if (topo.edge_sort_state() ==
+      katana::RDGTopology::EdgeSortKind::kSortedByDestID) {
+    return true;
+  }
+  katana::GReduceLogicalAnd all_sorted;
+  katana::do_all(
+      katana::iterate(topo.Nodes()),
+      [&](katana::GraphTopology::Node n) {
+        auto edges = topo.OutEdges(n);
+        const katana::GraphTopology::Node* dests = topo.DestData();
+        all_sorted.update(
+            std::is_sorted(dests + *edges.begin(), dests + *edges.end()));
+      },
+      katana::no_stats());
+  return all_sorted.reduce();
+}
+
+/// Padding at the end of the encoded stream, which keeps every block, even an
+/// empty last one, inside the allocation
+constexpr size_t kEncodedPadding = sizeof(uint64_t);
+
+/// Encodes \p values into blocks of CompressedTopology::kBlockSize values.
+/// (*offsets)[b] is the byte offset of block b in \p encoded and the last
+/// offset is the total encoded size.
+template <typename T>
+void
+EncodeBlocks(
+    const T* values, uint64_t num_values, katana::NUMAArray<uint8_t>* encoded,
+    katana::NUMAArray<uint64_t>* offsets) noexcept {
+  constexpr size_t kBlockSize = katana::CompressedTopology::kBlockSize;
+  const size_t num_blocks = (num_values + kBlockSize - 1) / kBlockSize;
+
+  // Size every block, then turn the sizes into skip pointers with a prefix
+  // sum
+  offsets->allocateInterleaved(num_blocks + 1);
+  (*offsets)[0] = 0;
+  katana::do_all(
+      katana::iterate(size_t{0}, num_blocks),
+      [&](size_t block) {
+        const uint64_t first = block * kBlockSize;
+        const uint64_t last =
+            std::min<uint64_t>(first + kBlockSize, num_values);
+        (*offsets)[block + 1] =
+            katana::DeltaVarintBlockSize(values + first, values + last);
+      },
+      katana::no_stats());
+  katana::ParallelSTL::partial_sum(
+      offsets->begin(), offsets->end(), offsets->begin());
+
+  encoded->allocateInterleaved((*offsets)[num_blocks] + kEncodedPadding);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_blocks),
+      [&](size_t block) {
+        const uint64_t first = block * kBlockSize;
+        const uint64_t last =
+            std::min<uint64_t>(first + kBlockSize, num_values);
+        uint8_t* out = katana::EncodeDeltaVarintBlock(
+            values + first, values + last,
+            encoded->data() + (*offsets)[block]);
+        KATANA_LOG_DEBUG_ASSERT(
+            out == encoded->data() + (*offsets)[block + 1]);
+      },
+      katana::no_stats());
+  std::fill_n(
+      encoded->data() + (*offsets)[num_blocks], kEncodedPadding, uint8_t{0});
+}
+
+}  // namespace
+
+katana::CompressedTopology::~CompressedTopology() = default;
+
+std::shared_ptr<katana::CompressedTopology>
+katana::CompressedTopology::MakeFrom(
+    const katana::GraphTopology& seed_topo) noexcept {
+  CompressedTopology ret;
+  ret.num_edges_ = seed_topo.NumEdges();
+  ret.edge_sort_state_ =
+      AdjacencyListsSortedByDest(seed_topo)
+          ? katana::RDGTopology::EdgeSortKind::kSortedByDestID
+          : seed_topo.edge_sort_state();
+
+  ret.adj_indices_.allocateInterleaved(seed_topo.NumNodes());
+  if (seed_topo.NumNodes() > 0) {
+    katana::ParallelSTL::copy(
+        seed_topo.AdjData(), seed_topo.AdjData() + seed_topo.NumNodes(),
+        ret.adj_indices_.begin());
+  }
+
+  const PropertyIndex* edge_from = seed_topo.edge_property_index_data();
+  if (edge_from) {
+    katana::GReduceLogicalAnd is_identity;
+    katana::do_all(
+        katana::iterate(uint64_t{0}, seed_topo.NumEdges()),
+        [&](uint64_t e) { is_identity.update(edge_from[e] == e); },
+        katana::no_stats());
+    if (!is_identity.reduce()) {
+      EncodeBlocks(
+          edge_from, seed_topo.NumEdges(), &ret.encoded_edge_prop_indices_,
+          &ret.edge_prop_index_offsets_);
+    }
+  }
+
+  const PropertyIndex* node_from = seed_topo.node_property_index_data();
+  if (node_from) {
+    ret.node_prop_indices_.allocateInterleaved(seed_topo.NumNodes());
+    katana::ParallelSTL::copy(
+        node_from, node_from + seed_topo.NumNodes(),
+        ret.node_prop_indices_.begin());
+  }
+
+  EncodeBlocks(
+      seed_topo.DestData(), ret.num_edges_, &ret.encoded_dests_,
+      &ret.block_offsets_);
+
+  return std::make_shared<CompressedTopology>(std::move(ret));
+}
+
+void
+katana::CompressedTopology::DecodeBlock(
+    uint64_t block, Node* out) const noexcept {
+  KATANA_LOG_DEBUG_ASSERT(block + 1 < block_offsets_.size());
+  [[maybe_unused]] const uint8_t* end = katana::DecodeDeltaVarintBlock(
+      encoded_dests_.data() + block_offsets_[block],
+      std::min<uint64_t>(kBlockSize, num_edges_ - block * kBlockSize), out);
+  KATANA_LOG_DEBUG_ASSERT(
+      end == encoded_dests_.data() + block_offsets_[block + 1]);
+}
+
+void
+katana::CompressedTopology::DecodeEdgePropIndexBlock(
+    uint64_t block, PropertyIndex* out) const noexcept {
+  KATANA_LOG_DEBUG_ASSERT(block + 1 < edge_prop_index_offsets_.size());
+  [[maybe_unused]] const uint8_t* end = katana::DecodeDeltaVarintBlock(
+      encoded_edge_prop_indices_.data() + edge_prop_index_offsets_[block],
+      std::min<uint64_t>(kBlockSize, num_edges_ - block * kBlockSize), out);
+  KATANA_LOG_DEBUG_ASSERT(
+      end ==
+      encoded_edge_prop_indices_.data() + edge_prop_index_offsets_[block + 1]);
+}
+
+void
+katana::CompressedTopology::Print() const noexcept {
+  std::cout << "adj_indices_: [ ";
+  for (const auto& i : adj_indices_) {
+    std::cout << i << ", ";
+  }
+  std::cout << "]" << std::endl;
+
+  std::cout << "dests: [ ";
+  for (auto e : OutEdges()) {
+    std::cout << OutEdgeDst(e) << ", ";
+  }
+  std::cout << "]" << std::endl;
+}
+
 const katana::GraphTopology&
 katana::PGViewCache::GetDefaultTopologyRef() const noexcept {
   return *original_topo_;
@@ -727,6 +934,7 @@ katana::PGViewCache::DropAllTopologies() noexcept {
   fully_shuff_topos_.clear();
   edge_type_aware_topos_.clear();
   edge_type_id_map_.reset();
+  compressed_topo_.reset();
 }
 
 std::shared_ptr<katana::CondensedTypeIDMap>
@@ -803,8 +1011,20 @@ katana::PGViewCache::BuildOrGetEdgeShuffTopoImpl(
       sort_kind, katana::RDGTopology::NodeSortKind::kAny);
 
   auto res = pg->LoadTopology(std::move(shadow));
-  auto new_topo = (!res) ? EdgeShuffleTopology::Make(pg, tpose_kind, sort_kind)
-                         : EdgeShuffleTopology::Make(res.value());
+  std::shared_ptr<EdgeShuffleTopology> new_topo;
+  if (res) {
+    auto load_res = EdgeShuffleTopology::Make(res.value());
+    if (load_res) {
+      new_topo = std::move(load_res.value());
+    } else {
+      KATANA_LOG_WARN(
+          "loading edge shuffle topology, generating it instead: {}",
+          load_res.error());
+    }
+  }
+  if (!new_topo) {
+    new_topo = EdgeShuffleTopology::Make(pg, tpose_kind, sort_kind);
+  }
   KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, new_topo.get()));
 
   if (pop) {
@@ -815,12 +1035,12 @@ katana::PGViewCache::BuildOrGetEdgeShuffTopoImpl(
   }
 }
 
-std::shared_ptr<katana::ShuffleTopology>
+katana::Result<std::shared_ptr<katana::ShuffleTopology>>
 katana::PGViewCache::BuildOrGetShuffTopo(
     katana::PropertyGraph* pg,
     const katana::RDGTopology::TransposeKind& tpose_kind,
     const katana::RDGTopology::NodeSortKind& node_sort_todo,
-    const katana::RDGTopology::EdgeSortKind& edge_sort_todo) noexcept {
+    const katana::RDGTopology::EdgeSortKind& edge_sort_todo) {
   // try to find a matching topology in the cache
   auto pred = [&](const auto& topo_ptr) {
     return topo_ptr->is_valid() && topo_ptr->has_transpose_state(tpose_kind) &&
@@ -842,7 +1062,20 @@ katana::PGViewCache::BuildOrGetShuffTopo(
         edge_sort_todo, node_sort_todo);
     auto res = pg->LoadTopology(std::move(shadow));
 
-    if (!res) {
+    std::shared_ptr<ShuffleTopology> new_topo;
+    if (res) {
+      // found matching topology in storage
+      auto load_res = katana::ShuffleTopology::Make(res.value());
+      if (load_res) {
+        new_topo = std::move(load_res.value());
+      } else {
+        KATANA_LOG_WARN(
+            "loading shuffle topology, generating it instead: {}",
+            load_res.error());
+      }
+    }
+
+    if (!new_topo) {
       // no matching topology in cache or storage, generate it
 
       // EdgeShuffleTopology e_topo below is going to serve as a seed for
@@ -853,14 +1086,12 @@ katana::PGViewCache::BuildOrGetShuffTopo(
           pg, tpose_kind, katana::RDGTopology::EdgeSortKind::kAny);
       KATANA_LOG_DEBUG_ASSERT(e_topo->has_transpose_state(tpose_kind));
 
-      fully_shuff_topos_.emplace_back(ShuffleTopology::MakeFromTopo(
-          pg, *e_topo, node_sort_todo, edge_sort_todo));
-
-    } else {
-      // found matching topology in storage
-      katana::RDGTopology* topo = res.value();
-      fully_shuff_topos_.emplace_back(katana::ShuffleTopology::Make(topo));
+      new_topo = KATANA_CHECKED_CONTEXT(
+          ShuffleTopology::MakeFromTopo(
+              pg, *e_topo, node_sort_todo, edge_sort_todo),
+          "building shuffle topology");
     }
+    fully_shuff_topos_.emplace_back(std::move(new_topo));
 
     KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, fully_shuff_topos_.back().get()));
     return fully_shuff_topos_.back();
@@ -901,17 +1132,27 @@ katana::PGViewCache::BuildOrGetEdgeTypeAwareTopo(
     // If it doesn't match, then the EdgeTypeAwareTopology on storage is out of date and cannot be used
     auto edge_type_index = BuildOrGetEdgeTypeIndex(pg);
 
+    std::shared_ptr<EdgeTypeAwareTopology> new_topo;
     if (res) {
-      // found matching topology in storage
-      katana::RDGTopology* rdg_topo = res.value();
+      // found matching topology in storage; Make only consumes its
+      // arguments once loading has succeeded
+      auto load_res = katana::EdgeTypeAwareTopology::Make(
+          res.value(), edge_type_index, std::move(*sorted_topo));
+      if (load_res) {
+        new_topo = std::move(load_res.value());
+      } else {
+        KATANA_LOG_WARN(
+            "loading edge type aware topology, generating it instead: {}",
+            load_res.error());
+      }
+    }
 
-      edge_type_aware_topos_.emplace_back(katana::EdgeTypeAwareTopology::Make(
-          rdg_topo, std::move(edge_type_index), std::move(*sorted_topo)));
-    } else {
+    if (!new_topo) {
       // no matching topology in cache or storage, generate it
-      edge_type_aware_topos_.emplace_back(EdgeTypeAwareTopology::MakeFrom(
-          pg, std::move(edge_type_index), std::move(*sorted_topo)));
+      new_topo = EdgeTypeAwareTopology::MakeFrom(
+          pg, std::move(edge_type_index), std::move(*sorted_topo));
     }
+    edge_type_aware_topos_.emplace_back(std::move(new_topo));
 
     KATANA_LOG_DEBUG_ASSERT(
         CheckTopology(pg, edge_type_aware_topos_.back().get()));
@@ -920,6 +1161,45 @@ katana::PGViewCache::BuildOrGetEdgeTypeAwareTopo(
   }
 }
 
+std::shared_ptr<katana::CompressedTopology>
+katana::PGViewCache::BuildOrGetCompressedTopo(
+    katana::PropertyGraph* pg) noexcept {
+  if (compressed_topo_ && compressed_topo_->is_valid()) {
+    KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, compressed_topo_.get()));
+    return compressed_topo_;
+  }
+
+  // Delta encoding only pays off when adjacency lists are sorted. Avoid
+  // building a sorted copy if the default topology happens to be sorted
+  // already, since the copy also carries a permutation of edge property
+  // indices that the compressed topology must keep.
+  const GraphTopology& default_topo = GetDefaultTopologyRef();
+  if (AdjacencyListsSortedByDest(default_topo)) {
+    compressed_topo_ = CompressedTopology::MakeFrom(default_topo);
+  } else {
+    auto it = std::find_if(
+        edge_shuff_topos_.begin(), edge_shuff_topos_.end(),
+        [](const auto& topo_ptr) {
+          return topo_ptr->is_valid() &&
+                 topo_ptr->has_transpose_state(
+                     katana::RDGTopology::TransposeKind::kNo) &&
+                 topo_ptr->has_edges_sorted_by(
+                     katana::RDGTopology::EdgeSortKind::kSortedByDestID);
+        });
+    // Nothing cached, so popping only loads or builds the copy
+    auto sorted_topo =
+        it != edge_shuff_topos_.end()
+            ? *it
+            : PopEdgeShuffTopo(
+                  pg, katana::RDGTopology::TransposeKind::kNo,
+                  katana::RDGTopology::EdgeSortKind::kSortedByDestID);
+    compressed_topo_ = CompressedTopology::MakeFrom(*sorted_topo);
+  }
+
+  KATANA_LOG_DEBUG_ASSERT(CheckTopology(pg, compressed_topo_.get()));
+  return compressed_topo_;
+}
+
 katana::Result<std::vector<katana::RDGTopology>>
 katana::PGViewCache::ToRDGTopology() {
   std::vector<katana::RDGTopology> rdg_topos;
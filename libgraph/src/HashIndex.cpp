@@ -0,0 +1,476 @@
+#include "katana/HashIndex.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+#include "katana/Galois.h"
+#include "katana/GraphTopology.h"
+#include "katana/ParallelSTL.h"
+#include "katana/Reduction.h"
+
+namespace {
+
+constexpr uint64_t kHashSeed = 0x9e3779b97f4a7c15ULL;
+
+/// The splitmix64 finalizer. Hashes must not change between releases because
+/// indexes are persisted, so std::hash is not used.
+uint64_t
+Mix(uint64_t x) {
+  x ^= x >> 30;
+  x *= 0xbf58476d1ce4e5b9ULL;
+  x ^= x >> 27;
+  x *= 0x94d049bb133111ebULL;
+  x ^= x >> 31;
+  return x;
+}
+
+uint64_t
+HashValue(bool v) {
+  return Mix(v);
+}
+
+uint64_t
+HashValue(uint8_t v) {
+  return Mix(v);
+}
+
+uint64_t
+HashValue(int64_t v) {
+  return Mix(static_cast<uint64_t>(v));
+}
+
+uint64_t
+HashValue(uint64_t v) {
+  return Mix(v);
+}
+
+uint64_t
+HashValue(double v) {
+  // Values that compare equal (see ValuesEqual) must hash equally.
+  if (v == 0) {
+    v = 0.0;
+  } else if (std::isnan(v)) {
+    v = std::numeric_limits<double>::quiet_NaN();
+  }
+  uint64_t bits;
+  std::memcpy(&bits, &v, sizeof(bits));
+  return Mix(bits);
+}
+
+uint64_t
+HashValue(std::string_view v) {
+  // FNV-1a
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (char c : v) {
+    h ^= static_cast<uint8_t>(c);
+    h *= 0x100000001b3ULL;
+  }
+  return Mix(h ^ v.size());
+}
+
+uint64_t
+Combine(uint64_t h, uint64_t value_hash) {
+  return Mix(h ^ value_hash);
+}
+
+template <typename T>
+bool
+ValuesEqual(const T& a, const T& b) {
+  return a == b;
+}
+
+/// NaN is a key like any other
+bool
+ValuesEqual(double a, double b) {
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+template <typename ArrayType>
+auto
+ValueAt(const ArrayType& array, int64_t i) {
+  return array.Value(i);
+}
+
+std::string_view
+ValueAt(const arrow::LargeStringArray& array, int64_t i) {
+  arrow::util::string_view view = array.GetView(i);
+  return std::string_view(view.data(), view.length());
+}
+
+bool
+IsIndexable(arrow::Type::type type_id) {
+  switch (type_id) {
+  case arrow::Type::BOOL:
+  case arrow::Type::UINT8:
+  case arrow::Type::INT64:
+  case arrow::Type::UINT64:
+  case arrow::Type::DOUBLE:
+  case arrow::Type::LARGE_STRING:
+    return true;
+  default:
+    return false;
+  }
+}
+
+/// Calls \p fn with \p property cast to its concrete array type. The type must
+/// be one accepted by IsIndexable.
+template <typename Fn>
+auto
+VisitProperty(const arrow::Array& property, const Fn& fn) {
+  switch (property.type_id()) {
+  case arrow::Type::BOOL:
+    return fn(static_cast<const arrow::BooleanArray&>(property));
+  case arrow::Type::UINT8:
+    return fn(static_cast<const arrow::UInt8Array&>(property));
+  case arrow::Type::INT64:
+    return fn(static_cast<const arrow::Int64Array&>(property));
+  case arrow::Type::UINT64:
+    return fn(static_cast<const arrow::UInt64Array&>(property));
+  case arrow::Type::DOUBLE:
+    return fn(static_cast<const arrow::DoubleArray&>(property));
+  case arrow::Type::LARGE_STRING:
+    return fn(static_cast<const arrow::LargeStringArray&>(property));
+  default:
+    KATANA_LOG_FATAL(
+        "unexpected property type: {}", property.type()->ToString());
+  }
+}
+
+template <typename node_or_edge>
+struct HashedID {
+  uint64_t hash;
+  node_or_edge id;
+
+  bool operator<(const HashedID& other) const {
+    return hash < other.hash || (hash == other.hash && id < other.id);
+  }
+};
+
+}  // namespace
+
+template <typename node_or_edge>
+katana::HashIndex<node_or_edge>::HashIndex(
+    std::vector<std::string> property_names, size_t num_entities,
+    std::vector<std::shared_ptr<arrow::Array>> properties)
+    : property_names_(std::move(property_names)),
+      num_entities_(num_entities),
+      properties_(std::move(properties)) {}
+
+template <typename node_or_edge>
+katana::Result<std::unique_ptr<katana::HashIndex<node_or_edge>>>
+katana::HashIndex<node_or_edge>::Make(
+    std::vector<std::string> property_names, size_t num_entities,
+    std::vector<std::shared_ptr<arrow::Array>> properties) {
+  if (properties.empty() || properties.size() != property_names.size()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "expected one or more properties and one name per property");
+  }
+  for (size_t i = 0; i < properties.size(); ++i) {
+    if (!IsIndexable(properties[i]->type_id())) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "Column has type unknown for indexing: {}",
+          properties[i]->type()->ToString());
+    }
+    if (static_cast<uint64_t>(properties[i]->length()) < num_entities) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "Property {} does not contain all entities", property_names[i]);
+    }
+  }
+
+  // Some compilers seem to have trouble converting to Result here.
+  return Result<std::unique_ptr<HashIndex>>(
+      std::unique_ptr<HashIndex>(new HashIndex(
+          std::move(property_names), num_entities, std::move(properties))));
+}
+
+template <typename node_or_edge>
+uint64_t
+katana::HashIndex<node_or_edge>::HashOf(node_or_edge id) const {
+  uint64_t h = kHashSeed;
+  for (const auto& property : properties_) {
+    VisitProperty(*property, [&](const auto& array) {
+      h = Combine(h, HashValue(ValueAt(array, id)));
+    });
+  }
+  return h;
+}
+
+template <typename node_or_edge>
+bool
+katana::HashIndex<node_or_edge>::AllValid(node_or_edge id) const {
+  for (const auto& property : properties_) {
+    if (!property->IsValid(id)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename node_or_edge>
+bool
+katana::HashIndex<node_or_edge>::KeysEqual(
+    node_or_edge a, node_or_edge b) const {
+  for (const auto& property : properties_) {
+    bool equal = VisitProperty(*property, [&](const auto& array) {
+      return ValuesEqual(ValueAt(array, a), ValueAt(array, b));
+    });
+    if (!equal) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename node_or_edge>
+bool
+katana::HashIndex<node_or_edge>::KeyEquals(
+    const Key& key, node_or_edge id) const {
+  for (size_t i = 0; i < properties_.size(); ++i) {
+    bool equal = VisitProperty(*properties_[i], [&](const auto& array) {
+      using ValueType = decltype(ValueAt(array, 0));
+      return ValuesEqual(std::get<ValueType>(key[i]), ValueAt(array, id));
+    });
+    if (!equal) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename node_or_edge>
+katana::Result<void>
+katana::HashIndex<node_or_edge>::BuildFromProperties() {
+  // Collect the entities with all properties valid. Each thread counts the
+  // valid entities of its block and then writes them starting at the prefix
+  // sum of the counts.
+  std::vector<size_t> offsets(katana::getActiveThreads() + 1, 0);
+  katana::on_each([&](unsigned tid, unsigned total) {
+    auto [begin, end] =
+        katana::block_range(size_t{0}, num_entities_, tid, total);
+    size_t count = 0;
+    for (size_t i = begin; i < end; ++i) {
+      count += AllValid(i);
+    }
+    offsets[tid + 1] = count;
+  });
+  std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+  const size_t num_ids = offsets.back();
+
+  NUMAArray<HashedID<node_or_edge>> entries;
+  entries.allocateInterleaved(num_ids);
+  katana::on_each([&](unsigned tid, unsigned total) {
+    auto [begin, end] =
+        katana::block_range(size_t{0}, num_entities_, tid, total);
+    size_t out = offsets[tid];
+    for (size_t i = begin; i < end; ++i) {
+      auto id = static_cast<node_or_edge>(i);
+      if (AllValid(id)) {
+        entries[out++] = HashedID<node_or_edge>{HashOf(id), id};
+      }
+    }
+  });
+
+  // Sorting by hash puts entities with the same key next to each other.
+  katana::ParallelSTL::sort(entries.begin(), entries.end());
+
+  ids_.allocateInterleaved(num_ids);
+  NUMAArray<uint64_t> group_number;
+  group_number.allocateInterleaved(num_ids);
+  katana::GReduceLogicalOr collision;
+  katana::do_all(
+      katana::iterate(size_t{0}, num_ids),
+      [&](size_t i) {
+        ids_[i] = entries[i].id;
+        bool starts_group = i == 0 || entries[i].hash != entries[i - 1].hash;
+        if (!starts_group && !KeysEqual(entries[i - 1].id, entries[i].id)) {
+          starts_group = true;
+          collision.update(true);
+        }
+        group_number[i] = starts_group;
+      },
+      katana::no_stats(), katana::loopname("HashIndex-FindGroups"));
+
+  if (collision.reduce()) {
+    // Different keys with the same hash may be interleaved. Regroup each run
+    // of equal hashes by key, keeping ids in order. This is rare enough to be
+    // done serially.
+    for (size_t begin = 0; begin < num_ids;) {
+      size_t end = begin + 1;
+      bool mixed = false;
+      while (end < num_ids && entries[end].hash == entries[begin].hash) {
+        mixed |= group_number[end] != 0;
+        ++end;
+      }
+      if (mixed) {
+        std::vector<std::vector<node_or_edge>> groups;
+        for (size_t i = begin; i < end; ++i) {
+          auto it = std::find_if(groups.begin(), groups.end(), [&](auto& g) {
+            return KeysEqual(g.front(), ids_[i]);
+          });
+          if (it == groups.end()) {
+            groups.emplace_back();
+            it = groups.end() - 1;
+          }
+          it->push_back(ids_[i]);
+        }
+        size_t out = begin;
+        for (const auto& group : groups) {
+          for (size_t j = 0; j < group.size(); ++j) {
+            group_number[out] = j == 0;
+            ids_[out++] = group[j];
+          }
+        }
+      }
+      begin = end;
+    }
+  }
+
+  katana::ParallelSTL::partial_sum(
+      group_number.begin(), group_number.end(), group_number.begin());
+  const size_t num_groups = num_ids == 0 ? 0 : group_number[num_ids - 1];
+
+  group_offsets_.allocateInterleaved(num_groups + 1);
+  group_hashes_.allocateInterleaved(num_groups);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_ids),
+      [&](size_t i) {
+        if (i == 0 || group_number[i] != group_number[i - 1]) {
+          uint64_t group = group_number[i] - 1;
+          group_offsets_[group] = i;
+          group_hashes_[group] = entries[i].hash;
+        }
+      },
+      katana::no_stats(), katana::loopname("HashIndex-GroupOffsets"));
+  group_offsets_[num_groups] = num_ids;
+
+  // Keep the table at most half full.
+  size_t num_slots = 1;
+  while (num_slots < 2 * num_groups) {
+    num_slots *= 2;
+  }
+  const uint64_t mask = num_slots - 1;
+  slots_.allocateInterleaved(num_slots);
+  katana::ParallelSTL::fill(slots_.begin(), slots_.end(), uint64_t{0});
+  katana::do_all(
+      katana::iterate(size_t{0}, num_groups),
+      [&](size_t group) {
+        uint64_t slot = group_hashes_[group] & mask;
+        while (!__sync_bool_compare_and_swap(&slots_[slot], 0, group + 1)) {
+          slot = (slot + 1) & mask;
+        }
+      },
+      katana::no_stats(), katana::loopname("HashIndex-Insert"));
+
+  return katana::ResultSuccess();
+}
+
+template <typename node_or_edge>
+katana::Result<typename katana::HashIndex<node_or_edge>::Range>
+katana::HashIndex<node_or_edge>::Find(const Key& key) const {
+  if (key.size() != properties_.size()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "expected a key of {} values, got {}",
+        properties_.size(), key.size());
+  }
+
+  uint64_t h = kHashSeed;
+  for (size_t i = 0; i < properties_.size(); ++i) {
+    bool type_matches = VisitProperty(*properties_[i], [&](const auto& array) {
+      using ValueType = decltype(ValueAt(array, 0));
+      const auto* value = std::get_if<ValueType>(&key[i]);
+      if (value == nullptr) {
+        return false;
+      }
+      h = Combine(h, HashValue(*value));
+      return true;
+    });
+    if (!type_matches) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "key value {} does not match the type of property {} ({})", i,
+          property_names_[i], properties_[i]->type()->ToString());
+    }
+  }
+
+  if (slots_.empty()) {
+    return Range(ids_.data(), ids_.data());
+  }
+  const uint64_t mask = slots_.size() - 1;
+  for (uint64_t slot = h & mask;; slot = (slot + 1) & mask) {
+    uint64_t entry = slots_[slot];
+    if (entry == 0) {
+      return Range(ids_.data(), ids_.data());
+    }
+    uint64_t group = entry - 1;
+    if (group_hashes_[group] == h &&
+        KeyEquals(key, ids_[group_offsets_[group]])) {
+      return Range(
+          ids_.data() + group_offsets_[group],
+          ids_.data() + group_offsets_[group + 1]);
+    }
+  }
+}
+
+template <typename node_or_edge>
+katana::PropertyHashIndexPrimitive
+katana::HashIndex<node_or_edge>::ToPrimitive() const {
+  PropertyHashIndexPrimitive primitive;
+  primitive.set_is_edge_index(
+      std::is_same_v<node_or_edge, katana::GraphTopology::Edge>);
+  primitive.set_property_names(property_names_);
+  primitive.set_num_entities(num_entities_);
+
+  auto copy = [](const auto& from, NUMAArray<uint64_t>* to) {
+    to->allocateInterleaved(from.size());
+    katana::ParallelSTL::copy(from.begin(), from.end(), to->begin());
+  };
+  copy(ids_, &primitive.ids());
+  copy(group_offsets_, &primitive.group_offsets());
+  copy(group_hashes_, &primitive.group_hashes());
+  copy(slots_, &primitive.slots());
+
+  return primitive;
+}
+
+template <typename node_or_edge>
+katana::Result<void>
+katana::HashIndex<node_or_edge>::FromPrimitive(
+    PropertyHashIndexPrimitive* primitive) {
+  if (primitive->is_edge_index() !=
+          std::is_same_v<node_or_edge, katana::GraphTopology::Edge> ||
+      primitive->property_names() != property_names_ ||
+      primitive->num_entities() != num_entities_) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "hash index {} was not built for these properties",
+        primitive->name());
+  }
+
+  const size_t num_groups = primitive->group_hashes().size();
+  const size_t num_slots = primitive->slots().size();
+  if (primitive->group_offsets().size() != num_groups + 1 ||
+      primitive->group_offsets()[num_groups] != primitive->ids().size() ||
+      num_slots <= num_groups || (num_slots & (num_slots - 1)) != 0) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "hash index {} is inconsistent",
+        primitive->name());
+  }
+
+  ids_.allocateInterleaved(primitive->ids().size());
+  katana::ParallelSTL::transform(
+      primitive->ids().begin(), primitive->ids().end(), ids_.begin(),
+      [](uint64_t id) { return static_cast<node_or_edge>(id); });
+  group_offsets_ = std::move(primitive->group_offsets());
+  group_hashes_ = std::move(primitive->group_hashes());
+  slots_ = std::move(primitive->slots());
+
+  return katana::ResultSuccess();
+}
+
+template class katana::HashIndex<katana::GraphTopology::Node>;
+template class katana::HashIndex<katana::GraphTopology::Edge>;
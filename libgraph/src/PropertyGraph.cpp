@@ -3,6 +3,7 @@
 #include <stdio.h>
 #include <sys/mman.h>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -149,6 +150,63 @@ FillBitMask(
   });
 }
 
+/// Fills \p index from the copy stored with \p rdg if there is one and it
+/// matches the index, and builds it otherwise. The RDG forgets stored copies
+/// when any of their properties are written, so a stored copy is never older
+/// than its properties.
+template <typename node_or_edge>
+katana::Result<void>
+LoadOrBuildHashIndex(katana::RDG* rdg, katana::HashIndex<node_or_edge>* index) {
+  std::string name = katana::PropertyHashIndexPrimitive::name(
+      std::is_same_v<node_or_edge, katana::GraphTopology::Edge>,
+      index->property_names());
+  std::optional<katana::PropertyHashIndexPrimitive> primitive =
+      KATANA_CHECKED(rdg->LoadPropertyHashIndexPrimitive(name));
+  if (primitive) {
+    auto res = index->FromPrimitive(&primitive.value());
+    if (res) {
+      return katana::ResultSuccess();
+    }
+    KATANA_LOG_WARN("rebuilding stale hash index {}: {}", name, res.error());
+  }
+  return index->BuildFromProperties();
+}
+
+template <typename IndexList>
+auto
+FindHashIndex(
+    const IndexList& indexes, const std::vector<std::string>& property_names)
+    -> katana::Result<typename IndexList::value_type> {
+  for (const auto& index : indexes) {
+    if (index->property_names() == property_names) {
+      return index;
+    }
+  }
+  return KATANA_ERROR(
+      katana::ErrorCode::NotFound, "hash index over {} not found",
+      fmt::join(property_names, ", "));
+}
+
+/// Forgets the indexes over any of \p property_names, which no longer match
+/// their properties
+template <typename IndexList>
+void
+DropHashIndexesOver(
+    IndexList* indexes, const std::vector<std::string>& property_names) {
+  auto uses_any = [&](const auto& index) {
+    for (const auto& name : index->property_names()) {
+      if (std::find(property_names.begin(), property_names.end(), name) !=
+          property_names.end()) {
+        return true;
+      }
+    }
+    return false;
+  };
+  indexes->erase(
+      std::remove_if(indexes->begin(), indexes->end(), uses_any),
+      indexes->end());
+}
+
 }  // namespace
 
 katana::PropertyGraph::~PropertyGraph() = default;
@@ -166,11 +224,17 @@ katana::PropertyGraph::Make(
 
   KATANA_LOG_DEBUG_ASSERT(CheckTopology(
       csr->adj_indices(), csr->num_nodes(), csr->dests(), csr->num_edges()));
-  katana::GraphTopology topo = katana::GraphTopology(
-      csr->adj_indices(), csr->num_nodes(), csr->dests(), csr->num_edges());
-
-  // The GraphTopology constructor copies all of the required topology data.
-  // Clean up the RDGTopologies memory
+  // A topology mapped from a local file is used in place, otherwise the
+  // GraphTopology constructor copies all of the required topology data.
+  katana::GraphTopology topo =
+      csr->mapped_file()
+          ? katana::GraphTopology::MakeMapped(*csr)
+          : katana::GraphTopology(
+                csr->adj_indices(), csr->num_nodes(), csr->dests(),
+                csr->num_edges());
+
+  // Clean up the RDGTopologies memory; a mapped file stays alive as long as
+  // topo uses it
   KATANA_CHECKED(csr->unbind_file_storage());
 
   if (rdg.IsEntityTypeIDsOutsideProperties()) {
@@ -1163,7 +1227,9 @@ katana::PropertyGraph::AddNodeProperties(
         ErrorCode::InvalidArgument, "expected {} rows found {} instead",
         NumOriginalNodes(), props->num_rows());
   }
-  return rdg_->AddNodeProperties(props, txn_ctx);
+  KATANA_CHECKED(rdg_->AddNodeProperties(props, txn_ctx));
+  DropHashIndexesOver(&node_hash_indexes_, props->ColumnNames());
+  return katana::ResultSuccess();
 }
 
 katana::Result<void>
@@ -1178,12 +1244,17 @@ katana::PropertyGraph::UpsertNodeProperties(
         ErrorCode::InvalidArgument, "expected {} rows found {} instead",
         NumOriginalNodes(), props->num_rows());
   }
-  return rdg_->UpsertNodeProperties(props, txn_ctx);
+  KATANA_CHECKED(rdg_->UpsertNodeProperties(props, txn_ctx));
+  DropHashIndexesOver(&node_hash_indexes_, props->ColumnNames());
+  return katana::ResultSuccess();
 }
 
 katana::Result<void>
 katana::PropertyGraph::RemoveNodeProperty(int i, katana::TxnContext* txn_ctx) {
-  return rdg_->RemoveNodeProperty(i, txn_ctx);
+  std::string name = rdg_->node_properties()->field(i)->name();
+  KATANA_CHECKED(rdg_->RemoveNodeProperty(i, txn_ctx));
+  DropHashIndexesOver(&node_hash_indexes_, {name});
+  return katana::ResultSuccess();
 }
 
 katana::Result<void>
@@ -1192,7 +1263,7 @@ katana::PropertyGraph::RemoveNodeProperty(
   auto col_names = rdg_->node_properties()->ColumnNames();
   auto pos = std::find(col_names.cbegin(), col_names.cend(), prop_name);
   if (pos != col_names.cend()) {
-    return rdg_->RemoveNodeProperty(
+    return RemoveNodeProperty(
         std::distance(col_names.cbegin(), pos), txn_ctx);
   }
   return katana::ErrorCode::PropertyNotFound;
@@ -1202,6 +1273,22 @@ katana::Result<void>
 katana::PropertyGraph::LoadNodeProperty(const std::string& name, int i) {
   return rdg_->LoadNodeProperty(name, i);
 }
+
+katana::Result<std::shared_ptr<arrow::Table>>
+katana::PropertyGraph::ReadNodePropertyRange(
+    const std::string& name, const ParquetReader::Bound& min,
+    const ParquetReader::Bound& max,
+    std::vector<ParquetReader::Slice>* slices) const {
+  return rdg_->ReadNodePropertyRange(name, min, max, slices);
+}
+
+katana::Result<std::shared_ptr<arrow::Table>>
+katana::PropertyGraph::ReadEdgePropertyRange(
+    const std::string& name, const ParquetReader::Bound& min,
+    const ParquetReader::Bound& max,
+    std::vector<ParquetReader::Slice>* slices) const {
+  return rdg_->ReadEdgePropertyRange(name, min, max, slices);
+}
 /// Load a node property by name if it is absent and append its column to
 /// the table do nothing otherwise
 katana::Result<void>
@@ -1229,7 +1316,9 @@ katana::PropertyGraph::AddEdgeProperties(
         ErrorCode::InvalidArgument, "expected {} rows found {} instead",
         NumOriginalEdges(), props->num_rows());
   }
-  return rdg_->AddEdgeProperties(props, txn_ctx);
+  KATANA_CHECKED(rdg_->AddEdgeProperties(props, txn_ctx));
+  DropHashIndexesOver(&edge_hash_indexes_, props->ColumnNames());
+  return katana::ResultSuccess();
 }
 
 katana::Result<void>
@@ -1244,12 +1333,17 @@ katana::PropertyGraph::UpsertEdgeProperties(
         ErrorCode::InvalidArgument, "expected {} rows found {} instead",
         NumOriginalEdges(), props->num_rows());
   }
-  return rdg_->UpsertEdgeProperties(props, txn_ctx);
+  KATANA_CHECKED(rdg_->UpsertEdgeProperties(props, txn_ctx));
+  DropHashIndexesOver(&edge_hash_indexes_, props->ColumnNames());
+  return katana::ResultSuccess();
 }
 
 katana::Result<void>
 katana::PropertyGraph::RemoveEdgeProperty(int i, katana::TxnContext* txn_ctx) {
-  return rdg_->RemoveEdgeProperty(i, txn_ctx);
+  std::string name = rdg_->edge_properties()->field(i)->name();
+  KATANA_CHECKED(rdg_->RemoveEdgeProperty(i, txn_ctx));
+  DropHashIndexesOver(&edge_hash_indexes_, {name});
+  return katana::ResultSuccess();
 }
 
 katana::Result<void>
@@ -1258,7 +1352,7 @@ katana::PropertyGraph::RemoveEdgeProperty(
   auto col_names = rdg_->edge_properties()->ColumnNames();
   auto pos = std::find(col_names.cbegin(), col_names.cend(), prop_name);
   if (pos != col_names.cend()) {
-    return rdg_->RemoveEdgeProperty(
+    return RemoveEdgeProperty(
         std::distance(col_names.cbegin(), pos), txn_ctx);
   }
   return katana::ErrorCode::PropertyNotFound;
@@ -1704,3 +1798,109 @@ katana::PropertyGraph::GetEdgeIndex(const std::string& property_name) const {
   }
   return KATANA_ERROR(katana::ErrorCode::NotFound, "edge index not found");
 }
+
+katana::Result<void>
+katana::PropertyGraph::MakeNodeHashIndex(
+    const std::vector<std::string>& property_names) {
+  if (FindHashIndex(node_hash_indexes_, property_names)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AlreadyExists, "Index already exists for {}",
+        fmt::join(property_names, ", "));
+  }
+
+  std::vector<std::shared_ptr<arrow::Array>> properties;
+  for (const auto& property_name : property_names) {
+    std::shared_ptr<arrow::ChunkedArray> chunked_property =
+        KATANA_CHECKED(GetNodeProperty(property_name));
+    KATANA_LOG_ASSERT(chunked_property->num_chunks() == 1);
+    properties.emplace_back(chunked_property->chunk(0));
+  }
+
+  std::shared_ptr<katana::HashIndex<GraphTopology::Node>> index =
+      KATANA_CHECKED(katana::HashIndex<GraphTopology::Node>::Make(
+          property_names, NumNodes(), std::move(properties)));
+  KATANA_CHECKED(LoadOrBuildHashIndex(&rdg(), index.get()));
+
+  node_hash_indexes_.push_back(std::move(index));
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::PropertyGraph::MakeEdgeHashIndex(
+    const std::vector<std::string>& property_names) {
+  if (FindHashIndex(edge_hash_indexes_, property_names)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::AlreadyExists, "Index already exists for {}",
+        fmt::join(property_names, ", "));
+  }
+
+  std::vector<std::shared_ptr<arrow::Array>> properties;
+  for (const auto& property_name : property_names) {
+    std::shared_ptr<arrow::ChunkedArray> chunked_property =
+        KATANA_CHECKED(GetEdgeProperty(property_name));
+    KATANA_LOG_ASSERT(chunked_property->num_chunks() == 1);
+    properties.emplace_back(chunked_property->chunk(0));
+  }
+
+  std::shared_ptr<katana::HashIndex<GraphTopology::Edge>> index =
+      KATANA_CHECKED(katana::HashIndex<GraphTopology::Edge>::Make(
+          property_names, NumEdges(), std::move(properties)));
+  KATANA_CHECKED(LoadOrBuildHashIndex(&rdg(), index.get()));
+
+  edge_hash_indexes_.push_back(std::move(index));
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::PropertyGraph::DeleteNodeHashIndex(
+    const std::vector<std::string>& property_names) {
+  auto index =
+      KATANA_CHECKED(FindHashIndex(node_hash_indexes_, property_names));
+  node_hash_indexes_.erase(std::find(
+      node_hash_indexes_.begin(), node_hash_indexes_.end(), index));
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::PropertyGraph::DeleteEdgeHashIndex(
+    const std::vector<std::string>& property_names) {
+  auto index =
+      KATANA_CHECKED(FindHashIndex(edge_hash_indexes_, property_names));
+  edge_hash_indexes_.erase(std::find(
+      edge_hash_indexes_.begin(), edge_hash_indexes_.end(), index));
+  return katana::ResultSuccess();
+}
+
+katana::Result<
+    std::shared_ptr<katana::HashIndex<katana::GraphTopology::Node>>>
+katana::PropertyGraph::GetNodeHashIndex(
+    const std::vector<std::string>& property_names) const {
+  return FindHashIndex(node_hash_indexes_, property_names);
+}
+
+katana::Result<
+    std::shared_ptr<katana::HashIndex<katana::GraphTopology::Edge>>>
+katana::PropertyGraph::GetEdgeHashIndex(
+    const std::vector<std::string>& property_names) const {
+  return FindHashIndex(edge_hash_indexes_, property_names);
+}
+
+katana::Result<void>
+katana::PropertyGraph::WriteNodeHashIndex(
+    const std::vector<std::string>& property_names) {
+  auto index =
+      KATANA_CHECKED(FindHashIndex(node_hash_indexes_, property_names));
+  katana::PropertyHashIndexPrimitive primitive = index->ToPrimitive();
+  return rdg().WritePropertyHashIndexPrimitive(primitive);
+}
+
+katana::Result<void>
+katana::PropertyGraph::WriteEdgeHashIndex(
+    const std::vector<std::string>& property_names) {
+  auto index =
+      KATANA_CHECKED(FindHashIndex(edge_hash_indexes_, property_names));
+  katana::PropertyHashIndexPrimitive primitive = index->ToPrimitive();
+  return rdg().WritePropertyHashIndexPrimitive(primitive);
+}
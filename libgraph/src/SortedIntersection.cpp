@@ -0,0 +1,234 @@
+#include "katana/SortedIntersection.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define KATANA_INTERSECTION_X86 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+using IntersectFn =
+    size_t (*)(const uint32_t*, size_t, const uint32_t*, size_t);
+
+/// Merges the tails left over by the block kernels
+size_t
+ScalarMerge(
+    const uint32_t* a, size_t a_size, const uint32_t* b,
+    size_t b_size) noexcept {
+  size_t i = 0;
+  size_t j = 0;
+  size_t count = 0;
+  while (i < a_size && j < b_size) {
+    const uint32_t va = a[i];
+    const uint32_t vb = b[j];
+    // branch-free advance; mispredictions dominate a plain merge
+    count += va == vb;
+    i += va <= vb;
+    j += vb <= va;
+  }
+  return count;
+}
+
+/// Searches each element of the short array \p a in the long array \p b,
+/// doubling the step from the last match before a binary search.
+size_t
+Galloping(
+    const uint32_t* a, size_t a_size, const uint32_t* b,
+    size_t b_size) noexcept {
+  size_t count = 0;
+  size_t lo = 0;
+  for (size_t i = 0; i < a_size && lo < b_size; ++i) {
+    const uint32_t v = a[i];
+    size_t step = 1;
+    size_t hi = lo;
+    while (hi < b_size && b[hi] < v) {
+      lo = hi + 1;
+      hi += step;
+      step *= 2;
+    }
+    hi = std::min(hi + 1, b_size);
+    lo = std::lower_bound(b + lo, b + hi, v) - b;
+    if (lo < b_size && b[lo] == v) {
+      ++count;
+      ++lo;
+    }
+  }
+  return count;
+}
+
+#if KATANA_INTERSECTION_X86
+
+/// True if a[i] or b[j] repeats the element before it. The block kernels
+/// count an element of a once if it equals any element in the block of b, so
+/// they only match repeated elements one-to-one when no block holds a repeat
+/// and no block starts with one.
+bool
+RepeatsAt(const uint32_t* a, size_t i, const uint32_t* b, size_t j) noexcept {
+  return (i > 0 && a[i] == a[i - 1]) || (j > 0 && b[j] == b[j - 1]);
+}
+
+/// Compares a block of 8 elements of each array all-against-all by rotating
+/// the block of b through every lane, then advances the block(s) with the
+/// smaller maximum. Inputs with repeated elements are merged by ScalarMerge.
+__attribute__((target("avx2"))) size_t
+BlockMergeAVX2(
+    const uint32_t* a, size_t a_size, const uint32_t* b,
+    size_t b_size) noexcept {
+  constexpr size_t kLanes = 8;
+  const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+  const __m256i prev = _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6);
+
+  size_t i = 0;
+  size_t j = 0;
+  size_t count = 0;
+  while (i + kLanes <= a_size && j + kLanes <= b_size) {
+    const __m256i va =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+
+    // Compare every element with the one before it in its block, and the
+    // first ones with the element before the block
+    const unsigned repeats =
+        static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(
+            _mm256_or_si256(
+                _mm256_cmpeq_epi32(va, _mm256_permutevar8x32_epi32(va, prev)),
+                _mm256_cmpeq_epi32(
+                    vb, _mm256_permutevar8x32_epi32(vb, prev)))))) &
+        0xfeu;
+    if (repeats != 0 || RepeatsAt(a, i, b, j)) {
+      return ScalarMerge(a, a_size, b, b_size);
+    }
+
+    __m256i eq = _mm256_cmpeq_epi32(va, vb);
+    for (size_t r = 1; r < kLanes; ++r) {
+      vb = _mm256_permutevar8x32_epi32(vb, rotate);
+      eq = _mm256_or_si256(eq, _mm256_cmpeq_epi32(va, vb));
+    }
+    count += __builtin_popcount(
+        static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(eq))));
+
+    const uint32_t a_max = a[i + kLanes - 1];
+    const uint32_t b_max = b[j + kLanes - 1];
+    i += (a_max <= b_max) ? kLanes : 0;
+    j += (b_max <= a_max) ? kLanes : 0;
+  }
+  if (i < a_size && j < b_size && RepeatsAt(a, i, b, j)) {
+    return ScalarMerge(a, a_size, b, b_size);
+  }
+  return count + ScalarMerge(a + i, a_size - i, b + j, b_size - j);
+}
+
+/// AVX-512 variant of BlockMergeAVX2 with blocks of 16 elements
+__attribute__((target("avx512f"))) size_t
+BlockMergeAVX512(
+    const uint32_t* a, size_t a_size, const uint32_t* b,
+    size_t b_size) noexcept {
+  constexpr size_t kLanes = 16;
+  const __m512i prev = _mm512_setr_epi32(
+      0, 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14);
+
+  size_t i = 0;
+  size_t j = 0;
+  size_t count = 0;
+  while (i + kLanes <= a_size && j + kLanes <= b_size) {
+    const __m512i va = _mm512_loadu_si512(a + i);
+    __m512i vb = _mm512_loadu_si512(b + j);
+
+    const __mmask16 repeats =
+        _mm512_mask_cmpeq_epi32_mask(
+            0xfffe, va, _mm512_permutexvar_epi32(prev, va)) |
+        _mm512_mask_cmpeq_epi32_mask(
+            0xfffe, vb, _mm512_permutexvar_epi32(prev, vb));
+    if (repeats != 0 || RepeatsAt(a, i, b, j)) {
+      return ScalarMerge(a, a_size, b, b_size);
+    }
+
+    __mmask16 eq = _mm512_cmpeq_epi32_mask(va, vb);
+    for (size_t r = 1; r < kLanes; ++r) {
+      vb = _mm512_mask_alignr_epi32(vb, 0xffff, vb, vb, 1);
+      eq |= _mm512_cmpeq_epi32_mask(va, vb);
+    }
+    count += __builtin_popcount(static_cast<unsigned>(eq));
+
+    const uint32_t a_max = a[i + kLanes - 1];
+    const uint32_t b_max = b[j + kLanes - 1];
+    i += (a_max <= b_max) ? kLanes : 0;
+    j += (b_max <= a_max) ? kLanes : 0;
+  }
+  if (i < a_size && j < b_size && RepeatsAt(a, i, b, j)) {
+    return ScalarMerge(a, a_size, b, b_size);
+  }
+  return count + ScalarMerge(a + i, a_size - i, b + j, b_size - j);
+}
+
+#endif
+
+IntersectFn
+SelectBlockMerge() noexcept {
+#if KATANA_INTERSECTION_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return BlockMergeAVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return BlockMergeAVX2;
+  }
+#endif
+  return ScalarMerge;
+}
+
+}  // namespace
+
+size_t
+katana::SortedIntersectionSizeScalar(
+    const uint32_t* a, size_t a_size, const uint32_t* b,
+    size_t b_size) noexcept {
+  if (a_size > b_size) {
+    std::swap(a, b);
+    std::swap(a_size, b_size);
+  }
+  if (a_size == 0) {
+    return 0;
+  }
+  if (b_size / a_size >= kGallopingRatio) {
+    return Galloping(a, a_size, b, b_size);
+  }
+  return ScalarMerge(a, a_size, b, b_size);
+}
+
+size_t
+katana::SortedIntersectionSize(
+    const uint32_t* a, size_t a_size, const uint32_t* b,
+    size_t b_size) noexcept {
+  static const IntersectFn block_merge = SelectBlockMerge();
+
+  if (a_size > b_size) {
+    std::swap(a, b);
+    std::swap(a_size, b_size);
+  }
+  if (a_size == 0) {
+    return 0;
+  }
+  if (b_size / a_size >= kGallopingRatio) {
+    return Galloping(a, a_size, b, b_size);
+  }
+  return block_merge(a, a_size, b, b_size);
+}
+
+katana::IntersectionBitmap::IntersectionBitmap(
+    const uint32_t* set, size_t size, uint32_t universe)
+    : bits_((size_t{universe} + 63) / 64, 0) {
+  for (size_t i = 0; i < size; ++i) {
+    bits_[set[i] / 64] |= uint64_t{1} << (set[i] % 64);
+  }
+}
+
+size_t
+katana::IntersectionBitmap::IntersectionSize(
+    const uint32_t* b, size_t b_size) const noexcept {
+  size_t count = 0;
+  for (size_t i = 0; i < b_size; ++i) {
+    count += Contains(b[i]);
+  }
+  return count;
+}
@@ -18,4 +18,11 @@ katana::Result<void> BetweennessCentralityLevel(
     katana::analytics::BetweennessCentralityPlan plan,
     katana::TxnContext* txn_ctx);
 
+katana::Result<void> BetweennessCentralitySampling(
+    katana::PropertyGraph* pg,
+    katana::analytics::BetweennessCentralitySources sources,
+    const std::string& output_property_name,
+    katana::analytics::BetweennessCentralityPlan plan,
+    katana::TxnContext* txn_ctx);
+
 #endif
@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+
 #include "betweenness_centrality_impl.h"
 #include "katana/AtomicHelpers.h"
 #include "katana/DynamicBitset.h"
@@ -242,8 +246,153 @@ ExtractBC(
   return katana::ResultSuccess();
 }
 
+/// The smallest number of samples after which BetweennessCentralitySampling
+/// checks whether its bound is met
+constexpr static uint64_t kMinSamples = 64;
+
+/// The number of samples after which BetweennessCentralitySampling checks
+/// whether its bound is met: doubling up to max_samples, which is always a
+/// checkpoint
+std::vector<uint64_t>
+SamplingCheckpoints(uint64_t max_samples) {
+  std::vector<uint64_t> checkpoints{max_samples};
+  while (checkpoints.back() / 2 >= kMinSamples) {
+    checkpoints.emplace_back(checkpoints.back() / 2);
+  }
+  std::reverse(checkpoints.begin(), checkpoints.end());
+  return checkpoints;
+}
+
 }  // namespace
 
+katana::Result<void>
+BetweennessCentralitySampling(
+    katana::PropertyGraph* pg,
+    katana::analytics::BetweennessCentralitySources sources,
+    const std::string& output_property_name,
+    katana::analytics::BetweennessCentralityPlan plan,
+    katana::TxnContext* txn_ctx) {
+  if (std::holds_alternative<std::vector<uint32_t>>(sources)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "sampling chooses its own sources");
+  }
+  if (!(plan.epsilon() > 0 && plan.delta() > 0 && plan.delta() < 1)) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "epsilon must be positive and delta in (0, 1), given {} and {}",
+        plan.epsilon(), plan.delta());
+  }
+
+  LevelGraph graph = KATANA_CHECKED(LevelGraph::Make(pg, {}, {}));
+  katana::ReportPageAllocGuard page_alloc;
+
+  BCLevelNodeDataArray graph_data;
+  katana::DynamicBitset active_edges;
+  LevelInitializeGraph(&graph, &graph_data, &active_edges);
+
+  const uint64_t num_nodes = graph.size();
+  if (num_nodes < 2) {
+    return ExtractBC(pg, graph, graph_data, output_property_name, txn_ctx);
+  }
+
+  // A sample is the dependency of a node on a uniformly chosen source
+  // divided by n - 1, so that it is in [0, 1] and its mean is the
+  // betweenness normalized by n * (n - 1). Half of delta goes to the
+  // Hoeffding bound over all nodes at max_samples and half to the empirical
+  // Bernstein bounds of all nodes at all checkpoints.
+  const double n = num_nodes;
+  const double epsilon = plan.epsilon();
+  const double delta = plan.delta();
+  uint64_t max_samples =
+      std::ceil(std::log(4 * n / delta) / (2 * epsilon * epsilon));
+  if (std::holds_alternative<uint32_t>(sources) &&
+      sources != kBetweennessCentralityAllNodes) {
+    max_samples = std::min<uint64_t>(max_samples, std::get<uint32_t>(sources));
+  }
+  if (max_samples == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "no sources to sample");
+  }
+  std::vector<uint64_t> checkpoints = SamplingCheckpoints(max_samples);
+  const double log_bernstein =
+      std::log(8 * n * checkpoints.size() / delta);
+
+  // Squares of the samples, for their variance
+  katana::NUMAArray<double> squares;
+  squares.allocateBlocked(num_nodes);
+  katana::ParallelSTL::fill(squares.begin(), squares.end(), 0.0);
+
+  std::mt19937_64 gen(plan.seed());
+  std::uniform_int_distribution<LevelGNode> any_node(0, num_nodes - 1);
+
+  katana::StatTimer exec_time("Sampling", "BetweennessCentrality");
+
+  uint64_t num_samples = 0;
+  double error_bound = 0;
+  for (uint64_t checkpoint : checkpoints) {
+    exec_time.start();
+    for (; num_samples < checkpoint; ++num_samples) {
+      LevelGNode src_node = any_node(gen);
+      LevelInitializeIteration(&graph, src_node, &graph_data, &active_edges);
+      katana::gstl::Vector<LevelWorklistType> worklists =
+          LevelSSSP(&graph, src_node, &graph_data, &active_edges);
+      LevelBackwardBrandes(&graph, &worklists, &graph_data, &active_edges);
+      katana::do_all(
+          katana::iterate(graph),
+          [&](LevelGNode v) {
+            double sample = graph_data[v].dependency / (n - 1);
+            squares[v] += sample * sample;
+          },
+          katana::no_stats(), katana::loopname("AccumulateSquares"));
+    }
+    exec_time.stop();
+
+    if (checkpoint == max_samples) {
+      error_bound = std::sqrt(std::log(4 * n / delta) / (2 * max_samples));
+    }
+    if (num_samples < 2) {
+      continue;
+    }
+    const double k = num_samples;
+    katana::GReduceMax<double> max_bernstein;
+    katana::do_all(
+        katana::iterate(graph),
+        [&](LevelGNode v) {
+          double mean = graph_data[v].bc / (n - 1) / k;
+          double variance =
+              std::max(0.0, (squares[v] - k * mean * mean) / (k - 1));
+          max_bernstein.update(
+              std::sqrt(2 * variance * log_bernstein / k) +
+              7 * log_bernstein / (3 * (k - 1)));
+        },
+        katana::no_stats(), katana::loopname("BernsteinBound"));
+    double bernstein_bound = max_bernstein.reduce();
+    if (checkpoint == max_samples) {
+      error_bound = std::min(error_bound, bernstein_bound);
+      break;
+    }
+    if (bernstein_bound <= epsilon) {
+      error_bound = bernstein_bound;
+      break;
+    }
+  }
+
+  katana::ReportStatSingle(
+      "BetweennessCentrality", "SampledSources", num_samples);
+  katana::ReportStatSingle("BetweennessCentrality", "ErrorBound", error_bound);
+
+  // Scale the sum of the dependencies on the sampled sources to an estimate
+  // of the sum over all sources
+  const double scale = n / num_samples;
+  katana::do_all(
+      katana::iterate(graph),
+      [&](LevelGNode v) { graph_data[v].bc *= scale; }, katana::no_stats(),
+      katana::loopname("ScaleBC"));
+
+  return ExtractBC(pg, graph, graph_data, output_property_name, txn_ctx);
+}
+
 katana::Result<void>
 BetweennessCentralityLevel(
     katana::PropertyGraph* pg,
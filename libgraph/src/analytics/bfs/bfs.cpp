@@ -19,9 +19,13 @@
 
 #include "katana/analytics/bfs/bfs.h"
 
+#include <algorithm>
 #include <deque>
+#include <memory>
 #include <type_traits>
 
+#include <arrow/api.h>
+
 #include "katana/DynamicBitset.h"
 #include "katana/ErrorCode.h"
 #include "katana/Result.h"
@@ -53,6 +57,8 @@ using Dist = BfsImplementation::Dist;
 using BiDirGraphView = katana::TypedPropertyGraphView<
     katana::PropertyGraphViews::BiDirectional, std::tuple<BfsNodeParent>,
     std::tuple<>>;
+using MultiSourceView = katana::TypedPropertyGraphView<
+    katana::PropertyGraphViews::BiDirectional, std::tuple<>, std::tuple<>>;
 
 constexpr unsigned kChunkSize = 256U;
 
@@ -367,6 +373,217 @@ ComputeParentFromDistance(
       katana::loopname(std::string("ComputeParentFromDistance").c_str()));
 }
 
+/// A set of the sources of a batch of MultiSourceBfs, one bit per source.
+/// Operations are loops over a fixed number of words, which the compiler
+/// turns into vector instructions.
+template <size_t kWords>
+struct alignas(sizeof(uint64_t) * kWords) SourceSet {
+  uint64_t words[kWords];
+
+  bool Any() const {
+    uint64_t any = 0;
+    for (size_t i = 0; i < kWords; ++i) {
+      any |= words[i];
+    }
+    return any != 0;
+  }
+
+  /// The sources of other that are not in this set
+  SourceSet Missing(const SourceSet& other) const {
+    SourceSet missing;
+    for (size_t i = 0; i < kWords; ++i) {
+      missing.words[i] = other.words[i] & ~words[i];
+    }
+    return missing;
+  }
+
+  SourceSet& operator|=(const SourceSet& other) {
+    for (size_t i = 0; i < kWords; ++i) {
+      words[i] |= other.words[i];
+    }
+    return *this;
+  }
+
+  void AtomicOr(const SourceSet& other) {
+    for (size_t i = 0; i < kWords; ++i) {
+      if (other.words[i] != 0) {
+        __sync_fetch_and_or(&words[i], other.words[i]);
+      }
+    }
+  }
+
+  void Add(size_t source) { words[source / 64] |= uint64_t{1} << source % 64; }
+
+  template <typename F>
+  void ForEach(const F& fn) const {
+    for (size_t i = 0; i < kWords; ++i) {
+      for (uint64_t word = words[i]; word != 0; word &= word - 1) {
+        fn(i * 64 + __builtin_ctzll(word));
+      }
+    }
+  }
+};
+
+/// Run a BFS from each of sources[0, num_sources) at once, writing the
+/// distance of node n from sources[i] to distances[n * num_lanes + lane + i]
+template <size_t kWords>
+void
+MultiSourceBfsBatch(
+    const MultiSourceView& graph, const GNode* sources, size_t num_sources,
+    size_t lane, size_t num_lanes, uint32_t* distances, const uint32_t alpha,
+    const uint32_t beta) {
+  using Set = SourceSet<kWords>;
+  using Cont = katana::InsertBag<GNode>;
+  using Loop = katana::DoAll;
+
+  KATANA_LOG_DEBUG_ASSERT(num_sources <= 64 * kWords);
+
+  Loop loop;
+
+  uint32_t num_nodes = graph.NumNodes();
+  uint64_t num_edges = graph.NumEdges();
+
+  // seen: sources that reached the node; visit: sources that reached it in
+  // the previous level; visit_next: sources that reach it in this level
+  katana::NUMAArray<Set> seen;
+  katana::NUMAArray<Set> visit;
+  katana::NUMAArray<Set> visit_next;
+  seen.allocateBlocked(num_nodes);
+  visit.allocateBlocked(num_nodes);
+  visit_next.allocateBlocked(num_nodes);
+  katana::ParallelSTL::fill(seen.begin(), seen.end(), Set{});
+  katana::ParallelSTL::fill(visit.begin(), visit.end(), Set{});
+  katana::ParallelSTL::fill(visit_next.begin(), visit_next.end(), Set{});
+
+  katana::DynamicBitset front_bitset;
+  katana::DynamicBitset next_bitset;
+  front_bitset.resize(num_nodes);
+  next_bitset.resize(num_nodes);
+
+  auto frontier = std::make_unique<Cont>();
+  auto next_frontier = std::make_unique<Cont>();
+
+  Set all{};
+  uint64_t scout_count = 0;
+  for (size_t i = 0; i < num_sources; ++i) {
+    GNode source = sources[i];
+    all.Add(i);
+    seen[source].Add(i);
+    visit[source].Add(i);
+    distances[source * num_lanes + lane + i] = 0;
+    if (!front_bitset.set(source)) {
+      frontier->push(source);
+      scout_count += graph.OutDegree(source);
+    }
+  }
+  front_bitset.reset();
+
+  uint64_t frontier_size = num_sources;
+  bool pull = false;
+  for (uint32_t level = 1; !frontier->empty(); ++level) {
+    if (!pull && scout_count > num_edges / alpha) {
+      pull = true;
+    } else if (pull && frontier_size < num_nodes / beta) {
+      pull = false;
+    }
+
+    if (pull) {
+      WlToBitset(*frontier, &front_bitset);
+      loop(
+          katana::iterate(graph),
+          [&](const GNode& dst) {
+            if (!seen[dst].Missing(all).Any()) {
+              return;
+            }
+            Set found{};
+            for (auto e : graph.InEdges(dst)) {
+              auto src = graph.InEdgeSrc(e);
+              if (front_bitset.test(src)) {
+                found |= visit[src];
+              }
+            }
+            found = seen[dst].Missing(found);
+            if (found.Any()) {
+              visit_next[dst] = found;
+              next_bitset.set(dst);
+            }
+          },
+          katana::steal(), katana::chunk_size<kChunkSize>(),
+          katana::loopname("MultiSourceBfs-pull"));
+      front_bitset.reset();
+      BitsetToWl(graph, next_bitset, next_frontier.get());
+    } else {
+      loop(
+          katana::iterate(*frontier),
+          [&](const GNode& src) {
+            const Set& src_visit = visit[src];
+            for (auto e : graph.OutEdges(src)) {
+              auto dst = graph.OutEdgeDst(e);
+              Set found = seen[dst].Missing(src_visit);
+              if (found.Any()) {
+                visit_next[dst].AtomicOr(found);
+                if (!next_bitset.set(dst)) {
+                  next_frontier->push(dst);
+                }
+              }
+            }
+          },
+          katana::steal(), katana::chunk_size<kChunkSize>(),
+          katana::loopname("MultiSourceBfs-push"));
+    }
+
+    loop(
+        katana::iterate(*frontier),
+        [&](const GNode& src) { visit[src] = Set{}; }, katana::no_stats());
+
+    katana::GAccumulator<uint64_t> next_scout_count;
+    katana::GAccumulator<uint64_t> next_frontier_size;
+    loop(
+        katana::iterate(*next_frontier),
+        [&](const GNode& dst) {
+          Set found = visit_next[dst];
+          visit_next[dst] = Set{};
+          seen[dst] |= found;
+          visit[dst] = found;
+          next_bitset.reset(dst);
+          found.ForEach([&](size_t i) {
+            distances[dst * num_lanes + lane + i] = level;
+          });
+          next_scout_count += graph.OutDegree(dst);
+          next_frontier_size += 1;
+        },
+        katana::steal(), katana::chunk_size<kChunkSize>(),
+        katana::loopname("MultiSourceBfs-visit"));
+    scout_count = next_scout_count.reduce();
+    frontier_size = next_frontier_size.reduce();
+
+    std::swap(frontier, next_frontier);
+    next_frontier->clear();
+  }
+}
+
+void
+MultiSourceBfsImpl(
+    const MultiSourceView& graph, const std::vector<GNode>& sources,
+    uint32_t* distances, BfsPlan algo) {
+  constexpr size_t kMaxBatchSize = 512;
+  for (size_t lane = 0; lane < sources.size(); lane += kMaxBatchSize) {
+    size_t num_sources = std::min(kMaxBatchSize, sources.size() - lane);
+    auto run = [&](auto batch_words) {
+      MultiSourceBfsBatch<decltype(batch_words)::value>(
+          graph, &sources[lane], num_sources, lane, sources.size(), distances,
+          algo.alpha(), algo.beta());
+    };
+    if (num_sources <= 64) {
+      run(std::integral_constant<size_t, 1>());
+    } else if (num_sources <= 256) {
+      run(std::integral_constant<size_t, 4>());
+    } else {
+      run(std::integral_constant<size_t, 8>());
+    }
+  }
+}
+
 katana::Result<void>
 RunAlgo(
     BfsPlan algo, Graph* graph, const BiDirGraphView& bidir_view,
@@ -474,6 +691,54 @@ katana::analytics::Bfs(
   return BfsImpl(&graph, bidir_view, start_node, algo);
 }
 
+katana::Result<void>
+katana::analytics::MultiSourceBfs(
+    PropertyGraph* pg, const std::vector<uint32_t>& sources,
+    const std::string& output_property_name, katana::TxnContext* txn_ctx,
+    BfsPlan algo) {
+  if (algo.algorithm() != BfsPlan::kSynchronousDirectOpt) {
+    return KATANA_ERROR(
+        katana::ErrorCode::NotImplemented, "Unsupported algorithm: {}",
+        algo.algorithm());
+  }
+  if (sources.empty()) {
+    return KATANA_ERROR(katana::ErrorCode::InvalidArgument, "no sources");
+  }
+  for (GNode source : sources) {
+    if (source >= pg->NumNodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "source {} is not in a graph of {} nodes", source, pg->NumNodes());
+    }
+  }
+
+  auto graph = KATANA_CHECKED(MultiSourceView::Make(pg));
+
+  // The distances are computed in place in the buffer of the output property
+  size_t num_values = graph.NumNodes() * sources.size();
+  std::shared_ptr<arrow::Buffer> buffer =
+      KATANA_CHECKED(arrow::AllocateBuffer(num_values * sizeof(uint32_t)));
+  auto* distances = reinterpret_cast<uint32_t*>(buffer->mutable_data());
+  katana::ParallelSTL::fill(
+      distances, distances + num_values, kMultiSourceBfsUnreached);
+
+  katana::StatTimer exec_time("MultiSourceBFS");
+  exec_time.start();
+  MultiSourceBfsImpl(graph, sources, distances, algo);
+  exec_time.stop();
+
+  auto distance_values =
+      std::make_shared<arrow::UInt32Array>(num_values, std::move(buffer));
+  auto distance_lists = KATANA_CHECKED(arrow::FixedSizeListArray::FromArrays(
+      distance_values, static_cast<int32_t>(sources.size())));
+  auto table = arrow::Table::Make(
+      arrow::schema(
+          {arrow::field(output_property_name, distance_lists->type())}),
+      {distance_lists});
+
+  return pg->AddNodeProperties(table, txn_ctx);
+}
+
 template <typename LevelVec>
 void
 ComputeLevels(
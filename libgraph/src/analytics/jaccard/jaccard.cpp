@@ -19,6 +19,10 @@
 
 #include "katana/analytics/jaccard/jaccard.h"
 
+#include <algorithm>
+#include <vector>
+
+#include "katana/SortedIntersection.h"
 #include "katana/Statistics.h"
 #include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/Utils.h"
@@ -36,61 +40,42 @@ namespace {
 
 struct IntersectWithSortedEdgeList {
 private:
-  const GNode base_;
   const Graph& graph_;
+  const GNode* base_dests_;
+  size_t base_size_;
 
 public:
   IntersectWithSortedEdgeList(const Graph& graph, GNode base)
-      : base_(base), graph_(graph) {}
+      : graph_(graph),
+        base_dests_(graph.DestData() + *graph.OutEdges(base).begin()),
+        base_size_(graph.OutDegree(base)) {}
 
   uint32_t operator()(GNode n2) {
-    uint32_t intersection_size = 0;
-    // Iterate over the edges of both n2 and base in sync, based on the
-    // assumption that edges lists are sorted.
-    auto edges_n2_iter = graph_.OutEdges(n2).begin();
-    auto edges_n2_end = graph_.OutEdges(n2).end();
-    auto edges_base_iter = graph_.OutEdges(base_).begin();
-    auto edges_base_end = graph_.OutEdges(base_).end();
-    while (edges_n2_iter != edges_n2_end && edges_base_iter != edges_base_end) {
-      auto edge_n2_dst = graph_.OutEdgeDst(*edges_n2_iter);
-      auto edge_base_dst = graph_.OutEdgeDst(*edges_base_iter);
-      if (edge_n2_dst == edge_base_dst) {
-        intersection_size++;
-        edges_n2_iter++;
-        edges_base_iter++;
-      } else if (edge_n2_dst > edge_base_dst) {
-        edges_base_iter++;
-      } else if (edge_n2_dst < edge_base_dst) {
-        edges_n2_iter++;
-      }
-    }
-    return intersection_size;
+    return katana::SortedIntersectionSize(
+        base_dests_, base_size_,
+        graph_.DestData() + *graph_.OutEdges(n2).begin(),
+        graph_.OutDegree(n2));
   }
 };
 
 struct IntersectWithUnsortedEdgeList {
 private:
-  std::unordered_set<GNode> base_neighbors;
   const Graph& graph_;
+  // Collect all the neighbors of the base node into a bitmap, the base node
+  // is probed against every other node.
+  katana::IntersectionBitmap base_neighbors_;
 
 public:
   IntersectWithUnsortedEdgeList(const Graph& graph, GNode base)
-      : graph_(graph) {
-    // Collect all the neighbors of the base node into a hash set.
-    for (const auto& e : graph.OutEdges(base)) {
-      auto dest = graph.OutEdgeDst(e);
-      base_neighbors.emplace(dest);
-    }
-  }
+      : graph_(graph),
+        base_neighbors_(
+            graph.DestData() + *graph.OutEdges(base).begin(),
+            graph.OutDegree(base), graph.NumNodes()) {}
 
   uint32_t operator()(GNode n2) {
-    uint32_t intersection_size = 0;
-    for (const auto& e : graph_.OutEdges(n2)) {
-      auto neighbor = graph_.OutEdgeDst(e);
-      if (base_neighbors.count(neighbor) > 0)
-        intersection_size++;
-    }
-    return intersection_size;
+    return base_neighbors_.IntersectionSize(
+        graph_.DestData() + *graph_.OutEdges(n2).begin(),
+        graph_.OutDegree(n2));
   }
 };
 
@@ -165,6 +150,185 @@ katana::analytics::Jaccard(
   return r;
 }
 
+namespace {
+
+using BiDirGraph = katana::PropertyGraphViews::BiDirectional;
+
+struct SimilarNode {
+  double similarity;
+  GNode node;
+
+  /// Orders by similarity, then by node id, so that the "largest" entry is
+  /// the one to report first
+  bool operator<(const SimilarNode& other) const {
+    if (similarity != other.similarity) {
+      return similarity < other.similarity;
+    }
+    return node > other.node;
+  }
+};
+
+/// Scratch space reused by each thread across queries. counts is indexed by
+/// node and is all zero between queries; candidates lists the nodes whose
+/// count is nonzero.
+struct TopKScratch {
+  std::vector<uint32_t> counts;
+  std::vector<GNode> candidates;
+  std::vector<SimilarNode> heap;
+};
+
+/// Top k similar nodes of query. A node w shares a neighbor u with query iff
+/// w is an in-neighbor of some out-neighbor u of query, and the number of
+/// such 2-hop paths from query to w is the size of the intersection of their
+/// neighborhoods. The paths are counted per node in a dense array, so the
+/// work is linear in the number of 2-hop paths plus log k per candidate.
+void
+TopKForQuery(
+    const BiDirGraph& graph, GNode query, uint32_t k, TopKScratch* scratch,
+    std::vector<SimilarNode>* out) {
+  auto& counts = scratch->counts;
+  auto& candidates = scratch->candidates;
+  auto& heap = scratch->heap;
+  if (counts.size() < graph.NumNodes()) {
+    counts.resize(graph.NumNodes(), 0);
+  }
+  candidates.clear();
+  heap.clear();
+
+  for (auto e : graph.OutEdges(query)) {
+    auto u = graph.OutEdgeDst(e);
+    for (auto in_e : graph.InEdges(u)) {
+      auto w = graph.InEdgeSrc(in_e);
+      if (w != query && counts[w]++ == 0) {
+        candidates.emplace_back(w);
+      }
+    }
+  }
+
+  const uint32_t query_size = graph.OutDegree(query);
+  // Min-heap on SimilarNode order holding the best k seen so far
+  auto worse = [](const SimilarNode& a, const SimilarNode& b) { return b < a; };
+  for (auto w : candidates) {
+    const uint32_t intersection_size = counts[w];
+    counts[w] = 0;
+    const uint32_t union_size =
+        query_size + graph.OutDegree(w) - intersection_size;
+    SimilarNode candidate{
+        static_cast<double>(intersection_size) / union_size, w};
+
+    if (heap.size() < k) {
+      heap.emplace_back(candidate);
+      std::push_heap(heap.begin(), heap.end(), worse);
+    } else if (heap.front() < candidate) {
+      std::pop_heap(heap.begin(), heap.end(), worse);
+      heap.back() = candidate;
+      std::push_heap(heap.begin(), heap.end(), worse);
+    }
+  }
+
+  // sort_heap with the inverted comparator leaves the best entry first
+  std::sort_heap(heap.begin(), heap.end(), worse);
+  out->assign(heap.begin(), heap.end());
+}
+
+/// Arrow array holding \p values
+template <typename Builder, typename T>
+katana::Result<std::shared_ptr<arrow::Array>>
+MakeColumn(const std::vector<T>& values) {
+  Builder builder;
+  if (auto st = builder.AppendValues(values); !st.ok()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::ArrowError, "appending JaccardTopK column: {}", st);
+  }
+  std::shared_ptr<arrow::Array> array;
+  if (auto st = builder.Finish(&array); !st.ok()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::ArrowError, "finishing JaccardTopK column: {}", st);
+  }
+  return array;
+}
+
+}  // namespace
+
+katana::Result<std::shared_ptr<arrow::Table>>
+katana::analytics::JaccardTopK(
+    PropertyGraph* pg, const std::vector<uint32_t>& query_nodes, uint32_t k) {
+  if (k == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "k must be greater than 0");
+  }
+  for (auto q : query_nodes) {
+    if (q >= pg->NumNodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument, "query node {} does not exist",
+          q);
+    }
+  }
+
+  katana::ReportPageAllocGuard page_alloc;
+
+  katana::StatTimer exec_time("JaccardTopK");
+  exec_time.start();
+
+  BiDirGraph graph = pg->BuildView<BiDirGraph>();
+
+  const size_t num_queries =
+      query_nodes.empty() ? graph.NumNodes() : query_nodes.size();
+  auto query_at = [&](size_t i) {
+    return query_nodes.empty() ? static_cast<GNode>(i) : query_nodes[i];
+  };
+
+  std::vector<std::vector<SimilarNode>> results(num_queries);
+  katana::PerThreadStorage<TopKScratch> scratch;
+
+  katana::do_all(
+      katana::iterate(size_t{0}, num_queries),
+      [&](size_t i) {
+        TopKForQuery(graph, query_at(i), k, scratch.getLocal(), &results[i]);
+      },
+      katana::steal(), katana::loopname("JaccardTopK"));
+
+  // Flatten the per query results into an edge list
+  std::vector<uint64_t> offsets(num_queries + 1, 0);
+  for (size_t i = 0; i < num_queries; ++i) {
+    offsets[i + 1] = offsets[i] + results[i].size();
+  }
+  const uint64_t num_rows = offsets[num_queries];
+
+  std::vector<uint32_t> sources(num_rows);
+  std::vector<uint32_t> destinations(num_rows);
+  std::vector<double> similarities(num_rows);
+  katana::do_all(
+      katana::iterate(size_t{0}, num_queries),
+      [&](size_t i) {
+        uint64_t row = offsets[i];
+        for (const auto& r : results[i]) {
+          sources[row] = query_at(i);
+          destinations[row] = r.node;
+          similarities[row] = r.similarity;
+          ++row;
+        }
+      },
+      katana::no_stats());
+
+  auto source_array =
+      KATANA_CHECKED(MakeColumn<arrow::UInt32Builder>(sources));
+  auto destination_array =
+      KATANA_CHECKED(MakeColumn<arrow::UInt32Builder>(destinations));
+  auto similarity_array =
+      KATANA_CHECKED(MakeColumn<arrow::DoubleBuilder>(similarities));
+
+  exec_time.stop();
+
+  return arrow::Table::Make(
+      arrow::schema({
+          arrow::field("source", arrow::uint32()),
+          arrow::field("destination", arrow::uint32()),
+          arrow::field("similarity", arrow::float64()),
+      }),
+      {source_array, destination_array, similarity_array});
+}
+
 constexpr static const double EPSILON = 1e-6;
 
 katana::Result<void>
@@ -19,7 +19,10 @@
 
 #include "katana/analytics/k_core/k_core.h"
 
+#include <limits>
+
 #include "katana/ArrowRandomAccessBuilder.h"
+#include "katana/DynamicBitset.h"
 #include "katana/Statistics.h"
 #include "katana/TypedPropertyGraph.h"
 
@@ -36,6 +39,8 @@ struct KCoreNodeCurrentDegree : public katana::AtomicPODProperty<uint32_t> {};
 
 struct KCoreNodeAlive : public katana::PODProperty<uint32_t> {};
 
+struct KCoreNodeNumber : public katana::PODProperty<uint32_t> {};
+
 using NodeData = std::tuple<KCoreNodeCurrentDegree>;
 using EdgeData = std::tuple<>;
 
@@ -169,6 +174,195 @@ AsyncCascadeKCore(GraphTy* graph, uint32_t k_core_number) {
       katana::loopname("KCore Asynchronous"));
 }
 
+/**
+ * Buckets of nodes by current degree, in the style of Julienne: only the
+ * kOpenBuckets degrees starting at base_ have a bucket of their own, and
+ * nodes of higher degree share an overflow bucket that is redistributed once
+ * the open buckets are used up. Nodes are added to a bucket again whenever
+ * their degree drops, so buckets hold stale entries, which are filtered out
+ * when the bucket is taken.
+ */
+template <typename GraphTy>
+class DegreeBuckets {
+public:
+  using GNode = typename GraphTy::Node;
+
+  static constexpr uint32_t kOpenBuckets = 128;
+
+  explicit DegreeBuckets(const GraphTy& graph)
+      : graph_(graph),
+        open_(kOpenBuckets),
+        overflow_(std::make_unique<katana::InsertBag<GNode>>()) {}
+
+  /// Add node to the bucket of its current degree. May be called in
+  /// parallel, but the degree must be at least that of the last taken bucket.
+  void Insert(const GNode& node) {
+    uint32_t degree = CurrentDegree(node);
+    KATANA_LOG_DEBUG_ASSERT(degree >= base_);
+    if (degree - base_ < kOpenBuckets) {
+      open_[degree - base_].emplace(node);
+    } else {
+      overflow_->emplace(node);
+    }
+  }
+
+  /**
+   * Move the nodes of the lowest nonempty bucket that have not been removed
+   * yet into frontier and mark them removed.
+   *
+   * @param level Set to the degree of the bucket taken
+   * @param frontier Empty worklist to be filled with the nodes taken
+   * @param removed Nodes that have been peeled already
+   * @returns false if there are no nodes left
+   */
+  bool TakeNext(
+      uint32_t* level, katana::InsertBag<GNode>* frontier,
+      katana::DynamicBitset* removed) {
+    while (true) {
+      for (; next_ < kOpenBuckets; next_++) {
+        katana::InsertBag<GNode>& bucket = open_[next_];
+        if (bucket.empty()) {
+          continue;
+        }
+        uint32_t degree = base_ + next_;
+        katana::do_all(
+            katana::iterate(bucket),
+            [&](const GNode& node) {
+              if (CurrentDegree(node) == degree && !removed->set(node)) {
+                frontier->emplace(node);
+              }
+            },
+            katana::loopname("KCore TakeBucket"), katana::no_stats());
+        bucket.clear();
+        if (!frontier->empty()) {
+          *level = degree;
+          return true;
+        }
+      }
+
+      katana::GReduceMin<uint32_t> min_degree;
+      katana::do_all(
+          katana::iterate(*overflow_),
+          [&](const GNode& node) {
+            if (!removed->test(node)) {
+              min_degree.update(CurrentDegree(node));
+            }
+          },
+          katana::loopname("KCore MinOverflowDegree"), katana::no_stats());
+      if (min_degree.reduce() == std::numeric_limits<uint32_t>::max()) {
+        overflow_->clear();
+        return false;
+      }
+
+      base_ = min_degree.reduce();
+      next_ = 0;
+      auto old_overflow = std::make_unique<katana::InsertBag<GNode>>();
+      std::swap(old_overflow, overflow_);
+      katana::do_all(
+          katana::iterate(*old_overflow),
+          [&](const GNode& node) {
+            if (!removed->test(node)) {
+              Insert(node);
+            }
+          },
+          katana::loopname("KCore RedistributeOverflow"), katana::no_stats());
+    }
+  }
+
+private:
+  uint32_t CurrentDegree(const GNode& node) const {
+    return graph_.template GetData<KCoreNodeCurrentDegree>(node);
+  }
+
+  const GraphTy& graph_;
+  /// Degree of the first open bucket
+  uint32_t base_{0};
+  /// Index of the first open bucket that may be nonempty
+  uint32_t next_{0};
+  std::vector<katana::InsertBag<GNode>> open_;
+  std::unique_ptr<katana::InsertBag<GNode>> overflow_;
+};
+
+/**
+ * Peel the nodes of the lowest degree bucket, and the nodes whose degree
+ * drops to that level as a result, in rounds until none are left at the
+ * level; then move on to the next bucket. The core number of a node is the
+ * level at which it is peeled. The bucket updates of a round are batched:
+ * a node whose degree drops in a round is moved to a new bucket once, after
+ * the round, however many of its neighbors were peeled.
+ *
+ * @param graph Graph to operate on
+ */
+template <typename GraphTy>
+void
+BucketedKCore(GraphTy* graph) {
+  using GNode = typename GraphTy::Node;
+
+  katana::DynamicBitset removed;
+  removed.resize(graph->NumNodes());
+  katana::DynamicBitset moved;
+  moved.resize(graph->NumNodes());
+  katana::InsertBag<GNode> moved_nodes;
+
+  DegreeBuckets<GraphTy> buckets(*graph);
+  katana::do_all(
+      katana::iterate(*graph), [&](const GNode& node) { buckets.Insert(node); },
+      katana::loopname("KCore InitialBuckets"), katana::no_stats());
+
+  auto current = std::make_unique<katana::InsertBag<GNode>>();
+  auto next = std::make_unique<katana::InsertBag<GNode>>();
+  uint32_t level = 0;
+  uint32_t num_levels = 0;
+
+  while (buckets.TakeNext(&level, current.get(), &removed)) {
+    num_levels++;
+    while (!current->empty()) {
+      katana::do_all(
+          katana::iterate(*current),
+          [&](const GNode& dead_node) {
+            graph->template GetData<KCoreNodeNumber>(dead_node) = level;
+            //! Decrement degree of all neighbors still in the graph.
+            for (auto e : Edges(*graph, dead_node)) {
+              auto dest = EdgeDst(*graph, e);
+              if (removed.test(dest)) {
+                continue;
+              }
+              auto& dest_current_degree =
+                  graph->template GetData<KCoreNodeCurrentDegree>(dest);
+              uint32_t old_degree = katana::atomicSub(dest_current_degree, 1u);
+
+              if (old_degree == level + 1) {
+                //! This thread put the degree of destination down to the
+                //! level; it is peeled in the next round.
+                removed.set(dest);
+                next->emplace(dest);
+              } else if (old_degree > level + 1 && !moved.set(dest)) {
+                moved_nodes.emplace(dest);
+              }
+            }
+          },
+          katana::steal(), katana::chunk_size<KCorePlan::kChunkSize>(),
+          katana::loopname("KCore Bucketed"));
+
+      katana::do_all(
+          katana::iterate(moved_nodes),
+          [&](const GNode& node) {
+            moved.reset(node);
+            if (!removed.test(node)) {
+              buckets.Insert(node);
+            }
+          },
+          katana::loopname("KCore MoveBuckets"), katana::no_stats());
+      moved_nodes.clear();
+
+      std::swap(current, next);
+      next->clear();
+    }
+  }
+
+  katana::ReportStatSingle("KCore", "Levels", num_levels);
+}
+
 /**
  * After computation is finished, the nodes left in the core
  * are marked as alive.
@@ -176,7 +370,7 @@ AsyncCascadeKCore(GraphTy* graph, uint32_t k_core_number) {
  * @param graph Graph to operate on
  * @param k_core_number Each node in the core is expected to have degree <= k_core_number.
  */
-template <typename GraphTy>
+template <typename GraphTy, typename DegreeProperty = KCoreNodeCurrentDegree>
 katana::Result<void>
 KCoreMarkAliveNodes(GraphTy* graph, uint32_t k_core_number) {
   using GNode = typename GraphTy::Node;
@@ -184,7 +378,7 @@ KCoreMarkAliveNodes(GraphTy* graph, uint32_t k_core_number) {
       katana::iterate(*graph),
       [&](const GNode& node) {
         auto& node_current_degree =
-            graph->template GetData<KCoreNodeCurrentDegree>(node);
+            graph->template GetData<DegreeProperty>(node);
         auto& node_flag = graph->template GetData<KCoreNodeAlive>(node);
         node_flag = 1;
         if (node_current_degree < k_core_number) {
@@ -225,11 +419,83 @@ KCoreImpl(GraphTy* graph, KCorePlan algo, uint32_t k_core_number) {
   return katana::ResultSuccess();
 }
 
+template <typename GraphTy>
+static katana::Result<void>
+KCoreNumbersImpl(GraphTy* graph) {
+  size_t approxNodeData = 4 * (graph->NumNodes() + graph->NumEdges());
+  katana::EnsurePreallocated(8, approxNodeData);
+  katana::ReportPageAllocGuard page_alloc;
+
+  //! Intialization of degrees.
+  DegreeCounting(graph);
+
+  katana::StatTimer exec_time("KCore");
+  exec_time.start();
+  BucketedKCore(graph);
+  exec_time.stop();
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::analytics::KCoreNumbers(
+    katana::PropertyGraph* pg, const std::string& output_property_name,
+    katana::TxnContext* txn_ctx, const bool& is_symmetric, KCorePlan plan) {
+  if (plan.algorithm() != KCorePlan::kBucketed) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "only the bucketed algorithm computes core numbers");
+  }
+
+  katana::analytics::TemporaryPropertyGuard temporary_property{
+      pg->NodeMutablePropertyView()};
+
+  KATANA_CHECKED(
+      pg->ConstructNodeProperties<std::tuple<KCoreNodeCurrentDegree>>(
+          txn_ctx, {temporary_property.name()}));
+  KATANA_CHECKED(pg->ConstructNodeProperties<std::tuple<KCoreNodeNumber>>(
+      txn_ctx, {output_property_name}));
+
+  using NumbersNodeData = std::tuple<KCoreNodeCurrentDegree, KCoreNodeNumber>;
+  if (is_symmetric) {
+    using Graph = katana::TypedPropertyGraphView<
+        katana::PropertyGraphViews::Default, NumbersNodeData, EdgeData>;
+    Graph graph = KATANA_CHECKED(Graph::Make(
+        pg, {temporary_property.name(), output_property_name}, {}));
+
+    return KCoreNumbersImpl(&graph);
+  }
+  using Graph = katana::TypedPropertyGraphView<
+      katana::PropertyGraphViews::Undirected, NumbersNodeData, EdgeData>;
+  Graph graph = KATANA_CHECKED(
+      Graph::Make(pg, {temporary_property.name(), output_property_name}, {}));
+
+  return KCoreNumbersImpl(&graph);
+}
+
 katana::Result<void>
 katana::analytics::KCore(
     katana::PropertyGraph* pg, uint32_t k_core_number,
     const std::string& output_property_name, katana::TxnContext* txn_ctx,
     const bool& is_symmetric, KCorePlan plan) {
+  if (plan.algorithm() == KCorePlan::kBucketed) {
+    //! A node is in the k-core iff its core number is at least k.
+    katana::analytics::TemporaryPropertyGuard core_numbers{
+        pg->NodeMutablePropertyView()};
+    KATANA_CHECKED(
+        KCoreNumbers(pg, core_numbers.name(), txn_ctx, is_symmetric, plan));
+    KATANA_CHECKED(pg->ConstructNodeProperties<std::tuple<KCoreNodeAlive>>(
+        txn_ctx, {output_property_name}));
+
+    using GraphTy = katana::TypedPropertyGraph<
+        std::tuple<KCoreNodeAlive, KCoreNodeNumber>, std::tuple<>>;
+    auto graph_final = KATANA_CHECKED(
+        GraphTy::Make(pg, {output_property_name, core_numbers.name()}, {}));
+
+    return KCoreMarkAliveNodes<GraphTy, KCoreNodeNumber>(
+        &graph_final, k_core_number);
+  }
+
   katana::analytics::TemporaryPropertyGuard temporary_property{
       pg->NodeMutablePropertyView()};
 
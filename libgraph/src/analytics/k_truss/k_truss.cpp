@@ -20,6 +20,7 @@
 #include "katana/analytics/k_truss/k_truss.h"
 
 #include "katana/ArrowRandomAccessBuilder.h"
+#include "katana/SortedIntersection.h"
 #include "katana/TypedPropertyGraph.h"
 
 using namespace katana::analytics;
@@ -95,39 +96,20 @@ IsValidDegreeNoLessThanJ(const SortedGraphView& g, GNode n, unsigned int j) {
 bool
 IsSupportNoLessThanJ(
     const SortedGraphView& g, GNode src, GNode dest, unsigned int j) {
-  size_t numValidEqual = 0;
-  auto srcI = g.OutEdges(src).begin(), srcE = g.OutEdges(src).end(),
-       dstI = g.OutEdges(dest).begin(), dstE = g.OutEdges(dest).end();
-
-  while (true) {
-    //! Find the first valid edge.
-    while (srcI != srcE && (g.GetEdgeData<EdgeFlag>(*srcI) & removed)) {
-      ++srcI;
-    }
-    while (dstI != dstE && (g.GetEdgeData<EdgeFlag>(*dstI) & removed)) {
-      ++dstI;
-    }
-
-    if (srcI == srcE || dstI == dstE) {
-      return numValidEqual >= j;
-    }
-
-    //! Check for intersection.
-    auto sN = g.OutEdgeDst(*srcI), dN = g.OutEdgeDst(*dstI);
-    if (sN < dN) {
-      ++srcI;
-    } else if (dN < sN) {
-      ++dstI;
-    } else {
-      numValidEqual += 1;
-      if (numValidEqual >= j) {
-        return true;
-      }
-      ++srcI;
-      ++dstI;
-    }
+  if (j == 0) {
+    return true;
   }
 
+  size_t numValidEqual = 0;
+  katana::ForEachSortedIntersection(
+      g.OutEdges(src).begin(), g.OutEdges(src).end(), g.OutEdges(dest).begin(),
+      g.OutEdges(dest).end(), [&g](auto e) { return g.OutEdgeDst(e); },
+      [&g](auto e) { return !(g.GetEdgeData<EdgeFlag>(e) & removed); },
+      [&](auto, auto) {
+        numValidEqual += 1;
+        return numValidEqual < j;
+      });
+
   return numValidEqual >= j;
 }
 
@@ -34,7 +34,9 @@ struct GraphTypes {
       PreviousCommunityID, CurrentCommunityID, DegreeWeight<EdgeWeightType>,
       CurrentSubCommunityID, NodeWeight>;
   using EdgeData = std::tuple<EdgeWeight<EdgeWeightType>>;
-  using Graph = katana::TypedPropertyGraphView<GraphViewTy, NodeData, EdgeData>;
+  using InputGraph =
+      katana::TypedPropertyGraphView<GraphViewTy, std::tuple<>, EdgeData>;
+  using Graph = CoarsenedGraph<NodeData, EdgeWeightType>;
 };
 
 template <typename EdgeWeightType, typename GraphViewTy>
@@ -42,17 +44,25 @@ struct LeidenClusteringImplementation
     : public katana::analytics::ClusteringImplementationBase<
           typename GraphTypes<EdgeWeightType, GraphViewTy>::Graph,
           EdgeWeightType, LeidenCommunityType<EdgeWeightType>> {
-  using NodeData = typename GraphTypes<EdgeWeightType, GraphViewTy>::NodeData;
-  using EdgeData = typename GraphTypes<EdgeWeightType, GraphViewTy>::EdgeData;
   using CommTy = LeidenCommunityType<EdgeWeightType>;
   using CommunityArray = katana::NUMAArray<CommTy>;
 
+  using InputGraph =
+      typename GraphTypes<EdgeWeightType, GraphViewTy>::InputGraph;
   using Graph = typename GraphTypes<EdgeWeightType, GraphViewTy>::Graph;
   using GNode = typename Graph::Node;
 
   using Base = katana::analytics::ClusteringImplementationBase<
       Graph, EdgeWeightType, CommTy>;
 
+  // Coarsened levels used to be property graphs seen through GraphViewTy. They
+  // hold both directions of every edge, so an undirected view of them counted
+  // each edge twice. Modularity does not depend on that scale, but refinement
+  // truncates degree weights to integers, so keep it to cluster as before.
+  constexpr static EdgeWeightType kCoarsenedWeightScale =
+      std::is_same_v<GraphViewTy, katana::PropertyGraphViews::Undirected> ? 2
+                                                                          : 1;
+
   katana::Result<double> LeidenWithoutLockingDoAll(
       Graph* graph, double lower, double modularity_threshold_per_round,
       uint32_t& iter, [[maybe_unused]] double resolution) {
@@ -98,6 +108,7 @@ struct LeidenClusteringImplementation
             c_info[n_data_curr_comm_id].degree_wt, n_data_degree_wt);
       });
     }
+    katana::PerThreadStorage<NeighborClusterMap<EdgeWeightType>> cluster_maps;
     katana::StatTimer TimerClusteringWhile("Timer_Clustering_While");
     TimerClusteringWhile.start();
     while (true) {
@@ -114,21 +125,17 @@ struct LeidenClusteringImplementation
 
             uint64_t degree = Degree(*graph, n);
             uint64_t local_target = Base::UNASSIGNED;
-            std::map<uint64_t, uint64_t>
-                cluster_local_map;  // Map each neighbor's cluster to local number:
-                                    // Community --> Index
-            std::vector<EdgeWeightType>
-                counter;  // Number of edges to each unique cluster
+            NeighborClusterMap<EdgeWeightType>& clusters =
+                *cluster_maps.getLocal();
             EdgeWeightType self_loop_wt = 0;
 
             if (degree > 0) {
               Base::template FindNeighboringClusters<EdgeWeightType>(
-                  *graph, n, cluster_local_map, counter, self_loop_wt);
+                  *graph, n, &clusters, self_loop_wt);
               // Find the max gain in modularity
               local_target = Base::MaxModularityWithoutSwaps(
-                  cluster_local_map, counter, self_loop_wt, c_info,
-                  n_data_node_wt, n_data_curr_comm_id,
-                  constant_for_second_term);
+                  clusters, self_loop_wt, c_info, n_data_node_wt,
+                  n_data_curr_comm_id, constant_for_second_term);
             } else {
               local_target = Base::UNASSIGNED;
             }
@@ -255,6 +262,7 @@ struct LeidenClusteringImplementation
       c_update_subtract[n].node_wt = 0;
     });
 
+    katana::PerThreadStorage<NeighborClusterMap<EdgeWeightType>> cluster_maps;
     katana::StatTimer TimerClusteringWhile("Timer_Clustering_While");
     TimerClusteringWhile.start();
 
@@ -275,21 +283,17 @@ struct LeidenClusteringImplementation
 
               uint64_t degree = Degree(*graph, n);
 
-              std::map<uint64_t, uint64_t>
-                  cluster_local_map;  // Map each neighbor's cluster to local number:
-                                      // Community --> Index
-              std::vector<EdgeWeightType>
-                  counter;  // Number of edges to each unique cluster
+              NeighborClusterMap<EdgeWeightType>& clusters =
+                  *cluster_maps.getLocal();
               EdgeWeightType self_loop_wt = 0;
 
               if (degree > 0) {
                 Base::template FindNeighboringClusters<EdgeWeightType>(
-                    *graph, n, cluster_local_map, counter, self_loop_wt);
+                    *graph, n, &clusters, self_loop_wt);
                 // Find the max gain in modularity
                 local_target[n] = Base::MaxModularityWithoutSwaps(
-                    cluster_local_map, counter, self_loop_wt, c_info,
-                    n_data_degree_wt, n_data_curr_comm_id,
-                    constant_for_second_term);
+                    clusters, self_loop_wt, c_info, n_data_degree_wt,
+                    n_data_curr_comm_id, constant_for_second_term);
 
               } else {
                 local_target[n] = 0;
@@ -386,29 +390,24 @@ struct LeidenClusteringImplementation
 public:
   katana::Result<void> LeidenClustering(
       katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
-      const std::vector<std::string>& temp_node_property_names,
-      katana::NUMAArray<uint64_t>& clusters_orig, LeidenClusteringPlan plan,
-      katana::TxnContext* txn_ctx) {
+      katana::NUMAArray<uint64_t>& clusters_orig, LeidenClusteringPlan plan) {
     katana::StatTimer TimerTotal("Timer_Leiden_Total");
     TimerTotal.start();
-    TemporaryPropertyGuard temp_edge_property{pg->EdgeMutablePropertyView()};
-    std::vector<std::string> temp_edge_property_names = {
-        temp_edge_property.name()};
+    auto input_graph = KATANA_CHECKED(
+        InputGraph::Make(pg, {}, {edge_weight_property_name}));
 
     /*
-     * Construct temp property graph. This graph gets coarsened as the
-     * computation proceeds.
+     * Copy the input graph. The copy gets coarsened as the computation
+     * proceeds.
      */
-    std::unique_ptr<katana::PropertyGraph> pg_mutable;
-
-    Graph graph_curr = KATANA_CHECKED(
-        Graph::Make(pg, temp_node_property_names, {edge_weight_property_name}));
+    Graph graph_curr = Graph::Copy(input_graph);
 
     /*
     * Vertex following optimization
     */
     if (plan.enable_vf()) {
-      Base::VertexFollowing(&graph_curr);  // Find nodes that follow other nodes
+      // Find nodes that follow other nodes
+      Base::VertexFollowing(input_graph, &graph_curr);
 
       uint64_t num_unique_clusters =
           Base::template RenumberClustersContiguously<CurrentCommunityID>(
@@ -421,18 +420,9 @@ public:
         clusters_orig[n] = graph_curr.template GetData<CurrentCommunityID>(n);
       });
 
-      auto pg_empty = std::make_unique<katana::PropertyGraph>();
-
       // Build new graph to remove the isolated nodes
-      auto coarsened_graph_result = Base::template GraphCoarsening<
-          NodeData, EdgeData, EdgeWeightType, CurrentCommunityID>(
-          graph_curr, pg_empty.get(), num_unique_clusters,
-          temp_node_property_names, temp_edge_property_names, txn_ctx);
-      if (!coarsened_graph_result) {
-        return coarsened_graph_result.error();
-      }
-
-      pg_mutable = std::move(coarsened_graph_result.value());
+      graph_curr = Base::template GraphCoarsening<CurrentCommunityID>(
+          graph_curr, num_unique_clusters, kCoarsenedWeightScale);
 
     } else {
       /*
@@ -441,23 +431,12 @@ public:
       katana::do_all(katana::iterate(graph_curr), [&](GNode n) {
         clusters_orig[n] = Base::UNASSIGNED;
       });
-
-      auto pg_dup = KATANA_CHECKED(Base::DuplicateGraphWithSameTopo(*pg));
-      KATANA_CHECKED(Base::template CopyEdgeProperty<GraphViewTy>(
-          pg, pg_dup.get(), temp_edge_property_names[0], txn_ctx));
-      KATANA_CHECKED(
-          pg_dup->template ConstructNodeProperties<NodeData>(txn_ctx));
-
-      pg_mutable = std::move(pg_dup);
     }
 
-    KATANA_LOG_ASSERT(pg_mutable);
-
     double prev_mod = -1;  // Previous modularity
     double curr_mod = -1;  // Current modularity
     uint32_t phase = 0;
 
-    std::unique_ptr<katana::PropertyGraph> pg_curr = std::move(pg_mutable);
     uint32_t iter = 0;
     uint64_t num_nodes_orig = clusters_orig.size();
 
@@ -465,8 +444,6 @@ public:
       iter++;
       phase++;
 
-      graph_curr = KATANA_CHECKED(Graph::Make(pg_curr.get()));
-
       if (iter == 1) {
         /* Initialization each node to its own cluster */
         katana::do_all(katana::iterate(graph_curr), [&](GNode n) {
@@ -556,25 +533,18 @@ public:
           katana::atomicAdd(cluster_node_wt[n_curr_sub_comm], n_node_wt);
         });
 
-        auto coarsened_graph_result = Base::template GraphCoarsening<
-            NodeData, EdgeData, EdgeWeightType, CurrentSubCommunityID>(
-            graph_curr, pg_curr.get(), num_unique_subclusters,
-            temp_node_property_names, temp_edge_property_names, txn_ctx);
-        if (!coarsened_graph_result) {
-          return coarsened_graph_result.error();
-        }
-        pg_curr = std::move(coarsened_graph_result.value());
+        graph_curr = Base::template GraphCoarsening<CurrentSubCommunityID>(
+            graph_curr, num_unique_subclusters, kCoarsenedWeightScale);
 
         prev_mod = curr_mod;
 
         /**
        * Assign cluster id from previous iteration
        */
-        Graph graph_curr_tmp = KATANA_CHECKED(Graph::Make(pg_curr.get()));
-        katana::do_all(katana::iterate(graph_curr_tmp), [&](GNode n) {
-          graph_curr_tmp.template GetData<CurrentCommunityID>(n) =
+        katana::do_all(katana::iterate(graph_curr), [&](GNode n) {
+          graph_curr.template GetData<CurrentCommunityID>(n) =
               original_comm_ass[n];
-          graph_curr_tmp.template GetData<NodeWeight>(n) = cluster_node_wt[n];
+          graph_curr.template GetData<NodeWeight>(n) = cluster_node_wt[n];
         });
 
         original_comm_ass.deallocate();
@@ -594,33 +564,30 @@ public:
             &graph_curr);
 
     katana::do_all(katana::iterate((uint64_t)0, num_nodes_orig), [&](GNode n) {
-      clusters_orig[n] =
-          graph_curr.template GetData<CurrentCommunityID>(clusters_orig[n]);
+      if (clusters_orig[n] != Base::UNASSIGNED) {
+        clusters_orig[n] =
+            graph_curr.template GetData<CurrentCommunityID>(clusters_orig[n]);
+      }
     });
 
-    auto coarsened_graph_result = Base::template GraphCoarsening<
-        NodeData, EdgeData, EdgeWeightType, CurrentCommunityID>(
-        graph_curr, pg_curr.get(), num_unique_clusters,
-        temp_node_property_names, temp_edge_property_names, txn_ctx);
-    if (!coarsened_graph_result) {
-      return coarsened_graph_result.error();
-    }
-    pg_curr = std::move(coarsened_graph_result.value());
+    graph_curr = Base::template GraphCoarsening<CurrentCommunityID>(
+        graph_curr, num_unique_clusters, kCoarsenedWeightScale);
 
     prev_mod = curr_mod;
 
-    Graph graph_curr_tmp = KATANA_CHECKED(Graph::Make(pg_curr.get()));
-    katana::do_all(katana::iterate(graph_curr_tmp), [&](GNode n) {
-      graph_curr_tmp.template GetData<CurrentCommunityID>(n) = n;
+    katana::do_all(katana::iterate(graph_curr), [&](GNode n) {
+      graph_curr.template GetData<CurrentCommunityID>(n) = n;
     });
 
     curr_mod = KATANA_CHECKED(LeidenDeterministic(
-        &graph_curr_tmp, curr_mod, plan.modularity_threshold_per_round(), iter,
+        &graph_curr, curr_mod, plan.modularity_threshold_per_round(), iter,
         plan.resolution()));
 
     katana::do_all(katana::iterate((uint64_t)0, num_nodes_orig), [&](GNode n) {
-      clusters_orig[n] =
-          graph_curr_tmp.template GetData<CurrentCommunityID>(clusters_orig[n]);
+      if (clusters_orig[n] != Base::UNASSIGNED) {
+        clusters_orig[n] =
+            graph_curr.template GetData<CurrentCommunityID>(clusters_orig[n]);
+      }
     });
 
     TimerTotal.stop();
@@ -638,17 +605,6 @@ LeidenClusteringWithWrap(
       std::is_integral_v<EdgeWeightType> ||
       std::is_floating_point_v<EdgeWeightType>);
 
-  std::vector<TemporaryPropertyGuard> temp_node_properties(5);
-  std::generate_n(
-      temp_node_properties.begin(), temp_node_properties.size(),
-      [&]() { return TemporaryPropertyGuard{pg->NodeMutablePropertyView()}; });
-  std::vector<std::string> temp_node_property_names(
-      temp_node_properties.size());
-  std::transform(
-      temp_node_properties.begin(), temp_node_properties.end(),
-      temp_node_property_names.begin(),
-      [](const TemporaryPropertyGuard& p) { return p.name(); });
-
   /*
    * To keep track of communities for nodes in the original graph.
    * Community will be set to UNASSINED for isolated nodes
@@ -657,29 +613,17 @@ LeidenClusteringWithWrap(
   clusters_orig.allocateBlocked(pg->NumNodes());
 
   if (is_symmetric) {
-    using Impl = LeidenClusteringImplementation<
-        EdgeWeightType, katana::PropertyGraphViews::Default>;
-    KATANA_CHECKED(pg->ConstructNodeProperties<typename Impl::NodeData>(
-        txn_ctx, temp_node_property_names));
-
     LeidenClusteringImplementation<
         EdgeWeightType, katana::PropertyGraphViews::Default>
         impl{};
     KATANA_CHECKED(impl.LeidenClustering(
-        pg, edge_weight_property_name, temp_node_property_names, clusters_orig,
-        plan, txn_ctx));
+        pg, edge_weight_property_name, clusters_orig, plan));
   } else {
-    using Impl = LeidenClusteringImplementation<
-        EdgeWeightType, katana::PropertyGraphViews::Undirected>;
-    KATANA_CHECKED(pg->ConstructNodeProperties<typename Impl::NodeData>(
-        txn_ctx, temp_node_property_names));
-
     LeidenClusteringImplementation<
         EdgeWeightType, katana::PropertyGraphViews::Undirected>
         impl{};
     KATANA_CHECKED(impl.LeidenClustering(
-        pg, edge_weight_property_name, temp_node_property_names, clusters_orig,
-        plan, txn_ctx));
+        pg, edge_weight_property_name, clusters_orig, plan));
   }
 
   KATANA_CHECKED(pg->ConstructNodeProperties<std::tuple<CurrentCommunityID>>(
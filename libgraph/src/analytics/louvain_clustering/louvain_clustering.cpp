@@ -36,7 +36,9 @@ struct GraphTypes {
 
   using EdgeData = std::tuple<EdgeWeight<EdgeWeightType>>;
 
-  using Graph = katana::TypedPropertyGraphView<GraphViewTy, NodeData, EdgeData>;
+  using InputGraph =
+      katana::TypedPropertyGraphView<GraphViewTy, std::tuple<>, EdgeData>;
+  using Graph = CoarsenedGraph<NodeData, EdgeWeightType>;
 };
 
 template <typename EdgeWeightType, typename GraphViewTy>
@@ -47,9 +49,9 @@ struct LouvainClusteringImplementation
   using CommTy = CommunityType<EdgeWeightType>;
   using CommunityArray = katana::NUMAArray<CommTy>;
 
+  using InputGraph =
+      typename GraphTypes<EdgeWeightType, GraphViewTy>::InputGraph;
   using Graph = typename GraphTypes<EdgeWeightType, GraphViewTy>::Graph;
-  using NodeData = typename GraphTypes<EdgeWeightType, GraphViewTy>::NodeData;
-  using EdgeData = typename GraphTypes<EdgeWeightType, GraphViewTy>::EdgeData;
   using GNode = typename Graph::Node;
 
   using Base = katana::analytics::ClusteringImplementationBase<
@@ -90,6 +92,7 @@ struct LouvainClusteringImplementation
       KATANA_LOG_FATAL("constant_for_second_term is INFINITY\n");
     }
 
+    katana::PerThreadStorage<NeighborClusterMap<EdgeWeightType>> cluster_maps;
     katana::StatTimer TimerClusteringWhile("Timer_Clustering_While");
     TimerClusteringWhile.start();
     while (true) {
@@ -110,22 +113,17 @@ struct LouvainClusteringImplementation
 
             uint64_t degree = Degree(*graph, n);
             uint64_t local_target = Base::UNASSIGNED;
-            // TODO(amber): use scalable allocator with these containers
-            std::map<uint64_t, uint64_t>
-                cluster_local_map;  // Map each neighbor's cluster to local number:
-                                    // Community --> Index
-            std::vector<EdgeWeightType>
-                counter;  // Number of edges to each unique cluster
+            NeighborClusterMap<EdgeWeightType>& clusters =
+                *cluster_maps.getLocal();
             EdgeWeightType self_loop_wt = 0;
 
             if (degree > 0) {
               Base::template FindNeighboringClusters<EdgeWeightType>(
-                  *graph, n, cluster_local_map, counter, self_loop_wt);
+                  *graph, n, &clusters, self_loop_wt);
               // Find the max gain in modularity
               local_target = Base::MaxModularityWithoutSwaps(
-                  cluster_local_map, counter, self_loop_wt, c_info,
-                  n_data_degree_wt, n_data_curr_comm_id,
-                  constant_for_second_term);
+                  clusters, self_loop_wt, c_info, n_data_degree_wt,
+                  n_data_curr_comm_id, constant_for_second_term);
 
             } else {
               local_target = Base::UNASSIGNED;
@@ -242,6 +240,7 @@ struct LouvainClusteringImplementation
       c_update_subtract[n].size = 0;
     });
 
+    katana::PerThreadStorage<NeighborClusterMap<EdgeWeightType>> cluster_maps;
     katana::StatTimer TimerClusteringWhile("Timer_Clustering_While");
     TimerClusteringWhile.start();
 
@@ -261,22 +260,17 @@ struct LouvainClusteringImplementation
 
               uint64_t degree = Degree(*graph, n);
 
-              // TODO(amber): use scalable allocators
-              std::map<uint64_t, uint64_t>
-                  cluster_local_map;  // Map each neighbor's cluster to local number:
-                                      // Community --> Index
-              std::vector<EdgeWeightType>
-                  counter;  // Number of edges to each unique cluster
+              NeighborClusterMap<EdgeWeightType>& clusters =
+                  *cluster_maps.getLocal();
               EdgeWeightType self_loop_wt = 0;
 
               if (degree > 0) {
                 Base::template FindNeighboringClusters<EdgeWeightType>(
-                    *graph, n, cluster_local_map, counter, self_loop_wt);
+                    *graph, n, &clusters, self_loop_wt);
                 // Find the max gain in modularity
                 local_target[n] = Base::MaxModularityWithoutSwaps(
-                    cluster_local_map, counter, self_loop_wt, c_info,
-                    n_data_degree_wt, n_data_curr_comm_id,
-                    constant_for_second_term);
+                    clusters, self_loop_wt, c_info, n_data_degree_wt,
+                    n_data_curr_comm_id, constant_for_second_term);
 
               } else {
                 local_target[n] = Base::UNASSIGNED;
@@ -358,26 +352,22 @@ struct LouvainClusteringImplementation
 public:
   katana::Result<void> LouvainClustering(
       katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
-      const std::vector<std::string>& temp_node_property_names,
-      katana::NUMAArray<uint64_t>& clusters_orig, LouvainClusteringPlan plan,
-      katana::TxnContext* txn_ctx) {
-    TemporaryPropertyGuard temp_edge_property{pg->EdgeMutablePropertyView()};
-    std::vector<std::string> temp_edge_property_names = {
-        temp_edge_property.name()};
+      katana::NUMAArray<uint64_t>& clusters_orig, LouvainClusteringPlan plan) {
+    auto input_graph = KATANA_CHECKED(
+        InputGraph::Make(pg, {}, {edge_weight_property_name}));
 
     /*
-     * Construct temp property graph. This graph gets coarsened as the
-     * computation proceeds.
+     * Copy the input graph. The copy gets coarsened as the computation
+     * proceeds.
      */
-    std::unique_ptr<katana::PropertyGraph> pg_mutable;
+    Graph graph_curr = Graph::Copy(input_graph);
 
-    Graph graph_curr = KATANA_CHECKED(
-        Graph::Make(pg, temp_node_property_names, {edge_weight_property_name}));
     /*
     * Vertex following optimization
     */
     if (plan.enable_vf()) {
-      Base::VertexFollowing(&graph_curr);  // Find nodes that follow other nodes
+      // Find nodes that follow other nodes
+      Base::VertexFollowing(input_graph, &graph_curr);
 
       uint64_t num_unique_clusters =
           Base::template RenumberClustersContiguously<CurrentCommunityID>(
@@ -390,18 +380,9 @@ public:
         clusters_orig[n] = graph_curr.template GetData<CurrentCommunityID>(n);
       });
 
-      auto pg_empty = std::make_unique<katana::PropertyGraph>();
-
       // Build new graph to remove the isolated nodes
-      auto coarsened_graph_result = Base::template GraphCoarsening<
-          NodeData, EdgeData, EdgeWeightType, CurrentCommunityID>(
-          graph_curr, pg_empty.get(), num_unique_clusters,
-          temp_node_property_names, temp_edge_property_names, txn_ctx);
-      if (!coarsened_graph_result) {
-        return coarsened_graph_result.error();
-      }
-
-      pg_mutable = std::move(coarsened_graph_result.value());
+      graph_curr = Base::template GraphCoarsening<CurrentCommunityID>(
+          graph_curr, num_unique_clusters);
 
     } else {
       /*
@@ -410,31 +391,18 @@ public:
       katana::do_all(katana::iterate(graph_curr), [&](GNode n) {
         clusters_orig[n] = Base::UNASSIGNED;
       });
-
-      auto pg_dup = KATANA_CHECKED(Base::DuplicateGraphWithSameTopo(*pg));
-      KATANA_CHECKED(Base::template CopyEdgeProperty<GraphViewTy>(
-          pg, pg_dup.get(), temp_edge_property_names[0], txn_ctx));
-
-      KATANA_CHECKED(
-          pg_dup->template ConstructNodeProperties<NodeData>(txn_ctx));
-
-      pg_mutable = std::move(pg_dup);
     }
 
-    KATANA_LOG_ASSERT(pg_mutable);
-
     double prev_mod = -1;  // Previous modularity
     double curr_mod = -1;  // Current modularity
     uint32_t phase = 0;
 
-    std::unique_ptr<katana::PropertyGraph> pg_curr = std::move(pg_mutable);
     uint32_t iter = 0;
     uint64_t num_nodes_orig = clusters_orig.size();
     while (true) {
       iter++;
       phase++;
 
-      Graph graph_curr = KATANA_CHECKED(Graph::Make(pg_curr.get()));
       if (graph_curr.NumNodes() > plan.min_graph_size()) {
         switch (plan.algorithm()) {
         case LouvainClusteringPlan::kDoAll: {
@@ -482,15 +450,8 @@ public:
               });
         }
 
-        auto coarsened_graph_result = Base::template GraphCoarsening<
-            NodeData, EdgeData, EdgeWeightType, CurrentCommunityID>(
-            graph_curr, pg_curr.get(), num_unique_clusters,
-            temp_node_property_names, temp_edge_property_names, txn_ctx);
-        if (!coarsened_graph_result) {
-          return coarsened_graph_result.error();
-        }
-
-        pg_curr = std::move(coarsened_graph_result.value());
+        graph_curr = Base::template GraphCoarsening<CurrentCommunityID>(
+            graph_curr, num_unique_clusters);
 
         prev_mod = curr_mod;
       } else {
@@ -511,17 +472,6 @@ LouvainClusteringWithWrap(
       std::is_integral_v<EdgeWeightType> ||
       std::is_floating_point_v<EdgeWeightType>);
 
-  std::vector<TemporaryPropertyGuard> temp_node_properties(3);
-  std::generate_n(
-      temp_node_properties.begin(), temp_node_properties.size(),
-      [&]() { return TemporaryPropertyGuard{pg->NodeMutablePropertyView()}; });
-  std::vector<std::string> temp_node_property_names(
-      temp_node_properties.size());
-  std::transform(
-      temp_node_properties.begin(), temp_node_properties.end(),
-      temp_node_property_names.begin(),
-      [](const TemporaryPropertyGuard& p) { return p.name(); });
-
   /*
    * To keep track of communities for nodes in the original graph.
    * Community will be set to UNASSINED for isolated nodes
@@ -531,24 +481,14 @@ LouvainClusteringWithWrap(
 
   if (is_symmetric) {
     using GraphViewTy = katana::PropertyGraphViews::Default;
-    using Impl = LouvainClusteringImplementation<EdgeWeightType, GraphViewTy>;
-    KATANA_CHECKED(pg->ConstructNodeProperties<typename Impl::NodeData>(
-        txn_ctx, temp_node_property_names));
-
     LouvainClusteringImplementation<EdgeWeightType, GraphViewTy> impl{};
     KATANA_CHECKED(impl.LouvainClustering(
-        pg, edge_weight_property_name, temp_node_property_names, clusters_orig,
-        plan, txn_ctx));
+        pg, edge_weight_property_name, clusters_orig, plan));
   } else {
     using GraphViewTy = katana::PropertyGraphViews::Undirected;
-    using Impl = LouvainClusteringImplementation<EdgeWeightType, GraphViewTy>;
-    KATANA_CHECKED(pg->ConstructNodeProperties<typename Impl::NodeData>(
-        txn_ctx, temp_node_property_names));
-
     LouvainClusteringImplementation<EdgeWeightType, GraphViewTy> impl{};
     KATANA_CHECKED(impl.LouvainClustering(
-        pg, edge_weight_property_name, temp_node_property_names, clusters_orig,
-        plan, txn_ctx));
+        pg, edge_weight_property_name, clusters_orig, plan));
   }
 
   KATANA_CHECKED(pg->ConstructNodeProperties<std::tuple<CurrentCommunityID>>(
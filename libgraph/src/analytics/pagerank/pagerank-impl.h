@@ -45,6 +45,26 @@ katana::Result<void> PagerankPushAsynchronous(
     katana::PropertyGraph* pg, const std::string& output_property_name,
     katana::analytics::PagerankPlan plan, katana::TxnContext* txn_ctx);
 
+katana::Result<void> PagerankPushIncremental(
+    katana::PropertyGraph* pg, const std::string& previous_property_name,
+    const std::vector<katana::analytics::PagerankEdgeChange>& changed_edges,
+    const std::vector<katana::GraphTopology::Node>& new_nodes,
+    const std::vector<katana::GraphTopology::Node>& deleted_nodes,
+    const std::string& output_property_name,
+    katana::analytics::PagerankPlan plan, katana::TxnContext* txn_ctx);
+
+katana::Result<void> PersonalizedPagerankPush(
+    katana::PropertyGraph* pg,
+    const std::vector<katana::GraphTopology::Node>& seeds,
+    const std::string& output_property_name,
+    katana::analytics::PagerankPlan plan, katana::TxnContext* txn_ctx);
+
+katana::Result<void> PersonalizedPagerankPushBatch(
+    katana::PropertyGraph* pg,
+    const std::vector<katana::GraphTopology::Node>& sources,
+    const std::string& output_property_name,
+    katana::analytics::PagerankPlan plan, katana::TxnContext* txn_ctx);
+
 katana::Result<void> PagerankPushSynchronous(
     katana::PropertyGraph* pg, const std::string& output_property_name,
     katana::analytics::PagerankPlan plan, katana::TxnContext* txn_ctx);
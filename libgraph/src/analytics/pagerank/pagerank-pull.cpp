@@ -17,8 +17,11 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include <functional>
+
 #include <arrow/type.h>
 
+#include "katana/TiledExecutor.h"
 #include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/Utils.h"
 #include "pagerank-impl.h"
@@ -152,6 +155,20 @@ ComputeOutDeg(const Graph& graph, NodeOutDegreeArray* node_data) {
   return katana::ResultSuccess();
 }
 
+//! Pull over the edges of the transposed graph a segment of neighbors at a
+//! time, with segments sized for value_size bytes read per neighbor.
+auto
+MakePullExecutor(const Graph& graph, size_t value_size) {
+  return katana::MakeCacheBlockedPullExecutor<PRTy>(
+      graph.size(),
+      [g = &graph](uint32_t src, const auto& fn) {
+        for (auto nbr : g->OutEdges(src)) {
+          fn(g->OutEdgeDst(nbr));
+        }
+      },
+      katana::CacheBlockedSegmentSize(value_size));
+}
+
 /**
  * It does not calculate the pagerank for each iteration,
  * but only calculate the residual to be added from the previous pagerank to
@@ -170,6 +187,7 @@ ComputePRResidual(
   using GNode = typename Graph::Node;
   unsigned int iterations = 0;
   katana::GAccumulator<unsigned int> accum;
+  auto executor = MakePullExecutor(*graph, sizeof(PRTy));
 
   while (true) {
     katana::do_all(
@@ -193,23 +211,17 @@ ComputePRResidual(
         },
         katana::loopname("PageRank_delta"));
 
-    katana::do_all(
-        katana::iterate(*graph),
-        [&](const GNode& src) {
-          float sum = 0;
-          for (auto nbr : graph->OutEdges(src)) {
-            auto dest = graph->OutEdgeDst(nbr);
-            if ((*delta)[dest] > 0) {
-              sum += (*delta)[dest];
-            }
-          }
+    executor.Execute(
+        0,
+        [&](uint32_t dest) {
+          return (*delta)[dest] > 0 ? (*delta)[dest] : PRTy{0};
+        },
+        std::plus<PRTy>(),
+        [&](uint32_t src, PRTy sum) {
           if (sum > 0) {
             (*residual)[src] = sum;
           }
-        },
-        katana::steal(),
-        katana::chunk_size<katana::analytics::PagerankPlan::kChunkSize>(),
-        katana::loopname("PageRank"));
+        });
 
 #if DEBUG
     std::cout << "iteration: " << iterations << "\n";
@@ -236,39 +248,30 @@ ComputePRTopological(
   katana::StatTimer exec_time("PagerankPullTopological");
   exec_time.start();
 
-  using GNode = typename Graph::Node;
   unsigned int iteration = 0;
   katana::GAccumulator<float> accum;
+  auto executor = MakePullExecutor(*graph, sizeof(PagerankValueAndOutDegreeTy));
 
   float base_score = (1.0f - plan.alpha());
   while (true) {
-    katana::do_all(
-        katana::iterate(*graph),
-        [&](const GNode& src) {
-          float sum = 0.0;
-
-          for (auto jj : graph->OutEdges(src)) {
-            auto dest = graph->OutEdgeDst(jj);
-            auto& ddata = (*node_data)[dest];
-            sum += ddata.value / ddata.out;
-          }
-
+    //! All sums are computed before any value is updated.
+    executor.Execute(
+        0,
+        [&](uint32_t dest) {
+          auto& ddata = (*node_data)[dest];
+          return ddata.value / ddata.out;
+        },
+        std::plus<PRTy>(),
+        [&](uint32_t src, PRTy sum) {
           //! New value of pagerank after computing contributions from
           //! incoming edges in the original graph.
           float value = sum * plan.alpha() + base_score;
           //! Find the delta in new and old pagerank values.
-          //float diff = std::fabs(value - sdata.value);
           float diff = std::fabs(value - (*node_data)[src].value);
 
-          //! Do not update pagerank before the diff is computed since
-          //! there is a data dependence on the pagerank value.
-          auto& sdata = (*node_data)[src].value;
-          sdata = value;
+          (*node_data)[src].value = value;
           accum += diff;
-        },
-        katana::steal(),
-        katana::chunk_size<katana::analytics::PagerankPlan::kChunkSize>(),
-        katana::loopname("Pagerank Topological"));
+        });
 
 #if DEBUG
     std::cout << "iteration: " << iteration << " max delta: " << delta << "\n";
@@ -17,8 +17,19 @@
  * Documentation, or loss or inaccuracy of data of any kind.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <vector>
+
+#include <arrow/api.h>
+
 #include "katana/AtomicHelpers.h"
+#include "katana/NUMAArray.h"
+#include "katana/PerThreadStorage.h"
 #include "katana/Properties.h"
+#include "katana/Reduction.h"
+#include "katana/SimpleLock.h"
 #include "katana/TypedPropertyGraph.h"
 #include "katana/analytics/Utils.h"
 #include "pagerank-impl.h"
@@ -50,6 +61,73 @@ InitializeNodeResidual(
       katana::no_stats(), katana::loopname("Initialize"));
 }
 
+/// Push residuals asynchronously until the residual of every node n is
+/// within threshold(n), starting from the nodes in initial. Residuals may be
+/// negative after an incremental update, so they are compared by magnitude.
+template <typename Range, typename Threshold>
+void
+PushResidualsAsynchronous(
+    Graph* graph, const katana::analytics::PagerankPlan& plan,
+    const Range& initial, const Threshold& threshold) {
+  typedef katana::PerSocketChunkFIFO<
+      katana::analytics::PagerankPlan::kChunkSize>
+      WL;
+  katana::for_each(
+      initial,
+      [&](const GNode& src, auto& ctx) {
+        auto& src_residual = graph->GetData<NodeResidual>(src);
+        if (std::fabs(src_residual.load()) > threshold(src)) {
+          PRTy old_residual = src_residual.exchange(0.0);
+          auto& src_value = graph->GetData<NodeValue>(src);
+          src_value += old_residual;
+          int src_nout = graph->OutDegree(src);
+          if (src_nout > 0) {
+            PRTy delta = old_residual * plan.alpha() / src_nout;
+            //! For each out-going neighbors.
+            for (const auto& jj : graph->OutEdges(src)) {
+              auto dest = graph->OutEdgeDst(jj);
+              auto& dest_residual = graph->GetData<NodeResidual>(dest);
+              if (delta != 0) {
+                auto old = atomicAdd(dest_residual, delta);
+                if ((std::fabs(old) <= threshold(dest)) &&
+                    (std::fabs(old + delta) > threshold(dest))) {
+                  ctx.push(dest);
+                }
+              }
+            }
+          }
+        }
+      },
+      katana::loopname("PushResidualAsynchronous"),
+      katana::disable_conflict_detection(), katana::wl<WL>());
+}
+
+/// The forward push of Andersen, Chung and Lang pushes a node while its
+/// residual exceeds the tolerance times its out degree
+template <typename View>
+PRTy
+ForwardPushThreshold(
+    const View& graph, const katana::analytics::PagerankPlan& plan,
+    const GNode& n) {
+  return plan.tolerance() * std::max<PRTy>(graph.OutDegree(n), 1);
+}
+
+katana::Result<void>
+CheckSeeds(katana::PropertyGraph* pg, const std::vector<GNode>& seeds) {
+  if (seeds.empty()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "no seeds for personalization");
+  }
+  for (GNode n : seeds) {
+    if (n >= pg->NumNodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "seed {} is not in a graph of {} nodes", n, pg->NumNodes());
+    }
+  }
+  return katana::ResultSuccess();
+}
+
 }  // namespace
 
 katana::Result<void>
@@ -73,39 +151,343 @@ PagerankPushAsynchronous(
 
   InitializeNodeResidual(&graph, plan);
 
+  PushResidualsAsynchronous(
+      &graph, plan, katana::iterate(graph),
+      [&](const GNode&) { return plan.tolerance(); });
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+PagerankPushIncremental(
+    katana::PropertyGraph* pg, const std::string& previous_property_name,
+    const std::vector<katana::analytics::PagerankEdgeChange>& changed_edges,
+    const std::vector<katana::GraphTopology::Node>& new_nodes,
+    const std::vector<katana::GraphTopology::Node>& deleted_nodes,
+    const std::string& output_property_name,
+    katana::analytics::PagerankPlan plan, katana::TxnContext* txn_ctx) {
+  using katana::analytics::PagerankEdgeChange;
+
+  // Group the changes by source and check them before touching the graph
+  std::vector<PagerankEdgeChange> changes(changed_edges);
+  std::sort(
+      changes.begin(), changes.end(),
+      [](const PagerankEdgeChange& a, const PagerankEdgeChange& b) {
+        return a.src < b.src;
+      });
+  std::vector<size_t> source_starts;
+  for (size_t i = 0; i < changes.size(); ++i) {
+    const PagerankEdgeChange& change = changes[i];
+    if (change.src >= pg->NumNodes() || change.dst >= pg->NumNodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "changed edge ({}, {}) is not in a graph of {} nodes", change.src,
+          change.dst, pg->NumNodes());
+    }
+    if (i == 0 || changes[i - 1].src != change.src) {
+      source_starts.emplace_back(i);
+    }
+  }
+  source_starts.emplace_back(changes.size());
+  for (size_t i = 0; i + 1 < source_starts.size(); ++i) {
+    auto begin = changes.begin() + source_starts[i];
+    auto end = changes.begin() + source_starts[i + 1];
+    auto num_inserted =
+        std::count_if(begin, end, [](const PagerankEdgeChange& change) {
+          return change.inserted;
+        });
+    if (static_cast<size_t>(num_inserted) >
+        pg->topology().OutDegree(begin->src)) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "{} edges inserted from node {}, which has {} edges", num_inserted,
+          begin->src, pg->topology().OutDegree(begin->src));
+    }
+  }
+  for (GNode n : new_nodes) {
+    if (n >= pg->NumNodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "new node {} is not in a graph of {} nodes", n, pg->NumNodes());
+    }
+  }
+
+  // Deleted nodes stay in the graph without edges
+  std::vector<uint8_t> is_deleted(deleted_nodes.empty() ? 0 : pg->NumNodes());
+  for (GNode n : deleted_nodes) {
+    if (n >= pg->NumNodes()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "deleted node {} is not in a graph of {} nodes", n, pg->NumNodes());
+    }
+    if (pg->topology().OutDegree(n) != 0) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "deleted node {} has {} edges", n, pg->topology().OutDegree(n));
+    }
+    is_deleted[n] = 1;
+  }
+  for (GNode n : new_nodes) {
+    if (!is_deleted.empty() && is_deleted[n]) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "node {} is both new and deleted", n);
+    }
+  }
+  if (!deleted_nodes.empty()) {
+    katana::GReduceLogicalOr has_in_edge;
+    const katana::GraphTopology& topology = pg->topology();
+    katana::do_all(
+        katana::iterate(topology.OutEdges()),
+        [&](const katana::GraphTopology::Edge& e) {
+          if (is_deleted[topology.OutEdgeDst(e)]) {
+            has_in_edge.update(true);
+          }
+        },
+        katana::no_stats(), katana::loopname("CheckDeletedNodes"));
+    if (has_in_edge.reduce()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "a deleted node has edges to it");
+    }
+  }
+
+  using PreviousGraph =
+      katana::TypedPropertyGraph<std::tuple<NodeValue>, std::tuple<>>;
+  auto previous = KATANA_CHECKED_CONTEXT(
+      PreviousGraph::Make(pg, {previous_property_name}, {}),
+      "previous Page Rank {}", previous_property_name);
+
+  katana::analytics::TemporaryPropertyGuard temporary_property{
+      pg->NodeMutablePropertyView()};
+
+  KATANA_CHECKED(pg->ConstructNodeProperties<NodeData>(
+      txn_ctx, {output_property_name, temporary_property.name()}));
+
+  Graph graph = KATANA_CHECKED(
+      Graph::Make(pg, {output_property_name, temporary_property.name()}, {}));
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        graph.GetData<NodeResidual>(n) = 0;
+        graph.GetData<NodeValue>(n) = previous.GetData<NodeValue>(n);
+      },
+      katana::no_stats(), katana::loopname("Initialize"));
+
+  // The push algorithm keeps residual = initial residual + alpha * (sum of
+  // value / out degree of in-neighbors) - value at every node, which held
+  // up to the tolerance before the change. Restore it where the change
+  // broke it; the residuals seeded this way may be negative.
+  katana::InsertBag<GNode> seeds;
+  auto add_residual = [&](GNode n, PRTy delta) {
+    auto old = atomicAdd(graph.GetData<NodeResidual>(n), delta);
+    if ((std::fabs(old) <= plan.tolerance()) &&
+        (std::fabs(old + delta) > plan.tolerance())) {
+      seeds.push(n);
+    }
+  };
+
+  katana::do_all(
+      katana::iterate(new_nodes),
+      [&](const GNode& n) {
+        graph.GetData<NodeValue>(n) = 0;
+        add_residual(n, plan.initial_residual());
+      },
+      katana::no_stats(), katana::loopname("SeedNewNodes"));
+
+  // New nodes have no value to redistribute
+  katana::do_all(
+      katana::iterate(size_t{0}, source_starts.size() - 1),
+      [&](size_t i) {
+        auto begin = changes.begin() + source_starts[i];
+        auto end = changes.begin() + source_starts[i + 1];
+        GNode src = begin->src;
+        PRTy value = graph.GetData<NodeValue>(src);
+        if (value == 0) {
+          return;
+        }
+
+        int64_t new_degree = graph.OutDegree(src);
+        int64_t old_degree = new_degree;
+        for (auto it = begin; it != end; ++it) {
+          old_degree += it->inserted ? -1 : 1;
+        }
+        PRTy new_share =
+            new_degree > 0 ? value * plan.alpha() / new_degree : 0;
+        PRTy old_share =
+            old_degree > 0 ? value * plan.alpha() / old_degree : 0;
+
+        // Every edge of src gets new_share instead of old_share, except
+        // inserted edges, which had nothing, and deleted edges, which lose
+        // old_share
+        if (new_share != old_share) {
+          for (const auto& e : graph.OutEdges(src)) {
+            add_residual(graph.OutEdgeDst(e), new_share - old_share);
+          }
+        }
+        for (auto it = begin; it != end; ++it) {
+          add_residual(it->dst, it->inserted ? old_share : -old_share);
+        }
+      },
+      katana::steal(), katana::loopname("SeedChangedEdges"));
+
+  // Deleted nodes redistributed their value above through their deleted
+  // edges; with no edges left they keep none. Their seeds are skipped since
+  // their residual is within the tolerance.
+  katana::do_all(
+      katana::iterate(deleted_nodes),
+      [&](const GNode& n) {
+        graph.GetData<NodeValue>(n) = 0;
+        graph.GetData<NodeResidual>(n) = 0;
+      },
+      katana::no_stats(), katana::loopname("ClearDeletedNodes"));
+
+  PushResidualsAsynchronous(
+      &graph, plan, katana::iterate(seeds),
+      [&](const GNode&) { return plan.tolerance(); });
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+PersonalizedPagerankPush(
+    katana::PropertyGraph* pg, const std::vector<GNode>& seeds,
+    const std::string& output_property_name,
+    katana::analytics::PagerankPlan plan, katana::TxnContext* txn_ctx) {
+  KATANA_CHECKED(CheckSeeds(pg, seeds));
+
+  katana::analytics::TemporaryPropertyGuard temporary_property{
+      pg->NodeMutablePropertyView()};
+
+  KATANA_CHECKED(pg->ConstructNodeProperties<NodeData>(
+      txn_ctx, {output_property_name, temporary_property.name()}));
+
+  Graph graph = KATANA_CHECKED(
+      Graph::Make(pg, {output_property_name, temporary_property.name()}, {}));
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        graph.GetData<NodeResidual>(n) = 0;
+        graph.GetData<NodeValue>(n) = 0;
+      },
+      katana::no_stats(), katana::loopname("Initialize"));
+
+  // The seeds share the restart probability; a seed may be repeated
+  PRTy seed_residual = plan.initial_residual() / seeds.size();
+  for (GNode seed : seeds) {
+    atomicAdd(graph.GetData<NodeResidual>(seed), seed_residual);
+  }
+
+  PushResidualsAsynchronous(
+      &graph, plan, katana::iterate(seeds), [&](const GNode& n) {
+        return ForwardPushThreshold(graph, plan, n);
+      });
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+PersonalizedPagerankPushBatch(
+    katana::PropertyGraph* pg, const std::vector<GNode>& sources,
+    const std::string& output_property_name,
+    katana::analytics::PagerankPlan plan, katana::TxnContext* txn_ctx) {
+  KATANA_CHECKED(CheckSeeds(pg, sources));
+
+  using TopologyGraph = katana::TypedPropertyGraphView<
+      katana::PropertyGraphViews::Default, std::tuple<>, std::tuple<>>;
+  TopologyGraph graph = KATANA_CHECKED(TopologyGraph::Make(pg));
+
+  // The ranks and residuals of a node are contiguous vectors with one lane
+  // per source. The ranks are computed in place in the buffer of the output
+  // property.
+  const size_t num_lanes = sources.size();
+  const size_t num_values = graph.NumNodes() * num_lanes;
+  std::shared_ptr<arrow::Buffer> buffer =
+      KATANA_CHECKED(arrow::AllocateBuffer(num_values * sizeof(PRTy)));
+  PRTy* values = reinterpret_cast<PRTy*>(buffer->mutable_data());
+  katana::NUMAArray<PRTy> residuals;
+  residuals.allocateBlocked(num_values);
+  // A push to a node adds to all lanes under the lock of the node, rather
+  // than with an atomic update per lane. queued is set while the node is on
+  // the worklist.
+  katana::NUMAArray<katana::SimpleLock> locks;
+  locks.allocateBlocked(graph.NumNodes());
+  katana::NUMAArray<uint8_t> queued;
+  queued.allocateBlocked(graph.NumNodes());
+
+  katana::do_all(
+      katana::iterate(graph),
+      [&](const GNode& n) {
+        std::fill_n(values + n * num_lanes, num_lanes, 0);
+        std::fill_n(&residuals[n * num_lanes], num_lanes, 0);
+        locks.constructAt(n);
+        queued[n] = false;
+      },
+      katana::no_stats(), katana::loopname("Initialize"));
+
+  std::vector<GNode> initial(sources);
+  for (size_t i = 0; i < num_lanes; ++i) {
+    residuals[sources[i] * num_lanes + i] = plan.initial_residual();
+    queued[sources[i]] = true;
+  }
+  std::sort(initial.begin(), initial.end());
+  initial.erase(std::unique(initial.begin(), initial.end()), initial.end());
+
+  katana::PerThreadStorage<std::vector<PRTy>> deltas;
+
   typedef katana::PerSocketChunkFIFO<
       katana::analytics::PagerankPlan::kChunkSize>
       WL;
   katana::for_each(
-      katana::iterate(graph),
+      katana::iterate(initial),
       [&](const GNode& src, auto& ctx) {
-        auto& src_residual = graph.GetData<NodeResidual>(src);
-        if (src_residual > plan.tolerance()) {
-          PRTy old_residual = src_residual.exchange(0.0);
-          auto& src_value = graph.GetData<NodeValue>(src);
-          src_value += old_residual;
-          int src_nout = graph.OutDegree(src);
-          if (src_nout > 0) {
-            PRTy delta = old_residual * plan.alpha() / src_nout;
-            //! For each out-going neighbors.
-            for (const auto& jj : graph.OutEdges(src)) {
-              auto dest = graph.OutEdgeDst(jj);
-              auto& dest_residual = graph.GetData<NodeResidual>(dest);
-              if (delta > 0) {
-                auto old = atomicAdd(dest_residual, delta);
-                if ((old < plan.tolerance()) &&
-                    (old + delta >= plan.tolerance())) {
-                  ctx.push(dest);
-                }
-              }
-            }
+        std::vector<PRTy>& delta = *deltas.getLocal();
+        delta.resize(num_lanes);
+        PRTy* src_value = values + src * num_lanes;
+        PRTy* src_residual = &residuals[src * num_lanes];
+        auto src_nout = graph.OutDegree(src);
+        PRTy share = src_nout > 0 ? plan.alpha() / src_nout : 0;
+        {
+          std::lock_guard<katana::SimpleLock> lock(locks[src]);
+          for (size_t i = 0; i < num_lanes; ++i) {
+            src_value[i] += src_residual[i];
+            delta[i] = src_residual[i] * share;
+            src_residual[i] = 0;
+          }
+          queued[src] = false;
+        }
+
+        //! For each out-going neighbors.
+        for (const auto& jj : graph.OutEdges(src)) {
+          auto dest = graph.OutEdgeDst(jj);
+          PRTy* dest_residual = &residuals[dest * num_lanes];
+          PRTy threshold = ForwardPushThreshold(graph, plan, dest);
+          bool above_threshold = false;
+          std::lock_guard<katana::SimpleLock> lock(locks[dest]);
+          for (size_t i = 0; i < num_lanes; ++i) {
+            dest_residual[i] += delta[i];
+            above_threshold |= dest_residual[i] > threshold;
+          }
+          if (above_threshold && !queued[dest]) {
+            queued[dest] = true;
+            ctx.push(dest);
           }
         }
       },
-      katana::loopname("PushResidualAsynchronous"),
+      katana::loopname("PersonalizedPushResidual"),
       katana::disable_conflict_detection(), katana::wl<WL>());
 
-  return katana::ResultSuccess();
+  auto rank_values =
+      std::make_shared<arrow::FloatArray>(num_values, std::move(buffer));
+  auto ranks = KATANA_CHECKED(arrow::FixedSizeListArray::FromArrays(
+      rank_values, static_cast<int32_t>(num_lanes)));
+  auto table = arrow::Table::Make(
+      arrow::schema({arrow::field(output_property_name, ranks->type())}),
+      {ranks});
+
+  return pg->AddNodeProperties(table, txn_ctx);
 }
 
 katana::Result<void>
@@ -38,6 +38,52 @@ katana::analytics::Pagerank(
   }
 }
 
+katana::Result<void>
+katana::analytics::PagerankIncremental(
+    katana::PropertyGraph* pg, const std::string& previous_property_name,
+    const std::vector<PagerankEdgeChange>& changed_edges,
+    const std::vector<GraphTopology::Node>& new_nodes,
+    const std::vector<GraphTopology::Node>& deleted_nodes,
+    const std::string& output_property_name, katana::TxnContext* txn_ctx,
+    katana::analytics::PagerankPlan plan) {
+  if (plan.algorithm() != PagerankPlan::kPushAsynchronous) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "incremental Page Rank requires the push asynchronous algorithm");
+  }
+  return PagerankPushIncremental(
+      pg, previous_property_name, changed_edges, new_nodes, deleted_nodes,
+      output_property_name, plan, txn_ctx);
+}
+
+katana::Result<void>
+katana::analytics::PersonalizedPagerank(
+    katana::PropertyGraph* pg, const std::vector<GraphTopology::Node>& seeds,
+    const std::string& output_property_name, katana::TxnContext* txn_ctx,
+    katana::analytics::PagerankPlan plan) {
+  if (plan.algorithm() != PagerankPlan::kPushAsynchronous) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "personalized Page Rank requires the push asynchronous algorithm");
+  }
+  return PersonalizedPagerankPush(
+      pg, seeds, output_property_name, plan, txn_ctx);
+}
+
+katana::Result<void>
+katana::analytics::PersonalizedPagerankBatch(
+    katana::PropertyGraph* pg, const std::vector<GraphTopology::Node>& sources,
+    const std::string& output_property_name, katana::TxnContext* txn_ctx,
+    katana::analytics::PagerankPlan plan) {
+  if (plan.algorithm() != PagerankPlan::kPushAsynchronous) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument,
+        "personalized Page Rank requires the push asynchronous algorithm");
+  }
+  return PersonalizedPagerankPushBatch(
+      pg, sources, output_property_name, plan, txn_ctx);
+}
+
 /// \cond DO_NOT_DOCUMENT
 katana::Result<void>
 katana::analytics::PagerankAssertValid(
@@ -19,6 +19,10 @@
 
 #include "katana/analytics/random_walks/random_walks.h"
 
+#include <algorithm>
+#include <array>
+#include <random>
+
 #include "katana/TypedPropertyGraph.h"
 
 using namespace katana::analytics;
@@ -28,147 +32,156 @@ const int RandomWalksPlan::kChunkSize = 1;
 namespace {
 
 using SortedPropertyGraphView = katana::PropertyGraphViews::EdgesSortedByDestID;
+using DefaultPropertyGraphView = katana::PropertyGraphViews::Default;
+
+/// Number of candidate steps that the rejection sampling of second-order
+/// walks draws at a time
+constexpr uint32_t kProposals = 4;
+
+/// The random numbers of the walks of one thread
+class WalkRandom {
+public:
+  void Seed(uint32_t seed) { generator_.seed(seed); }
+
+  /// Uniform in [0, bound) for bound < 2^32, with a multiplication and a
+  /// shift rather than a division (Lemire, "Fast Random Integer Generation in
+  /// an Interval", 2019)
+  uint64_t Below(uint64_t bound) {
+    return (static_cast<uint64_t>(generator_()) * bound) >> 32;
+  }
+
+  /// Uniform in [0, 1)
+  double Unit() { return generator_() * 0x1p-32; }
+
+private:
+  std::mt19937 generator_;
+};
+
+void
+SeedPerThread(katana::PerThreadStorage<WalkRandom>* random) {
+  // Default constructed generators would give every thread the same walks
+  for (uint32_t i = 0; i < random->size(); i++) {
+    random->getRemote(i)->Seed(std::mt19937::default_seed + i);
+  }
+}
+
+/// Pick one of \p degree candidate steps, accepting candidate c with
+/// probability accept(c) / upper_bound. Candidates are drawn kProposals at a
+/// time and first compared with lower_bound, below which they are accepted
+/// without calling accept, in loops over small arrays without branches; only
+/// the candidates that fail the comparison pay for accept, which for node2vec
+/// looks up an edge. The first accepted candidate of a batch wins, which
+/// gives the same distribution as drawing one candidate at a time.
+template <typename Accept>
+uint64_t
+RejectionSample(
+    WalkRandom* random, uint64_t degree, double upper_bound,
+    double lower_bound, const Accept& accept) {
+  std::array<uint64_t, kProposals> candidates;
+  std::array<double, kProposals> ys;
+  std::array<bool, kProposals> below_lower_bound;
+  while (true) {
+    for (uint32_t i = 0; i < kProposals; i++) {
+      candidates[i] = random->Below(degree);
+    }
+    for (uint32_t i = 0; i < kProposals; i++) {
+      ys[i] = random->Unit() * upper_bound;
+    }
+    for (uint32_t i = 0; i < kProposals; i++) {
+      below_lower_bound[i] = ys[i] <= lower_bound;
+    }
+    for (uint32_t i = 0; i < kProposals; i++) {
+      if (below_lower_bound[i] || ys[i] <= accept(candidates[i])) {
+        return candidates[i];
+      }
+    }
+  }
+}
+
+/// Pad \p walk after its first \p length nodes
+void
+EndWalk(uint32_t* walk, uint32_t length, const RandomWalkMatrix& walks) {
+  std::fill(walk + length, walk + walks.row_length(), kRandomWalkEnd);
+}
 
 struct Node2VecAlgo {
   using NodeData = std::tuple<>;
   using EdgeData = std::tuple<>;
 
-  using SortedGraphView = katana::TypedPropertyGraphView<
+  using Graph = katana::TypedPropertyGraphView<
       SortedPropertyGraphView, NodeData, EdgeData>;
-  using GNode = typename SortedGraphView::Node;
+  using GNode = typename Graph::Node;
 
   const RandomWalksPlan& plan_;
   Node2VecAlgo(const RandomWalksPlan& plan) : plan_(plan) {}
 
-  GNode FindSampleNeighbor(
-      const SortedGraphView& graph, const GNode& n,
-      const katana::NUMAArray<uint64_t>& degree, const double prob) {
-    if (degree[n] == 0) {
-      return graph.NumNodes();
-    }
-    double total_wt = degree[n];
-
-    uint32_t edge_index = std::floor(prob * total_wt);
-    auto ei = graph.OutEdges(n).begin() + edge_index;
-    return graph.OutEdgeDst(*ei);
+  uint64_t NumWalks(const Graph& graph) const {
+    return graph.size() * plan_.number_of_walks();
   }
 
   void GraphRandomWalk(
-      const SortedGraphView& graph,
-      katana::InsertBag<std::vector<uint32_t>>* walks,
+      const Graph& graph, RandomWalkMatrix* walks,
       const katana::NUMAArray<uint64_t>& degree) {
-    katana::PerThreadStorage<std::mt19937> generator;
-    katana::PerThreadStorage<std::uniform_real_distribution<double>*>
-        distribution;
-
-    for (uint32_t i = 0; i < distribution.size(); i++) {
-      *distribution.getRemote(i) =
-          new std::uniform_real_distribution<double>(0.0, 1.0);
-    }
+    katana::PerThreadStorage<WalkRandom> random;
+    SeedPerThread(&random);
 
     double prob_forward = 1.0 / plan_.forward_probability();
     double prob_backward = 1.0 / plan_.backward_probability();
 
-    double upper_bound = 1.0;
-
-    upper_bound = (upper_bound > prob_forward) ? upper_bound : prob_forward;
-    upper_bound = (upper_bound > prob_backward) ? upper_bound : prob_backward;
-
-    double lower_bound = 1.0;
-
-    lower_bound = (lower_bound < prob_forward) ? lower_bound : prob_forward;
-    lower_bound = (lower_bound < prob_backward) ? lower_bound : prob_backward;
-
-    uint64_t total_walks = graph.size() * plan_.number_of_walks();
+    double upper_bound = std::max({1.0, prob_forward, prob_backward});
+    double lower_bound = std::min({1.0, prob_forward, prob_backward});
 
     katana::do_all(
-        katana::iterate(uint64_t(0), total_walks),
+        katana::iterate(uint64_t(0), walks->num_walks()),
         [&](uint64_t idx) {
-          GNode n = idx % graph.size();
-
-          //check if n has no neighbor
-          if (degree[n] == 0) {
-            return;
-          }
-
-          std::uniform_real_distribution<double>* dist =
-              *distribution.getLocal();
-
-          std::vector<uint32_t> walk;
-          walk.push_back(n);
-
-          //random value between 0 and 1
-          double prob = (*dist)(*generator.getLocal());
-
-          //Assumption: All edges have weight 1
-          auto nbr = FindSampleNeighbor(graph, n, degree, prob);
-          KATANA_LOG_ASSERT(nbr < graph.NumNodes());
-
-          walk.push_back(std::move(nbr));
-
-          for (uint32_t current_walk = 2; current_walk <= plan_.walk_length();
-               current_walk++) {
-            uint32_t curr = walk[current_walk - 1];
-            uint32_t prev = walk[current_walk - 2];
-
-            //check if n has no neighbor
+          WalkRandom* rand = random.getLocal();
+          uint32_t* walk = walks->walk(idx);
+          walk[0] = idx % graph.size();
+
+          uint32_t length = 1;
+          for (; length <= plan_.walk_length(); length++) {
+            uint32_t curr = walk[length - 1];
+            //check if curr has no neighbor
             if (degree[curr] == 0) {
               break;
             }
-            //acceptance-rejection sampling
-            while (true) {
-              //sample x
-              double prob = (*dist)(*generator.getLocal());
-
-              auto nbr = FindSampleNeighbor(graph, curr, degree, prob);
-              KATANA_LOG_ASSERT(nbr < graph.NumNodes());
-
-              //sample y
-              double y = (*dist)(*generator.getLocal());
-              y = y * upper_bound;
-
-              if (y <= lower_bound) {
-                //accept this sample
-                walk.push_back(std::move(nbr));
-                break;
-              } else {
-                //compute transition probability
-                double alpha;
-
-                //check if nbr is same as the previous node on this walk
-                if (nbr == prev) {
-                  alpha = prob_backward;
-                }  //check if nbr is also a neighbor of the previous node on this walk
-                else if (graph.HasEdge(prev, nbr)) {
-                  alpha = 1.0;
-                } else {
-                  alpha = prob_forward;
-                }
-
-                if (y <= alpha) {
-                  //accept y
-                  walk.push_back(std::move(nbr));
-                  break;
-                }
-              }
+            auto edges = graph.OutEdges(curr).begin();
+
+            uint64_t offset = 0;
+            if (length == 1 || upper_bound == lower_bound) {
+              // Every candidate is accepted on the first step, and on all
+              // steps if both probabilities are 1
+              offset = rand->Below(degree[curr]);
+            } else {
+              uint32_t prev = walk[length - 2];
+              offset = RejectionSample(
+                  rand, degree[curr], upper_bound, lower_bound,
+                  [&](uint64_t candidate) {
+                    GNode nbr = graph.OutEdgeDst(*(edges + candidate));
+                    //check if nbr is same as the previous node on this walk
+                    if (nbr == prev) {
+                      return prob_backward;
+                    }
+                    //check if nbr is also a neighbor of the previous node
+                    if (graph.HasEdge(prev, nbr)) {
+                      return 1.0;
+                    }
+                    return prob_forward;
+                  });
             }
+            walk[length] = graph.OutEdgeDst(*(edges + offset));
           }
-
-          walks->push(std::move(walk));
+          EndWalk(walk, length, *walks);
         },
         katana::steal(), katana::chunk_size<RandomWalksPlan::kChunkSize>(),
         katana::loopname("Node2vec walks"), katana::no_stats());
-
-    for (uint32_t i = 0; i < distribution.size(); i++) {
-      delete (*distribution.getRemote(i));
-    }
   }
 
-  void operator()(
-      const SortedGraphView& graph,
-      katana::InsertBag<std::vector<uint32_t>>* walks,
-      const katana::NUMAArray<uint64_t>& degree) {
-    GraphRandomWalk(graph, walks, degree);
+  katana::Result<void> operator()(
+      const Graph& graph, RandomWalkMatrix* walks,
+      katana::NUMAArray<uint64_t>* degree) {
+    GraphRandomWalk(graph, walks, *degree);
+    return katana::ResultSuccess();
   }
 };
 
@@ -178,9 +191,9 @@ struct Edge2VecAlgo {
   using NodeData = std::tuple<>;
   using EdgeData = std::tuple<EdgeType>;
 
-  using SortedGraphView = katana::TypedPropertyGraphView<
+  using Graph = katana::TypedPropertyGraphView<
       SortedPropertyGraphView, NodeData, EdgeData>;
-  using GNode = typename SortedGraphView::Node;
+  using GNode = typename Graph::Node;
 
   const RandomWalksPlan& plan_;
   Edge2VecAlgo(const RandomWalksPlan& plan) : plan_(plan) {}
@@ -188,7 +201,23 @@ struct Edge2VecAlgo {
   //transition matrix
   std::vector<std::vector<double>> transition_matrix_;
 
-  void Initialize() {
+  /// Number of steps over edges of each type in each walk of the current
+  /// iteration, by type and then walk
+  katana::NUMAArray<uint32_t> type_counts_;
+  /// Whether a walk of the current iteration is complete; walks that reach a
+  /// node without neighbors are left out of the statistics and the output
+  katana::NUMAArray<uint8_t> complete_;
+  uint64_t num_complete_{0};
+
+  uint64_t WalksPerIteration(const Graph& graph) const {
+    return graph.size() * plan_.number_of_walks();
+  }
+
+  uint64_t NumWalks(const Graph& graph) const {
+    return WalksPerIteration(graph) * plan_.max_iterations();
+  }
+
+  void Initialize(const Graph& graph) {
     transition_matrix_.resize(plan_.number_of_edge_types() + 1);
     //initialize transition matrix
     for (uint32_t i = 0; i <= plan_.number_of_edge_types(); i++) {
@@ -196,192 +225,109 @@ struct Edge2VecAlgo {
         transition_matrix_[i].push_back(1.0);
       }
     }
-  }
 
-  std::pair<GNode, EdgeType::ViewType::value_type> FindSampleNeighbor(
-      const SortedGraphView& graph, const GNode& n,
-      const katana::NUMAArray<uint64_t>& degree, const double prob) {
-    if (degree[n] == 0) {
-      return std::make_pair(graph.NumNodes(), 1);
-    }
-    double total_wt = degree[n];
+    type_counts_.allocateBlocked(
+        (plan_.number_of_edge_types() + 1) * WalksPerIteration(graph));
+    complete_.allocateBlocked(WalksPerIteration(graph));
+  }
 
-    uint32_t edge_index = std::floor(prob * total_wt);
-    auto ei = graph.OutEdges(n).begin() + edge_index;
-    return std::make_pair(
-        graph.OutEdgeDst(*ei), graph.GetEdgeData<EdgeType>(*ei));
+  uint32_t& TypeCount(uint32_t type, uint64_t walk) {
+    return type_counts_[type * complete_.size() + walk];
   }
 
   void GraphRandomWalk(
-      const SortedGraphView& graph,
-      katana::InsertBag<std::vector<uint32_t>>* walks,
-      katana::InsertBag<std::vector<uint32_t>>* types_walks,
+      const Graph& graph, RandomWalkMatrix* walks, uint32_t iteration,
       const katana::NUMAArray<uint64_t>& degree) {
-    katana::PerThreadStorage<std::mt19937> generator;
-    katana::PerThreadStorage<std::uniform_real_distribution<double>*>
-        distribution;
-
-    for (uint32_t i = 0; i < distribution.size(); i++) {
-      *distribution.getRemote(i) =
-          new std::uniform_real_distribution<double>(0.0, 1.0);
-    }
+    katana::PerThreadStorage<WalkRandom> random;
+    SeedPerThread(&random);
 
     double prob_forward = 1.0 / plan_.forward_probability();
     double prob_backward = 1.0 / plan_.backward_probability();
 
-    double upper_bound = 1.0;
+    double upper_bound = std::max({1.0, prob_forward, prob_backward});
 
-    upper_bound = (upper_bound > prob_forward) ? upper_bound : prob_forward;
-    upper_bound = (upper_bound > prob_backward) ? upper_bound : prob_backward;
-
-    uint64_t total_walks = graph.size() * plan_.number_of_walks();
+    uint64_t total_walks = WalksPerIteration(graph);
+    katana::GAccumulator<uint64_t> num_complete;
 
     katana::do_all(
         katana::iterate(uint64_t(0), total_walks),
         [&](uint64_t idx) {
-          GNode n = idx % graph.size();
-
-          //check if n has no neighbor
-          if (degree[n] == 0) {
-            return;
+          WalkRandom* rand = random.getLocal();
+          uint32_t* walk = walks->walk(iteration * total_walks + idx);
+          walk[0] = idx % graph.size();
+          for (uint32_t type = 0; type <= plan_.number_of_edge_types();
+               type++) {
+            TypeCount(type, idx) = 0;
           }
 
-          std::uniform_real_distribution<double>* dist =
-              *distribution.getLocal();
-
-          std::vector<uint32_t> walk;
-          std::vector<uint32_t> types_vec;
-
-          walk.push_back(n);
-
-          //random value between 0 and 1
-          double prob = (*dist)(*generator.getLocal());
-
-          //Assumption: All edges have weight 1
-          auto nbr_pair = FindSampleNeighbor(graph, n, degree, prob);
-          KATANA_LOG_ASSERT(nbr_pair.first < graph.NumNodes());
-
-          walk.push_back(std::move(nbr_pair.first));
-          types_vec.push_back(nbr_pair.second);
-
-          for (uint32_t current_walk = 2; current_walk <= plan_.walk_length();
-               current_walk++) {
-            uint32_t curr = walk[walk.size() - 1];
-            //check if n has no neighbor
+          uint32_t length = 1;
+          uint32_t p1 = 0;
+          for (; length <= plan_.walk_length(); length++) {
+            uint32_t curr = walk[length - 1];
+            //check if curr has no neighbor
             if (degree[curr] == 0) {
-              return;
+              break;
+            }
+            auto edges = graph.OutEdges(curr).begin();
+
+            uint64_t offset = 0;
+            if (length == 1) {
+              offset = rand->Below(degree[curr]);
+            } else {
+              uint32_t prev = walk[length - 2];
+              offset = RejectionSample(
+                  rand, degree[curr], upper_bound, 0.0,
+                  [&](uint64_t candidate) {
+                    auto e = *(edges + candidate);
+                    GNode nbr = graph.OutEdgeDst(e);
+                    uint32_t p2 = graph.GetEdgeData<EdgeType>(e);
+                    //compute transition probability
+                    double alpha;
+                    //check if nbr is same as the previous node on this walk
+                    if (nbr == prev) {
+                      alpha = prob_backward;
+                    }  //check if nbr is also a neighbor of the previous node
+                    else if (graph.HasEdge(prev, nbr)) {
+                      alpha = 1.0;
+                    } else {
+                      alpha = prob_forward;
+                    }
+                    return alpha * transition_matrix_[p1][p2];
+                  });
             }
-            uint32_t prev = walk[walk.size() - 2];
-
-            uint32_t p1 = types_vec.back();  //last element of types_vec
-
-            //acceptance-rejection sampling
-            while (true) {
-              //sample x
-              double prob = (*dist)(*generator.getLocal());
-
-              auto nbr_type_pair =
-                  FindSampleNeighbor(graph, curr, degree, prob);
-              KATANA_LOG_ASSERT(nbr_pair.first < graph.NumNodes());
-
-              GNode nbr = nbr_type_pair.first;
-              EdgeType::ViewType::value_type p2 = nbr_type_pair.second;
-
-              //sample y
-              double y = (*dist)(*generator.getLocal());
-              y = y * upper_bound;
-
-              //compute transition probability
-              double alpha;
-
-              //check if nbr is same as the previous node on this walk
-              if (nbr == prev) {
-                alpha = prob_backward;
-              }  //check if nbr is also a neighbor of the previous node on this walk
-              else if (graph.HasEdge(prev, nbr)) {
-                alpha = 1.0;
-              } else {
-                alpha = prob_forward;
-              }
-
-              alpha = alpha * transition_matrix_[p1][p2];
-              if (alpha >= y) {
-                //accept y
-                walk.push_back(std::move(nbr));
-                types_vec.push_back(p2);
-                break;
-              }
-            }  //end while
-
-          }  //end for
-
-          (*walks).push(std::move(walk));
-          (*types_walks).push(std::move(types_vec));
+            auto e = *(edges + offset);
+            walk[length] = graph.OutEdgeDst(e);
+            p1 = graph.GetEdgeData<EdgeType>(e);
+            KATANA_LOG_DEBUG_ASSERT(p1 <= plan_.number_of_edge_types());
+            TypeCount(p1, idx)++;
+          }
+          complete_[idx] = length > plan_.walk_length();
+          if (complete_[idx]) {
+            num_complete += 1;
+          }
+          // Like walks that start at a node without neighbors, walks that
+          // reach one are dropped rather than kept truncated
+          EndWalk(walk, complete_[idx] ? length : 1, *walks);
         },
         katana::steal(), katana::chunk_size<RandomWalksPlan::kChunkSize>(),
         katana::loopname("Edge2vec walks"), katana::no_stats());
-  }
-
-  //compute the histogram of edge types for each walk
-  std::vector<std::vector<uint32_t>> ComputeNumEdgeTypeVectors(
-      const katana::InsertBag<std::vector<uint32_t>>& types_walks) {
-    std::vector<std::vector<uint32_t>> num_edge_types_walks;
-
-    katana::PerThreadStorage<std::vector<std::vector<uint32_t>>>
-        per_thread_num_edge_types_walks;
-    katana::do_all(
-        katana::iterate(types_walks),
-        [&](const std::vector<uint32_t>& types_walk) {
-          std::vector<uint32_t> num_edge_types(
-              plan_.number_of_edge_types() + 1, 0);
-
-          for (auto type : types_walk) {
-            num_edge_types[type]++;
-          }
-
-          per_thread_num_edge_types_walks.getLocal()->emplace_back(
-              std::move(num_edge_types));
-        });
-
-    for (unsigned j = 0; j < katana::getActiveThreads(); ++j) {
-      for (auto num_edge_types :
-           *per_thread_num_edge_types_walks.getRemote(j)) {
-        num_edge_types_walks.push_back(std::move(num_edge_types));
-      }
-    }
 
-    return num_edge_types_walks;
+    num_complete_ = num_complete.reduce();
   }
 
-  std::vector<std::vector<uint32_t>> TransformVectors(
-      const std::vector<std::vector<uint32_t>>& num_edge_types_walks) {
-    uint32_t rows = num_edge_types_walks.size();
-    std::vector<std::vector<uint32_t>> transformed_num_edge_types_walks;
-    transformed_num_edge_types_walks.resize(plan_.number_of_edge_types() + 1);
-
-    katana::do_all(
-        katana::iterate(uint32_t(0), plan_.number_of_edge_types() + 1),
-        [&](uint32_t j) {
-          for (uint32_t i = 0; i < rows; i++) {
-            transformed_num_edge_types_walks[j].push_back(
-                num_edge_types_walks[i][j]);
-          }
-        });
-
-    return transformed_num_edge_types_walks;
-  }
-
-  std::vector<double> ComputeMeans(const std::vector<std::vector<uint32_t>>&
-                                       transformed_num_edge_types_walks) {
+  std::vector<double> ComputeMeans() {
     std::vector<double> means(plan_.number_of_edge_types() + 1);
 
     for (uint32_t i = 1; i <= plan_.number_of_edge_types(); i++) {
-      uint32_t sum = 0;
-      for (auto n : transformed_num_edge_types_walks[i]) {
-        sum += n;
-      }
+      katana::GAccumulator<uint64_t> sum;
+      katana::do_all(
+          katana::iterate(uint64_t(0), complete_.size()), [&](uint64_t m) {
+            if (complete_[m]) {
+              sum += TypeCount(i, m);
+            }
+          });
 
-      means[i] = ((double)sum) / (transformed_num_edge_types_walks[i].size());
+      means[i] = ((double)sum.reduce()) / num_complete_;
     }
 
     return means;
@@ -392,45 +338,40 @@ struct Edge2VecAlgo {
   }
 
   double pearsonCorr(
-      const uint32_t i, const uint32_t j,
-      const std::vector<std::vector<uint32_t>>&
-          transformed_num_edge_types_walks,
-      const std::vector<double>& means) {
-    const std::vector<uint32_t>& x = transformed_num_edge_types_walks[i];
-    const std::vector<uint32_t>& y = transformed_num_edge_types_walks[j];
-
+      const uint32_t i, const uint32_t j, const std::vector<double>& means) {
     double sum = 0.0;
     double sig1 = 0.0;
     double sig2 = 0.0;
 
-    for (uint32_t m = 0; m < x.size(); m++) {
-      sum += ((double)x[m] - means[i]) * ((double)y[m] - means[j]);
-      sig1 += ((double)x[m] - means[i]) * ((double)x[m] - means[i]);
-      sig2 += ((double)y[m] - means[j]) * ((double)y[m] - means[j]);
+    for (uint64_t m = 0; m < complete_.size(); m++) {
+      if (!complete_[m]) {
+        continue;
+      }
+      double x = TypeCount(i, m);
+      double y = TypeCount(j, m);
+      sum += (x - means[i]) * (y - means[j]);
+      sig1 += (x - means[i]) * (x - means[i]);
+      sig2 += (y - means[j]) * (y - means[j]);
     }
 
-    sum = sum / x.size();
+    sum = sum / num_complete_;
 
-    sig1 = sig1 / x.size();
+    sig1 = sig1 / num_complete_;
     sig1 = sqrt(sig1);
 
-    sig2 = sig2 / x.size();
+    sig2 = sig2 / num_complete_;
     sig2 = sqrt(sig2);
 
     double corr = sum / (sig1 * sig2);
     return corr;
   }
 
-  void ComputeTransitionMatrix(
-      const std::vector<std::vector<uint32_t>>&
-          transformed_num_edge_types_walks,
-      const std::vector<double>& means) {
+  void ComputeTransitionMatrix(const std::vector<double>& means) {
     katana::do_all(
         katana::iterate(uint32_t(1), plan_.number_of_edge_types() + 1),
         [&](uint32_t i) {
           for (uint32_t j = 1; j <= plan_.number_of_edge_types(); j++) {
-            double pearson_corr =
-                pearsonCorr(i, j, transformed_num_edge_types_walks, means);
+            double pearson_corr = pearsonCorr(i, j, means);
             double sigmoid = sigmoidCal(pearson_corr);
 
             transition_matrix_[i][j] = sigmoid;
@@ -438,32 +379,216 @@ struct Edge2VecAlgo {
         });
   }
 
-  void operator()(
-      const SortedGraphView& graph,
-      katana::InsertBag<std::vector<uint32_t>>* walks,
-      const katana::NUMAArray<uint64_t>& degree) {
+  katana::Result<void> operator()(
+      const Graph& graph, RandomWalkMatrix* walks,
+      katana::NUMAArray<uint64_t>* degree) {
     uint32_t iterations = plan_.max_iterations();
 
-    Initialize();
+    Initialize(graph);
 
     for (uint32_t iter = 0; iter < iterations; iter++) {
       //E step; generate walks
-      katana::InsertBag<std::vector<uint32_t>> types_walks;
-
-      GraphRandomWalk(graph, walks, &types_walks, degree);
+      GraphRandomWalk(graph, walks, iter, *degree);
 
       //Update transition matrix
-      std::vector<std::vector<uint32_t>> num_edge_types_walks =
-          ComputeNumEdgeTypeVectors(types_walks);
+      std::vector<double> means = ComputeMeans();
+
+      ComputeTransitionMatrix(means);
+    }
+    return katana::ResultSuccess();
+  }
+};
+
+struct FirstOrderAlgo {
+  using NodeData = std::tuple<>;
+  using EdgeData = std::tuple<>;
+
+  using Graph = katana::TypedPropertyGraphView<
+      DefaultPropertyGraphView, NodeData, EdgeData>;
+
+  const RandomWalksPlan& plan_;
+  FirstOrderAlgo(const RandomWalksPlan& plan) : plan_(plan) {}
+
+  uint64_t NumWalks(const Graph& graph) const {
+    return graph.size() * plan_.number_of_walks();
+  }
+
+  katana::Result<void> operator()(
+      const Graph& graph, RandomWalkMatrix* walks,
+      katana::NUMAArray<uint64_t>* degree) {
+    katana::PerThreadStorage<WalkRandom> random;
+    SeedPerThread(&random);
+
+    katana::do_all(
+        katana::iterate(uint64_t(0), walks->num_walks()),
+        [&](uint64_t idx) {
+          WalkRandom* rand = random.getLocal();
+          uint32_t* walk = walks->walk(idx);
+          walk[0] = idx % graph.size();
+
+          uint32_t length = 1;
+          for (; length <= plan_.walk_length(); length++) {
+            uint32_t curr = walk[length - 1];
+            if ((*degree)[curr] == 0) {
+              break;
+            }
+            auto e = *(graph.OutEdges(curr).begin() +
+                       rand->Below((*degree)[curr]));
+            walk[length] = graph.OutEdgeDst(e);
+          }
+          EndWalk(walk, length, *walks);
+        },
+        katana::steal(), katana::chunk_size<RandomWalksPlan::kChunkSize>(),
+        katana::loopname("First order walks"), katana::no_stats());
+    return katana::ResultSuccess();
+  }
+};
 
-      std::vector<std::vector<uint32_t>> transformed_num_edge_types_walks =
-          TransformVectors(num_edge_types_walks);
+template <typename EdgeWeightType>
+struct WeightedFirstOrderAlgo {
+  using EdgeWeight = katana::PODProperty<EdgeWeightType>;
 
-      std::vector<double> means =
-          ComputeMeans(transformed_num_edge_types_walks);
+  using NodeData = std::tuple<>;
+  using EdgeData = std::tuple<EdgeWeight>;
+
+  using Graph = katana::TypedPropertyGraphView<
+      DefaultPropertyGraphView, NodeData, EdgeData>;
+  using GNode = typename Graph::Node;
 
-      ComputeTransitionMatrix(transformed_num_edge_types_walks, means);
+  const RandomWalksPlan& plan_;
+  WeightedFirstOrderAlgo(const RandomWalksPlan& plan) : plan_(plan) {}
+
+  /// The alias tables of the out-edges of all nodes, by edge: a step from a
+  /// node picks one of its out-edges e uniformly, and takes e with
+  /// probability keep_[e] or else the out-edge at offset alias_[e] among
+  /// those of the node
+  katana::NUMAArray<float> keep_;
+  katana::NUMAArray<uint32_t> alias_;
+
+  uint64_t NumWalks(const Graph& graph) const {
+    return graph.size() * plan_.number_of_walks();
+  }
+
+  /// Build the alias tables with Vose's method ("A Linear Algorithm for
+  /// Generating Random Numbers with a Given Distribution", 1991). Nodes whose
+  /// out-edges all have weight 0 get degree 0, so that walks end there.
+  katana::Result<void> BuildAliasTables(
+      const Graph& graph, katana::NUMAArray<uint64_t>* degree) {
+    keep_.allocateBlocked(graph.NumEdges());
+    alias_.allocateBlocked(graph.NumEdges());
+
+    katana::PerThreadStorage<std::vector<double>> scaled_weights;
+    katana::PerThreadStorage<std::vector<uint32_t>> small_offsets;
+    katana::PerThreadStorage<std::vector<uint32_t>> large_offsets;
+    katana::GReduceLogicalOr invalid_weight;
+
+    katana::do_all(
+        katana::iterate(graph),
+        [&](const GNode& n) {
+          uint64_t num_edges = (*degree)[n];
+          if (num_edges == 0) {
+            return;
+          }
+          auto edges = graph.OutEdges(n).begin();
+
+          double total_weight = 0;
+          for (uint64_t i = 0; i < num_edges; i++) {
+            double weight =
+                graph.template GetEdgeData<EdgeWeight>(*(edges + i));
+            // Also catches NaN
+            if (!(weight >= 0)) {
+              invalid_weight.update(true);
+              return;
+            }
+            total_weight += weight;
+          }
+          if (total_weight == 0) {
+            (*degree)[n] = 0;
+            return;
+          }
+
+          std::vector<double>& scaled = *scaled_weights.getLocal();
+          std::vector<uint32_t>& small = *small_offsets.getLocal();
+          std::vector<uint32_t>& large = *large_offsets.getLocal();
+          scaled.resize(num_edges);
+          small.clear();
+          large.clear();
+          for (uint64_t i = 0; i < num_edges; i++) {
+            scaled[i] = graph.template GetEdgeData<EdgeWeight>(*(edges + i)) *
+                        num_edges / total_weight;
+            if (scaled[i] < 1) {
+              small.emplace_back(i);
+            } else {
+              large.emplace_back(i);
+            }
+          }
+
+          while (!small.empty() && !large.empty()) {
+            uint32_t s = small.back();
+            small.pop_back();
+            uint32_t l = large.back();
+            keep_[*(edges + s)] = scaled[s];
+            alias_[*(edges + s)] = l;
+            scaled[l] -= 1 - scaled[s];
+            if (scaled[l] < 1) {
+              large.pop_back();
+              small.emplace_back(l);
+            }
+          }
+          // Whatever is left is 1 up to rounding
+          for (uint32_t i : small) {
+            keep_[*(edges + i)] = 1;
+            alias_[*(edges + i)] = i;
+          }
+          for (uint32_t i : large) {
+            keep_[*(edges + i)] = 1;
+            alias_[*(edges + i)] = i;
+          }
+        },
+        katana::steal(), katana::loopname("BuildAliasTables"),
+        katana::no_stats());
+
+    if (invalid_weight.reduce()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "edge weights of weighted random walks must be non-negative");
     }
+    return katana::ResultSuccess();
+  }
+
+  katana::Result<void> operator()(
+      const Graph& graph, RandomWalkMatrix* walks,
+      katana::NUMAArray<uint64_t>* degree) {
+    KATANA_CHECKED(BuildAliasTables(graph, degree));
+
+    katana::PerThreadStorage<WalkRandom> random;
+    SeedPerThread(&random);
+
+    katana::do_all(
+        katana::iterate(uint64_t(0), walks->num_walks()),
+        [&](uint64_t idx) {
+          WalkRandom* rand = random.getLocal();
+          uint32_t* walk = walks->walk(idx);
+          walk[0] = idx % graph.size();
+
+          uint32_t length = 1;
+          for (; length <= plan_.walk_length(); length++) {
+            uint32_t curr = walk[length - 1];
+            if ((*degree)[curr] == 0) {
+              break;
+            }
+            auto edges = graph.OutEdges(curr).begin();
+            auto e = *(edges + rand->Below((*degree)[curr]));
+            if (rand->Unit() >= keep_[e]) {
+              e = *(edges + alias_[e]);
+            }
+            walk[length] = graph.OutEdgeDst(e);
+          }
+          EndWalk(walk, length, *walks);
+        },
+        katana::steal(), katana::chunk_size<RandomWalksPlan::kChunkSize>(),
+        katana::loopname("Weighted first order walks"), katana::no_stats());
+    return katana::ResultSuccess();
   }
 };
 
@@ -477,12 +602,61 @@ InitializeDegrees(const Graph& graph, katana::NUMAArray<uint64_t>* degree) {
   });
 }
 
+/// An arrow buffer over the memory of a NUMAArray, which it owns
+class NUMAArrayBuffer : public arrow::Buffer {
+public:
+  explicit NUMAArrayBuffer(katana::NUMAArray<uint32_t>&& array)
+      : arrow::Buffer(nullptr, 0), array_(std::move(array)) {
+    data_ = reinterpret_cast<const uint8_t*>(array_.data());
+    size_ = array_.size() * sizeof(uint32_t);
+    capacity_ = size_;
+  }
+
+private:
+  katana::NUMAArray<uint32_t> array_;
+};
+
 }  //namespace
 
+RandomWalkMatrix::RandomWalkMatrix(uint64_t num_walks, uint32_t walk_length)
+    : num_walks_(num_walks), walk_length_(walk_length) {
+  nodes_.allocateBlocked(num_walks_ * row_length());
+}
+
+katana::Result<std::shared_ptr<arrow::FixedSizeListArray>>
+RandomWalkMatrix::ToArrow() {
+  auto values = std::make_shared<arrow::UInt32Array>(
+      num_walks_ * row_length(),
+      std::make_shared<NUMAArrayBuffer>(std::move(nodes_)));
+  auto list = KATANA_CHECKED(
+      arrow::FixedSizeListArray::FromArrays(values, row_length()));
+  num_walks_ = 0;
+  return std::static_pointer_cast<arrow::FixedSizeListArray>(list);
+}
+
+std::vector<std::vector<uint32_t>>
+RandomWalkMatrix::ToVectors() const {
+  std::vector<std::vector<uint32_t>> walks_in_vector;
+  for (uint64_t i = 0; i < num_walks_; i++) {
+    const uint32_t* begin = walk(i);
+    const uint32_t* end =
+        std::find(begin, begin + row_length(), kRandomWalkEnd);
+    if (end - begin > 1) {
+      walks_in_vector.emplace_back(begin, end);
+    }
+  }
+  return walks_in_vector;
+}
+
 template <typename Algorithm>
-static katana::Result<std::vector<std::vector<uint32_t>>>
+static katana::Result<RandomWalkMatrix>
 RandomWalksWithWrap(
-    const typename Algorithm::SortedGraphView& graph, RandomWalksPlan plan) {
+    const typename Algorithm::Graph& graph, RandomWalksPlan plan) {
+  if (plan.walk_length() == 0) {
+    return KATANA_ERROR(
+        katana::ErrorCode::InvalidArgument, "walk length must be positive");
+  }
+
   katana::ReportPageAllocGuard page_alloc;
 
   Algorithm algo(plan);
@@ -493,35 +667,86 @@ RandomWalksWithWrap(
 
   katana::StatTimer execTime("RandomWalks");
   execTime.start();
-  katana::InsertBag<std::vector<uint32_t>> walks;
-  algo(graph, &walks, degree);
+  RandomWalkMatrix walks(algo.NumWalks(graph), plan.walk_length());
+  KATANA_CHECKED(algo(graph, &walks, &degree));
   execTime.stop();
 
-  std::vector<std::vector<uint32_t>> walks_in_vector;
-  walks_in_vector.reserve(plan.number_of_walks());
-  std::move(walks.begin(), walks.end(), std::back_inserter(walks_in_vector));
-  return walks_in_vector;
+  return walks;
 }
 
-katana::Result<std::vector<std::vector<uint32_t>>>
-katana::analytics::RandomWalks(PropertyGraph* pg, RandomWalksPlan plan) {
+template <typename EdgeWeightType>
+static katana::Result<RandomWalkMatrix>
+WeightedRandomWalks(
+    katana::PropertyGraph* pg, const std::string& edge_weight_property_name,
+    RandomWalksPlan plan) {
+  using Algorithm = WeightedFirstOrderAlgo<EdgeWeightType>;
+  auto graph = KATANA_CHECKED(
+      Algorithm::Graph::Make(pg, {}, {edge_weight_property_name}));
+  return RandomWalksWithWrap<Algorithm>(graph, plan);
+}
+
+katana::Result<RandomWalkMatrix>
+katana::analytics::GenerateRandomWalks(
+    PropertyGraph* pg, RandomWalksPlan plan) {
   switch (plan.algorithm()) {
   case RandomWalksPlan::kNode2Vec: {
-    auto graph =
-        KATANA_CHECKED(Node2VecAlgo::SortedGraphView::Make(pg, {}, {}));
+    auto graph = KATANA_CHECKED(Node2VecAlgo::Graph::Make(pg, {}, {}));
     return RandomWalksWithWrap<Node2VecAlgo>(graph, plan);
   }
   case RandomWalksPlan::kEdge2Vec: {
     TemporaryPropertyGuard tmp_edge_prop{pg->NodeMutablePropertyView()};
     auto graph = KATANA_CHECKED(
-        Edge2VecAlgo::SortedGraphView::Make(pg, {}, {tmp_edge_prop.name()}));
+        Edge2VecAlgo::Graph::Make(pg, {}, {tmp_edge_prop.name()}));
     return RandomWalksWithWrap<Edge2VecAlgo>(graph, plan);
   }
+  case RandomWalksPlan::kFirstOrder: {
+    auto graph = KATANA_CHECKED(FirstOrderAlgo::Graph::Make(pg, {}, {}));
+    return RandomWalksWithWrap<FirstOrderAlgo>(graph, plan);
+  }
   default:
     return ErrorCode::InvalidArgument;
   }
 }
 
+katana::Result<RandomWalkMatrix>
+katana::analytics::GenerateRandomWalks(
+    PropertyGraph* pg, const std::string& edge_weight_property_name,
+    RandomWalksPlan plan) {
+  if (plan.algorithm() != RandomWalksPlan::kFirstOrder) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "only first-order random walks support edge weights");
+  }
+
+  switch (KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+              ->type()
+              ->id()) {
+  case arrow::UInt32Type::type_id:
+    return WeightedRandomWalks<uint32_t>(pg, edge_weight_property_name, plan);
+  case arrow::Int32Type::type_id:
+    return WeightedRandomWalks<int32_t>(pg, edge_weight_property_name, plan);
+  case arrow::UInt64Type::type_id:
+    return WeightedRandomWalks<uint64_t>(pg, edge_weight_property_name, plan);
+  case arrow::Int64Type::type_id:
+    return WeightedRandomWalks<int64_t>(pg, edge_weight_property_name, plan);
+  case arrow::FloatType::type_id:
+    return WeightedRandomWalks<float>(pg, edge_weight_property_name, plan);
+  case arrow::DoubleType::type_id:
+    return WeightedRandomWalks<double>(pg, edge_weight_property_name, plan);
+  default:
+    return KATANA_ERROR(
+        ErrorCode::TypeError, "Unsupported type: {}",
+        KATANA_CHECKED(pg->GetEdgeProperty(edge_weight_property_name))
+            ->type()
+            ->ToString());
+  }
+}
+
+katana::Result<std::vector<std::vector<uint32_t>>>
+katana::analytics::RandomWalks(PropertyGraph* pg, RandomWalksPlan plan) {
+  return KATANA_CHECKED(GenerateRandomWalks(pg, plan)).ToVectors();
+}
+
 /// \cond DO_NOT_DOCUMENT
 katana::Result<void>
 katana::analytics::RandomWalksAssertValid(
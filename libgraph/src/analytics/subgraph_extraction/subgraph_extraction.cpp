@@ -31,12 +31,13 @@ using namespace katana::analytics;
 using edge_iterator = boost::counting_iterator<uint64_t>;
 
 using SortedGraphView = katana::PropertyGraphViews::EdgesSortedByDestID;
+using CompressedGraphView = katana::PropertyGraphViews::Compressed;
 using Node = SortedGraphView::Node;
 using Edge = SortedGraphView::Edge;
 
+template <typename GraphView>
 katana::Result<std::unique_ptr<katana::PropertyGraph>>
-SubGraphNodeSet(
-    const SortedGraphView& graph, const std::vector<Node>& node_set) {
+SubGraphNodeSet(const GraphView& graph, const std::vector<Node>& node_set) {
   uint64_t num_nodes = node_set.size();
   // Subgraph topology : out indices
   katana::NUMAArray<Edge> out_indices;
@@ -109,17 +110,24 @@ katana::analytics::SubGraphExtraction(
     return std::make_unique<katana::PropertyGraph>();
   }
 
-  SortedGraphView sg = pg->BuildView<SortedGraphView>();
-
   katana::StatTimer execTime("SubGraph-Extraction");
   switch (plan.algorithm()) {
   case SubGraphExtractionPlan::kNodeSet: {
+    SortedGraphView sg = pg->BuildView<SortedGraphView>();
     execTime.start();
     auto subgraph = SubGraphNodeSet(sg, dedup_node_vec);
     execTime.stop();
     KATANA_LOG_DEBUG_ASSERT(subgraph);
     return std::move(subgraph.value());
   }
+  case SubGraphExtractionPlan::kCompressedNodeSet: {
+    CompressedGraphView cg = pg->BuildView<CompressedGraphView>();
+    execTime.start();
+    auto subgraph = SubGraphNodeSet(cg, dedup_node_vec);
+    execTime.stop();
+    KATANA_LOG_DEBUG_ASSERT(subgraph);
+    return std::move(subgraph.value());
+  }
   default:
     return katana::ErrorCode::InvalidArgument;
   }
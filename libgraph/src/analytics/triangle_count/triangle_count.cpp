@@ -19,6 +19,7 @@
 
 #include "katana/analytics/triangle_count/triangle_count.h"
 
+#include "katana/SortedIntersection.h"
 #include "katana/analytics/Utils.h"
 
 using namespace katana::analytics;
@@ -60,28 +61,16 @@ LowerBound(Iterator first, Iterator last, Compare comp) {
 }
 
 /**
- * std::set_intersection over edge_iterators.
+ * Size of the intersection of the destinations of two edge ranges.
  */
 template <typename G>
 size_t
 CountEqual(
     const G& g, typename G::edge_iterator aa, typename G::edge_iterator ea,
     typename G::edge_iterator bb, typename G::edge_iterator eb) {
-  size_t retval = 0;
-  while (aa != ea && bb != eb) {
-    typename G::Node a = g.OutEdgeDst(*aa);
-    typename G::Node b = g.OutEdgeDst(*bb);
-    if (a < b) {
-      ++aa;
-    } else if (b < a) {
-      ++bb;
-    } else {
-      retval += 1;
-      ++aa;
-      ++bb;
-    }
-  }
-  return retval;
+  const typename G::Node* dests = g.DestData();
+  return katana::SortedIntersectionSize(
+      dests + *aa, std::distance(aa, ea), dests + *bb, std::distance(bb, eb));
 }
 
 template <typename G>
@@ -276,7 +265,8 @@ katana::analytics::TriangleCount(
 
   katana::StatTimer timer_relabel("GraphRelabelTimer", "TriangleCount");
   timer_relabel.start();
-  SortedGraphView sorted_view = pg->BuildView<SortedGraphView>();
+  SortedGraphView sorted_view =
+      KATANA_CHECKED(pg->MakeView<SortedGraphView>());
   timer_relabel.stop();
 
   // TODO(amber): Today we sort unconditionally. Figure out a way to re-enable the
@@ -0,0 +1,57 @@
+#ifndef KATANA_LIBGRAPH_TESTRANDOMGRAPH_H_
+#define KATANA_LIBGRAPH_TESTRANDOMGRAPH_H_
+
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "katana/GraphTopology.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+
+/// Small graphs with known edges for checking analytics against reference
+/// implementations.
+///
+/// \file TestRandomGraph.h
+
+/// The out-neighbors of each node
+using TestAdjacency = std::vector<std::set<katana::GraphTopology::Node>>;
+
+/// RandomAdjacency gives each of \p num_nodes nodes a number of out-edges
+/// drawn uniformly from [\p min_degree, \p max_degree] to uniformly drawn
+/// nodes. Repeated draws are kept once, so a node may end up with fewer
+/// out-neighbors than drawn.
+inline TestAdjacency
+RandomAdjacency(
+    size_t num_nodes, size_t min_degree, size_t max_degree, std::mt19937* gen) {
+  std::uniform_int_distribution<katana::GraphTopology::Node> any_node(
+      0, num_nodes - 1);
+  std::uniform_int_distribution<size_t> degree(min_degree, max_degree);
+
+  TestAdjacency adjacency(num_nodes);
+  for (auto& neighbors : adjacency) {
+    for (size_t i = degree(*gen); i > 0; --i) {
+      neighbors.emplace(any_node(*gen));
+    }
+  }
+  return adjacency;
+}
+
+/// MakeTestGraph makes a property graph without properties whose out-edges
+/// are \p adjacency, in ascending order of destination.
+inline std::unique_ptr<katana::PropertyGraph>
+MakeTestGraph(const TestAdjacency& adjacency) {
+  katana::AsymmetricGraphTopologyBuilder builder;
+  builder.AddNodes(adjacency.size());
+  for (katana::GraphTopology::Node n = 0; n < adjacency.size(); ++n) {
+    for (auto dst : adjacency[n]) {
+      builder.AddEdge(n, dst);
+    }
+  }
+  auto res = katana::PropertyGraph::Make(builder.ConvertToCSR());
+  KATANA_LOG_VASSERT(res, "Failed to make graph: {}", res.error());
+  return std::move(res.value());
+}
+
+#endif
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <random>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "TestRandomGraph.h"
+#include "katana/Logging.h"
+#include "katana/SharedMemSys.h"
+#include "katana/Threads.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/analytics/louvain_clustering/louvain_clustering.h"
+
+// Measures the modularity per second that LouvainClustering reaches on
+// graphs with planted communities. Compare runs before and after a change to
+// the clustering implementation, e.g., to how the weights of edges to
+// neighboring clusters are aggregated.
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+constexpr uint32_t kCommunitySize = 64;
+constexpr double kIntraCommunityFraction = 0.8;
+
+// A symmetric graph in which most edges of a node go to one of the
+// kCommunitySize nodes of its community
+std::unique_ptr<katana::PropertyGraph>
+MakePlantedGraph(uint32_t num_nodes, uint32_t degree) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<Node> any_node(0, num_nodes - 1);
+  std::uniform_int_distribution<Node> community_node(0, kCommunitySize - 1);
+  std::bernoulli_distribution intra(kIntraCommunityFraction);
+
+  TestAdjacency adjacency(num_nodes);
+  for (Node n = 0; n < num_nodes; ++n) {
+    for (uint32_t i = 0; i < degree / 2; ++i) {
+      Node dst = any_node(gen);
+      if (intra(gen)) {
+        dst = std::min(
+            n / kCommunitySize * kCommunitySize + community_node(gen),
+            num_nodes - 1);
+      }
+      adjacency[n].emplace(dst);
+      adjacency[dst].emplace(n);
+    }
+  }
+
+  std::unique_ptr<katana::PropertyGraph> pg = MakeTestGraph(adjacency);
+  katana::TxnContext txn_ctx;
+  auto weight_res = katana::AddEdgeProperties(
+      pg.get(), &txn_ctx,
+      katana::PropertyGenerator("weight", [](auto) { return uint32_t{1}; }));
+  KATANA_LOG_VASSERT(
+      weight_res, "Failed to add edge properties: {}", weight_res.error());
+  return pg;
+}
+
+void
+RunLouvain(benchmark::State& state, const LouvainClusteringPlan& plan) {
+  std::unique_ptr<katana::PropertyGraph> pg =
+      MakePlantedGraph(state.range(0), state.range(1));
+  katana::TxnContext txn_ctx;
+
+  double total_modularity = 0;
+  double modularity = 0;
+  for (auto _ : state) {
+    auto res = LouvainClustering(
+        pg.get(), "weight", "cluster", &txn_ctx, true, plan);
+    KATANA_LOG_VASSERT(res, "LouvainClustering: {}", res.error());
+
+    state.PauseTiming();
+    auto stats_res = LouvainClusteringStatistics::Compute(
+        pg.get(), "weight", "cluster", &txn_ctx);
+    KATANA_LOG_VASSERT(stats_res, "Compute: {}", stats_res.error());
+    modularity = stats_res.value().modularity;
+    total_modularity += modularity;
+    auto remove_res = pg->RemoveNodeProperty("cluster", &txn_ctx);
+    KATANA_LOG_VASSERT(
+        remove_res, "RemoveNodeProperty: {}", remove_res.error());
+    state.ResumeTiming();
+  }
+
+  state.counters["modularity"] = modularity;
+  state.counters["modularity_per_second"] =
+      benchmark::Counter(total_modularity, benchmark::Counter::kIsRate);
+}
+
+void
+LouvainDoAll(benchmark::State& state) {
+  RunLouvain(state, LouvainClusteringPlan::DoAll());
+}
+
+void
+LouvainDeterministic(benchmark::State& state) {
+  RunLouvain(state, LouvainClusteringPlan::Deterministic());
+}
+
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  for (long num_nodes : {1 << 14, 1 << 18}) {
+    for (long degree : {8, 64}) {
+      b->Args({num_nodes, degree});
+    }
+  }
+}
+
+BENCHMARK(LouvainDoAll)->Apply(MakeArguments)->UseRealTime();
+BENCHMARK(LouvainDeterministic)->Apply(MakeArguments)->UseRealTime();
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  ::benchmark::Initialize(&argc, argv);
+  katana::SharedMemSys G;
+  katana::setActiveThreads(std::thread::hardware_concurrency());
+  ::benchmark::RunSpecifiedBenchmarks();
+}
@@ -0,0 +1,174 @@
+#include <map>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/ClusteringImplementationBase.h"
+
+namespace {
+
+using katana::analytics::CoarsenedGraph;
+using katana::analytics::CurrentCommunityID;
+using Weight = katana::analytics::EdgeWeight<int64_t>;
+using Graph = CoarsenedGraph<std::tuple<CurrentCommunityID>, int64_t>;
+using ClusterWeights = std::map<std::pair<uint64_t, uint64_t>, int64_t>;
+
+template <typename InputGraph, typename ClusterFn>
+ClusterWeights
+SumClusterWeights(
+    const InputGraph& graph, uint64_t num_clusters,
+    const ClusterFn& cluster_of) {
+  ClusterWeights weights;
+  for (auto n : graph) {
+    if (cluster_of(n) >= num_clusters) {
+      continue;
+    }
+    for (auto e : katana::Edges(graph, n)) {
+      weights[{cluster_of(n), cluster_of(katana::EdgeDst(graph, e))}] +=
+          graph.template GetEdgeData<Weight>(e);
+    }
+  }
+  return weights;
+}
+
+template <typename InputGraph, typename ClusterFn>
+Graph
+CheckCoarsening(
+    const InputGraph& graph, uint64_t num_clusters,
+    const ClusterFn& cluster_of) {
+  Graph coarsened = Graph::Make(graph, num_clusters, cluster_of);
+  ClusterWeights expected = SumClusterWeights(graph, num_clusters, cluster_of);
+
+  KATANA_LOG_ASSERT(coarsened.NumNodes() == num_clusters);
+  KATANA_LOG_VASSERT(
+      coarsened.NumEdges() == expected.size(), "{} edges, expected {}",
+      coarsened.NumEdges(), expected.size());
+
+  // Edges of a node are sorted by destination
+  auto it = expected.begin();
+  for (auto n : coarsened) {
+    KATANA_LOG_ASSERT(coarsened.GetData<CurrentCommunityID>(n) == 0);
+    for (auto e : coarsened.OutEdges(n)) {
+      KATANA_LOG_ASSERT(it->first.first == n);
+      KATANA_LOG_ASSERT(it->first.second == coarsened.OutEdgeDst(e));
+      KATANA_LOG_VASSERT(
+          it->second == coarsened.GetEdgeData<Weight>(e),
+          "weight {} from {} to {}, expected {}",
+          coarsened.GetEdgeData<Weight>(e), n, coarsened.OutEdgeDst(e),
+          it->second);
+      ++it;
+    }
+  }
+  return coarsened;
+}
+
+template <typename GraphViewTy>
+void
+TestCoarsening(katana::PropertyGraph* pg) {
+  using InputGraph = katana::TypedPropertyGraphView<
+      GraphViewTy, std::tuple<>, std::tuple<Weight>>;
+  auto input_res = InputGraph::Make(pg, {}, {"weight"});
+  KATANA_LOG_VASSERT(
+      input_res, "Failed to create view: {}", input_res.error());
+  InputGraph input = input_res.value();
+
+  Graph copy = Graph::Copy(input);
+  KATANA_LOG_ASSERT(copy.NumNodes() == input.NumNodes());
+  CheckCoarsening(input, input.NumNodes(), [](auto n) { return uint64_t{n}; });
+
+  uint64_t num_pairs = (input.NumNodes() + 1) / 2;
+  Graph pairs = CheckCoarsening(input, num_pairs, [](auto n) {
+    return uint64_t{n / 2};
+  });
+
+  Graph all = CheckCoarsening(pairs, 1, [](auto) { return uint64_t{0}; });
+  KATANA_LOG_ASSERT(all.NumEdges() == 1);
+}
+
+// Vertex following takes degrees from the input graph, where 3 has two
+// parallel edges to its only neighbor 2, so 3 must not follow 2 although its
+// copy has a single edge to 2
+template <typename GraphViewTy>
+void
+TestVertexFollowing(katana::PropertyGraph* pg) {
+  using InputGraph = katana::TypedPropertyGraphView<
+      GraphViewTy, std::tuple<>, std::tuple<Weight>>;
+  using Base = katana::analytics::ClusteringImplementationBase<
+      Graph, int64_t, katana::analytics::CommunityType<int64_t>>;
+  auto input_res = InputGraph::Make(pg, {}, {"weight"});
+  KATANA_LOG_VASSERT(
+      input_res, "Failed to create view: {}", input_res.error());
+  InputGraph input = input_res.value();
+
+  Graph copy = Graph::Copy(input);
+  Base::VertexFollowing(input, &copy);
+
+  // 0 follows 1, 4 is isolated
+  std::vector<uint64_t> expected{1, 1, 2, 3, Base::UNASSIGNED};
+  for (auto n : copy) {
+    KATANA_LOG_VASSERT(
+        copy.GetData<CurrentCommunityID>(n) == expected[n],
+        "node {} is in cluster {}, expected {}", n,
+        copy.GetData<CurrentCommunityID>(n), expected[n]);
+  }
+}
+
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph(const std::vector<std::pair<uint32_t, uint32_t>>& edges) {
+  constexpr size_t kNumNodes = 5;
+  std::vector<katana::GraphTopology::Edge> adj_indices(kNumNodes);
+  std::vector<katana::GraphTopology::Node> dests;
+  for (const auto& [src, dst] : edges) {
+    ++adj_indices[src];
+    dests.emplace_back(dst);
+  }
+  std::partial_sum(
+      adj_indices.begin(), adj_indices.end(), adj_indices.begin());
+
+  katana::GraphTopology topo{
+      adj_indices.data(), adj_indices.size(), dests.data(), dests.size()};
+  auto pg_res = katana::PropertyGraph::Make(std::move(topo));
+  KATANA_LOG_VASSERT(pg_res, "Failed to make graph: {}", pg_res.error());
+  std::unique_ptr<katana::PropertyGraph> pg = std::move(pg_res.value());
+
+  katana::TxnContext txn_ctx;
+  auto res = katana::AddEdgeProperties(
+      pg.get(), &txn_ctx,
+      katana::PropertyGenerator("weight", [](auto) { return int64_t{1}; }));
+  KATANA_LOG_VASSERT(res, "Failed to add edge properties: {}", res.error());
+  return pg;
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  // Clusters of a Ferris wheel have edges between them in both directions
+  // and parallel edges from their nodes to the center
+  std::unique_ptr<katana::PropertyGraph> pg = katana::MakeFerrisWheel(10);
+  katana::TxnContext txn_ctx;
+  auto res = katana::AddEdgeProperties(
+      pg.get(), &txn_ctx, katana::PropertyGenerator("weight", [](auto e) {
+        return static_cast<int64_t>(e % 3 + 1);
+      }));
+  KATANA_LOG_VASSERT(res, "Failed to add edge properties: {}", res.error());
+
+  TestCoarsening<katana::PropertyGraphViews::Default>(pg.get());
+  TestCoarsening<katana::PropertyGraphViews::Undirected>(pg.get());
+
+  // Edges sorted by source, each stored once or in both directions
+  std::unique_ptr<katana::PropertyGraph> asymmetric =
+      MakeGraph({{0, 1}, {1, 2}, {3, 2}, {3, 2}});
+  TestVertexFollowing<katana::PropertyGraphViews::Undirected>(
+      asymmetric.get());
+  std::unique_ptr<katana::PropertyGraph> symmetric = MakeGraph(
+      {{0, 1}, {1, 0}, {1, 2}, {2, 1}, {2, 3}, {2, 3}, {3, 2}, {3, 2}});
+  TestVertexFollowing<katana::PropertyGraphViews::Default>(symmetric.get());
+
+  return 0;
+}
@@ -0,0 +1,204 @@
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "TestRandomGraph.h"
+#include "katana/GraphReordering.h"
+#include "katana/SharedMemSys.h"
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+constexpr size_t kNumNodes = 1000;
+constexpr size_t kCommunitySize = 50;
+
+// A directed graph of dense communities whose members are scattered over the
+// node ids, plus a few isolated nodes. The value of node property "id" and of
+// edge property "src" is the node id of the node and the source of the edge.
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph() {
+  std::mt19937 gen(42);
+  std::vector<Node> scatter(kNumNodes);
+  std::iota(scatter.begin(), scatter.end(), 0);
+  std::shuffle(scatter.begin(), scatter.end(), gen);
+  std::uniform_int_distribution<size_t> member(0, kCommunitySize - 1);
+  std::uniform_int_distribution<size_t> degree(0, 8);
+
+  TestAdjacency edges(kNumNodes);
+  for (size_t i = 0; i + 10 < kNumNodes; ++i) {
+    size_t community = i / kCommunitySize * kCommunitySize;
+    for (size_t j = degree(gen); j > 0; --j) {
+      size_t k = std::min(community + member(gen), kNumNodes - 11);
+      edges[scatter[i]].emplace(scatter[k]);
+    }
+  }
+
+  std::unique_ptr<katana::PropertyGraph> pg = MakeTestGraph(edges);
+
+  arrow::UInt32Builder ids;
+  arrow::UInt32Builder srcs;
+  for (Node n = 0; n < kNumNodes; ++n) {
+    KATANA_LOG_ASSERT(ids.Append(n).ok());
+    for (size_t i = 0; i < edges[n].size(); ++i) {
+      KATANA_LOG_ASSERT(srcs.Append(n).ok());
+    }
+  }
+  std::shared_ptr<arrow::Array> id_array;
+  KATANA_LOG_ASSERT(ids.Finish(&id_array).ok());
+  std::shared_ptr<arrow::Array> src_array;
+  KATANA_LOG_ASSERT(srcs.Finish(&src_array).ok());
+  katana::TxnContext txn_ctx;
+  auto node_res = pg->AddNodeProperties(
+      arrow::Table::Make(
+          arrow::schema({arrow::field("id", arrow::uint32())}), {id_array}),
+      &txn_ctx);
+  KATANA_LOG_VASSERT(node_res, "Failed to add ids: {}", node_res.error());
+  auto edge_res = pg->AddEdgeProperties(
+      arrow::Table::Make(
+          arrow::schema({arrow::field("src", arrow::uint32())}), {src_array}),
+      &txn_ctx);
+  KATANA_LOG_VASSERT(edge_res, "Failed to add srcs: {}", edge_res.error());
+  return pg;
+}
+
+std::set<Node>
+OutNeighbors(const katana::GraphTopology& topology, Node n) {
+  std::set<Node> neighbors;
+  for (auto e : topology.OutEdges(n)) {
+    neighbors.emplace(topology.OutEdgeDst(e));
+  }
+  return neighbors;
+}
+
+void
+CheckPermutation(const katana::NUMAArray<Node>& new_to_old) {
+  KATANA_LOG_ASSERT(new_to_old.size() == kNumNodes);
+  std::vector<bool> seen(kNumNodes);
+  for (Node old_id : new_to_old) {
+    KATANA_LOG_ASSERT(old_id < kNumNodes && !seen[old_id]);
+    seen[old_id] = true;
+  }
+}
+
+// Checks that node i of reordered is node new_to_old[i] of pg, with its
+// edges and properties
+void
+CheckPermuted(
+    const katana::PropertyGraph& pg, const katana::PropertyGraph& reordered,
+    const katana::NUMAArray<Node>& new_to_old) {
+  std::vector<Node> old_to_new(kNumNodes);
+  for (Node n = 0; n < kNumNodes; ++n) {
+    old_to_new[new_to_old[n]] = n;
+  }
+  const auto& topology = reordered.topology();
+  KATANA_LOG_ASSERT(topology.NumEdges() == pg.topology().NumEdges());
+
+  auto ids = reordered.GetNodePropertyTyped<uint32_t>("id").value();
+  auto srcs = reordered.GetEdgePropertyTyped<uint32_t>("src").value();
+  for (Node n = 0; n < kNumNodes; ++n) {
+    Node old_id = new_to_old[n];
+    KATANA_LOG_ASSERT(ids->Value(n) == old_id);
+    std::set<Node> expected;
+    for (Node dst : OutNeighbors(pg.topology(), old_id)) {
+      expected.emplace(old_to_new[dst]);
+    }
+    KATANA_LOG_ASSERT(OutNeighbors(topology, n) == expected);
+    for (auto e : topology.OutEdges(n)) {
+      KATANA_LOG_ASSERT(srcs->Value(e) == old_id);
+    }
+  }
+}
+
+void
+TestOrders(const katana::PropertyGraph& pg) {
+  for (auto kind :
+       {katana::ReorderingKind::kDegree,
+        katana::ReorderingKind::kDegreeGrouping, katana::ReorderingKind::kRCM,
+        katana::ReorderingKind::kGorder, katana::ReorderingKind::kRabbit}) {
+    auto order_res = katana::ComputeNodeOrder(pg.topology(), kind);
+    KATANA_LOG_VASSERT(order_res, "ComputeNodeOrder: {}", order_res.error());
+    CheckPermutation(order_res.value());
+
+    katana::TxnContext txn_ctx;
+    auto reordered_res = katana::PermuteNodes(&pg, order_res.value(), &txn_ctx);
+    KATANA_LOG_VASSERT(
+        reordered_res, "PermuteNodes: {}", reordered_res.error());
+    CheckPermuted(pg, *reordered_res.value(), order_res.value());
+  }
+
+  // Degree order puts nodes with more out-edges first
+  auto degree_order =
+      katana::ComputeNodeOrder(pg.topology(), katana::ReorderingKind::kDegree)
+          .value();
+  for (Node n = 1; n < kNumNodes; ++n) {
+    KATANA_LOG_ASSERT(
+        pg.topology().OutDegree(degree_order[n - 1]) >=
+        pg.topology().OutDegree(degree_order[n]));
+  }
+}
+
+void
+TestInvalidOrder(const katana::PropertyGraph& pg) {
+  katana::TxnContext txn_ctx;
+  katana::NUMAArray<Node> short_order;
+  short_order.allocateBlocked(kNumNodes - 1);
+  std::iota(short_order.begin(), short_order.end(), 0);
+  KATANA_LOG_ASSERT(!katana::PermuteNodes(&pg, short_order, &txn_ctx));
+
+  katana::NUMAArray<Node> repeated;
+  repeated.allocateBlocked(kNumNodes);
+  std::iota(repeated.begin(), repeated.end(), 0);
+  repeated[1] = 0;
+  KATANA_LOG_ASSERT(!katana::PermuteNodes(&pg, repeated, &txn_ctx));
+
+  auto seed = katana::EdgeShuffleTopology::MakeOriginalCopy(&pg);
+  KATANA_LOG_ASSERT(!katana::ShuffleTopology::MakeFromTopo(
+      &pg, *seed, katana::RDGTopology::NodeSortKind::kInvalid,
+      katana::RDGTopology::EdgeSortKind::kAny));
+}
+
+template <typename View>
+void
+TestView(katana::PropertyGraph* pg) {
+  auto view_res = pg->MakeView<View>();
+  KATANA_LOG_VASSERT(view_res, "Failed to make view: {}", view_res.error());
+  View view = std::move(view_res.value());
+  KATANA_LOG_ASSERT(view.NumNodes() == kNumNodes);
+  KATANA_LOG_ASSERT(view.NumEdges() == pg->topology().NumEdges());
+  std::vector<bool> seen(kNumNodes);
+  for (auto n : view.Nodes()) {
+    Node old_id = view.GetLocalNodeID(n);
+    KATANA_LOG_ASSERT(!seen[old_id]);
+    seen[old_id] = true;
+    std::set<Node> neighbors;
+    for (auto e : view.OutEdges(n)) {
+      neighbors.emplace(view.GetLocalNodeID(view.OutEdgeDst(e)));
+    }
+    KATANA_LOG_ASSERT(neighbors == OutNeighbors(pg->topology(), old_id));
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(4);
+
+  std::unique_ptr<katana::PropertyGraph> pg = MakeGraph();
+  TestOrders(*pg);
+  TestInvalidOrder(*pg);
+
+  using Views = katana::PropertyGraphViews;
+  TestView<Views::NodesReorderedByDegreeGroupingEdgesSortedByDestID>(pg.get());
+  TestView<Views::NodesReorderedByRCMEdgesSortedByDestID>(pg.get());
+  TestView<Views::NodesReorderedByGorderEdgesSortedByDestID>(pg.get());
+  TestView<Views::NodesReorderedByRabbitEdgesSortedByDestID>(pg.get());
+
+  return 0;
+}
@@ -1,3 +1,5 @@
+#include <cstdlib>
+
 #include <arrow/api.h>
 #include <boost/filesystem.hpp>
 
@@ -349,6 +351,135 @@ TestRoundTrip() {
   }
 }
 
+void
+TestMappedRoundTrip() {
+  constexpr size_t test_length = 10;
+  katana::TxnContext txn_ctx;
+
+  RandomPolicy policy{1};
+  auto g = MakeFileGraph<uint32_t>(test_length, 0, &policy, &txn_ctx);
+
+  auto add_node_result = g->AddNodeProperties(
+      MakeProps<int32_t>("node-name", test_length), &txn_ctx);
+  KATANA_LOG_ASSERT(add_node_result);
+  auto add_edge_result = g->AddEdgeProperties(
+      MakeProps<int64_t>("edge-name", test_length), &txn_ctx);
+  KATANA_LOG_ASSERT(add_edge_result);
+
+  auto uri_res = katana::URI::MakeRand("/tmp/propertyfilegraph");
+  KATANA_LOG_ASSERT(uri_res);
+  auto rdg_dir = uri_res.value();
+
+  // fixed width properties become Arrow IPC files
+  setenv("KATANA_ARROW_PROPERTY_FILES", "1", 1);
+  auto write_result = g->Write(rdg_dir, command_line, &txn_ctx);
+  unsetenv("KATANA_ARROW_PROPERTY_FILES");
+  if (!write_result) {
+    fs::remove_all(rdg_dir.path());
+    KATANA_LOG_FATAL("writing result: {}", write_result.error());
+  }
+
+  size_t num_arrow_files = 0;
+  for (const auto& entry : fs::directory_iterator(rdg_dir.path())) {
+    if (entry.path().extension() == ".arrow") {
+      ++num_arrow_files;
+    }
+  }
+  KATANA_LOG_VASSERT(
+      num_arrow_files >= 2, "found {} arrow files", num_arrow_files);
+
+  for (bool map_local_files : {false, true}) {
+    katana::RDGLoadOptions opts;
+    opts.map_local_files = map_local_files;
+    auto make_result = katana::PropertyGraph::Make(rdg_dir, &txn_ctx, opts);
+    if (!make_result) {
+      fs::remove_all(rdg_dir.path());
+      KATANA_LOG_FATAL("making result: {}", make_result.error());
+    }
+    std::unique_ptr<katana::PropertyGraph> g2 = std::move(make_result.value());
+
+    KATANA_LOG_ASSERT(g2->topology().IsMapped() == map_local_files);
+    KATANA_LOG_ASSERT(g->Equals(g2.get()));
+  }
+  fs::remove_all(rdg_dir.path());
+}
+
+void
+TestPropertyRange(bool fixed_width_as_arrow) {
+  constexpr int64_t test_length = 1000;
+  constexpr int64_t rows_per_zone = 100;
+  katana::TxnContext txn_ctx;
+
+  RandomPolicy policy{1};
+  auto g = MakeFileGraph<uint32_t>(test_length, 0, &policy, &txn_ctx);
+
+  arrow::Int64Builder builder;
+  for (int64_t i = 0; i < test_length; ++i) {
+    KATANA_LOG_ASSERT(builder.Append(i).ok());
+  }
+  std::shared_ptr<arrow::Array> ids;
+  KATANA_LOG_ASSERT(builder.Finish(&ids).ok());
+  auto schema = arrow::schema({arrow::field("id", arrow::int64())});
+  auto add_node_result =
+      g->AddNodeProperties(arrow::Table::Make(schema, {ids}), &txn_ctx);
+  KATANA_LOG_ASSERT(add_node_result);
+
+  auto opts = katana::ParquetWriter::WriteOpts::Properties();
+  opts.max_row_group_rows = rows_per_zone;
+  opts.fixed_width_as_arrow = fixed_width_as_arrow;
+  g->SetNodePropertyWriteOpts("id", opts);
+
+  auto uri_res = katana::URI::MakeRand("/tmp/propertyfilegraph");
+  KATANA_LOG_ASSERT(uri_res);
+  auto rdg_dir = uri_res.value();
+
+  auto write_result = g->Write(rdg_dir, command_line, &txn_ctx);
+  if (!write_result) {
+    fs::remove_all(rdg_dir.path());
+    KATANA_LOG_FATAL("writing result: {}", write_result.error());
+  }
+
+  // leave the property on storage; ranges are read without loading it
+  katana::RDGLoadOptions load_opts;
+  load_opts.node_properties = std::vector<std::string>{};
+  auto make_result = katana::PropertyGraph::Make(rdg_dir, &txn_ctx, load_opts);
+  if (!make_result) {
+    fs::remove_all(rdg_dir.path());
+    KATANA_LOG_FATAL("making result: {}", make_result.error());
+  }
+  std::unique_ptr<katana::PropertyGraph> g2 = std::move(make_result.value());
+  KATANA_LOG_ASSERT(!g2->HasNodeProperty("id"));
+
+  // ids [150, 420] are in the zones of [100, 500), which are merged
+  std::vector<katana::ParquetReader::Slice> slices;
+  auto range_result = g2->ReadNodePropertyRange(
+      "id", int64_t{150}, int64_t{420}, &slices);
+  auto empty_result = g2->ReadNodePropertyRange(
+      "id", int64_t{test_length}, int64_t{2 * test_length});
+  fs::remove_all(rdg_dir.path());
+  KATANA_LOG_VASSERT(range_result, "reading range: {}", range_result.error());
+  KATANA_LOG_VASSERT(empty_result, "reading range: {}", empty_result.error());
+
+  KATANA_LOG_ASSERT(slices.size() == 1);
+  KATANA_LOG_ASSERT(slices[0].offset == rows_per_zone);
+  KATANA_LOG_ASSERT(slices[0].length == 4 * rows_per_zone);
+
+  std::shared_ptr<arrow::Table> range = range_result.value();
+  KATANA_LOG_ASSERT(range->num_columns() == 1);
+  KATANA_LOG_ASSERT(range->field(0)->name() == "id");
+  KATANA_LOG_ASSERT(range->num_rows() == 4 * rows_per_zone);
+  int64_t expected = rows_per_zone;
+  for (const auto& chunk : range->column(0)->chunks()) {
+    auto values = std::static_pointer_cast<arrow::Int64Array>(chunk);
+    for (int64_t i = 0; i < values->length(); ++i) {
+      KATANA_LOG_ASSERT(values->Value(i) == expected++);
+    }
+  }
+
+  KATANA_LOG_ASSERT(empty_result.value()->num_rows() == 0);
+  KATANA_LOG_ASSERT(empty_result.value()->field(0)->name() == "id");
+}
+
 void
 TestGarbageMetadata() {
   auto uri_res = katana::URI::MakeRand("/tmp/propertyfilegraph");
@@ -468,6 +599,9 @@ main(int argc, char** argv) {
   command_line = cmdout.str();
 
   TestRoundTrip();
+  TestMappedRoundTrip();
+  TestPropertyRange(false);
+  TestPropertyRange(true);
   TestGarbageMetadata();
   TestSimplePGs();
   TestTopologyAccess();
@@ -0,0 +1,116 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+
+using namespace katana;
+using Edge = PropertyGraph::Edge;
+using Node = PropertyGraph::Node;
+using CompressedGraphView = PropertyGraphViews::Compressed;
+using SortedGraphView = PropertyGraphViews::EdgesSortedByDestID;
+
+void
+CheckSameAsSorted(
+    const CompressedGraphView& compressed, const SortedGraphView& sorted) {
+  KATANA_LOG_ASSERT(compressed.NumNodes() == sorted.NumNodes());
+  KATANA_LOG_ASSERT(compressed.NumEdges() == sorted.NumEdges());
+
+  for (Node n : sorted.Nodes()) {
+    KATANA_LOG_VASSERT(
+        compressed.OutDegree(n) == sorted.OutDegree(n),
+        "Degrees do not match");
+    for (Edge e : sorted.OutEdges(n)) {
+      KATANA_LOG_VASSERT(
+          compressed.OutEdgeDst(e) == sorted.OutEdgeDst(e),
+          "Edge destinations do not match");
+      KATANA_LOG_VASSERT(
+          compressed.GetEdgePropertyIndexFromOutEdge(e) ==
+              sorted.GetEdgePropertyIndexFromOutEdge(e),
+          "Edge property indices do not match");
+      KATANA_LOG_VASSERT(
+          compressed.GetEdgeSrc(e) == n, "Edge sources do not match");
+      KATANA_LOG_VASSERT(
+          *compressed.FindEdge(n, sorted.OutEdgeDst(e)) ==
+              *sorted.FindEdge(n, sorted.OutEdgeDst(e)),
+          "Found edges do not match");
+    }
+    KATANA_LOG_VASSERT(
+        !compressed.HasEdge(n, sorted.NumNodes()),
+        "Found an edge that does not exist");
+  }
+
+  // random access in reverse order defeats the per-thread block cache
+  for (Edge e = compressed.NumEdges(); e > 0; --e) {
+    KATANA_LOG_VASSERT(
+        compressed.OutEdgeDst(e - 1) == sorted.OutEdgeDst(e - 1),
+        "Edge destinations do not match");
+  }
+}
+
+// Checks that the memory that a compressed copy of \p seed uses, everything
+// included, is less than a plain CSR with the same edges and no edge property
+// indices
+void
+CheckSmallerThanPlain(const GraphTopology& seed, const std::string& name) {
+  std::shared_ptr<CompressedTopology> compressed =
+      CompressedTopology::MakeFrom(seed);
+  size_t plain =
+      seed.NumNodes() * sizeof(Edge) + seed.NumEdges() * sizeof(Node);
+  KATANA_LOG_VASSERT(
+      compressed->SizeInBytes() < plain,
+      "compressed {} takes {} bytes, plain {}", name,
+      compressed->SizeInBytes(), plain);
+}
+
+Result<void>
+TestUnsortedGraph() {
+  constexpr size_t kNumNodes = 1000;
+  constexpr size_t kEdgesPerNode = 100;
+
+  auto pg = KATANA_CHECKED(PropertyGraph::Make(
+      CreateUniformRandomTopology(kNumNodes, kEdgesPerNode)));
+
+  auto compressed = pg->BuildView<CompressedGraphView>();
+  auto sorted = pg->BuildView<SortedGraphView>();
+
+  CheckSameAsSorted(compressed, sorted);
+
+  // Sorting permutes edges, so the compressed topology keeps the edge
+  // property indices too
+  auto sorted_topo = EdgeShuffleTopology::Make(
+      pg.get(), RDGTopology::TransposeKind::kNo,
+      RDGTopology::EdgeSortKind::kSortedByDestID);
+  CheckSmallerThanPlain(*sorted_topo, "unsorted graph");
+
+  return katana::ResultSuccess();
+}
+
+Result<void>
+TestSortedGraph() {
+  // A grid has sorted adjacency lists with small gaps, the best case for
+  // delta encoding.
+  std::unique_ptr<PropertyGraph> pg = MakeGrid(100, 100, true);
+
+  auto compressed = pg->BuildView<CompressedGraphView>();
+  auto sorted = pg->BuildView<SortedGraphView>();
+
+  CheckSameAsSorted(compressed, sorted);
+  CheckSmallerThanPlain(pg->topology(), "sorted graph");
+
+  return katana::ResultSuccess();
+}
+
+int
+main() {
+  SharedMemSys sys;
+
+  auto res = TestUnsortedGraph();
+  KATANA_LOG_ASSERT(res);
+
+  res = TestSortedGraph();
+  KATANA_LOG_ASSERT(res);
+
+  return 0;
+}
@@ -0,0 +1,303 @@
+#include <arrow/api.h>
+#include <boost/filesystem.hpp>
+
+#include "TestTypedPropertyGraph.h"
+#include "katana/HashIndex.h"
+#include "katana/Logging.h"
+#include "katana/PropertyGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/URI.h"
+
+namespace {
+
+namespace fs = boost::filesystem;
+
+constexpr int64_t kNumTypes = 7;
+
+std::string
+ExternalID(size_t i) {
+  return "id" + std::to_string(i / kNumTypes);
+}
+
+// Creates a type column (i % kNumTypes), an external id column that is only
+// unique together with the type and a column that is null for every third
+// entity.
+std::shared_ptr<arrow::Table>
+CreateProperties(size_t num_rows) {
+  arrow::Int64Builder type_builder;
+  arrow::LargeStringBuilder id_builder;
+  arrow::UInt64Builder sparse_builder;
+  for (size_t i = 0; i < num_rows; ++i) {
+    KATANA_LOG_ASSERT(type_builder.Append(i % kNumTypes).ok());
+    KATANA_LOG_ASSERT(id_builder.Append(ExternalID(i)).ok());
+    if (i % 3 == 0) {
+      KATANA_LOG_ASSERT(sparse_builder.AppendNull().ok());
+    } else {
+      KATANA_LOG_ASSERT(sparse_builder.Append(i / 2).ok());
+    }
+  }
+
+  std::shared_ptr<arrow::Array> type_array;
+  std::shared_ptr<arrow::Array> id_array;
+  std::shared_ptr<arrow::Array> sparse_array;
+  KATANA_LOG_ASSERT(type_builder.Finish(&type_array).ok());
+  KATANA_LOG_ASSERT(id_builder.Finish(&id_array).ok());
+  KATANA_LOG_ASSERT(sparse_builder.Finish(&sparse_array).ok());
+
+  return arrow::Table::Make(
+      arrow::schema(
+          {arrow::field("type", arrow::int64()),
+           arrow::field("external_id", arrow::large_utf8()),
+           arrow::field("sparse", arrow::uint64())}),
+      {type_array, id_array, sparse_array});
+}
+
+template <typename node_or_edge>
+void
+CheckIndex(const katana::HashIndex<node_or_edge>& index, size_t num_entities) {
+  using Key = typename katana::HashIndex<node_or_edge>::Key;
+
+  if (index.property_names().size() == 1) {
+    // Single column index over the type.
+    size_t num_found = 0;
+    for (int64_t type = 0; type < kNumTypes; ++type) {
+      auto range_res = index.Find(Key{type});
+      KATANA_LOG_VASSERT(range_res, "Find failed: {}", range_res.error());
+      node_or_edge prev = 0;
+      bool first = true;
+      for (node_or_edge id : range_res.value()) {
+        KATANA_LOG_VASSERT(
+            static_cast<int64_t>(id % kNumTypes) == type,
+            "id {} found for type {}", id, type);
+        KATANA_LOG_ASSERT(first || prev < id);
+        prev = id;
+        first = false;
+        ++num_found;
+      }
+    }
+    KATANA_LOG_ASSERT(num_found == num_entities);
+    KATANA_LOG_ASSERT(index.num_keys() == kNumTypes);
+
+    auto missing_res = index.Find(Key{kNumTypes});
+    KATANA_LOG_ASSERT(missing_res && missing_res.value().empty());
+
+    // Wrong type of key value
+    KATANA_LOG_ASSERT(!index.Find(Key{uint64_t{1}}));
+    // Wrong number of key values
+    KATANA_LOG_ASSERT(!index.Find(Key{int64_t{1}, int64_t{1}}));
+    return;
+  }
+
+  // Composite index over (type, external id).
+  for (size_t i = 0; i < num_entities; ++i) {
+    std::string external_id = ExternalID(i);
+    int64_t type = i % kNumTypes;
+    auto range_res = index.Find(Key{type, std::string_view(external_id)});
+    KATANA_LOG_VASSERT(range_res, "Find failed: {}", range_res.error());
+    auto range = range_res.value();
+    KATANA_LOG_VASSERT(range.size() == 1, "{} entities for key", range.size());
+    KATANA_LOG_ASSERT(*range.begin() == i);
+  }
+  KATANA_LOG_ASSERT(index.num_keys() == num_entities);
+
+  auto missing_res = index.Find(Key{int64_t{0}, std::string_view("id")});
+  KATANA_LOG_ASSERT(missing_res && missing_res.value().empty());
+}
+
+void
+TestNodeIndexes(size_t num_nodes) {
+  LinePolicy policy{3};
+  katana::TxnContext txn_ctx;
+  std::unique_ptr<katana::PropertyGraph> g =
+      MakeFileGraph<int64_t>(num_nodes, 0, &policy, &txn_ctx);
+  KATANA_LOG_ASSERT(
+      g->AddNodeProperties(CreateProperties(num_nodes), &txn_ctx));
+
+  std::vector<std::string> type{"type"};
+  std::vector<std::string> composite{"type", "external_id"};
+  KATANA_LOG_ASSERT(g->MakeNodeHashIndex(type));
+  KATANA_LOG_ASSERT(g->MakeNodeHashIndex(composite));
+  KATANA_LOG_ASSERT(!g->MakeNodeHashIndex(type));
+
+  auto type_index = g->GetNodeHashIndex(type).value();
+  auto composite_index = g->GetNodeHashIndex(composite).value();
+  CheckIndex(*type_index, num_nodes);
+  CheckIndex(*composite_index, num_nodes);
+
+  // Entities with null values are not indexed.
+  std::vector<std::string> sparse{"sparse"};
+  KATANA_LOG_ASSERT(g->MakeNodeHashIndex(sparse));
+  auto sparse_index = g->GetNodeHashIndex(sparse).value();
+  KATANA_LOG_ASSERT(sparse_index->size() == num_nodes - (num_nodes + 2) / 3);
+  auto range = sparse_index->Find({uint64_t{2}}).value();
+  KATANA_LOG_ASSERT(range.size() == 2);
+  KATANA_LOG_ASSERT(*range.begin() == 4 && *(range.begin() + 1) == 5);
+
+  // An index restored from its stored form answers the same queries.
+  katana::PropertyHashIndexPrimitive primitive = composite_index->ToPrimitive();
+  std::vector<std::shared_ptr<arrow::Array>> properties{
+      g->GetNodeProperty("type").value()->chunk(0),
+      g->GetNodeProperty("external_id").value()->chunk(0)};
+  auto restored = katana::HashIndex<katana::GraphTopology::Node>::Make(
+                      composite, num_nodes, properties)
+                      .value();
+  KATANA_LOG_ASSERT(restored->FromPrimitive(&primitive));
+  CheckIndex(*restored, num_nodes);
+
+  // ... but only for the properties it was built for.
+  katana::PropertyHashIndexPrimitive other = type_index->ToPrimitive();
+  KATANA_LOG_ASSERT(!restored->FromPrimitive(&other));
+}
+
+void
+TestEdgeIndex(size_t num_nodes) {
+  LinePolicy policy{3};
+  katana::TxnContext txn_ctx;
+  std::unique_ptr<katana::PropertyGraph> g =
+      MakeFileGraph<int64_t>(num_nodes, 0, &policy, &txn_ctx);
+  KATANA_LOG_ASSERT(
+      g->AddEdgeProperties(CreateProperties(g->NumEdges()), &txn_ctx));
+
+  std::vector<std::string> composite{"type", "external_id"};
+  KATANA_LOG_ASSERT(g->MakeEdgeHashIndex(composite));
+  CheckIndex(*g->GetEdgeHashIndex(composite).value(), g->NumEdges());
+  KATANA_LOG_ASSERT(!g->GetNodeHashIndex(composite));
+}
+
+std::unique_ptr<katana::PropertyGraph>
+LoadGraph(const katana::URI& rdg_dir, katana::TxnContext* txn_ctx) {
+  auto g_res = katana::PropertyGraph::Make(rdg_dir, txn_ctx);
+  KATANA_LOG_VASSERT(g_res, "loading {}: {}", rdg_dir, g_res.error());
+  return std::move(g_res.value());
+}
+
+bool
+HasStoredNodeIndex(
+    katana::PropertyGraph* g, const std::vector<std::string>& property_names) {
+  auto primitive_res = g->rdg().LoadPropertyHashIndexPrimitive(
+      katana::PropertyHashIndexPrimitive::name(false, property_names));
+  KATANA_LOG_ASSERT(primitive_res);
+  return primitive_res.value().has_value();
+}
+
+// A stored index is dropped when one of its properties is rewritten, even if
+// the number of rows stays the same.
+void
+TestStaleStoredIndex(size_t num_nodes) {
+  using Key = katana::HashIndex<katana::GraphTopology::Node>::Key;
+
+  LinePolicy policy{3};
+  katana::TxnContext txn_ctx;
+  std::unique_ptr<katana::PropertyGraph> g =
+      MakeFileGraph<int64_t>(num_nodes, 0, &policy, &txn_ctx);
+  KATANA_LOG_ASSERT(
+      g->AddNodeProperties(CreateProperties(num_nodes), &txn_ctx));
+
+  auto uri_res = katana::URI::MakeRand("/tmp/propertyhashindex");
+  KATANA_LOG_ASSERT(uri_res);
+  katana::URI rdg_dir = uri_res.value();
+  KATANA_LOG_ASSERT(g->Write(rdg_dir, "", &txn_ctx));
+
+  std::vector<std::string> type{"type"};
+  std::vector<std::string> sparse{"sparse"};
+  g = LoadGraph(rdg_dir, &txn_ctx);
+  KATANA_LOG_ASSERT(g->MakeNodeHashIndex(type));
+  KATANA_LOG_ASSERT(g->MakeNodeHashIndex(sparse));
+  KATANA_LOG_ASSERT(g->WriteNodeHashIndex(type));
+  KATANA_LOG_ASSERT(g->WriteNodeHashIndex(sparse));
+  KATANA_LOG_ASSERT(g->Commit("", &txn_ctx));
+
+  // Shift every type by one
+  g = LoadGraph(rdg_dir, &txn_ctx);
+  KATANA_LOG_ASSERT(HasStoredNodeIndex(g.get(), type));
+  arrow::Int64Builder type_builder;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    KATANA_LOG_ASSERT(type_builder.Append((i + 1) % kNumTypes).ok());
+  }
+  std::shared_ptr<arrow::Array> type_array;
+  KATANA_LOG_ASSERT(type_builder.Finish(&type_array).ok());
+  KATANA_LOG_ASSERT(g->UpsertNodeProperties(
+      arrow::Table::Make(
+          arrow::schema({arrow::field("type", arrow::int64())}), {type_array}),
+      &txn_ctx));
+  KATANA_LOG_ASSERT(g->Commit("", &txn_ctx));
+
+  g = LoadGraph(rdg_dir, &txn_ctx);
+  KATANA_LOG_ASSERT(!HasStoredNodeIndex(g.get(), type));
+  KATANA_LOG_ASSERT(HasStoredNodeIndex(g.get(), sparse));
+
+  KATANA_LOG_ASSERT(g->MakeNodeHashIndex(type));
+  auto range = g->GetNodeHashIndex(type).value()->Find(Key{int64_t{1}}).value();
+  KATANA_LOG_ASSERT(!range.empty());
+  for (auto id : range) {
+    KATANA_LOG_VASSERT((id + 1) % kNumTypes == 1, "id {} has type 1", id);
+  }
+
+  fs::remove_all(rdg_dir.path());
+}
+
+// The in-memory index is deleted when one of its properties is written, so
+// it can be made again and a stale copy is never stored.
+void
+TestIndexAfterUpsert(size_t num_nodes) {
+  using Key = katana::HashIndex<katana::GraphTopology::Node>::Key;
+
+  LinePolicy policy{3};
+  katana::TxnContext txn_ctx;
+  std::unique_ptr<katana::PropertyGraph> g =
+      MakeFileGraph<int64_t>(num_nodes, 0, &policy, &txn_ctx);
+  KATANA_LOG_ASSERT(
+      g->AddNodeProperties(CreateProperties(num_nodes), &txn_ctx));
+
+  std::vector<std::string> type{"type"};
+  std::vector<std::string> composite{"type", "external_id"};
+  std::vector<std::string> sparse{"sparse"};
+  KATANA_LOG_ASSERT(g->MakeNodeHashIndex(type));
+  KATANA_LOG_ASSERT(g->MakeNodeHashIndex(composite));
+  KATANA_LOG_ASSERT(g->MakeNodeHashIndex(sparse));
+
+  KATANA_LOG_ASSERT(g->DeleteNodeHashIndex(sparse));
+  KATANA_LOG_ASSERT(!g->DeleteNodeHashIndex(sparse));
+  KATANA_LOG_ASSERT(!g->GetNodeHashIndex(sparse));
+  KATANA_LOG_ASSERT(g->MakeNodeHashIndex(sparse));
+
+  // Set every type to 0
+  arrow::Int64Builder type_builder;
+  for (size_t i = 0; i < num_nodes; ++i) {
+    KATANA_LOG_ASSERT(type_builder.Append(0).ok());
+  }
+  std::shared_ptr<arrow::Array> type_array;
+  KATANA_LOG_ASSERT(type_builder.Finish(&type_array).ok());
+  KATANA_LOG_ASSERT(g->UpsertNodeProperties(
+      arrow::Table::Make(
+          arrow::schema({arrow::field("type", arrow::int64())}), {type_array}),
+      &txn_ctx));
+
+  KATANA_LOG_ASSERT(!g->GetNodeHashIndex(type));
+  KATANA_LOG_ASSERT(!g->GetNodeHashIndex(composite));
+  KATANA_LOG_ASSERT(!g->WriteNodeHashIndex(type));
+  KATANA_LOG_ASSERT(g->GetNodeHashIndex(sparse));
+
+  KATANA_LOG_ASSERT(g->MakeNodeHashIndex(type));
+  auto range = g->GetNodeHashIndex(type).value()->Find(Key{int64_t{0}}).value();
+  KATANA_LOG_ASSERT(range.size() == num_nodes);
+
+  KATANA_LOG_ASSERT(g->RemoveNodeProperty("sparse", &txn_ctx));
+  KATANA_LOG_ASSERT(!g->GetNodeHashIndex(sparse));
+  KATANA_LOG_ASSERT(g->GetNodeHashIndex(type));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+
+  TestNodeIndexes(10);
+  TestNodeIndexes(5000);
+  TestEdgeIndex(1000);
+  TestStaleStoredIndex(100);
+  TestIndexAfterUpsert(100);
+
+  return 0;
+}
@@ -203,6 +203,17 @@ TestPrimitiveIndex(size_t num_nodes, size_t line_width) {
   it = nonuniform_index->UpperBound(44);
   KATANA_LOG_ASSERT(it != nonuniform_index->end());
   KATANA_LOG_ASSERT(typed_prop->Value(*it) == 46);
+
+  // Every entity is indexed once, in order of its value.
+  size_t num_indexed = 0;
+  for (it = nonuniform_index->begin(); it != nonuniform_index->end(); ++it) {
+    auto next = it;
+    if (++next != nonuniform_index->end()) {
+      KATANA_LOG_ASSERT(typed_prop->Value(*it) < typed_prop->Value(*next));
+    }
+    ++num_indexed;
+  }
+  KATANA_LOG_ASSERT(num_indexed == num_entities);
 }
 
 template <typename node_or_edge>
@@ -285,5 +296,10 @@ main() {
   TestStringIndex<katana::GraphTopology::Node>(10, 3);
   TestStringIndex<katana::GraphTopology::Edge>(10, 3);
 
+  // Large enough for the parallel sort and for several fence keys.
+  TestPrimitiveIndex<katana::GraphTopology::Node, int64_t>(5000, 3);
+  TestPrimitiveIndex<katana::GraphTopology::Edge, double_t>(5000, 3);
+  TestStringIndex<katana::GraphTopology::Node>(5000, 3);
+
   return 0;
 }
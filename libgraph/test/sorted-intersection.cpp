@@ -0,0 +1,109 @@
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "katana/Logging.h"
+#include "katana/SortedIntersection.h"
+
+namespace {
+
+std::vector<uint32_t>
+RandomSet(std::mt19937* gen, size_t size, uint32_t universe) {
+  std::set<uint32_t> set;
+  std::uniform_int_distribution<uint32_t> dist(0, universe - 1);
+  while (set.size() < size) {
+    set.insert(dist(*gen));
+  }
+  return std::vector<uint32_t>(set.begin(), set.end());
+}
+
+void
+TestSizes(std::mt19937* gen, size_t a_size, size_t b_size, uint32_t universe) {
+  auto a = RandomSet(gen, a_size, universe);
+  auto b = RandomSet(gen, b_size, universe);
+
+  std::vector<uint32_t> expected;
+  std::set_intersection(
+      a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+
+  KATANA_LOG_ASSERT(
+      katana::SortedIntersectionSize(a.data(), a.size(), b.data(), b.size()) ==
+      expected.size());
+  KATANA_LOG_ASSERT(
+      katana::SortedIntersectionSizeScalar(
+          a.data(), a.size(), b.data(), b.size()) == expected.size());
+
+  katana::IntersectionBitmap bitmap(a.data(), a.size(), universe);
+  KATANA_LOG_ASSERT(
+      bitmap.IntersectionSize(b.data(), b.size()) == expected.size());
+
+  // Filter out odd elements and stop after the first ten matches.
+  size_t expected_filtered = std::min<size_t>(
+      std::count_if(
+          expected.begin(), expected.end(), [](uint32_t v) { return v % 2; }),
+      10);
+  size_t visited = 0;
+  katana::ForEachSortedIntersection(
+      a.begin(), a.end(), b.begin(), b.end(), [](uint32_t v) { return v; },
+      [](uint32_t v) { return v % 2 == 1; },
+      [&](auto a_it, auto b_it) {
+        KATANA_LOG_ASSERT(*a_it == *b_it);
+        return ++visited < 10;
+      });
+  KATANA_LOG_ASSERT(visited == expected_filtered);
+}
+
+/// Neighbors of multigraphs repeat; every kernel matches repeats one-to-one,
+/// like std::set_intersection
+void
+TestRepeats(
+    std::mt19937* gen, size_t a_size, size_t b_size, uint32_t universe) {
+  std::uniform_int_distribution<uint32_t> dist(0, universe - 1);
+  std::vector<uint32_t> a(a_size);
+  std::vector<uint32_t> b(b_size);
+  std::generate(a.begin(), a.end(), [&]() { return dist(*gen); });
+  std::generate(b.begin(), b.end(), [&]() { return dist(*gen); });
+  std::sort(a.begin(), a.end());
+  std::sort(b.begin(), b.end());
+
+  std::vector<uint32_t> expected;
+  std::set_intersection(
+      a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(expected));
+
+  size_t scalar = katana::SortedIntersectionSizeScalar(
+      a.data(), a.size(), b.data(), b.size());
+  size_t vectorized =
+      katana::SortedIntersectionSize(a.data(), a.size(), b.data(), b.size());
+  KATANA_LOG_VASSERT(
+      scalar == expected.size() && vectorized == scalar,
+      "sizes {} and {}: scalar {}, vectorized {}, expected {}", a_size, b_size,
+      scalar, vectorized, expected.size());
+}
+
+}  // namespace
+
+int
+main() {
+  std::mt19937 gen(0);
+
+  TestSizes(&gen, 0, 100, 1000);
+  TestSizes(&gen, 100, 100, 200);
+  TestSizes(&gen, 100, 100, 100000);
+  TestSizes(&gen, 1000, 1000, 2000);
+  TestSizes(&gen, 1003, 517, 4000);
+  // skewed sizes use galloping search
+  TestSizes(&gen, 10, 5000, 10000);
+  TestSizes(&gen, 5000, 10, 10000);
+
+  // a few repeats, repeats within every block and repeats across blocks
+  for (int i = 0; i < 20; ++i) {
+    TestRepeats(&gen, 100, 100, 150);
+    TestRepeats(&gen, 64, 48, 8);
+    TestRepeats(&gen, 1000, 700, 300);
+    TestRepeats(&gen, 17, 33, 2);
+  }
+
+  return 0;
+}
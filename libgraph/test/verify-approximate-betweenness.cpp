@@ -0,0 +1,71 @@
+#include <cmath>
+#include <random>
+
+#include "TestRandomGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/betweenness_centrality/betweenness_centrality.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+constexpr size_t kNumNodes = 200;
+constexpr double kEpsilon = 0.05;
+
+// Random edges without self loops
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph() {
+  std::mt19937 gen(42);
+  TestAdjacency adjacency = RandomAdjacency(kNumNodes, 0, 6, &gen);
+  for (Node n = 0; n < kNumNodes; ++n) {
+    adjacency[n].erase(n);
+  }
+  return MakeTestGraph(adjacency);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+  katana::TxnContext txn_ctx;
+
+  std::unique_ptr<katana::PropertyGraph> pg = MakeGraph();
+
+  auto res = BetweennessCentrality(
+      pg.get(), "exact", &txn_ctx, kBetweennessCentralityAllNodes,
+      BetweennessCentralityPlan::Level());
+  KATANA_LOG_VASSERT(res, "BetweennessCentrality failed: {}", res.error());
+  res = BetweennessCentrality(
+      pg.get(), "sampled", &txn_ctx, kBetweennessCentralityAllNodes,
+      BetweennessCentralityPlan::Sampling(kEpsilon, 0.1));
+  KATANA_LOG_VASSERT(res, "BetweennessCentrality failed: {}", res.error());
+
+  auto exact = pg->GetNodePropertyTyped<float>("exact").value();
+  auto sampled = pg->GetNodePropertyTyped<float>("sampled").value();
+  double normalization = double{kNumNodes} * (kNumNodes - 1);
+  for (Node n = 0; n < kNumNodes; ++n) {
+    double error = std::abs(sampled->Value(n) - exact->Value(n));
+    KATANA_LOG_VASSERT(
+        error <= kEpsilon * normalization,
+        "node {} has centrality {}, expected {}", n, sampled->Value(n),
+        exact->Value(n));
+  }
+
+  // A cap on the number of sampled sources
+  res = BetweennessCentrality(
+      pg.get(), "capped", &txn_ctx, uint32_t{10},
+      BetweennessCentralityPlan::Sampling(kEpsilon, 0.1));
+  KATANA_LOG_VASSERT(res, "BetweennessCentrality failed: {}", res.error());
+
+  KATANA_LOG_ASSERT(!BetweennessCentrality(
+      pg.get(), "bad", &txn_ctx, std::vector<uint32_t>{0, 1},
+      BetweennessCentralityPlan::Sampling()));
+  KATANA_LOG_ASSERT(!BetweennessCentrality(
+      pg.get(), "bad", &txn_ctx, kBetweennessCentralityAllNodes,
+      BetweennessCentralityPlan::Sampling(kEpsilon, 0)));
+
+  return 0;
+}
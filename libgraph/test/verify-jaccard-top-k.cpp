@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "TestRandomGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/jaccard/jaccard.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+constexpr size_t kNumNodes = 40;
+
+struct Similar {
+  uint32_t source;
+  uint32_t destination;
+  double similarity;
+
+  bool operator==(const Similar& other) const {
+    return source == other.source && destination == other.destination &&
+           similarity == other.similarity;
+  }
+};
+
+// Random out-neighbors, plus nodes with the same neighbors, whose
+// similarities to any query tie
+TestAdjacency
+MakeEdges() {
+  std::mt19937 gen(7);
+  TestAdjacency edges = RandomAdjacency(kNumNodes, 0, 5, &gen);
+  for (Node n = 0; n < 4; ++n) {
+    edges[n] = {10, 11, 12};
+  }
+  edges[4] = {10, 11};
+  edges[5] = {12, 13};
+  return edges;
+}
+
+// Pairwise similarity of the out-neighbors of query and every other node
+std::vector<Similar>
+Reference(
+    const TestAdjacency& edges, const std::vector<Node>& queries, uint32_t k) {
+  std::vector<Similar> expected;
+  for (Node query : queries) {
+    std::vector<Similar> row;
+    for (Node other = 0; other < kNumNodes; ++other) {
+      std::vector<Node> shared;
+      std::set_intersection(
+          edges[query].begin(), edges[query].end(), edges[other].begin(),
+          edges[other].end(), std::back_inserter(shared));
+      if (other == query || shared.empty()) {
+        continue;
+      }
+      uint32_t intersection_size = shared.size();
+      uint32_t union_size =
+          edges[query].size() + edges[other].size() - intersection_size;
+      row.emplace_back(Similar{
+          query, other, static_cast<double>(intersection_size) / union_size});
+    }
+    std::sort(row.begin(), row.end(), [](const auto& a, const auto& b) {
+      if (a.similarity != b.similarity) {
+        return a.similarity > b.similarity;
+      }
+      return a.destination < b.destination;
+    });
+    row.resize(std::min<size_t>(row.size(), k));
+    expected.insert(expected.end(), row.begin(), row.end());
+  }
+  return expected;
+}
+
+std::vector<Similar>
+ToRows(const arrow::Table& table) {
+  KATANA_LOG_ASSERT(table.num_columns() == 3);
+  std::vector<Similar> rows;
+  for (int c = 0; c < table.column(0)->num_chunks(); ++c) {
+    auto sources =
+        std::static_pointer_cast<arrow::UInt32Array>(table.column(0)->chunk(c));
+    auto destinations =
+        std::static_pointer_cast<arrow::UInt32Array>(table.column(1)->chunk(c));
+    auto similarities =
+        std::static_pointer_cast<arrow::DoubleArray>(table.column(2)->chunk(c));
+    for (int64_t i = 0; i < sources->length(); ++i) {
+      rows.emplace_back(Similar{
+          sources->Value(i), destinations->Value(i), similarities->Value(i)});
+    }
+  }
+  return rows;
+}
+
+void
+TestTopK(const std::vector<Node>& query_nodes, uint32_t k) {
+  TestAdjacency edges = MakeEdges();
+  std::unique_ptr<katana::PropertyGraph> pg = MakeTestGraph(edges);
+
+  auto res = JaccardTopK(pg.get(), query_nodes, k);
+  KATANA_LOG_VASSERT(res, "JaccardTopK: {}", res.error());
+  std::vector<Similar> rows = ToRows(*res.value());
+
+  std::vector<Node> queries = query_nodes;
+  if (queries.empty()) {
+    for (Node n = 0; n < kNumNodes; ++n) {
+      queries.emplace_back(n);
+    }
+  }
+  std::vector<Similar> expected = Reference(edges, queries, k);
+
+  KATANA_LOG_VASSERT(
+      rows.size() == expected.size(), "k {}: {} rows, expected {}", k,
+      rows.size(), expected.size());
+  for (size_t i = 0; i < rows.size(); ++i) {
+    KATANA_LOG_VASSERT(
+        rows[i] == expected[i],
+        "k {}, row {}: ({}, {}, {}), expected ({}, {}, {})", k, i,
+        rows[i].source, rows[i].destination, rows[i].similarity,
+        expected[i].source, expected[i].destination, expected[i].similarity);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  // Nodes 1 to 3 tie for node 0; k = 2 keeps the smallest ids
+  TestTopK({0, 4, 5}, 2);
+  // k larger than any degree or number of candidates keeps every node that
+  // shares a neighbor
+  TestTopK({0, 4, 5}, 100);
+  TestTopK({}, 1);
+  TestTopK({}, 3);
+  TestTopK({}, kNumNodes);
+
+  KATANA_LOG_ASSERT(!JaccardTopK(MakeTestGraph(MakeEdges()).get(), {0}, 0));
+  KATANA_LOG_ASSERT(
+      !JaccardTopK(MakeTestGraph(MakeEdges()).get(), {kNumNodes}, 1));
+
+  return 0;
+}
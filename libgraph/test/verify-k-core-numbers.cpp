@@ -0,0 +1,137 @@
+#include <random>
+#include <set>
+#include <vector>
+
+#include "TestRandomGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/k_core/k_core.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+constexpr size_t kNumNodes = 2000;
+constexpr uint32_t kKCoreNumber = 6;
+
+// Random undirected edges {u, v} with u < v, with a dense cluster among the
+// first nodes so that core numbers span more than the open buckets
+TestAdjacency
+MakeEdges() {
+  std::mt19937 gen(42);
+  TestAdjacency random = RandomAdjacency(kNumNodes, 0, 6, &gen);
+
+  TestAdjacency edges(kNumNodes);
+  for (Node n = 0; n < kNumNodes; ++n) {
+    for (Node dst : random[n]) {
+      if (dst != n) {
+        edges[std::min(n, dst)].emplace(std::max(n, dst));
+      }
+    }
+  }
+  for (Node n = 0; n < 300; ++n) {
+    for (Node dst = n + 1; dst < 300; ++dst) {
+      edges[n].emplace(dst);
+    }
+  }
+  return edges;
+}
+
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph(const TestAdjacency& edges, bool symmetric) {
+  TestAdjacency out_edges(edges);
+  if (symmetric) {
+    for (Node n = 0; n < kNumNodes; ++n) {
+      for (Node dst : edges[n]) {
+        out_edges[dst].emplace(n);
+      }
+    }
+  }
+  return MakeTestGraph(out_edges);
+}
+
+// Sequential peeling of a node of minimum degree at a time
+std::vector<uint32_t>
+Reference(const TestAdjacency& edges) {
+  std::vector<std::vector<Node>> adjacency(kNumNodes);
+  for (Node n = 0; n < kNumNodes; ++n) {
+    for (Node dst : edges[n]) {
+      adjacency[n].emplace_back(dst);
+      adjacency[dst].emplace_back(n);
+    }
+  }
+
+  std::vector<uint32_t> degree(kNumNodes);
+  std::set<std::pair<uint32_t, Node>> queue;
+  for (Node n = 0; n < kNumNodes; ++n) {
+    degree[n] = adjacency[n].size();
+    queue.emplace(degree[n], n);
+  }
+  std::vector<uint32_t> core(kNumNodes);
+  std::vector<bool> removed(kNumNodes);
+  uint32_t level = 0;
+  while (!queue.empty()) {
+    auto [d, n] = *queue.begin();
+    queue.erase(queue.begin());
+    level = std::max(level, d);
+    core[n] = level;
+    removed[n] = true;
+    for (Node dst : adjacency[n]) {
+      if (!removed[dst]) {
+        queue.erase({degree[dst], dst});
+        queue.emplace(--degree[dst], dst);
+      }
+    }
+  }
+  return core;
+}
+
+void
+TestNumbers(bool symmetric) {
+  TestAdjacency edges = MakeEdges();
+  std::vector<uint32_t> expected = Reference(edges);
+  std::unique_ptr<katana::PropertyGraph> pg = MakeGraph(edges, symmetric);
+
+  katana::TxnContext txn_ctx;
+  auto res = KCoreNumbers(pg.get(), "core", &txn_ctx, symmetric);
+  KATANA_LOG_VASSERT(res, "KCoreNumbers: {}", res.error());
+  auto core = pg->GetNodePropertyTyped<uint32_t>("core").value();
+  for (Node n = 0; n < kNumNodes; ++n) {
+    KATANA_LOG_VASSERT(
+        core->Value(n) == expected[n], "node {}: core {}, expected {}", n,
+        core->Value(n), expected[n]);
+  }
+
+  // The bucketed plan answers membership like the other plans
+  auto bucketed_res = KCore(
+      pg.get(), kKCoreNumber, "bucketed", &txn_ctx, symmetric,
+      KCorePlan::Bucketed());
+  KATANA_LOG_VASSERT(bucketed_res, "KCore: {}", bucketed_res.error());
+  auto sync_res = KCore(
+      pg.get(), kKCoreNumber, "synchronous", &txn_ctx, symmetric,
+      KCorePlan::Synchronous());
+  KATANA_LOG_VASSERT(sync_res, "KCore: {}", sync_res.error());
+  auto bucketed = pg->GetNodePropertyTyped<uint32_t>("bucketed").value();
+  auto synchronous = pg->GetNodePropertyTyped<uint32_t>("synchronous").value();
+  for (Node n = 0; n < kNumNodes; ++n) {
+    KATANA_LOG_ASSERT(bucketed->Value(n) == synchronous->Value(n));
+    KATANA_LOG_ASSERT(bucketed->Value(n) == (expected[n] >= kKCoreNumber));
+  }
+
+  KATANA_LOG_ASSERT(!KCoreNumbers(
+      pg.get(), "other", &txn_ctx, symmetric, KCorePlan::Synchronous()));
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(4);
+
+  TestNumbers(true);
+  TestNumbers(false);
+
+  return 0;
+}
@@ -0,0 +1,93 @@
+#include <string>
+
+#include "TestRandomGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/analytics/leiden_clustering/leiden_clustering.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+constexpr size_t kNumCliques = 4;
+constexpr size_t kCliqueSize = 5;
+constexpr size_t kNumNodes = kNumCliques * kCliqueSize;
+
+// A ring of cliques: each clique is joined to the next by a single edge.
+// Every edge is stored once, from the smaller to the larger node, unless the
+// graph is symmetric.
+std::unique_ptr<katana::PropertyGraph>
+MakeRingOfCliques(bool symmetric) {
+  TestAdjacency out_edges(kNumNodes);
+  auto add_edge = [&](Node src, Node dst) {
+    out_edges[std::min(src, dst)].emplace(std::max(src, dst));
+    if (symmetric) {
+      out_edges[std::max(src, dst)].emplace(std::min(src, dst));
+    }
+  };
+  for (Node c = 0; c < kNumCliques; ++c) {
+    Node first = c * kCliqueSize;
+    for (Node src = first; src < first + kCliqueSize; ++src) {
+      for (Node dst = src + 1; dst < first + kCliqueSize; ++dst) {
+        add_edge(src, dst);
+      }
+    }
+    add_edge(first + kCliqueSize - 1, (first + kCliqueSize) % kNumNodes);
+  }
+
+  return MakeTestGraph(out_edges);
+}
+
+// Before coarsened levels were built as CoarsenedGraph, Leiden put each
+// clique of the ring in a cluster of its own. Fractional weights also go
+// through the degree weights that refinement truncates to integers.
+template <typename Weight>
+void
+TestRingOfCliques(bool symmetric, Weight weight, bool enable_vf) {
+  std::unique_ptr<katana::PropertyGraph> pg = MakeRingOfCliques(symmetric);
+  katana::TxnContext txn_ctx;
+  auto weight_res = katana::AddEdgeProperties(
+      pg.get(), &txn_ctx,
+      katana::PropertyGenerator("weight", [&](auto) { return weight; }));
+  KATANA_LOG_VASSERT(
+      weight_res, "Failed to add edge properties: {}", weight_res.error());
+
+  // Keep every level, however small
+  auto plan = LeidenClusteringPlan::Deterministic(
+      enable_vf, LeidenClusteringPlan::kDefaultModularityThresholdPerRound,
+      LeidenClusteringPlan::kDefaultModularityThresholdTotal,
+      LeidenClusteringPlan::kDefaultMaxIterations, 0);
+  auto res = LeidenClustering(
+      pg.get(), "weight", "cluster", &txn_ctx, symmetric, plan);
+  KATANA_LOG_VASSERT(res, "LeidenClustering: {}", res.error());
+  KATANA_LOG_ASSERT(LeidenClusteringAssertValid(pg.get(), "weight", "cluster"));
+
+  auto cluster = pg->GetNodePropertyTyped<uint64_t>("cluster").value();
+  for (Node n = 0; n < kNumNodes; ++n) {
+    for (Node other = 0; other < kNumNodes; ++other) {
+      bool same_clique = n / kCliqueSize == other / kCliqueSize;
+      KATANA_LOG_VASSERT(
+          (cluster->Value(n) == cluster->Value(other)) == same_clique,
+          "nodes {} and {} are in clusters {} and {}", n, other,
+          cluster->Value(n), cluster->Value(other));
+    }
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+
+  for (bool enable_vf : {false, true}) {
+    TestRingOfCliques<int64_t>(false, 1, enable_vf);
+    TestRingOfCliques<int64_t>(true, 1, enable_vf);
+    TestRingOfCliques<double>(false, 0.75, enable_vf);
+    TestRingOfCliques<double>(true, 0.75, enable_vf);
+  }
+
+  return 0;
+}
@@ -0,0 +1,98 @@
+#include <queue>
+#include <random>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "TestRandomGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/bfs/bfs.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+constexpr size_t kNumNodes = 3000;
+
+std::vector<uint32_t>
+Distances(const katana::PropertyGraph& pg, Node source) {
+  const auto& topology = pg.topology();
+  std::vector<uint32_t> distances(pg.NumNodes(), kMultiSourceBfsUnreached);
+  std::queue<Node> queue;
+  distances[source] = 0;
+  queue.push(source);
+  while (!queue.empty()) {
+    Node n = queue.front();
+    queue.pop();
+    for (auto e : topology.OutEdges(n)) {
+      Node dst = topology.OutEdgeDst(e);
+      if (distances[dst] == kMultiSourceBfsUnreached) {
+        distances[dst] = distances[n] + 1;
+        queue.push(dst);
+      }
+    }
+  }
+  return distances;
+}
+
+// Batches of each width, and more sources than fit in one batch
+void
+TestSources(
+    katana::PropertyGraph* pg, size_t num_sources, std::mt19937* gen,
+    BfsPlan plan) {
+  std::uniform_int_distribution<Node> any_node(0, kNumNodes - 1);
+  std::vector<uint32_t> sources(num_sources);
+  for (auto& source : sources) {
+    source = any_node(*gen);
+  }
+
+  katana::TxnContext txn_ctx;
+  std::string name = "distances-" + std::to_string(num_sources);
+  auto res = MultiSourceBfs(pg, sources, name, &txn_ctx, plan);
+  KATANA_LOG_VASSERT(res, "MultiSourceBfs failed: {}", res.error());
+
+  auto property = pg->GetNodeProperty(name).value();
+  auto lists =
+      std::static_pointer_cast<arrow::FixedSizeListArray>(property->chunk(0));
+  auto values = std::static_pointer_cast<arrow::UInt32Array>(lists->values());
+  for (size_t i = 0; i < num_sources; ++i) {
+    std::vector<uint32_t> expected = Distances(*pg, sources[i]);
+    for (Node n = 0; n < pg->NumNodes(); ++n) {
+      uint32_t distance = values->Value(n * num_sources + i);
+      KATANA_LOG_VASSERT(
+          distance == expected[n],
+          "node {} is at {} from source {}, expected {}", n, distance,
+          sources[i], expected[n]);
+    }
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+  std::mt19937 gen(42);
+
+  std::unique_ptr<katana::PropertyGraph> pg =
+      MakeTestGraph(RandomAdjacency(kNumNodes, 0, 4, &gen));
+
+  for (size_t num_sources : {1, 5, 64, 200, 300, 700}) {
+    TestSources(pg.get(), num_sources, &gen, BfsPlan());
+  }
+  // Always push, and pull from the first level with outgoing edges on
+  TestSources(pg.get(), 100, &gen, BfsPlan::SynchronousDirectOpt(1, 1));
+  TestSources(
+      pg.get(), 100, &gen,
+      BfsPlan::SynchronousDirectOpt(kNumNodes * 10, kNumNodes * 10));
+
+  katana::TxnContext txn_ctx;
+  KATANA_LOG_ASSERT(!MultiSourceBfs(pg.get(), {}, "bad", &txn_ctx));
+  KATANA_LOG_ASSERT(!MultiSourceBfs(pg.get(), {kNumNodes}, "bad", &txn_ctx));
+  KATANA_LOG_ASSERT(
+      !MultiSourceBfs(pg.get(), {0}, "bad", &txn_ctx, BfsPlan::Asynchronous()));
+
+  return 0;
+}
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "TestRandomGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/TopologyGeneration.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/pagerank/pagerank.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+struct Rank : public katana::PODProperty<float> {};
+
+using Node = katana::GraphTopology::Node;
+
+constexpr size_t kNumNodes = 2000;
+constexpr size_t kNumNewNodes = 5;
+constexpr size_t kNumDeletedNodes = 5;
+constexpr float kTolerance = 1.0e-5;
+
+std::vector<float>
+GetRanks(katana::PropertyGraph* pg, const std::string& property_name) {
+  auto graph_res =
+      katana::TypedPropertyGraph<std::tuple<Rank>, std::tuple<>>::Make(
+          pg, {property_name}, {});
+  KATANA_LOG_VASSERT(graph_res, "Failed to make view: {}", graph_res.error());
+  std::vector<float> ranks;
+  for (Node n : graph_res.value()) {
+    ranks.emplace_back(graph_res.value().GetData<Rank>(n));
+  }
+  return ranks;
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+  katana::TxnContext txn_ctx;
+  PagerankPlan plan = PagerankPlan::PushAsynchronous(kTolerance);
+
+  std::mt19937 gen(42);
+  TestAdjacency adjacency = RandomAdjacency(kNumNodes, 0, 8, &gen);
+  std::uniform_int_distribution<Node> any_node(0, kNumNodes - 1);
+
+  std::unique_ptr<katana::PropertyGraph> before = MakeTestGraph(adjacency);
+  auto res = Pagerank(before.get(), "rank", &txn_ctx, plan);
+  KATANA_LOG_VASSERT(res, "Pagerank failed: {}", res.error());
+  std::vector<float> previous = GetRanks(before.get(), "rank");
+
+  // Delete and insert edges from a few nodes and add nodes with edges to and
+  // from the rest of the graph
+  std::vector<PagerankEdgeChange> changes;
+  for (Node n = 0; n < 20; ++n) {
+    if (!adjacency[n].empty()) {
+      changes.emplace_back(PagerankEdgeChange{n, *adjacency[n].begin(), false});
+      adjacency[n].erase(adjacency[n].begin());
+    }
+    Node dst = any_node(gen);
+    if (adjacency[n].emplace(dst).second) {
+      changes.emplace_back(PagerankEdgeChange{n, dst, true});
+    }
+  }
+  // Delete a few nodes by removing their edges; they keep their ids
+  std::vector<Node> deleted_nodes;
+  for (size_t i = 0; i < kNumDeletedNodes; ++i) {
+    Node n = kNumNodes / 2 + i;
+    deleted_nodes.emplace_back(n);
+    for (Node dst : adjacency[n]) {
+      changes.emplace_back(PagerankEdgeChange{n, dst, false});
+    }
+    adjacency[n].clear();
+    for (Node src = 0; src < adjacency.size(); ++src) {
+      if (adjacency[src].erase(n) == 0) {
+        continue;
+      }
+      // An edge inserted above never existed
+      auto inserted = std::find_if(
+          changes.begin(), changes.end(), [&](const PagerankEdgeChange& c) {
+            return c.src == src && c.dst == n && c.inserted;
+          });
+      if (inserted != changes.end()) {
+        changes.erase(inserted);
+      } else {
+        changes.emplace_back(PagerankEdgeChange{src, n, false});
+      }
+    }
+  }
+  auto is_deleted = [&](Node n) {
+    return std::find(deleted_nodes.begin(), deleted_nodes.end(), n) !=
+           deleted_nodes.end();
+  };
+
+  std::vector<Node> new_nodes;
+  for (size_t i = 0; i < kNumNewNodes; ++i) {
+    Node n = adjacency.size();
+    Node src = any_node(gen);
+    Node dst = any_node(gen);
+    if (is_deleted(src) || is_deleted(dst)) {
+      continue;
+    }
+    new_nodes.emplace_back(n);
+    adjacency.emplace_back(std::set<Node>{dst});
+    changes.emplace_back(PagerankEdgeChange{n, dst, true});
+    if (adjacency[src].emplace(n).second) {
+      changes.emplace_back(PagerankEdgeChange{src, n, true});
+    }
+  }
+
+  std::unique_ptr<katana::PropertyGraph> after = MakeTestGraph(adjacency);
+  res = katana::AddNodeProperties(
+      after.get(), &txn_ctx, katana::PropertyGenerator("previous", [&](Node n) {
+        return n < previous.size() ? previous[n] : 0.0f;
+      }));
+  KATANA_LOG_VASSERT(res, "Failed to add previous ranks: {}", res.error());
+
+  res = PagerankIncremental(
+      after.get(), "previous", changes, new_nodes, deleted_nodes,
+      "incremental", &txn_ctx, plan);
+  KATANA_LOG_VASSERT(res, "PagerankIncremental failed: {}", res.error());
+  res = Pagerank(after.get(), "full", &txn_ctx, plan);
+  KATANA_LOG_VASSERT(res, "Pagerank failed: {}", res.error());
+
+  std::vector<float> incremental = GetRanks(after.get(), "incremental");
+  std::vector<float> full = GetRanks(after.get(), "full");
+  // Both ranks are within kTolerance * rank / (1 - alpha) of the exact rank
+  // of a node, up to rounding
+  constexpr float kMaxError =
+      2 * kTolerance / (1 - PagerankPlan::kDefaultAlpha);
+  for (Node n = 0; n < full.size(); ++n) {
+    if (is_deleted(n)) {
+      KATANA_LOG_VASSERT(
+          incremental[n] == 0, "deleted node {} has incremental rank {}", n,
+          incremental[n]);
+      continue;
+    }
+    KATANA_LOG_VASSERT(
+        std::abs(incremental[n] - full[n]) <= kMaxError * full[n] + kTolerance,
+        "node {} has incremental rank {} and rank {}", n, incremental[n],
+        full[n]);
+  }
+
+  // Changes that cannot be applied to the graph
+  std::vector<PagerankEdgeChange> out_of_range{
+      PagerankEdgeChange{0, static_cast<Node>(adjacency.size()), true}};
+  KATANA_LOG_ASSERT(!PagerankIncremental(
+      after.get(), "previous", out_of_range, {}, {}, "bad", &txn_ctx, plan));
+  KATANA_LOG_ASSERT(!PagerankIncremental(
+      after.get(), "previous", changes, new_nodes, deleted_nodes, "bad",
+      &txn_ctx, PagerankPlan::PullResidual()));
+
+  // Deleted nodes that still have edges to or from them
+  Node with_out_edges = 0;
+  while (adjacency[with_out_edges].empty()) {
+    ++with_out_edges;
+  }
+  KATANA_LOG_ASSERT(!PagerankIncremental(
+      after.get(), "previous", {}, {}, {with_out_edges}, "bad", &txn_ctx,
+      plan));
+  auto has_in_edge = [&](Node n) {
+    return std::any_of(
+        adjacency.begin(), adjacency.end(),
+        [&](const std::set<Node>& neighbors) { return neighbors.count(n); });
+  };
+  Node with_in_edge = 0;
+  while (!adjacency[with_in_edge].empty() || !has_in_edge(with_in_edge)) {
+    ++with_in_edge;
+  }
+  KATANA_LOG_ASSERT(!PagerankIncremental(
+      after.get(), "previous", {}, {}, {with_in_edge}, "bad", &txn_ctx, plan));
+
+  return 0;
+}
@@ -0,0 +1,132 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "TestRandomGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/TypedPropertyGraph.h"
+#include "katana/analytics/pagerank/pagerank.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+struct Rank : public katana::PODProperty<float> {};
+
+using Node = katana::GraphTopology::Node;
+
+constexpr size_t kNumNodes = 500;
+constexpr float kTolerance = 1.0e-6;
+constexpr int kReferenceIterations = 200;
+
+// Power iteration from a restart distribution uniform over seeds
+std::vector<double>
+Reference(const katana::PropertyGraph& pg, const std::vector<Node>& seeds) {
+  const auto& topology = pg.topology();
+  double alpha = PagerankPlan::kDefaultAlpha;
+  std::vector<double> restart(pg.NumNodes());
+  for (Node seed : seeds) {
+    restart[seed] += (1 - alpha) / seeds.size();
+  }
+  std::vector<double> ranks(restart);
+  for (int i = 0; i < kReferenceIterations; ++i) {
+    std::vector<double> next(restart);
+    for (Node n = 0; n < pg.NumNodes(); ++n) {
+      for (auto e : topology.OutEdges(n)) {
+        next[topology.OutEdgeDst(e)] +=
+            alpha * ranks[n] / topology.OutDegree(n);
+      }
+    }
+    ranks.swap(next);
+  }
+  return ranks;
+}
+
+void
+CheckRanks(
+    const katana::PropertyGraph& pg, const std::vector<Node>& seeds,
+    const std::vector<float>& ranks) {
+  std::vector<double> expected = Reference(pg, seeds);
+  double error = 0;
+  for (Node n = 0; n < pg.NumNodes(); ++n) {
+    error += std::abs(ranks[n] - expected[n]);
+  }
+  double bound = kTolerance * (pg.NumEdges() + pg.NumNodes()) /
+                     (1 - PagerankPlan::kDefaultAlpha) +
+                 1.0e-4;
+  KATANA_LOG_VASSERT(
+      error <= bound, "ranks for {} seeds are {} from the reference",
+      seeds.size(), error);
+}
+
+void
+TestSeedSet(katana::PropertyGraph* pg, const std::vector<Node>& seeds) {
+  katana::TxnContext txn_ctx;
+  std::string name = "rank-" + std::to_string(seeds.front()) + "-" +
+                     std::to_string(seeds.size());
+  auto res = PersonalizedPagerank(
+      pg, seeds, name, &txn_ctx, PagerankPlan::PushAsynchronous(kTolerance));
+  KATANA_LOG_VASSERT(res, "PersonalizedPagerank failed: {}", res.error());
+
+  auto graph_res =
+      katana::TypedPropertyGraph<std::tuple<Rank>, std::tuple<>>::Make(
+          pg, {name}, {});
+  KATANA_LOG_VASSERT(graph_res, "Failed to make view: {}", graph_res.error());
+  std::vector<float> ranks;
+  for (Node n : graph_res.value()) {
+    ranks.emplace_back(graph_res.value().GetData<Rank>(n));
+  }
+  CheckRanks(*pg, seeds, ranks);
+}
+
+void
+TestBatch(katana::PropertyGraph* pg, const std::vector<Node>& sources) {
+  katana::TxnContext txn_ctx;
+  auto res = PersonalizedPagerankBatch(
+      pg, sources, "batch", &txn_ctx,
+      PagerankPlan::PushAsynchronous(kTolerance));
+  KATANA_LOG_VASSERT(res, "PersonalizedPagerankBatch failed: {}", res.error());
+
+  auto property = pg->GetNodeProperty("batch").value();
+  KATANA_LOG_ASSERT(property->num_chunks() == 1);
+  auto lists =
+      std::static_pointer_cast<arrow::FixedSizeListArray>(property->chunk(0));
+  KATANA_LOG_ASSERT(
+      lists->value_length(0) == static_cast<int32_t>(sources.size()));
+  auto values = std::static_pointer_cast<arrow::FloatArray>(lists->values());
+
+  for (size_t i = 0; i < sources.size(); ++i) {
+    std::vector<float> ranks;
+    for (Node n = 0; n < pg->NumNodes(); ++n) {
+      ranks.emplace_back(values->Value(n * sources.size() + i));
+    }
+    CheckRanks(*pg, {sources[i]}, ranks);
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys S;
+  katana::TxnContext txn_ctx;
+
+  std::mt19937 gen(42);
+  std::unique_ptr<katana::PropertyGraph> pg =
+      MakeTestGraph(RandomAdjacency(kNumNodes, 0, 8, &gen));
+
+  TestSeedSet(pg.get(), {3});
+  TestSeedSet(pg.get(), {3, 17, 17, 499});
+  // Repeated sources get a lane each
+  TestBatch(pg.get(), {3, 17, 42, 3, 0, 499});
+
+  KATANA_LOG_ASSERT(!PersonalizedPagerank(pg.get(), {}, "bad", &txn_ctx));
+  KATANA_LOG_ASSERT(!PersonalizedPagerankBatch(
+      pg.get(), {0, kNumNodes}, "bad", &txn_ctx));
+  KATANA_LOG_ASSERT(!PersonalizedPagerank(
+      pg.get(), {0}, "bad", &txn_ctx, PagerankPlan::PullTopological()));
+
+  return 0;
+}
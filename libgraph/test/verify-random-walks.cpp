@@ -0,0 +1,195 @@
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "TestRandomGraph.h"
+#include "katana/SharedMemSys.h"
+#include "katana/analytics/random_walks/random_walks.h"
+
+using namespace katana::analytics;
+
+namespace {
+
+using Node = katana::GraphTopology::Node;
+
+constexpr size_t kNumNodes = 200;
+constexpr uint32_t kWalkLength = 20;
+constexpr uint32_t kNumberOfWalks = 50;
+
+// A random graph in which the last node has no out-edges and the weight of
+// an edge is its position among the out-edges of its source, so that the
+// first out-edge of every node has weight 0
+std::unique_ptr<katana::PropertyGraph>
+MakeGraph() {
+  std::mt19937 gen(42);
+  TestAdjacency adjacency = RandomAdjacency(kNumNodes, 1, 8, &gen);
+  adjacency.back().clear();
+  std::unique_ptr<katana::PropertyGraph> pg = MakeTestGraph(adjacency);
+
+  arrow::UInt32Builder weights;
+  for (const auto& neighbors : adjacency) {
+    for (uint32_t weight = 0; weight < neighbors.size(); ++weight) {
+      KATANA_LOG_ASSERT(weights.Append(weight).ok());
+    }
+  }
+  std::shared_ptr<arrow::Array> weight_array;
+  KATANA_LOG_ASSERT(weights.Finish(&weight_array).ok());
+  katana::TxnContext txn_ctx;
+  auto add_res = pg->AddEdgeProperties(
+      arrow::Table::Make(
+          arrow::schema({arrow::field("weight", arrow::uint32())}),
+          {weight_array}),
+      &txn_ctx);
+  KATANA_LOG_VASSERT(add_res, "Failed to add weights: {}", add_res.error());
+  return pg;
+}
+
+// Returns the weight of the edge from src to dst, or -1 if there is none
+int64_t
+EdgeWeight(const katana::PropertyGraph& pg, Node src, Node dst) {
+  const auto& topology = pg.topology();
+  int64_t weight = 0;
+  for (auto e : topology.OutEdges(src)) {
+    if (topology.OutEdgeDst(e) == dst) {
+      return weight;
+    }
+    ++weight;
+  }
+  return -1;
+}
+
+// Checks that walks start at the right nodes, follow edges and are padded
+// exactly after they reach a node without out-edges, or for weighted walks
+// without out-edges of positive weight
+void
+CheckWalks(
+    const katana::PropertyGraph& pg, const RandomWalkMatrix& walks,
+    bool weighted) {
+  KATANA_LOG_ASSERT(walks.num_walks() == kNumNodes * kNumberOfWalks);
+  KATANA_LOG_ASSERT(walks.row_length() == kWalkLength + 1);
+  const auto& topology = pg.topology();
+  for (uint64_t i = 0; i < walks.num_walks(); ++i) {
+    const uint32_t* walk = walks.walk(i);
+    KATANA_LOG_ASSERT(walk[0] == i % kNumNodes);
+    for (uint32_t j = 1; j < walks.row_length(); ++j) {
+      if (walk[j] == kRandomWalkEnd) {
+        size_t degree = topology.OutDegree(walk[j - 1]);
+        KATANA_LOG_ASSERT(degree == 0 || (weighted && degree == 1));
+        for (uint32_t k = j; k < walks.row_length(); ++k) {
+          KATANA_LOG_ASSERT(walk[k] == kRandomWalkEnd);
+        }
+        break;
+      }
+      int64_t weight = EdgeWeight(pg, walk[j - 1], walk[j]);
+      KATANA_LOG_VASSERT(
+          weight >= 0, "no edge from {} to {}", walk[j - 1], walk[j]);
+      // Weighted walks never take edges of weight 0
+      KATANA_LOG_ASSERT(!weighted || weight > 0);
+    }
+  }
+}
+
+// The first steps of the weighted walks from each node should go to its
+// out-neighbors with probability proportional to the edge weights
+void
+CheckFirstSteps(
+    const katana::PropertyGraph& pg, const RandomWalkMatrix& walks) {
+  const auto& topology = pg.topology();
+  std::vector<std::vector<double>> counts(kNumNodes);
+  for (uint64_t i = 0; i < walks.num_walks(); ++i) {
+    const uint32_t* walk = walks.walk(i);
+    if (walk[1] != kRandomWalkEnd) {
+      counts[walk[0]].resize(topology.OutDegree(walk[0]));
+      counts[walk[0]][EdgeWeight(pg, walk[0], walk[1])] += 1;
+    }
+  }
+
+  double error = 0;
+  double expected_error = 0;
+  for (Node n = 0; n < kNumNodes; ++n) {
+    size_t degree = topology.OutDegree(n);
+    if (degree < 2) {
+      // Nodes with one out-edge, of weight 0, end walks
+      continue;
+    }
+    double total_weight = degree * (degree - 1) / 2.0;
+    for (size_t w = 0; w < degree; ++w) {
+      double p = w / total_weight;
+      error += std::abs(counts[n][w] / kNumberOfWalks - p);
+      expected_error += std::sqrt(p * (1 - p) / kNumberOfWalks);
+    }
+  }
+  KATANA_LOG_VASSERT(
+      error < 2 * expected_error, "error {} (expected about {})", error,
+      expected_error);
+}
+
+void
+TestWeighted(katana::PropertyGraph* pg) {
+  auto plan = RandomWalksPlan::FirstOrder(kWalkLength, kNumberOfWalks);
+  auto walks_res = GenerateRandomWalks(pg, "weight", plan);
+  KATANA_LOG_VASSERT(walks_res, "weighted walks: {}", walks_res.error());
+  CheckWalks(*pg, walks_res.value(), true);
+  CheckFirstSteps(*pg, walks_res.value());
+
+  // Only first-order walks support weights
+  KATANA_LOG_ASSERT(!GenerateRandomWalks(
+      pg, "weight", RandomWalksPlan::Node2Vec(kWalkLength, kNumberOfWalks)));
+  KATANA_LOG_ASSERT(!GenerateRandomWalks(pg, "missing", plan));
+}
+
+void
+TestUnweighted(katana::PropertyGraph* pg) {
+  for (const auto& plan :
+       {RandomWalksPlan::FirstOrder(kWalkLength, kNumberOfWalks),
+        RandomWalksPlan::Node2Vec(kWalkLength, kNumberOfWalks),
+        RandomWalksPlan::Node2Vec(kWalkLength, kNumberOfWalks, 0.5, 2.0)}) {
+    auto walks_res = GenerateRandomWalks(pg, plan);
+    KATANA_LOG_VASSERT(walks_res, "walks: {}", walks_res.error());
+    CheckWalks(*pg, walks_res.value(), false);
+  }
+
+  KATANA_LOG_ASSERT(
+      !GenerateRandomWalks(pg, RandomWalksPlan::Node2Vec(0, kNumberOfWalks)));
+}
+
+void
+TestConversions(katana::PropertyGraph* pg) {
+  auto walks_res = GenerateRandomWalks(
+      pg, RandomWalksPlan::Node2Vec(kWalkLength, kNumberOfWalks));
+  KATANA_LOG_ASSERT(walks_res);
+  RandomWalkMatrix walks = std::move(walks_res.value());
+
+  // Walks from the node without out-edges are left out of the vectors
+  std::vector<std::vector<uint32_t>> vectors = walks.ToVectors();
+  KATANA_LOG_ASSERT(vectors.size() == (kNumNodes - 1) * kNumberOfWalks);
+
+  std::vector<uint32_t> first(walks.walk(0), walks.walk(1));
+  auto array_res = walks.ToArrow();
+  KATANA_LOG_VASSERT(array_res, "ToArrow: {}", array_res.error());
+  std::shared_ptr<arrow::FixedSizeListArray> array = array_res.value();
+  KATANA_LOG_ASSERT(
+      static_cast<size_t>(array->length()) == kNumNodes * kNumberOfWalks);
+  KATANA_LOG_ASSERT(array->list_type()->list_size() == kWalkLength + 1);
+  auto values = std::static_pointer_cast<arrow::UInt32Array>(array->values());
+  KATANA_LOG_ASSERT(
+      std::equal(first.begin(), first.end(), values->raw_values()));
+  KATANA_LOG_ASSERT(walks.num_walks() == 0);
+}
+
+}  // namespace
+
+int
+main() {
+  katana::SharedMemSys sys;
+  katana::setActiveThreads(4);
+
+  std::unique_ptr<katana::PropertyGraph> pg = MakeGraph();
+  TestWeighted(pg.get());
+  TestUnweighted(pg.get());
+  TestConversions(pg.get());
+
+  return 0;
+}
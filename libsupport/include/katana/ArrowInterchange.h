@@ -1,6 +1,7 @@
 #ifndef KATANA_LIBSUPPORT_KATANA_ARROWINTERCHANGE_H_
 #define KATANA_LIBSUPPORT_KATANA_ARROWINTERCHANGE_H_
 
+#include <arrow/io/interfaces.h>
 #include <arrow/stl.h>
 #include <arrow/type_traits.h>
 
@@ -305,6 +306,12 @@ KATANA_EXPORT Result<std::shared_ptr<arrow::Table>> TakeRows(
     const std::shared_ptr<arrow::Table>& original,
     const std::shared_ptr<arrow::BooleanArray> picker);
 
+/// Read all record batches of the Arrow IPC file \p file into a table. The
+/// arrays point into the buffers that \p file returns, so a memory mapped or
+/// in-memory file is not copied.
+KATANA_EXPORT Result<std::shared_ptr<arrow::Table>> ReadArrowIpcFile(
+    const std::shared_ptr<arrow::io::RandomAccessFile>& file);
+
 }  // namespace katana
 
 #endif
@@ -49,6 +49,12 @@ struct CacheStats {
             static_cast<float>(insert_hit_count)) /
            total_count();
   }
+  float spill_get_hit_percentage() const {
+    if (spill_get_count == 0LL) {
+      return 0.0;
+    }
+    return 100.0 * static_cast<float>(spill_get_hit_count) / spill_get_count;
+  }
   uint64_t total_count() const { return insert_count + get_count; }
   void Log() const {
     katana::GetTracer().GetActiveSpan().Log(
@@ -60,6 +66,11 @@ struct CacheStats {
             {"total_count", total_count()},
             {"get_count", get_count},
             {"insert_count", insert_count},
+            {"spill_get_per",
+             fmt::format("{:.2f}%", spill_get_hit_percentage())},
+            {"spill_get_count", spill_get_count},
+            {"spill_insert_count", spill_insert_count},
+            {"spill_bytes", spill_bytes},
         });
   }
 
@@ -67,6 +78,12 @@ struct CacheStats {
   int64_t get_hit_count{0LL};
   int64_t insert_count{0LL};
   int64_t insert_hit_count{0LL};
+  // Second tier, for caches that move evicted values to local storage; gets
+  // only count lookups that missed in memory
+  int64_t spill_get_count{0LL};
+  int64_t spill_get_hit_count{0LL};
+  int64_t spill_insert_count{0LL};
+  int64_t spill_bytes{0LL};
 };
 
 template <typename Value>
@@ -79,6 +96,8 @@ class KATANA_EXPORT Cache {
     typename ListType::iterator lru_it;
   };
   using MapType = std::unordered_map<Key, MapValue, Key::Hash>;
+  using EvictedCallback =
+      std::function<void(const Key& key, const Value& value)>;
   // kLRUSize - LRU replacement when the number of elements is above threshold
   // kLRUBytes- LRU replacement when the byte count of elements is above threshold
   // kNone - LRU replacement only on demand
@@ -147,10 +166,14 @@ public:
 
   /// Try to reclaim \p goal bytes (#entries), evicting least recently used entries to
   /// do it.  Returns the number of bytes actually evicted.
-  int64_t Reclaim(int64_t goal) {
+  int64_t Reclaim(int64_t goal) { return Reclaim(goal, nullptr); }
+
+  /// Like Reclaim, but hands every evicted entry to \p evicted, e.g., to move it to
+  /// a slower tier.
+  int64_t Reclaim(int64_t goal, const EvictedCallback& evicted) {
     int64_t reclaimed{};
     while (!empty() && reclaimed < goal) {
-      reclaimed += EvictLastOne();
+      reclaimed += EvictLastOne(evicted);
     }
     return reclaimed;
   }
@@ -248,9 +271,12 @@ private:
     return evicted_value;
   }
 
-  uint64_t EvictLastOne() {
+  uint64_t EvictLastOne(const EvictedCallback& evicted = nullptr) {
     // evict item from the end of most recently used list
     auto tail = --lru_list_.end();
+    if (evicted) {
+      evicted(*tail, key_to_value_.at(*tail).value);
+    }
     auto evicted_value = EvictMe(tail);
     if (value_to_bytes_ != nullptr) {
       return value_to_bytes_(evicted_value);
@@ -0,0 +1,191 @@
+#ifndef KATANA_LIBSUPPORT_KATANA_DELTAVARINT_H_
+#define KATANA_LIBSUPPORT_KATANA_DELTAVARINT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace katana {
+
+/// Maps small negative and positive numbers to small unsigned numbers:
+/// 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+inline uint64_t
+ZigZagEncode(int64_t v) {
+  return (static_cast<uint64_t>(v) << 1) ^ static_cast<uint64_t>(v >> 63);
+}
+
+inline int64_t
+ZigZagDecode(uint64_t v) {
+  return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+}
+
+/// Bytes of the LEB128 varint of \p v
+inline size_t
+VarintSize(uint64_t v) {
+  size_t size = 1;
+  while (v >= 0x80) {
+    v >>= 7;
+    ++size;
+  }
+  return size;
+}
+
+/// Writes the LEB128 varint of \p v to \p out and returns the end of it
+inline uint8_t*
+WriteVarint(uint64_t v, uint8_t* out) {
+  while (v >= 0x80) {
+    *out++ = static_cast<uint8_t>(v | 0x80);
+    v >>= 7;
+  }
+  *out++ = static_cast<uint8_t>(v);
+  return out;
+}
+
+/// Reads a varint at \p *in and advances \p *in past it. The varint must be
+/// complete; use the overload with an end for untrusted input.
+inline uint64_t
+ReadVarint(const uint8_t** in) {
+  const uint8_t* p = *in;
+  uint64_t v = *p & 0x7f;
+  for (unsigned shift = 7; *p & 0x80; shift += 7) {
+    ++p;
+    v |= static_cast<uint64_t>(*p & 0x7f) << shift;
+  }
+  *in = p + 1;
+  return v;
+}
+
+/// Reads a varint at \p *in and advances \p *in past it. Returns false if
+/// the varint runs past \p end or is longer than 64 bits.
+inline bool
+ReadVarint(const uint8_t** in, const uint8_t* end, uint64_t* value) {
+  uint64_t v = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    if (*in == end) {
+      return false;
+    }
+    uint8_t byte = *(*in)++;
+    v |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      *value = v;
+      return true;
+    }
+  }
+  return false;
+}
+
+/// A delta varint block stores the values [begin, end) as the varint of the
+/// first value, followed by the zigzag varints of the differences between
+/// consecutive values. Sorted or clustered integers mostly take one byte
+/// each. Blocks only depend on themselves, so a sequence split into blocks
+/// can be encoded and decoded in parallel.
+template <typename T, typename Fn>
+void
+ForEachDeltaVarint(const T* begin, const T* end, const Fn& fn) {
+  if (begin == end) {
+    return;
+  }
+  fn(static_cast<uint64_t>(*begin));
+  for (const T* it = begin + 1; it != end; ++it) {
+    fn(ZigZagEncode(static_cast<int64_t>(
+        static_cast<uint64_t>(*it) - static_cast<uint64_t>(*(it - 1)))));
+  }
+}
+
+/// Bytes of the delta varint block of [begin, end)
+template <typename T>
+size_t
+DeltaVarintBlockSize(const T* begin, const T* end) {
+  size_t size = 0;
+  ForEachDeltaVarint(begin, end, [&](uint64_t v) { size += VarintSize(v); });
+  return size;
+}
+
+/// Writes the delta varint block of [begin, end) to \p out and returns the
+/// end of it
+template <typename T>
+uint8_t*
+EncodeDeltaVarintBlock(const T* begin, const T* end, uint8_t* out) {
+  ForEachDeltaVarint(
+      begin, end, [&](uint64_t v) { out = WriteVarint(v, out); });
+  return out;
+}
+
+namespace internal {
+
+/// Decodes \p count values of a delta varint block into \p out. Runs of
+/// eight one-byte deltas, the common case for sorted lists, are decoded
+/// without per-byte branches. If \p end is not null, no byte at or past it
+/// is read and false is returned when the block is truncated.
+template <typename T>
+bool
+DecodeDeltaVarintBlock(
+    const uint8_t** in, const uint8_t* end, size_t count, T* out) {
+  if (count == 0) {
+    return true;
+  }
+  uint64_t value{};
+  if (end) {
+    if (!ReadVarint(in, end, &value)) {
+      return false;
+    }
+  } else {
+    value = ReadVarint(in);
+  }
+  out[0] = static_cast<T>(value);
+
+  constexpr uint64_t kContinuationBits = 0x8080808080808080ULL;
+  size_t i = 1;
+  while (i < count) {
+    // Eight more values take at least eight bytes, so the word stays inside
+    // a complete block
+    if (i + 8 <= count && (!end || end - *in >= 8)) {
+      uint64_t word;
+      std::memcpy(&word, *in, sizeof(word));
+      if ((word & kContinuationBits) == 0) {
+        for (size_t j = 0; j < 8; ++j) {
+          value += static_cast<uint64_t>(ZigZagDecode((*in)[j]));
+          out[i + j] = static_cast<T>(value);
+        }
+        *in += 8;
+        i += 8;
+        continue;
+      }
+    }
+    uint64_t delta{};
+    if (end) {
+      if (!ReadVarint(in, end, &delta)) {
+        return false;
+      }
+    } else {
+      delta = ReadVarint(in);
+    }
+    value += static_cast<uint64_t>(ZigZagDecode(delta));
+    out[i++] = static_cast<T>(value);
+  }
+  return true;
+}
+
+}  // namespace internal
+
+/// Decodes \p count values of the complete delta varint block at \p in into
+/// \p out and returns the end of the block
+template <typename T>
+const uint8_t*
+DecodeDeltaVarintBlock(const uint8_t* in, size_t count, T* out) {
+  internal::DecodeDeltaVarintBlock(&in, nullptr, count, out);
+  return in;
+}
+
+/// Decodes \p count values of the delta varint block in [\p in, \p end) into
+/// \p out. Returns false if the block is truncated.
+template <typename T>
+bool
+DecodeDeltaVarintBlock(
+    const uint8_t* in, const uint8_t* end, size_t count, T* out) {
+  return internal::DecodeDeltaVarintBlock(&in, end, count, out);
+}
+
+}  // namespace katana
+
+#endif
@@ -5,6 +5,7 @@
 #include <sstream>
 
 #include <arrow/array/concatenate.h>
+#include <arrow/ipc/reader.h>
 
 #include "katana/Random.h"
 #include "katana/Result.h"
@@ -59,6 +60,18 @@ katana::TakeRows(
   return filtered.table();
 }
 
+katana::Result<std::shared_ptr<arrow::Table>>
+katana::ReadArrowIpcFile(
+    const std::shared_ptr<arrow::io::RandomAccessFile>& file) {
+  auto reader = KATANA_CHECKED(arrow::ipc::RecordBatchFileReader::Open(file));
+  std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+  for (int i = 0; i < reader->num_record_batches(); ++i) {
+    batches.emplace_back(KATANA_CHECKED(reader->ReadRecordBatch(i)));
+  }
+  return KATANA_CHECKED(
+      arrow::Table::FromRecordBatches(reader->schema(), batches));
+}
+
 katana::Result<std::shared_ptr<arrow::ChunkedArray>>
 katana::NullChunkedArray(
     const std::shared_ptr<arrow::DataType>& type, int64_t length) {
@@ -0,0 +1,74 @@
+#include "katana/DeltaVarint.h"
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "katana/Logging.h"
+
+namespace {
+
+template <typename T>
+void
+TestRoundTrip(const std::vector<T>& values) {
+  const T* begin = values.data();
+  const T* end = values.data() + values.size();
+  size_t size = katana::DeltaVarintBlockSize(begin, end);
+  std::vector<uint8_t> encoded(size);
+  KATANA_LOG_ASSERT(
+      katana::EncodeDeltaVarintBlock(begin, end, encoded.data()) ==
+      encoded.data() + size);
+
+  std::vector<T> decoded(values.size());
+  KATANA_LOG_ASSERT(
+      katana::DecodeDeltaVarintBlock(
+          encoded.data(), values.size(), decoded.data()) ==
+      encoded.data() + size);
+  KATANA_LOG_ASSERT(decoded == values);
+
+  decoded.assign(values.size(), 0);
+  KATANA_LOG_ASSERT(katana::DecodeDeltaVarintBlock(
+      encoded.data(), encoded.data() + size, values.size(), decoded.data()));
+  KATANA_LOG_ASSERT(decoded == values);
+
+  if (size > 0) {
+    KATANA_LOG_ASSERT(!katana::DecodeDeltaVarintBlock(
+        encoded.data(), encoded.data() + size - 1, values.size(),
+        decoded.data()));
+  }
+}
+
+}  // namespace
+
+int
+main() {
+  for (int64_t v : {int64_t{0}, int64_t{-1}, int64_t{1}, int64_t{-64},
+                    std::numeric_limits<int64_t>::min(),
+                    std::numeric_limits<int64_t>::max()}) {
+    KATANA_LOG_ASSERT(katana::ZigZagDecode(katana::ZigZagEncode(v)) == v);
+  }
+  KATANA_LOG_ASSERT(katana::ZigZagEncode(-1) == 1);
+  KATANA_LOG_ASSERT(katana::ZigZagEncode(1) == 2);
+
+  KATANA_LOG_ASSERT(katana::VarintSize(0) == 1);
+  KATANA_LOG_ASSERT(katana::VarintSize(127) == 1);
+  KATANA_LOG_ASSERT(katana::VarintSize(128) == 2);
+  KATANA_LOG_ASSERT(
+      katana::VarintSize(std::numeric_limits<uint64_t>::max()) == 10);
+
+  TestRoundTrip<uint32_t>({});
+  TestRoundTrip<uint32_t>({7});
+  // sorted runs take the eight byte fast path, jumps and descents do not
+  std::vector<uint32_t> dests;
+  for (uint32_t i = 0; i < 100; ++i) {
+    dests.emplace_back(i % 10 == 9 ? 1000000 - i : 3 * i);
+  }
+  dests.emplace_back(std::numeric_limits<uint32_t>::max());
+  dests.emplace_back(0);
+  TestRoundTrip(dests);
+  TestRoundTrip<uint64_t>(
+      {0, std::numeric_limits<uint64_t>::max(), 1,
+       std::numeric_limits<uint64_t>::max() - 1, 5, 6, 7, 8, 9, 10, 11, 12});
+
+  return 0;
+}
@@ -16,6 +16,42 @@ namespace katana {
 
 class KATANA_EXPORT FileView : public arrow::io::RandomAccessFile {
 public:
+  /// How reads through the arrow::io::RandomAccessFile interface fetch data
+  /// ahead of the cursor
+  enum class Readahead {
+    /// Only fetch what is read
+    kNone,
+    /// Fetch the size of the last read plus 10% past it. Suits consecutive
+    /// parquet row groups of about the same size.
+    kLastReadSize,
+    /// Detect sequential and constant stride reads and fetch further ahead,
+    /// up to max_readahead_bytes, the longer the pattern holds
+    kAdaptive,
+  };
+
+  struct ReadaheadPolicy {
+    Readahead mode{Readahead::kAdaptive};
+    /// Upper bound on the data fetched ahead of one read
+    uint64_t max_readahead_bytes{UINT64_C(64) << 20};
+    /// Fills larger than this are split into several GetAsync calls that
+    /// are issued together
+    uint64_t max_fetch_bytes{UINT64_C(8) << 20};
+  };
+
+  /// Counters, since the last Bind, of how well data was fetched ahead of use
+  struct Stats {
+    /// Fills of data that was already fetched or being fetched
+    uint64_t hits{0};
+    /// Fills that had to fetch data from storage
+    uint64_t misses{0};
+    /// Fetches that were not complete when their data was needed
+    uint64_t waits{0};
+    /// Bytes requested from storage, including readahead
+    uint64_t bytes_fetched{0};
+    /// Bytes requested by readahead and Prefetch
+    uint64_t bytes_prefetched{0};
+  };
+
   FileView() = default;
   FileView(const FileView&) = delete;
   FileView& operator=(const FileView&) = delete;
@@ -29,7 +65,13 @@ public:
         filename_(std::move(other.filename_)),
         bound_(other.bound_),
         filling_(std::move(other.filling_)),
-        fetches_(std::move(other.fetches_)) {
+        fetches_(std::move(other.fetches_)),
+        readahead_policy_(other.readahead_policy_),
+        last_read_start_(other.last_read_start_),
+        last_read_size_(other.last_read_size_),
+        last_stride_(other.last_stride_),
+        readahead_bytes_(other.readahead_bytes_),
+        stats_(other.stats_) {
     other.bound_ = false;
   }
 
@@ -48,6 +90,12 @@ public:
       filling_ = std::move(other.filling_);
       fetches_ =
           std::unique_ptr<std::vector<FillingRange>>(std::move(other.fetches_));
+      readahead_policy_ = other.readahead_policy_;
+      last_read_start_ = other.last_read_start_;
+      last_read_size_ = other.last_read_size_;
+      last_stride_ = other.last_stride_;
+      readahead_bytes_ = other.readahead_bytes_;
+      stats_ = other.stats_;
       other.bound_ = false;
     }
     return *this;
@@ -77,6 +125,18 @@ public:
 
   katana::Result<void> Fill(uint64_t begin, uint64_t end, bool resolve);
 
+  /// Start fetching [begin, end) of the file in the background, e.g., the
+  /// next part of a file that is about to be parsed. Unlike Fill, the fetched
+  /// bytes count as prefetched in stats().
+  katana::Result<void> Prefetch(uint64_t begin, uint64_t end);
+
+  const ReadaheadPolicy& readahead_policy() const { return readahead_policy_; }
+  void set_readahead_policy(const ReadaheadPolicy& policy) {
+    readahead_policy_ = policy;
+  }
+
+  const Stats& stats() const { return stats_; }
+
   bool Valid() const { return bound_; }
 
   katana::Result<void> Unbind();
@@ -149,10 +209,16 @@ private:
   katana::Result<void> MarkFilled(
       uint64_t* bitmap, uint64_t begin, uint64_t end);
 
+  // Fetch the pages of [begin, end) that have not been fetched yet; Fill and
+  // Prefetch differ in how they are counted
+  katana::Result<void> Fetch(
+      uint64_t begin, uint64_t end, bool resolve, bool prefetch);
+
   // Resolve all outstanding reads that overlap with the range [cursor_, nbytes]
   katana::Result<void> Resolve(int64_t start, int64_t size);
 
   // Start asynchronously fetching data that we think we might need from storage
+  // according to readahead_policy_.
   // @start and @size give the location and range of the previous read
   katana::Result<void> PreFetch(int64_t start, int64_t size);
 
@@ -171,6 +237,14 @@ private:
   bool bound_{false};
   std::vector<uint64_t> filling_;
   std::unique_ptr<std::vector<FillingRange>> fetches_;
+
+  ReadaheadPolicy readahead_policy_;
+  // access pattern of the reads, for Readahead::kAdaptive
+  int64_t last_read_start_{0};
+  int64_t last_read_size_{0};
+  int64_t last_stride_{0};
+  uint64_t readahead_bytes_{0};
+  Stats stats_;
 };
 }  // namespace katana
 
@@ -0,0 +1,55 @@
+#ifndef KATANA_LIBTSUBA_KATANA_MAPPEDFILE_H_
+#define KATANA_LIBTSUBA_KATANA_MAPPEDFILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "katana/Result.h"
+#include "katana/URI.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// MappedFile maps a whole file on local storage into memory. Unlike a
+/// FileView, which reads a file into anonymous memory, the pages of a
+/// MappedFile come straight from the page cache, so they are only read from
+/// disk once per host and are shared by every process that maps the same
+/// file.
+///
+/// The mapping is private and writable: writes go to private copies of the
+/// pages they touch and never reach the file.
+class KATANA_EXPORT MappedFile {
+public:
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  ~MappedFile();
+
+  /// Returns true if \p uri names a file that Make can map
+  static bool IsMappable(const katana::URI& uri);
+
+  static katana::Result<std::shared_ptr<MappedFile>> Make(
+      const katana::URI& uri);
+
+  template <typename T>
+  T* ptr() const {
+    return reinterpret_cast<T*>(data_);
+  }
+
+  size_t size() const { return size_; }
+
+  const katana::URI& uri() const { return uri_; }
+
+private:
+  MappedFile(katana::URI uri, uint8_t* data, size_t size)
+      : uri_(std::move(uri)), data_(data), size_(size) {}
+
+  katana::URI uri_;
+  uint8_t* data_{nullptr};
+  size_t size_{0};
+};
+
+}  // namespace katana
+
+#endif
@@ -2,6 +2,9 @@
 #define KATANA_LIBTSUBA_KATANA_PARQUETREADER_H_
 
 #include <optional>
+#include <string>
+#include <variant>
+#include <vector>
 
 #include <arrow/api.h>
 
@@ -31,6 +34,36 @@ public:
     static ReadOpts Defaults() { return ReadOpts{}; }
   };
 
+  /// A bound on the values of a column, compared with the statistics of
+  /// integer, floating point and string columns respectively
+  using Bound = std::variant<int64_t, double, std::string>;
+
+  /// Restricts a scan to the row groups whose statistics show that they may
+  /// contain values of `column` in [min, max]. Row groups are filtered, not
+  /// rows: the row groups that are read may contain other values too, and
+  /// row groups without statistics are always read.
+  struct RowGroupFilter {
+    std::string column;
+    Bound min;
+    Bound max;
+  };
+
+  struct ScanOpts {
+    /// names of the columns to read, in this order; all columns if empty
+    std::vector<std::string> columns;
+    /// only read the row groups that may pass all of the filters
+    std::vector<RowGroupFilter> filters;
+    /// number of threads that read row groups in parallel, 0 for one per
+    /// hardware thread
+    uint32_t num_threads{0};
+  };
+
+  /// What a ScanTable read from storage
+  struct ScanStats {
+    /// bytes fetched for the metadata and the column chunks
+    uint64_t bytes_fetched{0};
+  };
+
   /// build a reader that will read a table from storage location optionally
   /// reading only part of the table.
   /// \param opts an opt structure detailing how reads should behave (see
@@ -52,6 +85,16 @@ public:
       const katana::URI& uri, const std::vector<int32_t>& column_bitmap,
       std::optional<Slice> slice = std::nullopt);
 
+  /// read a table from storage, fetching and decoding only the row groups
+  /// and columns selected by \p opts. The row groups are split among
+  /// several threads, each of which only fetches the bytes of the column
+  /// chunks it decodes.
+  ///   \param uri an identifier for a parquet file
+  ///   \param stats if not null, set to what the scan read from storage
+  katana::Result<std::shared_ptr<arrow::Table>> ScanTable(
+      const katana::URI& uri, const ScanOpts& opts,
+      ScanStats* stats = nullptr);
+
   /// read only the schema from a parquet file in storage
   katana::Result<std::shared_ptr<arrow::Schema>> GetSchema(
       const katana::URI& uri);
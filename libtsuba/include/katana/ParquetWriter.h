@@ -2,6 +2,7 @@
 #define KATANA_LIBTSUBA_KATANA_PARQUETWRITER_H_
 
 #include <limits>
+#include <optional>
 #include <vector>
 
 #include <arrow/api.h>
@@ -10,11 +11,22 @@
 #include "katana/Result.h"
 #include "katana/URI.h"
 #include "katana/WriteGroup.h"
+#include "katana/ZoneMap.h"
 
 namespace katana {
 
 class KATANA_EXPORT ParquetWriter {
 public:
+  enum class DictionaryEncoding {
+    /// Dictionary encode every column; Parquet falls back to plain encoding
+    /// when a dictionary grows too large
+    kAlways,
+    /// Like kAlways, except for string columns with many distinct values in a
+    /// sample of their first rows, whose dictionaries would be discarded
+    kAuto,
+    kNever,
+  };
+
   struct WriteOpts {
     /// int64 timestamps with nanosecond resolution requires Parquet version
     /// 2.0. In Arrow to Parquet version 1.0, nanosecond timestamps will get
@@ -31,9 +43,42 @@ public:
 
     /// control the approximate size of blocked files when writing blocked
     uint64_t mbs_per_block{256};
+
+    /// Codec for data pages; codecs that this build of Arrow lacks are
+    /// replaced with no compression
+    arrow::Compression::type compression{arrow::Compression::UNCOMPRESSED};
+    /// codec specific level, the codec's default if absent
+    std::optional<int> compression_level{std::nullopt};
+
+    DictionaryEncoding dictionary{DictionaryEncoding::kAlways};
+
+    /// maximum number of rows in a row group, which is the unit readers can
+    /// skip
+    int64_t max_row_group_rows{std::numeric_limits<int64_t>::max()};
+
+    /// if true, store min/max statistics for every column chunk
+    bool write_statistics{true};
+
+    /// if true, compute a ZoneMap of every column, with one zone per row
+    /// group, see zone_maps()
+    bool compute_zone_maps{false};
+
+    /// if true, RDG property files of fixed width columns are stored in the
+    /// Arrow IPC file format instead, which loaders can map without decoding.
+    /// Only zone maps apply to those files; ParquetWriter ignores this.
+    bool fixed_width_as_arrow{false};
+
     static WriteOpts Defaults() { return WriteOpts{}; }
+
+    /// Options for RDG property files: zstd compressed, dictionaries for low
+    /// cardinality strings, and row groups of kPropertyRowGroupRows rows
+    /// that are described by zone maps. Fixed width properties are stored as
+    /// Arrow IPC files if KATANA_ARROW_PROPERTY_FILES is set.
+    static WriteOpts Properties();
   };
 
+  static constexpr int64_t kPropertyRowGroupRows = 1 << 20;
+
   /// \returns a Writer that will write a table consisting of a single column
   /// \param array will become the lone column in the table
   /// \param name will become the name of the column in the table
@@ -57,12 +102,19 @@ public:
   katana::Result<void> WriteToUri(
       const katana::URI& uri, WriteGroup* group = nullptr);
 
+  /// The zone maps of the columns of the table, if WriteOpts requested them
+  const std::vector<ZoneMap>& zone_maps() const { return zone_maps_; }
+
 private:
   ParquetWriter(
-      std::vector<std::shared_ptr<arrow::Table>> tables, WriteOpts opts)
-      : tables_(std::move(tables)), opts_(opts) {}
+      std::vector<std::shared_ptr<arrow::Table>> tables, WriteOpts opts,
+      std::vector<ZoneMap> zone_maps)
+      : tables_(std::move(tables)),
+        opts_(opts),
+        zone_maps_(std::move(zone_maps)) {}
 
-  std::shared_ptr<parquet::WriterProperties> StandardWriterProperties();
+  std::shared_ptr<parquet::WriterProperties> StandardWriterProperties(
+      const arrow::Table& table);
 
   std::shared_ptr<parquet::ArrowWriterProperties> StandardArrowProperties();
 
@@ -75,6 +127,7 @@ private:
 
   std::vector<std::shared_ptr<arrow::Table>> tables_;
   WriteOpts opts_;
+  std::vector<ZoneMap> zone_maps_;
 };
 
 }  // namespace katana
@@ -0,0 +1,203 @@
+#ifndef KATANA_LIBTSUBA_KATANA_PROPERTYHASHINDEXPRIMITIVE_H_
+#define KATANA_LIBTSUBA_KATANA_PROPERTYHASHINDEXPRIMITIVE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "katana/ErrorCode.h"
+#include "katana/FileFrame.h"
+#include "katana/FileView.h"
+#include "katana/JSON.h"
+#include "katana/Logging.h"
+#include "katana/NUMAArray.h"
+#include "katana/RDGOptionalDatastructure.h"
+#include "katana/Result.h"
+#include "katana/URI.h"
+#include "katana/config.h"
+#include "katana/file.h"
+#include "katana/tsuba.h"
+
+namespace katana {
+
+/// Prefix of the optional datastructure names of hash indexes. The full name
+/// also identifies the entity kind and the indexed properties, see
+/// PropertyHashIndexPrimitive::name().
+const std::string kOptionalDatastructurePropertyHashIndexPrimitive =
+    "kg.v1.property_hash_index";
+const std::string kOptionalDatastructurePropertyHashIndexPrimitiveFilename =
+    "property_hash_index_manifest";
+
+/// The on-storage form of a hash index over one or more node or edge
+/// properties (see katana::HashIndex in libgraph). The manifest holds the
+/// description of the index and the arrays are stored in their own files,
+/// listed in paths_.
+class KATANA_EXPORT PropertyHashIndexPrimitive
+    : private katana::RDGOptionalDatastructure {
+public:
+  static katana::Result<PropertyHashIndexPrimitive> Load(
+      const katana::URI& rdg_dir_path, const std::string& path) {
+    PropertyHashIndexPrimitive index =
+        KATANA_CHECKED(LoadJson(rdg_dir_path.Join(path).string()));
+
+    KATANA_CHECKED(LoadArray(rdg_dir_path, index.paths_, "ids", &index.ids_));
+    KATANA_CHECKED(LoadArray(
+        rdg_dir_path, index.paths_, "group_offsets", &index.group_offsets_));
+    KATANA_CHECKED(LoadArray(
+        rdg_dir_path, index.paths_, "group_hashes", &index.group_hashes_));
+    KATANA_CHECKED(
+        LoadArray(rdg_dir_path, index.paths_, "slots", &index.slots_));
+
+    return index;
+  }
+
+  katana::Result<std::string> Write(katana::URI rdg_dir_path) {
+    paths_.clear();
+    KATANA_CHECKED(WriteArray(rdg_dir_path, "ids", ids_));
+    KATANA_CHECKED(WriteArray(rdg_dir_path, "group_offsets", group_offsets_));
+    KATANA_CHECKED(WriteArray(rdg_dir_path, "group_hashes", group_hashes_));
+    KATANA_CHECKED(WriteArray(rdg_dir_path, "slots", slots_));
+
+    // Write out our json manifest
+    katana::URI manifest_path = rdg_dir_path.RandFile(
+        kOptionalDatastructurePropertyHashIndexPrimitiveFilename);
+    KATANA_CHECKED(WriteManifest(manifest_path.string()));
+    return manifest_path.BaseName();
+  }
+
+  /// The optional datastructure name of the index over \p property_names of
+  /// nodes (or edges if \p is_edge_index).
+  static std::string name(
+      bool is_edge_index, const std::vector<std::string>& property_names) {
+    std::string name = fmt::format(
+        "{}.{}", kOptionalDatastructurePropertyHashIndexPrimitive,
+        is_edge_index ? "edge" : "node");
+    for (const auto& property_name : property_names) {
+      name += "." + property_name;
+    }
+    return name;
+  }
+  std::string name() const { return name(is_edge_index_, property_names_); }
+
+  bool is_edge_index() const { return is_edge_index_; }
+  void set_is_edge_index(bool is_edge_index) { is_edge_index_ = is_edge_index; }
+
+  const std::vector<std::string>& property_names() const {
+    return property_names_;
+  }
+  void set_property_names(std::vector<std::string> property_names) {
+    property_names_ = std::move(property_names);
+  }
+
+  /// Number of nodes or edges of the graph when the index was built
+  uint64_t num_entities() const { return num_entities_; }
+  void set_num_entities(uint64_t num) { num_entities_ = num; }
+
+  /// Indexed entities, grouped by key
+  katana::NUMAArray<uint64_t>& ids() { return ids_; }
+  /// Start of each group of entities with the same key in ids, followed by
+  /// the number of ids
+  katana::NUMAArray<uint64_t>& group_offsets() { return group_offsets_; }
+  /// Hash of the key of each group
+  katana::NUMAArray<uint64_t>& group_hashes() { return group_hashes_; }
+  /// Open addressing table of group number + 1, 0 for empty slots
+  katana::NUMAArray<uint64_t>& slots() { return slots_; }
+
+  friend void to_json(
+      nlohmann::json& j, const PropertyHashIndexPrimitive& index);
+  friend void from_json(
+      const nlohmann::json& j, PropertyHashIndexPrimitive& index);
+
+private:
+  bool is_edge_index_{false};
+  std::vector<std::string> property_names_;
+  uint64_t num_entities_{0};
+
+  /// data structures dumped to their own files
+
+  katana::NUMAArray<uint64_t> ids_;
+  katana::NUMAArray<uint64_t> group_offsets_;
+  katana::NUMAArray<uint64_t> group_hashes_;
+  katana::NUMAArray<uint64_t> slots_;
+
+  static katana::Result<PropertyHashIndexPrimitive> LoadJson(
+      const std::string& path) {
+    katana::FileView fv;
+    KATANA_CHECKED(fv.Bind(path, true));
+
+    if (fv.size() == 0) {
+      return PropertyHashIndexPrimitive();
+    }
+
+    PropertyHashIndexPrimitive index;
+    KATANA_CHECKED(katana::JsonParse<PropertyHashIndexPrimitive>(fv, &index));
+
+    return index;
+  }
+
+  static katana::Result<void> LoadArray(
+      const katana::URI& rdg_dir_path,
+      const std::map<std::string, std::string>& paths,
+      const std::string& array_name, katana::NUMAArray<uint64_t>* array) {
+    auto it = paths.find(array_name);
+    if (it == paths.end()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "hash index manifest has no {} file", array_name);
+    }
+
+    katana::FileView fv;
+    KATANA_CHECKED(fv.Bind(rdg_dir_path.Join(it->second).string(), true));
+    if (fv.size() % sizeof(uint64_t) != 0) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "hash index file {} has a partial entry", it->second);
+    }
+
+    array->allocateInterleaved(fv.size() / sizeof(uint64_t));
+    if (fv.size() != 0) {
+      std::copy(
+          fv.ptr<uint64_t>(), fv.ptr<uint64_t>() + array->size(),
+          array->begin());
+    }
+    KATANA_CHECKED(fv.Unbind());
+
+    return katana::ResultSuccess();
+  }
+
+  katana::Result<void> WriteArray(
+      const katana::URI& rdg_dir_path, const std::string& array_name,
+      const katana::NUMAArray<uint64_t>& array) {
+    katana::URI path =
+        rdg_dir_path.RandFile("property_hash_index_" + array_name);
+    KATANA_CHECKED(katana::FileStore(
+        path.string(), array.data(), array.size() * sizeof(uint64_t)));
+    paths_[array_name] = path.BaseName();
+
+    return katana::ResultSuccess();
+  }
+
+  katana::Result<void> WriteManifest(const std::string& path) const {
+    std::string serialized = KATANA_CHECKED(katana::JsonDump(*this));
+    // POSIX files end with newlines
+    serialized = serialized + "\n";
+
+    auto ff = std::make_unique<katana::FileFrame>();
+    KATANA_CHECKED(ff->Init(serialized.size()));
+    if (auto res = ff->Write(serialized.data(), serialized.size()); !res.ok()) {
+      return KATANA_ERROR(
+          katana::ArrowToKatana(res.code()), "arrow error: {}", res);
+    }
+    ff->Bind(path);
+    // persist now
+    KATANA_CHECKED(ff->Persist());
+
+    return katana::ResultSuccess();
+  }
+};
+
+}  // namespace katana
+
+#endif
@@ -17,7 +17,10 @@
 #include "katana/FileFrame.h"
 #include "katana/FileView.h"
 #include "katana/NUMAArray.h"
+#include "katana/ParquetReader.h"
+#include "katana/ParquetWriter.h"
 #include "katana/PartitionMetadata.h"
+#include "katana/PropertyHashIndexPrimitive.h"
 #include "katana/RDGLineage.h"
 #include "katana/RDGStorageFormatVersion.h"
 #include "katana/RDGTopology.h"
@@ -48,12 +51,20 @@ struct KATANA_EXPORT RDGLoadOptions {
   /// List of edge properties that should be loaded
   /// nullptr means all edge properties will be loaded
   std::optional<std::vector<std::string>> edge_properties{std::nullopt};
+  /// If true, raw topology files and Arrow IPC property files on local
+  /// storage are memory mapped and used in place rather than read into
+  /// memory. Their pages come from the page cache, so they are shared by
+  /// every process on the host that loads the same RDG this way. Block
+  /// compressed topologies, Parquet property files and files on remote
+  /// storage are read as usual.
+  bool map_local_files{false};
 
   /// Build a default options struct the default behavior is:
   ///  * load the partition associated with this host
   ///  * load all node properties
   ///  * load all edge properties
   ///  * do not use a property cache
+  ///  * read files into memory rather than mapping them
   static RDGLoadOptions Defaults() { return RDGLoadOptions{}; }
 };
 
@@ -191,6 +202,34 @@ public:
   katana::Result<URI> GetEdgePropertyStorageLocation(
       const std::string& name) const;
 
+  /// Set how the property with \p name is written from now on, e.g., its
+  /// compression codec, dictionary encoding and row group size. Properties
+  /// default to ParquetWriter::WriteOpts::Properties()
+  void SetNodePropertyWriteOpts(
+      const std::string& name, const ParquetWriter::WriteOpts& opts);
+  void SetEdgePropertyWriteOpts(
+      const std::string& name, const ParquetWriter::WriteOpts& opts);
+
+  /// The zones recorded when the property with \p name was last written; the
+  /// zone map is empty if the property was written without zones. Returns an
+  /// error if the property is dirty, like GetNodePropertyStorageLocation
+  katana::Result<ZoneMap> GetNodePropertyZoneMap(const std::string& name) const;
+  katana::Result<ZoneMap> GetEdgePropertyZoneMap(const std::string& name) const;
+
+  /// Read from storage the rows of the node property with \p name that may
+  /// hold values in [\p min, \p max], as selected by its zone map, without
+  /// adding them to the property table. The rows of \p slices (which may be
+  /// null) are returned in order; a property without zones is read whole.
+  /// Returns an error if the property is dirty, like GetNodePropertyZoneMap
+  katana::Result<std::shared_ptr<arrow::Table>> ReadNodePropertyRange(
+      const std::string& name, const ParquetReader::Bound& min,
+      const ParquetReader::Bound& max,
+      std::vector<ParquetReader::Slice>* slices = nullptr) const;
+  katana::Result<std::shared_ptr<arrow::Table>> ReadEdgePropertyRange(
+      const std::string& name, const ParquetReader::Bound& min,
+      const ParquetReader::Bound& max,
+      std::vector<ParquetReader::Slice>* slices = nullptr) const;
+
   /// Load node property with a particular name and insert it into the
   /// property table at index. If index is invalid, the property is put
   /// in the last slot. A given property cannot be loaded more than once
@@ -231,6 +270,8 @@ public:
 
   /// Ask this RDG if it has a topology matching the fields in shadow
   /// If it does, the RDG returns the topology
+  /// The topology is bound with RDGTopology::BindMapped if this RDG was
+  /// loaded with RDGLoadOptions::map_local_files
   katana::Result<katana::RDGTopology*> GetTopology(const RDGTopology& shadow);
 
   katana::Result<void> UnbindNodeEntityTypeIDArrayFileStorage();
@@ -333,6 +374,14 @@ public:
   katana::Result<void> WriteRDKSubstructureIndexPrimitive(
       katana::RDKSubstructureIndexPrimitive& index);
 
+  // Returns std::nullopt if no hash index named `name` (see
+  // PropertyHashIndexPrimitive::name()) was written to this RDG
+  katana::Result<std::optional<katana::PropertyHashIndexPrimitive>>
+  LoadPropertyHashIndexPrimitive(const std::string& name);
+
+  katana::Result<void> WritePropertyHashIndexPrimitive(
+      katana::PropertyHashIndexPrimitive& index);
+
 private:
   std::string view_type_;
   RDG(std::unique_ptr<RDGCore>&& core);
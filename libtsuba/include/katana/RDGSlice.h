@@ -102,6 +102,13 @@ public:
   // topology and friends
   const FileView& topology_file_storage() const;
 
+  /// The CSR topology if it is stored block compressed, or nullptr. For
+  /// compressed topologies, topo_off and topo_size are ignored: the adjacency
+  /// indices of node_range and the destinations of edge_range are decoded
+  /// instead (see RDGTopology::MapSlice), while topology_file_storage holds
+  /// the whole compressed file.
+  const RDGTopology* compressed_topology() const;
+
   // optional partition metadata
   const std::vector<std::shared_ptr<arrow::ChunkedArray>>& master_nodes() const;
   const std::vector<std::shared_ptr<arrow::ChunkedArray>>& mirror_nodes() const;
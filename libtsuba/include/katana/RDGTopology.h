@@ -2,12 +2,16 @@
 #define KATANA_LIBTSUBA_KATANA_RDGTOPOLOGY_H_
 
 #include <array>
+#include <memory>
+#include <utility>
 
 #include "katana/EntityTypeManager.h"
 #include "katana/ErrorCode.h"
 #include "katana/FileView.h"
 #include "katana/JSON.h"
 #include "katana/Logging.h"
+#include "katana/MappedFile.h"
+#include "katana/NUMAArray.h"
 #include "katana/Result.h"
 #include "katana/URI.h"
 #include "katana/WriteGroup.h"
@@ -44,7 +48,12 @@ public:
     kInvalid = -1,
     kAny = 0,
     kSortedByDegree,
-    kSortedByNodeType
+    kSortedByNodeType,
+    // Locality improving orders, see katana/GraphReordering.h
+    kReorderedByDegreeGrouping,
+    kReorderedByRCM,
+    kReorderedByGorder,
+    kReorderedByRabbit
   };
 
   enum class TopologyKind : int {
@@ -55,6 +64,14 @@ public:
     kEdgeTypeAwareTopology
   };
 
+  /// How the adjacency indices and destinations are laid out in the topology
+  /// file; see Map
+  enum class StorageEncoding : int {
+    kInvalid = -1,
+    kRaw = 0,
+    kBlockCompressed
+  };
+
   //
   // File Store Accessors/Mutators
   //
@@ -74,6 +91,8 @@ public:
   void unmap_file_storage() {
     adj_indices_ = nullptr;
     dests_ = nullptr;
+    decoded_adj_indices_ = NUMAArray<uint64_t>();
+    decoded_dests_ = NUMAArray<uint32_t>();
     edge_index_to_property_index_map_ = nullptr;
     node_index_to_property_index_map_ = nullptr;
     edge_condensed_type_id_map_ = nullptr;
@@ -90,6 +109,7 @@ public:
 
     if (file_store_bound_) {
       KATANA_CHECKED(file_storage_.Unbind());
+      mapped_file_.reset();
       file_store_bound_ = false;
     }
     return katana::ResultSuccess();
@@ -181,6 +201,16 @@ public:
 
   NodeSortKind node_sort_state() const { return node_sort_state_; }
 
+  StorageEncoding storage_encoding() const { return storage_encoding_; }
+
+  /// Set the encoding of the file written by the next DoStore that writes
+  /// this topology. In memory topologies start with
+  /// StorageEncoding::kBlockCompressed if KATANA_COMPRESS_TOPOLOGY is set and
+  /// with StorageEncoding::kRaw otherwise.
+  void set_storage_encoding(StorageEncoding storage_encoding) {
+    storage_encoding_ = storage_encoding;
+  }
+
   std::string path() const;
   void set_path(const std::string& path);
 
@@ -205,6 +235,18 @@ public:
       const katana::URI& metadata_dir, uint64_t begin, uint64_t end,
       bool resolve);
 
+  /// Like Bind, but a raw topology file on local storage is memory mapped
+  /// (see MappedFile) instead of being read into memory, and Map points into
+  /// that mapping. Other topology files are bound like Bind does.
+  katana::Result<void> BindMapped(const katana::URI& metadata_dir);
+
+  /// The file that BindMapped mapped, or null. The arrays that Map extracts
+  /// from it stay valid while a reference to it is held, even after
+  /// unbind_file_storage.
+  const std::shared_ptr<MappedFile>& mapped_file() const {
+    return mapped_file_;
+  }
+
   /// Map takes the file buffer of a topology file and extracts the
   /// topology elements
   ///
@@ -233,12 +275,27 @@ public:
   ///   uint64_t magic_number: sum of num_edges + num_nodes
   ///   katana::EntityTypeID node_condensed_type_id_map: condensed map of the nodes EntityTypeIDs
   ///
+  /// Topologies stored with StorageEncoding::kBlockCompressed have version 2,
+  /// and out_indices, out_dests and the padding after them are replaced by a
+  /// block compressed section (see BlockCompressedTopologyFile.h), which is
+  /// decoded in parallel into memory owned by this RDGTopology.
+  ///
   /// Since property graphs store their edge data separately, we
   /// ignore the size_of_edge_data (data[1]) and the
   /// void*[num_edges] edge_data
   /// defined by FileGraph.cpp
   katana::Result<void> Map();
 
+  /// Like Map, but only makes the adjacency indices of nodes [\p node_range)
+  /// and the destinations of edges [\p edge_range) available. Afterwards,
+  /// adj_indices()[0] is the adjacency index of node_range.first and dests()[0]
+  /// the destination of edge_range.first. Optional topology data structures
+  /// are not mapped. Block compressed topologies only decode the blocks that
+  /// cover the ranges.
+  katana::Result<void> MapSlice(
+      std::pair<uint64_t, uint64_t> node_range,
+      std::pair<uint64_t, uint64_t> edge_range);
+
   /// Map a topology file and extract its metadata
   /// this only loads the topology metadata into the PartitionTopologyMetadataEntry
   /// *ONLY USE THIS FOR BACKWARDS COMPATIBILITY*
@@ -320,6 +377,7 @@ private:
   TransposeKind transpose_state_{-1};
   EdgeSortKind edge_sort_state_{-1};
   NodeSortKind node_sort_state_{-1};
+  StorageEncoding storage_encoding_{StorageEncoding::kRaw};
   uint64_t edge_condensed_type_id_map_size_{0};
   uint64_t node_condensed_type_id_map_size_{0};
 
@@ -345,7 +403,24 @@ private:
   const katana::EntityTypeID* edge_condensed_type_id_map_{nullptr};
   const katana::EntityTypeID* node_condensed_type_id_map_{nullptr};
 
+  // backing memory of adj_indices_ and dests_ when they are decoded from a
+  // block compressed file
+  NUMAArray<uint64_t> decoded_adj_indices_;
+  NUMAArray<uint32_t> decoded_dests_;
+
   FileView file_storage_;
+  /// set instead of file_storage_ by BindMapped
+  std::shared_ptr<MappedFile> mapped_file_;
+
+  /// The bound topology file, whichever way it was bound
+  template <typename T>
+  const T* storage_ptr() const {
+    return mapped_file_ ? mapped_file_->ptr<const T>()
+                        : file_storage_.ptr<T>();
+  }
+  size_t storage_size() const {
+    return mapped_file_ ? mapped_file_->size() : file_storage_.size();
+  }
 
   static katana::Result<katana::RDGTopology> DoMake(
       katana::RDGTopology topo, const uint64_t* adj_indices, uint64_t num_nodes,
@@ -353,7 +428,13 @@ private:
       TransposeKind transpose_state, EdgeSortKind edge_sort_state,
       NodeSortKind node_sort_state);
 
-  size_t GetGraphSize() const;
+  /// Expected size of the topology file, given that its adjacency indices and
+  /// destinations take \p csr_size bytes
+  size_t GetGraphSize(size_t csr_size) const;
+
+  /// Validates the mandatory fields of a bound topology file against the
+  /// metadata
+  katana::Result<void> CheckHeader() const;
 
   // Topology File Offset Definitions
   static constexpr size_t version_num_offset = 0;
@@ -0,0 +1,159 @@
+#ifndef KATANA_LIBTSUBA_KATANA_SIMULATEDSTORAGE_H_
+#define KATANA_LIBTSUBA_KATANA_SIMULATEDSTORAGE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "katana/FileStorage.h"
+#include "katana/Result.h"
+#include "katana/config.h"
+
+namespace katana {
+
+/// SimulatedStorage is a storage backend for benchmarking the storage path. It
+/// serves URIs with its own scheme (by default sim://) from another backend
+/// (by default the local file system) by swapping the scheme, and makes every
+/// request look like it went to a remote object store: each one waits for a
+/// free request slot, pays a fixed latency and then takes its share of a
+/// link with limited bandwidth. The time spent on the real request is hidden
+/// inside the simulated time, so the local disk only shows through when it is
+/// slower than the simulated store.
+///
+/// Every request is recorded, per URI, so that the access pattern of a load
+/// (how many requests, of what size, how many in flight at once) can be
+/// inspected after the fact.
+///
+/// Like any backend, it has to be registered with RegisterFileStorage before
+/// katana::InitTsuba and must outlive katana::FiniTsuba.
+class KATANA_EXPORT SimulatedStorage : public FileStorage {
+public:
+  struct Options {
+    /// Time added to every request before any of its bytes move
+    std::chrono::microseconds latency{0};
+    /// Bytes per second shared by all requests; 0 means no limit
+    uint64_t bandwidth{0};
+    /// Requests in flight at once; the rest queue. 0 means no limit
+    uint32_t max_concurrent_requests{0};
+    /// Record a Request for every request
+    bool record_trace{true};
+
+    /// Options from the environment, any unset variable keeping its default:
+    ///
+    ///   KATANA_SIMULATED_STORAGE_LATENCY_US
+    ///   KATANA_SIMULATED_STORAGE_BANDWIDTH_MBPS (in MB/s)
+    ///   KATANA_SIMULATED_STORAGE_MAX_CONCURRENT_REQUESTS
+    ///   KATANA_SIMULATED_STORAGE_RECORD_TRACE
+    static Options FromEnv();
+  };
+
+  enum class RequestKind {
+    kStat,
+    kGet,
+    kPut,
+    kList,
+    kDelete,
+    kCopy,
+  };
+
+  struct Request {
+    RequestKind kind;
+    uint64_t begin{0};
+    uint64_t size{0};
+    /// When the request was issued, relative to Init
+    std::chrono::nanoseconds issued{0};
+    /// Time spent waiting for a request slot
+    std::chrono::nanoseconds queued{0};
+    /// Time from issue to completion
+    std::chrono::nanoseconds elapsed{0};
+    bool ok{true};
+  };
+
+  using Trace = std::unordered_map<std::string, std::vector<Request>>;
+
+  explicit SimulatedStorage(
+      Options opts = Options::FromEnv(), std::string_view uri_scheme = "sim://",
+      std::string_view target_scheme = "file://");
+
+  const Options& options() const { return opts_; }
+  std::string_view target_scheme() const { return target_scheme_; }
+
+  /// Returns the URI served by this storage that names \p uri of the target
+  /// storage, e.g., sim:///data/graph for file:///data/graph
+  katana::Result<std::string> Wrap(const std::string& uri) const;
+
+  /// Returns a copy of the requests recorded so far, by URI
+  Trace GetTrace() const;
+  void ClearTrace();
+
+  katana::Result<void> Init() override;
+  katana::Result<void> Fini() override;
+  katana::Result<void> Stat(const std::string& uri, StatBuf* s_buf) override;
+
+  katana::Result<void> GetMultiSync(
+      const std::string& uri, uint64_t start, uint64_t size,
+      uint8_t* result_buf) override;
+
+  katana::Result<void> PutMultiSync(
+      const std::string& uri, const uint8_t* data, uint64_t size) override;
+
+  katana::Result<void> RemoteCopy(
+      const std::string& source_uri, const std::string& dest_uri,
+      uint64_t begin, uint64_t size) override;
+
+  std::future<katana::CopyableResult<void>> PutAsync(
+      const std::string& uri, const uint8_t* data, uint64_t size) override;
+  std::future<katana::CopyableResult<void>> GetAsync(
+      const std::string& uri, uint64_t start, uint64_t size,
+      uint8_t* result_buf) override;
+  std::future<katana::CopyableResult<void>> ListAsync(
+      const std::string& directory, std::vector<std::string>* list,
+      std::vector<uint64_t>* size) override;
+
+  katana::Result<void> Delete(
+      const std::string& directory,
+      const std::unordered_set<std::string>& files) override;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  katana::Result<std::string> Unwrap(const std::string& uri) const;
+
+  /// Runs \p op against the target storage as a simulated request of \p size
+  /// bytes moved over the link
+  template <typename OpFunc>
+  katana::Result<void> Simulate(
+      RequestKind kind, const std::string& uri, uint64_t begin, uint64_t size,
+      OpFunc op);
+
+  void AcquireSlot();
+  void ReleaseSlot();
+  /// Reserves the link for \p size bytes no earlier than \p ready and returns
+  /// when the transfer ends
+  Clock::time_point ReserveLink(Clock::time_point ready, uint64_t size);
+
+  Options opts_;
+  std::string target_scheme_;
+  Clock::time_point start_{Clock::now()};
+
+  std::mutex slots_mutex_;
+  std::condition_variable slots_cv_;
+  uint32_t in_flight_{0};
+
+  std::mutex link_mutex_;
+  Clock::time_point link_free_{};
+
+  mutable std::mutex trace_mutex_;
+  Trace trace_;
+};
+
+}  // namespace katana
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef KATANA_LIBTSUBA_KATANA_ZONEMAP_H_
+#define KATANA_LIBTSUBA_KATANA_ZONEMAP_H_
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "katana/JSON.h"
+#include "katana/ParquetReader.h"
+#include "katana/Result.h"
+
+namespace katana {
+
+/// Returns true if \p a < \p b. Integers and floating point numbers are
+/// compared with each other as floating point numbers; comparing a string
+/// with a number is an error.
+KATANA_EXPORT Result<bool> BoundLess(
+    const ParquetReader::Bound& a, const ParquetReader::Bound& b);
+
+/// The minimum and maximum value of consecutive rows of a property
+struct KATANA_EXPORT Zone {
+  int64_t offset{0};
+  int64_t length{0};
+  int64_t null_count{0};
+  /// Absent if the rows have no values that can be compared, e.g., they are
+  /// all null or of a type without an order
+  std::optional<ParquetReader::Bound> min;
+  std::optional<ParquetReader::Bound> max;
+};
+
+/// Min/max statistics of fixed size ranges of rows of a property, stored in
+/// the RDG part header. They let loaders decide which parts of a property to
+/// fetch before touching its file.
+class KATANA_EXPORT ZoneMap {
+public:
+  ZoneMap() = default;
+
+  /// Computes the zones of \p array, each of which covers \p rows_per_zone
+  /// rows (except for the last). Integer (including temporal), floating point
+  /// and string columns get bounds; other columns only get row and null
+  /// counts.
+  static Result<ZoneMap> Make(
+      const arrow::ChunkedArray& array, int64_t rows_per_zone);
+
+  /// Returns the row ranges that may contain values in [\p min, \p max].
+  /// Adjacent ranges are merged, and zones without bounds are always
+  /// selected.
+  Result<std::vector<ParquetReader::Slice>> Select(
+      const ParquetReader::Bound& min, const ParquetReader::Bound& max) const;
+
+  const std::vector<Zone>& zones() const { return zones_; }
+  bool empty() const { return zones_.empty(); }
+
+  friend void to_json(nlohmann::json& j, const ZoneMap& zone_map);
+  friend void from_json(const nlohmann::json& j, ZoneMap& zone_map);
+
+private:
+  std::vector<Zone> zones_;
+};
+
+KATANA_EXPORT void to_json(nlohmann::json& j, const ZoneMap& zone_map);
+KATANA_EXPORT void from_json(const nlohmann::json& j, ZoneMap& zone_map);
+
+}  // namespace katana
+
+#endif
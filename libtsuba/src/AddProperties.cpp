@@ -6,6 +6,7 @@
 #include <arrow/chunked_array.h>
 #include <arrow/type_fwd.h>
 
+#include "ArrowPropertyFile.h"
 #include "katana/ArrowInterchange.h"
 #include "katana/ErrorCode.h"
 #include "katana/FileView.h"
@@ -22,12 +23,20 @@ namespace {
 katana::Result<std::shared_ptr<arrow::Table>>
 DoLoadProperties(
     const std::string& expected_name, const katana::URI& file_path,
-    std::optional<katana::ParquetReader::Slice> slice = std::nullopt) {
-  std::unique_ptr<katana::ParquetReader> reader =
-      KATANA_CHECKED(katana::ParquetReader::Make());
-
-  std::shared_ptr<arrow::Table> out =
-      KATANA_CHECKED(reader->ReadTable(file_path, slice));
+    std::optional<katana::ParquetReader::Slice> slice = std::nullopt,
+    bool map_local_files = false) {
+  std::shared_ptr<arrow::Table> out;
+  if (katana::IsArrowPropertyFile(file_path.path())) {
+    out = KATANA_CHECKED(
+        katana::LoadArrowPropertyFile(file_path, map_local_files));
+    if (slice) {
+      out = out->Slice(slice->offset, slice->length);
+    }
+  } else {
+    std::unique_ptr<katana::ParquetReader> reader =
+        KATANA_CHECKED(katana::ParquetReader::Make());
+    out = KATANA_CHECKED(reader->ReadTable(file_path, slice));
+  }
 
   std::shared_ptr<arrow::Schema> schema = out->schema();
   if (schema->num_fields() != 1) {
@@ -48,9 +57,11 @@ DoLoadProperties(
 
 katana::Result<std::shared_ptr<arrow::Table>>
 katana::LoadProperties(
-    const std::string& expected_name, const katana::URI& file_path) {
+    const std::string& expected_name, const katana::URI& file_path,
+    bool map_local_files) {
   try {
-    return DoLoadProperties(expected_name, file_path);
+    return DoLoadProperties(
+        expected_name, file_path, std::nullopt, map_local_files);
   } catch (const std::exception& exp) {
     return KATANA_ERROR(
         katana::ErrorCode::ArrowError, "arrow exception: {}", exp.what());
@@ -76,7 +87,8 @@ katana::AddProperties(
     const katana::URI& uri, bool is_property,
     const std::vector<katana::PropStorageInfo*>& properties, ReadGroup* grp,
     const std::function<katana::Result<void>(std::shared_ptr<arrow::Table>)>&
-        add_fn) {
+        add_fn,
+    bool map_local_files) {
   for (katana::PropStorageInfo* prop : properties) {
     if (!prop->IsAbsent()) {
       return KATANA_ERROR(
@@ -121,10 +133,11 @@ katana::AddProperties(
     std::future<katana::CopyableResult<std::shared_ptr<arrow::Table>>> future =
         std::async(
             std::launch::async,
-            [prop,
-             path]() -> katana::CopyableResult<std::shared_ptr<arrow::Table>> {
+            [prop, path, map_local_files]()
+                -> katana::CopyableResult<std::shared_ptr<arrow::Table>> {
               return KATANA_CHECKED_CONTEXT(
-                  LoadProperties(prop->name(), path), "error loading {}", path);
+                  LoadProperties(prop->name(), path, map_local_files),
+                  "error loading {}", path);
             });
     auto on_complete = [add_fn, is_property,
                         prop](const std::shared_ptr<arrow::Table>& props)
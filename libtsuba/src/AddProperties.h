@@ -10,8 +10,13 @@
 
 namespace katana {
 
+/// Loads the property file at \p file_path, which is either a Parquet file or,
+/// if its name says so, an Arrow IPC file (see ArrowPropertyFile.h). Arrow IPC
+/// files on local storage are mapped instead of read if \p map_local_files
+/// is true.
 KATANA_EXPORT katana::Result<std::shared_ptr<arrow::Table>> LoadProperties(
-    const std::string& expected_name, const katana::URI& file_path);
+    const std::string& expected_name, const katana::URI& file_path,
+    bool map_local_files = false);
 
 KATANA_EXPORT katana::Result<std::shared_ptr<arrow::Table>> LoadPropertySlice(
     const std::string& expected_name, const katana::URI& file_path,
@@ -22,7 +27,8 @@ KATANA_EXPORT katana::Result<void> AddProperties(
     const katana::URI& uri, bool is_property,
     const std::vector<katana::PropStorageInfo*>& properties, ReadGroup* grp,
     const std::function<katana::Result<void>(std::shared_ptr<arrow::Table>)>&
-        add_fn);
+        add_fn,
+    bool map_local_files = false);
 
 KATANA_EXPORT katana::Result<void> AddPropertySlice(
     const katana::URI& dir,
@@ -0,0 +1,114 @@
+#include "ArrowPropertyFile.h"
+
+#include <future>
+#include <vector>
+
+#include <arrow/io/file.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/writer.h>
+#include <arrow/type_traits.h>
+
+#include "katana/ArrowInterchange.h"
+#include "katana/ErrorCode.h"
+#include "katana/FaultTest.h"
+#include "katana/FileFrame.h"
+#include "katana/FileView.h"
+#include "katana/MappedFile.h"
+
+namespace {
+
+/// A buffer over the whole of a bound FileView, which keeps the FileView (and
+/// so its memory) alive for as long as the buffer or its slices are
+class FileViewBuffer : public arrow::Buffer {
+public:
+  explicit FileViewBuffer(std::shared_ptr<katana::FileView> fv)
+      : arrow::Buffer(fv->ptr<uint8_t>(), fv->size()), fv_(std::move(fv)) {}
+
+private:
+  std::shared_ptr<katana::FileView> fv_;
+};
+
+katana::Result<std::shared_ptr<arrow::io::RandomAccessFile>>
+OpenFile(const katana::URI& uri, bool map_local_files) {
+  if (map_local_files && katana::MappedFile::IsMappable(uri)) {
+    // slices of a memory mapped file keep the mapping alive
+    return KATANA_CHECKED_CONTEXT(
+        arrow::io::MemoryMappedFile::Open(
+            uri.path(), arrow::io::FileMode::READ),
+        "mapping {}", uri);
+  }
+  auto fv = std::make_shared<katana::FileView>();
+  KATANA_CHECKED_CONTEXT(fv->Bind(uri.string(), true), "reading {}", uri);
+  return std::make_shared<arrow::io::BufferReader>(
+      std::make_shared<FileViewBuffer>(std::move(fv)));
+}
+
+}  // namespace
+
+bool
+katana::IsArrowPropertyFile(const std::string& path) {
+  return path.size() >= kArrowPropertyFileSuffix.size() &&
+         path.compare(
+             path.size() - kArrowPropertyFileSuffix.size(),
+             kArrowPropertyFileSuffix.size(), kArrowPropertyFileSuffix) == 0;
+}
+
+bool
+katana::CanStoreArrowPropertyFile(const arrow::DataType& type) {
+  return type.id() != arrow::Type::DICTIONARY &&
+         arrow::is_fixed_width(type.id());
+}
+
+katana::Result<void>
+katana::StoreArrowPropertyFile(
+    std::shared_ptr<arrow::Table> table, const katana::URI& uri,
+    katana::WriteGroup* desc) {
+  for (const auto& field : table->schema()->fields()) {
+    if (!CanStoreArrowPropertyFile(*field->type())) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "column {} of type {} is not fixed width", field->name(),
+          field->type()->ToString());
+    }
+  }
+
+  auto ff = std::make_shared<katana::FileFrame>();
+  KATANA_CHECKED(ff->Init());
+  ff->Bind(uri.string());
+
+  auto future = std::async(
+      std::launch::async,
+      [table = std::move(table), ff = std::move(ff), desc,
+       uri]() mutable -> katana::CopyableResult<void> {
+        auto writer = KATANA_CHECKED_CONTEXT(
+            arrow::ipc::MakeFileWriter(ff, table->schema()), "writing {}",
+            uri);
+        KATANA_CHECKED_CONTEXT(writer->WriteTable(*table), "writing {}", uri);
+        KATANA_CHECKED_CONTEXT(writer->Close(), "writing {}", uri);
+        table.reset();
+
+        if (desc) {
+          desc->AddToOutstanding(ff->map_size());
+        }
+
+        TSUBA_PTP(katana::internal::FaultSensitivity::Normal);
+        KATANA_CHECKED(ff->Persist());
+
+        return katana::CopyableResultSuccess();
+      });
+
+  if (!desc) {
+    KATANA_CHECKED(future.get());
+    return katana::ResultSuccess();
+  }
+
+  desc->AddOp(std::move(future), uri.string());
+  return katana::ResultSuccess();
+}
+
+katana::Result<std::shared_ptr<arrow::Table>>
+katana::LoadArrowPropertyFile(const katana::URI& uri, bool map_local_files) {
+  std::shared_ptr<arrow::io::RandomAccessFile> in =
+      KATANA_CHECKED(OpenFile(uri, map_local_files));
+  return KATANA_CHECKED_CONTEXT(ReadArrowIpcFile(in), "reading {}", uri);
+}
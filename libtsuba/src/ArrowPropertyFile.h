@@ -0,0 +1,43 @@
+#ifndef KATANA_LIBTSUBA_ARROWPROPERTYFILE_H_
+#define KATANA_LIBTSUBA_ARROWPROPERTYFILE_H_
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <arrow/api.h>
+
+#include "katana/Result.h"
+#include "katana/URI.h"
+#include "katana/WriteGroup.h"
+
+namespace katana {
+
+/// Property files whose names end with this suffix are stored in the Arrow IPC
+/// file format, uncompressed, instead of Parquet. Their buffers are laid out
+/// on storage like they are in memory, so they are used without decoding and,
+/// on local storage, without copying.
+constexpr std::string_view kArrowPropertyFileSuffix = ".arrow";
+
+KATANA_EXPORT bool IsArrowPropertyFile(const std::string& path);
+
+/// Returns true for the types that StoreArrowPropertyFile accepts: the fixed
+/// width types except for dictionaries
+KATANA_EXPORT bool CanStoreArrowPropertyFile(const arrow::DataType& type);
+
+/// Writes \p table to \p uri. If \p desc is null the write is synchronous,
+/// otherwise it is added to \p desc.
+KATANA_EXPORT katana::Result<void> StoreArrowPropertyFile(
+    std::shared_ptr<arrow::Table> table, const katana::URI& uri,
+    katana::WriteGroup* desc);
+
+/// Reads the table at \p uri. If \p map_local_files is true and the file is
+/// on local storage, the arrays of the table point into a read only mapping
+/// of the file. Otherwise the file is read into memory once and the arrays
+/// point into that copy.
+KATANA_EXPORT katana::Result<std::shared_ptr<arrow::Table>>
+LoadArrowPropertyFile(const katana::URI& uri, bool map_local_files);
+
+}  // namespace katana
+
+#endif
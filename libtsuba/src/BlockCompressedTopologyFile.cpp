@@ -0,0 +1,233 @@
+#include "BlockCompressedTopologyFile.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "katana/DeltaVarint.h"
+#include "katana/ErrorCode.h"
+#include "katana/Loops.h"
+
+namespace {
+
+constexpr uint64_t kNumHeaderFields = 5;
+
+uint64_t
+NumBlocks(uint64_t num_values, uint64_t values_per_block) {
+  return num_values / values_per_block +
+         (num_values % values_per_block == 0 ? 0 : 1);
+}
+
+template <typename T>
+std::vector<std::string>
+EncodeBlocks(const T* values, uint64_t num_values, uint64_t values_per_block) {
+  std::vector<std::string> blocks(NumBlocks(num_values, values_per_block));
+  katana::do_all(
+      katana::iterate(size_t{0}, blocks.size()),
+      [&](size_t b) {
+        uint64_t begin = b * values_per_block;
+        uint64_t end = std::min(begin + values_per_block, num_values);
+        std::string& block = blocks[b];
+        block.resize(
+            katana::DeltaVarintBlockSize(values + begin, values + end));
+        katana::EncodeDeltaVarintBlock(
+            values + begin, values + end,
+            reinterpret_cast<uint8_t*>(block.data()));
+      },
+      katana::steal());
+  return blocks;
+}
+
+/// Decodes the values [begin, end) of the blocks described by offsets.
+/// Returns false if a block is truncated.
+template <typename T>
+bool
+DecodeBlocks(
+    const uint8_t* payload, const uint64_t* offsets, uint64_t values_per_block,
+    uint64_t begin, uint64_t end, T* out) {
+  if (begin >= end) {
+    return true;
+  }
+  uint64_t first_block = begin / values_per_block;
+  uint64_t last_block = (end - 1) / values_per_block;
+  std::atomic<bool> truncated{false};
+  katana::do_all(
+      katana::iterate(first_block, last_block + 1),
+      [&](uint64_t b) {
+        uint64_t block_begin = b * values_per_block;
+        uint64_t stop = std::min(block_begin + values_per_block, end);
+        // blocks are decoded from their start, so the first and last block
+        // of the range may go through a scratch buffer
+        std::vector<T> scratch;
+        T* block_out{};
+        if (block_begin < begin || stop < block_begin + values_per_block) {
+          scratch.resize(stop - block_begin);
+          block_out = scratch.data();
+        } else {
+          block_out = out + (block_begin - begin);
+        }
+        if (!katana::DecodeDeltaVarintBlock(
+                payload + offsets[b], payload + offsets[b + 1],
+                stop - block_begin, block_out)) {
+          truncated = true;
+          return;
+        }
+        if (block_out == scratch.data()) {
+          uint64_t first = std::max(block_begin, begin);
+          std::copy(
+              scratch.begin() + (first - block_begin), scratch.end(),
+              out + (first - begin));
+        }
+      },
+      katana::steal());
+  return !truncated;
+}
+
+katana::Result<void>
+WriteWords(const std::vector<uint64_t>& words, katana::FileFrame* ff) {
+  arrow::Status aro_sts =
+      ff->Write(words.data(), words.size() * sizeof(uint64_t));
+  if (!aro_sts.ok()) {
+    return katana::ArrowToKatana(aro_sts.code());
+  }
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+katana::Result<void>
+katana::BlockCompressedTopologyFile::Encode(
+    const uint64_t* indices, uint64_t num_indices, const uint32_t* dests,
+    uint64_t num_dests, FileFrame* ff) {
+  std::vector<std::string> index_blocks =
+      EncodeBlocks(indices, num_indices, kIndicesPerBlock);
+  std::vector<std::string> dest_blocks =
+      EncodeBlocks(dests, num_dests, kDestsPerBlock);
+
+  std::vector<uint64_t> offsets;
+  offsets.reserve(index_blocks.size() + dest_blocks.size() + 2);
+  uint64_t payload_size = 0;
+  for (const auto* blocks : {&index_blocks, &dest_blocks}) {
+    for (const std::string& block : *blocks) {
+      offsets.emplace_back(payload_size);
+      payload_size += block.size();
+    }
+    offsets.emplace_back(payload_size);
+  }
+
+  KATANA_CHECKED(WriteWords(
+      {num_indices, num_dests, kIndicesPerBlock, kDestsPerBlock, payload_size},
+      ff));
+  KATANA_CHECKED(WriteWords(offsets, ff));
+  for (const auto* blocks : {&index_blocks, &dest_blocks}) {
+    for (const std::string& block : *blocks) {
+      arrow::Status aro_sts = ff->Write(block.data(), block.size());
+      if (!aro_sts.ok()) {
+        return katana::ArrowToKatana(aro_sts.code());
+      }
+    }
+  }
+
+  // keep the rest of the topology file aligned
+  uint64_t padding = (sizeof(uint64_t) - payload_size % sizeof(uint64_t)) %
+                     sizeof(uint64_t);
+  if (padding > 0) {
+    uint64_t zero = 0;
+    arrow::Status aro_sts = ff->Write(&zero, padding);
+    if (!aro_sts.ok()) {
+      return katana::ArrowToKatana(aro_sts.code());
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<katana::BlockCompressedTopologyFile>
+katana::BlockCompressedTopologyFile::Make(const uint64_t* data, size_t size) {
+  size_t num_words = size / sizeof(uint64_t);
+  if (num_words < kNumHeaderFields) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "compressed topology of {} bytes is too small for its header", size);
+  }
+
+  BlockCompressedTopologyFile topo;
+  topo.num_indices_ = data[0];
+  topo.num_dests_ = data[1];
+  topo.indices_per_block_ = data[2];
+  topo.dests_per_block_ = data[3];
+  uint64_t payload_size = data[4];
+  if (topo.indices_per_block_ == 0 || topo.dests_per_block_ == 0) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "compressed topology has empty blocks");
+  }
+
+  uint64_t num_index_blocks =
+      NumBlocks(topo.num_indices_, topo.indices_per_block_);
+  uint64_t num_dest_blocks = NumBlocks(topo.num_dests_, topo.dests_per_block_);
+  uint64_t num_offsets = num_index_blocks + num_dest_blocks + 2;
+  uint64_t payload_words =
+      (payload_size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+  if (num_words - kNumHeaderFields < num_offsets ||
+      num_words - kNumHeaderFields - num_offsets < payload_words) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "compressed topology is truncated: {} bytes for {} indices and {} "
+        "dests",
+        size, topo.num_indices_, topo.num_dests_);
+  }
+
+  topo.index_offsets_ = data + kNumHeaderFields;
+  topo.dest_offsets_ = topo.index_offsets_ + num_index_blocks + 1;
+  topo.payload_ = reinterpret_cast<const uint8_t*>(
+      data + kNumHeaderFields + num_offsets);
+  topo.size_bytes_ =
+      (kNumHeaderFields + num_offsets + payload_words) * sizeof(uint64_t);
+
+  // blocks are decoded in parallel without further checks, so make sure
+  // they stay inside the payload now
+  const uint64_t* offsets = topo.index_offsets_;
+  for (uint64_t i = 0; i < num_offsets; ++i) {
+    if (offsets[i] > payload_size || (i > 0 && offsets[i] < offsets[i - 1])) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "compressed topology has a bad block offset {} at {}", offsets[i],
+          i);
+    }
+  }
+  return topo;
+}
+
+katana::Result<void>
+katana::BlockCompressedTopologyFile::DecodeIndices(
+    uint64_t begin, uint64_t end, uint64_t* out) const {
+  if (begin > end || end > num_indices_) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "index range [{}, {}) is out of bounds for {} indices", begin, end,
+        num_indices_);
+  }
+  if (!DecodeBlocks(
+          payload_, index_offsets_, indices_per_block_, begin, end, out)) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "compressed topology indices are corrupt");
+  }
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::BlockCompressedTopologyFile::DecodeDests(
+    uint64_t begin, uint64_t end, uint32_t* out) const {
+  if (begin > end || end > num_dests_) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "dest range [{}, {}) is out of bounds for {} dests", begin, end,
+        num_dests_);
+  }
+  if (!DecodeBlocks(
+          payload_, dest_offsets_, dests_per_block_, begin, end, out)) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "compressed topology dests are corrupt");
+  }
+  return katana::ResultSuccess();
+}
@@ -0,0 +1,76 @@
+#ifndef KATANA_LIBTSUBA_BLOCKCOMPRESSEDTOPOLOGYFILE_H_
+#define KATANA_LIBTSUBA_BLOCKCOMPRESSEDTOPOLOGYFILE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "katana/FileFrame.h"
+#include "katana/Result.h"
+
+namespace katana {
+
+/// BlockCompressedTopologyFile reads and writes the block compressed encoding
+/// of the adjacency indices and destinations of a topology file.
+///
+/// Indices and destinations are split into fixed size blocks, each stored as
+/// a delta varint block (see katana/DeltaVarint.h). Adjacency indices grow
+/// slowly and destinations of a node are often close to each other, so most
+/// differences take one or two bytes instead of eight or four. Since blocks
+/// only depend on themselves, they are encoded and decoded in parallel, and a
+/// range of values only needs the blocks that cover it.
+///
+/// Format of the section (all fields uint64_t unless noted otherwise)
+///
+///   num_indices, num_dests: number of values
+///   indices_per_block, dests_per_block: values per block
+///   payload_size: bytes of encoded blocks
+///   uint64_t[num_index_blocks + 1] index_offsets: where index blocks start
+///     in the payload; the last entry is where the index blocks end
+///   uint64_t[num_dest_blocks + 1] dest_offsets: likewise for dest blocks
+///   uint8_t[payload_size] payload, zero padded to a multiple of 8 bytes
+class BlockCompressedTopologyFile {
+public:
+  static constexpr uint64_t kIndicesPerBlock = uint64_t{1} << 12;
+  static constexpr uint64_t kDestsPerBlock = uint64_t{1} << 14;
+
+  /// Appends the section encoding \p indices and \p dests to \p ff
+  static katana::Result<void> Encode(
+      const uint64_t* indices, uint64_t num_indices, const uint32_t* dests,
+      uint64_t num_dests, FileFrame* ff);
+
+  /// Parses the section at the start of \p data, which holds \p size bytes.
+  /// The section is not copied, so \p data must outlive the result.
+  static katana::Result<BlockCompressedTopologyFile> Make(
+      const uint64_t* data, size_t size);
+
+  /// Decodes indices [\p begin, \p end) into \p out
+  katana::Result<void> DecodeIndices(
+      uint64_t begin, uint64_t end, uint64_t* out) const;
+
+  /// Decodes destinations [\p begin, \p end) into \p out
+  katana::Result<void> DecodeDests(
+      uint64_t begin, uint64_t end, uint32_t* out) const;
+
+  uint64_t num_indices() const { return num_indices_; }
+  uint64_t num_dests() const { return num_dests_; }
+
+  /// Bytes of the section, including padding; the section is followed by the
+  /// rest of the topology file
+  size_t size_bytes() const { return size_bytes_; }
+
+private:
+  BlockCompressedTopologyFile() = default;
+
+  uint64_t num_indices_{0};
+  uint64_t num_dests_{0};
+  uint64_t indices_per_block_{0};
+  uint64_t dests_per_block_{0};
+  const uint64_t* index_offsets_{nullptr};
+  const uint64_t* dest_offsets_{nullptr};
+  const uint8_t* payload_{nullptr};
+  size_t size_bytes_{0};
+};
+
+}  // namespace katana
+
+#endif
@@ -3,7 +3,9 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cstdio>
 #include <string>
 
@@ -66,8 +68,8 @@ katana::Result<void>
 katana::FileView::Bind(
     std::string_view filename, uint64_t begin, uint64_t end, bool resolve) {
   StatBuf buf;
-  filename_ = filename;
-  KATANA_CHECKED_CONTEXT(FileStat(filename_, &buf), "{}", filename);
+  std::string new_filename(filename);
+  KATANA_CHECKED_CONTEXT(FileStat(new_filename, &buf), "{}", filename);
 
   uint64_t in_end = std::min<uint64_t>(end, static_cast<uint64_t>(buf.size));
   if (in_end < begin) {
@@ -78,12 +80,6 @@ katana::FileView::Bind(
         begin, end, buf.size);
   }
 
-  // SCB 2020-07-23: Given that page_shift_ is treated as a compile-time
-  // constant, it seems silly to have it be a member of this class. But I can
-  // imagine one day wanting to set it dynamically based on file type, file
-  // size, type of backing storage, etc. So make it a class member and set it
-  // here.
-  page_shift_ = 20; /* 1M */
   void* tmp = nullptr;
 
   // Map enough virtual memory to hold entire file, but do not populate it
@@ -96,14 +92,27 @@ katana::FileView::Bind(
     }
   }
 
+  // Unbind resets the members describing the file, so set them after it
   KATANA_CHECKED(Unbind());
 
+  // SCB 2020-07-23: Given that page_shift_ is treated as a compile-time
+  // constant, it seems silly to have it be a member of this class. But I can
+  // imagine one day wanting to set it dynamically based on file type, file
+  // size, type of backing storage, etc. So make it a class member and set it
+  // here.
+  page_shift_ = 20; /* 1M */
+  filename_ = std::move(new_filename);
   map_start_ = static_cast<uint8_t*>(tmp);
   mem_start_ = -1;
   filling_.clear();
   filling_.resize(page_number(buf.size) / 64 + 1, 0);
   file_size_ = buf.size;
   fetches_ = std::make_unique<std::vector<FillingRange>>();
+  last_read_start_ = 0;
+  last_read_size_ = 0;
+  last_stride_ = 0;
+  readahead_bytes_ = 0;
+  stats_ = Stats();
   KATANA_CHECKED_CONTEXT(
       Fill(begin, in_end, resolve), "failed to fill, begin: {}, end: {}", begin,
       in_end);
@@ -115,6 +124,17 @@ katana::FileView::Bind(
 
 katana::Result<void>
 katana::FileView::Fill(uint64_t begin, uint64_t end, bool resolve) {
+  return Fetch(begin, end, resolve, false);
+}
+
+katana::Result<void>
+katana::FileView::Prefetch(uint64_t begin, uint64_t end) {
+  return Fetch(begin, end, false, true);
+}
+
+katana::Result<void>
+katana::FileView::Fetch(
+    uint64_t begin, uint64_t end, bool resolve, bool prefetch) {
   uint64_t in_end = std::min<uint64_t>(end, file_size_);
   uint64_t in_begin = std::min<uint64_t>(begin, in_end);
   uint64_t first_page = 0;
@@ -129,12 +149,19 @@ katana::FileView::Fill(uint64_t begin, uint64_t end, bool resolve) {
   }
   // Gracefully handle the fill zero case here to simplify Bind
   if (in_end != in_begin) {
-    if (auto opt =
-            MustFill(&filling_[0], page_number(in_begin), page_number(in_end));
+    if (auto opt = MustFill(
+            &filling_[0], page_number(in_begin), page_number(in_end - 1));
         opt.has_value()) {
       std::tie(first_page, last_page) = opt.value();
       found_empty = true;
     }
+    if (!prefetch) {
+      if (found_empty) {
+        stats_.misses += 1;
+      } else {
+        stats_.hits += 1;
+      }
+    }
 
     uint64_t file_off = first_page * (1UL << page_shift_);
     uint64_t map_size = std::min(
@@ -148,20 +175,38 @@ katana::FileView::Fill(uint64_t begin, uint64_t end, bool resolve) {
         return KATANA_ERROR(katana::ResultErrno(), "mprotecting buffer");
       }
 
-      auto peek_fut =
-          FileGetAsync(filename_, map_start_ + file_off, file_off, map_size);
-      KATANA_LOG_ASSERT(peek_fut.valid());
-      FillingRange fetch = {first_page, last_page, std::move(peek_fut)};
-      fetches_->push_back(std::move(fetch));
-      KATANA_CHECKED(MarkFilled(&filling_[0], first_page, last_page));
-      if (resolve) {
-        KATANA_CHECKED(Resolve(file_off, map_size));
+      // Split large regions so that the storage backend can fetch the pieces
+      // in parallel
+      uint64_t pages_per_fetch = std::max<uint64_t>(
+          1, page_number(readahead_policy_.max_fetch_bytes));
+      for (uint64_t page = first_page; page <= last_page;
+           page += pages_per_fetch) {
+        uint64_t piece_last = std::min(last_page, page + pages_per_fetch - 1);
+        uint64_t piece_off = page * (1UL << page_shift_);
+        uint64_t piece_size =
+            std::min(file_off + map_size, (piece_last + 1) << page_shift_) -
+            piece_off;
+        auto peek_fut = FileGetAsync(
+            filename_, map_start_ + piece_off, piece_off, piece_size);
+        KATANA_LOG_ASSERT(peek_fut.valid());
+        FillingRange fetch = {page, piece_last, std::move(peek_fut)};
+        fetches_->push_back(std::move(fetch));
+      }
+      stats_.bytes_fetched += map_size;
+      if (prefetch) {
+        stats_.bytes_prefetched += map_size;
       }
+
+      KATANA_CHECKED(MarkFilled(&filling_[0], first_page, last_page));
       int64_t signed_begin = static_cast<int64_t>(in_begin);
       if (mem_start_ < 0 || signed_begin < mem_start_) {
         mem_start_ = signed_begin;
       }
     }
+    // Also wait for earlier fetches of the range, e.g., by readahead
+    if (resolve) {
+      KATANA_CHECKED(Resolve(in_begin, in_end - in_begin));
+    }
   }
   return katana::ResultSuccess();
 }
@@ -462,12 +507,17 @@ katana::FileView::Resolve(int64_t start, int64_t size) {
   // This loop could do less work by sorting the vector or storing an
   // interval tree, but that seems like overkill unless this becomes a
   // bottleneck
+  uint64_t first_page = page_number(start);
+  uint64_t last_page = size > 0 ? page_number(start + size - 1) : first_page;
   for (auto it = fetches_->begin(); it != fetches_->end();) {
     auto fetch = it;
-    if (fetch->first_page <= page_number(start + size) ||
-        fetch->last_page >= page_number(start)) {
+    if (fetch->first_page <= last_page && fetch->last_page >= first_page) {
       // Complete the remaining work if there is some
       if (fetch->work.valid()) {
+        if (fetch->work.wait_for(std::chrono::seconds(0)) ==
+            std::future_status::timeout) {
+          stats_.waits += 1;
+        }
         KATANA_CHECKED(fetch->work.get());
       } else {
         KATANA_LOG_DEBUG("bad future in FileView::Resolve {} {}", start, size);
@@ -482,15 +532,63 @@ katana::FileView::Resolve(int64_t start, int64_t size) {
 
 katana::Result<void>
 katana::FileView::PreFetch(int64_t start, int64_t size) {
-  // Our highly sophisticated prefetching algorithm is to crudely approximate
-  // the size of the last read plus 10%. This is largely motivated by parquet
-  // files, which consecutively read row groups that are (in theory)
-  // approximately the same size.
-  int64_t fetch_size = (size / 10) * 11;
-  // Make sure we haven't overflown
-  KATANA_LOG_DEBUG_ASSERT(fetch_size >= 0);
-  uint64_t begin = static_cast<uint64_t>(start + size);
-  uint64_t end = static_cast<uint64_t>(start + size + fetch_size);
-  KATANA_CHECKED(Fill(begin, end, false));
+  // Nothing was read, e.g., a read at EOF; there is no pattern to follow and
+  // it must not become part of one
+  if (size <= 0) {
+    return katana::ResultSuccess();
+  }
+
+  uint64_t next = static_cast<uint64_t>(start + size);
+
+  switch (readahead_policy_.mode) {
+  case Readahead::kNone:
+    return katana::ResultSuccess();
+  case Readahead::kLastReadSize: {
+    // Our highly sophisticated prefetching algorithm is to crudely
+    // approximate the size of the last read plus 10%. This is largely
+    // motivated by parquet files, which consecutively read row groups that
+    // are (in theory) approximately the same size.
+    int64_t fetch_size = (size / 10) * 11;
+    // Make sure we haven't overflown
+    KATANA_LOG_DEBUG_ASSERT(fetch_size >= 0);
+    return Prefetch(next, next + static_cast<uint64_t>(fetch_size));
+  }
+  case Readahead::kAdaptive:
+    break;
+  }
+
+  int64_t stride = start - last_read_start_;
+  bool sequential = last_read_size_ > 0 && stride == last_read_size_;
+  bool strided = stride > size && stride == last_stride_;
+  last_read_start_ = start;
+  last_read_size_ = size;
+  last_stride_ = stride;
+
+  if (!sequential && !strided) {
+    // Random access; fetching ahead would only waste bandwidth
+    readahead_bytes_ = 0;
+    return katana::ResultSuccess();
+  }
+
+  // Like the kernel's readahead, double the window while the pattern holds
+  readahead_bytes_ = std::min(
+      std::max(2 * readahead_bytes_, static_cast<uint64_t>(size)),
+      readahead_policy_.max_readahead_bytes);
+
+  if (sequential) {
+    return Prefetch(next, next + readahead_bytes_);
+  }
+
+  // Fetch the next reads of a constant stride, e.g., one column of
+  // consecutive row groups, but not the gaps between them
+  uint64_t num_reads =
+      std::max<uint64_t>(1, readahead_bytes_ / static_cast<uint64_t>(size));
+  for (uint64_t i = 1; i <= num_reads; ++i) {
+    uint64_t read_start = static_cast<uint64_t>(start) + i * stride;
+    if (read_start >= static_cast<uint64_t>(file_size_)) {
+      break;
+    }
+    KATANA_CHECKED(Prefetch(read_start, read_start + size));
+  }
   return katana::ResultSuccess();
 }
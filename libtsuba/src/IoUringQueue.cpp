@@ -0,0 +1,727 @@
+#include "IoUringQueue.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <system_error>
+
+#include "katana/ErrorCode.h"
+#include "katana/Logging.h"
+#include "katana/config.h"
+#include "katana/file.h"
+
+#if defined(KATANA_USE_IO_URING) && __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#define KATANA_HAVE_IO_URING 1
+#endif
+
+struct katana::IoUringQueue::Request {
+  std::string path;
+  int fd{-1};
+  bool is_write{false};
+  /// caller buffer; only read from for writes
+  uint8_t* data{nullptr};
+  uint64_t start{0};
+  uint64_t size{0};
+
+  /// file range of the chunks not yet given a slot
+  uint64_t next_offset{0};
+  uint64_t end{0};
+
+  /// chunks given a slot but not completed
+  uint32_t outstanding{0};
+  bool all_assigned{false};
+  /// bytes of the request past the end of the file
+  uint64_t missing{0};
+  std::optional<katana::CopyableErrorInfo> error;
+
+  std::promise<katana::CopyableResult<void>> promise;
+};
+
+struct katana::IoUringQueue::Slot {
+  uint32_t index{0};
+  Request* request{nullptr};
+  /// buffer the chunk is read into or written from
+  uint8_t* buf{nullptr};
+  /// file offset and length of the chunk
+  uint64_t offset{0};
+  uint64_t len{0};
+  /// bytes of the chunk completed so far
+  uint64_t done{0};
+  /// part of buf that belongs to the caller's buffer; only differs from
+  /// [0, len) when a direct read is widened to aligned offsets
+  uint64_t copy_begin{0};
+  uint64_t copy_end{0};
+  /// the kernel owns the chunk
+  bool in_flight{false};
+};
+
+namespace {
+
+#if KATANA_HAVE_IO_URING
+
+constexpr uint64_t kShutdownUserData = ~uint64_t{0};
+
+int
+IoUringSetup(uint32_t entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int
+IoUringEnter(
+    int fd, uint32_t to_submit, uint32_t min_complete, uint32_t flags) {
+  return static_cast<int>(syscall(
+      __NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+int
+IoUringRegister(int fd, uint32_t opcode, void* arg, uint32_t nr_args) {
+  return static_cast<int>(
+      syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+katana::Result<void>
+CheckOpsSupported(int ring_fd, const std::vector<uint8_t>& ops) {
+  constexpr size_t kMaxOps = 256;
+  std::vector<uint8_t> storage(
+      sizeof(io_uring_probe) + kMaxOps * sizeof(io_uring_probe_op));
+  auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+  if (IoUringRegister(ring_fd, IORING_REGISTER_PROBE, probe, kMaxOps) < 0) {
+    return KATANA_ERROR(
+        katana::ResultErrno(), "probing io_uring operations (Linux < 5.6?)");
+  }
+  for (uint8_t op : ops) {
+    if (op > probe->last_op ||
+        !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) {
+      return KATANA_ERROR(
+          katana::ErrorCode::NotImplemented,
+          "io_uring operation {} not supported", op);
+    }
+  }
+  return katana::ResultSuccess();
+}
+
+#endif
+
+uint64_t
+AlignDown(uint64_t v, uint64_t alignment) {
+  return v - v % alignment;
+}
+
+uint64_t
+AlignUp(uint64_t v, uint64_t alignment) {
+  return AlignDown(v + alignment - 1, alignment);
+}
+
+}  // namespace
+
+katana::Result<std::unique_ptr<katana::IoUringQueue>>
+katana::IoUringQueue::Make(uint32_t depth, bool direct) {
+#if KATANA_HAVE_IO_URING
+  if (depth == 0) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "io_uring queue depth must be positive");
+  }
+  // new to access non-public constructor
+  std::unique_ptr<IoUringQueue> queue(new IoUringQueue(direct));
+  KATANA_CHECKED(queue->Setup(depth));
+  if (direct) {
+    KATANA_CHECKED(queue->RegisterBuffers());
+  }
+  queue->reaper_ = std::thread([q = queue.get()]() { q->ReapLoop(); });
+  return std::move(queue);
+#else
+  (void)depth;
+  (void)direct;
+  return KATANA_ERROR(
+      ErrorCode::NotImplemented, "built without io_uring support");
+#endif
+}
+
+katana::IoUringQueue::IoUringQueue(bool direct) : direct_(direct) {}
+
+katana::IoUringQueue::~IoUringQueue() {
+#if KATANA_HAVE_IO_URING
+  if (reaper_.joinable()) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    // Requests own their slots until they finish. A reaper that stopped
+    // on an error has already failed every request.
+    slot_freed_.wait(lock, [&]() {
+      return failed_ || (free_slots_.size() == depth_ && pending_.empty());
+    });
+
+    // Wake up the reaper with a no-op it recognizes
+    if (!failed_) {
+      auto* sqe =
+          static_cast<io_uring_sqe*>(sqes_) + (*sq_tail_ & *sq_mask_);
+      std::memset(sqe, 0, sizeof(*sqe));
+      sqe->opcode = IORING_OP_NOP;
+      sqe->user_data = kShutdownUserData;
+      uint32_t tail = *sq_tail_;
+      sq_array_[tail & *sq_mask_] = tail & *sq_mask_;
+      __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+      while (IoUringEnter(ring_fd_, 1, 0, 0) < 0 && errno == EINTR) {
+      }
+    }
+    lock.unlock();
+    reaper_.join();
+  }
+
+  if (buffers_ != nullptr) {
+    munmap(buffers_, depth_ * kChunkSize);
+  }
+  if (sqes_ != nullptr) {
+    munmap(sqes_, sqes_size_);
+  }
+  if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+    munmap(cq_ring_, cq_ring_size_);
+  }
+  if (sq_ring_ != nullptr) {
+    munmap(sq_ring_, sq_ring_size_);
+  }
+  if (ring_fd_ >= 0) {
+    close(ring_fd_);
+  }
+#endif
+}
+
+katana::Result<void>
+katana::IoUringQueue::Setup(uint32_t depth) {
+#if KATANA_HAVE_IO_URING
+  io_uring_params params{};
+  ring_fd_ = IoUringSetup(depth, &params);
+  if (ring_fd_ < 0) {
+    return KATANA_ERROR(katana::ResultErrno(), "io_uring_setup");
+  }
+
+  KATANA_CHECKED(CheckOpsSupported(
+      ring_fd_, {IORING_OP_READ, IORING_OP_WRITE, IORING_OP_READ_FIXED,
+                 IORING_OP_WRITE_FIXED, IORING_OP_NOP}));
+
+  sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+  cq_ring_size_ =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap) {
+    sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    cq_ring_size_ = sq_ring_size_;
+  }
+
+  void* sq_ring = mmap(
+      nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+      MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  if (sq_ring == MAP_FAILED) {
+    return KATANA_ERROR(katana::ResultErrno(), "mapping submission ring");
+  }
+  sq_ring_ = sq_ring;
+
+  if (single_mmap) {
+    cq_ring_ = sq_ring_;
+  } else {
+    void* cq_ring = mmap(
+        nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+    if (cq_ring == MAP_FAILED) {
+      return KATANA_ERROR(katana::ResultErrno(), "mapping completion ring");
+    }
+    cq_ring_ = cq_ring;
+  }
+
+  sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqes = mmap(
+      nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+      ring_fd_, IORING_OFF_SQES);
+  if (sqes == MAP_FAILED) {
+    return KATANA_ERROR(katana::ResultErrno(), "mapping submission entries");
+  }
+  sqes_ = sqes;
+
+  auto* sq = static_cast<uint8_t*>(sq_ring_);
+  sq_head_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+  sq_tail_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+  sq_mask_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+  sq_array_ = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+  auto* cq = static_cast<uint8_t*>(cq_ring_);
+  cq_head_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+  cq_tail_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+  cq_mask_ = reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+  cqes_ = cq + params.cq_off.cqes;
+
+  // At most one submission per slot is in flight, so neither ring can
+  // overflow.
+  depth_ = params.sq_entries;
+  slots_.resize(depth_);
+  for (uint32_t i = 0; i < depth_; ++i) {
+    slots_[i].index = i;
+    free_slots_.emplace_back(&slots_[i]);
+  }
+  return katana::ResultSuccess();
+#else
+  (void)depth;
+  return KATANA_ERROR(
+      ErrorCode::NotImplemented, "built without io_uring support");
+#endif
+}
+
+katana::Result<void>
+katana::IoUringQueue::RegisterBuffers() {
+#if KATANA_HAVE_IO_URING
+  // mmap returns page aligned memory, which satisfies O_DIRECT
+  void* buffers = mmap(
+      nullptr, depth_ * kChunkSize, PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (buffers == MAP_FAILED) {
+    return KATANA_ERROR(katana::ResultErrno(), "allocating bounce buffers");
+  }
+  buffers_ = static_cast<uint8_t*>(buffers);
+
+  std::vector<iovec> iovecs(depth_);
+  for (uint32_t i = 0; i < depth_; ++i) {
+    iovecs[i].iov_base = buffers_ + i * kChunkSize;
+    iovecs[i].iov_len = kChunkSize;
+  }
+  if (IoUringRegister(
+          ring_fd_, IORING_REGISTER_BUFFERS, iovecs.data(), depth_) < 0) {
+    return KATANA_ERROR(
+        katana::ResultErrno(),
+        "registering {} io_uring buffers (RLIMIT_MEMLOCK too low?)", depth_);
+  }
+  return katana::ResultSuccess();
+#else
+  return KATANA_ERROR(
+      ErrorCode::NotImplemented, "built without io_uring support");
+#endif
+}
+
+std::future<katana::CopyableResult<void>>
+katana::IoUringQueue::Read(
+    const std::string& path, uint64_t start, uint64_t size, uint8_t* data) {
+  auto request = std::make_unique<Request>();
+  request->path = path;
+  request->data = data;
+  request->start = start;
+  request->size = size;
+  return Start(std::move(request));
+}
+
+std::future<katana::CopyableResult<void>>
+katana::IoUringQueue::Write(
+    const std::string& path, const uint8_t* data, uint64_t size) {
+  auto request = std::make_unique<Request>();
+  request->path = path;
+  request->is_write = true;
+  request->data = const_cast<uint8_t*>(data);  // NOLINT never written to
+  request->size = size;
+  return Start(std::move(request));
+}
+
+std::future<katana::CopyableResult<void>>
+katana::IoUringQueue::Start(std::unique_ptr<Request> request) {
+  std::future<katana::CopyableResult<void>> future =
+      request->promise.get_future();
+
+  int flags = request->is_write ? O_WRONLY | O_CREAT | O_TRUNC : O_RDONLY;
+  if (direct_) {
+    flags |= O_DIRECT;
+  }
+  request->fd = open(request->path.c_str(), flags | O_CLOEXEC, 0644);
+  if (request->fd < 0) {
+    request->promise.set_value(KATANA_ERROR(
+        katana::ResultErrno(), "opening {}", request->path));
+    return future;
+  }
+
+  // Direct I/O widens reads to aligned offsets and pads the last chunk of a
+  // write, which is truncated again when the request finishes.
+  request->next_offset = request->start;
+  request->end = request->start + request->size;
+  if (direct_) {
+    request->next_offset = AlignDown(request->next_offset, kDirectAlignment);
+    request->end = AlignUp(request->end, kDirectAlignment);
+  }
+
+  // The request is owned by the queue from here on and freed by Finish
+  Request* req = request.release();
+  bool finished = false;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (failed_) {
+      req->error = failed_.value();
+      finished = true;
+    } else if (req->next_offset == req->end) {
+      finished = true;
+    } else {
+      pending_.emplace_back(req);
+    }
+  }
+  if (finished) {
+    Finish(req);
+    return future;
+  }
+
+  Dispatch();
+  return future;
+}
+
+void
+katana::IoUringQueue::Dispatch() {
+  std::vector<Slot*> assigned;
+  std::vector<Request*> finished;
+  do {
+    assigned.clear();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      AssignSlots(&assigned, &finished);
+    }
+
+    // Filling bounce buffers does not need the lock; the slots belong to
+    // their requests until they are released
+    if (direct_) {
+      for (Slot* slot : assigned) {
+        const Request* req = slot->request;
+        if (!req->is_write) {
+          continue;
+        }
+        uint64_t src = slot->offset + slot->copy_begin - req->start;
+        std::memcpy(
+            slot->buf + slot->copy_begin, req->data + src,
+            slot->copy_end - slot->copy_begin);
+        std::memset(
+            slot->buf + slot->copy_end, 0, slot->len - slot->copy_end);
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (Slot* slot : assigned) {
+        Request* req = slot->request;
+        if (!req->error && failed_) {
+          req->error = failed_.value();
+        }
+        if (!req->error) {
+          auto res = Submit(slot);
+          if (res) {
+            continue;
+          }
+          req->error = res.error();
+        }
+        // Do not bother with the rest of a request that already failed
+        if (Request* done = ReleaseSlot(slot); done) {
+          finished.emplace_back(done);
+        }
+      }
+    }
+
+    for (Request* req : finished) {
+      Finish(req);
+    }
+    finished.clear();
+  } while (!assigned.empty());
+}
+
+void
+katana::IoUringQueue::AssignSlots(
+    std::vector<Slot*>* assigned, std::vector<Request*>* finished) {
+  while (!pending_.empty() && !free_slots_.empty()) {
+    Request* req = pending_.front();
+    if (req->error) {
+      pending_.pop_front();
+      req->all_assigned = true;
+      if (req->outstanding == 0) {
+        finished->emplace_back(req);
+      }
+      continue;
+    }
+
+    Slot* slot = free_slots_.back();
+    free_slots_.pop_back();
+
+    slot->request = req;
+    slot->offset = req->next_offset;
+    slot->len = std::min(kChunkSize, req->end - req->next_offset);
+    slot->done = 0;
+    uint64_t window_begin = std::max(slot->offset, req->start);
+    uint64_t window_end =
+        std::min(slot->offset + slot->len, req->start + req->size);
+    slot->copy_begin = window_begin - slot->offset;
+    slot->copy_end = window_end - slot->offset;
+    if (direct_) {
+      slot->buf = buffers_ + slot->index * kChunkSize;
+    } else {
+      slot->buf = req->data + (window_begin - req->start);
+    }
+
+    req->next_offset += slot->len;
+    req->outstanding += 1;
+    if (req->next_offset >= req->end) {
+      pending_.pop_front();
+      req->all_assigned = true;
+    }
+    assigned->emplace_back(slot);
+  }
+}
+
+katana::IoUringQueue::Request*
+katana::IoUringQueue::ReleaseSlot(Slot* slot) {
+  Request* req = slot->request;
+  slot->request = nullptr;
+  free_slots_.emplace_back(slot);
+  slot_freed_.notify_all();
+
+  req->outstanding -= 1;
+  if (req->outstanding == 0 && req->all_assigned) {
+    return req;
+  }
+  return nullptr;
+}
+
+katana::Result<void>
+katana::IoUringQueue::Submit(Slot* slot) {
+#if KATANA_HAVE_IO_URING
+  uint32_t tail = *sq_tail_;
+  uint32_t index = tail & *sq_mask_;
+  auto* sqe = static_cast<io_uring_sqe*>(sqes_) + index;
+  std::memset(sqe, 0, sizeof(*sqe));
+
+  bool is_write = slot->request->is_write;
+  if (direct_) {
+    sqe->opcode = is_write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+    sqe->buf_index = slot->index;
+  } else {
+    sqe->opcode = is_write ? IORING_OP_WRITE : IORING_OP_READ;
+  }
+  sqe->fd = slot->request->fd;
+  sqe->off = slot->offset + slot->done;
+  sqe->addr = reinterpret_cast<uint64_t>(slot->buf + slot->done);
+  sqe->len = slot->len - slot->done;
+  sqe->user_data = slot->index;
+
+  sq_array_[index] = index;
+  __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+
+  int ret = 0;
+  while ((ret = IoUringEnter(ring_fd_, 1, 0, 0)) < 0 && errno == EINTR) {
+  }
+  std::error_code err =
+      ret < 0 ? katana::ResultErrno()
+              : std::make_error_code(std::errc::device_or_resource_busy);
+
+  // The kernel only consumes submissions in io_uring_enter, and every call
+  // that submits holds mutex_. If this one did not consume the entry, take it
+  // back, or a later call would start it after the slot has been reused.
+  if (__atomic_load_n(sq_head_, __ATOMIC_ACQUIRE) == tail) {
+    __atomic_store_n(sq_tail_, tail, __ATOMIC_RELEASE);
+    return KATANA_ERROR(err, "io_uring_enter");
+  }
+  // Otherwise it is in flight and completes like any other, even if the
+  // call reported an error
+  slot->in_flight = true;
+  return katana::ResultSuccess();
+#else
+  (void)slot;
+  return KATANA_ERROR(
+      ErrorCode::NotImplemented, "built without io_uring support");
+#endif
+}
+
+bool
+katana::IoUringQueue::Complete(Slot* slot, int32_t res) {
+  Request* req = slot->request;
+  slot->in_flight = false;
+
+  if (res == -EINTR || res == -EAGAIN) {
+    if (Submit(slot)) {
+      return false;
+    }
+    res = -EIO;
+  }
+
+  if (res < 0) {
+    if (!req->error) {
+      req->error = KATANA_ERROR(
+          std::error_code(-res, std::system_category()), "{} {} at {}",
+          req->is_write ? "writing" : "reading", req->path,
+          slot->offset + slot->done);
+    }
+  } else if (res == 0 && req->is_write) {
+    if (!req->error) {
+      req->error = KATANA_ERROR(
+          ErrorCode::LocalStorageError, "writing {} made no progress",
+          req->path);
+    }
+  } else {
+    slot->done += res;
+    // A short direct read only happens at the end of the file
+    bool at_eof = res == 0 || (direct_ && !req->is_write);
+    if (slot->done < slot->len && !at_eof) {
+      auto submit_res = Submit(slot);
+      if (submit_res) {
+        return false;
+      }
+      if (!req->error) {
+        req->error = submit_res.error();
+      }
+    }
+  }
+  return true;
+}
+
+void
+katana::IoUringQueue::CopyOut(Slot* slot) {
+  Request* req = slot->request;
+  if (req->is_write) {
+    return;
+  }
+  uint64_t window = slot->copy_end - slot->copy_begin;
+  uint64_t valid_end = std::min(slot->done, slot->copy_end);
+  uint64_t valid =
+      valid_end > slot->copy_begin ? valid_end - slot->copy_begin : 0;
+  req->missing += window - valid;
+  if (direct_ && valid > 0) {
+    uint64_t dest = slot->offset + slot->copy_begin - req->start;
+    std::memcpy(req->data + dest, slot->buf + slot->copy_begin, valid);
+  }
+}
+
+void
+katana::IoUringQueue::Finish(Request* request) {
+  std::unique_ptr<Request> req(request);
+
+  if (!req->error && req->is_write && direct_ &&
+      ftruncate(req->fd, req->size) != 0) {
+    req->error = KATANA_ERROR(
+        katana::ResultErrno(), "truncating {}", req->path);
+  }
+  if (close(req->fd) != 0 && !req->error) {
+    req->error = KATANA_ERROR(
+        katana::ResultErrno(), "closing {}", req->path);
+  }
+  // Like the synchronous read, tolerate a partial block at the end of the
+  // file
+  if (!req->error && req->missing > kBlockSize) {
+    req->error = KATANA_ERROR(
+        ErrorCode::LocalStorageError, "reading {}: {} bytes past end of file",
+        req->path, req->missing);
+  }
+
+  if (req->error) {
+    req->promise.set_value(req->error.value());
+  } else {
+    req->promise.set_value(katana::CopyableResultSuccess());
+  }
+}
+
+void
+katana::IoUringQueue::Fail(const katana::CopyableErrorInfo& error) {
+  std::vector<Request*> finished;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    failed_ = error;
+    for (Request* req : pending_) {
+      if (!req->error) {
+        req->error = error;
+      }
+      req->all_assigned = true;
+      if (req->outstanding == 0) {
+        finished.emplace_back(req);
+      }
+    }
+    pending_.clear();
+    // In-flight slots are never reused because no request is accepted any
+    // more; slots assigned but not yet submitted are released by Dispatch
+    for (Slot& slot : slots_) {
+      if (!slot.in_flight) {
+        continue;
+      }
+      Request* req = slot.request;
+      slot.in_flight = false;
+      slot.request = nullptr;
+      if (!req->error) {
+        req->error = error;
+      }
+      req->outstanding -= 1;
+      if (req->outstanding == 0 && req->all_assigned) {
+        finished.emplace_back(req);
+      }
+    }
+    slot_freed_.notify_all();
+  }
+
+  for (Request* req : finished) {
+    Finish(req);
+  }
+}
+
+void
+katana::IoUringQueue::ReapLoop() {
+#if KATANA_HAVE_IO_URING
+  auto* cqes = static_cast<io_uring_cqe*>(cqes_);
+  bool shutdown = false;
+  std::vector<Slot*> done;
+  std::vector<Request*> finished;
+  while (!shutdown) {
+    if (IoUringEnter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS) < 0 &&
+        errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+      // Anything else will not go away by trying again
+      auto err = KATANA_ERROR(
+          katana::ResultErrno(), "waiting for io_uring completions");
+      KATANA_LOG_ERROR("stopping io_uring queue: {}", err);
+      Fail(err);
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      uint32_t head = *cq_head_;
+      uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+      for (; head != tail; ++head) {
+        const io_uring_cqe& cqe = cqes[head & *cq_mask_];
+        if (cqe.user_data == kShutdownUserData) {
+          shutdown = true;
+          continue;
+        }
+        if (Slot* slot = &slots_[cqe.user_data]; Complete(slot, cqe.res)) {
+          done.emplace_back(slot);
+        }
+      }
+      __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+    }
+    if (done.empty()) {
+      continue;
+    }
+
+    // Copying out of bounce buffers does not need the lock; the slots belong
+    // to their requests until they are released
+    for (Slot* slot : done) {
+      CopyOut(slot);
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (Slot* slot : done) {
+        if (Request* req = ReleaseSlot(slot); req) {
+          finished.emplace_back(req);
+        }
+      }
+    }
+    done.clear();
+
+    // Closing files and waking up waiters does not need the lock either
+    for (Request* req : finished) {
+      Finish(req);
+    }
+    finished.clear();
+
+    // Give the freed slots to queued chunks
+    Dispatch();
+  }
+#endif
+}
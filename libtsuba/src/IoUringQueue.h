@@ -0,0 +1,135 @@
+#ifndef KATANA_LIBTSUBA_IOURINGQUEUE_H_
+#define KATANA_LIBTSUBA_IOURINGQUEUE_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "katana/Result.h"
+
+namespace katana {
+
+/// IoUringQueue reads and writes local files asynchronously through a Linux
+/// io_uring. Requests are split into chunks of at most kChunkSize bytes and
+/// at most depth() chunks are in flight at a time; chunks beyond that wait in
+/// the queue without blocking the caller. A dedicated thread reaps
+/// completions, submits waiting chunks and fulfills the futures returned to
+/// callers, so reads and writes issued by a ReadGroup or WriteGroup overlap
+/// with each other and with computation. If waiting for completions fails,
+/// outstanding and later requests fail with that error.
+///
+/// In direct mode files are opened with O_DIRECT to bypass the page cache.
+/// Chunks then go through aligned bounce buffers that are registered with
+/// the ring once, rather than mapped by the kernel on every request.
+class IoUringQueue {
+public:
+  static constexpr uint64_t kChunkSize = 1UL << 20;
+  /// Alignment of file offsets, sizes and buffers for O_DIRECT
+  static constexpr uint64_t kDirectAlignment = 4096;
+
+  /// Returns an error if io_uring, or one of the operations used, is not
+  /// supported by the kernel; callers should fall back to synchronous I/O.
+  static katana::Result<std::unique_ptr<IoUringQueue>> Make(
+      uint32_t depth, bool direct);
+
+  IoUringQueue(const IoUringQueue& no_copy) = delete;
+  IoUringQueue(IoUringQueue&& no_move) = delete;
+  IoUringQueue& operator=(const IoUringQueue& no_copy) = delete;
+  IoUringQueue& operator=(IoUringQueue&& no_move) = delete;
+
+  /// Waits for outstanding requests
+  ~IoUringQueue();
+
+  /// Read [start, start + size) of the file at \p path into \p data, which
+  /// must stay valid until the future is ready. Like the synchronous read,
+  /// reading less than a block past the end of the file is not an error.
+  std::future<katana::CopyableResult<void>> Read(
+      const std::string& path, uint64_t start, uint64_t size, uint8_t* data);
+
+  /// Replace the contents of the file at \p path with \p data, which must
+  /// stay valid until the future is ready
+  std::future<katana::CopyableResult<void>> Write(
+      const std::string& path, const uint8_t* data, uint64_t size);
+
+  uint32_t depth() const { return depth_; }
+  bool direct() const { return direct_; }
+
+private:
+  struct Request;
+  struct Slot;
+
+  IoUringQueue(bool direct);
+
+  katana::Result<void> Setup(uint32_t depth);
+  katana::Result<void> RegisterBuffers();
+
+  std::future<katana::CopyableResult<void>> Start(
+      std::unique_ptr<Request> request);
+  /// Give free slots to queued chunks and submit them
+  void Dispatch();
+  /// Give free slots to queued chunks; requests that failed while queued are
+  /// added to \p finished. Requires mutex_.
+  void AssignSlots(
+      std::vector<Slot*>* assigned, std::vector<Request*>* finished);
+  /// Return \p slot to the free list; returns the request of the slot if
+  /// that finished it. Requires mutex_.
+  Request* ReleaseSlot(Slot* slot);
+  /// Push the next part of the chunk in \p slot to the ring; requires mutex_
+  katana::Result<void> Submit(Slot* slot);
+  /// Account for a completion of \p slot; returns true if the chunk is done
+  /// rather than resubmitted. Requires mutex_.
+  bool Complete(Slot* slot, int32_t res);
+  /// Copy the done read chunk in \p slot to the caller's buffer
+  void CopyOut(Slot* slot);
+  void Finish(Request* request);
+  /// Fail queued and in-flight requests and refuse new ones
+  void Fail(const katana::CopyableErrorInfo& error);
+
+  void ReapLoop();
+
+  bool direct_;
+  uint32_t depth_{0};
+
+  int ring_fd_{-1};
+  void* sq_ring_{nullptr};
+  size_t sq_ring_size_{0};
+  void* cq_ring_{nullptr};
+  size_t cq_ring_size_{0};
+  void* sqes_{nullptr};
+  size_t sqes_size_{0};
+
+  /// views of the rings shared with the kernel
+  uint32_t* sq_head_{nullptr};
+  uint32_t* sq_tail_{nullptr};
+  uint32_t* sq_mask_{nullptr};
+  uint32_t* sq_array_{nullptr};
+  uint32_t* cq_head_{nullptr};
+  uint32_t* cq_tail_{nullptr};
+  uint32_t* cq_mask_{nullptr};
+  void* cqes_{nullptr};
+
+  /// bounce buffers of the slots in direct mode, kChunkSize bytes each
+  uint8_t* buffers_{nullptr};
+
+  std::mutex mutex_;
+  std::condition_variable slot_freed_;
+  std::vector<Slot> slots_;
+  std::vector<Slot*> free_slots_;
+  /// requests with chunks waiting for a slot
+  std::deque<Request*> pending_;
+  /// set once the reaper has stopped
+  std::optional<katana::CopyableErrorInfo> failed_;
+
+  std::thread reaper_;
+};
+
+}  // namespace katana
+
+#endif
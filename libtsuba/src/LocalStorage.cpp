@@ -15,6 +15,7 @@
 #include <boost/system/error_code.hpp>
 
 #include "GlobalState.h"
+#include "katana/Env.h"
 #include "katana/ErrorCode.h"
 #include "katana/Logging.h"
 #include "katana/Result.h"
@@ -47,8 +48,90 @@ GetPath(const std::string& uri) {
   return u.path();
 }
 
+std::future<katana::CopyableResult<void>>
+ReadyFuture(const katana::Result<void>& res) {
+  if (!res) {
+    katana::CopyableErrorInfo cei{res.error()};
+    return std::async(
+        std::launch::deferred,
+        [=]() -> katana::CopyableResult<void> { return cei; });
+  }
+  return std::async(
+      std::launch::deferred, []() -> katana::CopyableResult<void> {
+        return katana::CopyableResultSuccess();
+      });
+}
+
 }  // namespace
 
+katana::Result<void>
+katana::LocalStorage::Init() {
+  bool use_io_uring = false;
+  katana::GetEnv("KATANA_LOCAL_STORAGE_IO_URING", &use_io_uring);
+  if (!use_io_uring) {
+    return katana::ResultSuccess();
+  }
+
+  int depth = 64;
+  katana::GetEnv("KATANA_LOCAL_STORAGE_IO_URING_DEPTH", &depth);
+  bool direct = false;
+  katana::GetEnv("KATANA_LOCAL_STORAGE_O_DIRECT", &direct);
+  if (depth <= 0) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "io_uring depth must be positive: {}",
+        depth);
+  }
+
+  auto queue_res = IoUringQueue::Make(depth, direct);
+  if (!queue_res) {
+    // Old kernels and some container runtimes do not allow io_uring
+    KATANA_LOG_DEBUG(
+        "not using io_uring for local storage: {}", queue_res.error());
+    return katana::ResultSuccess();
+  }
+  io_uring_ = std::move(queue_res.value());
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::LocalStorage::Fini() {
+  // Waits for outstanding requests
+  io_uring_.reset();
+  return katana::ResultSuccess();
+}
+
+std::future<katana::CopyableResult<void>>
+katana::LocalStorage::PutAsync(
+    const std::string& uri, const uint8_t* data, uint64_t size) {
+  if (!io_uring_) {
+    return ReadyFuture(WriteFile(uri, data, size));
+  }
+
+  auto path_res = GetPath(uri);
+  if (!path_res) {
+    return ReadyFuture(path_res.error());
+  }
+  if (auto res = EnsureDirectories(path_res.value()); !res) {
+    return ReadyFuture(res.error());
+  }
+  return io_uring_->Write(path_res.value(), data, size);
+}
+
+std::future<katana::CopyableResult<void>>
+katana::LocalStorage::GetAsync(
+    const std::string& uri, uint64_t start, uint64_t size,
+    uint8_t* result_buf) {
+  if (!io_uring_) {
+    return ReadyFuture(ReadFile(uri, start, size, result_buf));
+  }
+
+  auto path_res = GetPath(uri);
+  if (!path_res) {
+    return ReadyFuture(path_res.error());
+  }
+  return io_uring_->Read(path_res.value(), start, size, result_buf);
+}
+
 katana::Result<void>
 katana::LocalStorage::WriteFile(
     const std::string& uri, const uint8_t* data, uint64_t size) {
@@ -5,16 +5,30 @@
 
 #include <cstdint>
 #include <future>
+#include <memory>
 #include <string>
 #include <thread>
 
+#include "IoUringQueue.h"
 #include "katana/FileStorage.h"
 #include "katana/Result.h"
 
 namespace katana {
 
-/// Store byte arrays to the local file system; Provided as a convenience for
-/// testing only (un-optimized)
+/// Store byte arrays to the local file system.
+///
+/// Asynchronous gets and puts can go through an io_uring, so that the reads
+/// and writes of a ReadGroup or WriteGroup overlap. This is opt-in and needs
+/// a kernel that supports it and a build with KATANA_USE_IO_URING on (the
+/// default). The ring is configured with environment variables:
+///
+///   KATANA_LOCAL_STORAGE_IO_URING: use io_uring (default false)
+///   KATANA_LOCAL_STORAGE_IO_URING_DEPTH: maximum number of 1MB chunks in
+///     flight (default 64)
+///   KATANA_LOCAL_STORAGE_O_DIRECT: bypass the page cache (default false)
+///
+/// Otherwise, and for the synchronous calls, files are read and written
+/// synchronously.
 class LocalStorage : public FileStorage {
   katana::Result<void> WriteFile(
       const std::string&, const uint8_t* data, uint64_t size);
@@ -24,11 +38,13 @@ class LocalStorage : public FileStorage {
       const std::string& source_uri, const std::string& dest_uri,
       uint64_t begin, uint64_t size);
 
+  std::unique_ptr<IoUringQueue> io_uring_;
+
 public:
   LocalStorage() : FileStorage("file://") {}
 
-  katana::Result<void> Init() override { return katana::ResultSuccess(); }
-  katana::Result<void> Fini() override { return katana::ResultSuccess(); }
+  katana::Result<void> Init() override;
+  katana::Result<void> Fini() override;
   katana::Result<void> Stat(const std::string& uri, StatBuf* s_buf) override;
 
   uint32_t Priority() const override { return 1; }
@@ -52,34 +68,10 @@ public:
 
   // get on future can potentially block (bulk synchronous parallel)
   std::future<katana::CopyableResult<void>> PutAsync(
-      const std::string& uri, const uint8_t* data, uint64_t size) override {
-    // No need for AsyncPut to local storage right now
-    if (auto write_res = WriteFile(uri, data, size); !write_res) {
-      katana::CopyableErrorInfo cei{write_res.error()};
-      return std::async(
-          std::launch::deferred,
-          [=]() -> katana::CopyableResult<void> { return cei; });
-    }
-    return std::async(
-        std::launch::deferred, []() -> katana::CopyableResult<void> {
-          return katana::CopyableResultSuccess();
-        });
-  }
+      const std::string& uri, const uint8_t* data, uint64_t size) override;
   std::future<katana::CopyableResult<void>> GetAsync(
       const std::string& uri, uint64_t start, uint64_t size,
-      uint8_t* result_buf) override {
-    // I suppose there is no need for AsyncGet to local storage either
-    if (auto read_res = ReadFile(uri, start, size, result_buf); !read_res) {
-      katana::CopyableErrorInfo cei{read_res.error()};
-      return std::async(
-          std::launch::deferred,
-          [=]() -> katana::CopyableResult<void> { return cei; });
-    }
-    return std::async(
-        std::launch::deferred, []() -> katana::CopyableResult<void> {
-          return katana::CopyableResultSuccess();
-        });
-  }
+      uint8_t* result_buf) override;
   std::future<katana::CopyableResult<void>> ListAsync(
       const std::string& uri, std::vector<std::string>* list,
       std::vector<uint64_t>* size) override;
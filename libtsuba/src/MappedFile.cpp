@@ -0,0 +1,60 @@
+#include "katana/MappedFile.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "katana/ErrorCode.h"
+#include "katana/Logging.h"
+
+katana::MappedFile::~MappedFile() {
+  if (data_ != nullptr) {
+    if (int err = munmap(data_, size_); err) {
+      KATANA_LOG_WARN(
+          "unmapping {}: {}", uri_, katana::ResultErrno().message());
+    }
+  }
+}
+
+bool
+katana::MappedFile::IsMappable(const katana::URI& uri) {
+  return uri.scheme() == katana::URI::kFileScheme;
+}
+
+katana::Result<std::shared_ptr<katana::MappedFile>>
+katana::MappedFile::Make(const katana::URI& uri) {
+  if (!IsMappable(uri)) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "{} is not on local storage", uri);
+  }
+
+  int fd = open(uri.path().c_str(), O_RDONLY);
+  if (fd < 0) {
+    return KATANA_ERROR(katana::ResultErrno(), "opening {}", uri);
+  }
+
+  struct stat stat_buf;
+  if (fstat(fd, &stat_buf) != 0) {
+    auto err = katana::ResultErrno();
+    close(fd);
+    return KATANA_ERROR(err, "getting the size of {}", uri);
+  }
+  size_t size = stat_buf.st_size;
+
+  // mmap rejects empty mappings, and an empty file has nothing to map anyway
+  void* data = nullptr;
+  if (size > 0) {
+    data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      auto err = katana::ResultErrno();
+      close(fd);
+      return KATANA_ERROR(err, "mapping {} bytes of {}", size, uri);
+    }
+  }
+  // the mapping does not need the descriptor
+  close(fd);
+
+  return std::shared_ptr<MappedFile>(
+      new MappedFile(uri, static_cast<uint8_t*>(data), size));
+}
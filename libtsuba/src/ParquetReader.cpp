@@ -1,7 +1,11 @@
 #include "katana/ParquetReader.h"
 
+#include <algorithm>
+#include <future>
+#include <iomanip>
 #include <limits>
 #include <memory>
+#include <thread>
 #include <unordered_map>
 
 #include <arrow/array/util.h>
@@ -9,11 +13,17 @@
 #include <arrow/compute/cast.h>
 #include <arrow/type.h>
 #include <arrow/type_fwd.h>
+#include <parquet/arrow/reader.h>
 #include <parquet/arrow/schema.h>
+#include <parquet/exception.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+#include <parquet/statistics.h>
 
 #include "katana/ErrorCode.h"
 #include "katana/FileView.h"
 #include "katana/JSON.h"
+#include "katana/ZoneMap.h"
 
 template <typename T>
 using Result = katana::Result<T>;
@@ -22,6 +32,8 @@ using ErrorCode = katana::ErrorCode;
 
 namespace {
 
+using Bound = katana::ParquetReader::Bound;
+
 katana::Result<std::shared_ptr<arrow::ChunkedArray>>
 HandleBadParquetTypes(std::shared_ptr<arrow::ChunkedArray> old_array) {
   switch (old_array->type()->id()) {
@@ -109,6 +121,95 @@ ReadTableSlice(
   return out->Slice(row_offset, last_row - first_row);
 }
 
+/// Appends the indexes of the parquet (leaf) columns that store \p field
+void
+LeafColumns(
+    const parquet::arrow::SchemaField& field, std::vector<int>* leaves) {
+  if (field.is_leaf()) {
+    leaves->emplace_back(field.column_index);
+    return;
+  }
+  for (const auto& child : field.children) {
+    LeafColumns(child, leaves);
+  }
+}
+
+/// The minimum and maximum value of a column chunk, if its statistics have
+/// them in a form that can be compared with a Bound
+std::optional<std::pair<Bound, Bound>>
+StatisticsBounds(const parquet::ColumnChunkMetaData& chunk) {
+  std::shared_ptr<parquet::Statistics> stats = chunk.statistics();
+  if (!stats || !stats->HasMinMax()) {
+    return std::nullopt;
+  }
+  const std::shared_ptr<const parquet::LogicalType>& logical_type =
+      stats->descr()->logical_type();
+  if (logical_type && logical_type->is_int() &&
+      !static_cast<const parquet::IntLogicalType&>(*logical_type)
+           .is_signed()) {
+    // Unsigned values are not ordered like their signed physical values
+    return std::nullopt;
+  }
+
+  switch (stats->physical_type()) {
+  case parquet::Type::INT32: {
+    auto typed = std::static_pointer_cast<parquet::Int32Statistics>(stats);
+    return std::make_pair(
+        Bound{int64_t{typed->min()}}, Bound{int64_t{typed->max()}});
+  }
+  case parquet::Type::INT64: {
+    auto typed = std::static_pointer_cast<parquet::Int64Statistics>(stats);
+    return std::make_pair(
+        Bound{int64_t{typed->min()}}, Bound{int64_t{typed->max()}});
+  }
+  case parquet::Type::FLOAT: {
+    auto typed = std::static_pointer_cast<parquet::FloatStatistics>(stats);
+    return std::make_pair(
+        Bound{double{typed->min()}}, Bound{double{typed->max()}});
+  }
+  case parquet::Type::DOUBLE: {
+    auto typed = std::static_pointer_cast<parquet::DoubleStatistics>(stats);
+    return std::make_pair(Bound{typed->min()}, Bound{typed->max()});
+  }
+  case parquet::Type::BYTE_ARRAY: {
+    auto typed = std::static_pointer_cast<parquet::ByteArrayStatistics>(stats);
+    auto to_string = [](const parquet::ByteArray& value) {
+      return std::string(reinterpret_cast<const char*>(value.ptr), value.len);
+    };
+    return std::make_pair(
+        Bound{to_string(typed->min())}, Bound{to_string(typed->max())});
+  }
+  default:
+    return std::nullopt;
+  }
+}
+
+/// Returns false if the statistics of \p row_group show that it has no
+/// rows that pass all of the \p filters; filter_leaves are the indexes of
+/// the columns of the filters.
+katana::Result<bool>
+MayMatch(
+    const parquet::RowGroupMetaData& row_group,
+    const std::vector<katana::ParquetReader::RowGroupFilter>& filters,
+    const std::vector<int>& filter_leaves) {
+  for (size_t i = 0; i < filters.size(); ++i) {
+    auto bounds = StatisticsBounds(*row_group.ColumnChunk(filter_leaves[i]));
+    if (!bounds) {
+      continue;
+    }
+    const auto& [min, max] = bounds.value();
+    if (KATANA_CHECKED_CONTEXT(
+            katana::BoundLess(max, filters[i].min), "filter on {}",
+            std::quoted(filters[i].column)) ||
+        KATANA_CHECKED_CONTEXT(
+            katana::BoundLess(filters[i].max, min), "filter on {}",
+            std::quoted(filters[i].column))) {
+      return false;
+    }
+  }
+  return true;
+}
+
 class BlockedParquetReader {
 public:
   /// Read a potentially blocked Parquet file at the provide uri
@@ -317,6 +418,141 @@ public:
     return concatenated_table;
   }
 
+  Result<std::shared_ptr<arrow::Table>> ScanTable(
+      const katana::ParquetReader::ScanOpts& opts,
+      katana::ParquetReader::ScanStats* stats) {
+    KATANA_CHECKED(EnsureReader(0));
+    std::shared_ptr<arrow::Schema> schema;
+    KATANA_CHECKED(readers_[0]->GetSchema(&schema));
+    const parquet::arrow::SchemaManifest& manifest = readers_[0]->manifest();
+
+    std::vector<std::string> names = opts.columns;
+    if (names.empty()) {
+      names = schema->field_names();
+    }
+    std::vector<int> leaves;
+    for (const auto& name : names) {
+      int idx = schema->GetFieldIndex(name);
+      if (idx < 0) {
+        return KATANA_ERROR(
+            ErrorCode::NotFound, "no unique column named {}",
+            std::quoted(name));
+      }
+      LeafColumns(manifest.schema_fields[idx], &leaves);
+    }
+    std::sort(leaves.begin(), leaves.end());
+    leaves.erase(std::unique(leaves.begin(), leaves.end()), leaves.end());
+
+    std::vector<int> filter_leaves;
+    for (const auto& filter : opts.filters) {
+      int idx = schema->GetFieldIndex(filter.column);
+      if (idx < 0) {
+        return KATANA_ERROR(
+            ErrorCode::NotFound, "no unique column named {}",
+            std::quoted(filter.column));
+      }
+      const parquet::arrow::SchemaField& field = manifest.schema_fields[idx];
+      if (!field.is_leaf()) {
+        return KATANA_ERROR(
+            ErrorCode::InvalidArgument, "cannot filter on nested column {}",
+            std::quoted(filter.column));
+      }
+      filter_leaves.emplace_back(field.column_index);
+    }
+
+    // Only the metadata is read through these views; reading past it would
+    // fetch column chunks that the workers fetch again
+    katana::FileView::ReadaheadPolicy no_readahead;
+    no_readahead.mode = katana::FileView::Readahead::kNone;
+    std::vector<RowGroupRef> row_groups;
+    for (size_t i = 0, num_files = readers_.size(); i < num_files; ++i) {
+      KATANA_CHECKED(EnsureReader(i));
+      fvs_[i]->set_readahead_policy(no_readahead);
+      std::shared_ptr<parquet::FileMetaData> metadata =
+          readers_[i]->parquet_reader()->metadata();
+      for (int rg = 0; rg < metadata->num_row_groups(); ++rg) {
+        if (KATANA_CHECKED(MayMatch(
+                *metadata->RowGroup(rg), opts.filters, filter_leaves))) {
+          row_groups.emplace_back(RowGroupRef{i, rg});
+        }
+      }
+    }
+
+    std::vector<std::shared_ptr<arrow::Field>> fields;
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> columns;
+    if (row_groups.empty()) {
+      for (const auto& name : names) {
+        std::shared_ptr<arrow::Field> field = schema->GetFieldByName(name);
+        fields.emplace_back(field);
+        columns.emplace_back(std::make_shared<arrow::ChunkedArray>(
+            KATANA_CHECKED(arrow::MakeArrayOfNull(field->type(), 0))));
+      }
+      return arrow::Table::Make(arrow::schema(fields), columns);
+    }
+
+    size_t num_threads = opts.num_threads;
+    if (num_threads == 0) {
+      num_threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    size_t num_workers = std::min(num_threads, row_groups.size());
+
+    // Split the row groups into contiguous ranges, so that concatenating the
+    // tables of the workers preserves the order of rows
+    using TableResult = katana::CopyableResult<std::shared_ptr<arrow::Table>>;
+    std::vector<std::future<TableResult>> futures;
+    std::vector<uint64_t> worker_bytes_fetched(num_workers);
+    for (size_t w = 0; w < num_workers; ++w) {
+      const RowGroupRef* begin =
+          row_groups.data() + row_groups.size() * w / num_workers;
+      const RowGroupRef* end =
+          row_groups.data() + row_groups.size() * (w + 1) / num_workers;
+      futures.emplace_back(std::async(
+          std::launch::async,
+          [this, begin, end, &leaves,
+           bytes_fetched = &worker_bytes_fetched[w]]() -> TableResult {
+            return KATANA_CHECKED(
+                ReadRowGroups(begin, end, leaves, bytes_fetched));
+          }));
+    }
+
+    // Wait for all workers before returning, they refer to our locals
+    std::vector<std::shared_ptr<arrow::Table>> tables;
+    std::optional<katana::CopyableErrorInfo> error;
+    for (auto& future : futures) {
+      auto res = future.get();
+      if (!res) {
+        if (!error) {
+          error = res.error();
+        }
+        continue;
+      }
+      tables.emplace_back(std::move(res.value()));
+    }
+    if (error) {
+      return error.value();
+    }
+    if (stats) {
+      stats->bytes_fetched = 0;
+      for (const auto& fv : fvs_) {
+        if (fv) {
+          stats->bytes_fetched += fv->stats().bytes_fetched;
+        }
+      }
+      for (uint64_t bytes : worker_bytes_fetched) {
+        stats->bytes_fetched += bytes;
+      }
+    }
+    std::shared_ptr<arrow::Table> table =
+        KATANA_CHECKED(arrow::ConcatenateTables(tables));
+
+    // Arrow orders columns as they are in the file
+    for (const auto& name : names) {
+      fields.emplace_back(table->schema()->GetFieldByName(name));
+      columns.emplace_back(table->GetColumnByName(name));
+    }
+    return arrow::Table::Make(arrow::schema(fields), columns);
+  }
+
   Result<std::vector<std::string>> GetFiles() {
     std::vector<std::string> sub_files;
     sub_files.reserve(fvs_.size());
@@ -331,6 +567,73 @@ public:
   }
 
 private:
+  struct RowGroupRef {
+    size_t file;
+    int row_group;
+  };
+
+  /// Read the \p leaves columns of row groups [begin, end). Files are
+  /// opened again, with the metadata read before, so that each thread has
+  /// its own FileView and only fetches the column chunks it decodes. The
+  /// bytes fetched from storage are added to \p bytes_fetched.
+  Result<std::shared_ptr<arrow::Table>> ReadRowGroups(
+      const RowGroupRef* begin, const RowGroupRef* end,
+      const std::vector<int>& leaves, uint64_t* bytes_fetched) const {
+    std::vector<std::shared_ptr<arrow::Table>> tables;
+    while (begin != end) {
+      size_t file = begin->file;
+      std::vector<int> file_row_groups;
+      for (; begin != end && begin->file == file; ++begin) {
+        file_row_groups.emplace_back(begin->row_group);
+      }
+
+      std::shared_ptr<parquet::FileMetaData> metadata =
+          readers_[file]->parquet_reader()->metadata();
+      auto fv = std::make_shared<katana::FileView>();
+      // The column chunks are prefetched below; reading ahead of them would
+      // fetch the chunks of columns or row groups that are not decoded here
+      katana::FileView::ReadaheadPolicy no_readahead;
+      no_readahead.mode = katana::FileView::Readahead::kNone;
+      fv->set_readahead_policy(no_readahead);
+      KATANA_CHECKED(fv->Bind(fvs_[file]->filename(), 0, 0, false));
+
+      // Start fetching every column chunk before decoding the first one
+      for (int rg : file_row_groups) {
+        std::unique_ptr<parquet::RowGroupMetaData> rg_md =
+            metadata->RowGroup(rg);
+        for (int leaf : leaves) {
+          std::unique_ptr<parquet::ColumnChunkMetaData> chunk =
+              rg_md->ColumnChunk(leaf);
+          int64_t start = chunk->data_page_offset();
+          if (chunk->has_dictionary_page()) {
+            start = std::min(start, chunk->dictionary_page_offset());
+          }
+          KATANA_CHECKED(
+              fv->Prefetch(start, start + chunk->total_compressed_size()));
+        }
+      }
+
+      std::unique_ptr<parquet::arrow::FileReader> reader;
+      try {
+        KATANA_CHECKED(parquet::arrow::FileReader::Make(
+            arrow::default_memory_pool(),
+            parquet::ParquetFileReader::Open(
+                fv, parquet::default_reader_properties(), metadata),
+            &reader));
+      } catch (const parquet::ParquetException& exp) {
+        return KATANA_ERROR(
+            ErrorCode::ArrowError, "opening {}: {}", fv->filename(),
+            exp.what());
+      }
+
+      std::shared_ptr<arrow::Table> table;
+      KATANA_CHECKED(reader->ReadRowGroups(file_row_groups, leaves, &table));
+      tables.emplace_back(std::move(table));
+      *bytes_fetched += fv->stats().bytes_fetched;
+    }
+    return KATANA_CHECKED(arrow::ConcatenateTables(tables));
+  }
+
   BlockedParquetReader(
       std::string prefix, std::vector<std::shared_ptr<katana::FileView>>&& fvs,
       std::vector<std::unique_ptr<parquet::arrow::FileReader>>&& readers,
@@ -381,6 +684,13 @@ katana::ParquetReader::ReadTable(
   return FixTable(KATANA_CHECKED(bpr->ReadTable(slice)));
 }
 
+Result<std::shared_ptr<arrow::Table>>
+katana::ParquetReader::ScanTable(
+    const katana::URI& uri, const ScanOpts& opts, ScanStats* stats) {
+  auto bpr = KATANA_CHECKED(BlockedParquetReader::Make(uri, false));
+  return FixTable(KATANA_CHECKED(bpr->ScanTable(opts, stats)));
+}
+
 katana::Result<std::shared_ptr<arrow::Schema>>
 katana::ParquetReader::GetSchema(const katana::URI& uri) {
   auto bpr = KATANA_CHECKED(BlockedParquetReader::Make(uri, false));
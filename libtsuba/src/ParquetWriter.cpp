@@ -1,9 +1,15 @@
 #include "katana/ParquetWriter.h"
 
+#include <unordered_set>
+
+#include <arrow/util/compression.h>
+
 #include "katana/ArrowInterchange.h"
+#include "katana/Env.h"
 #include "katana/ErrorCode.h"
 #include "katana/FaultTest.h"
 #include "katana/JSON.h"
+#include "katana/Logging.h"
 #include "katana/Result.h"
 
 template <typename T>
@@ -34,6 +40,55 @@ EstimateRowSize(const std::shared_ptr<arrow::Table>& table) {
 
 constexpr uint64_t kMB = 1UL << 20;
 
+// kAuto dictionary encodes string columns with at most this fraction of
+// distinct values among their first kDictionarySampleRows values
+constexpr int64_t kDictionarySampleRows = 1 << 16;
+constexpr double kDictionaryMaxDistinctFraction = 0.25;
+
+template <typename ArrayType>
+bool
+IsLowCardinality(const arrow::ChunkedArray& column) {
+  std::unordered_set<arrow::util::string_view> distinct;
+  int64_t sampled = 0;
+  for (const auto& chunk : column.chunks()) {
+    const auto& typed = static_cast<const ArrayType&>(*chunk);
+    for (int64_t i = 0; i < typed.length() && sampled < kDictionarySampleRows;
+         ++i) {
+      if (typed.IsValid(i)) {
+        distinct.emplace(typed.GetView(i));
+        ++sampled;
+      }
+    }
+  }
+  return static_cast<double>(distinct.size()) <=
+         kDictionaryMaxDistinctFraction * static_cast<double>(sampled);
+}
+
+/// Returns true if \p column is a string column whose dictionary would likely
+/// outgrow the dictionary page limit
+bool
+IsHighCardinalityString(const arrow::ChunkedArray& column) {
+  switch (column.type()->id()) {
+  case arrow::Type::STRING:
+    return !IsLowCardinality<arrow::StringArray>(column);
+  case arrow::Type::LARGE_STRING:
+    return !IsLowCardinality<arrow::LargeStringArray>(column);
+  default:
+    return false;
+  }
+}
+
+arrow::Compression::type
+AvailableCompression(arrow::Compression::type compression) {
+  if (arrow::util::Codec::IsAvailable(compression)) {
+    return compression;
+  }
+  KATANA_WARN_ONCE(
+      "compression codec {} is not available, writing uncompressed files",
+      arrow::util::Codec::GetCodecAsString(compression));
+  return arrow::Compression::UNCOMPRESSED;
+}
+
 std::vector<std::shared_ptr<arrow::Table>>
 BlockTable(std::shared_ptr<arrow::Table> table, uint64_t mbs_per_block) {
   if (table->num_rows() <= 1) {
@@ -63,7 +118,7 @@ DoStoreParquet(
     const std::string& path, std::shared_ptr<arrow::Table> table,
     const std::shared_ptr<parquet::WriterProperties>& writer_props,
     const std::shared_ptr<parquet::ArrowWriterProperties>& arrow_props,
-    katana::WriteGroup* desc) {
+    int64_t max_row_group_rows, katana::WriteGroup* desc) {
   auto ff = std::make_shared<katana::FileFrame>();
   KATANA_CHECKED(ff->Init());
   ff->Bind(path);
@@ -71,10 +126,11 @@ DoStoreParquet(
   auto future = std::async(
       std::launch::async,
       [table = std::move(table), ff = std::move(ff), desc, writer_props,
-       arrow_props]() mutable -> katana::CopyableResult<void> {
+       arrow_props,
+       max_row_group_rows]() mutable -> katana::CopyableResult<void> {
         auto write_result = parquet::arrow::WriteTable(
-            *table, arrow::default_memory_pool(), ff,
-            std::numeric_limits<int64_t>::max(), writer_props, arrow_props);
+            *table, arrow::default_memory_pool(), ff, max_row_group_rows,
+            writer_props, arrow_props);
         table.reset();
 
         if (!write_result.ok()) {
@@ -112,15 +168,43 @@ katana::ParquetWriter::Make(
       opts);
 }
 
+katana::ParquetWriter::WriteOpts
+katana::ParquetWriter::WriteOpts::Properties() {
+  WriteOpts opts;
+  opts.compression = arrow::Compression::ZSTD;
+  opts.dictionary = DictionaryEncoding::kAuto;
+  opts.max_row_group_rows = kPropertyRowGroupRows;
+  opts.compute_zone_maps = true;
+  katana::GetEnv("KATANA_ARROW_PROPERTY_FILES", &opts.fixed_width_as_arrow);
+  return opts;
+}
+
 Result<std::unique_ptr<katana::ParquetWriter>>
 katana::ParquetWriter::Make(
     std::shared_ptr<arrow::Table> table, WriteOpts opts) {
+  if (opts.max_row_group_rows <= 0) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "row groups must have rows: {}",
+        opts.max_row_group_rows);
+  }
+
+  // Zones cover the rows of the whole table, so that they stay valid however
+  // the table is split into files
+  std::vector<ZoneMap> zone_maps;
+  if (opts.compute_zone_maps) {
+    for (const auto& column : table->columns()) {
+      zone_maps.emplace_back(
+          KATANA_CHECKED(ZoneMap::Make(*column, opts.max_row_group_rows)));
+    }
+  }
+
   if (!opts.write_blocked) {
     return std::unique_ptr<ParquetWriter>(
-        new ParquetWriter({std::move(table)}, opts));
+        new ParquetWriter({std::move(table)}, opts, std::move(zone_maps)));
   }
   return std::unique_ptr<ParquetWriter>(new ParquetWriter(
-      BlockTable(std::move(table), opts.mbs_per_block), opts));
+      BlockTable(std::move(table), opts.mbs_per_block), opts,
+      std::move(zone_maps)));
 }
 
 katana::Result<void>
@@ -134,11 +218,35 @@ katana::ParquetWriter::WriteToUri(const katana::URI& uri, WriteGroup* group) {
 }
 
 std::shared_ptr<parquet::WriterProperties>
-katana::ParquetWriter::StandardWriterProperties() {
-  return parquet::WriterProperties::Builder()
-      .version(opts_.parquet_version)
+katana::ParquetWriter::StandardWriterProperties(const arrow::Table& table) {
+  parquet::WriterProperties::Builder builder;
+  builder.version(opts_.parquet_version)
       ->data_page_version(opts_.data_page_version)
-      ->build();
+      ->compression(AvailableCompression(opts_.compression));
+  if (opts_.compression_level) {
+    builder.compression_level(opts_.compression_level.value());
+  }
+  if (!opts_.write_statistics) {
+    builder.disable_statistics();
+  }
+
+  switch (opts_.dictionary) {
+  case DictionaryEncoding::kAlways:
+    builder.enable_dictionary();
+    break;
+  case DictionaryEncoding::kNever:
+    builder.disable_dictionary();
+    break;
+  case DictionaryEncoding::kAuto:
+    builder.enable_dictionary();
+    for (int i = 0; i < table.num_columns(); ++i) {
+      if (IsHighCardinalityString(*table.column(i))) {
+        builder.disable_dictionary(table.field(i)->name());
+      }
+    }
+    break;
+  }
+  return builder.build();
 }
 
 std::shared_ptr<parquet::ArrowWriterProperties>
@@ -151,12 +259,14 @@ katana::Result<void>
 katana::ParquetWriter::StoreParquet(
     std::shared_ptr<arrow::Table> table, const katana::URI& uri,
     katana::WriteGroup* desc) {
-  auto writer_props = StandardWriterProperties();
+  auto writer_props = StandardWriterProperties(*table);
   auto arrow_props = StandardArrowProperties();
   std::string prefix = uri.string();
 
   if (table->num_rows() <= kMaxRowsPerFile) {
-    return DoStoreParquet(prefix, table, writer_props, arrow_props, desc);
+    return DoStoreParquet(
+        prefix, table, writer_props, arrow_props, opts_.max_row_group_rows,
+        desc);
   }
 
   std::vector<std::shared_ptr<arrow::Table>> tables;
@@ -179,7 +289,7 @@ katana::ParquetWriter::StoreParquet(
   for (const auto& t : tables) {
     KATANA_CHECKED(DoStoreParquet(
         fmt::format("{}.part_{:09}", prefix, table_count++), t, writer_props,
-        arrow_props, desc));
+        arrow_props, opts_.max_row_group_rows, desc));
   }
   return FileStore(
       uri.string(), KATANA_CHECKED(katana::JsonDump(table_offsets)));
@@ -35,6 +35,8 @@ public:
   katana::RDGTopology::TransposeKind transpose_state_{-1};
   katana::RDGTopology::EdgeSortKind edge_sort_state_{-1};
   katana::RDGTopology::NodeSortKind node_sort_state_{-1};
+  katana::RDGTopology::StorageEncoding storage_encoding_{
+      katana::RDGTopology::StorageEncoding::kRaw};
 
   // control variables
 
@@ -24,6 +24,7 @@
 #include <parquet/properties.h>
 
 #include "AddProperties.h"
+#include "ArrowPropertyFile.h"
 #include "GlobalState.h"
 #include "RDGCore.h"
 #include "RDGHandleImpl.h"
@@ -45,22 +46,62 @@ using json = nlohmann::json;
 
 namespace {
 
+/// Writes \p array to a new file in \p dir and returns the name of the file.
+/// If \p zone_map is not null, it is set to the zones of the array (which are
+/// empty unless \p opts asks for them).
 katana::Result<std::string>
 StoreArrowArrayAtName(
     const std::shared_ptr<arrow::ChunkedArray>& array, const katana::URI& dir,
-    const std::string& name, katana::WriteGroup* desc) {
+    const std::string& name, katana::WriteGroup* desc,
+    const katana::ParquetWriter::WriteOpts& opts =
+        katana::ParquetWriter::WriteOpts::Defaults(),
+    katana::ZoneMap* zone_map = nullptr) {
+  if (opts.fixed_width_as_arrow &&
+      katana::CanStoreArrowPropertyFile(*array->type())) {
+    katana::URI new_path =
+        dir.RandFile(name) + std::string(katana::kArrowPropertyFileSuffix);
+    if (zone_map != nullptr) {
+      *zone_map = opts.compute_zone_maps
+                      ? KATANA_CHECKED(katana::ZoneMap::Make(
+                            *array, opts.max_row_group_rows))
+                      : katana::ZoneMap();
+    }
+    auto table = arrow::Table::Make(
+        arrow::schema({arrow::field(name, array->type())}), {array});
+    KATANA_CHECKED_CONTEXT(
+        katana::StoreArrowPropertyFile(std::move(table), new_path, desc),
+        "writing to: {}", new_path);
+    return new_path.BaseName();
+  }
+
   std::unique_ptr<katana::ParquetWriter> writer =
-      KATANA_CHECKED(katana::ParquetWriter::Make(array, name));
+      KATANA_CHECKED(katana::ParquetWriter::Make(array, name, opts));
 
   katana::URI new_path = dir.RandFile(name);
   KATANA_CHECKED_CONTEXT(
       writer->WriteToUri(new_path, desc), "writing to: {}", new_path);
+  if (zone_map != nullptr) {
+    *zone_map = writer->zone_maps().empty() ? katana::ZoneMap()
+                                            : writer->zone_maps()[0];
+  }
   return new_path.BaseName();
 }
 
+katana::ParquetWriter::WriteOpts
+PropertyWriteOpts(
+    const katana::RDGCore::PropertyWriteOpts& write_opts,
+    const std::string& name) {
+  auto it = write_opts.find(name);
+  if (it == write_opts.end()) {
+    return katana::ParquetWriter::WriteOpts::Properties();
+  }
+  return it->second;
+}
+
 katana::Result<void>
 WriteProperties(
     const arrow::Table& props, std::vector<katana::PropStorageInfo*> prop_info,
+    const katana::RDGCore::PropertyWriteOpts& write_opts,
     const katana::URI& dir, katana::WriteGroup* desc) {
   const auto& schema = props.schema();
 
@@ -71,10 +112,12 @@ WriteProperties(
     }
     std::string name = prop_info[i]->name().empty() ? schema->field(i)->name()
                                                     : prop_info[i]->name();
-    std::string path =
-        KATANA_CHECKED(StoreArrowArrayAtName(props.column(i), dir, name, desc));
+    katana::ZoneMap zone_map;
+    std::string path = KATANA_CHECKED(StoreArrowArrayAtName(
+        props.column(i), dir, name, desc, PropertyWriteOpts(write_opts, name),
+        &zone_map));
 
-    prop_info[i]->WasWritten(path);
+    prop_info[i]->WasWritten(path, std::move(zone_map));
   }
   TSUBA_PTP(katana::internal::FaultSensitivity::Normal);
 
@@ -320,7 +363,8 @@ katana::RDG::DoStore(
   // writing node properties
   KATANA_CHECKED(WriteProperties(
       *core_->node_properties(), node_props_to_store,
-      handle.impl_->rdg_manifest().dir(), write_group.get()));
+      core_->node_property_write_opts(), handle.impl_->rdg_manifest().dir(),
+      write_group.get()));
 
   std::vector<std::string> edge_prop_names;
   for (const auto& field : core_->edge_properties()->fields()) {
@@ -333,7 +377,8 @@ katana::RDG::DoStore(
   // writing edge properties
   KATANA_CHECKED(WriteProperties(
       *core_->edge_properties(), edge_props_to_store,
-      handle.impl_->rdg_manifest().dir(), write_group.get()));
+      core_->edge_property_write_opts(), handle.impl_->rdg_manifest().dir(),
+      write_group.get()));
 
   // writing partition metadata
   core_->part_header().set_part_prop_info_list(KATANA_CHECKED(
@@ -385,7 +430,8 @@ katana::RDG::DoMake(
         }
         rdg->core_->set_node_properties(std::move(prop_table));
         return katana::ResultSuccess();
-      }));
+      },
+      core_->map_local_files()));
 
   // populating edge properties
   KATANA_CHECKED(AddProperties(
@@ -405,7 +451,8 @@ katana::RDG::DoMake(
         }
         rdg->core_->set_edge_properties(std::move(prop_table));
         return katana::ResultSuccess();
-      }));
+      },
+      core_->map_local_files()));
 
   // populating topologies
   KATANA_CHECKED(core_->MakeTopologyManager(metadata_dir));
@@ -508,6 +555,7 @@ katana::RDG::Make(const RDGManifest& manifest, const RDGLoadOptions& opts) {
   // needs a valid rdg_dir
   rdg.set_rdg_dir(manifest.dir());
   KATANA_LOG_ASSERT(!manifest.dir().empty());
+  rdg.core_->set_map_local_files(opts.map_local_files);
 
   std::vector<PropStorageInfo*> node_props = KATANA_CHECKED(
       rdg.core_->part_header().SelectNodeProperties(opts.node_properties));
@@ -663,6 +711,7 @@ katana::Result<std::shared_ptr<arrow::Table>>
 UnloadProperty(
     const std::shared_ptr<arrow::Table>& props, int i,
     std::vector<katana::PropStorageInfo>* prop_info_list,
+    const katana::RDGCore::PropertyWriteOpts& write_opts,
     const katana::URI& dir) {
   if (i < 0 || i > props->num_columns()) {
     return KATANA_ERROR(
@@ -681,9 +730,11 @@ UnloadProperty(
   KATANA_LOG_ASSERT(!prop_info.IsAbsent());
 
   if (prop_info.IsDirty()) {
-    std::string path = KATANA_CHECKED(
-        StoreArrowArrayAtName(props->column(i), dir, name, nullptr));
-    prop_info.WasWritten(path);
+    katana::ZoneMap zone_map;
+    std::string path = KATANA_CHECKED(StoreArrowArrayAtName(
+        props->column(i), dir, name, nullptr,
+        PropertyWriteOpts(write_opts, name), &zone_map));
+    prop_info.WasWritten(path, std::move(zone_map));
   }
 
   prop_info.WasUnloaded();
@@ -691,8 +742,8 @@ UnloadProperty(
   return KATANA_CHECKED(props->RemoveColumn(i));
 }
 
-katana::Result<katana::URI>
-GetStorageLocationIfValid(
+katana::Result<const katana::PropStorageInfo*>
+FindPropStorageInfoIfValid(
     const std::string& name,
     const std::vector<katana::PropStorageInfo>& prop_info_list) {
   auto psi_it = std::find_if(
@@ -708,16 +759,78 @@ GetStorageLocationIfValid(
     return KATANA_ERROR(
         katana::ErrorCode::AssertionFailed, "the property exists but is dirty");
   }
+  return &*psi_it;
+}
+
+katana::Result<katana::URI>
+GetStorageLocationIfValid(
+    const std::string& name,
+    const std::vector<katana::PropStorageInfo>& prop_info_list) {
+  const katana::PropStorageInfo* psi =
+      KATANA_CHECKED(FindPropStorageInfoIfValid(name, prop_info_list));
   // TODO(thunt) there's really no reason why we shouldn't always use uri
-  auto path = KATANA_CHECKED(katana::URI::Make(psi_it->path()));
+  auto path = KATANA_CHECKED(katana::URI::Make(psi->path()));
   return path;
 }
 
+katana::Result<std::shared_ptr<arrow::Table>>
+ReadPropertyRange(
+    const std::string& name,
+    const std::vector<katana::PropStorageInfo>& prop_info_list,
+    const katana::URI& dir, const katana::ParquetReader::Bound& min,
+    const katana::ParquetReader::Bound& max,
+    std::vector<katana::ParquetReader::Slice>* slices) {
+  const katana::PropStorageInfo* psi =
+      KATANA_CHECKED(FindPropStorageInfoIfValid(name, prop_info_list));
+  katana::URI path = dir.Join(psi->path());
+
+  if (psi->zone_map().empty()) {
+    std::shared_ptr<arrow::Table> props =
+        KATANA_CHECKED(katana::LoadProperties(name, path));
+    if (slices != nullptr) {
+      *slices = {{.offset = 0, .length = props->num_rows()}};
+    }
+    return props;
+  }
+
+  std::vector<katana::ParquetReader::Slice> selected =
+      KATANA_CHECKED(psi->zone_map().Select(min, max));
+  std::vector<std::shared_ptr<arrow::Table>> tables;
+  if (katana::IsArrowPropertyFile(path.path())) {
+    // Arrow files have no row groups to skip, so read the file once, mapped
+    // if it is local, and cut the zones out of it
+    std::shared_ptr<arrow::Table> props = KATANA_CHECKED(
+        katana::LoadProperties(name, path, /*map_local_files=*/true));
+    for (const auto& slice : selected) {
+      tables.emplace_back(props->Slice(slice.offset, slice.length));
+    }
+    if (tables.empty()) {
+      tables.emplace_back(props->Slice(0, 0));
+    }
+  } else {
+    for (const auto& slice : selected) {
+      tables.emplace_back(KATANA_CHECKED_CONTEXT(
+          katana::LoadPropertySlice(name, path, slice.offset, slice.length),
+          "reading rows [{}, {}) of {}", slice.offset,
+          slice.offset + slice.length, std::quoted(name)));
+    }
+    if (tables.empty()) {
+      // an empty slice still has the schema of the property
+      tables.emplace_back(
+          KATANA_CHECKED(katana::LoadPropertySlice(name, path, 0, 0)));
+    }
+  }
+  if (slices != nullptr) {
+    *slices = std::move(selected);
+  }
+  return KATANA_CHECKED(arrow::ConcatenateTables(tables));
+}
+
 katana::Result<std::shared_ptr<arrow::Table>>
 LoadProperty(
     const std::shared_ptr<arrow::Table>& props, const std::string name, int i,
     std::vector<katana::PropStorageInfo>* prop_info_list,
-    const katana::URI& dir) {
+    const katana::URI& dir, bool map_local_files) {
   auto psi_it = std::find_if(
       prop_info_list->begin(), prop_info_list->end(),
       [&](const katana::PropStorageInfo& psi) { return psi.name() == name; });
@@ -753,7 +866,8 @@ LoadProperty(
           new_table = col;
         }
         return katana::ResultSuccess();
-      }));
+      },
+      map_local_files));
 
   KATANA_LOG_ASSERT(prop_info.IsClean());
 
@@ -766,7 +880,7 @@ katana::Result<void>
 katana::RDG::UnloadNodeProperty(int i) {
   std::shared_ptr<arrow::Table> new_props = KATANA_CHECKED(UnloadProperty(
       node_properties(), i, &core_->part_header().node_prop_info_list(),
-      rdg_dir()));
+      core_->node_property_write_opts(), rdg_dir()));
   core_->set_node_properties(std::move(new_props));
   return katana::ResultSuccess();
 }
@@ -793,7 +907,7 @@ katana::Result<void>
 katana::RDG::UnloadEdgeProperty(int i) {
   std::shared_ptr<arrow::Table> new_props = KATANA_CHECKED(UnloadProperty(
       edge_properties(), i, &core_->part_header().edge_prop_info_list(),
-      rdg_dir()));
+      core_->edge_property_write_opts(), rdg_dir()));
   core_->set_edge_properties(std::move(new_props));
   return katana::ResultSuccess();
 }
@@ -804,6 +918,52 @@ katana::RDG::GetEdgePropertyStorageLocation(const std::string& name) const {
       name, core_->part_header().edge_prop_info_list());
 }
 
+void
+katana::RDG::SetNodePropertyWriteOpts(
+    const std::string& name, const ParquetWriter::WriteOpts& opts) {
+  core_->node_property_write_opts()[name] = opts;
+}
+
+void
+katana::RDG::SetEdgePropertyWriteOpts(
+    const std::string& name, const ParquetWriter::WriteOpts& opts) {
+  core_->edge_property_write_opts()[name] = opts;
+}
+
+katana::Result<katana::ZoneMap>
+katana::RDG::GetNodePropertyZoneMap(const std::string& name) const {
+  const PropStorageInfo* psi = KATANA_CHECKED(FindPropStorageInfoIfValid(
+      name, core_->part_header().node_prop_info_list()));
+  return psi->zone_map();
+}
+
+katana::Result<katana::ZoneMap>
+katana::RDG::GetEdgePropertyZoneMap(const std::string& name) const {
+  const PropStorageInfo* psi = KATANA_CHECKED(FindPropStorageInfoIfValid(
+      name, core_->part_header().edge_prop_info_list()));
+  return psi->zone_map();
+}
+
+katana::Result<std::shared_ptr<arrow::Table>>
+katana::RDG::ReadNodePropertyRange(
+    const std::string& name, const ParquetReader::Bound& min,
+    const ParquetReader::Bound& max,
+    std::vector<ParquetReader::Slice>* slices) const {
+  return ReadPropertyRange(
+      name, core_->part_header().node_prop_info_list(), rdg_dir(), min, max,
+      slices);
+}
+
+katana::Result<std::shared_ptr<arrow::Table>>
+katana::RDG::ReadEdgePropertyRange(
+    const std::string& name, const ParquetReader::Bound& min,
+    const ParquetReader::Bound& max,
+    std::vector<ParquetReader::Slice>* slices) const {
+  return ReadPropertyRange(
+      name, core_->part_header().edge_prop_info_list(), rdg_dir(), min, max,
+      slices);
+}
+
 katana::Result<void>
 katana::RDG::UnloadEdgeProperty(const std::string& name) {
   auto col_names = edge_properties()->ColumnNames();
@@ -820,7 +980,7 @@ katana::Result<void>
 katana::RDG::LoadNodeProperty(const std::string& name, int i) {
   std::shared_ptr<arrow::Table> new_props = KATANA_CHECKED(LoadProperty(
       node_properties(), name, i, &core_->part_header().node_prop_info_list(),
-      rdg_dir()));
+      rdg_dir(), core_->map_local_files()));
   core_->set_node_properties(std::move(new_props));
   return katana::ResultSuccess();
 }
@@ -829,7 +989,7 @@ katana::Result<void>
 katana::RDG::LoadEdgeProperty(const std::string& name, int i) {
   std::shared_ptr<arrow::Table> new_props = KATANA_CHECKED(LoadProperty(
       edge_properties(), name, i, &core_->part_header().edge_prop_info_list(),
-      rdg_dir()));
+      rdg_dir(), core_->map_local_files()));
   core_->set_edge_properties(std::move(new_props));
   return katana::ResultSuccess();
 }
@@ -1008,7 +1168,11 @@ katana::Result<katana::RDGTopology*>
 katana::RDG::GetTopology(const katana::RDGTopology& shadow) {
   RDGTopology* topology =
       KATANA_CHECKED(core_->topology_manager().GetTopology(shadow));
-  KATANA_CHECKED(topology->Bind(rdg_dir()));
+  if (core_->map_local_files()) {
+    KATANA_CHECKED(topology->BindMapped(rdg_dir()));
+  } else {
+    KATANA_CHECKED(topology->Bind(rdg_dir()));
+  }
   KATANA_CHECKED(topology->Map());
   return topology;
 }
@@ -1129,6 +1293,32 @@ katana::RDG::WriteRDKSubstructureIndexPrimitive(
   return katana::ResultSuccess();
 }
 
+katana::Result<std::optional<katana::PropertyHashIndexPrimitive>>
+katana::RDG::LoadPropertyHashIndexPrimitive(const std::string& name) {
+  // Look the manifest up directly: a missing hash index is expected and
+  // should not be logged.
+  const auto& manifests =
+      core_->part_header().optional_datastructure_manifests();
+  auto it = manifests.find(name);
+  if (it == manifests.end()) {
+    return std::nullopt;
+  }
+
+  katana::PropertyHashIndexPrimitive index = KATANA_CHECKED_CONTEXT(
+      katana::PropertyHashIndexPrimitive::Load(rdg_dir(), it->second),
+      "Failed to load PropertyHashIndexPrimitive located at {}", it->second);
+  return index;
+}
+
+katana::Result<void>
+katana::RDG::WritePropertyHashIndexPrimitive(
+    katana::PropertyHashIndexPrimitive& index) {
+  std::string path = KATANA_CHECKED(index.Write(rdg_dir()));
+  core_->part_header().AppendOptionalDatastructureManifest(index.name(), path);
+
+  return katana::ResultSuccess();
+}
+
 katana::RDG::RDG(std::unique_ptr<RDGCore>&& core) : core_(std::move(core)) {}
 
 katana::RDG::RDG() : core_(std::make_unique<RDGCore>()) {}
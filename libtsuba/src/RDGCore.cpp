@@ -218,6 +218,7 @@ katana::RDGCore::AddNodeProperties(
   KATANA_LOG_DEBUG_ASSERT(txn_ctx != nullptr);
   auto written_prop_names = KATANA_CHECKED(AddProperties(
       props, &node_properties_, &part_header_.node_prop_info_list()));
+  part_header_.DropPropertyHashIndexes(false, written_prop_names);
   // store write properties into transaction context
   txn_ctx->InsertNodePropertyWrite<std::set<std::string>>(
       rdg_dir_, written_prop_names);
@@ -231,6 +232,7 @@ katana::RDGCore::AddEdgeProperties(
   KATANA_LOG_DEBUG_ASSERT(txn_ctx != nullptr);
   auto written_prop_names = KATANA_CHECKED(AddProperties(
       props, &edge_properties_, &part_header_.edge_prop_info_list()));
+  part_header_.DropPropertyHashIndexes(true, written_prop_names);
   // store write properties into transaction context
   txn_ctx->InsertEdgePropertyWrite<std::set<std::string>>(
       rdg_dir_, written_prop_names);
@@ -244,6 +246,7 @@ katana::RDGCore::UpsertNodeProperties(
   KATANA_LOG_DEBUG_ASSERT(txn_ctx != nullptr);
   auto written_prop_names = KATANA_CHECKED(UpsertProperties(
       props, &node_properties_, &part_header_.node_prop_info_list()));
+  part_header_.DropPropertyHashIndexes(false, written_prop_names);
   // store write properties into transaction context
   txn_ctx->InsertNodePropertyWrite<std::set<std::string>>(
       rdg_dir_, written_prop_names);
@@ -257,6 +260,7 @@ katana::RDGCore::UpsertEdgeProperties(
   KATANA_LOG_DEBUG_ASSERT(txn_ctx != nullptr);
   auto written_prop_names = KATANA_CHECKED(UpsertProperties(
       props, &edge_properties_, &part_header_.edge_prop_info_list()));
+  part_header_.DropPropertyHashIndexes(true, written_prop_names);
   // store write properties into transaction context
   txn_ctx->InsertEdgePropertyWrite<std::set<std::string>>(
       rdg_dir_, written_prop_names);
@@ -318,6 +322,7 @@ katana::RDGCore::RemoveNodeProperty(int i, katana::TxnContext* txn_ctx) {
   node_properties_ = KATANA_CHECKED(node_properties_->RemoveColumn(i));
   // store write properties into transaction context
   txn_ctx->InsertNodePropertyWrite(rdg_dir_, field->name());
+  part_header_.DropPropertyHashIndexes(false, {field->name()});
 
   return part_header_.RemoveNodeProperty(field->name());
 }
@@ -328,6 +333,7 @@ katana::RDGCore::RemoveEdgeProperty(int i, katana::TxnContext* txn_ctx) {
   edge_properties_ = KATANA_CHECKED(edge_properties_->RemoveColumn(i));
   // store write properties into transaction context
   txn_ctx->InsertEdgePropertyWrite(rdg_dir_, field->name());
+  part_header_.DropPropertyHashIndexes(true, {field->name()});
 
   return part_header_.RemoveEdgeProperty(field->name());
 }
@@ -2,6 +2,8 @@
 #define KATANA_LIBTSUBA_RDGCORE_H_
 
 #include <memory>
+#include <string>
+#include <unordered_map>
 
 #include <arrow/api.h>
 
@@ -11,6 +13,7 @@
 #include "katana/FileView.h"
 #include "katana/Logging.h"
 #include "katana/NUMAArray.h"
+#include "katana/ParquetWriter.h"
 #include "katana/RDGTopology.h"
 #include "katana/Result.h"
 #include "katana/TxnContext.h"
@@ -85,6 +88,12 @@ public:
   uint32_t partition_id() const { return partition_id_; }
   void set_partition_id(uint32_t partition_id) { partition_id_ = partition_id; }
 
+  /// See RDGLoadOptions::map_local_files
+  bool map_local_files() const { return map_local_files_; }
+  void set_map_local_files(bool map_local_files) {
+    map_local_files_ = map_local_files;
+  }
+
   std::shared_ptr<arrow::Schema> full_node_schema() const;
 
   const std::shared_ptr<arrow::Table>& node_properties() const {
@@ -284,6 +293,24 @@ public:
     lineage_.AddCommandLine(command_line);
   }
 
+  using PropertyWriteOpts =
+      std::unordered_map<std::string, ParquetWriter::WriteOpts>;
+
+  /// Options for writing particular properties; properties without an entry
+  /// are written with ParquetWriter::WriteOpts::Properties()
+  const PropertyWriteOpts& node_property_write_opts() const {
+    return node_property_write_opts_;
+  }
+  PropertyWriteOpts& node_property_write_opts() {
+    return node_property_write_opts_;
+  }
+  const PropertyWriteOpts& edge_property_write_opts() const {
+    return edge_property_write_opts_;
+  }
+  PropertyWriteOpts& edge_property_write_opts() {
+    return edge_property_write_opts_;
+  }
+
 private:
   void InitEmptyProperties();
 
@@ -308,10 +335,14 @@ private:
   std::shared_ptr<arrow::ChunkedArray> local_to_user_id_;
   std::shared_ptr<arrow::ChunkedArray> local_to_global_id_;
 
+  PropertyWriteOpts node_property_write_opts_;
+  PropertyWriteOpts edge_property_write_opts_;
+
   /// name of the graph that was used to load this RDG
   katana::URI rdg_dir_;
   /// which partition of the graph was loaded
   uint32_t partition_id_{std::numeric_limits<uint32_t>::max()};
+  bool map_local_files_{false};
   // How this graph was derived from the previous version
   RDGLineage lineage_;
 };
@@ -263,6 +263,37 @@ katana::RDGPartHeader::Validate() const {
   return katana::ResultSuccess();
 }
 
+void
+katana::RDGPartHeader::DropPropertyHashIndexes(
+    bool is_edge, const std::set<std::string>& property_names) {
+  // The name of an index is its prefix followed by its property names, all
+  // separated by dots (see PropertyHashIndexPrimitive::name()). A property
+  // name with dots in it may match an index that does not use it; that only
+  // costs a rebuild.
+  std::string prefix =
+      katana::PropertyHashIndexPrimitive::name(is_edge, {}) + ".";
+  for (auto it = optional_datastructure_manifests_.begin();
+       it != optional_datastructure_manifests_.end();) {
+    const std::string& name = it->first;
+    bool stale = false;
+    if (name.compare(0, prefix.size(), prefix) == 0) {
+      std::string names = "." + name.substr(prefix.size()) + ".";
+      for (const auto& property_name : property_names) {
+        if (names.find("." + property_name + ".") != std::string::npos) {
+          stale = true;
+          break;
+        }
+      }
+    }
+    if (stale) {
+      KATANA_LOG_DEBUG("dropping stale hash index {}", name);
+      it = optional_datastructure_manifests_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
 katana::Result<void>
 katana::RDGPartHeader::ChangeStorageLocation(
     const katana::URI& old_location, const katana::URI& new_location) {
@@ -528,12 +559,20 @@ void
 katana::from_json(const nlohmann::json& j, katana::PropStorageInfo& propmd) {
   j.at(0).get_to(propmd.name_);
   j.at(1).get_to(propmd.path_);
+  // zone maps are optional and absent in older headers
+  if (j.size() > 2) {
+    j.at(2).get_to(propmd.zone_map_);
+  }
   propmd.state_ = PropStorageInfo::State::kAbsent;
 }
 
 void
 katana::to_json(json& j, const katana::PropStorageInfo& propmd) {
-  j = json{propmd.name(), propmd.path()};
+  if (propmd.zone_map().empty()) {
+    j = json{propmd.name(), propmd.path()};
+  } else {
+    j = json{propmd.name(), propmd.path(), propmd.zone_map()};
+  }
 }
 
 void
@@ -562,6 +601,14 @@ katana::from_json(
   j.at("transpose_state").get_to(topo.transpose_state_);
   j.at("edge_sort_state").get_to(topo.edge_sort_state_);
   j.at("node_sort_state").get_to(topo.node_sort_state_);
+  // topologies stored before storage encodings existed are raw
+  if (j.contains("storage_encoding")) {
+    j.at("storage_encoding").get_to(topo.storage_encoding_);
+    if (topo.storage_encoding_ ==
+        katana::RDGTopology::StorageEncoding::kInvalid) {
+      throw std::runtime_error("unknown topology storage encoding");
+    }
+  }
   KATANA_LOG_DEBUG(
       "read topology with: topology_state={}, transpose_state={}, "
       "edge_sort_state={}, node_sort_state={}",
@@ -607,7 +654,8 @@ katana::to_json(json& j, const katana::PartitionTopologyMetadataEntry& topo) {
       {"topology_state", topo.topology_state_},
       {"transpose_state", topo.transpose_state_},
       {"edge_sort_state", topo.edge_sort_state_},
-      {"node_sort_state", topo.node_sort_state_}};
+      {"node_sort_state", topo.node_sort_state_},
+      {"storage_encoding", topo.storage_encoding_}};
 
   KATANA_LOG_DEBUG(
       "stored topology with: topology_state={}, transpose_state={}, "
@@ -731,6 +779,25 @@ katana::to_json(
       {"paths", index.paths_}};
 }
 
+void
+katana::from_json(
+    const nlohmann::json& j, katana::PropertyHashIndexPrimitive& index) {
+  j.at("is_edge_index").get_to(index.is_edge_index_);
+  j.at("property_names").get_to(index.property_names_);
+  j.at("num_entities").get_to(index.num_entities_);
+  j.at("paths").get_to(index.paths_);
+}
+
+void
+katana::to_json(
+    nlohmann::json& j, const katana::PropertyHashIndexPrimitive& index) {
+  j = nlohmann::json{
+      {"is_edge_index", index.is_edge_index_},
+      {"property_names", index.property_names_},
+      {"num_entities", index.num_entities_},
+      {"paths", index.paths_}};
+}
+
 void
 katana::from_json(
     const nlohmann::json& j, katana::RDGOptionalDatastructure& data) {
@@ -6,6 +6,7 @@
 #include <memory>
 #include <optional>
 #include <regex>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -18,6 +19,7 @@
 #include "katana/JSON.h"
 #include "katana/Logging.h"
 #include "katana/PartitionMetadata.h"
+#include "katana/PropertyHashIndexPrimitive.h"
 #include "katana/RDG.h"
 #include "katana/RDGStorageFormatVersion.h"
 #include "katana/RDGTopology.h"
@@ -26,6 +28,7 @@
 #include "katana/Result.h"
 #include "katana/URI.h"
 #include "katana/WriteGroup.h"
+#include "katana/ZoneMap.h"
 #include "katana/tsuba.h"
 
 namespace katana {
@@ -82,13 +85,15 @@ public:
 
   void WasModified(const std::shared_ptr<arrow::DataType>& type) {
     path_.clear();
+    zone_map_ = ZoneMap();
     state_ = State::kDirty;
     type_ = type;
   }
 
-  void WasWritten(std::string_view new_path) {
+  void WasWritten(std::string_view new_path, ZoneMap zone_map = ZoneMap()) {
     KATANA_LOG_ASSERT(state_ == State::kDirty);
     path_ = new_path;
+    zone_map_ = std::move(zone_map);
     state_ = State::kClean;
   }
 
@@ -106,6 +111,8 @@ public:
   const std::string& name() const { return name_; }
   const std::string& path() const { return path_; }
   const std::shared_ptr<arrow::DataType>& type() const { return type_; }
+  /// Empty if the property was written without zones
+  const ZoneMap& zone_map() const { return zone_map_; }
 
   // since we don't have type info in the header don't know the
   // type when this would have been constructed. Allow others to
@@ -126,6 +133,7 @@ private:
   std::string name_;
   std::string path_;
   std::shared_ptr<arrow::DataType> type_;
+  ZoneMap zone_map_;
   State state_;
 };
 
@@ -437,7 +445,8 @@ public:
   void AppendOptionalDatastructureManifest(
       const std::string& optional_datastructure_name,
       const std::string& optional_datastructure_path) {
-    optional_datastructure_manifests_.emplace(
+    // Writing a datastructure again replaces the earlier manifest
+    optional_datastructure_manifests_.insert_or_assign(
         optional_datastructure_name, optional_datastructure_path);
     KATANA_LOG_DEBUG(
         "Appended optional datastructure manifest {}, at path {}, total count "
@@ -446,6 +455,11 @@ public:
         optional_datastructure_manifests_.size());
   }
 
+  /// Forgets the stored hash indexes over any of \p property_names of nodes
+  /// (or edges if \p is_edge): their contents no longer match the properties
+  void DropPropertyHashIndexes(
+      bool is_edge, const std::set<std::string>& property_names);
+
   const std::unordered_map<std::string, std::string>&
   optional_datastructure_manifests() const {
     return optional_datastructure_manifests_;
@@ -605,6 +619,9 @@ void from_json(const nlohmann::json& j, RDKLSHIndexPrimitive& index);
 void to_json(nlohmann::json& j, const RDKSubstructureIndexPrimitive& index);
 void from_json(const nlohmann::json& j, RDKSubstructureIndexPrimitive& index);
 
+void to_json(nlohmann::json& j, const PropertyHashIndexPrimitive& index);
+void from_json(const nlohmann::json& j, PropertyHashIndexPrimitive& index);
+
 void to_json(nlohmann::json& j, const RDGOptionalDatastructure& data);
 void from_json(const nlohmann::json& j, RDGOptionalDatastructure& data);
 
@@ -631,7 +648,12 @@ NLOHMANN_JSON_SERIALIZE_ENUM(
     {{RDGTopology::NodeSortKind::kInvalid, "kInvalid"},
      {RDGTopology::NodeSortKind::kAny, "kAny"},
      {RDGTopology::NodeSortKind::kSortedByDegree, "kSortedByDegree"},
-     {RDGTopology::NodeSortKind::kSortedByNodeType, "kSortedByNodeType"}})
+     {RDGTopology::NodeSortKind::kSortedByNodeType, "kSortedByNodeType"},
+     {RDGTopology::NodeSortKind::kReorderedByDegreeGrouping,
+      "kReorderedByDegreeGrouping"},
+     {RDGTopology::NodeSortKind::kReorderedByRCM, "kReorderedByRCM"},
+     {RDGTopology::NodeSortKind::kReorderedByGorder, "kReorderedByGorder"},
+     {RDGTopology::NodeSortKind::kReorderedByRabbit, "kReorderedByRabbit"}})
 
 NLOHMANN_JSON_SERIALIZE_ENUM(
     RDGTopology::TopologyKind,
@@ -642,6 +664,12 @@ NLOHMANN_JSON_SERIALIZE_ENUM(
      {RDGTopology::TopologyKind::kEdgeTypeAwareTopology,
       "kEdgeTypeAwareTopology"}})
 
+NLOHMANN_JSON_SERIALIZE_ENUM(
+    RDGTopology::StorageEncoding,
+    {{RDGTopology::StorageEncoding::kInvalid, "kInvalid"},
+     {RDGTopology::StorageEncoding::kRaw, "kRaw"},
+     {RDGTopology::StorageEncoding::kBlockCompressed, "kBlockCompressed"}})
+
 }  // namespace katana
 
 #endif
@@ -171,11 +171,25 @@ katana::RDGSlice::DoMake(
   katana::RDGTopology* topo =
       KATANA_CHECKED(core_->topology_manager().GetTopology(shadow));
 
-  KATANA_CHECKED_CONTEXT(
-      topo->Bind(
-          metadata_dir, slice.topo_off, slice.topo_off + slice.topo_size, true),
-      "loading topology array; begin: {}, end: {}", slice.topo_off,
-      slice.topo_off + slice.topo_size);
+  if (topo->storage_encoding() ==
+      katana::RDGTopology::StorageEncoding::kBlockCompressed) {
+    // byte offsets mean nothing in a compressed file; decode the blocks that
+    // cover the slice instead
+    KATANA_CHECKED_CONTEXT(
+        topo->Bind(metadata_dir, true), "loading compressed topology");
+    KATANA_CHECKED_CONTEXT(
+        topo->MapSlice(slice.node_range, slice.edge_range),
+        "decoding topology; nodes: [{}, {}), edges: [{}, {})",
+        slice.node_range.first, slice.node_range.second,
+        slice.edge_range.first, slice.edge_range.second);
+  } else {
+    KATANA_CHECKED_CONTEXT(
+        topo->Bind(
+            metadata_dir, slice.topo_off, slice.topo_off + slice.topo_size,
+            true),
+        "loading topology array; begin: {}, end: {}", slice.topo_off,
+        slice.topo_off + slice.topo_size);
+  }
 
   if (core_->part_header().IsEntityTypeIDsOutsideProperties()) {
     katana::URI node_types_path = metadata_dir.Join(
@@ -547,6 +561,20 @@ katana::RDGSlice::topology_file_storage() const {
   return topo->file_storage();
 }
 
+const katana::RDGTopology*
+katana::RDGSlice::compressed_topology() const {
+  katana::RDGTopology shadow = katana::RDGTopology::MakeShadowCSR();
+  auto res = core_->topology_manager().GetTopology(shadow);
+  KATANA_LOG_VASSERT(res, "CSR topology is no longer available");
+
+  katana::RDGTopology* topo = res.value();
+  if (topo->storage_encoding() !=
+      katana::RDGTopology::StorageEncoding::kBlockCompressed) {
+    return nullptr;
+  }
+  return topo;
+}
+
 bool
 katana::RDGSlice::IsEntityTypeIDsOutsideProperties() const {
   return core_->part_header().IsEntityTypeIDsOutsideProperties();
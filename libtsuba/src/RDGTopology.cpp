@@ -1,5 +1,6 @@
 #include "katana/RDGTopology.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -8,9 +9,11 @@
 #include <boost/outcome/detail/value_storage.hpp>
 #include <unicode/utypes.h>
 
+#include "BlockCompressedTopologyFile.h"
 #include "PartitionTopologyMetadata.h"
 #include "RDGPartHeader.h"
 #include "katana/EntityTypeManager.h"
+#include "katana/Env.h"
 #include "katana/ErrorCode.h"
 #include "katana/FaultTest.h"
 #include "katana/FileFrame.h"
@@ -22,6 +25,73 @@
 #include "katana/config.h"
 #include "katana/tsuba.h"
 
+namespace {
+
+// version field of topology files, see RDGTopology::Map
+constexpr uint64_t kRawVersion = 1;
+constexpr uint64_t kBlockCompressedVersion = 2;
+constexpr size_t kHeaderSize = 4 * sizeof(uint64_t);
+
+katana::RDGTopology::StorageEncoding
+DefaultStorageEncoding() {
+  bool compress = false;
+  katana::GetEnv("KATANA_COMPRESS_TOPOLOGY", &compress);
+  return compress ? katana::RDGTopology::StorageEncoding::kBlockCompressed
+                  : katana::RDGTopology::StorageEncoding::kRaw;
+}
+
+/// Number of adjacency indices in a raw topology file that Map skips to find
+/// the destinations
+uint64_t
+RawAdjIndicesSize(const katana::RDGTopology& topo) {
+  // EdgeTypeAwareTopologies have a larger adj_indices array than usual topologies
+  if (topo.topology_state() ==
+      katana::RDGTopology::TopologyKind::kEdgeTypeAwareTopology) {
+    return std::max(
+        topo.num_nodes(),
+        topo.num_nodes() * topo.edge_condensed_type_id_map_size());
+  }
+  return topo.num_nodes();
+}
+
+/// Number of adjacency indices DoStore writes
+uint64_t
+StoredAdjIndicesSize(const katana::RDGTopology& topo) {
+  if (topo.topology_state() ==
+      katana::RDGTopology::TopologyKind::kEdgeTypeAwareTopology) {
+    return topo.num_nodes() * topo.edge_condensed_type_id_map_size();
+  }
+  return topo.num_nodes();
+}
+
+/// Decodes the adjacency indices [node_range) and destinations [edge_range)
+/// of \p csr
+katana::Result<void>
+DecodeCSR(
+    const katana::BlockCompressedTopologyFile& csr,
+    std::pair<uint64_t, uint64_t> node_range,
+    std::pair<uint64_t, uint64_t> edge_range,
+    katana::NUMAArray<uint64_t>* adj_indices,
+    katana::NUMAArray<uint32_t>* dests) {
+  uint64_t num_indices = node_range.second - node_range.first;
+  uint64_t num_dests = edge_range.second - edge_range.first;
+  // allocate at least one element so that empty arrays have an address, like
+  // the arrays of raw topology files
+  katana::NUMAArray<uint64_t> decoded_adj_indices;
+  decoded_adj_indices.allocateInterleaved(std::max<uint64_t>(num_indices, 1));
+  katana::NUMAArray<uint32_t> decoded_dests;
+  decoded_dests.allocateInterleaved(std::max<uint64_t>(num_dests, 1));
+  KATANA_CHECKED(csr.DecodeIndices(
+      node_range.first, node_range.second, decoded_adj_indices.data()));
+  KATANA_CHECKED(csr.DecodeDests(
+      edge_range.first, edge_range.second, decoded_dests.data()));
+  *adj_indices = std::move(decoded_adj_indices);
+  *dests = std::move(decoded_dests);
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
 std::string
 katana::RDGTopology::path() const {
   if (metadata_entry_valid()) {
@@ -106,31 +176,57 @@ katana::RDGTopology::Bind(
 }
 
 katana::Result<void>
-katana::RDGTopology::Map() {
-  if (file_store_mapped_) {
+katana::RDGTopology::BindMapped(const katana::URI& metadata_dir) {
+  if (file_store_bound_) {
+    KATANA_LOG_WARN("topology already bound, nothing to do");
     return katana::ResultSuccess();
   }
+  if (path().empty()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "Cannot bind topology with empty path");
+  }
+
+  katana::URI t_path = metadata_dir.Join(path());
+  // block compressed topologies are decoded into memory anyway
+  if (storage_encoding_ != StorageEncoding::kRaw ||
+      !MappedFile::IsMappable(t_path)) {
+    return Bind(metadata_dir);
+  }
+
+  KATANA_LOG_DEBUG("mapping entire topology file at path {}", t_path.string());
+  mapped_file_ = KATANA_CHECKED(MappedFile::Make(t_path));
+
+  file_store_bound_ = true;
+  storage_valid_ = true;
+
+  return katana::ResultSuccess();
+}
 
+katana::Result<void>
+katana::RDGTopology::CheckHeader() const {
   if (!file_store_bound_) {
     return KATANA_ERROR(
         ErrorCode::InvalidArgument,
         "topology must be bound before it is mapped");
   }
 
-  const auto* data = file_storage_.ptr<uint64_t>();
+  const auto* data = storage_ptr<uint64_t>();
 
-  size_t min_size = 4;
-  if (file_storage_.size() < min_size) {
+  if (storage_size() < kHeaderSize) {
     return KATANA_ERROR(
         ErrorCode::InvalidArgument,
         "file_storage size {} is less than the minimum size {}",
-        file_storage_.size(), min_size);
+        storage_size(), kHeaderSize);
   }
 
-  if (data[0] != 1) {
+  uint64_t version = storage_encoding_ == StorageEncoding::kBlockCompressed
+                         ? kBlockCompressedVersion
+                         : kRawVersion;
+  if (data[0] != version) {
     return KATANA_ERROR(
         ErrorCode::InvalidArgument,
-        "first entry in the topology data array must be 1, is {}", data[0]);
+        "first entry in the topology data array must be {}, is {}", version,
+        data[0]);
   }
 
   // ensure the data file matches the metadata
@@ -141,7 +237,18 @@ katana::RDGTopology::Map() {
       num_edges_ == data[3], "expected {} edges, found {} edges", num_edges_,
       data[3]);
 
-  adj_indices_ = &data[4];
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::RDGTopology::Map() {
+  if (file_store_mapped_) {
+    return katana::ResultSuccess();
+  }
+
+  KATANA_CHECKED(CheckHeader());
+
+  const auto* data = storage_ptr<uint64_t>();
 
   //TODO(emcginnis): this cursor stuff is gross and easy to mess up.
   // Could introduce a byte iterator, with all usual iterator input stuff.
@@ -150,23 +257,40 @@ katana::RDGTopology::Map() {
   // as well as something like
   // AdvanceBy<T> which advances the cursor in the iterator by sizeof(T)
   // all of the padding math then gets wrapped up in the iterator
-  const uint64_t* cursor = adj_indices_;
+  const uint64_t* cursor = &data[4];
   const uint64_t magic = (num_nodes_ + num_edges_);
-
-  uint64_t adj_indices_size = num_nodes_;
-  // EdgeTypeAwareTopologies have a larger adj_indices array than usual topologies
-  if (topology_state_ ==
-      katana::RDGTopology::TopologyKind::kEdgeTypeAwareTopology) {
-    adj_indices_size =
-        std::max(num_nodes_, num_nodes_ * edge_condensed_type_id_map_size_);
+  size_t csr_size = 0;
+
+  if (storage_encoding_ == StorageEncoding::kBlockCompressed) {
+    BlockCompressedTopologyFile csr =
+        KATANA_CHECKED(BlockCompressedTopologyFile::Make(
+            cursor, storage_size() - kHeaderSize));
+    if (csr.num_indices() != StoredAdjIndicesSize(*this) ||
+        csr.num_dests() != num_edges_) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "compressed topology has {} adj_indices and {} dests, expected {} "
+          "and {}",
+          csr.num_indices(), csr.num_dests(), StoredAdjIndicesSize(*this),
+          num_edges_);
+    }
+    KATANA_CHECKED(DecodeCSR(
+        csr, {0, csr.num_indices()}, {0, num_edges_}, &decoded_adj_indices_,
+        &decoded_dests_));
+    adj_indices_ = decoded_adj_indices_.data();
+    dests_ = decoded_dests_.data();
+    csr_size = csr.size_bytes();
+    cursor += csr_size / sizeof(uint64_t);
+  } else {
+    adj_indices_ = cursor;
+    cursor += RawAdjIndicesSize(*this);
+
+    dests_ = reinterpret_cast<const uint32_t*>(cursor);
+
+    cursor += (num_edges_ / 2 + num_edges_ % 2);
+    csr_size = num_nodes_ * sizeof(uint64_t) + num_edges_ * sizeof(uint32_t);
   }
 
-  cursor += adj_indices_size;
-
-  dests_ = reinterpret_cast<const uint32_t*>(cursor);
-
-  cursor += (num_edges_ / 2 + num_edges_ % 2);
-
   if (metadata_entry_->edge_index_to_property_index_map_present_) {
     KATANA_LOG_VASSERT(
         *cursor == magic, "expected magic number = {}, found {}", magic,
@@ -211,8 +335,8 @@ katana::RDGTopology::Map() {
          FileFrame::calculate_padding_bytes(num_nodes_, sizeof(uint64_t)));
   }
 
-  size_t expected_size = GetGraphSize();
-  if (file_storage_.size() < expected_size) {
+  size_t expected_size = GetGraphSize(csr_size);
+  if (storage_size() < expected_size) {
     return KATANA_ERROR(
         katana::ErrorCode::InvalidArgument,
         "file_view size: {} expected size: {}., num_nodes = {}, num_edges = "
@@ -221,7 +345,7 @@ katana::RDGTopology::Map() {
         "node_index_to_property_index_map_present_ = {}, "
         "edge_condensed_type_id_map_present = {}, "
         "node_condensed_type_id_map_present = {}",
-        file_storage_.size(), expected_size, num_nodes_, num_edges_,
+        storage_size(), expected_size, num_nodes_, num_edges_,
         metadata_entry_->edge_index_to_property_index_map_present_,
         metadata_entry_->node_index_to_property_index_map_present_,
         metadata_entry_->edge_condensed_type_id_map_present_,
@@ -233,6 +357,58 @@ katana::RDGTopology::Map() {
   return katana::ResultSuccess();
 }
 
+katana::Result<void>
+katana::RDGTopology::MapSlice(
+    std::pair<uint64_t, uint64_t> node_range,
+    std::pair<uint64_t, uint64_t> edge_range) {
+  if (file_store_mapped_) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "topology is already mapped");
+  }
+  if (node_range.first > node_range.second ||
+      node_range.second > StoredAdjIndicesSize(*this) ||
+      edge_range.first > edge_range.second ||
+      edge_range.second > num_edges_) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument,
+        "slice with nodes [{}, {}) and edges [{}, {}) is out of bounds",
+        node_range.first, node_range.second, edge_range.first,
+        edge_range.second);
+  }
+
+  KATANA_CHECKED(CheckHeader());
+
+  const auto* data = storage_ptr<uint64_t>();
+  const uint64_t* cursor = &data[4];
+
+  if (storage_encoding_ == StorageEncoding::kBlockCompressed) {
+    BlockCompressedTopologyFile csr =
+        KATANA_CHECKED(BlockCompressedTopologyFile::Make(
+            cursor, storage_size() - kHeaderSize));
+    KATANA_CHECKED(DecodeCSR(
+        csr, node_range, edge_range, &decoded_adj_indices_, &decoded_dests_));
+    adj_indices_ = decoded_adj_indices_.data();
+    dests_ = decoded_dests_.data();
+  } else {
+    uint64_t adj_indices_size = RawAdjIndicesSize(*this);
+    size_t slice_end = kHeaderSize + adj_indices_size * sizeof(uint64_t) +
+                       edge_range.second * sizeof(uint32_t);
+    if (storage_size() < slice_end) {
+      return KATANA_ERROR(
+          ErrorCode::InvalidArgument,
+          "file_view size: {} is too small for the slice, which ends at {}",
+          storage_size(), slice_end);
+    }
+    adj_indices_ = cursor + node_range.first;
+    dests_ = reinterpret_cast<const uint32_t*>(cursor + adj_indices_size) +
+             edge_range.first;
+  }
+
+  file_store_mapped_ = true;
+
+  return katana::ResultSuccess();
+}
+
 katana::Result<void>
 katana::RDGTopology::MapMetadataExtract(
     uint64_t num_nodes, uint64_t num_edges, bool storage_valid) {
@@ -249,10 +425,10 @@ katana::RDGTopology::MapMetadataExtract(
         "topology must be bound before it is mapped");
   }
 
-  const auto* data = file_storage_.ptr<uint64_t>();
+  const auto* data = storage_ptr<uint64_t>();
 
   size_t min_size = 4;
-  if (file_storage_.size() < min_size) {
+  if (storage_size() < min_size) {
     return katana::ErrorCode::InvalidArgument;
   }
 
@@ -308,13 +484,36 @@ katana::RDGTopology::DoStore(
     auto ff = std::make_unique<katana::FileFrame>();
     KATANA_CHECKED(ff->Init());
 
-    uint64_t data[4] = {1, 0, num_nodes_, num_edges_};
+    bool compress = storage_encoding_ == StorageEncoding::kBlockCompressed;
+    uint64_t data[4] = {
+        compress ? kBlockCompressedVersion : kRawVersion, 0, num_nodes_,
+        num_edges_};
     arrow::Status aro_sts = ff->Write(&data, 4 * sizeof(uint64_t));
     if (!aro_sts.ok()) {
       return katana::ArrowToKatana(aro_sts.code());
     }
 
-    if (num_nodes_) {
+    if (compress) {
+      uint64_t adj_indices_size = StoredAdjIndicesSize(*this);
+      KATANA_LOG_VASSERT(
+          adj_indices_ != nullptr || adj_indices_size == 0,
+          "Cannot store an RDGTopology with nodes and null adj_indices");
+      KATANA_LOG_VASSERT(
+          dests_ != nullptr || num_edges_ == 0,
+          "Cannot store an RDGTopology with null dests_");
+
+      KATANA_LOG_DEBUG(
+          "Storing RDGTopology to file. Writing compressed adj_indices, size "
+          "= {}, and dests, size = {}",
+          adj_indices_size, num_edges_);
+
+      KATANA_CHECKED_CONTEXT(
+          BlockCompressedTopologyFile::Encode(
+              adj_indices_, adj_indices_size, dests_, num_edges_, ff.get()),
+          "Failed to write compressed topology to file frame");
+    }
+
+    if (num_nodes_ && !compress) {
       if (edge_condensed_type_id_map_size_ > 0) {
         KATANA_LOG_VASSERT(
             adj_indices_ != nullptr,
@@ -343,7 +542,7 @@ katana::RDGTopology::DoStore(
       }
     }
 
-    if (num_edges_) {
+    if (num_edges_ && !compress) {
       KATANA_LOG_VASSERT(
           dests_ != nullptr, "Cannot store an RDGTopology with null dests_");
       const auto* raw = dests_;
@@ -476,6 +675,7 @@ katana::RDGTopology::DoStore(
         node_condensed_type_id_map_size_,
         (node_condensed_type_id_map_ != nullptr), topology_state_,
         transpose_state_, edge_sort_state_, node_sort_state_);
+    metadata_entry_->storage_encoding_ = storage_encoding_;
   }
 
   else if (path().empty()) {
@@ -517,10 +717,10 @@ katana::RDGTopology::DoStore(
     }
 
     TSUBA_PTP(internal::FaultSensitivity::Normal);
-    // depends on `topology file_storage_` outliving writes
+    // depends on the bound topology file outliving writes
     // all topology file stores must remain bound until write_group->Finish() completes
     write_group->StartStore(
-        path_uri.string(), file_storage_.ptr<uint8_t>(), file_storage_.size());
+        path_uri.string(), storage_ptr<uint8_t>(), storage_size());
     TSUBA_PTP(internal::FaultSensitivity::Normal);
 
     // since nothing has changed besides the storage location, just have to update path
@@ -534,10 +734,10 @@ katana::RDGTopology::DoStore(
 bool
 katana::RDGTopology::Equals(const RDGTopology& other) const {
   return (
-      file_storage_.size() == other.file_storage_.size() &&
+      storage_size() == other.storage_size() &&
       !memcmp(
-          file_storage_.ptr<uint8_t>(), other.file_storage_.ptr<uint8_t>(),
-          file_storage_.size()) &&
+          storage_ptr<uint8_t>(), other.storage_ptr<uint8_t>(),
+          storage_size()) &&
       topology_state_ == other.topology_state_ &&
       transpose_state_ == other.transpose_state_ &&
       edge_sort_state_ == other.edge_sort_state_ &&
@@ -583,6 +783,7 @@ katana::RDGTopology::DoMake(
   topo.transpose_state_ = transpose_state;
   topo.edge_sort_state_ = edge_sort_state;
   topo.node_sort_state_ = node_sort_state;
+  topo.storage_encoding_ = DefaultStorageEncoding();
 
   return RDGTopology(std::move(topo));
 }
@@ -706,6 +907,7 @@ katana::RDGTopology::Make(katana::PartitionTopologyMetadataEntry* entry) {
   topo.transpose_state_ = topo.metadata_entry_->transpose_state_;
   topo.edge_sort_state_ = topo.metadata_entry_->edge_sort_state_;
   topo.node_sort_state_ = topo.metadata_entry_->node_sort_state_;
+  topo.storage_encoding_ = topo.metadata_entry_->storage_encoding_;
   topo.edge_condensed_type_id_map_size_ =
       topo.metadata_entry_->edge_condensed_type_id_map_size_;
   topo.node_condensed_type_id_map_size_ =
@@ -718,11 +920,9 @@ katana::RDGTopology::Make(katana::PartitionTopologyMetadataEntry* entry) {
 }
 
 size_t
-katana::RDGTopology::GetGraphSize() const {
+katana::RDGTopology::GetGraphSize(size_t csr_size) const {
   /// version, sizeof_edge_data, num_nodes, num_edges
-  constexpr int mandatory_fields = 4;
-  size_t graphsize = (mandatory_fields + num_nodes_) * sizeof(uint64_t) +
-                     (num_edges_ * sizeof(uint32_t));
+  size_t graphsize = kHeaderSize + csr_size;
 
   KATANA_LOG_DEBUG("Base graph size = {}", graphsize);
 
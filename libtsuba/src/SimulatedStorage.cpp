@@ -0,0 +1,255 @@
+#include "katana/SimulatedStorage.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "katana/Env.h"
+#include "katana/ErrorCode.h"
+#include "katana/Logging.h"
+#include "katana/file.h"
+
+namespace {
+
+bool
+HasPrefix(const std::string& str, std::string_view prefix) {
+  return str.size() >= prefix.size() &&
+         str.compare(0, prefix.size(), prefix) == 0;
+}
+
+}  // namespace
+
+katana::SimulatedStorage::Options
+katana::SimulatedStorage::Options::FromEnv() {
+  Options opts;
+  if (int latency_us = 0;
+      katana::GetEnv("KATANA_SIMULATED_STORAGE_LATENCY_US", &latency_us) &&
+      latency_us > 0) {
+    opts.latency = std::chrono::microseconds(latency_us);
+  }
+  if (double mbps = 0;
+      katana::GetEnv("KATANA_SIMULATED_STORAGE_BANDWIDTH_MBPS", &mbps) &&
+      mbps > 0) {
+    opts.bandwidth = static_cast<uint64_t>(mbps * 1000 * 1000);
+  }
+  if (int max_requests = 0; katana::GetEnv(
+                                "KATANA_SIMULATED_STORAGE_MAX_CONCURRENT_"
+                                "REQUESTS",
+                                &max_requests) &&
+                            max_requests > 0) {
+    opts.max_concurrent_requests = max_requests;
+  }
+  katana::GetEnv("KATANA_SIMULATED_STORAGE_RECORD_TRACE", &opts.record_trace);
+  return opts;
+}
+
+katana::SimulatedStorage::SimulatedStorage(
+    Options opts, std::string_view uri_scheme, std::string_view target_scheme)
+    : FileStorage(uri_scheme),
+      opts_(opts),
+      target_scheme_(target_scheme) {}
+
+katana::Result<void>
+katana::SimulatedStorage::Init() {
+  if (target_scheme_ == uri_scheme()) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "simulated storage {} cannot wrap itself",
+        uri_scheme());
+  }
+  start_ = Clock::now();
+  link_free_ = start_;
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+katana::SimulatedStorage::Fini() {
+  return katana::ResultSuccess();
+}
+
+katana::Result<std::string>
+katana::SimulatedStorage::Wrap(const std::string& uri) const {
+  if (!HasPrefix(uri, target_scheme_)) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "{} is not a {} uri", uri, target_scheme_);
+  }
+  return std::string(uri_scheme()) + uri.substr(target_scheme_.size());
+}
+
+katana::Result<std::string>
+katana::SimulatedStorage::Unwrap(const std::string& uri) const {
+  if (!HasPrefix(uri, uri_scheme())) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "{} is not a {} uri", uri, uri_scheme());
+  }
+  return target_scheme_ + uri.substr(uri_scheme().size());
+}
+
+katana::SimulatedStorage::Trace
+katana::SimulatedStorage::GetTrace() const {
+  std::lock_guard<std::mutex> lock(trace_mutex_);
+  return trace_;
+}
+
+void
+katana::SimulatedStorage::ClearTrace() {
+  std::lock_guard<std::mutex> lock(trace_mutex_);
+  trace_.clear();
+}
+
+void
+katana::SimulatedStorage::AcquireSlot() {
+  if (opts_.max_concurrent_requests == 0) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(slots_mutex_);
+  slots_cv_.wait(
+      lock, [this] { return in_flight_ < opts_.max_concurrent_requests; });
+  ++in_flight_;
+}
+
+void
+katana::SimulatedStorage::ReleaseSlot() {
+  if (opts_.max_concurrent_requests == 0) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    --in_flight_;
+  }
+  slots_cv_.notify_one();
+}
+
+katana::SimulatedStorage::Clock::time_point
+katana::SimulatedStorage::ReserveLink(Clock::time_point ready, uint64_t size) {
+  if (opts_.bandwidth == 0 || size == 0) {
+    return ready;
+  }
+  auto transfer = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(
+          static_cast<double>(size) / static_cast<double>(opts_.bandwidth)));
+
+  // requests share the link first come, first served: a transfer starts when
+  // both the request and the link are ready
+  std::lock_guard<std::mutex> lock(link_mutex_);
+  link_free_ = std::max(link_free_, ready) + transfer;
+  return link_free_;
+}
+
+template <typename OpFunc>
+katana::Result<void>
+katana::SimulatedStorage::Simulate(
+    RequestKind kind, const std::string& uri, uint64_t begin, uint64_t size,
+    OpFunc op) {
+  auto issued = Clock::now();
+  AcquireSlot();
+  auto admitted = Clock::now();
+
+  auto done = ReserveLink(admitted + opts_.latency, size);
+  auto res = op();
+  std::this_thread::sleep_until(done);
+
+  ReleaseSlot();
+  auto finished = Clock::now();
+
+  if (opts_.record_trace) {
+    Request req;
+    req.kind = kind;
+    req.begin = begin;
+    req.size = size;
+    req.issued = issued - start_;
+    req.queued = admitted - issued;
+    req.elapsed = finished - issued;
+    req.ok = static_cast<bool>(res);
+    std::lock_guard<std::mutex> lock(trace_mutex_);
+    trace_[uri].emplace_back(req);
+  }
+  return res;
+}
+
+katana::Result<void>
+katana::SimulatedStorage::Stat(const std::string& uri, StatBuf* s_buf) {
+  std::string target = KATANA_CHECKED(Unwrap(uri));
+  return Simulate(RequestKind::kStat, uri, 0, 0, [&]() {
+    return katana::FileStat(target, s_buf);
+  });
+}
+
+katana::Result<void>
+katana::SimulatedStorage::GetMultiSync(
+    const std::string& uri, uint64_t start, uint64_t size,
+    uint8_t* result_buf) {
+  std::string target = KATANA_CHECKED(Unwrap(uri));
+  return Simulate(RequestKind::kGet, uri, start, size, [&]() {
+    return katana::FileGet(target, result_buf, start, size);
+  });
+}
+
+katana::Result<void>
+katana::SimulatedStorage::PutMultiSync(
+    const std::string& uri, const uint8_t* data, uint64_t size) {
+  std::string target = KATANA_CHECKED(Unwrap(uri));
+  return Simulate(RequestKind::kPut, uri, 0, size, [&]() {
+    return katana::FileStore(target, data, size);
+  });
+}
+
+katana::Result<void>
+katana::SimulatedStorage::RemoteCopy(
+    const std::string& source_uri, const std::string& dest_uri, uint64_t begin,
+    uint64_t size) {
+  std::string source = KATANA_CHECKED(Unwrap(source_uri));
+  std::string dest = KATANA_CHECKED(Unwrap(dest_uri));
+  // the copy happens inside the store, so it pays latency but not bandwidth
+  return Simulate(RequestKind::kCopy, dest_uri, begin, 0, [&]() {
+    return katana::FileRemoteCopy(source, dest, begin, size);
+  });
+}
+
+std::future<katana::CopyableResult<void>>
+katana::SimulatedStorage::PutAsync(
+    const std::string& uri, const uint8_t* data, uint64_t size) {
+  return std::async(
+      std::launch::async, [this, uri, data, size]() -> CopyableResult<void> {
+        KATANA_CHECKED(PutMultiSync(uri, data, size));
+        return CopyableResultSuccess();
+      });
+}
+
+std::future<katana::CopyableResult<void>>
+katana::SimulatedStorage::GetAsync(
+    const std::string& uri, uint64_t start, uint64_t size,
+    uint8_t* result_buf) {
+  return std::async(
+      std::launch::async,
+      [this, uri, start, size, result_buf]() -> CopyableResult<void> {
+        KATANA_CHECKED(GetMultiSync(uri, start, size, result_buf));
+        return CopyableResultSuccess();
+      });
+}
+
+std::future<katana::CopyableResult<void>>
+katana::SimulatedStorage::ListAsync(
+    const std::string& directory, std::vector<std::string>* list,
+    std::vector<uint64_t>* size) {
+  return std::async(
+      std::launch::async,
+      [this, directory, list, size]() -> CopyableResult<void> {
+        std::string target = KATANA_CHECKED(Unwrap(directory));
+        // names are relative to the directory, so they need no rewriting
+        auto list_fn = [&]() -> Result<void> {
+          KATANA_CHECKED(katana::FileListAsync(target, list, size).get());
+          return ResultSuccess();
+        };
+        KATANA_CHECKED(Simulate(RequestKind::kList, directory, 0, 0, list_fn));
+        return CopyableResultSuccess();
+      });
+}
+
+katana::Result<void>
+katana::SimulatedStorage::Delete(
+    const std::string& directory,
+    const std::unordered_set<std::string>& files) {
+  std::string target = KATANA_CHECKED(Unwrap(directory));
+  return Simulate(RequestKind::kDelete, directory, 0, 0, [&]() {
+    return katana::FileDelete(target, files);
+  });
+}
@@ -0,0 +1,269 @@
+#include "katana/ZoneMap.h"
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <variant>
+
+#include "katana/ErrorCode.h"
+
+using json = nlohmann::json;
+using Bound = katana::ParquetReader::Bound;
+
+namespace {
+
+/// Longer string bounds are not stored: a prefix is a valid minimum but not a
+/// valid maximum, and the bounds are kept in the part header
+constexpr size_t kMaxStringBoundSize = 64;
+
+using Bounds = std::optional<std::pair<Bound, Bound>>;
+
+/// The smallest and largest non-null values of \p rows for which \p skip is
+/// false
+template <typename ArrowType, typename Value, typename Skip>
+std::optional<std::pair<Value, Value>>
+MinMax(const arrow::ChunkedArray& rows, const Skip& skip) {
+  using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
+  std::optional<std::pair<Value, Value>> ret;
+  for (const auto& chunk : rows.chunks()) {
+    const auto& typed = static_cast<const ArrayType&>(*chunk);
+    for (int64_t i = 0; i < typed.length(); ++i) {
+      if (typed.IsNull(i)) {
+        continue;
+      }
+      Value value = typed.GetView(i);
+      if (skip(value)) {
+        continue;
+      }
+      if (!ret) {
+        ret = std::make_pair(value, value);
+        continue;
+      }
+      if (value < ret->first) {
+        ret->first = value;
+      }
+      if (ret->second < value) {
+        ret->second = value;
+      }
+    }
+  }
+  return ret;
+}
+
+template <typename ArrowType>
+Bounds
+IntegerBounds(const arrow::ChunkedArray& rows) {
+  using Value = typename ArrowType::c_type;
+  auto min_max = MinMax<ArrowType, Value>(rows, [](Value) { return false; });
+  if (!min_max) {
+    return std::nullopt;
+  }
+  if constexpr (std::is_unsigned_v<Value> && sizeof(Value) == sizeof(int64_t)) {
+    if (min_max->second >
+        static_cast<Value>(std::numeric_limits<int64_t>::max())) {
+      return std::nullopt;
+    }
+  }
+  return std::make_pair(
+      Bound{static_cast<int64_t>(min_max->first)},
+      Bound{static_cast<int64_t>(min_max->second)});
+}
+
+template <typename ArrowType>
+Bounds
+FloatingPointBounds(const arrow::ChunkedArray& rows) {
+  using Value = typename ArrowType::c_type;
+  // Like Parquet statistics, ignore NaNs; infinities cannot be stored in JSON
+  auto min_max = MinMax<ArrowType, Value>(
+      rows, [](Value value) { return std::isnan(value); });
+  if (!min_max || !std::isfinite(min_max->first) ||
+      !std::isfinite(min_max->second)) {
+    return std::nullopt;
+  }
+  return std::make_pair(
+      Bound{static_cast<double>(min_max->first)},
+      Bound{static_cast<double>(min_max->second)});
+}
+
+template <typename ArrowType>
+Bounds
+StringBounds(const arrow::ChunkedArray& rows) {
+  using Value = arrow::util::string_view;
+  auto min_max = MinMax<ArrowType, Value>(rows, [](Value) { return false; });
+  if (!min_max || min_max->second.size() > kMaxStringBoundSize) {
+    return std::nullopt;
+  }
+  const Value& min = min_max->first;
+  return std::make_pair(
+      Bound{std::string(min.data(), std::min(min.size(), kMaxStringBoundSize))},
+      Bound{std::string(min_max->second.data(), min_max->second.size())});
+}
+
+Bounds
+ZoneBounds(const arrow::ChunkedArray& rows) {
+  switch (rows.type()->id()) {
+  case arrow::Type::INT8:
+    return IntegerBounds<arrow::Int8Type>(rows);
+  case arrow::Type::INT16:
+    return IntegerBounds<arrow::Int16Type>(rows);
+  case arrow::Type::INT32:
+    return IntegerBounds<arrow::Int32Type>(rows);
+  case arrow::Type::INT64:
+    return IntegerBounds<arrow::Int64Type>(rows);
+  case arrow::Type::UINT8:
+    return IntegerBounds<arrow::UInt8Type>(rows);
+  case arrow::Type::UINT16:
+    return IntegerBounds<arrow::UInt16Type>(rows);
+  case arrow::Type::UINT32:
+    return IntegerBounds<arrow::UInt32Type>(rows);
+  case arrow::Type::UINT64:
+    return IntegerBounds<arrow::UInt64Type>(rows);
+  case arrow::Type::DATE32:
+    return IntegerBounds<arrow::Date32Type>(rows);
+  case arrow::Type::DATE64:
+    return IntegerBounds<arrow::Date64Type>(rows);
+  case arrow::Type::TIME32:
+    return IntegerBounds<arrow::Time32Type>(rows);
+  case arrow::Type::TIME64:
+    return IntegerBounds<arrow::Time64Type>(rows);
+  case arrow::Type::TIMESTAMP:
+    return IntegerBounds<arrow::TimestampType>(rows);
+  case arrow::Type::DURATION:
+    return IntegerBounds<arrow::DurationType>(rows);
+  case arrow::Type::FLOAT:
+    return FloatingPointBounds<arrow::FloatType>(rows);
+  case arrow::Type::DOUBLE:
+    return FloatingPointBounds<arrow::DoubleType>(rows);
+  case arrow::Type::STRING:
+    return StringBounds<arrow::StringType>(rows);
+  case arrow::Type::LARGE_STRING:
+    return StringBounds<arrow::LargeStringType>(rows);
+  default:
+    return std::nullopt;
+  }
+}
+
+double
+BoundAsDouble(const Bound& bound) {
+  if (std::holds_alternative<int64_t>(bound)) {
+    return static_cast<double>(std::get<int64_t>(bound));
+  }
+  return std::get<double>(bound);
+}
+
+json
+BoundToJson(const Bound& bound) {
+  return std::visit([](const auto& value) { return json(value); }, bound);
+}
+
+Bound
+BoundFromJson(const json& j) {
+  if (j.is_string()) {
+    return j.get<std::string>();
+  }
+  if (j.is_number_integer()) {
+    return j.get<int64_t>();
+  }
+  if (j.is_number_float()) {
+    return j.get<double>();
+  }
+  // nlohmann::json reports errors using exceptions
+  throw std::runtime_error("zone bound is not a number or a string");
+}
+
+}  // namespace
+
+katana::Result<bool>
+katana::BoundLess(const Bound& a, const Bound& b) {
+  bool a_is_string = std::holds_alternative<std::string>(a);
+  bool b_is_string = std::holds_alternative<std::string>(b);
+  if (a_is_string != b_is_string) {
+    return KATANA_ERROR(
+        ErrorCode::TypeError, "cannot compare a string and a number");
+  }
+  if (a_is_string) {
+    return std::get<std::string>(a) < std::get<std::string>(b);
+  }
+  if (std::holds_alternative<int64_t>(a) &&
+      std::holds_alternative<int64_t>(b)) {
+    return std::get<int64_t>(a) < std::get<int64_t>(b);
+  }
+  return BoundAsDouble(a) < BoundAsDouble(b);
+}
+
+katana::Result<katana::ZoneMap>
+katana::ZoneMap::Make(const arrow::ChunkedArray& array, int64_t rows_per_zone) {
+  if (rows_per_zone <= 0) {
+    return KATANA_ERROR(
+        ErrorCode::InvalidArgument, "rows per zone must be positive: {}",
+        rows_per_zone);
+  }
+  ZoneMap zone_map;
+  for (int64_t offset = 0, num_rows = array.length(); offset < num_rows;) {
+    Zone zone;
+    zone.offset = offset;
+    zone.length = std::min(rows_per_zone, num_rows - offset);
+    std::shared_ptr<arrow::ChunkedArray> rows =
+        array.Slice(offset, zone.length);
+    zone.null_count = rows->null_count();
+    if (auto bounds = ZoneBounds(*rows); bounds) {
+      zone.min = std::move(bounds->first);
+      zone.max = std::move(bounds->second);
+    }
+    offset += zone.length;
+    zone_map.zones_.emplace_back(std::move(zone));
+  }
+  return zone_map;
+}
+
+katana::Result<std::vector<katana::ParquetReader::Slice>>
+katana::ZoneMap::Select(const Bound& min, const Bound& max) const {
+  std::vector<ParquetReader::Slice> slices;
+  for (const Zone& zone : zones_) {
+    if (zone.null_count == zone.length) {
+      continue;
+    }
+    if (zone.min && zone.max &&
+        (KATANA_CHECKED(BoundLess(zone.max.value(), min)) ||
+         KATANA_CHECKED(BoundLess(max, zone.min.value())))) {
+      continue;
+    }
+    if (!slices.empty() &&
+        slices.back().offset + slices.back().length == zone.offset) {
+      slices.back().length += zone.length;
+    } else {
+      slices.emplace_back(
+          ParquetReader::Slice{.offset = zone.offset, .length = zone.length});
+    }
+  }
+  return slices;
+}
+
+void
+katana::to_json(json& j, const katana::ZoneMap& zone_map) {
+  j = json::array();
+  for (const Zone& zone : zone_map.zones_) {
+    json entry = json::array({zone.offset, zone.length, zone.null_count});
+    if (zone.min && zone.max) {
+      entry.push_back(BoundToJson(zone.min.value()));
+      entry.push_back(BoundToJson(zone.max.value()));
+    }
+    j.push_back(std::move(entry));
+  }
+}
+
+void
+katana::from_json(const json& j, katana::ZoneMap& zone_map) {
+  zone_map.zones_.clear();
+  for (const auto& entry : j) {
+    Zone zone;
+    entry.at(0).get_to(zone.offset);
+    entry.at(1).get_to(zone.length);
+    entry.at(2).get_to(zone.null_count);
+    if (entry.size() > 4) {
+      zone.min = BoundFromJson(entry.at(3));
+      zone.max = BoundFromJson(entry.at(4));
+    }
+    zone_map.zones_.emplace_back(std::move(zone));
+  }
+}
@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "BlockCompressedTopologyFile.h"
+#include "PartitionTopologyMetadata.h"
+#include "katana/FileFrame.h"
+#include "katana/FileView.h"
+#include "katana/Galois.h"
+#include "katana/RDGManifest.h"
+#include "katana/RDGTopology.h"
+#include "katana/Result.h"
+#include "katana/URI.h"
+#include "katana/WriteGroup.h"
+#include "katana/tsuba.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+// several blocks of indices and of dests, the last ones partial
+constexpr uint64_t kNumNodes =
+    3 * katana::BlockCompressedTopologyFile::kIndicesPerBlock + 7;
+constexpr uint64_t kDegree = 11;
+constexpr uint64_t kNumEdges = kNumNodes * kDegree;
+
+struct CSR {
+  std::vector<uint64_t> adj_indices;
+  std::vector<uint32_t> dests;
+};
+
+/// Mostly nearby destinations, with an occasional far one
+CSR
+MakeCSR() {
+  CSR csr;
+  for (uint64_t n = 0; n < kNumNodes; ++n) {
+    for (uint64_t e = 0; e < kDegree; ++e) {
+      uint64_t dest = e == 0 ? (n * 7919) % kNumNodes : (n + e) % kNumNodes;
+      csr.dests.emplace_back(static_cast<uint32_t>(dest));
+    }
+    csr.adj_indices.emplace_back(csr.dests.size());
+  }
+  return csr;
+}
+
+/// Writes a version 2 topology file, like RDGTopology::DoStore
+katana::Result<void>
+StoreCompressedFile(const CSR& csr, const std::string& path) {
+  katana::FileFrame ff;
+  KATANA_CHECKED(ff.Init());
+  uint64_t header[4] = {2, 0, kNumNodes, kNumEdges};
+  KATANA_CHECKED(ff.Write(&header, sizeof(header)));
+  KATANA_CHECKED(katana::BlockCompressedTopologyFile::Encode(
+      csr.adj_indices.data(), csr.adj_indices.size(), csr.dests.data(),
+      csr.dests.size(), &ff));
+  ff.Bind(path);
+  return ff.Persist();
+}
+
+katana::Result<void>
+TestCodec(const CSR& csr, const std::string& dir) {
+  std::string path = dir + "/codec";
+  KATANA_CHECKED(StoreCompressedFile(csr, path));
+
+  katana::FileView fv;
+  KATANA_CHECKED(fv.Bind(path, true));
+  const auto* section = fv.ptr<uint64_t>() + 4;
+  size_t size = fv.size() - 4 * sizeof(uint64_t);
+
+  auto compressed =
+      KATANA_CHECKED(katana::BlockCompressedTopologyFile::Make(section, size));
+  KATANA_LOG_ASSERT(compressed.num_indices() == kNumNodes);
+  KATANA_LOG_ASSERT(compressed.num_dests() == kNumEdges);
+  KATANA_LOG_ASSERT(compressed.size_bytes() == size);
+  KATANA_LOG_ASSERT(
+      size < csr.adj_indices.size() * sizeof(uint64_t) +
+                 csr.dests.size() * sizeof(uint32_t));
+
+  std::vector<uint64_t> indices(kNumNodes);
+  KATANA_CHECKED(compressed.DecodeIndices(0, kNumNodes, indices.data()));
+  KATANA_LOG_ASSERT(indices == csr.adj_indices);
+  std::vector<uint32_t> dests(kNumEdges);
+  KATANA_CHECKED(compressed.DecodeDests(0, kNumEdges, dests.data()));
+  KATANA_LOG_ASSERT(dests == csr.dests);
+
+  // a range in the middle of a block through the middle of another one
+  uint64_t begin = katana::BlockCompressedTopologyFile::kIndicesPerBlock - 3;
+  uint64_t end = 2 * katana::BlockCompressedTopologyFile::kIndicesPerBlock + 5;
+  std::vector<uint64_t> some(end - begin);
+  KATANA_CHECKED(compressed.DecodeIndices(begin, end, some.data()));
+  KATANA_LOG_ASSERT(std::equal(
+      some.begin(), some.end(), csr.adj_indices.begin() + begin));
+  KATANA_CHECKED(compressed.DecodeIndices(begin, begin, some.data()));
+
+  KATANA_LOG_ASSERT(
+      !compressed.DecodeIndices(0, kNumNodes + 1, indices.data()));
+  KATANA_LOG_ASSERT(
+      !katana::BlockCompressedTopologyFile::Make(section, size / 2));
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+TestMap(const CSR& csr, const std::string& dir) {
+  std::string name = "topology";
+  KATANA_CHECKED(StoreCompressedFile(csr, dir + "/" + name));
+  auto dir_uri = KATANA_CHECKED(katana::URI::MakeFromFile(dir));
+
+  katana::PartitionTopologyMetadataEntry entry;
+  entry.FillCSRMetadataEntry(kNumNodes, kNumEdges);
+  entry.path_ = name;
+  entry.storage_encoding_ =
+      katana::RDGTopology::StorageEncoding::kBlockCompressed;
+
+  auto topo = KATANA_CHECKED(katana::RDGTopology::Make(&entry));
+  KATANA_CHECKED(topo.Bind(dir_uri));
+  KATANA_CHECKED(topo.Map());
+  KATANA_LOG_ASSERT(std::equal(
+      csr.adj_indices.begin(), csr.adj_indices.end(), topo.adj_indices()));
+  KATANA_LOG_ASSERT(
+      std::equal(csr.dests.begin(), csr.dests.end(), topo.dests()));
+  KATANA_CHECKED(topo.unbind_file_storage());
+
+  std::pair<uint64_t, uint64_t> nodes{100, 200};
+  std::pair<uint64_t, uint64_t> edges{
+      csr.adj_indices[nodes.first - 1], csr.adj_indices[nodes.second - 1]};
+  KATANA_CHECKED(topo.Bind(dir_uri));
+  KATANA_CHECKED(topo.MapSlice(nodes, edges));
+  KATANA_LOG_ASSERT(topo.adj_indices()[0] == csr.adj_indices[nodes.first]);
+  KATANA_LOG_ASSERT(topo.dests()[0] == csr.dests[edges.first]);
+  KATANA_LOG_ASSERT(
+      topo.dests()[edges.second - edges.first - 1] ==
+      csr.dests[edges.second - 1]);
+  KATANA_CHECKED(topo.unbind_file_storage());
+
+  // the metadata decides how the file is read
+  entry.storage_encoding_ = katana::RDGTopology::StorageEncoding::kRaw;
+  auto raw = KATANA_CHECKED(katana::RDGTopology::Make(&entry));
+  KATANA_CHECKED(raw.Bind(dir_uri));
+  KATANA_LOG_ASSERT(!raw.Map());
+  KATANA_CHECKED(raw.unbind_file_storage());
+
+  return katana::ResultSuccess();
+}
+
+/// Stores an in memory topology with both property index maps through
+/// DoStore, like RDG::Store does, and maps the file back
+katana::Result<void>
+TestStore(const CSR& csr, const std::string& dir) {
+  auto rdg_dir = KATANA_CHECKED(katana::URI::MakeFromFile(dir + "/rdg"));
+  KATANA_CHECKED(katana::Create(rdg_dir));
+  katana::RDGManifest manifest = KATANA_CHECKED(katana::FindManifest(rdg_dir));
+  katana::RDGFile handle{
+      KATANA_CHECKED(katana::Open(std::move(manifest), katana::kReadWrite))};
+
+  std::vector<uint64_t> edge_map(kNumEdges);
+  for (uint64_t e = 0; e < kNumEdges; ++e) {
+    edge_map[e] = kNumEdges - 1 - e;
+  }
+  std::vector<uint64_t> node_map(kNumNodes);
+  for (uint64_t n = 0; n < kNumNodes; ++n) {
+    node_map[n] = (n * 7) % kNumNodes;
+  }
+
+  auto topo = KATANA_CHECKED(katana::RDGTopology::Make(
+      csr.adj_indices.data(), kNumNodes, csr.dests.data(), kNumEdges,
+      katana::RDGTopology::TopologyKind::kShuffleTopology,
+      katana::RDGTopology::TransposeKind::kNo,
+      katana::RDGTopology::EdgeSortKind::kSortedByDestID,
+      katana::RDGTopology::NodeSortKind::kSortedByDegree, edge_map.data(),
+      node_map.data()));
+  katana::PartitionTopologyMetadataEntry entry;
+  topo.set_metadata_entry(&entry);
+  topo.set_storage_encoding(
+      katana::RDGTopology::StorageEncoding::kBlockCompressed);
+
+  std::unique_ptr<katana::WriteGroup> write_group =
+      KATANA_CHECKED(katana::WriteGroup::Make());
+  KATANA_CHECKED(topo.DoStore(handle, rdg_dir, write_group));
+  KATANA_CHECKED(write_group->Finish());
+
+  KATANA_LOG_ASSERT(
+      entry.storage_encoding_ ==
+      katana::RDGTopology::StorageEncoding::kBlockCompressed);
+  KATANA_LOG_ASSERT(entry.edge_index_to_property_index_map_present_);
+  KATANA_LOG_ASSERT(entry.node_index_to_property_index_map_present_);
+
+  auto stored = KATANA_CHECKED(katana::RDGTopology::Make(&entry));
+  KATANA_CHECKED(stored.Bind(rdg_dir));
+  KATANA_CHECKED(stored.Map());
+  KATANA_LOG_ASSERT(std::equal(
+      csr.adj_indices.begin(), csr.adj_indices.end(), stored.adj_indices()));
+  KATANA_LOG_ASSERT(
+      std::equal(csr.dests.begin(), csr.dests.end(), stored.dests()));
+  // the maps follow the compressed section
+  KATANA_LOG_ASSERT(std::equal(
+      edge_map.begin(), edge_map.end(),
+      stored.edge_index_to_property_index_map()));
+  KATANA_LOG_ASSERT(std::equal(
+      node_map.begin(), node_map.end(),
+      stored.node_index_to_property_index_map()));
+  KATANA_CHECKED(stored.unbind_file_storage());
+
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+int
+main() {
+  katana::GaloisRuntime sys;
+  if (auto init_good = katana::InitTsuba(); !init_good) {
+    KATANA_LOG_FATAL("katana::InitTsuba: {}", init_good.error());
+  }
+
+  fs::path dir = fs::temp_directory_path() /
+                 fs::unique_path("compressed-topology-test-%%%%-%%%%");
+  fs::create_directories(dir);
+
+  CSR csr = MakeCSR();
+  if (auto res = TestCodec(csr, dir.string()); !res) {
+    KATANA_LOG_FATAL("TestCodec: {}", res.error());
+  }
+  if (auto res = TestMap(csr, dir.string()); !res) {
+    KATANA_LOG_FATAL("TestMap: {}", res.error());
+  }
+  if (auto res = TestStore(csr, dir.string()); !res) {
+    KATANA_LOG_FATAL("TestStore: {}", res.error());
+  }
+
+  fs::remove_all(dir);
+
+  if (auto fini_good = katana::FiniTsuba(); !fini_good) {
+    KATANA_LOG_FATAL("katana::FiniTsuba: {}", fini_good.error());
+  }
+  return 0;
+}
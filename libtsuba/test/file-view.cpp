@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 #include <boost/filesystem.hpp>
 
 #include "katana/FileView.h"
@@ -31,9 +35,98 @@ TestEmpty(const std::string& path) {
   return katana::ResultSuccess();
 }
 
+katana::Result<void>
+TestReadahead(const std::string& path) {
+  auto uri = KATANA_CHECKED(katana::URI::MakeFromFile(path));
+  // Several 1MB pages, not a multiple of the page size
+  std::vector<uint64_t> data((5 << 20) / sizeof(uint64_t) + 3);
+  std::iota(data.begin(), data.end(), 0);
+  auto first_uri = uri.Join("first_file");
+  auto second_uri = uri.Join("second_file");
+  KATANA_CHECKED(katana::FileStore(first_uri.string(), data));
+  std::reverse(data.begin(), data.end());
+  KATANA_CHECKED(katana::FileStore(second_uri.string(), data));
+  std::reverse(data.begin(), data.end());
+
+  katana::FileView fv;
+  KATANA_CHECKED(fv.Bind(first_uri.string(), 0, 0, false));
+
+  // Sequential reads through the arrow interface
+  std::vector<uint64_t> chunk(1000);
+  for (size_t i = 0; i + chunk.size() <= data.size(); i += chunk.size()) {
+    auto read_res = fv.Read(chunk.size() * sizeof(uint64_t), chunk.data());
+    KATANA_LOG_ASSERT(read_res.ok());
+    KATANA_LOG_ASSERT(
+        read_res.ValueOrDie() ==
+        static_cast<int64_t>(chunk.size() * sizeof(uint64_t)));
+    KATANA_LOG_ASSERT(std::equal(chunk.begin(), chunk.end(), data.begin() + i));
+  }
+  const katana::FileView::Stats& stats = fv.stats();
+  KATANA_LOG_ASSERT(stats.misses > 0);
+  KATANA_LOG_ASSERT(stats.hits > 0);
+  KATANA_LOG_ASSERT(stats.bytes_prefetched > 0);
+  KATANA_LOG_ASSERT(stats.bytes_fetched <= fv.size());
+
+  // Explicit prefetch followed by direct access; rebinding resets the view
+  KATANA_CHECKED(fv.Bind(second_uri.string(), 0, 0, false));
+  KATANA_LOG_ASSERT(fv.stats().bytes_fetched == 0);
+  KATANA_CHECKED(fv.Prefetch(0, fv.size()));
+  KATANA_LOG_ASSERT(fv.stats().bytes_prefetched == fv.size());
+  KATANA_CHECKED(fv.Fill(0, fv.size(), true));
+  KATANA_LOG_ASSERT(fv.stats().hits == 1);
+  KATANA_LOG_ASSERT(std::equal(data.rbegin(), data.rend(), fv.ptr<uint64_t>()));
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+TestStridedToEOF(const std::string& path) {
+  auto uri = KATANA_CHECKED(katana::URI::MakeFromFile(path));
+  constexpr int64_t kStride = 4096;
+  constexpr int64_t kReadSize = 512;
+  std::vector<uint8_t> data(64 * kStride);
+  std::iota(data.begin(), data.end(), 0);
+  auto strided_uri = uri.Join("strided_file");
+  KATANA_CHECKED(katana::FileStore(strided_uri.string(), data));
+
+  katana::FileView fv;
+  KATANA_CHECKED(fv.Bind(strided_uri.string(), 0, 0, false));
+
+  // Strided reads, the last of which lands exactly on EOF and reads nothing
+  std::vector<uint8_t> chunk(kReadSize);
+  for (int64_t pos = 0;; pos += kStride) {
+    auto read_res = fv.ReadAt(pos, kReadSize, chunk.data());
+    KATANA_LOG_ASSERT(read_res.ok());
+    if (pos == static_cast<int64_t>(data.size())) {
+      KATANA_LOG_ASSERT(read_res.ValueOrDie() == 0);
+      break;
+    }
+    KATANA_LOG_ASSERT(read_res.ValueOrDie() == kReadSize);
+    KATANA_LOG_ASSERT(
+        std::equal(chunk.begin(), chunk.end(), data.begin() + pos));
+  }
+  KATANA_LOG_ASSERT(fv.stats().bytes_prefetched > 0);
+
+  // Same through the buffer interface
+  KATANA_CHECKED(fv.Bind(strided_uri.string(), 0, 0, false));
+  for (int64_t pos = 0; pos <= static_cast<int64_t>(data.size());
+       pos += kStride) {
+    KATANA_LOG_ASSERT(fv.Seek(pos).ok());
+    auto read_res = fv.Read(kReadSize);
+    KATANA_LOG_ASSERT(read_res.ok());
+    int64_t expected =
+        pos == static_cast<int64_t>(data.size()) ? 0 : kReadSize;
+    KATANA_LOG_ASSERT(read_res.ValueOrDie()->size() == expected);
+  }
+
+  return katana::ResultSuccess();
+}
+
 katana::Result<void>
 TestAll(const std::string& path) {
   KATANA_CHECKED_CONTEXT(TestEmpty(path), "TestEmpty");
+  KATANA_CHECKED_CONTEXT(TestReadahead(path), "TestReadahead");
+  KATANA_CHECKED_CONTEXT(TestStridedToEOF(path), "TestStridedToEOF");
 
   return katana::ResultSuccess();
 }
@@ -0,0 +1,184 @@
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <random>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "IoUringQueue.h"
+#include "katana/Env.h"
+#include "katana/Result.h"
+#include "katana/URI.h"
+#include "katana/file.h"
+#include "katana/tsuba.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+std::vector<uint8_t>
+RandomBytes(size_t size, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::vector<uint8_t> data(size);
+  for (auto& b : data) {
+    b = gen();
+  }
+  return data;
+}
+
+// Sizes around the chunk and O_DIRECT alignment boundaries
+const std::vector<size_t> kSizes{
+    0,
+    1,
+    4095,
+    4096,
+    4097,
+    katana::IoUringQueue::kChunkSize - 3,
+    katana::IoUringQueue::kChunkSize,
+    5 * katana::IoUringQueue::kChunkSize + 123,
+};
+
+katana::Result<void>
+TestQueue(const std::string& dir, uint32_t depth, bool direct) {
+  auto queue_res = katana::IoUringQueue::Make(depth, direct);
+  if (!queue_res) {
+    KATANA_LOG_WARN("skipping io_uring test: {}", queue_res.error());
+    return katana::ResultSuccess();
+  }
+  auto queue = std::move(queue_res.value());
+
+  std::vector<std::vector<uint8_t>> contents;
+  std::vector<std::future<katana::CopyableResult<void>>> futures;
+  for (size_t i = 0; i < kSizes.size(); ++i) {
+    contents.emplace_back(RandomBytes(kSizes[i], i));
+  }
+  // Issue all writes before waiting for any of them; chunks beyond the
+  // depth of the queue wait in it
+  for (size_t i = 0; i < kSizes.size(); ++i) {
+    futures.emplace_back(queue->Write(
+        fmt::format("{}/file-{}", dir, i), contents[i].data(), kSizes[i]));
+  }
+  for (auto& future : futures) {
+    KATANA_CHECKED(future.get());
+  }
+  futures.clear();
+
+  // Read back unaligned slices
+  std::vector<std::vector<uint8_t>> slices;
+  std::vector<size_t> starts;
+  for (size_t size : kSizes) {
+    starts.emplace_back(size / 3);
+    slices.emplace_back(size - size / 3 - size / 5);
+  }
+  for (size_t i = 0; i < kSizes.size(); ++i) {
+    futures.emplace_back(queue->Read(
+        fmt::format("{}/file-{}", dir, i), starts[i], slices[i].size(),
+        slices[i].data()));
+  }
+  for (size_t i = 0; i < kSizes.size(); ++i) {
+    KATANA_CHECKED(futures[i].get());
+    KATANA_LOG_ASSERT(
+        fs::file_size(fmt::format("{}/file-{}", dir, i)) == kSizes[i]);
+    KATANA_LOG_ASSERT(std::equal(
+        slices[i].begin(), slices[i].end(), contents[i].begin() + starts[i]));
+  }
+
+  // Reading up to a block past the end of the file is tolerated, like with
+  // the synchronous reads, but not more.
+  std::vector<uint8_t> buf(3 * katana::kBlockSize);
+  std::string path = fmt::format("{}/file-{}", dir, 2);
+  KATANA_CHECKED(queue->Read(path, 0, kSizes[2] + 100, buf.data()).get());
+  KATANA_LOG_ASSERT(!queue->Read(path, 0, buf.size(), buf.data()).get());
+  KATANA_LOG_ASSERT(!queue->Read(dir + "/missing", 0, 10, buf.data()).get());
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<bool>
+SupportsDirectIO(const std::string& dir) {
+  std::string probe = dir + "/direct-probe";
+  int fd = open(probe.c_str(), O_CREAT | O_WRONLY | O_DIRECT, 0644);
+  if (fd < 0) {
+    if (errno == EINVAL) {
+      return false;
+    }
+    return KATANA_ERROR(katana::ResultErrno(), "opening {}", probe);
+  }
+  close(fd);
+  unlink(probe.c_str());
+  return true;
+}
+
+// Goes through LocalStorage, which main asks to use the queue when it is
+// available
+katana::Result<void>
+TestAsyncFiles(const std::string& dir) {
+  auto uri = KATANA_CHECKED(katana::URI::MakeFromFile(dir));
+  std::vector<uint8_t> data =
+      RandomBytes(3 * katana::IoUringQueue::kChunkSize + 17, 42);
+
+  auto file_uri = uri.Join("nested").Join("async_file");
+  KATANA_CHECKED(
+      katana::FileStoreAsync(file_uri.string(), data.data(), data.size())
+          .get());
+
+  std::vector<uint8_t> read(data.size());
+  KATANA_CHECKED(
+      katana::FileGetAsync(file_uri.string(), read.data(), 0, read.size())
+          .get());
+  KATANA_LOG_ASSERT(read == data);
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+TestAll(const std::string& dir) {
+  if (boost::system::error_code err; !fs::create_directories(dir, err)) {
+    if (err) {
+      return KATANA_ERROR(
+          std::error_code(err.value(), err.category()),
+          "creating test directory: {}", err.message());
+    }
+  }
+
+  KATANA_CHECKED_CONTEXT(TestQueue(dir, 4, false), "TestQueue");
+  KATANA_CHECKED_CONTEXT(TestQueue(dir, 1, false), "TestQueue depth 1");
+  // Not all file systems support O_DIRECT (e.g., tmpfs before Linux 6.6)
+  if (KATANA_CHECKED(SupportsDirectIO(dir))) {
+    KATANA_CHECKED_CONTEXT(TestQueue(dir, 4, true), "TestQueue O_DIRECT");
+  } else {
+    KATANA_LOG_WARN(
+        "skipping io_uring O_DIRECT test: {} does not support it", dir);
+  }
+  KATANA_CHECKED_CONTEXT(TestAsyncFiles(dir), "TestAsyncFiles");
+
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+int
+main(int argc, char* argv[]) {
+  // LocalStorage only uses io_uring when asked to
+  katana::SetEnv("KATANA_LOCAL_STORAGE_IO_URING", "true", true);
+  if (auto init_good = katana::InitTsuba(); !init_good) {
+    KATANA_LOG_FATAL("katana::InitTsuba: {}", init_good.error());
+  }
+
+  if (argc <= 1) {
+    KATANA_LOG_FATAL("{} <empty dir>", argv[0]);
+  }
+
+  auto res = TestAll(argv[1]);
+  if (!res) {
+    KATANA_LOG_FATAL("test failed: {}", res.error());
+  }
+
+  if (auto fini_good = katana::FiniTsuba(); !fini_good) {
+    KATANA_LOG_FATAL("katana::FiniTsuba: {}", fini_good.error());
+  }
+
+  return 0;
+}
@@ -1,9 +1,14 @@
+#include <arrow/api.h>
 #include <arrow/chunked_array.h>
+#include <arrow/io/memory.h>
 #include <arrow/type_fwd.h>
+#include <parquet/arrow/writer.h>
 
 #include "katana/ParquetReader.h"
 #include "katana/ParquetWriter.h"
 #include "katana/Result.h"
+#include "katana/ZoneMap.h"
+#include "katana/file.h"
 #include "katana/tsuba.h"
 
 katana::Result<std::shared_ptr<arrow::ChunkedArray>>
@@ -38,10 +43,212 @@ TestLargeStringRoundTrip(const std::string& dir) {
   return katana::ResultSuccess();
 }
 
+constexpr int64_t kScanRows = 1000;
+constexpr int64_t kScanRowsPerGroup = 100;
+constexpr int64_t kWideRows = 1 << 18;
+constexpr int64_t kWideRowsPerGroup = 1 << 16;
+
+/// Columns: id (0 .. kScanRows), score (id / 2.0) and name. Each row group
+/// holds kScanRowsPerGroup consecutive ids.
+katana::Result<std::shared_ptr<arrow::Table>>
+MakeScanTable() {
+  arrow::Int64Builder id_builder;
+  arrow::DoubleBuilder score_builder;
+  arrow::LargeStringBuilder name_builder;
+  for (int64_t i = 0; i < kScanRows; ++i) {
+    KATANA_CHECKED(id_builder.Append(i));
+    KATANA_CHECKED(score_builder.Append(i / 2.0));
+    KATANA_CHECKED(name_builder.Append(fmt::format("name-{:04}", i)));
+  }
+  std::shared_ptr<arrow::Array> ids;
+  std::shared_ptr<arrow::Array> scores;
+  std::shared_ptr<arrow::Array> names;
+  KATANA_CHECKED(id_builder.Finish(&ids));
+  KATANA_CHECKED(score_builder.Finish(&scores));
+  KATANA_CHECKED(name_builder.Finish(&names));
+  return arrow::Table::Make(
+      arrow::schema(
+          {arrow::field("id", arrow::int64()),
+           arrow::field("score", arrow::float64()),
+           arrow::field("name", arrow::large_utf8())}),
+      {ids, scores, names});
+}
+
+katana::Result<void>
+TestScanTable(const std::string& dir) {
+  auto uri = KATANA_CHECKED(katana::URI::Make(dir)).Join("scan.parquet");
+  auto expected = KATANA_CHECKED(MakeScanTable());
+  {
+    auto out = KATANA_CHECKED(arrow::io::BufferOutputStream::Create());
+    KATANA_CHECKED(parquet::arrow::WriteTable(
+        *expected, arrow::default_memory_pool(), out, kScanRowsPerGroup));
+    auto buffer = KATANA_CHECKED(out->Finish());
+    KATANA_CHECKED(
+        katana::FileStore(uri.string(), buffer->data(), buffer->size()));
+  }
+
+  auto reader = KATANA_CHECKED(katana::ParquetReader::Make());
+
+  // All columns, with one and with several threads
+  for (uint32_t num_threads : {1, 4}) {
+    katana::ParquetReader::ScanOpts opts;
+    opts.num_threads = num_threads;
+    auto table = KATANA_CHECKED(reader->ScanTable(uri, opts));
+    KATANA_LOG_ASSERT(table->Equals(*expected));
+  }
+
+  // Projected columns come back in the requested order
+  katana::ParquetReader::ScanOpts projected;
+  projected.columns = {"name", "id"};
+  projected.num_threads = 3;
+  auto table = KATANA_CHECKED(reader->ScanTable(uri, projected));
+  KATANA_LOG_ASSERT(table->num_columns() == 2);
+  KATANA_LOG_ASSERT(table->field(0)->name() == "name");
+  KATANA_LOG_ASSERT(table->field(1)->name() == "id");
+  KATANA_LOG_ASSERT(table->column(1)->Equals(expected->column(0)));
+
+  // Filters prune whole row groups: ids [150, 420] are in the groups of
+  // [100, 500) and scores [0, 60] in the groups of [0, 200)
+  katana::ParquetReader::ScanOpts filtered;
+  filtered.columns = {"id"};
+  filtered.filters = {{"id", int64_t{150}, int64_t{420}}};
+  table = KATANA_CHECKED(reader->ScanTable(uri, filtered));
+  KATANA_LOG_ASSERT(table->num_rows() == 4 * kScanRowsPerGroup);
+  KATANA_LOG_ASSERT(
+      table->column(0)->Equals(expected->column(0)->Slice(100, 400)));
+
+  filtered.filters.push_back({"score", 0.0, 60.0});
+  table = KATANA_CHECKED(reader->ScanTable(uri, filtered));
+  KATANA_LOG_ASSERT(
+      table->column(0)->Equals(expected->column(0)->Slice(100, 100)));
+
+  filtered.filters = {{"name", std::string("zzz"), std::string("zzzz")}};
+  table = KATANA_CHECKED(reader->ScanTable(uri, filtered));
+  KATANA_LOG_ASSERT(table->num_rows() == 0 && table->num_columns() == 1);
+
+  // Only the column chunks that are decoded are fetched: one of two columns
+  // of the same size is about half of the file. The slack covers the footer
+  // and rounding to pages.
+  {
+    auto wide_uri =
+        KATANA_CHECKED(katana::URI::Make(dir)).Join("scan_wide.parquet");
+    arrow::Int64Builder id_builder;
+    arrow::Int64Builder pad_builder;
+    for (int64_t i = 0; i < kWideRows; ++i) {
+      KATANA_CHECKED(id_builder.Append(i));
+      KATANA_CHECKED(pad_builder.Append(-i));
+    }
+    std::shared_ptr<arrow::Array> ids;
+    std::shared_ptr<arrow::Array> pads;
+    KATANA_CHECKED(id_builder.Finish(&ids));
+    KATANA_CHECKED(pad_builder.Finish(&pads));
+    auto wide = arrow::Table::Make(
+        arrow::schema(
+            {arrow::field("id", arrow::int64()),
+             arrow::field("pad", arrow::int64())}),
+        {ids, pads});
+
+    auto out = KATANA_CHECKED(arrow::io::BufferOutputStream::Create());
+    KATANA_CHECKED(parquet::arrow::WriteTable(
+        *wide, arrow::default_memory_pool(), out, kWideRowsPerGroup,
+        parquet::WriterProperties::Builder().disable_dictionary()->build()));
+    auto buffer = KATANA_CHECKED(out->Finish());
+    KATANA_CHECKED(katana::FileStore(
+        wide_uri.string(), buffer->data(), buffer->size()));
+    uint64_t file_size = buffer->size();
+    constexpr uint64_t kSlack = 256 << 10;
+
+    katana::ParquetReader::ScanOpts all;
+    all.num_threads = 2;
+    katana::ParquetReader::ScanStats stats;
+    table = KATANA_CHECKED(reader->ScanTable(wide_uri, all, &stats));
+    KATANA_LOG_ASSERT(table->num_rows() == kWideRows);
+    KATANA_LOG_VASSERT(
+        stats.bytes_fetched >= file_size / 2 &&
+            stats.bytes_fetched <= file_size + kSlack,
+        "fetched {} bytes of {}", stats.bytes_fetched, file_size);
+
+    katana::ParquetReader::ScanOpts one;
+    one.columns = {"id"};
+    one.num_threads = 2;
+    table = KATANA_CHECKED(reader->ScanTable(wide_uri, one, &stats));
+    KATANA_LOG_ASSERT(table->column(0)->Equals(wide->column(0)));
+    KATANA_LOG_VASSERT(
+        stats.bytes_fetched > 0 &&
+            stats.bytes_fetched <= file_size / 2 + kSlack,
+        "fetched {} bytes of {}", stats.bytes_fetched, file_size);
+  }
+
+  // Bad requests
+  katana::ParquetReader::ScanOpts bad;
+  bad.columns = {"missing"};
+  KATANA_LOG_ASSERT(!reader->ScanTable(uri, bad));
+  bad.columns = {};
+  bad.filters = {{"name", int64_t{0}, int64_t{1}}};
+  KATANA_LOG_ASSERT(!reader->ScanTable(uri, bad));
+
+  return katana::ResultSuccess();
+}
+
+katana::Result<void>
+TestZoneMaps(const std::string& dir) {
+  auto uri = KATANA_CHECKED(katana::URI::Make(dir)).Join("zones.parquet");
+  auto expected = KATANA_CHECKED(MakeScanTable());
+
+  auto opts = katana::ParquetWriter::WriteOpts::Properties();
+  opts.max_row_group_rows = kScanRowsPerGroup;
+  auto writer = KATANA_CHECKED(katana::ParquetWriter::Make(expected, opts));
+  KATANA_CHECKED(writer->WriteToUri(uri));
+
+  const std::vector<katana::ZoneMap>& zone_maps = writer->zone_maps();
+  KATANA_LOG_ASSERT(zone_maps.size() == 3);
+  const auto& ids = zone_maps[0];
+  KATANA_LOG_ASSERT(ids.zones().size() == kScanRows / kScanRowsPerGroup);
+  KATANA_LOG_ASSERT(ids.zones()[1].offset == kScanRowsPerGroup);
+  KATANA_LOG_ASSERT(
+      std::get<int64_t>(ids.zones()[1].min.value()) == kScanRowsPerGroup);
+  KATANA_LOG_ASSERT(
+      std::get<int64_t>(ids.zones()[1].max.value()) ==
+      2 * kScanRowsPerGroup - 1);
+
+  // Zones survive the part header
+  nlohmann::json j = ids;
+  auto from_json = j.get<katana::ZoneMap>();
+  KATANA_LOG_ASSERT(nlohmann::json(from_json) == j);
+
+  // ids [150, 420] are in the zones of [100, 500), which are merged; numbers
+  // compare with integers
+  auto slices = KATANA_CHECKED(from_json.Select(int64_t{150}, 420.5));
+  KATANA_LOG_ASSERT(slices.size() == 1);
+  KATANA_LOG_ASSERT(slices[0].offset == 100 && slices[0].length == 400);
+  auto reader = KATANA_CHECKED(katana::ParquetReader::Make());
+  auto table = KATANA_CHECKED(reader->ReadTable(uri, slices[0]));
+  KATANA_LOG_ASSERT(table->Equals(*expected->Slice(100, 400)));
+
+  slices = KATANA_CHECKED(
+      zone_maps[2].Select(std::string("name-0950"), std::string("zzz")));
+  KATANA_LOG_ASSERT(slices.size() == 1 && slices[0].offset == 900);
+  KATANA_LOG_ASSERT(!zone_maps[2].Select(int64_t{0}, int64_t{1}));
+
+  // Compressed files read back the same
+  table = KATANA_CHECKED(reader->ReadTable(uri));
+  KATANA_LOG_ASSERT(table->Equals(*expected));
+
+  // Zones are opt-in
+  writer = KATANA_CHECKED(katana::ParquetWriter::Make(expected));
+  KATANA_LOG_ASSERT(writer->zone_maps().empty());
+  opts.max_row_group_rows = 0;
+  KATANA_LOG_ASSERT(!katana::ParquetWriter::Make(expected, opts));
+
+  return katana::ResultSuccess();
+}
+
 katana::Result<void>
 TestAll(const std::string& dir) {
   KATANA_CHECKED_CONTEXT(
       TestLargeStringRoundTrip(dir), "TestLargeStringRoundTrip");
+  KATANA_CHECKED_CONTEXT(TestScanTable(dir), "TestScanTable");
+  KATANA_CHECKED_CONTEXT(TestZoneMaps(dir), "TestZoneMaps");
 
   return katana::ResultSuccess();
 }
@@ -0,0 +1,122 @@
+#include <chrono>
+#include <future>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "katana/Logging.h"
+#include "katana/Result.h"
+#include "katana/SimulatedStorage.h"
+#include "katana/URI.h"
+#include "katana/file.h"
+#include "katana/tsuba.h"
+
+namespace fs = boost::filesystem;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr auto kLatency = std::chrono::milliseconds(20);
+constexpr uint32_t kConcurrency = 2;
+constexpr uint64_t kSize = 1 << 20;
+
+katana::Result<void>
+TestAll(katana::SimulatedStorage* storage, const std::string& dir) {
+  fs::create_directories(dir);
+  auto file_dir = KATANA_CHECKED(katana::URI::MakeFromFile(dir));
+  std::string wrapped = KATANA_CHECKED(storage->Wrap(file_dir.string()));
+  auto sim_dir = KATANA_CHECKED(katana::URI::Make(wrapped));
+  KATANA_LOG_ASSERT(sim_dir.scheme() == "sim");
+  std::string name = "data";
+  std::string uri = sim_dir.Join(name).string();
+
+  std::vector<uint8_t> data(kSize);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = i;
+  }
+  KATANA_CHECKED(katana::FileStore(uri, data.data(), data.size()));
+  // the data went through to the local file system
+  KATANA_LOG_ASSERT(fs::file_size(fs::path(dir) / name) == kSize);
+
+  katana::StatBuf stat_buf;
+  KATANA_CHECKED(katana::FileStat(uri, &stat_buf));
+  KATANA_LOG_ASSERT(stat_buf.size == kSize);
+
+  std::vector<std::string> files;
+  KATANA_CHECKED(katana::FileListAsync(sim_dir.string(), &files).get());
+  KATANA_LOG_ASSERT(files == std::vector<std::string>{name});
+
+  // twice as many requests as slots take at least two latencies
+  storage->ClearTrace();
+  constexpr uint64_t kNumGets = 2 * kConcurrency;
+  constexpr uint64_t kGetSize = kSize / kNumGets;
+  std::vector<uint8_t> read(kSize);
+  std::vector<std::future<katana::CopyableResult<void>>> futures;
+  auto start = Clock::now();
+  for (uint64_t i = 0; i < kNumGets; ++i) {
+    futures.emplace_back(katana::FileGetAsync(
+        uri, read.data() + i * kGetSize, i * kGetSize, kGetSize));
+  }
+  for (auto& future : futures) {
+    KATANA_CHECKED(future.get());
+  }
+  KATANA_LOG_ASSERT(Clock::now() - start >= 2 * kLatency);
+  KATANA_LOG_ASSERT(read == data);
+
+  auto trace = storage->GetTrace();
+  KATANA_LOG_ASSERT(trace.size() == 1);
+  const auto& requests = trace[uri];
+  KATANA_LOG_ASSERT(requests.size() == kNumGets);
+  std::chrono::nanoseconds queued{0};
+  for (const auto& req : requests) {
+    KATANA_LOG_ASSERT(req.kind == katana::SimulatedStorage::RequestKind::kGet);
+    KATANA_LOG_ASSERT(req.size == kGetSize);
+    KATANA_LOG_ASSERT(req.ok);
+    KATANA_LOG_ASSERT(req.elapsed >= kLatency);
+    queued += req.queued;
+  }
+  KATANA_LOG_ASSERT(queued > std::chrono::nanoseconds(0));
+
+  // errors from the target storage are passed on and recorded
+  storage->ClearTrace();
+  std::string missing = sim_dir.Join("missing").string();
+  KATANA_LOG_ASSERT(!katana::FileStat(missing, &stat_buf));
+  KATANA_LOG_ASSERT(!storage->GetTrace()[missing].at(0).ok);
+
+  KATANA_CHECKED(katana::FileDelete(sim_dir.string(), {name}));
+  KATANA_LOG_ASSERT(!fs::exists(fs::path(dir) / name));
+
+  return katana::ResultSuccess();
+}
+
+}  // namespace
+
+int
+main(int argc, char* argv[]) {
+  if (argc <= 1) {
+    KATANA_LOG_FATAL("{} <empty dir>", argv[0]);
+  }
+
+  katana::SimulatedStorage::Options opts;
+  opts.latency = kLatency;
+  opts.max_concurrent_requests = kConcurrency;
+  katana::SimulatedStorage storage(opts);
+  katana::RegisterFileStorage(&storage);
+
+  if (auto init_good = katana::InitTsuba(); !init_good) {
+    KATANA_LOG_FATAL("katana::InitTsuba: {}", init_good.error());
+  }
+
+  auto res = TestAll(&storage, argv[1]);
+  if (!res) {
+    KATANA_LOG_FATAL("test failed: {}", res.error());
+  }
+
+  if (auto fini_good = katana::FiniTsuba(); !fini_good) {
+    KATANA_LOG_FATAL("katana::FiniTsuba: {}", fini_good.error());
+  }
+
+  return 0;
+}
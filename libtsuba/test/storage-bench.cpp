@@ -0,0 +1,135 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "katana/Galois.h"
+#include "katana/Logging.h"
+#include "katana/RDG.h"
+#include "katana/RDGManifest.h"
+#include "katana/RDGTopology.h"
+#include "katana/Result.h"
+#include "katana/SimulatedStorage.h"
+#include "katana/URI.h"
+#include "katana/tsuba.h"
+
+/*
+ * Loads an RDG through SimulatedStorage to see how the storage path behaves
+ * against a store with the given latency (us), bandwidth (MB/s) and request
+ * concurrency, e.g., to tune ReadGroup parallelism, FileView fetch sizes and
+ * prefetching. Besides the time, each run reports what the store saw: the
+ * number of requests, the bytes read and how long requests queued for a slot.
+ *
+ * Usage: storage-bench [benchmark flags] <rdg dir>
+ */
+
+namespace {
+
+std::string rdg_dir;
+
+void
+MakeArguments(benchmark::internal::Benchmark* b) {
+  b->ArgNames({"latency_us", "mbps", "concurrency"});
+  // a local disk, then stores further away and more constrained
+  b->Args({0, 0, 0});
+  for (long latency_us : {1000, 20000}) {
+    for (long mbps : {100, 1000}) {
+      for (long concurrency : {4, 64}) {
+        b->Args({latency_us, mbps, concurrency});
+      }
+    }
+  }
+  b->Unit(benchmark::kMillisecond);
+  b->UseRealTime();
+}
+
+katana::Result<void>
+LoadRDG(const katana::URI& dir) {
+  katana::RDGManifest manifest = KATANA_CHECKED(katana::FindManifest(dir));
+  katana::RDGFile rdg_file{
+      KATANA_CHECKED(katana::Open(std::move(manifest), katana::kReadOnly))};
+  katana::RDG rdg =
+      KATANA_CHECKED(katana::RDG::Make(rdg_file, katana::RDGLoadOptions()));
+
+  katana::RDGTopology* csr = KATANA_CHECKED(
+      rdg.GetTopology(katana::RDGTopology::MakeShadowCSR()));
+  benchmark::DoNotOptimize(csr->adj_indices());
+  KATANA_CHECKED(csr->unbind_file_storage());
+  return katana::ResultSuccess();
+}
+
+void
+Load(benchmark::State& state) {
+  katana::SimulatedStorage::Options opts;
+  opts.latency = std::chrono::microseconds(state.range(0));
+  opts.bandwidth = state.range(1) * 1000 * 1000;
+  opts.max_concurrent_requests = state.range(2);
+
+  // backends are registered anew for each InitTsuba
+  katana::SimulatedStorage storage(opts);
+  katana::RegisterFileStorage(&storage);
+  if (auto res = katana::InitTsuba(); !res) {
+    KATANA_LOG_FATAL("katana::InitTsuba: {}", res.error());
+  }
+
+  auto file_dir = katana::URI::MakeFromFile(rdg_dir);
+  KATANA_LOG_ASSERT(file_dir);
+  auto wrapped = storage.Wrap(file_dir.value().string());
+  KATANA_LOG_ASSERT(wrapped);
+  auto dir = katana::URI::Make(wrapped.value());
+  KATANA_LOG_ASSERT(dir);
+
+  for (auto _ : state) {
+    if (auto res = LoadRDG(dir.value()); !res) {
+      KATANA_LOG_FATAL("loading {}: {}", dir.value(), res.error());
+    }
+  }
+
+  uint64_t requests = 0;
+  uint64_t bytes = 0;
+  std::chrono::nanoseconds queued{0};
+  std::chrono::nanoseconds longest{0};
+  for (const auto& [uri, trace] : storage.GetTrace()) {
+    for (const auto& req : trace) {
+      requests += 1;
+      bytes += req.size;
+      queued += req.queued;
+      longest = std::max(longest, req.elapsed);
+    }
+  }
+
+  double iterations = state.iterations();
+  state.counters["files"] = storage.GetTrace().size() / iterations;
+  state.counters["requests"] = requests / iterations;
+  state.counters["bytes"] = benchmark::Counter(
+      bytes / iterations, benchmark::Counter::kDefaults,
+      benchmark::Counter::kIs1024);
+  state.counters["queued_ms"] =
+      std::chrono::duration<double, std::milli>(queued).count() / iterations;
+  state.counters["longest_ms"] =
+      std::chrono::duration<double, std::milli>(longest).count();
+  state.SetBytesProcessed(bytes);
+
+  if (auto res = katana::FiniTsuba(); !res) {
+    KATANA_LOG_FATAL("katana::FiniTsuba: {}", res.error());
+  }
+}
+
+BENCHMARK(Load)->Apply(MakeArguments);
+
+}  // namespace
+
+int
+main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (argc != 2) {
+    KATANA_LOG_FATAL("usage: {} [benchmark flags] <rdg dir>", argv[0]);
+  }
+  rdg_dir = argv[1];
+
+  katana::GaloisRuntime sys;
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
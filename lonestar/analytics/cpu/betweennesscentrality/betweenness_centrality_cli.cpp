@@ -64,11 +64,25 @@ static cll::opt<BetweennessCentralityPlan::Algorithm> algo(
         // clEnumValN(BetweennessCentralityPlan::kAsynchronous, "Async", "Asynchronous"),
         clEnumValN(
             BetweennessCentralityPlan::kOuter, "Outer",
-            "Outer parallel algorithm")
+            "Outer parallel algorithm"),
+        clEnumValN(
+            BetweennessCentralityPlan::kSampling, "Sampling",
+            "Approximation from sampled sources; source options are ignored")
         // clEnumValN(BetweennessCentralityPlan::kAutoAlgo, "Auto", "Auto: choose among the algorithms automatically")
         ),
     cll::init(BetweennessCentralityPlan::kLevel));
 
+static cll::opt<double> epsilon(
+    "epsilon",
+    cll::desc("Error bound of the normalized centrality for -algo=Sampling "
+              "(default value 0.01)"),
+    cll::init(BetweennessCentralityPlan::kDefaultEpsilon));
+static cll::opt<double> delta(
+    "delta",
+    cll::desc("Probability that -algo=Sampling exceeds its error bound "
+              "(default value 0.1)"),
+    cll::init(BetweennessCentralityPlan::kDefaultDelta));
+
 static cll::opt<bool> thread_spin(
     "threadSpin",
     cll::desc("If enabled, threads busy-wait for work rather than use "
@@ -117,11 +131,14 @@ main(int argc, char** argv) {
 
   BetweennessCentralityPlan plan =
       BetweennessCentralityPlan::FromAlgorithm(algo);
+  if (algo == BetweennessCentralityPlan::kSampling) {
+    plan = BetweennessCentralityPlan::Sampling(epsilon, delta);
+  }
 
   BetweennessCentralitySources sources = kBetweennessCentralityAllNodes;
   uint32_t num_sources = pg_projected_view->NumNodes();
 
-  if (!allSources) {
+  if (!allSources && algo != BetweennessCentralityPlan::kSampling) {
     if (!startNodesFile.getValue().empty()) {
       std::ifstream file(startNodesFile);
       if (!file.good()) {
@@ -154,7 +171,7 @@ main(int argc, char** argv) {
       }
       num_sources = sources_vec.size();
     }
-  } else {
+  } else if (algo != BetweennessCentralityPlan::kSampling) {
     sources = num_sources;
   }
 
@@ -44,6 +44,12 @@ static cll::opt<unsigned int> report_node(
     "reportNode",
     cll::desc("Node to report the similarity of (default value 1)"),
     cll::init(1));
+static cll::opt<unsigned int> top_k(
+    "topK",
+    cll::desc(
+        "If nonzero, compute the topK most similar nodes of every node "
+        "instead of the similarity to baseNode (default value 0)"),
+    cll::init(0));
 
 using NodeValue = katana::PODProperty<double>;
 
@@ -89,6 +95,19 @@ main(int argc, char** argv) {
     abort();
   }
 
+  if (top_k > 0) {
+    auto top_k_result =
+        katana::analytics::JaccardTopK(pg_projected_view.get(), {}, top_k);
+    if (!top_k_result) {
+      KATANA_LOG_FATAL("JaccardTopK failed: {}", top_k_result.error());
+    }
+    std::cout << "Found " << top_k_result.value()->num_rows()
+              << " similar node pairs\n";
+
+    totalTime.stop();
+    return 0;
+  }
+
   katana::TxnContext txn_ctx;
   if (auto r = katana::analytics::Jaccard(
           pg_projected_view.get(), base_node, output_property_name, &txn_ctx,
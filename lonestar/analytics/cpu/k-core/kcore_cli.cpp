@@ -47,8 +47,10 @@ static cll::opt<KCorePlan::Algorithm> algo(
         clEnumValN(
             KCorePlan::kSynchronous, "Synchronous", "Synchronous algorithm"),
         clEnumValN(
-            KCorePlan::kAsynchronous, "Asynchronous",
-            "Asynchronous algorithm")),
+            KCorePlan::kAsynchronous, "Asynchronous", "Asynchronous algorithm"),
+        clEnumValN(
+            KCorePlan::kBucketed, "Bucketed",
+            "Bucketed peeling algorithm, which computes all core numbers")),
     cll::init(KCorePlan::kSynchronous));
 
 //! Required k specification for k-core.
@@ -65,6 +67,8 @@ AlgorithmName(KCorePlan::Algorithm algorithm) {
     return "Synchronous";
   case KCorePlan::kAsynchronous:
     return "Asynchronous";
+  case KCorePlan::kBucketed:
+    return "Bucketed";
   default:
     return "Unknown";
   }
@@ -115,6 +119,9 @@ main(int argc, char** argv) {
   case KCorePlan::kAsynchronous:
     plan = KCorePlan::Asynchronous();
     break;
+  case KCorePlan::kBucketed:
+    plan = KCorePlan::Bucketed();
+    break;
   default:
     KATANA_LOG_FATAL("Invalid algorithm");
   }
@@ -43,7 +43,11 @@ static cll::opt<RandomWalksPlan::Algorithm> algo(
         clEnumValN(
             RandomWalksPlan::kNode2Vec, "Node2Vec", "Node2Vec algorithm"),
         clEnumValN(
-            RandomWalksPlan::kEdge2Vec, "Edge2Vec", "Edge2Vec algorithm")),
+            RandomWalksPlan::kEdge2Vec, "Edge2Vec", "Edge2Vec algorithm"),
+        clEnumValN(
+            RandomWalksPlan::kFirstOrder, "FirstOrder",
+            "First-order walks, weighted by the edge property if one is "
+            "given")),
     cll::init(RandomWalksPlan::kNode2Vec));
 
 static cll::opt<uint32_t> maxIterations(
@@ -76,20 +80,25 @@ AlgorithmName(RandomWalksPlan::Algorithm algorithm) {
     return "Node2Vec";
   case RandomWalksPlan::kEdge2Vec:
     return "Edge2Vec";
+  case RandomWalksPlan::kFirstOrder:
+    return "FirstOrder";
   default:
     return "Unknown";
   }
 }
 
 void
-PrintWalks(
-    const std::vector<std::vector<uint32_t>>& walks,
-    const std::string& output_file) {
+PrintWalks(const RandomWalkMatrix& walks, const std::string& output_file) {
   std::ofstream f(output_file);
 
-  for (auto walk : walks) {
-    for (auto node : walk) {
-      f << node << " ";
+  for (uint64_t i = 0; i < walks.num_walks(); i++) {
+    const uint32_t* walk = walks.walk(i);
+    if (walk[1] == kRandomWalkEnd) {
+      continue;
+    }
+    for (uint32_t j = 0; j < walks.row_length() && walk[j] != kRandomWalkEnd;
+         j++) {
+      f << walk[j] << " ";
     }
     f << std::endl;
   }
@@ -135,11 +144,18 @@ main(int argc, char** argv) {
         walkLength, numberOfWalks, backwardProbability, forwardProbability,
         maxIterations, numberOfEdgeTypes);
     break;
+  case RandomWalksPlan::kFirstOrder:
+    plan = RandomWalksPlan::FirstOrder(walkLength, numberOfWalks);
+    break;
   default:
     KATANA_LOG_FATAL("Invalid algorithm");
   }
 
-  auto walks_result = RandomWalks(pg.get(), plan);
+  bool weighted =
+      algo == RandomWalksPlan::kFirstOrder && !edge_property_name.empty();
+  auto walks_result =
+      weighted ? GenerateRandomWalks(pg.get(), edge_property_name, plan)
+               : GenerateRandomWalks(pg.get(), plan);
   if (!walks_result) {
     KATANA_LOG_FATAL("Failed to run RandomWalks: {}", walks_result.error());
   }
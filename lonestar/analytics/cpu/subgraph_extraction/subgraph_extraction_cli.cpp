@@ -45,9 +45,14 @@ static cll::opt<std::string> nodesString(
     cll::init(""));
 static cll::opt<SubGraphExtractionPlan::Algorithm> algo(
     "algo", cll::desc("Choose an algorithm:"),
-    cll::values(clEnumValN(
-        SubGraphExtractionPlan::kNodeSet, "nodeSet",
-        "Extract subgraph topology from node set")),
+    cll::values(
+        clEnumValN(
+            SubGraphExtractionPlan::kNodeSet, "nodeSet",
+            "Extract subgraph topology from node set"),
+        clEnumValN(
+            SubGraphExtractionPlan::kCompressedNodeSet, "compressedNodeSet",
+            "Extract subgraph topology from node set using a compressed "
+            "topology")),
     cll::init(SubGraphExtractionPlan::kNodeSet));
 
 int
@@ -77,6 +82,17 @@ main(int argc, char** argv) {
             << pg_projected_view->topology().NumNodes() << " nodes, "
             << pg_projected_view->topology().NumEdges() << " edges\n";
   SubGraphExtractionPlan plan;
+  switch (algo) {
+  case SubGraphExtractionPlan::kNodeSet:
+    plan = SubGraphExtractionPlan::NodeSet();
+    break;
+  case SubGraphExtractionPlan::kCompressedNodeSet:
+    plan = SubGraphExtractionPlan::CompressedNodeSet();
+    break;
+  default:
+    std::cerr << "Invalid algorithm\n";
+    abort();
+  }
 
   std::vector<uint32_t> node_vec;
   if (!nodesFile.getValue().empty()) {
@@ -76,7 +76,7 @@ from katana.local.analytics._independent_set import (
     independent_set_assert_valid,
 )
 from katana.local.analytics._jaccard import JaccardPlan, JaccardStatistics, jaccard, jaccard_assert_valid
-from katana.local.analytics._k_core import KCorePlan, KCoreStatistics, k_core, k_core_assert_valid
+from katana.local.analytics._k_core import KCorePlan, KCoreStatistics, k_core, k_core_assert_valid, k_core_numbers
 from katana.local.analytics._k_truss import KTrussPlan, KTrussStatistics, k_truss, k_truss_assert_valid
 from katana.local.analytics._ksssp import KssspPlan, ksssp
 from katana.local.analytics._leiden_clustering import (
@@ -14,7 +14,7 @@ Betweenness Centrality
 
 """
 
-from libc.stdint cimport uint32_t
+from libc.stdint cimport uint32_t, uint64_t
 from libcpp.string cimport string
 from libcpp.vector cimport vector
 
@@ -39,8 +39,12 @@ cdef extern from "katana/analytics/betweenness_centrality/betweenness_centrality
         enum Algorithm:
             kOuter "katana::analytics::BetweennessCentralityPlan::kOuter"
             kLevel "katana::analytics::BetweennessCentralityPlan::kLevel"
+            kSampling "katana::analytics::BetweennessCentralityPlan::kSampling"
 
         _BetweennessCentralityPlan.Algorithm algorithm() const
+        double epsilon() const
+        double delta() const
+        uint64_t seed() const
 
         BetweennessCentralityPlan()
 
@@ -49,8 +53,14 @@ cdef extern from "katana/analytics/betweenness_centrality/betweenness_centrality
         @staticmethod
         _BetweennessCentralityPlan Outer()
         @staticmethod
+        _BetweennessCentralityPlan Sampling(double epsilon, double delta, uint64_t seed)
+        @staticmethod
         _BetweennessCentralityPlan FromAlgorithm(_BetweennessCentralityPlan.Algorithm algo)
 
+    double kDefaultEpsilon "katana::analytics::BetweennessCentralityPlan::kDefaultEpsilon"
+    double kDefaultDelta "katana::analytics::BetweennessCentralityPlan::kDefaultDelta"
+    uint64_t kDefaultSeed "katana::analytics::BetweennessCentralityPlan::kDefaultSeed"
+
     BetweennessCentralitySources kBetweennessCentralityAllNodes;
 
     Result[void] BetweennessCentrality(_PropertyGraph* pg, string output_property_name, CTxnContext* txn_ctx, const BetweennessCentralitySources& sources, _BetweennessCentralityPlan plan)
@@ -87,6 +97,7 @@ class _BetweennessCentralityAlgorithm(Enum):
     """
     Outer = _BetweennessCentralityPlan.Algorithm.kOuter
     Level = _BetweennessCentralityPlan.Algorithm.kLevel
+    Sampling = _BetweennessCentralityPlan.Algorithm.kSampling
 
 
 cdef class BetweennessCentralityPlan(Plan):
@@ -113,6 +124,18 @@ cdef class BetweennessCentralityPlan(Plan):
     def algorithm(self) -> _BetweennessCentralityAlgorithm:
         return _BetweennessCentralityAlgorithm(self.underlying_.algorithm())
 
+    @property
+    def epsilon(self) -> float:
+        return self.underlying_.epsilon()
+
+    @property
+    def delta(self) -> float:
+        return self.underlying_.delta()
+
+    @property
+    def seed(self) -> int:
+        return self.underlying_.seed()
+
     @staticmethod
     def outer():
         """
@@ -127,6 +150,15 @@ cdef class BetweennessCentralityPlan(Plan):
         """
         return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.Level())
 
+    @staticmethod
+    def sampling(double epsilon = kDefaultEpsilon, double delta = kDefaultDelta, uint64_t seed = kDefaultSeed):
+        """
+        Approximate from uniformly sampled sources until, with probability at least 1 - delta, the centrality of every
+        node normalized by n * (n - 1) is within epsilon of its exact value. The sources argument of
+        betweenness_centrality may only cap the number of samples.
+        """
+        return BetweennessCentralityPlan.make(_BetweennessCentralityPlan.Sampling(epsilon, delta, seed))
+
 
 def betweenness_centrality(pg, str output_property_name, sources = None,
              BetweennessCentralityPlan plan = BetweennessCentralityPlan(),
@@ -10,6 +10,8 @@ k-Core
 
 .. autofunction:: katana.local.analytics.k_core
 
+.. autofunction:: katana.local.analytics.k_core_numbers
+
 .. autoclass:: katana.local.analytics.KCoreStatistics
 
 
@@ -37,6 +39,7 @@ cdef extern from "katana/analytics/k_core/k_core.h" namespace "katana::analytics
         enum Algorithm:
             kSynchronous "katana::analytics::KCorePlan::kSynchronous"
             kAsynchronous "katana::analytics::KCorePlan::kAsynchronous"
+            kBucketed "katana::analytics::KCorePlan::kBucketed"
 
         _KCorePlan.Algorithm algorithm() const
 
@@ -46,9 +49,13 @@ cdef extern from "katana/analytics/k_core/k_core.h" namespace "katana::analytics
         _KCorePlan Synchronous()
         @staticmethod
         _KCorePlan Asynchronous()
+        @staticmethod
+        _KCorePlan Bucketed()
 
     Result[void] KCore(_PropertyGraph* pg, uint32_t k_core_number, string output_property_name, CTxnContext* txn_ctx, bool is_symmetric, _KCorePlan plan)
 
+    Result[void] KCoreNumbers(_PropertyGraph* pg, string output_property_name, CTxnContext* txn_ctx, bool is_symmetric, _KCorePlan plan)
+
 
     Result[void] KCoreAssertValid(_PropertyGraph* pg, uint32_t k_core_number, string output_property_name)
 
@@ -67,6 +74,7 @@ class _KCorePlanAlgorithm(Enum):
     """
     Synchronous = _KCorePlan.Algorithm.kSynchronous
     Asynchronous = _KCorePlan.Algorithm.kAsynchronous
+    Bucketed = _KCorePlan.Algorithm.kBucketed
 
 
 cdef class KCorePlan(Plan):
@@ -105,6 +113,12 @@ cdef class KCorePlan(Plan):
         Asynchronous
         """
         return KCorePlan.make(_KCorePlan.Asynchronous())
+    @staticmethod
+    def bucketed() -> KCorePlan:
+        """
+        Peel nodes in order of degree, keeping them in buckets by current degree. Computes all core numbers in one run.
+        """
+        return KCorePlan.make(_KCorePlan.Bucketed())
 
 
 def k_core(pg, uint32_t k_core_number, str output_property_name, bool is_symmetric = False, KCorePlan plan = KCorePlan(), *, txn_ctx = None) -> int:
@@ -144,6 +158,27 @@ def k_core(pg, uint32_t k_core_number, str output_property_name, bool is_symmetr
     return v
 
 
+def k_core_numbers(pg, str output_property_name, bool is_symmetric = False, KCorePlan plan = KCorePlan.bucketed(), *, txn_ctx = None) -> int:
+    """
+    Compute the core number of every node in pg, the largest k such that the node is in the k-core.
+
+    :type pg: katana.local.Graph
+    :param pg: The graph to analyze.
+    :type output_property_name: str
+    :param output_property_name: The output property holding the core number of each node.
+        This property must not already exist.
+    :param is_symmetric: The bool flag to indicate if graph is symmetric.
+    :type plan: KCorePlan
+    :param plan: The execution plan to use. Only :py:meth:`KCorePlan.bucketed` is supported.
+    :param txn_ctx: The tranaction context for passing read write sets.
+    """
+    cdef string output_property_name_str = output_property_name.encode("utf-8")
+    txn_ctx = txn_ctx or TxnContext()
+    with nogil:
+        v = handle_result_void(KCoreNumbers(underlying_property_graph(pg), output_property_name_str, underlying_txn_context(txn_ctx), is_symmetric, plan.underlying_))
+    return v
+
+
 def k_core_assert_valid(pg, uint32_t k_core_number, str output_property_name):
     """
     Raise an exception if the k-core results in `pg` are invalid. This is not an exhaustive check, just a sanity check.
@@ -25,6 +25,7 @@ cdef extern from "katana/analytics/subgraph_extraction/subgraph_extraction.h" na
     cppclass _SubGraphExtractionPlan "katana::analytics::SubGraphExtractionPlan" (_Plan):
         enum Algorithm:
             kNodeSet "katana::analytics::SubGraphExtractionPlan::kNodeSet"
+            kCompressedNodeSet "katana::analytics::SubGraphExtractionPlan::kCompressedNodeSet"
 
         _SubGraphExtractionPlan.Algorithm algorithm() const
 
@@ -34,11 +35,16 @@ cdef extern from "katana/analytics/subgraph_extraction/subgraph_extraction.h" na
         _SubGraphExtractionPlan NodeSet(
             )
 
+        @staticmethod
+        _SubGraphExtractionPlan CompressedNodeSet(
+            )
+
     Result[unique_ptr[_PropertyGraph]] SubGraphExtraction(_PropertyGraph* pfg, const vector[uint32_t]& node_vec, _SubGraphExtractionPlan plan)
 
 
 class _SubGraphExtractionPlanAlgorithm(Enum):
     NodeSet = _SubGraphExtractionPlan.Algorithm.kNodeSet
+    CompressedNodeSet = _SubGraphExtractionPlan.Algorithm.kCompressedNodeSet
 
 
 cdef class SubGraphExtractionPlan(Plan):
@@ -72,6 +78,14 @@ cdef class SubGraphExtractionPlan(Plan):
         """
         return SubGraphExtractionPlan.make(_SubGraphExtractionPlan.NodeSet())
 
+    @staticmethod
+    def compressed_node_set() -> SubGraphExtractionPlan:
+        """
+        The node-set algorithm on a compressed copy of the topology, which uses less memory than the sorted copy that
+        the node-set algorithm builds.
+        """
+        return SubGraphExtractionPlan.make(_SubGraphExtractionPlan.CompressedNodeSet())
+
 
 cdef shared_ptr[_PropertyGraph] handle_result_property_graph(Result[unique_ptr[_PropertyGraph]] res) nogil except *:
     if not res.has_value():
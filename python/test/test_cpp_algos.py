@@ -24,6 +24,7 @@ from katana.local.analytics import (
     LouvainClusteringStatistics,
     PagerankStatistics,
     SsspStatistics,
+    SubGraphExtractionPlan,
     TriangleCountPlan,
     betweenness_centrality,
     bfs,
@@ -457,15 +458,16 @@ def test_subgraph_extraction():
         for i in nodes
     ]
 
-    pg = subgraph_extraction(graph, nodes)
+    for plan in [SubGraphExtractionPlan.node_set(), SubGraphExtractionPlan.compressed_node_set()]:
+        pg = subgraph_extraction(graph, nodes, plan)
 
-    assert isinstance(pg, Graph)
-    assert pg.num_nodes() == len(nodes)
-    assert pg.num_edges() == 6
+        assert isinstance(pg, Graph)
+        assert pg.num_nodes() == len(nodes)
+        assert pg.num_edges() == 6
 
-    for i, _ in enumerate(expected_edges):
-        assert len(pg.out_edge_ids(i)) == len(expected_edges[i])
-        assert [pg.get_edge_dst(e) for e in pg.out_edge_ids(i)] == expected_edges[i]
+        for i, _ in enumerate(expected_edges):
+            assert len(pg.out_edge_ids(i)) == len(expected_edges[i])
+            assert [pg.get_edge_dst(e) for e in pg.out_edge_ids(i)] == expected_edges[i]
 
 
 def test_busy_wait(graph: Graph):
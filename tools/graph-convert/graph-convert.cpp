@@ -37,6 +37,7 @@
 #include "katana/ErrorCode.h"
 #include "katana/FileGraph.h"
 #include "katana/Galois.h"
+#include "katana/GraphReordering.h"
 #include "katana/NUMAArray.h"
 #include "katana/RDGManifest.h"
 #include "katana/RDGPrefix.h"
@@ -57,10 +58,12 @@ enum ConvertMode {
   gr2binarypbbs64,
   gr2bsml,
   gr2cgr,
+  gr2dbggr,
   gr2dimacs,
   gr2adjacencylist,
   gr2edgelist,
   gr2edgelist1ind,
+  gr2gordergr,
   gr2linegr,
   gr2lowdegreegr,
   gr2mtx,
@@ -68,8 +71,10 @@ enum ConvertMode {
   gr2partsrcgr,
   gr2pbbs,
   gr2pbbsedges,
+  gr2rabbitgr,
   gr2randgr,
   gr2randomweightgr,
+  gr2rcmgr,
   gr2ringgr,
   gr2rmat,
   gr2metis,
@@ -153,10 +158,17 @@ static cll::opt<ConvertMode> convertMode(
         clEnumVal(gr2bsml, "Convert binary gr to binary sparse MATLAB matrix"),
         clEnumVal(
             gr2cgr, "Clean up binary gr: remove self edges and multi-edges"),
+        clEnumVal(
+            gr2dbggr,
+            "Group nodes by degree, hubs first, keeping their order within "
+            "a group"),
         clEnumVal(gr2dimacs, "Convert binary gr to dimacs"),
         clEnumVal(gr2adjacencylist, "Convert binary gr to adjacency list"),
         clEnumVal(gr2edgelist, "Convert binary gr to edgelist"),
         clEnumVal(gr2edgelist1ind, "Convert binary gr to edgelist, 1-indexed"),
+        clEnumVal(
+            gr2gordergr,
+            "Order nodes by Gorder: neighbors shared with recent nodes"),
         clEnumVal(gr2linegr, "Overlay line graph"),
         clEnumVal(gr2lowdegreegr, "Remove high degree nodes from binary gr"),
         clEnumVal(gr2mtx, "Convert binary gr to matrix market format"),
@@ -167,8 +179,11 @@ static cll::opt<ConvertMode> convertMode(
             gr2partsrcgr, "Partition binary gr in N pieces by source nodes"),
         clEnumVal(gr2pbbs, "Convert binary gr to pbbs graph"),
         clEnumVal(gr2pbbsedges, "Convert binary gr to pbbs edge list"),
+        clEnumVal(
+            gr2rabbitgr, "Order nodes by Rabbit order: community dendrograms"),
         clEnumVal(gr2randgr, "Randomly permute nodes of binary gr"),
         clEnumVal(gr2randomweightgr, "Add or Randomize edge weights"),
+        clEnumVal(gr2rcmgr, "Order nodes by reverse Cuthill-McKee"),
         clEnumVal(
             gr2ringgr,
             "Convert binary gr to strongly connected graph by "
@@ -1203,6 +1218,52 @@ struct SortByBFS : public Conversion {
   }
 };
 
+template <katana::ReorderingKind Kind>
+struct Reorder : public Conversion {
+  template <typename EdgeTy>
+  void convert(const std::string& infilename, const std::string& outfilename) {
+    typedef katana::FileGraph Graph;
+    typedef Graph::GraphNode GNode;
+    typedef katana::NUMAArray<GNode> Permutation;
+
+    Graph graph;
+    graph.fromFile(infilename);
+
+    katana::GraphTopology::AdjIndexVec adj_indices;
+    adj_indices.create(graph.size());
+    katana::GraphTopology::EdgeDestVec dests;
+    dests.create(graph.sizeEdges());
+    katana::do_all(katana::iterate(graph), [&](GNode node) {
+      adj_indices[node] = *graph.edge_end(node);
+      for (Graph::edge_iterator jj = graph.edge_begin(node),
+                                ej = graph.edge_end(node);
+           jj != ej; ++jj) {
+        dests[*jj] = graph.getEdgeDst(jj);
+      }
+    });
+    katana::GraphTopology topology(std::move(adj_indices), std::move(dests));
+
+    auto order_res = katana::ComputeNodeOrder(topology, Kind);
+    if (!order_res) {
+      KATANA_LOG_FATAL("computing node order: {}", order_res.error());
+    }
+    const auto& new_to_old = order_res.value();
+
+    Permutation perm;
+    perm.create(graph.size());
+    for (size_t i = 0; i < new_to_old.size(); ++i) {
+      perm[new_to_old[i]] = i;
+    }
+
+    Graph out;
+    katana::permute<EdgeTy>(graph, perm, out);
+    outputPermutation(perm);
+
+    out.toFile(outfilename);
+    printStatus(out.size(), out.sizeEdges());
+  }
+};
+
 template <typename T, bool IsInteger = std::numeric_limits<T>::is_integer>
 struct UniformDistribution {};
 
@@ -3338,6 +3399,9 @@ main(int argc, char** argv) {
   case gr2cgr:
     convert<Cleanup>();
     break;
+  case gr2dbggr:
+    convert<Reorder<katana::ReorderingKind::kDegreeGrouping>>();
+    break;
   case gr2dimacs:
     convert<Gr2Dimacs>();
     break;
@@ -3350,6 +3414,9 @@ main(int argc, char** argv) {
   case gr2edgelist1ind:
     convert<Gr2Edgelist1Ind>();
     break;
+  case gr2gordergr:
+    convert<Reorder<katana::ReorderingKind::kGorder>>();
+    break;
   case gr2linegr:
     convert<AddRing<true>>();
     break;
@@ -3371,12 +3438,18 @@ main(int argc, char** argv) {
   case gr2pbbsedges:
     convert<Gr2Pbbsedges>();
     break;
+  case gr2rabbitgr:
+    convert<Reorder<katana::ReorderingKind::kRabbit>>();
+    break;
   case gr2randgr:
     convert<RandomizeNodes>();
     break;
   case gr2randomweightgr:
     convert<RandomizeEdgeWeights>();
     break;
+  case gr2rcmgr:
+    convert<Reorder<katana::ReorderingKind::kRCM>>();
+    break;
   case gr2ringgr:
     convert<AddRing<false>>();
     break;
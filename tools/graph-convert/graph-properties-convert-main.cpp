@@ -1,5 +1,9 @@
+#include <algorithm>
 #include <iostream>
+#include <thread>
+#include <vector>
 
+#include <boost/filesystem.hpp>
 #include <llvm/Support/CommandLine.h>
 
 #include "Transforms.h"
@@ -10,6 +14,7 @@
 #include "katana/Logging.h"
 #include "katana/RDG.h"
 #include "katana/SharedMemSys.h"
+#include "katana/Threads.h"
 #include "katana/Timer.h"
 #include "katana/config.h"
 
@@ -70,6 +75,28 @@ cll::opt<bool> generate_mapping(
               "The file is created at the output destination specified"),
     cll::init(false));
 
+cll::opt<std::string> spill_dir(
+    "spill-dir",
+    cll::desc("Local directory for temporary files when importing GraphML\n"
+              "If set, parsed rows and edges are written there instead of "
+              "being kept in memory until the end of the import"),
+    cll::init(""));
+cll::opt<size_t> memory_budget_mb(
+    "memory-budget-mb",
+    cll::desc("Memory in MB for buffered rows and edges before they are "
+              "spilled to --spill-dir"),
+    cll::init(1024));
+
+cll::opt<bool> parallel(
+    "parallel",
+    cll::desc("Parse parts of GraphML inputs in parallel\n"
+              "The input can then also be a directory, all .graphml files of "
+              "which are imported as one graph in name order"),
+    cll::init(false));
+cll::opt<int> num_threads(
+    "t", cll::desc("Number of threads for --parallel (default: all)"),
+    cll::init(0));
+
 cll::list<std::string> timestamp_properties(
     "timestamp", cll::desc("Timestamp properties"));
 cll::list<std::string> date32_properties(
@@ -138,12 +165,55 @@ ConvertKatana(const katana::URI& rdg_file, katana::TxnContext* txn_ctx) {
   return graph;
 }
 
+// The input itself, or the GraphML files in it if it is a directory
+katana::Result<std::vector<std::string>>
+GraphMLFiles() {
+  if (!boost::filesystem::is_directory(input_filename.getValue())) {
+    return std::vector<std::string>{input_filename};
+  }
+  std::vector<std::string> files;
+  for (const auto& entry :
+       boost::filesystem::directory_iterator(input_filename.getValue())) {
+    if (entry.path().extension() == ".graphml") {
+      files.emplace_back(entry.path().string());
+    }
+  }
+  if (files.empty()) {
+    return KATANA_ERROR(
+        katana::ErrorCode::NotFound, "no .graphml files in {}",
+        input_filename);
+  }
+  std::sort(files.begin(), files.end());
+  return std::move(files);
+}
+
+katana::Result<katana::GraphComponents>
+ImportGraphML() {
+  if (parallel) {
+    if (!spill_dir.empty()) {
+      return KATANA_ERROR(
+          katana::ErrorCode::InvalidArgument,
+          "--parallel cannot be combined with --spill-dir");
+    }
+    katana::setActiveThreads(
+        num_threads > 0 ? num_threads : std::thread::hardware_concurrency());
+    return katana::ConvertGraphMLParallel(
+        KATANA_CHECKED(GraphMLFiles()), chunk_size, true);
+  }
+  if (spill_dir.empty()) {
+    return katana::ConvertGraphML(input_filename, chunk_size, true);
+  }
+  katana::SpillOptions spill_options{
+      spill_dir, static_cast<size_t>(memory_budget_mb) << 20};
+  return katana::ConvertGraphML(
+      input_filename, spill_options, chunk_size, true);
+}
+
 void
 ParseWild(katana::TxnContext* txn_ctx) {
   switch (type) {
   case katana::SourceType::kGraphml: {
-    auto components_result =
-        katana::ConvertGraphML(input_filename, chunk_size, true);
+    auto components_result = ImportGraphML();
     if (!components_result) {
       KATANA_LOG_FATAL("Error converting graph: {}", components_result.error());
     }
@@ -170,8 +240,7 @@ void
 ParseNeo4j(katana::TxnContext* txn_ctx) {
   switch (type) {
   case katana::SourceType::kGraphml: {
-    auto components_result =
-        katana::ConvertGraphML(input_filename, chunk_size, true);
+    auto components_result = ImportGraphML();
     if (!components_result) {
       KATANA_LOG_FATAL("Error converting graph: {}", components_result.error());
     }
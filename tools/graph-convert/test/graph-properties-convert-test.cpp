@@ -43,6 +43,15 @@ static cll::opt<ConvertTest> test_type(
 static cll::opt<int> chunk_size(
     "chunkSize", cll::desc("Chunk size for in memory arrow representation"),
     cll::init(25000));
+static cll::opt<std::string> spill_dir(
+    "spillDir", cll::desc("Spill to this directory while converting"),
+    cll::init(""));
+static cll::opt<size_t> memory_budget(
+    "memoryBudget", cll::desc("Memory budget in bytes when spilling"),
+    cll::init(0));
+static cll::opt<bool> parallel(
+    "parallel", cll::desc("Parse parts of the input in parallel"),
+    cll::init(false));
 
 namespace {
 
@@ -1261,6 +1270,20 @@ VerifyMongodbSet(const katana::GraphComponents& graph) {
 }
 #endif
 
+katana::Result<katana::GraphComponents>
+ConvertGraphMLInput() {
+  if (parallel) {
+    return katana::ConvertGraphMLParallel(
+        {input_filename.getValue()}, chunk_size, true);
+  }
+  if (!spill_dir.empty()) {
+    return katana::ConvertGraphML(
+        input_filename, katana::SpillOptions{spill_dir, memory_budget},
+        chunk_size, true);
+  }
+  return katana::ConvertGraphML(input_filename, chunk_size, true);
+}
+
 }  // namespace
 
 int
@@ -1271,13 +1294,14 @@ main(int argc, char** argv) {
   katana::GraphComponents graph;
 
   switch (fileType) {
-  case katana::SourceDatabase::kNeo4j:
-    if (auto r = katana::ConvertGraphML(input_filename, chunk_size, true); !r) {
+  case katana::SourceDatabase::kNeo4j: {
+    auto r = ConvertGraphMLInput();
+    if (!r) {
       KATANA_LOG_FATAL(": {}", r.error());
-    } else {
-      graph = std::move(r.value());
     }
+    graph = std::move(r.value());
     break;
+  }
 #if defined(KATANA_MONGOC_FOUND)
   case katana::SourceDatabase::kMongodb:
     graph = GenerateAndConvertBson(chunk_size);